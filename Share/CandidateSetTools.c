@@ -0,0 +1,315 @@
+/* CandidateSetTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the candidate sets - the classic
+		numbers a solver still considers, a bit per number. A guess's result
+		is filtered in without scoring any number: the bulls of a number are
+		the # of the guess's positions it shares, and its common digits are
+		the # of the guess's digits it has, so both are counted for 128
+		numbers at once (SSE2_SCANNING, 64 otherwise) from two tables - the
+		numbers with a digit at a position, and the numbers with a digit - by
+		adding 4 sets bit-sliced. The group of a result is then an AND of two counts, and the
+		filter is an AND of the group with the set. The tables are filled once,
+		and are read only afterwards, by the Server's bot, the Client's hints
+		& the self-play engine.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <intrin.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "CandidateSetTools.h"
+
+// Constants --------------------------------------------------------------------
+static const int NUM_OF_DIGITS = 10;
+static const int BITS_IN_WORD = 64;
+
+	//A vector of candidate set words - the sets are filtered a vector at a time
+#ifdef SSE2_SCANNING
+typedef __m128i candidateVector;
+#define LOAD_CANDIDATE_VECTOR( p_Vector ) _mm_load_si128(p_Vector)
+#define STORE_CANDIDATE_VECTOR( p_Vector, Vector ) _mm_store_si128(p_Vector, Vector)
+#define AND_CANDIDATE_VECTORS( First, Second ) _mm_and_si128(First, Second)
+#define XOR_CANDIDATE_VECTORS( First, Second ) _mm_xor_si128(First, Second)
+#define NOT_CANDIDATE_VECTOR( Vector ) _mm_xor_si128(Vector, _mm_set1_epi32(-1))
+#else
+typedef ULONGLONG candidateVector;
+#define LOAD_CANDIDATE_VECTOR( p_Vector ) (*(p_Vector))
+#define STORE_CANDIDATE_VECTOR( p_Vector, Vector ) (*(p_Vector) = (Vector))
+#define AND_CANDIDATE_VECTORS( First, Second ) ((First) & (Second))
+#define XOR_CANDIDATE_VECTORS( First, Second ) ((First) ^ (Second))
+#define NOT_CANDIDATE_VECTOR( Vector ) (~(Vector))
+#endif //SSE2_SCANNING
+#define WORDS_IN_CANDIDATE_VECTOR ( sizeof(candidateVector) / sizeof(ULONGLONG) )
+#define NUM_OF_CANDIDATE_VECTORS ( CANDIDATE_SET_NUM_OF_WORDS / WORDS_IN_CANDIDATE_VECTOR )
+
+// Global variables ------------------------------------------------------------
+//The classic numbers, in increasing order, and the sets of numbers with a digit at a position & with a digit (anywhere)
+static char g_candidateNumbers[NUM_OF_PLAYER_NUMBERS][PLAYER_NUMBER_LEN + 1];
+static candidateSet g_positionDigitSets[PLAYER_NUMBER_LEN][10];
+static candidateSet g_digitSets[10];
+static candidateSet g_allCandidates;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function finds the tables' sets of a guess - the numbers sharing each of its positions & the numbers having each of its digits
+/// </summary>
+/// <param name="const char* p_guess - the guess"></param>
+/// <param name="const candidateVector** p_p_positionSets - array of PLAYER_NUMBER_LEN sets (output)"></param>
+/// <param name="const candidateVector** p_p_digitSets - array of PLAYER_NUMBER_LEN sets (output)"></param>
+/// <returns>True if the guess is of digits only. False otherwise</returns>
+static BOOL fetchGuessSets(const char* p_guess, const candidateVector** p_p_positionSets, const candidateVector** p_p_digitSets);
+
+/// <summary>
+/// Description - This function adds 4 sets bit-sliced - bit n of the 3 outputs is the binary # of the sets that have bit n
+/// </summary>
+/// <param name="candidateVector first, second, third, fourth - the sets' vectors"></param>
+/// <param name="candidateVector* p_counts - array of 3 vectors, the count's bits from the lowest (output)"></param>
+static __forceinline void countSetsBitSliced(candidateVector first, candidateVector second, candidateVector third, candidateVector fourth, candidateVector* p_counts);
+
+/// <summary>
+/// Description - This function selects the bits whose bit-sliced count equals a value
+/// </summary>
+/// <param name="const candidateVector* p_counts - array of 3 vectors, the count's bits from the lowest"></param>
+/// <param name="int value - the value (0 - PLAYER_NUMBER_LEN)"></param>
+/// <returns>a vector of the bits whose count equals the value</returns>
+static __forceinline candidateVector selectBitSlicedCount(const candidateVector* p_counts, int value);
+
+/// <summary>
+/// Description - This function counts the bits of a candidate set's word (32 bits at a time, so 32 bits builds count it as well)
+/// </summary>
+static __forceinline int countWordBits(ULONGLONG word);
+
+/// <summary>
+/// Description - This function counts the bits of a vector
+/// </summary>
+static __forceinline int countVectorBits(candidateVector vector);
+
+
+// Functions definitions -------------------------------------------------------
+
+void initializeCandidateSets()
+{
+	int numOfCandidates = 0, first = 0, second = 0, third = 0, fourth = 0, position = 0, word = 0;
+	ULONGLONG bit = 0;
+
+	memset(g_positionDigitSets, 0, sizeof(g_positionDigitSets));
+	memset(g_digitSets, 0, sizeof(g_digitSets));
+	memset(&g_allCandidates, 0, sizeof(g_allCandidates));
+
+	for (first = 0; first < NUM_OF_DIGITS; first++)
+		for (second = 0; second < NUM_OF_DIGITS; second++) {
+			if (second == first) continue;
+			for (third = 0; third < NUM_OF_DIGITS; third++) {
+				if ((third == first) || (third == second)) continue;
+				for (fourth = 0; fourth < NUM_OF_DIGITS; fourth++) {
+					if ((fourth == first) || (fourth == second) || (fourth == third)) continue;
+					g_candidateNumbers[numOfCandidates][0] = (char)('0' + first);
+					g_candidateNumbers[numOfCandidates][1] = (char)('0' + second);
+					g_candidateNumbers[numOfCandidates][2] = (char)('0' + third);
+					g_candidateNumbers[numOfCandidates][3] = (char)('0' + fourth);
+					g_candidateNumbers[numOfCandidates][PLAYER_NUMBER_LEN] = '\0';
+
+					//The number's bit in the sets of its digits & positions
+					word = numOfCandidates / BITS_IN_WORD;
+					bit = 1ULL << (numOfCandidates % BITS_IN_WORD);
+					g_allCandidates.words[word] |= bit;
+					for (position = 0; position < PLAYER_NUMBER_LEN; position++) {
+						g_positionDigitSets[position][g_candidateNumbers[numOfCandidates][position] - '0'].words[word] |= bit;
+						g_digitSets[g_candidateNumbers[numOfCandidates][position] - '0'].words[word] |= bit;
+					}
+					numOfCandidates++;
+				}
+			}
+		}
+	assert(NUM_OF_PLAYER_NUMBERS == numOfCandidates);
+}
+
+const char* fetchCandidateNumber(SHORT candidate)
+{
+	//Assert
+	assert((0 <= candidate) && (candidate < NUM_OF_PLAYER_NUMBERS));
+
+	return g_candidateNumbers[candidate];
+}
+
+int fillCandidateSet(candidateSet* p_set)
+{
+	//Assert
+	assert(NULL != p_set);
+
+	*p_set = g_allCandidates;
+	return NUM_OF_PLAYER_NUMBERS;
+}
+
+int filterCandidateSet(candidateSet* p_set, const char* p_guess, SHORT bulls, SHORT cows)
+{
+	const candidateVector* p_positionSets[PLAYER_NUMBER_LEN];
+	const candidateVector* p_digitSets[PLAYER_NUMBER_LEN];
+	candidateVector* p_vectors = NULL;
+	candidateVector bullsCounts[3], commonsCounts[3], kept;
+	int v = 0;
+	//Asserts
+	assert(NULL != p_set);
+	assert(NULL != p_guess);
+
+	//No number gets a result that is not a result of a guess - or a result of a guess that is not a number
+	if ((0 > bulls) || (0 > cows) || (PLAYER_NUMBER_LEN < bulls + cows) || (FALSE == fetchGuessSets(p_guess, p_positionSets, p_digitSets))) {
+		memset(p_set, 0, sizeof(candidateSet));
+		return 0;
+	}
+
+	//Keep the numbers of exactly 'bulls' shared positions & 'bulls + cows' common digits
+	p_vectors = (candidateVector*)p_set->words;
+	for (v = 0; v < NUM_OF_CANDIDATE_VECTORS; v++) {
+		countSetsBitSliced(p_positionSets[0][v], p_positionSets[1][v], p_positionSets[2][v], p_positionSets[3][v], bullsCounts);
+		countSetsBitSliced(p_digitSets[0][v], p_digitSets[1][v], p_digitSets[2][v], p_digitSets[3][v], commonsCounts);
+		kept = AND_CANDIDATE_VECTORS(LOAD_CANDIDATE_VECTOR(p_vectors + v),
+			AND_CANDIDATE_VECTORS(selectBitSlicedCount(bullsCounts, bulls), selectBitSlicedCount(commonsCounts, bulls + cows)));
+		STORE_CANDIDATE_VECTOR(p_vectors + v, kept);
+	}
+	return countCandidateSet(p_set);
+}
+
+void countCandidateSetGroups(const candidateSet* p_set, const char* p_guess, int* p_groupSizes)
+{
+	const candidateVector* p_positionSets[PLAYER_NUMBER_LEN];
+	const candidateVector* p_digitSets[PLAYER_NUMBER_LEN];
+	const candidateVector* p_vectors = NULL;
+	candidateVector bullsCounts[3], commonsCounts[3], candidates, bullsGroup;
+	int v = 0, bulls = 0, commons = 0, word = 0;
+	//Asserts
+	assert(NULL != p_set);
+	assert(NULL != p_guess);
+	assert(NULL != p_groupSizes);
+
+	memset(p_groupSizes, 0, sizeof(int) * NUM_OF_SCORE_CODES);
+	if (FALSE == fetchGuessSets(p_guess, p_positionSets, p_digitSets)) return;
+
+	//Every (bulls, common digits) pair of a vector - a number has at least as many common digits as bulls
+	p_vectors = (const candidateVector*)p_set->words;
+	for (v = 0; v < NUM_OF_CANDIDATE_VECTORS; v++) {
+		//Skip the vectors already filtered out
+		for (word = 0; word < WORDS_IN_CANDIDATE_VECTOR; word++)
+			if (0 != p_set->words[v * WORDS_IN_CANDIDATE_VECTOR + word]) break;
+		if (WORDS_IN_CANDIDATE_VECTOR == word) continue;
+
+		candidates = LOAD_CANDIDATE_VECTOR(p_vectors + v);
+		countSetsBitSliced(p_positionSets[0][v], p_positionSets[1][v], p_positionSets[2][v], p_positionSets[3][v], bullsCounts);
+		countSetsBitSliced(p_digitSets[0][v], p_digitSets[1][v], p_digitSets[2][v], p_digitSets[3][v], commonsCounts);
+		for (bulls = 0; bulls <= PLAYER_NUMBER_LEN; bulls++) {
+			bullsGroup = AND_CANDIDATE_VECTORS(candidates, selectBitSlicedCount(bullsCounts, bulls));
+			for (commons = bulls; commons <= PLAYER_NUMBER_LEN; commons++)
+				p_groupSizes[SCORE_CODE(bulls, commons - bulls)] += countVectorBits(AND_CANDIDATE_VECTORS(bullsGroup, selectBitSlicedCount(commonsCounts, commons)));
+		}
+	}
+}
+
+int countCandidateSet(const candidateSet* p_set)
+{
+	int word = 0, numOfCandidates = 0;
+	//Assert
+	assert(NULL != p_set);
+
+	for (word = 0; word < CANDIDATE_SET_NUM_OF_WORDS; word++) numOfCandidates += countWordBits(p_set->words[word]);
+	return numOfCandidates;
+}
+
+SHORT fetchNthCandidate(const candidateSet* p_set, int n)
+{
+	ULONGLONG bits = 0;
+	unsigned long bit = 0;
+	int word = 0, numOfBits = 0;
+	//Assert
+	assert(NULL != p_set);
+
+	if (0 > n) return CANDIDATE_SET_NO_CANDIDATE;
+	//Skip whole words, then the lowest bits of the word of the nth candidate
+	for (word = 0; word < CANDIDATE_SET_NUM_OF_WORDS; word++) {
+		bits = p_set->words[word];
+		if (n >= (numOfBits = countWordBits(bits))) {
+			n -= numOfBits;
+			continue;
+		}
+		for (; 0 < n; n--) bits &= bits - 1;
+		if (0 != _BitScanForward(&bit, (ULONG)bits))
+			return (SHORT)(word * BITS_IN_WORD + (int)bit);
+		_BitScanForward(&bit, (ULONG)(bits >> 32));
+		return (SHORT)(word * BITS_IN_WORD + 32 + (int)bit);
+	}
+	return CANDIDATE_SET_NO_CANDIDATE;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL fetchGuessSets(const char* p_guess, const candidateVector** p_p_positionSets, const candidateVector** p_p_digitSets)
+{
+	int position = 0, digit = 0;
+
+	for (position = 0; position < PLAYER_NUMBER_LEN; position++) {
+		digit = p_guess[position] - '0';
+		if ((0 > digit) || (NUM_OF_DIGITS <= digit)) return FALSE;
+		p_p_positionSets[position] = (const candidateVector*)g_positionDigitSets[position][digit].words;
+		p_p_digitSets[position] = (const candidateVector*)g_digitSets[digit].words;
+	}
+	return TRUE;
+}
+
+static __forceinline void countSetsBitSliced(candidateVector first, candidateVector second, candidateVector third, candidateVector fourth, candidateVector* p_counts)
+{
+	candidateVector firstSum = XOR_CANDIDATE_VECTORS(first, second), firstCarry = AND_CANDIDATE_VECTORS(first, second);
+	candidateVector secondSum = XOR_CANDIDATE_VECTORS(third, fourth), secondCarry = AND_CANDIDATE_VECTORS(third, fourth);
+	candidateVector sumsCarry = AND_CANDIDATE_VECTORS(firstSum, secondSum);
+
+	//A sum's carry excludes its pair's carry, so the twos add up to 2 only when both pairs carry
+	p_counts[0] = XOR_CANDIDATE_VECTORS(firstSum, secondSum);
+	p_counts[1] = XOR_CANDIDATE_VECTORS(XOR_CANDIDATE_VECTORS(firstCarry, secondCarry), sumsCarry);
+	p_counts[2] = AND_CANDIDATE_VECTORS(firstCarry, secondCarry);
+}
+
+static __forceinline candidateVector selectBitSlicedCount(const candidateVector* p_counts, int value)
+{
+	return AND_CANDIDATE_VECTORS(AND_CANDIDATE_VECTORS(
+		(value & 1) ? p_counts[0] : NOT_CANDIDATE_VECTOR(p_counts[0]),
+		(value & 2) ? p_counts[1] : NOT_CANDIDATE_VECTOR(p_counts[1])),
+		(value & 4) ? p_counts[2] : NOT_CANDIDATE_VECTOR(p_counts[2]));
+}
+
+static __forceinline int countWordBits(ULONGLONG word)
+{
+	return (int)(__popcnt((unsigned int)word) + __popcnt((unsigned int)(word >> 32)));
+}
+
+static __forceinline int countVectorBits(candidateVector vector)
+{
+	const ULONGLONG* p_words = (const ULONGLONG*)&vector;
+	int word = 0, numOfBits = 0;
+
+	for (word = 0; word < WORDS_IN_CANDIDATE_VECTOR; word++) numOfBits += countWordBits(p_words[word]);
+	return numOfBits;
+}
@@ -0,0 +1,78 @@
+/* CandidateSetTools.h
+------------------------------------------------------------------
+	Module Description - header module for CandidateSetTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __CANDIDATE_SET_TOOLS_H__
+#define __CANDIDATE_SET_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function fills the classic numbers & the sets of numbers with a digit, and with a digit at a position. Must be called once,
+/// before any candidate set is used (the tables are read only afterwards)
+/// </summary>
+void initializeCandidateSets();
+
+/// <summary>
+/// Description - This function returns a classic number
+/// </summary>
+/// <param name="SHORT candidate - the number's index (0 - NUM_OF_PLAYER_NUMBERS - 1)"></param>
+/// <returns>the number, a string of PLAYER_NUMBER_LEN digits</returns>
+const char* fetchCandidateNumber(SHORT candidate);
+
+/// <summary>
+/// Description - This function sets every classic number a candidate
+/// </summary>
+/// <param name="candidateSet* p_set - the set"></param>
+/// <returns># of candidates (NUM_OF_PLAYER_NUMBERS)</returns>
+int fillCandidateSet(candidateSet* p_set);
+
+/// <summary>
+/// Description - This function keeps only the candidates that score the given bulls & cows against the given guess - an AND of the set with the
+/// result's group, computed word by word
+/// </summary>
+/// <param name="candidateSet* p_set - the set"></param>
+/// <param name="const char* p_guess - the guess that was scored, of 4 distinct digits"></param>
+/// <param name="SHORT bulls - the guess's bulls"></param>
+/// <param name="SHORT cows - the guess's cows"></param>
+/// <returns># of candidates left</returns>
+int filterCandidateSet(candidateSet* p_set, const char* p_guess, SHORT bulls, SHORT cows);
+
+/// <summary>
+/// Description - This function counts the candidates of every result a guess may get - the sizes of the groups a guess splits the set to
+/// </summary>
+/// <param name="const candidateSet* p_set - the set"></param>
+/// <param name="const char* p_guess - the guess, of 4 distinct digits"></param>
+/// <param name="int* p_groupSizes - array of NUM_OF_SCORE_CODES group sizes, indexed by score code"></param>
+void countCandidateSetGroups(const candidateSet* p_set, const char* p_guess, int* p_groupSizes);
+
+/// <summary>
+/// Description - This function counts the candidates of a set
+/// </summary>
+/// <param name="const candidateSet* p_set - the set"></param>
+/// <returns># of candidates</returns>
+int countCandidateSet(const candidateSet* p_set);
+
+/// <summary>
+/// Description - This function finds the nth candidate of a set, in increasing order
+/// </summary>
+/// <param name="const candidateSet* p_set - the set"></param>
+/// <param name="int n - 0 for the first candidate"></param>
+/// <returns>the candidate's index, or CANDIDATE_SET_NO_CANDIDATE if the set has n candidates or less</returns>
+SHORT fetchNthCandidate(const candidateSet* p_set, int n);
+
+
+#endif //__CANDIDATE_SET_TOOLS_H__
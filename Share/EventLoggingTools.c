@@ -0,0 +1,430 @@
+/* EventLoggingTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains a binary event logger for the
+		diagnostics of the messages & game paths. Every thread owns a log ring
+		(single producer - the thread, single consumer - the formatter thread),
+		so logging an event is a level check, a timestamp & a few stores into the
+		thread's own ring - no lock, no formatting & no stdout access. The
+		formatter thread wakes up every LOG_FLUSH_INTERVAL_MS, merges the events
+		of all the rings by their timestamps & prints them.
+		The minimal level is read from the LOG_LEVEL_ENVIRONMENT_VARIABLE
+		environment variable & may be changed with setEventLoggerLevel(.).
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL MANUAL_RESET = TRUE;
+static const BOOL INITIALLY_NON_SIGNALED = FALSE;
+static const DWORD FORMATTER_THREAD_STOP_TIMEOUT_MS = 5000;
+
+static const double MILLISECONDS_IN_SECOND = 1000.0;
+
+//Level names (ordered as 'logLevels') - also the values of the LOG_LEVEL_ENVIRONMENT_VARIABLE environment variable
+static const char* LOG_LEVEL_NAMES[NUM_OF_LOG_LEVELS] = { "DEBUG", "INFO", "WARNING", "ERROR", "NONE" };
+
+//Level & format of every event (ordered as 'logEventIds'). A format is applied to the description (%s) & to the two arguments (%lld)
+static const logLevels LOG_EVENT_LEVELS[NUM_OF_LOG_EVENTS] = {
+	LOG_LEVEL_ERROR, LOG_LEVEL_ERROR, LOG_LEVEL_ERROR, LOG_LEVEL_ERROR, LOG_LEVEL_ERROR, LOG_LEVEL_ERROR, LOG_LEVEL_ERROR,
+	LOG_LEVEL_WARNING, LOG_LEVEL_INFO, LOG_LEVEL_INFO, LOG_LEVEL_DEBUG, LOG_LEVEL_DEBUG };
+static const char* LOG_EVENT_FORMATS[NUM_OF_LOG_EVENTS] = {
+	"Bad inputs to function%s",
+	"%s",
+	"Failed to allocate memory for %s",
+	"%s, with error code no. %lld",
+	"%s, with Winsock error code no. %lld",
+	"%s (value %lld)",
+	"%s, message type no. %lld",
+	"%s reached its timeout",
+	"%s (%lld)",
+	"%s - thread is exiting",
+	"%s - result %lld",
+	"%s: %lld, %lld" };
+
+// Global variables ------------------------------------------------------------
+//Fiber Local Storage slot holding the calling thread's log ring
+static DWORD g_logRingFlsIndex = FLS_OUT_OF_INDEXES;
+//Registry of all log rings (rings are only added, & freed when the logger is destroyed) and its lock
+static CRITICAL_SECTION g_logRingsRegistryLock;
+static logRing* g_p_logRingsRegistry = NULL;
+
+//Minimal level of the recorded events & whether events go to the rings (TRUE) or are printed directly (FALSE)
+static volatile LONG g_minimalLogLevel = LOG_LEVEL_INFO;
+static volatile LONG g_isLoggerRunning = FALSE;
+
+//Formatter thread & the Event that stops it
+static HANDLE g_h_formatterThread = NULL;
+static HANDLE g_h_formatterStopEvent = NULL;
+
+//Timestamps are printed in milliseconds since the logger was initialized
+static LARGE_INTEGER g_loggerStartTicks = { 0 };
+static LARGE_INTEGER g_ticksFrequency = { 0 };
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function fetches the calling thread's log ring. On the thread's first call, it adopts an orphaned ring (whose thread exited)
+/// or allocates a new one, and registers it
+/// </summary>
+/// <returns>pointer to the calling thread's log ring, or NULL if failed</returns>
+static logRing* fetchCurrentThreadLogRing();
+
+/// <summary>
+/// Description - Fiber Local Storage callback, called when a thread exits (or when the slot is freed). It orphans the thread's log ring,
+/// so the next new thread adopts it (its remaining events are still printed by the formatter thread)
+/// </summary>
+/// <param name="PVOID p_flsData - the exiting thread's log ring"></param>
+static VOID WINAPI orphanLogRingOnThreadExit(PVOID p_flsData);
+
+/// <summary>
+/// Description - Formatter thread routine - drains all the rings every LOG_FLUSH_INTERVAL_MS, until the stop Event is signaled (then drains them once more)
+/// </summary>
+/// <param name="LPVOID lpParam - not used"></param>
+/// <returns>0</returns>
+static DWORD WINAPI formatterThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function prints the events of all the rings, oldest first, up to the events that were written when it started
+/// (so a busy thread can't keep the formatter draining forever), and reports the events dropped since the last drain
+/// </summary>
+static void drainAllLogRings();
+
+/// <summary>
+/// Description - This function formats a single event & prints it with a single printf(.) call
+/// </summary>
+/// <param name="const logEventRecord* p_record - pointer to the event"></param>
+static void printLogEventRecord(const logEventRecord* p_record);
+
+/// <summary>
+/// Description - This function reads the minimal level from the LOG_LEVEL_ENVIRONMENT_VARIABLE environment variable (INFO if not set or invalid)
+/// </summary>
+/// <returns>the minimal level</returns>
+static logLevels fetchLogLevelFromEnvironment();
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeEventLogger()
+{
+	QueryPerformanceFrequency(&g_ticksFrequency);
+	QueryPerformanceCounter(&g_loggerStartTicks);
+	setEventLoggerLevel(fetchLogLevelFromEnvironment());
+
+	//Allocate the Fiber Local Storage slot. Unlike a TLS slot, its callback is called on thread exit
+	if (FLS_OUT_OF_INDEXES == (g_logRingFlsIndex = FlsAlloc(orphanLogRingOnThreadExit))) {
+		printf("Error: Failed to allocate a Fiber Local Storage slot for the log rings, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		return STATUS_CODE_FAILURE;
+	}
+	InitializeCriticalSection(&g_logRingsRegistryLock);
+
+	//Formatter thread & its stop Event
+	if (NULL == (g_h_formatterStopEvent = CreateEvent(NULL, MANUAL_RESET, INITIALLY_NON_SIGNALED, NULL))) {
+		printf("Error: Failed to create the formatter thread stop Event, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+	if (NULL == (g_h_formatterThread = CreateThread(NULL, 0, formatterThreadRoutine, NULL, 0, NULL))) {
+		printf("Error: Failed to create the log formatter thread, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+
+	InterlockedExchange(&g_isLoggerRunning, TRUE);
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyEventLogger()
+{
+	logRing* p_ring = NULL;
+
+	flushEventLogger();
+
+	if (FLS_OUT_OF_INDEXES == g_logRingFlsIndex) return; //Never initialized
+
+	//Freeing the slot calls the callback for the calling thread's ring as well
+	FlsFree(g_logRingFlsIndex);
+	g_logRingFlsIndex = FLS_OUT_OF_INDEXES;
+
+	//Free every ring
+	EnterCriticalSection(&g_logRingsRegistryLock);
+	while (NULL != g_p_logRingsRegistry) {
+		p_ring = g_p_logRingsRegistry;
+		g_p_logRingsRegistry = p_ring->p_nextRing;
+		_aligned_free(p_ring);
+	}
+	LeaveCriticalSection(&g_logRingsRegistryLock);
+	DeleteCriticalSection(&g_logRingsRegistryLock);
+}
+
+void flushEventLogger()
+{
+	//From now on events are printed directly. Events already in the rings are printed by the formatter's last drain
+	InterlockedExchange(&g_isLoggerRunning, FALSE);
+
+	//Stop the formatter thread
+	if (NULL != g_h_formatterThread) {
+		SetEvent(g_h_formatterStopEvent);
+		if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_formatterThread, FORMATTER_THREAD_STOP_TIMEOUT_MS)) {
+			printf("Error: The log formatter thread did not stop on time.\n");
+			printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		}
+		CloseHandle(g_h_formatterThread);
+		g_h_formatterThread = NULL;
+	}
+	if (NULL != g_h_formatterStopEvent) {
+		CloseHandle(g_h_formatterStopEvent);
+		g_h_formatterStopEvent = NULL;
+	}
+}
+
+void setEventLoggerLevel(logLevels minimalLevel)
+{
+	if ((LOG_LEVEL_DEBUG > minimalLevel) || (NUM_OF_LOG_LEVELS <= minimalLevel)) {
+		printf("Error: Bad inputs to function: %s\n", __func__); return;
+	}
+	InterlockedExchange(&g_minimalLogLevel, (LONG)minimalLevel);
+}
+
+void logEvent(logEventIds eventId, const char* p_description, const char* p_file, const char* p_function, int lineNumber,
+	LONGLONG firstArgument, LONGLONG secondArgument)
+{
+	logRing* p_ring = NULL;
+	logEventRecord* p_record = NULL;
+	logEventRecord directRecord;
+	LARGE_INTEGER timestampTicks;
+	LONG writeIndex = 0;
+
+	//Events below the minimal level are discarded - this is the whole cost of a disabled event
+	if ((LOG_EVENT_BAD_INPUTS > eventId) || (NUM_OF_LOG_EVENTS <= eventId)) return;
+	if ((LONG)LOG_EVENT_LEVELS[eventId] < g_minimalLogLevel) return;
+
+	if ((TRUE == g_isLoggerRunning) && (NULL != (p_ring = fetchCurrentThreadLogRing()))) {
+		writeIndex = p_ring->writeIndex;
+		//The ring seems full - re-sample the formatter's index (the only access to the consumer's cache line)
+		if (LOG_RING_CAPACITY <= (ULONG)writeIndex - (ULONG)p_ring->cachedReadIndex) {
+			p_ring->cachedReadIndex = p_ring->readIndex;
+			if (LOG_RING_CAPACITY <= (ULONG)writeIndex - (ULONG)p_ring->cachedReadIndex) {
+				p_ring->droppedEvents++;
+				return;
+			}
+		}
+		p_record = &p_ring->events[writeIndex & (LOG_RING_CAPACITY - 1)];
+	}
+	else p_record = &directRecord; //Logger is not running (or the ring is unavailable) - print directly
+
+	//Record the event (strings by pointer - they are literals)
+	QueryPerformanceCounter(&timestampTicks);
+	p_record->timestampTicks = timestampTicks.QuadPart;
+	p_record->p_description = p_description;
+	p_record->p_file = p_file;
+	p_record->p_function = p_function;
+	p_record->arguments[0] = firstArgument;
+	p_record->arguments[1] = secondArgument;
+	p_record->lineNumber = lineNumber;
+	p_record->threadId = GetCurrentThreadId();
+	p_record->eventId = eventId;
+
+	if (&directRecord == p_record) printLogEventRecord(p_record);
+	//Publish the event - the interlocked exchange is a full barrier, so the formatter never sees the new index before the record
+	else InterlockedExchange(&p_ring->writeIndex, (LONG)((ULONG)writeIndex + 1));
+}
+
+void fetchEventLoggerQueueDepths(LONG* p_pendingEvents, LONG* p_droppedEvents)
+{
+	logRing* p_ring = NULL;
+	//Input integrity validation
+	if ((NULL == p_pendingEvents) || (NULL == p_droppedEvents)) {
+		printf("Error: Bad inputs to function: %s\n", __func__); return;
+	}
+
+	*p_pendingEvents = 0;
+	*p_droppedEvents = 0;
+	if (FALSE == g_isLoggerRunning) return; //Nothing is queued - events are printed directly
+
+	//Same walk as the formatter's - rings are only added at the head & never removed while the logger runs
+	EnterCriticalSection(&g_logRingsRegistryLock);
+	p_ring = g_p_logRingsRegistry;
+	LeaveCriticalSection(&g_logRingsRegistryLock);
+
+	for (; NULL != p_ring; p_ring = p_ring->p_nextRing) {
+		*p_pendingEvents += (LONG)((ULONG)p_ring->writeIndex - (ULONG)p_ring->readIndex);
+		*p_droppedEvents += p_ring->droppedEvents;
+	}
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static logRing* fetchCurrentThreadLogRing()
+{
+	logRing* p_ring = NULL;
+
+	if (FLS_OUT_OF_INDEXES == g_logRingFlsIndex) return NULL;
+
+	//Fast path - the thread already has a ring
+	if (NULL != (p_ring = (logRing*)FlsGetValue(g_logRingFlsIndex))) return p_ring;
+
+	EnterCriticalSection(&g_logRingsRegistryLock);
+	//Adopt an orphaned ring if exists (its indices are kept, so its remaining events are still printed)
+	for (p_ring = g_p_logRingsRegistry; NULL != p_ring; p_ring = p_ring->p_nextRing)
+		if (0 == p_ring->ownerThreadId) break;
+
+	//Otherwise, allocate a new ring & register it
+	if (NULL == p_ring) {
+		if (NULL == (p_ring = (logRing*)_aligned_malloc(sizeof(logRing), CACHE_LINE_SIZE))) {
+			LeaveCriticalSection(&g_logRingsRegistryLock);
+			printf("Error: Failed to allocate memory for a logRing struct.\n");
+			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			return NULL;
+		}
+		memset(p_ring, 0, sizeof(logRing));
+		p_ring->p_nextRing = g_p_logRingsRegistry;
+		g_p_logRingsRegistry = p_ring;
+	}
+	p_ring->ownerThreadId = GetCurrentThreadId();
+	LeaveCriticalSection(&g_logRingsRegistryLock);
+
+	if (FALSE == FlsSetValue(g_logRingFlsIndex, p_ring)) {
+		printf("Error: Failed to store the log ring in the Fiber Local Storage slot, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		orphanLogRingOnThreadExit(p_ring);
+		return NULL;
+	}
+
+	return p_ring;
+}
+
+static VOID WINAPI orphanLogRingOnThreadExit(PVOID p_flsData)
+{
+	logRing* p_ring = (logRing*)p_flsData;
+
+	if (NULL == p_ring) return;
+
+	EnterCriticalSection(&g_logRingsRegistryLock);
+	p_ring->ownerThreadId = 0;
+	LeaveCriticalSection(&g_logRingsRegistryLock);
+}
+
+static DWORD WINAPI formatterThreadRoutine(LPVOID lpParam)
+{
+	//Drain every LOG_FLUSH_INTERVAL_MS until the stop Event is signaled
+	while (WAIT_TIMEOUT == WaitForSingleObject(g_h_formatterStopEvent, LOG_FLUSH_INTERVAL_MS))
+		drainAllLogRings();
+
+	//Last drain - the events logged right before the logger was stopped
+	drainAllLogRings();
+	return 0;
+}
+
+static void drainAllLogRings()
+{
+	logRing* p_ringsHead = NULL, * p_ring = NULL, * p_oldestRing = NULL;
+	logEventRecord* p_record = NULL, * p_oldestRecord = NULL;
+	LONG droppedEvents = 0, readIndex = 0;
+	ULONG numOfEventsToDrain = 0;
+
+	//Rings are only added at the head & never removed while the formatter runs, so the list can be walked without the lock
+	EnterCriticalSection(&g_logRingsRegistryLock);
+	p_ringsHead = g_p_logRingsRegistry;
+	LeaveCriticalSection(&g_logRingsRegistryLock);
+
+	//Report the dropped events & count the events written so far
+	for (p_ring = p_ringsHead; NULL != p_ring; p_ring = p_ring->p_nextRing) {
+		if ((droppedEvents = p_ring->droppedEvents) != p_ring->reportedDroppedEvents) {
+			printf("Warning: %ld log events were dropped (log ring of thread no. %lu was full)\n",
+				droppedEvents - p_ring->reportedDroppedEvents, p_ring->ownerThreadId);
+			p_ring->reportedDroppedEvents = droppedEvents;
+		}
+		numOfEventsToDrain += (ULONG)p_ring->writeIndex - (ULONG)p_ring->readIndex;
+	}
+
+	//Merge the rings by timestamp - every ring is already ordered, so its oldest event is at its read index
+	for (; 0 < numOfEventsToDrain; numOfEventsToDrain--) {
+		p_oldestRing = NULL;
+		for (p_ring = p_ringsHead; NULL != p_ring; p_ring = p_ring->p_nextRing) {
+			if (p_ring->readIndex == p_ring->writeIndex) continue; //Empty ring
+			p_record = &p_ring->events[p_ring->readIndex & (LOG_RING_CAPACITY - 1)];
+			if ((NULL == p_oldestRing) || (p_record->timestampTicks < p_oldestRecord->timestampTicks)) {
+				p_oldestRing = p_ring;
+				p_oldestRecord = p_record;
+			}
+		}
+		if (NULL == p_oldestRing) break;
+
+		printLogEventRecord(p_oldestRecord);
+		//Release the slot to the producer (the record was fully read before the index moves)
+		readIndex = p_oldestRing->readIndex;
+		InterlockedExchange(&p_oldestRing->readIndex, (LONG)((ULONG)readIndex + 1));
+	}
+}
+
+static void printLogEventRecord(const logEventRecord* p_record)
+{
+	char eventText[LOG_FORMATTED_EVENT_LEN] = { 0 };
+	double milliseconds = 0;
+
+	if (0 != g_ticksFrequency.QuadPart)
+		milliseconds = ((double)(p_record->timestampTicks - g_loggerStartTicks.QuadPart) * MILLISECONDS_IN_SECOND) / (double)g_ticksFrequency.QuadPart;
+
+	_snprintf_s(eventText, sizeof(eventText), _TRUNCATE, LOG_EVENT_FORMATS[p_record->eventId],
+		(NULL != p_record->p_description) ? p_record->p_description : "", p_record->arguments[0], p_record->arguments[1]);
+
+	//Errors & warnings carry their calling site, as the printf(.) diagnostics did
+	if (LOG_LEVEL_WARNING <= LOG_EVENT_LEVELS[p_record->eventId])
+		printf("[%10.3f ms][Thread %5lu][%-7s] %s\n\tAt file: %s\n\tAt line number: %d\n\tAt function: %s\n",
+			milliseconds, p_record->threadId, LOG_LEVEL_NAMES[LOG_EVENT_LEVELS[p_record->eventId]], eventText,
+			p_record->p_file, p_record->lineNumber, p_record->p_function);
+	else
+		printf("[%10.3f ms][Thread %5lu][%-7s] %s (%s)\n",
+			milliseconds, p_record->threadId, LOG_LEVEL_NAMES[LOG_EVENT_LEVELS[p_record->eventId]], eventText, p_record->p_function);
+}
+
+static logLevels fetchLogLevelFromEnvironment()
+{
+	char levelName[LOG_FORMATTED_EVENT_LEN] = { 0 };
+	DWORD levelNameLength = 0;
+	int l = 0;
+
+	levelNameLength = GetEnvironmentVariableA(LOG_LEVEL_ENVIRONMENT_VARIABLE, levelName, sizeof(levelName));
+	if ((0 == levelNameLength) || (sizeof(levelName) <= levelNameLength)) return LOG_LEVEL_INFO; //Not set (or too long to be valid)
+
+	for (l = LOG_LEVEL_DEBUG; l < NUM_OF_LOG_LEVELS; l++)
+		if (STRINGS_ARE_EQUAL(levelName, LOG_LEVEL_NAMES[l], sizeof(levelName))) return (logLevels)l;
+
+	printf("Warning: Unknown log level '%s' in %s - using INFO\n", levelName, LOG_LEVEL_ENVIRONMENT_VARIABLE);
+	return LOG_LEVEL_INFO;
+}
@@ -0,0 +1,78 @@
+/* EventLoggingTools.h
+------------------------------------------------------------------
+	Module Description - header module for EventLoggingTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __EVENT_LOGGING_TOOLS_H__
+#define __EVENT_LOGGING_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+
+//Logs an event with the calling site (file, line, function). p_description MUST be a string literal (it is formatted later, by the formatter thread)
+#define LOG_EVENT( EventId, p_description, FirstArgument, SecondArgument ) \
+	logEvent( (EventId), (p_description), __FILE__, __func__, __LINE__, (LONGLONG)(FirstArgument), (LONGLONG)(SecondArgument) )
+
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function prepares the event logger: allocates a Fiber Local Storage slot that will hold every thread's log ring, reads the minimal
+/// log level from the LOG_LEVEL_ENVIRONMENT_VARIABLE environment variable and starts the formatter thread. Must be called once, before any thread is created.
+/// Events logged before this call (or after destroyEventLogger(.)) are printed directly.
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeEventLogger();
+
+/// <summary>
+/// Description - This function stops the formatter thread after it drains all the rings, frees the rings and releases the Fiber Local Storage slot.
+/// Must be called once, after all other threads ended.
+/// </summary>
+void destroyEventLogger();
+
+/// <summary>
+/// Description - This function stops the formatter thread after it drains all the rings, but leaves the rings to the threads that still run (their
+/// events are printed directly from now on). Called instead of destroyEventLogger(.) when the Server was handed off
+/// </summary>
+void flushEventLogger();
+
+/// <summary>
+/// Description - This function sets the minimal level of the events that are recorded (events of lower levels are discarded at once)
+/// </summary>
+/// <param name="logLevels minimalLevel - LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARNING, LOG_LEVEL_ERROR or LOG_LEVEL_NONE"></param>
+void setEventLoggerLevel(logLevels minimalLevel);
+
+/// <summary>
+/// Description - This function records a binary event in the calling thread's log ring, without any lock and without formatting anything.
+/// If the ring is full the event is dropped & counted (the formatter reports the count). Use it through the LOG_EVENT(.) macro.
+/// </summary>
+/// <param name="logEventIds eventId - the event id (selects the level & the format)"></param>
+/// <param name="const char* p_description - string literal describing the event (may be NULL)"></param>
+/// <param name="const char* p_file - __FILE__"></param>
+/// <param name="const char* p_function - __func__"></param>
+/// <param name="int lineNumber - __LINE__"></param>
+/// <param name="LONGLONG firstArgument - first argument of the event's format"></param>
+/// <param name="LONGLONG secondArgument - second argument of the event's format"></param>
+void logEvent(logEventIds eventId, const char* p_description, const char* p_file, const char* p_function, int lineNumber,
+	LONGLONG firstArgument, LONGLONG secondArgument);
+
+/// <summary>
+/// Description - This function samples the log rings without stopping their threads (or the formatter): the # of events waiting for the formatter
+/// & the # of events dropped so far, summed over all the rings. The values are approximate while threads log
+/// </summary>
+/// <param name="LONG* p_pendingEvents - pointer to the variable that will hold the # of events not printed yet"></param>
+/// <param name="LONG* p_droppedEvents - pointer to the variable that will hold the # of events dropped since the logger was initialized"></param>
+void fetchEventLoggerQueueDepths(LONG* p_pendingEvents, LONG* p_droppedEvents);
+
+
+#endif //__EVENT_LOGGING_TOOLS_H__
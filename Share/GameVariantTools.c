@@ -0,0 +1,307 @@
+/* GameVariantTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the game variants: their rules
+		(number length, alphabet size & whether a symbol may repeat), their
+		parsing from the Server's command line, their SERVER_SETUP_REQUSET
+		parameters, the validation of the players numbers, and the scorers.
+		A scorer counts the bulls (same symbol, same position) & the cows
+		(common symbols, minus the bulls). The common shapes have kernels
+		specialized at compile time - the number length & the alphabet are
+		constants, so the loops are unrolled and the symbol decoding folds to
+		a subtraction for decimal alphabets. Numbers of distinct symbols are
+		scored with a symbols bitmask; the generic kernel counts every symbol,
+		so it scores repeated symbols as well. The scorer is chosen once per
+		variant, thus a round pays a single (well predicted) indirect call.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "GameVariantTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const char GAME_VARIANT_SYMBOLS[] = "0123456789abcdef";
+static const int NUM_OF_VARIANT_PARAMETERS = 3;
+static const int SYMBOL_VALUE_MASK = 2 * MAX_GAME_ALPHABET_SIZE - 1; //A character that is not a symbol is masked into the scorers' range, never out of it
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function decodes a symbol to its value - '0'-'9' then 'a'-'f' (or 'A'-'F'). Inlined into the kernels, where the
+/// alphabet size is a constant, so a decimal alphabet decodes with a single subtraction
+/// </summary>
+/// <param name="char symbol - the symbol"></param>
+/// <param name="int alphabetSize - # of symbols of the alphabet"></param>
+/// <returns>the symbol's value (masked by SYMBOL_VALUE_MASK)</returns>
+static __forceinline int fetchSymbolValue(char symbol, int alphabetSize);
+
+/// <summary>
+/// Description - The generic kernel - scores numbers of any length (up to their '\0') & any alphabet, repeated symbols included:
+/// the cows are the common symbols (the lower count of every symbol) minus the bulls
+/// </summary>
+/// <param name="const char* p_secretNumber - the opponent's initial number"></param>
+/// <param name="const char* p_guessNumber - the guess"></param>
+/// <param name="SHORT* p_bulls - address of the bulls count"></param>
+/// <param name="SHORT* p_cows - address of the cows count"></param>
+static void scoreGuessGeneric(const char* p_secretNumber, const char* p_guessNumber, SHORT* p_bulls, SHORT* p_cows);
+
+//Kernels specialized for numbers of distinct symbols - the secret number's symbols are set in a mask, and every guess symbol found in the mask
+// is common. Both loops have a constant trip count & no branch
+#define DEFINE_DISTINCT_SYMBOLS_SCORER( Name, NumberLength, AlphabetSize )												\
+static void Name(const char* p_secretNumber, const char* p_guessNumber, SHORT* p_bulls, SHORT* p_cows)					\
+{																														\
+	ULONG secretSymbolsMask = 0;																						\
+	int i = 0, bulls = 0, commonSymbols = 0, guessSymbolValue = 0;														\
+	assert((NULL != p_secretNumber) && (NULL != p_guessNumber) && (NULL != p_bulls) && (NULL != p_cows));				\
+																														\
+	for (i = 0; i < (NumberLength); i++) secretSymbolsMask |= 1UL << fetchSymbolValue(p_secretNumber[i], (AlphabetSize));	\
+	for (i = 0; i < (NumberLength); i++) {																				\
+		guessSymbolValue = fetchSymbolValue(p_guessNumber[i], (AlphabetSize));											\
+		bulls += (guessSymbolValue == fetchSymbolValue(p_secretNumber[i], (AlphabetSize)));								\
+		commonSymbols += (int)((secretSymbolsMask >> guessSymbolValue) & 1);											\
+	}																													\
+	*p_bulls = (SHORT)bulls;																							\
+	*p_cows = (SHORT)(commonSymbols - bulls);																			\
+}
+
+DEFINE_DISTINCT_SYMBOLS_SCORER(scoreGuess4x10, 4, 10)
+DEFINE_DISTINCT_SYMBOLS_SCORER(scoreGuess5x10, 5, 10)
+DEFINE_DISTINCT_SYMBOLS_SCORER(scoreGuess6x16, 6, 16)
+#undef DEFINE_DISTINCT_SYMBOLS_SCORER
+
+//The specialized shapes - a variant of distinct symbols with one of these shapes is scored by its kernel
+static const struct {
+	SHORT numberLength;
+	SHORT alphabetSize;
+	void (*p_scoreGuess)(const char* p_secretNumber, const char* p_guessNumber, SHORT* p_bulls, SHORT* p_cows);
+} SPECIALIZED_SCORERS[] = {
+	{ PLAYER_NUMBER_LEN, CLASSIC_GAME_ALPHABET_SIZE, scoreGuess4x10 },
+	{ 5, 10, scoreGuess5x10 },
+	{ 6, 16, scoreGuess6x16 } };
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL setGameVariant(SHORT numberLength, SHORT alphabetSize, BOOL isRepeatAllowed, gameVariant* p_variant)
+{
+	int shape = 0;
+	//Input integrity validation
+	if (NULL == p_variant) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+	if ((1 > numberLength) || (MAX_PLAYER_NUMBER_LEN < numberLength) || (MIN_GAME_ALPHABET_SIZE > alphabetSize) || (MAX_GAME_ALPHABET_SIZE < alphabetSize) ||
+		((FALSE == isRepeatAllowed) && (numberLength > alphabetSize))) return STATUS_CODE_FAILURE;
+
+	p_variant->numberLength = numberLength;
+	p_variant->alphabetSize = alphabetSize;
+	p_variant->isRepeatAllowed = (FALSE != isRepeatAllowed);
+
+	//Choose the scorer
+	p_variant->p_scoreGuess = scoreGuessGeneric;
+	if (FALSE == p_variant->isRepeatAllowed)
+		for (shape = 0; shape < (int)(sizeof(SPECIALIZED_SCORERS) / sizeof(SPECIALIZED_SCORERS[0])); shape++)
+			if ((numberLength == SPECIALIZED_SCORERS[shape].numberLength) && (alphabetSize == SPECIALIZED_SCORERS[shape].alphabetSize))
+				p_variant->p_scoreGuess = SPECIALIZED_SCORERS[shape].p_scoreGuess;
+	return STATUS_CODE_SUCCESS;
+}
+
+void setClassicGameVariant(gameVariant* p_variant)
+{
+	setGameVariant(PLAYER_NUMBER_LEN, CLASSIC_GAME_ALPHABET_SIZE, FALSE, p_variant);
+}
+
+BOOL isClassicGameVariant(const gameVariant* p_variant)
+{
+	//Assert
+	assert(NULL != p_variant);
+
+	return (PLAYER_NUMBER_LEN == p_variant->numberLength) && (CLASSIC_GAME_ALPHABET_SIZE == p_variant->alphabetSize) && (FALSE == p_variant->isRepeatAllowed);
+}
+
+BOOL parseGameVariant(const char* p_variantString, gameVariant* p_variant)
+{
+	char* p_end = NULL;
+	long numberLength = 0, alphabetSize = 0;
+	BOOL isRepeatAllowed = FALSE;
+	//Input integrity validation
+	if ((NULL == p_variantString) || (NULL == p_variant)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+
+	//"<length>x<alphabet>" followed by an optional 'r'
+	numberLength = strtol(p_variantString, &p_end, 10);
+	if ((p_end == p_variantString) || (('x' != *p_end) && ('X' != *p_end))) return STATUS_CODE_FAILURE;
+	p_variantString = p_end + 1;
+	alphabetSize = strtol(p_variantString, &p_end, 10);
+	if (p_end == p_variantString) return STATUS_CODE_FAILURE;
+	if (('r' == *p_end) || ('R' == *p_end)) {
+		isRepeatAllowed = TRUE;
+		p_end++;
+	}
+	if (('\0' != *p_end) || (0 > numberLength) || (MAX_PLAYER_NUMBER_LEN < numberLength) || (0 > alphabetSize) || (MAX_GAME_ALPHABET_SIZE < alphabetSize)) return STATUS_CODE_FAILURE;
+
+	return setGameVariant((SHORT)numberLength, (SHORT)alphabetSize, isRepeatAllowed, p_variant);
+}
+
+void formatGameVariantParameters(const gameVariant* p_variant, char* p_lengthBuffer, char* p_alphabetBuffer, char* p_repeatsBuffer)
+{
+	//Asserts
+	assert(NULL != p_variant);
+	assert((NULL != p_lengthBuffer) && (NULL != p_alphabetBuffer) && (NULL != p_repeatsBuffer));
+
+	_snprintf_s(p_lengthBuffer, GAME_VARIANT_PARAMETER_LEN, _TRUNCATE, "%hd", p_variant->numberLength);
+	_snprintf_s(p_alphabetBuffer, GAME_VARIANT_PARAMETER_LEN, _TRUNCATE, "%hd", p_variant->alphabetSize);
+	_snprintf_s(p_repeatsBuffer, GAME_VARIANT_PARAMETER_LEN, _TRUNCATE, "%d", (TRUE == p_variant->isRepeatAllowed) ? 1 : 0);
+}
+
+BOOL decodeGameVariantParameters(parameter* p_parameters, gameVariant* p_variant)
+{
+	long values[3] = { 0 };
+	int p = 0;
+	//Input integrity validation
+	if (NULL == p_variant) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+
+	//No parameters - the classic variant
+	if (NULL == p_parameters) {
+		setClassicGameVariant(p_variant);
+		return STATUS_CODE_SUCCESS;
+	}
+
+	//Number length, alphabet size & repeats
+	for (p = 0; p < NUM_OF_VARIANT_PARAMETERS; p++, p_parameters = p_parameters->p_nextParameter) {
+		if ((NULL == p_parameters) || (NULL == p_parameters->p_parameter)) return STATUS_CODE_FAILURE;
+		values[p] = strtol(p_parameters->p_parameter, NULL, 10);
+	}
+	if ((0 > values[0]) || (MAX_PLAYER_NUMBER_LEN < values[0]) || (0 > values[1]) || (MAX_GAME_ALPHABET_SIZE < values[1])) return STATUS_CODE_FAILURE;
+	return setGameVariant((SHORT)values[0], (SHORT)values[1], (0 != values[2]), p_variant);
+}
+
+const char* fetchResumedInitialNumber(parameter* p_parameters)
+{
+	int p = 0;
+
+	//The number follows the variant's parameters
+	for (p = 0; (p < NUM_OF_VARIANT_PARAMETERS) && (NULL != p_parameters); p++) p_parameters = p_parameters->p_nextParameter;
+	return (NULL != p_parameters) ? p_parameters->p_parameter : NULL;
+}
+
+void describeGameVariant(const gameVariant* p_variant, char* p_description)
+{
+	//Asserts
+	assert(NULL != p_variant);
+	assert(NULL != p_description);
+
+	if (CLASSIC_GAME_ALPHABET_SIZE == p_variant->alphabetSize)
+		_snprintf_s(p_description, GAME_VARIANT_DESCRIPTION_LEN, _TRUNCATE, "%hd %sdigits", p_variant->numberLength,
+			(TRUE == p_variant->isRepeatAllowed) ? "" : "different ");
+	else //The alphabet's range, e.g. "0-7" or "0-9a-f"
+		_snprintf_s(p_description, GAME_VARIANT_DESCRIPTION_LEN, _TRUNCATE, "%hd %ssymbols of 0-%s%c", p_variant->numberLength,
+			(TRUE == p_variant->isRepeatAllowed) ? "" : "different ", (CLASSIC_GAME_ALPHABET_SIZE < p_variant->alphabetSize) ? "9a-" : "",
+			GAME_VARIANT_SYMBOLS[p_variant->alphabetSize - 1]);
+}
+
+BOOL isValidPlayerNumber(const gameVariant* p_variant, const char* p_number)
+{
+	ULONG seenSymbolsMask = 0, repeatedSymbolsMask = 0, invalidSymbols = 0, symbolBit = 0;
+	ULONG digitValue = 0, letterValue = 0, isDigit = 0, isLetter = 0, symbolValue = 0;
+	int length = 0, i = 0;
+	//Input integrity validation
+	if ((NULL == p_variant) || (NULL == p_number)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return FALSE;
+	}
+
+	//The length - the only branch on the number's content
+	for (length = 0; (length <= p_variant->numberLength) && ('\0' != p_number[length]); length++);
+	if (length != p_variant->numberLength) return FALSE;
+
+	//Branch-free - every symbol is classified with unsigned range checks, and its bit is added to the seen symbols mask. A symbol that is not
+	// of the alphabet raises invalidSymbols, a symbol whose bit was already seen raises its bit in the repeated symbols mask
+	for (i = 0; i < length; i++) {
+		digitValue = (ULONG)((unsigned char)p_number[i] - '0');
+		letterValue = (ULONG)(((unsigned char)p_number[i] | 0x20) - 'a');	// | 0x20 makes 'A'-'F' lower case
+		isDigit = (digitValue < CLASSIC_GAME_ALPHABET_SIZE);
+		isLetter = (letterValue < MAX_GAME_ALPHABET_SIZE - CLASSIC_GAME_ALPHABET_SIZE);
+		symbolValue = (digitValue & (0UL - isDigit)) | ((letterValue + CLASSIC_GAME_ALPHABET_SIZE) & (0UL - isLetter));
+		invalidSymbols |= ((isDigit | isLetter) ^ 1) | (symbolValue >= (ULONG)p_variant->alphabetSize);
+		symbolBit = 1UL << (symbolValue & SYMBOL_VALUE_MASK);
+		repeatedSymbolsMask |= seenSymbolsMask & symbolBit;
+		seenSymbolsMask |= symbolBit;
+	}
+	invalidSymbols |= (0 != repeatedSymbolsMask) & (FALSE == p_variant->isRepeatAllowed);
+	return (0 == invalidSymbols);
+}
+
+gameRoundOutcomes judgeGameRound(const gameVariant* p_variant, SHORT selfGuessBulls, SHORT otherGuessBulls)
+{
+	//Assert
+	assert(NULL != p_variant);
+
+	if ((selfGuessBulls == p_variant->numberLength) && (otherGuessBulls == p_variant->numberLength)) return GAME_ROUND_DRAW;
+	if (selfGuessBulls == p_variant->numberLength) return GAME_ROUND_SELF_WINS;
+	if (otherGuessBulls == p_variant->numberLength) return GAME_ROUND_OTHER_WINS;
+	return GAME_ROUND_CONTINUES;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static __forceinline int fetchSymbolValue(char symbol, int alphabetSize)
+{
+	//Decimal alphabets - '0'-'9' only. Otherwise 'a'-'f' follow the digits (| 0x20 makes 'A'-'F' lower case & keeps the digits as they are)
+	if (CLASSIC_GAME_ALPHABET_SIZE >= alphabetSize) return (symbol - '0') & SYMBOL_VALUE_MASK;
+	return (('9' >= symbol) ? (symbol - '0') : ((symbol | 0x20) - 'a' + 10)) & SYMBOL_VALUE_MASK;
+}
+
+static void scoreGuessGeneric(const char* p_secretNumber, const char* p_guessNumber, SHORT* p_bulls, SHORT* p_cows)
+{
+	int secretSymbolsCounts[2 * MAX_GAME_ALPHABET_SIZE] = { 0 }, guessSymbolsCounts[2 * MAX_GAME_ALPHABET_SIZE] = { 0 }; //Every masked value
+	int i = 0, bulls = 0, commonSymbols = 0, secretSymbolValue = 0, guessSymbolValue = 0;
+	//Asserts
+	assert((NULL != p_secretNumber) && (NULL != p_guessNumber));
+	assert((NULL != p_bulls) && (NULL != p_cows));
+
+	//Count every symbol of both numbers, and the bulls
+	for (i = 0; (i < MAX_PLAYER_NUMBER_LEN) && ('\0' != p_secretNumber[i]) && ('\0' != p_guessNumber[i]); i++) {
+		secretSymbolValue = fetchSymbolValue(p_secretNumber[i], MAX_GAME_ALPHABET_SIZE);
+		guessSymbolValue = fetchSymbolValue(p_guessNumber[i], MAX_GAME_ALPHABET_SIZE);
+		secretSymbolsCounts[secretSymbolValue]++;
+		guessSymbolsCounts[guessSymbolValue]++;
+		bulls += (secretSymbolValue == guessSymbolValue);
+	}
+	//A symbol is common as many times as it appears in the number that has less of it
+	for (i = 0; i < 2 * MAX_GAME_ALPHABET_SIZE; i++)
+		commonSymbols += (secretSymbolsCounts[i] < guessSymbolsCounts[i]) ? secretSymbolsCounts[i] : guessSymbolsCounts[i];
+
+	*p_bulls = (SHORT)bulls;
+	*p_cows = (SHORT)(commonSymbols - bulls);
+}
@@ -0,0 +1,106 @@
+/* GameVariantTools.h
+------------------------------------------------------------------
+	Module Description - header module for GameVariantTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __GAME_VARIANT_TOOLS_H__
+#define __GAME_VARIANT_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function sets a variant's rules and chooses its scorer - the kernel specialized for its shape, if exists, the generic kernel otherwise
+/// </summary>
+/// <param name="SHORT numberLength - # of symbols of a number (1 - MAX_PLAYER_NUMBER_LEN)"></param>
+/// <param name="SHORT alphabetSize - # of symbols to choose from (MIN_GAME_ALPHABET_SIZE - MAX_GAME_ALPHABET_SIZE)"></param>
+/// <param name="BOOL isRepeatAllowed - TRUE if a symbol may repeat. Otherwise the number length may not exceed the alphabet size"></param>
+/// <param name="gameVariant* p_variant - pointer to the variant to set"></param>
+/// <returns>True if the rules are valid. False otherwise (the variant is left untouched)</returns>
+BOOL setGameVariant(SHORT numberLength, SHORT alphabetSize, BOOL isRepeatAllowed, gameVariant* p_variant);
+
+/// <summary>
+/// Description - This function sets the classic variant - 4 distinct decimal digits
+/// </summary>
+/// <param name="gameVariant* p_variant - pointer to the variant to set"></param>
+void setClassicGameVariant(gameVariant* p_variant);
+
+/// <summary>
+/// Description - This function checks whether a variant is the classic one
+/// </summary>
+/// <param name="const gameVariant* p_variant - the variant"></param>
+/// <returns>True if classic. False otherwise</returns>
+BOOL isClassicGameVariant(const gameVariant* p_variant);
+
+/// <summary>
+/// Description - This function parses a variant given on the command line as "<length>x<alphabet>", followed by 'r' if symbols may repeat (e.g. 5x10, 6x16r)
+/// </summary>
+/// <param name="const char* p_variantString - the command line argument"></param>
+/// <param name="gameVariant* p_variant - pointer to the variant to set"></param>
+/// <returns>True if the string is a valid variant. False otherwise</returns>
+BOOL parseGameVariant(const char* p_variantString, gameVariant* p_variant);
+
+/// <summary>
+/// Description - This function formats a variant as the three SERVER_SETUP_REQUSET parameters - number length, alphabet size & repeats (1\0)
+/// </summary>
+/// <param name="const gameVariant* p_variant - the variant"></param>
+/// <param name="char* p_lengthBuffer, p_alphabetBuffer, p_repeatsBuffer - buffers of GAME_VARIANT_PARAMETER_LEN bytes"></param>
+void formatGameVariantParameters(const gameVariant* p_variant, char* p_lengthBuffer, char* p_alphabetBuffer, char* p_repeatsBuffer);
+
+/// <summary>
+/// Description - This function sets a variant from the SERVER_SETUP_REQUSET parameters. A request with no parameters (a Server that predates the variants)
+/// is the classic variant
+/// </summary>
+/// <param name="parameter* p_parameters - the message's parameters (may be NULL)"></param>
+/// <param name="gameVariant* p_variant - pointer to the variant to set"></param>
+/// <returns>True if succeeded. False if the parameters are not a valid variant</returns>
+BOOL decodeGameVariantParameters(parameter* p_parameters, gameVariant* p_variant);
+
+/// <summary>
+/// Description - This function fetches the player's initial number from the SERVER_SETUP_REQUSET parameters - sent after the variant when the game
+/// is resumed, since the previous Server process ended mid-game (the player doesn't choose a number again)
+/// </summary>
+/// <param name="parameter* p_parameters - the message's parameters (may be NULL)"></param>
+/// <returns>pointer to the initial number parameter, or NULL if the game is a new one</returns>
+const char* fetchResumedInitialNumber(parameter* p_parameters);
+
+/// <summary>
+/// Description - This function describes a variant for the player, e.g. "4 different digits" or "6 symbols of 0-9a-f" (repeats allowed)
+/// </summary>
+/// <param name="const gameVariant* p_variant - the variant"></param>
+/// <param name="char* p_description - buffer of GAME_VARIANT_DESCRIPTION_LEN bytes"></param>
+void describeGameVariant(const gameVariant* p_variant, char* p_description);
+
+/// <summary>
+/// Description - This function checks whether a number obeys a variant - its length, its symbols and, unless repeats are allowed, that no symbol repeats
+/// (symbols 'a'-'f' may be given in upper case as well). Past the length, the symbols are checked branch-free with a seen symbols bitmask - the Server
+/// checks every CLIENT_SETUP & CLIENT_PLAYER_MOVE number with it
+/// </summary>
+/// <param name="const gameVariant* p_variant - the variant"></param>
+/// <param name="const char* p_number - the number, a string"></param>
+/// <returns>True if valid. False otherwise</returns>
+BOOL isValidPlayerNumber(const gameVariant* p_variant, const char* p_number);
+
+/// <summary>
+/// Description - This function judges a scored game round - a number is guessed when all of its symbols are bulls, and a round in which both
+/// players guessed is a draw
+/// </summary>
+/// <param name="const gameVariant* p_variant - the game's variant"></param>
+/// <param name="SHORT selfGuessBulls - bulls of the "self" player's guess"></param>
+/// <param name="SHORT otherGuessBulls - bulls of the opponent's guess"></param>
+/// <returns>the round's 'gameRoundOutcomes' outcome, of the "self" player</returns>
+gameRoundOutcomes judgeGameRound(const gameVariant* p_variant, SHORT selfGuessBulls, SHORT otherGuessBulls);
+
+
+#endif //__GAME_VARIANT_TOOLS_H__
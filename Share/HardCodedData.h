@@ -28,10 +28,54 @@
 
 #define STRINGS_ARE_EQUAL( Str1, Str2, len ) ( strncmp( (Str1), (Str2), len ) == 0 )
 #define EXIT_GUESS_LEN 5
+#define SERVER_COMMAND_LEN 8		//The longest Server STDin command ("restart") & '\0'
 
 //.......BOTH constants
 #define SET_EVENT_TO_SIGNALED_STATE_FAILED 0
 
+	//Cache line constants - records shared between threads (or written by several threads) are aligned to a cache line, so two threads never
+	// write the same line unless they write the same data (no false sharing). Such records are allocated with _aligned_malloc(.)
+#define CACHE_LINE_SIZE 64
+#define CACHE_ALIGNED __declspec(align(CACHE_LINE_SIZE))
+
+	//Slab allocator constants
+#define SLAB_SMALL_BUFFER_SIZE 64		//Strings of up to 64 bytes (incl. '\0') are served by the slab caches, longer strings by the Heap
+#define SLAB_BLOCKS_PER_CHUNK 64		//Number of blocks a slab cache carves out of every chunk it allocates from the Heap
+
+	//Event logger constants
+#define LOG_RING_CAPACITY 1024			//Events per thread ring - MUST be a power of 2 (a full ring drops new events & counts them)
+#define LOG_FLUSH_INTERVAL_MS 20		//The formatter thread drains all the rings every 20ms
+#define LOG_FORMATTED_EVENT_LEN 256		//Max length of a single formatted event (longer ones are truncated)
+#define LOG_LEVEL_ENVIRONMENT_VARIABLE "BULLS_AND_COWS_LOG_LEVEL"	//DEBUG, INFO, WARNING, ERROR or NONE (INFO if not set)
+
+	//Metrics registry constants - latencies are recorded in microseconds into log-linear (HDR-style) histograms: every power of 2 is split into
+	// METRICS_HISTOGRAM_SUB_BUCKETS linear sub-buckets, so a recorded value is off by at most 1/8 (12.5%) of itself. Values of 2^40us and above share the last bucket
+#define METRICS_MAX_SHARDS 64					//Counters & histograms are kept per processor (up to 64 shards, processors beyond share them)
+#define METRICS_HISTOGRAM_SUB_BUCKET_BITS 3
+#define METRICS_HISTOGRAM_SUB_BUCKETS (1 << METRICS_HISTOGRAM_SUB_BUCKET_BITS)
+#define METRICS_HISTOGRAM_MAX_EXPONENT 40
+#define METRICS_HISTOGRAM_NUM_OF_BUCKETS ((METRICS_HISTOGRAM_MAX_EXPONENT - METRICS_HISTOGRAM_SUB_BUCKET_BITS + 1) * METRICS_HISTOGRAM_SUB_BUCKETS)
+#define NUM_OF_MESSAGE_TYPES (CLIENT_DISCONNECT_NUM + 1)	//Message type serial numbers start at 1 (index 0 is never used)
+
+	//Messages scanning constants - the received frames & strings are scanned 16 bytes at a time with SSE2 (every x64 processor has it, and 32bit
+	// builds generate SSE2 by default). Chunks are loaded from 16 bytes aligned addresses, so a scan never crosses a page it was not asked to read.
+	// Define NO_SSE2_SCANNING (or build for another architecture) to scan byte by byte instead
+#if (defined(_M_X64) || defined(_M_IX86)) && !defined(NO_SSE2_SCANNING)
+#define SSE2_SCANNING
+#include <emmintrin.h>
+#endif
+#define SCAN_CHUNK_SIZE 16
+#define MESSAGE_MAX_SLICES 16		//Message type + parameters of a received message (messages have at most 4 parameters, longer messages are rejected)
+
+	//Send queues constants - a Worker thread queues the frames (length prefix & message) it sends to its Client in a bounded queue & flushes it
+	// without blocking (SendQueueTools.c). A frame that doesn't fit below the high watermark applies the queue's policy: drop the connection,
+	// park the Worker thread until the Client reads, or coalesce the pending SERVER_GAME_RESULTS frames
+#define SEND_QUEUE_HIGH_WATERMARK 8192		//Bytes a single queue holds
+#define SEND_QUEUE_MAX_FRAMES 64			//Frames a single queue holds
+#define SEND_QUEUE_PARK_TIMEOUT_MS 2000		//A parked Worker thread waits up to 2 Seconds for room, then evicts its Client
+#define SEND_QUEUE_DRAIN_TIMEOUT_MS 15000	//Before every receive the queue is drained (a Client answers only what it read) for up to 15 Seconds
+#define SEND_QUEUE_DEFAULT_POLICY SEND_QUEUE_POLICY_COALESCE
+
 
 
 //.......Server Constants
@@ -41,12 +85,179 @@
 
 #define MUTEX_CONTROL_FAILURE -1
 #define GAME_SESSION_PATH "GameSession.txt" //Relative Path to Server process files ONLY
+#define PLAYER_NUMBER_LEN 4 //Number of digits of an initial number or a guess (classic variant)
+
+	//Game variant constants - a variant sets the length of the numbers, the size of their alphabet ('0'-'9' then 'a'-'f') & whether a symbol
+	// may repeat. The Server plays a single variant (server.exe <port> [<length>x<alphabet>[r]], e.g. 5x10 or 6x16r), offered to both players with
+	// SERVER_SETUP_REQUSET. The classic variant is 4 distinct decimal digits
+#define MAX_PLAYER_NUMBER_LEN 7				//Longest number of any variant - the four numbers of a Worker thread still fit its second hot cache line
+#define MAX_GAME_ALPHABET_SIZE 16
+#define MIN_GAME_ALPHABET_SIZE 2
+#define CLASSIC_GAME_ALPHABET_SIZE 10
+#define GAME_VARIANT_PARAMETER_LEN 4		//Buffer of a single SERVER_SETUP_REQUSET parameter (incl. '\0')
+#define GAME_VARIANT_DESCRIPTION_LEN 64		//Buffer of a variant's description, as shown to the player
+
+	//Admin endpoint constants - a TCP listener bound to SERVER_ADDRESS_STR that answers every HTTP request with the live telemetry
+	// in the Prometheus text format (e.g. curl http://127.0.0.1:<game port + 1>/metrics)
+#define ADMIN_ENDPOINT_PORT_OFFSET 1			//The admin port is the game port + 1
+#define ADMIN_REQUEST_BUFFER_SIZE 1024			//The request is read once & only its first line is looked at
+#define ADMIN_RESPONSE_BUFFER_SIZE 65536		//Headers & body of a single scrape (longer bodies are truncated)
+
+	//Spectator constants - spectators connect to their own port & watch the Game Room read-only (client.exe <ip> <game port> <name> spectate).
+	// Every round result & outcome is encoded ONCE into a reference-counted immutable frame, and a single fan-out thread queues a reference to it
+	// for every spectator & sends it straight from the shared frame with non-blocking send(.)s (SpectatorFanoutTools.c)
+#define SPECTATOR_ENDPOINT_PORT_OFFSET 2		//The spectators port is the game port + 2
+#define SPECTATOR_MAX_SPECTATORS 256			//Spectators watching at once (the next one is declined)
+#define SPECTATOR_QUEUE_CAPACITY 64				//Frames a spectator may fall behind - MUST be a power of 2 (a spectator that falls further behind is dropped)
+#define CLIENT_SPECTATE_OPTION "spectate"
+
+	//Matchmaking constants - a player that sent CLIENT_VERSUS waits in a lock-free queue (MatchmakingTools.c) & is paired in arrival order,
+	// or within a rating window (its rating bucket & the neighbouring ones) that widens while it waits. A player left alone may be offered a bot,
+	// played by the Server itself over loopback
+#define MATCHMAKING_QUEUE_CAPACITY 64					//Waiting entries per bucket - MUST be a power of 2
+#define MATCHMAKING_MAX_TICKETS NUM_OF_WORKER_THREADS	//A player waits with a ticket - at most one per Worker thread
+#define MATCHMAKING_NUM_OF_BUCKETS 16
+#define MATCHMAKING_BUCKET_WIDTH 200					//Rating points per bucket
+#define MATCHMAKING_BUCKET_SPREAD 1						//Neighbouring buckets searched on each side before waiting,
+#define MATCHMAKING_WINDOW_WIDEN_INTERVAL_MS 4000		// and one more on each side every 4 Seconds of waiting
+#define MATCHMAKING_WAIT_TIMEOUT_MS 20000				//A player waits 20 Seconds for an opponent,
+#define MATCHMAKING_BOT_ARRIVAL_TIMEOUT_MS 10000		// and if a bot is summoned, 10 more Seconds for the bot to arrive
+#define MATCHMAKING_DEFAULT_MODE MATCHMAKING_MODE_SKILL_BUCKETS
+#define MATCHMAKING_DEFAULT_BOT_FALLBACK TRUE
+#define MATCHMAKING_BOT_NAME "ServerBot"
+#define NUM_OF_PLAYER_NUMBERS 5040						//Numbers of 4 distinct digits (10 * 9 * 8 * 7) - the bot's candidates
+
+	//A matchmaking ticket's state word packs its state (2 bits) & its generation (the rest) - the generation grows every time the ticket
+	// starts waiting, so a queue entry left by a previous wait can never claim the ticket
+#define MATCHMAKING_TICKET_STATE_MASK 0x00000003
+#define MATCHMAKING_TICKET_GENERATION_SHIFT 2
+#define MATCHMAKING_TICKET_STATE( Word ) ( (Word) & MATCHMAKING_TICKET_STATE_MASK )
+#define MATCHMAKING_TICKET_GENERATION( Word ) ( (LONG)(((ULONG)(Word)) >> MATCHMAKING_TICKET_GENERATION_SHIFT) )
+#define MATCHMAKING_TICKET_STATE_WORD( Generation, State ) ( (LONG)((((ULONG)(Generation)) << MATCHMAKING_TICKET_GENERATION_SHIFT) | ((State) & MATCHMAKING_TICKET_STATE_MASK)) )
+
+	//Rating store constants - every player name has an Elo rating (RatingStoreTools.c), kept in memory in shards that are locked separately, and
+	// snapshotted to a file periodically & when the Server exits. A new player's games count more (provisional K factor) until its rating settles
+#define RATING_STORE_NUM_OF_SHARDS 16					//MUST be a power of 2
+#define RATING_STORE_SHARD_CAPACITY 512					//Names per shard - MUST be a power of 2 (a full shard rates its new names as RATING_INITIAL)
+#define RATING_STORE_SNAPSHOT_INTERVAL_MS 60000			//The store is written every minute, if it changed
+#define RATING_STORE_PATH "Ratings.bin"					//Relative Path to Server process files ONLY
+#define RATING_STORE_TEMP_PATH "Ratings.tmp"			//The snapshot is written here first, then replaces RATING_STORE_PATH
+#define RATING_STORE_MAGIC 0x474E5452					//'RTNG'
+#define RATING_INITIAL 1200
+#define RATING_SCALE 400.0								//A RATING_SCALE difference means 10:1 expected odds
+#define RATING_K_FACTOR 20
+#define RATING_PROVISIONAL_K_FACTOR 40
+#define RATING_PROVISIONAL_GAMES 30
+
+	//Game journal constants - the Game Room opener records every game (pairing, initial numbers, rounds & outcome) into a bounded ring without
+	// any lock (GameJournalTools.c). A writer thread appends the ring's records to the journal file & flushes the file once per batch (group commit),
+	// so a round never waits for the disk. The journal is only appended to, and is decoded & replayed by the GAME_JOURNAL_REPLAY build
+#define GAME_JOURNAL_RING_CAPACITY 1024				//Records - MUST be a power of 2 (a full ring drops new records & counts them)
+#define GAME_JOURNAL_COMMIT_INTERVAL_MS 50			//The writer commits a batch every 50ms
+#define GAME_JOURNAL_PATH "GameJournal.bin"			//Relative Path to Server process files ONLY
+#define GAME_JOURNAL_MAGIC 0x4C4E524A				//'JRNL' - every record starts with it
+
+	//Game history index constants - the finished games of the journal are folded into a memory-mapped file (GameHistoryIndexTools.c) of
+	// per-player records & columns of game entries (a game is an entry per player), so a player's last games & win rate are read without a lock.
+	// The index is folded incrementally - only the journal records appended since the last fold are read - and is mapped as is when the Server starts
+#define GAME_HISTORY_INDEX_PATH "GameHistory.idx"		//Relative Path to Server process files ONLY
+#define GAME_HISTORY_INDEX_MAGIC 0x58444948				//'HIDX'
+#define GAME_HISTORY_MAX_PLAYERS 4096					//MUST be a power of 2
+#define GAME_HISTORY_MAX_ENTRIES 65536					//A full index stops folding new games
+#define GAME_HISTORY_MAX_OPEN_GAMES 16					//Journaled games being folded at once (from their PAIRING record to their OUTCOME record)
+#define GAME_HISTORY_FOLD_INTERVAL_MS 1000				//New journal records are folded every Second
+#define GAME_HISTORY_MAX_LAST_GAMES 16					//Games a single query returns at most
+#define GAME_HISTORY_MENU_GAMES 5						//Last games shown with SERVER_MAIN_MENU
+#define GAME_HISTORY_NO_ENTRY -1
+
+	//Opening book constants - the solver's decision tree of the classic variant, built offline by the OPENING_BOOK_BUILDER build of the Server
+	// (OpeningBookBuilder.c) & mapped read-only by both processes (OpeningBookTools.c) - the bot plays it and the Client offers its guesses as hints.
+	// A node is a guess & a bit per result that leads to a child node, and the children of a node are contiguous, so a move is an index computation
+#define OPENING_BOOK_PATH "OpeningBook.bin"		//Relative Path to Server & Client process files
+#define OPENING_BOOK_MAGIC 0x4B4F4F42			//'BOOK'
+#define OPENING_BOOK_MAX_DEPTH 10				//Guesses of the longest path the builder allows
+#define OPENING_BOOK_NO_NODE -1
+	//A result (bulls & cows of a classic guess) as a single code
+#define NUM_OF_SCORE_CODES ((PLAYER_NUMBER_LEN + 1) * (PLAYER_NUMBER_LEN + 1))
+#define SCORE_CODE( Bulls, Cows ) ( (BYTE)((Bulls) * (PLAYER_NUMBER_LEN + 1) + (Cows)) )
+#define SCORE_CODE_BULLS( Code ) ( (SHORT)((Code) / (PLAYER_NUMBER_LEN + 1)) )
+#define SCORE_CODE_COWS( Code ) ( (SHORT)((Code) % (PLAYER_NUMBER_LEN + 1)) )
+
+	//Candidate set constants - the classic numbers a solver still considers, a bit per number (CandidateSetTools.c). A result is filtered in with
+	// whole words - the bulls & the common digits of every number are counted at once, from the sets of numbers with a digit (at a position)
+#define CANDIDATE_SET_NUM_OF_WORDS 80			//64 bits words - NUM_OF_PLAYER_NUMBERS bits, rounded up to whole SSE2 vectors
+#define CANDIDATE_SET_NO_CANDIDATE -1
+
+	//Hot restart constants - 'restart' on the Server's STDin hands the listening socket & the Clients connections over to a new Server process
+	// (HotRestartTools.c). A Worker thread is handed over only while it awaits its Client, or its opponent in the middle of an exchange - it parks
+	// there, and the new process resumes it at the same step. The sockets are duplicated with WSADuplicateSocket(.) & sent, with the Game Room &
+	// the Worker threads state, over an anonymous pipe:	server.exe <port> [<variant>] --handoff <state pipe> <ack pipe> <old process id>
+#define HOT_RESTART_ARGUMENT "--handoff"
+#define HOT_RESTART_NUM_OF_ARGUMENTS 4
+#define HOT_RESTART_QUIESCE_TIMEOUT_MS 45000			//Every Worker thread must park within 45 Seconds (a matchmaking wait ends within 30) or the restart is cancelled
+#define HOT_RESTART_QUIESCE_POLL_MS 100
+#define HOT_RESTART_OLD_PROCESS_EXIT_TIMEOUT_MS 30000	//The new process waits for the old one to leave, before it opens the journal & the stores
+#define HOT_RESTART_STATE_MAGIC 0x31425248				//"HRB1" - the layout of the state sent over the pipe
+#define HOT_RESTART_ACK 'A'								//Sent back by the new process once it owns the sockets
+#define HOT_RESTART_COMMAND_LINE_LEN 1024
+	//Strings of a parked Worker thread that were set (their pointers aren't sent, the new process points them at the same storage)
+#define HOT_RESTART_SELF_NAME 0x01
+#define HOT_RESTART_OTHER_NAME 0x02
+#define HOT_RESTART_SELF_INITIAL_NUMBER 0x04
+#define HOT_RESTART_OTHER_INITIAL_NUMBER 0x08
+#define HOT_RESTART_SELF_GUESS 0x10
+#define HOT_RESTART_OTHER_GUESS 0x20
+
+	//Room snapshot constants - every Worker thread checkpoints its game (names, initial numbers, round & pending guess) at the phase boundaries into a
+	// memory-mapped file (RoomSnapshotTools.c). A Worker thread owns two records & writes the one its last checkpoint isn't in, then publishes it, so
+	// a checkpoint is a copy into memory that never waits & never tears the previous one. The records outlive a crash of the Server process (the
+	// system writes the mapped pages back) - the restarted Server reads them back & a player paired again with its opponent resumes their game
+#define ROOM_SNAPSHOT_PATH "RoomSnapshots.bin"		//Relative Path to Server process files ONLY
+#define ROOM_SNAPSHOT_MAGIC 0x504E5352				//'RSNP'
+#define ROOM_SNAPSHOT_NUM_OF_BUFFERS 2				//Records per Worker thread - MUST be a power of 2
+#define ROOM_SNAPSHOT_NUM_OF_SEATS 2				//A recovered game is the records of both its players' Worker threads
+#define ROOM_SNAPSHOT_MAX_RECOVERED_GAMES ( NUM_OF_WORKER_THREADS / ROOM_SNAPSHOT_NUM_OF_SEATS )
+
+	//Session token constants - SERVER_APPROVED carries a session token the Client presents in its next CLIENT_REQUEST (SessionTokenTools.c). A Client
+	// whose connection drops while its Worker thread awaits its initial number or guess has a grace period to reconnect: the Worker thread holds the
+	// game, & a CLIENT_REQUEST with the token hands the new connection over to it (a token hash table lookup) - the Client goes on from the pending
+	// request, without the main menu:		SERVER_APPROVED:<token>[;<reattached phase>[;<results index>]]		CLIENT_REQUEST:<name>[;<token>]
+	// A reattached guessing game's last SERVER_GAME_RESULTS is sent again before the move request - the results index (the # of results sent since the
+	// game's SERVER_SETUP_REQUSET) lets a Client that already showed them skip them
+#define SESSION_TOKEN_STRING_LEN 17					//16 hex digits & '\0'
+#define SESSION_TABLE_BITS 6						//64 buckets, far more than Worker threads - a lookup probes a bucket or two
+#define SESSION_TABLE_CAPACITY (1 << SESSION_TABLE_BITS)
+#define SESSION_RECONNECT_GRACE_PERIOD 30000		//A game waits 30 Seconds for its dropped Client
+#define SESSION_REATTACH_REQUEST_TIMEOUT 2000		//With no idle Worker thread while a game is held, the main thread waits 2 Seconds for a connection's CLIENT_REQUEST
+#define SESSION_REATTACHED_SETUP "1"				//The pending request is SERVER_SETUP_REQUSET
+#define SESSION_REATTACHED_GUESSING "2"				//The pending request is SERVER_PLAYER_MOVE_REQUEST
+#define SESSION_REATTACHED_PHASE_LEN 2
+#define SESSION_RESULTS_INDEX_LEN 12				//A LONG in decimal & '\0'
 
 
 	//"Exit" "Error" events status constants
 #define KEEP_GOING 0
 #define STATUS_SERVER_ERROR -1
 #define STATUS_SERVER_EXIT -2
+#define STATUS_SERVER_HANDOFF -3
+
+	//Game Room state word layout - a single LONG accessed ONLY with Interlocked functions:
+	//	bits 0-7 phase  |  bits 8-9 quit flags (one per player slot)  |  bits 16-30 epoch (a new epoch per game)
+#define GAME_ROOM_PHASE_MASK 0x000000FF
+#define GAME_ROOM_QUIT_FLAGS_SHIFT 8
+#define GAME_ROOM_QUIT_FLAGS_MASK 0x00000300
+#define GAME_ROOM_EPOCH_SHIFT 16
+#define GAME_ROOM_EPOCH_MASK 0x7FFF0000
+
+#define GAME_ROOM_PHASE( Word ) ( (Word) & GAME_ROOM_PHASE_MASK )
+#define GAME_ROOM_QUIT_FLAG( Slot ) ( 1 << (GAME_ROOM_QUIT_FLAGS_SHIFT + (Slot)) )
+#define GAME_ROOM_EPOCH( Word ) ( ((Word) & GAME_ROOM_EPOCH_MASK) >> GAME_ROOM_EPOCH_SHIFT )
+#define GAME_ROOM_STATE_WORD( Epoch, QuitFlags, Phase ) ( (((Epoch) << GAME_ROOM_EPOCH_SHIFT) & GAME_ROOM_EPOCH_MASK) | ((QuitFlags) & GAME_ROOM_QUIT_FLAGS_MASK) | ((Phase) & GAME_ROOM_PHASE_MASK) )
+#define GAME_ROOM_OPENER_SLOT 0		//Second arriver - opens the room & is the first to write to GameSession.txt
+#define GAME_ROOM_JOINER_SLOT 1		//First arriver
+
+	//Players data exchange types (names, initial numbers, guesses) are exchanged at the pairing, setup & guessing Worker phases respectively
+#define WORKER_PHASE_OF_DATA_TYPE( DataType ) ( (workerPhases)(WORKER_PHASE_PAIRING + (DataType) - 1) )
 
 
 
@@ -112,7 +323,71 @@ typedef enum { CHARACTER_IS_DIGIT, CHARACTER_IS_UPPER_CASE, CHARACTER_IS_LOWER_C
 typedef enum { STATUS_TIMEDOUT, STATUS_OWNED_SIGNALED, STATUS_ABONDAND, STATUS_FAILED } waitEnums;
 
 
-typedef enum { TRANSFER_FAILED, TRANSFER_SUCCEEDED, TRANSFER_TIMEOUT, TRANSFER_DISCONNECTED, TRANSFER_PREVENTED } transferResults;
+typedef enum { TRANSFER_FAILED, TRANSFER_SUCCEEDED, TRANSFER_TIMEOUT, TRANSFER_DISCONNECTED, TRANSFER_PREVENTED, TRANSFER_ABORTED } transferResults;
+
+typedef enum { GAME_ROOM_IDLE, GAME_ROOM_SETUP, GAME_ROOM_GUESSING, GAME_ROOM_CLOSED } gameRoomPhases;
+
+	//The steps a Worker thread parks at during a hot restart - awaiting its Client's response to the main menu, SERVER_SETUP_REQUSET or
+	// SERVER_PLAYER_MOVE_REQUEST, or awaiting its opponent after it received its Client's initial number or guess
+typedef enum { WORKER_NOT_PARKED, WORKER_PARKED_MAIN_MENU, WORKER_PARKED_SETUP, WORKER_PARKED_SETUP_EXCHANGE, WORKER_PARKED_PLAYER_MOVE, WORKER_PARKED_MOVE_EXCHANGE } workerParkPoints;
+
+	//Room snapshot phases - no game, the player's initial number was received, or both initial numbers were exchanged & the rounds are played
+typedef enum { ROOM_SNAPSHOT_EMPTY, ROOM_SNAPSHOT_SETUP, ROOM_SNAPSHOT_GUESSING } roomSnapshotPhases;
+
+	//Session states - the Client is connected, its Worker thread holds the game for its reconnection, or a reconnection was handed to it
+typedef enum { SESSION_CONNECTED, SESSION_HELD, SESSION_REATTACHED } sessionStates;
+
+	//gameVariant structure describes the rules of a game. Its scorer is chosen once, when the variant is set (GameVariantTools.c) - a kernel
+	// specialized at compile time for the common shapes (4x10, 5x10 & 6x16 with distinct symbols), the generic kernel otherwise
+typedef struct _gameVariant {
+	SHORT numberLength;						// # of symbols of an initial number or a guess
+	SHORT alphabetSize;						// # of symbols to choose from - '0'-'9' then 'a'-'f'
+	BOOL isRepeatAllowed;					// TRUE if a symbol may appear more than once in a number
+	void (*p_scoreGuess)(const char* p_secretNumber, const char* p_guessNumber, SHORT* p_bulls, SHORT* p_cows);
+}gameVariant;
+
+typedef enum { PLAYER_RESET_ROUND, PLAYER_RESET_GAME, PLAYER_RESET_CONNECTION } playerResetScopes;
+
+	//Outcome of a game round, of the "self" player - judged once (GameVariantTools.c) for the Worker threads & the offline builds alike
+typedef enum { GAME_ROUND_CONTINUES, GAME_ROUND_SELF_WINS, GAME_ROUND_OTHER_WINS, GAME_ROUND_DRAW } gameRoundOutcomes;
+
+	//Worker thread phases, as seen by the metrics registry (timeouts & opponent waiting durations are recorded per phase)
+typedef enum { WORKER_PHASE_ADMISSION, WORKER_PHASE_MAIN_MENU, WORKER_PHASE_PAIRING, WORKER_PHASE_SETUP, WORKER_PHASE_GUESSING, NUM_OF_WORKER_PHASES } workerPhases;
+
+typedef enum { SLAB_MESSAGE, SLAB_PARAMETER, SLAB_MESSAGE_STRING, SLAB_SMALL_BUFFER, NUM_OF_SLAB_OBJECT_TYPES } slabObjectTypes;
+
+typedef enum { LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARNING, LOG_LEVEL_ERROR, LOG_LEVEL_NONE, NUM_OF_LOG_LEVELS } logLevels;
+
+	//High watermark policies of a send queue
+typedef enum { SEND_QUEUE_POLICY_DROP, SEND_QUEUE_POLICY_PARK, SEND_QUEUE_POLICY_COALESCE } sendQueuePolicies;
+
+	//Matchmaking pairing modes, tickets states & outcomes (the outcomes are counted by the metrics registry)
+typedef enum { MATCHMAKING_MODE_FIFO, MATCHMAKING_MODE_SKILL_BUCKETS } matchmakingModes;
+typedef enum { MATCHMAKING_TICKET_IDLE, MATCHMAKING_TICKET_WAITING, MATCHMAKING_TICKET_MATCHED, MATCHMAKING_TICKET_CANCELLED } matchmakingTicketStates;
+typedef enum { MATCHMAKING_MATCHED_PLAYER, MATCHMAKING_MATCHED_BOT, MATCHMAKING_NO_OPPONENT, MATCHMAKING_ABORTED, MATCHMAKING_FAILED, NUM_OF_MATCHMAKING_OUTCOMES } matchmakingOutcomes;
+
+	//Rated game outcomes, of the first player - the value is twice the player's score
+typedef enum { RATING_OUTCOME_LOSS, RATING_OUTCOME_DRAW, RATING_OUTCOME_WIN } ratingOutcomes;
+
+	//Game journal record types - a SESSION record marks a Server start (Game Room epochs start over), a game is its PAIRING record & the records of its epoch that follow
+typedef enum { JOURNAL_RECORD_SESSION, JOURNAL_RECORD_PAIRING, JOURNAL_RECORD_SETUP, JOURNAL_RECORD_ROUND, JOURNAL_RECORD_OUTCOME, NUM_OF_JOURNAL_RECORD_TYPES } journalRecordTypes;
+
+	//Event ids of the event logger - every id has a level & a format (EventLoggingTools.c) applied to the event's description & two arguments
+typedef enum {
+	LOG_EVENT_BAD_INPUTS,				//ERROR   - a function received bad inputs
+	LOG_EVENT_FAILURE,					//ERROR   - description: what failed
+	LOG_EVENT_ALLOCATION_FAILURE,		//ERROR   - description: what failed to be allocated
+	LOG_EVENT_WINAPI_FAILURE,			//ERROR   - description: the failed operation, argument: GetLastError()
+	LOG_EVENT_WINSOCK_FAILURE,			//ERROR   - description: the failed operation, argument: WSAGetLastError()
+	LOG_EVENT_UNEXPECTED,				//ERROR   - description: what was not supposed to happen, argument: the unexpected value
+	LOG_EVENT_MESSAGE_FAILURE,			//ERROR   - description: what failed with the message, argument: the message type
+	LOG_EVENT_TIMEOUT,					//WARNING - description: what reached its timeout
+	LOG_EVENT_CONNECTION,				//INFO    - description: a connection\disconnection\approval event, argument: a related value
+	LOG_EVENT_THREAD_EXIT,				//INFO    - description: why the thread is exiting
+	LOG_EVENT_COMMUNICATION_RESULT,		//DEBUG   - description: the step, argument: its 'communicationResults' or 'transferResults' value
+	LOG_EVENT_TRACE,					//DEBUG   - description: what is traced, arguments: the traced values
+	NUM_OF_LOG_EVENTS
+} logEventIds;
 
 
 
@@ -125,7 +400,8 @@ typedef enum {
 	PLAYER_DISCONNECTED,		//Player sent message "CLIENT_DISCONNECT" at "SERVER_MAIN_MENU" phase
 	SERVER_DENIED_COMM,			//Server declined a Client Connection with "SERVER_DENIED". (main reason - 3rd player)
 	BACK_TO_MENU,				//Mid way output - looping back to either Connection menu or Server main menu
-	COMMUNICATION_EXIT			//"EXIT" or "ERROR" events were set - turned signaled
+	COMMUNICATION_EXIT,			//"EXIT" or "ERROR" events were set - turned signaled
+	CLIENT_REATTACHED			//A reconnected Client's connection was handed to the Worker thread that holds its game (SessionTokenTools.c)
 } communicationResults;
 
 
@@ -159,19 +435,398 @@ typedef struct _messageString {
 
 
 
-
+	//slabBlockHeader structure precedes every object handed out by the slab allocator (SlabAllocationTools.c). The object itself starts right after it
+typedef struct _slabBlockHeader {
+	struct _slabThreadCache* p_ownerCache;		// pointer to the slab cache the block belongs to, or NULL if the block was allocated directly from the Heap
+	struct _slabBlockHeader* p_nextFreeBlock;	// pointer to the next block in a free list (meaningless while the block is in use)
+	slabObjectTypes objectType;					// the free list the block returns to
+}slabBlockHeader;
+
+	//slabChunk structure heads every Heap allocation a slab cache makes. SLAB_BLOCKS_PER_CHUNK blocks follow it
+typedef struct _slabChunk {
+	struct _slabChunk* p_nextChunk;				// pointer to the next chunk of the same slab cache
+}slabChunk;
+
+	//slabStatistics structure contains the allocation counters of a slab cache, or of all the slab caches together
+typedef struct _slabStatistics {
+	LONG allocations[NUM_OF_SLAB_OBJECT_TYPES];				// # of objects handed out
+	LONG localFrees[NUM_OF_SLAB_OBJECT_TYPES];				// # of objects returned by the owner thread
+	LONG remoteFrees[NUM_OF_SLAB_OBJECT_TYPES];				// # of objects returned by other threads (cross-thread return)
+	LONG chunksAllocated[NUM_OF_SLAB_OBJECT_TYPES];			// # of Heap allocations made to grow the slabs
+	LONG heapBufferAllocations;								// # of buffers longer than SLAB_SMALL_BUFFER_SIZE (allocated from the Heap)
+	LONG numOfThreadCaches;									// # of slab caches (filled only when fetching the statistics of all caches)
+}slabStatistics;
+
+	//logEventRecord structure is a single binary event in a thread's log ring - the strings are NOT copied, thus they MUST be string literals
+	// (or __FILE__\__func__). It is formatted by the formatter thread only. One record fills one cache line (64 bit)
+typedef struct _logEventRecord {
+	LONGLONG timestampTicks;				// QueryPerformanceCounter(.) ticks at the time the event was logged
+	const char* p_description;				// string literal describing the event (may be NULL)
+	const char* p_file;						// __FILE__
+	const char* p_function;					// __func__
+	LONGLONG arguments[2];					// the event's arguments (error codes, values, results..)
+	int lineNumber;							// __LINE__
+	DWORD threadId;							// the thread that logged the event
+	logEventIds eventId;					// the event id (selects the level & the format)
+}logEventRecord;
+
+	//logRing structure is a single-producer single-consumer ring of events: the owner thread writes events without any lock and the formatter
+	// thread reads them. The producer, consumer & registry fields are on separate cache lines, so both sides never write the same line
+typedef CACHE_ALIGNED struct _logRing {
+	//.....Producer (owner thread)
+	volatile LONG writeIndex;				// # of events ever written (the next write position, masked by LOG_RING_CAPACITY - 1)
+	LONG cachedReadIndex;					// the producer's last sample of 'readIndex', 'readIndex' is re-read ONLY when the ring seems full
+	volatile LONG droppedEvents;			// # of events dropped since the ring was full
+	//.....Consumer (formatter thread)
+	CACHE_ALIGNED volatile LONG readIndex;	// # of events ever read
+	LONG reportedDroppedEvents;				// # of dropped events the formatter already reported
+	//.....Registry - under the registry lock
+	CACHE_ALIGNED DWORD ownerThreadId;		// 0 while the ring is orphaned (its thread exited)
+	struct _logRing* p_nextRing;			// pointer to the next ring in the rings registry (never changes once registered)
+	//.....Events
+	CACHE_ALIGNED logEventRecord events[LOG_RING_CAPACITY];
+}logRing;
+
+	//metricsHistogram structure is a log-linear latency histogram of a single shard. Written ONLY with Interlocked functions (a thread may
+	// migrate to another processor in the middle of a record), read by snapshots without any lock
+typedef struct _metricsHistogram {
+	volatile LONG buckets[METRICS_HISTOGRAM_NUM_OF_BUCKETS];	// # of values recorded into every bucket
+	volatile LONG64 sumMicroseconds;							// sum of all the recorded values
+	volatile LONG64 maxMicroseconds;							// largest recorded value
+}metricsHistogram;
+
+	//metricsShard structure holds the counters & histograms recorded by the threads running on a single processor. Every shard starts
+	// on its own cache line, so threads on different processors never write the same line
+typedef CACHE_ALIGNED struct _metricsShard {
+	volatile LONG64 messagesSent[NUM_OF_MESSAGE_TYPES];			// # of messages sent, per message type
+	volatile LONG64 bytesSent[NUM_OF_MESSAGE_TYPES];			// # of bytes sent (length prefix included), per message type
+	volatile LONG64 messagesReceived[NUM_OF_MESSAGE_TYPES];		// # of messages received, per message type
+	volatile LONG64 bytesReceived[NUM_OF_MESSAGE_TYPES];		// # of bytes received (length prefix included), per message type
+	volatile LONG64 timeouts[NUM_OF_WORKER_PHASES];				// # of timeouts, per Worker phase
+	volatile LONG64 admissionDenials;							// # of Clients declined with SERVER_DENIED
+	volatile LONG64 invalidPlayerNumbers;						// # of CLIENT_SETUP\CLIENT_PLAYER_MOVE numbers the Game Room's variant does not allow
+	volatile LONG64 matchmakingOutcomes[NUM_OF_MATCHMAKING_OUTCOMES];	// # of CLIENT_VERSUS requests, per matchmaking outcome
+	metricsHistogram sendTime[NUM_OF_MESSAGE_TYPES];			// message construction & send(.) duration, per message type
+	metricsHistogram parseTime[NUM_OF_MESSAGE_TYPES];			// received message translation duration, per message type
+	metricsHistogram opponentWaitTime[NUM_OF_WORKER_PHASES];	// time spent blocked on the opponent's Worker thread, per Worker phase
+	metricsHistogram roundDuration;								// a whole guessing round (move request -> results sent)
+	metricsHistogram matchLatency;								// CLIENT_VERSUS received -> opponent found
+}metricsShard;
+
+	//metricsHistogramSnapshot structure is a histogram merged from all the shards
+typedef struct _metricsHistogramSnapshot {
+	LONG64 buckets[METRICS_HISTOGRAM_NUM_OF_BUCKETS];
+	LONG64 count;												// # of recorded values (sum of all the buckets)
+	LONG64 sumMicroseconds;
+	LONG64 maxMicroseconds;
+}metricsHistogramSnapshot;
+
+	//metricsSnapshot structure holds all the metrics merged from all the shards. It is large (~100KB) - allocate it on the Heap
+typedef struct _metricsSnapshot {
+	LONG64 messagesSent[NUM_OF_MESSAGE_TYPES];
+	LONG64 bytesSent[NUM_OF_MESSAGE_TYPES];
+	LONG64 messagesReceived[NUM_OF_MESSAGE_TYPES];
+	LONG64 bytesReceived[NUM_OF_MESSAGE_TYPES];
+	LONG64 timeouts[NUM_OF_WORKER_PHASES];
+	LONG64 admissionDenials;
+	LONG64 invalidPlayerNumbers;
+	LONG64 matchmakingOutcomes[NUM_OF_MATCHMAKING_OUTCOMES];
+	metricsHistogramSnapshot sendTime[NUM_OF_MESSAGE_TYPES];
+	metricsHistogramSnapshot parseTime[NUM_OF_MESSAGE_TYPES];
+	metricsHistogramSnapshot opponentWaitTime[NUM_OF_WORKER_PHASES];
+	metricsHistogramSnapshot roundDuration;
+	metricsHistogramSnapshot matchLatency;
+	int numOfShards;											// # of shards merged into the snapshot
+}metricsSnapshot;
+
+	//slabThreadCache structure is owned by a single thread, which allocates & frees objects through its free lists without any lock.
+	// Other threads return objects to the remote free lists with InterlockedCompareExchangePointer, and the owner takes them back
+	// all at once when its free list runs empty. When the owner thread exits, the cache is orphaned & adopted by the next new thread.
+	// The fields written by other threads start on their own cache line, so cross-thread returns don't invalidate the owner's free lists & counters
+typedef CACHE_ALIGNED struct _slabThreadCache {
+	//.....Owner thread ONLY
+	slabBlockHeader* p_freeLists[NUM_OF_SLAB_OBJECT_TYPES];					// free lists of the owner thread
+	slabStatistics statistics;												// this cache's counters (remoteFrees is kept below)
+	slabChunk* p_chunks;													// all chunks allocated by this cache (freed when the allocator is destroyed)
+	//.....Written by other threads
+	CACHE_ALIGNED slabBlockHeader* volatile p_remoteFreeLists[NUM_OF_SLAB_OBJECT_TYPES];	// pushed by other threads, emptied by the owner thread
+	volatile LONG remoteFrees[NUM_OF_SLAB_OBJECT_TYPES];					// # of objects returned by other threads (InterlockedIncrement)
+	//.....Registry - under the registry lock
+	CACHE_ALIGNED DWORD ownerThreadId;										// 0 while the cache is orphaned
+	struct _slabThreadCache* p_nextCache;									// pointer to the next cache in the caches registry
+}slabThreadCache;
+
+
+
+	//sendQueueFrame structure describes a single frame held by a send queue
+typedef struct _sendQueueFrame {
+	int messageType;						// message type serial number (SERVER_GAME_RESULTS frames may be coalesced)
+	int frameLength;						// # of bytes - length prefix, message & terminating zero
+}sendQueueFrame;
+
+	//sendQueue structure is the bounded outbound queue of a single connection, owned by the Worker thread serving it (Fiber Local Storage).
+	// The unsent bytes are kept contiguous from the start of the buffer - the first 'headFrameSentBytes' bytes of the head frame were already
+	// sent & removed. The depths are read by the admin thread (under the registry lock), so they are volatile
+typedef struct _sendQueue {
+	SOCKET s_socket;						// the connection's socket
+	sendQueuePolicies policy;				// applied when a frame doesn't fit below the high watermark
+	BOOL isEvicted;							// TRUE once the Client was evicted - every following send fails
+	volatile LONG queuedBytes;				// # of unsent bytes in the buffer
+	volatile LONG numOfFrames;				// # of frames in the queue (the head frame may be partly sent)
+	int headFrameSentBytes;					// # of bytes of the head frame already sent
+	sendQueueFrame frames[SEND_QUEUE_MAX_FRAMES];
+	char buffer[SEND_QUEUE_HIGH_WATERMARK];
+	struct _sendQueue* p_nextQueue;			// pointer to the next queue in the queues registry
+}sendQueue;
+
+	//spectatorFrame structure is a single encoded message (length prefix & message, as sendString(.) sends it), shared by all the spectators
+	// it was queued for. It is immutable once published, and is freed by whoever releases its last reference
+typedef struct _spectatorFrame {
+	SLIST_ENTRY publishedListEntry;			// link of the published frames list (MUST be first - aligned to MEMORY_ALLOCATION_ALIGNMENT)
+	volatile LONG referenceCount;			// one per spectator queue holding the frame, and one while the frame is published
+	int frameLength;						// # of bytes - length prefix & message
+	char* p_frameBytes;						// the bytes, right after the struct (same allocation)
+}spectatorFrame;
+
+	//spectator structure is the connection of a single spectator & its ring of frame references - touched ONLY by the fan-out thread.
+	// The first 'headFrameSentBytes' bytes of the head frame were already sent
+typedef struct _spectator {
+	SOCKET s_socket;						// the spectator's socket (non-blocking), INVALID_SOCKET if the slot is free
+	int headIndex;							// ring index of the head frame
+	int numOfFrames;						// # of frames in the ring
+	int headFrameSentBytes;
+	spectatorFrame* p_frames[SPECTATOR_QUEUE_CAPACITY];
+}spectator;
+
+	//sendQueueStatistics structure contains the depths of all the send queues & the policies counters
+typedef struct _sendQueueStatistics {
+	LONG numOfQueues;						// # of attached queues (connections)
+	LONG queuedBytes;						// # of unsent bytes in all the queues
+	LONG queuedFrames;						// # of frames in all the queues
+	LONG maxQueuedBytes;					// depth of the deepest queue
+	LONG evictions;							// # of Clients evicted (dropped, parked too long, or still over after coalescing)
+	LONG parks;								// # of times a Worker thread was parked until its Client read
+	LONG coalescedFrames;					// # of SERVER_GAME_RESULTS frames removed before being sent
+}sendQueueStatistics;
+
+
+
+
+
+
+
+
+	//gameRoom structure holds the state shared by the two Worker threads of a single game. The state word is read & modified ONLY with
+	// Interlocked functions, and every time a quit flag is raised the manual-reset quit Event is set, so the other Worker thread wakes up
+	// from its waits (players events, recv(.)) immediately rather than when its own timeout expires.
+	// Both Worker threads write the state word, so the room is aligned to a cache line of its own
+typedef CACHE_ALIGNED struct _gameRoom {
+	volatile LONG roomStateWord;			// phase, quit flags & epoch packed as described by the GAME_ROOM_ macros
+	HANDLE* p_h_roomQuitEvent;				// pointer to the manual-reset Event signaled when one of the players quits the current epoch
+	gameVariant variant;					// the rules of the room's games - set when the room is created & only read afterwards
+}gameRoom;
+
+
+
+	//matchmakingTicket structure is the waiting entry of a single player. Tickets are pre-allocated, kept in an interlocked free list while idle,
+	// and never freed while the Server runs, so a queue entry may always be dereferenced. A waiting ticket is claimed by its opponent
+	// with a single InterlockedCompareExchange on the state word (WAITING -> MATCHED), or cancelled the same way by its owner (WAITING -> CANCELLED)
+typedef CACHE_ALIGNED struct _matchmakingTicket {
+	SLIST_ENTRY freeListEntry;				// link of the free tickets list (MUST be first - aligned to MEMORY_ALLOCATION_ALIGNMENT)
+	volatile LONG stateWord;				// state & generation packed as described by the MATCHMAKING_TICKET_ macros
+	BOOL isBot;								// TRUE if the waiting player is the Server's bot
+	volatile BOOL isOpponentBot;			// written by the opponent before it signals the matched Event
+	HANDLE h_matchedEvent;					// auto-reset Event signaled by the opponent that claimed the ticket
+}matchmakingTicket;
+
+	//matchmakingCell structure is a single entry of a matchmaking queue. Its sequence tells whether the cell is free for the enqueue at
+	// a given position, or holds the entry for the dequeue at that position (bounded multi-producer multi-consumer ring)
+typedef struct _matchmakingCell {
+	volatile LONG sequence;
+	matchmakingTicket* p_ticket;			// the waiting ticket
+	LONG waitingStateWord;					// the ticket's state word while it waits (the comparand of the claim)
+}matchmakingCell;
+
+	//matchmakingQueue structure is the waiting queue of a single rating bucket. The enqueue & dequeue positions are advanced with
+	// InterlockedCompareExchange only, each on a cache line of its own
+typedef CACHE_ALIGNED struct _matchmakingQueue {
+	volatile LONG enqueuePosition;
+	CACHE_ALIGNED volatile LONG dequeuePosition;
+	CACHE_ALIGNED matchmakingCell cells[MATCHMAKING_QUEUE_CAPACITY];
+}matchmakingQueue;
+
+
+
+	//ratingRecord structure is the rating of a single player name (an empty name marks a free slot). The snapshot file is a ratingSnapshotHeader
+	// followed by the records
+typedef struct _ratingRecord {
+	char playerName[MAX_PLAYER_NAME_LEN + 1];
+	LONG rating;
+	LONG gamesPlayed;
+}ratingRecord;
+
+typedef struct _ratingSnapshotHeader {
+	DWORD magic;							// RATING_STORE_MAGIC
+	DWORD numOfRecords;
+}ratingSnapshotHeader;
+
+	//ratingStoreShard structure is an open addressing (linear probing) table of the names that hash to the shard, and its lock -
+	// shared by lookups, exclusive for updates. Names are never removed
+typedef CACHE_ALIGNED struct _ratingStoreShard {
+	SRWLOCK lock;
+	int numOfRecords;
+	ratingRecord records[RATING_STORE_SHARD_CAPACITY];
+}ratingStoreShard;
+
+
+
+	//gameJournalRecord structure is a single record of the game journal, as written to the file. The two fields hold the opener's & the joiner's
+	// names (PAIRING), initial numbers (SETUP) or guesses (ROUND). The results are the bulls & cows of the opener's guess, then of the joiner's guess (ROUND),
+	// the game variant - number length, alphabet size & repeats (SETUP), or the opener's 'ratingOutcomes' value (OUTCOME)
+typedef struct _gameJournalRecord {
+	LONGLONG timestamp;						// UTC, as a FILETIME (100ns intervals since 1601)
+	DWORD magic;							// GAME_JOURNAL_MAGIC
+	LONG gameEpoch;							// the Game Room epoch of the game
+	SHORT recordType;						// 'journalRecordTypes' value
+	SHORT results[4];
+	char openerField[MAX_PLAYER_NAME_LEN + 1];
+	char joinerField[MAX_PLAYER_NAME_LEN + 1];
+}gameJournalRecord;
+
+	//gameJournalCell structure is a single entry of the journal ring. Its sequence tells whether the cell is free for the record at a given position,
+	// or holds the record for the writer (bounded multi-producer single-consumer ring)
+typedef struct _gameJournalCell {
+	volatile LONG sequence;
+	gameJournalRecord record;
+}gameJournalCell;
+
+	//gameJournalRing structure is the journal ring. Worker threads reserve positions with InterlockedCompareExchange, the writer thread alone
+	// advances the commit position - each on a cache line of its own
+typedef CACHE_ALIGNED struct _gameJournalRing {
+	volatile LONG enqueuePosition;
+	volatile LONG droppedRecords;
+	CACHE_ALIGNED LONG commitPosition;
+	CACHE_ALIGNED gameJournalCell cells[GAME_JOURNAL_RING_CAPACITY];
+}gameJournalRing;
+
+
+
+	//gameHistoryIndexHeader structure starts the game history index file. It is followed by the player records (GAME_HISTORY_MAX_PLAYERS), then by
+	// the entries columns (GAME_HISTORY_MAX_ENTRIES each): game ids, timestamps, previous entries, # of rounds, outcomes & opponents names
+typedef CACHE_ALIGNED struct _gameHistoryIndexHeader {
+	DWORD magic;							// GAME_HISTORY_INDEX_MAGIC
+	DWORD maxPlayers;						// GAME_HISTORY_MAX_PLAYERS & GAME_HISTORY_MAX_ENTRIES of when the file was created -
+	DWORD maxEntries;						//  a file of other sizes is rebuilt
+	volatile LONG numOfEntries;
+	LONG numOfSessions;						// SESSION records folded so far - a game id is the session's serial number & the game's epoch
+	LONGLONG journalOffset;					// bytes of the journal folded so far
+}gameHistoryIndexHeader;
+
+	//gameHistoryPlayer structure is the record of a single player name (an open addressing table keyed by the name's hash). Only the folding thread
+	// writes it, between two increments of its version (odd while written), so a reader retries until it reads the same even version before & after
+typedef struct _gameHistoryPlayer {
+	volatile LONG version;
+	char playerName[MAX_PLAYER_NAME_LEN + 1];
+	LONG lastEntry;							// the player's latest entry (GAME_HISTORY_NO_ENTRY if none) - each entry links to the player's previous one
+	LONG numOfGames;
+	LONG numOfWins;
+	LONG numOfDraws;
+}gameHistoryPlayer;
+
+	//gameHistoryEntry & gameHistory structures hold the answer of a player history query - its counts & its latest games, latest first
+typedef struct _gameHistoryEntry {
+	LONGLONG gameId;
+	LONGLONG timestamp;						// the game's end, UTC, as a FILETIME
+	char opponentName[MAX_PLAYER_NAME_LEN + 1];
+	SHORT numOfRounds;
+	ratingOutcomes outcome;					// of the queried player
+}gameHistoryEntry;
+
+typedef struct _gameHistory {
+	LONG numOfGames;
+	LONG numOfWins;
+	LONG numOfDraws;
+	int numOfLastGames;
+	gameHistoryEntry lastGames[GAME_HISTORY_MAX_LAST_GAMES];
+}gameHistory;
+
+	//foldedGame structure holds a journaled game while it is folded - from its PAIRING record to its OUTCOME record
+typedef struct _foldedGame {
+	BOOL isOpen;
+	LONG gameEpoch;
+	char playerNames[2][MAX_PLAYER_NAME_LEN + 1];	// the Game Room opener, then the joiner
+	SHORT numOfRounds;
+}foldedGame;
+
+	//openingBookHeader structure starts the opening book file, followed by its nodes - the root first
+typedef struct _openingBookHeader {
+	DWORD magic;							// OPENING_BOOK_MAGIC
+	DWORD numberLength;						// PLAYER_NUMBER_LEN of the book
+	LONG numOfNodes;
+	LONG maxDepth;							// guesses of the longest path
+}openingBookHeader;
+
+	//openingBookNode structure is a node of the opening book - the guess, and the results that lead to a child node (a bit per score code). The children
+	// are contiguous from the first one, ordered by score code - the child of a result is the first child + the # of lower results that have a child
+typedef struct _openingBookNode {
+	char guess[PLAYER_NUMBER_LEN];			// not terminated
+	ULONG childrenMask;
+	LONG firstChild;
+}openingBookNode;
+
+	//candidateSet structure is a set of classic numbers - bit n is the nth number of 4 distinct digits, in increasing order
+typedef CACHE_ALIGNED struct _candidateSet {
+	ULONGLONG words[CANDIDATE_SET_NUM_OF_WORDS];
+}candidateSet;
+
+
+
+	//playerNumbers & playerNames structures hold, inline, the storage of all the players strings a Worker thread needs during a game, so receiving a name,
+	// an initial number or a guess never allocates. The 'workingThreadPackage' string pointers point into this storage while the string is valid
+	// and are NULL otherwise, thus a reset (end of round\game\connection) is done by pointing them to NULL.
+	// The numbers are read at every round & the names only once per game, so they are kept apart (hot & cold cache lines of the package)
+typedef struct _playerNumbers {
+	char selfInitialNumber[MAX_PLAYER_NUMBER_LEN + 1];
+	char otherInitialNumber[MAX_PLAYER_NUMBER_LEN + 1];
+	char selfCurrentGuess[MAX_PLAYER_NUMBER_LEN + 1];
+	char otherCurrentGuess[MAX_PLAYER_NUMBER_LEN + 1];
+}playerNumbers;
+
+typedef struct _playerNames {
+	char selfPlayerName[MAX_PLAYER_NAME_LEN + 1];
+	char otherPlayerName[MAX_PLAYER_NAME_LEN + 1];
+}playerNames;
+
+	//The SERVER_GAME_RESULTS parameters of the last round a Worker thread sent (the opponent's name aside), sent again to a Client that reconnects
+typedef struct _roundResults {
+	LONG resultsIndex;						// # of SERVER_GAME_RESULTS sent since the game's SERVER_SETUP_REQUSET (0 - none yet) - the Client counts the same
+	char bullsAndCows[4];					// the bulls & the cows digits, each followed by '\0' (as sent)
+	char otherGuess[MAX_PLAYER_NUMBER_LEN + 1];
+}roundResults;
 
 
 
 //Thread input parameters struct (package) - This is a struct meant to combine all the inputs to a Working thread, which is a thread in the Server side
 //											 meant to communicate with a Client process (Application), and will consist the communication socket with the Server
 //											 and the pointers to all the needed synchronous objects.
-typedef struct _workingThreadPackage {
-	//Resource 1 - Number of current connected(-to-Server) Clients, will be modified identicaly to the number of existing working threads
-	USHORT* p_currentNumOfConnectedClients;	// pointer to the number of existing working threads (resource)
-	HANDLE* p_h_connectedClientsNumMutex;	// pointer to the number of existing working threads resource Mutex
+//											 The packages of all Worker threads are laid out contiguously in a single array, each starting on its own cache line.
+//											 The fields are ordered by access frequency - a game round touches ONLY the first two cache lines (hot), the rest are
+//											 touched once per game or per connection (cold).
+typedef CACHE_ALIGNED struct _workingThreadPackage {
+	//.....Hot line 1 - every message & every round
+	SOCKET* p_s_acceptSocket;				// pointer to the Server socket "accept" has outputted after accepting a Client's connection
+	gameRoom* p_gameRoom;					// pointer to the Game Room this Worker thread plays in (shared with the opponent's Worker thread)
+	int gameRoomSlot;						// GAME_ROOM_OPENER_SLOT or GAME_ROOM_JOINER_SLOT - which quit flag belongs to this Worker thread
+	LONG gameRoomEpoch;						// the epoch of the game this Worker thread currently plays - quit flags of other epochs are ignored
+	LONG gameRound;							// # of rounds of the current game played so far (reset by resetThePlayer(.))
+	char* p_selfCurrentGuess;				// pointer to the string represening the current guess number of the current Client User
+	char* p_otherCurrentGuess;				// pointer to the string represening the current guess number of the opponent Client User
+	char* p_selfInitialNumber;				// pointer to the string represening the initial number of the current Client User
+	char* p_otherInitialNumber;				// pointer to the string represening the initial number of the opponent Client User
+
+	//.....Hot line 2 - every round (GameSession.txt accessing)
 	//Resource 2 - GameSession.txt file
-	HANDLE* p_h_firstPlayerEvent;			// pointer to the Event in which a First player of two, has connected, its connection to Server was approved
+	CACHE_ALIGNED HANDLE* p_h_firstPlayerEvent;	// pointer to the Event in which a First player of two, has connected, its connection to Server was approved
 											//		and this player's Working thread in the Server side created the GameSession.txt & wrote the player's name. 
 											//		Also, it will be used to signal the Second player, during a game, that the First player Working thread has
 											//		finished writing a "guess" to the file, at every phase of the game.
@@ -183,24 +838,352 @@ typedef struct _workingThreadPackage {
 	HANDLE* p_h_exitEvent;					// pointer to the Event that will signal if "Exit" was entered in Server's STDin 										
 	HANDLE* p_h_errorEvent;					// pointer to the Event that will signal if any fatal error has occured when, for example, Heap memory allocation
 											//		failed, sync object accessing failed
-	//Most importantly
-	SOCKET* p_s_acceptSocket;				// pointer to the Server socket "accept" has outputted after accepting a Client's connection
-	char* p_selfPlayerName;					// pointer to the a string repersenting the name of the current Client User
+	playerNumbers playerNumbersStorage;		// inline storage the four number strings of hot line 1 point into (never freed, reset by resetThePlayer(.))
+
+	//.....Cold - once per game or per connection
+	CACHE_ALIGNED char* p_selfPlayerName;	// pointer to the a string repersenting the name of the current Client User
 	char* p_otherPlayerName;				// pointer to the a string repersenting the name of the opponent Client User
-	char* p_selfInitialNumber;				// pointer to the string represening the initial number of the current Client User
-	char* p_otherInitialNumber;				// pointer to the string represening the initial number of the opponent Client User
-	char* p_selfCurrentGuess;				// pointer to the string represening the current guess number of the current Client User
-	char* p_otherCurrentGuess;				// pointer to the string represening the current guess number of the opponent Client User
+	playerNames playerNamesStorage;			// inline storage the two names point into (never freed, reset by resetThePlayer(.))
+	//Resource 1 - Number of current connected(-to-Server) Clients, will be modified identicaly to the number of existing working threads
+	USHORT* p_currentNumOfConnectedClients;	// pointer to the number of existing working threads (resource)
+	HANDLE* p_h_connectedClientsNumMutex;	// pointer to the number of existing working threads resource Mutex
+	//Hot restart (HotRestartTools.c)
+	HANDLE* p_h_handoffEvent;				// pointer to the manual-reset Event signaled when 'restart' was entered - Worker threads park at their next wait
+	HANDLE* p_h_handoffCancelEvent;			// pointer to the manual-reset Event signaled when a restart is cancelled - parked Worker threads go on
+	volatile LONG parkPoint;				// the 'workerParkPoints' step this Worker thread is parked at, sampled by the main thread
+	workerParkPoints resumePoint;			// the step a handed off Worker thread resumes at, in the new Server process (then WORKER_NOT_PARKED)
+	//Room snapshots (RoomSnapshotTools.c)
+	int snapshotSlot;						// the slot of the room snapshots file this Worker thread checkpoints its game to - its package index
+	//Session tokens (SessionTokenTools.c)
+	ULONGLONG sessionToken;					// the token of the Client's session (0 - none), replaced at the next Client's admission
+	roundResults lastRoundResults;			// the last round's results sent in the current game (reset by resetThePlayer(.))
 
 }workingThreadPackage;
 
 
 
+	//handedOffConnection structure is the state of a parked Worker thread, as the old Server process sends it to the new one (hot restart)
+typedef struct _handedOffConnection {
+	WSAPROTOCOL_INFO socketInfo;			// the Client's socket, duplicated for the new process
+	workerParkPoints parkPoint;				// the step the Worker thread resumes at
+	int gameRoomSlot;
+	LONG gameRoomEpoch;
+	LONG gameRound;
+	int setStrings;							// HOT_RESTART_ flags of the strings that were set
+	playerNumbers playerNumbersStorage;
+	playerNames playerNamesStorage;
+	ULONGLONG sessionToken;					// the Client's session token (0 - none), registered again by the new process
+	roundResults lastRoundResults;			// the last round's results, sent again if the Client reconnects
+}handedOffConnection;
+
+	//hotRestartState structure is everything the old Server process sends the new one - written & read in one piece
+typedef struct _hotRestartState {
+	DWORD magic;							// HOT_RESTART_STATE_MAGIC
+	WSAPROTOCOL_INFO listeningSocketInfo;	// the listening socket, duplicated for the new process (pending connections stay in its backlog)
+	LONG roomStateWord;						// the Game Room state word - phase, quit flags & epoch
+	int numOfConnections;
+	handedOffConnection connections[NUM_OF_WORKER_THREADS];
+}hotRestartState;
+
+
+
+	//roomSnapshotRecord structure is a single checkpoint of a Worker thread's game, as written to the room snapshots file. A string that was not set
+	// at the checkpoint (the opponent's initial number before the exchange, the guesses between rounds) is empty
+typedef struct _roomSnapshotRecord {
+	DWORD magic;							// ROOM_SNAPSHOT_MAGIC
+	LONG sequence;							// the checkpoint's serial number in its slot
+	ULONG checksum;							// FNV-1a of the record from 'phase' on - a record that was torn (written back partly) is ignored
+	LONG phase;								// 'roomSnapshotPhases' value
+	LONGLONG timestamp;						// UTC, as a FILETIME (100ns intervals since 1601)
+	LONG gameRoomEpoch;
+	LONG gameRound;							// rounds played so far
+	SHORT numberLength;						// the game's variant - a game is resumed only by a Server of the same variant
+	SHORT alphabetSize;
+	BOOL isRepeatAllowed;
+	playerNames names;
+	playerNumbers numbers;					// both initial numbers, the player's pending guess of the next round & its opponent's
+}roomSnapshotRecord;
+
+	//roomSnapshotSlot structure holds the checkpoints of a single Worker thread - only that thread writes it. A checkpoint is written to the record
+	// the published one is not in, then published by its sequence, so the published record is never written (double buffering)
+typedef CACHE_ALIGNED struct _roomSnapshotSlot {
+	volatile LONG publishedSequence;
+	CACHE_ALIGNED roomSnapshotRecord records[ROOM_SNAPSHOT_NUM_OF_BUFFERS];
+}roomSnapshotSlot;
+
+	//roomSnapshotFile structure is the whole room snapshots file, as mapped
+typedef CACHE_ALIGNED struct _roomSnapshotFile {
+	DWORD magic;							// ROOM_SNAPSHOT_MAGIC
+	DWORD numOfSlots;						// NUM_OF_WORKER_THREADS of when the file was created - a file of another size is emptied
+	CACHE_ALIGNED roomSnapshotSlot slots[NUM_OF_WORKER_THREADS];
+}roomSnapshotFile;
+
+
+
+	//sessionTableEntry structure is a bucket of the session tokens hash table (linear probing). The reconnection fields are set ONLY while the
+	// Worker thread holds its game
+typedef struct _sessionTableEntry {
+	ULONGLONG token;						// 0 - an empty bucket
+	workingThreadPackage* p_package;		// the package of the Worker thread that serves the session
+	sessionStates state;
+	HANDLE h_reattachEvent;					// signaled when a reconnection is handed to the holding Worker thread
+	SOCKET* p_s_reattachedSocket;			// the reconnected Client's socket
+}sessionTableEntry;
+
+
+
 typedef struct _clientThreadPackage {
 	char* p_playerName;						// pointer to the player's name, represented by the "Client" process User
 	char* p_otherPlayerName;				// pointer to the other player's name
 	SOCKET* p_s_clientSocket;				// pointer to the Server socket "accept" has outputted after accepting a Client's connection
+	BOOL isSpectator;						// TRUE if connected to the spectators port - the Game Room is only watched
 
 }clientThreadPackage;
 
+#ifdef LAYOUT_MICROBENCHMARK
+//Layout microbenchmark structs - built ONLY when LAYOUT_MICROBENCHMARK is defined (see LayoutMicrobenchmark.c)
+	//legacyThreadPackage - the previous 'workingThreadPackage' layout: allocated one by one & pointing at strings allocated one by one
+typedef struct _legacyThreadPackage {
+	USHORT* p_currentNumOfConnectedClients;
+	HANDLE* p_h_connectedClientsNumMutex;
+	HANDLE* p_h_firstPlayerEvent;
+	HANDLE* p_h_secondPlayerEvent;
+	HANDLE* p_h_exitEvent;
+	HANDLE* p_h_errorEvent;
+	gameRoom* p_gameRoom;
+	int gameRoomSlot;
+	LONG gameRoomEpoch;
+	SOCKET* p_s_acceptSocket;
+	char* p_selfPlayerName;
+	char* p_otherPlayerName;
+	char* p_selfInitialNumber;
+	char* p_otherInitialNumber;
+	char* p_selfCurrentGuess;
+	char* p_otherCurrentGuess;
+}legacyThreadPackage;
+
+	//Counters of the false sharing measurement - packed in a single cache line vs a cache line per counter
+typedef CACHE_ALIGNED struct _benchmarkPackedCounters {
+	volatile LONG counters[NUM_OF_WORKER_THREADS];
+}benchmarkPackedCounters;
+
+typedef CACHE_ALIGNED struct _benchmarkPaddedCounter {
+	volatile LONG counter;
+}benchmarkPaddedCounter;
+
+	//Input of a counting thread
+typedef struct _benchmarkCounterPackage {
+	volatile LONG* p_counter;				// pointer to the counter this thread increments
+	HANDLE* p_h_startEvent;					// pointer to the Event that releases all counting threads at once
+}benchmarkCounterPackage;
+#endif //LAYOUT_MICROBENCHMARK
+
+#ifdef MICROBENCHMARK_SUITE
+//Microbenchmark suite constants & structs - built ONLY when MICROBENCHMARK_SUITE is defined (see MicrobenchmarkSuite.c)
+#define BENCHMARK_NUM_OF_SCORING_PAIRS 256		//Initial number & guess pairs cycled by the scoring case - MUST be a power of 2
+#define BENCHMARK_STRING_LEN 64					//Length of the strings copied & measured by the string utilities cases
+
+	//benchmarkContext structure holds the inputs of all the cases, prepared once before the first case runs
+typedef struct _benchmarkContext {
+	char initialNumbers[BENCHMARK_NUM_OF_SCORING_PAIRS][PLAYER_NUMBER_LEN + 1];
+	char guesses[BENCHMARK_NUM_OF_SCORING_PAIRS][PLAYER_NUMBER_LEN + 1];
+	char classicInitialNumbers[BENCHMARK_NUM_OF_SCORING_PAIRS][MAX_PLAYER_NUMBER_LEN + 1];	// the classic pairs, in the variant kernels' layout
+	char classicGuesses[BENCHMARK_NUM_OF_SCORING_PAIRS][MAX_PLAYER_NUMBER_LEN + 1];
+	char hexInitialNumbers[BENCHMARK_NUM_OF_SCORING_PAIRS][MAX_PLAYER_NUMBER_LEN + 1];	// pairs of the 6x16 variant
+	char hexGuesses[BENCHMARK_NUM_OF_SCORING_PAIRS][MAX_PLAYER_NUMBER_LEN + 1];
+	gameVariant classicVariant;
+	gameVariant hexVariant;
+	gameVariant hexRepeatsVariant;			// 6x16 with repeats - scored by the generic kernel
+	SHORT filterBulls[BENCHMARK_NUM_OF_SCORING_PAIRS];	// the result of each classic pair - the candidates filtering cases filter every number by it
+	SHORT filterCows[BENCHMARK_NUM_OF_SCORING_PAIRS];
+	char candidateNumbers[NUM_OF_PLAYER_NUMBERS][PLAYER_NUMBER_LEN + 1];	// every classic number, as the bot kept them before the candidate sets
+	SHORT keptCandidates[NUM_OF_PLAYER_NUMBERS];
+	char sourceString[BENCHMARK_STRING_LEN + 1];
+	char destinationString[BENCHMARK_STRING_LEN + 1];
+	messageString* p_gameResultsMessage;	// SERVER_GAME_RESULTS as the Server sends it (the longest message of a round)
+	messageString* p_playerMoveMessage;		// CLIENT_PLAYER_MOVE as the Client sends it
+	int gameResultsWireLength;				// # of bytes sendString(.) sends of each message (up to & including the '\n', without the length prefix)
+	int playerMoveWireLength;
+	SOCKET s_sendingSocket;					// loopback connection - the sending side
+	SOCKET s_receivingSocket;				// loopback connection - the receiving side (accepted)
+	volatile LONGLONG sink;					// every case adds its results here, so the measured calls are not optimized away
+}benchmarkContext;
+
+	//benchmarkCase structure describes a single case. Its routine performs the measured operation 'iterations' times
+typedef struct _benchmarkCase {
+	const char* p_name;
+	BOOL (*p_routine)(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+}benchmarkCase;
+
+	//benchmarkResult structure holds the measurement of a single case (its last, long enough, run)
+typedef struct _benchmarkResult {
+	LONGLONG iterations;
+	double nanosecondsPerOperation;
+	double allocationsPerOperation;			// slab objects & Heap buffers handed out per operation
+	double operationsPerSecond;
+	double bytesPerSecond;					// 0 if the case processes no bytes
+	double baselineNanosecondsPerOperation;	// 0 if there is no baseline for the case
+}benchmarkResult;
+#endif //MICROBENCHMARK_SUITE
+
+#ifdef GAME_JOURNAL_REPLAY
+//Game journal replay constants & structs - built ONLY when GAME_JOURNAL_REPLAY is defined (see GameJournalReplay.c)
+#define JOURNAL_REPLAY_MAX_OPEN_GAMES 16		//Games of a session replayed at once (a game is open from its PAIRING record to its OUTCOME record)
+
+	//replayedGame structure holds what the replay knows of an open game - index 0 is the Game Room opener, index 1 the joiner
+typedef struct _replayedGame {
+	BOOL isOpen;
+	LONG gameEpoch;
+	char playerNames[2][MAX_PLAYER_NAME_LEN + 1];
+	char initialNumbers[2][MAX_PLAYER_NAME_LEN + 1];
+	gameVariant variant;					// journaled with the initial numbers (classic for journals that predate the variants)
+	int numOfRounds;
+}replayedGame;
+#endif //GAME_JOURNAL_REPLAY
+
+#ifdef GAME_JOURNAL_AUDIT
+//Game journal auditor constants & structs - built ONLY when GAME_JOURNAL_AUDIT is defined (see GameJournalAuditor.c)
+#define JOURNAL_AUDIT_MAX_THREADS MAXIMUM_WAIT_OBJECTS	//The auditor waits for all of its threads at once
+#define JOURNAL_AUDIT_MAX_OPEN_GAMES 16					//Games of a session open at once (as JOURNAL_REPLAY_MAX_OPEN_GAMES)
+#define JOURNAL_AUDIT_INITIAL_CAPACITY 4096				//Records & games held in memory, doubled whenever full
+#define JOURNAL_AUDIT_NO_RECORD -1
+#define JOURNAL_AUDIT_NO_OUTCOME -1						//A game left by a player has no outcome record
+#define JOURNAL_AUDIT_MIN_TIMED_ROUNDS 5				//Intervals between rounds a game needs before its pace is judged
+#define JOURNAL_AUDIT_BOT_MAX_MEAN_MS 1000.0			//Rounds that come faster than a person types on average...
+#define JOURNAL_AUDIT_BOT_MAX_VARIATION 0.05			//...or at a steadier pace (standard deviation / mean) look scripted
+#define JOURNAL_AUDIT_MIN_SOLVER_GUESSES 5				//Guesses of a player, each consistent with all of its earlier results, that look solver made
+
+	//Findings of an audited game - the first three are results the Server could not have produced, the others only look automated
+#define JOURNAL_AUDIT_INVALID_NUMBER 0x01				//an initial number or a guess the game's variant does not allow
+#define JOURNAL_AUDIT_RESCORE_MISMATCH 0x02				//a journaled result differs from its re-scoring
+#define JOURNAL_AUDIT_OUTCOME_MISMATCH 0x04				//a round after the game was decided, or an outcome the last round contradicts
+#define JOURNAL_AUDIT_IMPOSSIBLE_RESULTS (JOURNAL_AUDIT_INVALID_NUMBER | JOURNAL_AUDIT_RESCORE_MISMATCH | JOURNAL_AUDIT_OUTCOME_MISMATCH)
+#define JOURNAL_AUDIT_BOT_TIMING 0x08
+#define JOURNAL_AUDIT_OPENER_SOLVER 0x10
+#define JOURNAL_AUDIT_JOINER_SOLVER 0x20
+
+	//auditedGame structure is a journaled game, as read before the audit - index 0 is the Game Room opener, index 1 the joiner. Its ROUND records
+	// are linked in order. Only the auditor thread that claimed the game writes its findings
+typedef struct _auditedGame {
+	int sessionNumber;
+	LONG gameEpoch;
+	char playerNames[2][MAX_PLAYER_NAME_LEN + 1];
+	char initialNumbers[2][MAX_PLAYER_NAME_LEN + 1];
+	gameVariant variant;					// journaled with the initial numbers (classic for journals that predate the variants)
+	SHORT outcome;							// the opener's 'ratingOutcomes' value, JOURNAL_AUDIT_NO_OUTCOME if left by a player
+	LONG firstRound;						// index of the first ROUND record, JOURNAL_AUDIT_NO_RECORD if none
+	LONG lastRound;
+	int numOfRounds;
+	double meanRoundMilliseconds;			// pace of the rounds (0 if too few to judge)
+	double roundVariation;					// standard deviation / mean of the intervals between rounds
+	DWORD findings;							// JOURNAL_AUDIT_ flags
+}auditedGame;
+#endif //GAME_JOURNAL_AUDIT
+
+#ifdef LOOPBACK_LATENCY_BENCHMARK
+//Loopback latency benchmark constants & structs - built ONLY when LOOPBACK_LATENCY_BENCHMARK is defined (see LoopbackLatencyBenchmark.c)
+#define LATENCY_BENCHMARK_MAX_ROOMS (NUM_OF_WORKER_THREADS / 2)	//Concurrent Game Rooms the Server can hold (two Clients each, the next Client is declined)
+#define LATENCY_BENCHMARK_NAME_PREFIX "Latency"					//A scripted player's name is the prefix followed by its initial number
+
+	//latencyBenchmarkClient structure is the input & output of a single scripted Client thread
+typedef struct _latencyBenchmarkClient {
+	unsigned short serverPortNumber;
+	int numOfRounds;								// SERVER_GAME_RESULTS rounds to measure (the game then ends with a draw)
+	char playerName[MAX_PLAYER_NAME_LEN + 1];
+	char initialNumber[PLAYER_NUMBER_LEN + 1];
+	LONGLONG* p_latencyTicks;						// CLIENT_PLAYER_MOVE sent -> SERVER_GAME_RESULTS received, per round (QueryPerformanceCounter ticks)
+	int numOfLatencies;								// # of rounds measured so far
+	BOOL isSucceeded;
+}latencyBenchmarkClient;
+#endif //LOOPBACK_LATENCY_BENCHMARK
+
+#ifdef TOURNAMENT_SCHEDULER
+//Tournament scheduler constants & structs - built ONLY when TOURNAMENT_SCHEDULER is defined (see TournamentScheduler.c)
+#define TOURNAMENT_DEFAULT_NUM_OF_PLAYERS 1024
+#define TOURNAMENT_MAX_PLAYERS 4096
+#define TOURNAMENT_MAX_SWISS_ROUNDS 32
+#define TOURNAMENT_MAX_GAME_ROUNDS 16			//A game no one won within 16 rounds is a draw (a bot guesses any number within 10)
+#define TOURNAMENT_MAX_REPLAYS 8				//A drawn bracket match is replayed, and then decided by seed
+#define TOURNAMENT_STANDINGS_SHOWN 8
+#define TOURNAMENT_NAME_PREFIX "Bot"			//A player's name is the prefix followed by its seed
+#define TOURNAMENT_NO_PLAYER -1
+
+typedef enum { TOURNAMENT_FORMAT_BRACKET, TOURNAMENT_FORMAT_SWISS } tournamentFormats;
+
+	//tournamentPlayer structure holds a registered player's standing. It is updated ONLY by the room it plays in, or by the scheduler between rounds
+typedef struct _tournamentPlayer {
+	char playerName[MAX_PLAYER_NAME_LEN + 1];
+	int seed;										// 1 is the top seed
+	int score;										// twice the points - a win or a Swiss bye adds 2, a draw 1 (as 'ratingOutcomes')
+	int wins;
+	int draws;
+	int losses;
+	int byes;
+	int opponents[TOURNAMENT_MAX_SWISS_ROUNDS];		// players met so far - a Swiss round pairs them again only if nothing else is left
+	int numOfOpponents;
+}tournamentPlayer;
+
+	//tournamentRoom structure is a match of a round - two bots, their numbers & the candidates each still considers. It is queued to the scheduler's
+	// completion port once per game round, so a scheduler thread plays a single round of it & queues it again (no thread per match)
+typedef struct _tournamentRoom {
+	int playerIndexes[2];
+	char initialNumbers[2][PLAYER_NUMBER_LEN + 1];
+	SHORT* p_candidates[2];							// indexes of the numbers side i may still guess (consistent with every result side i got)
+	int numOfCandidates[2];
+	int numOfGameRounds;							// 0 - a new game is set up on the next dequeue
+	int numOfReplays;
+	int winnerIndex;								// the player that advances, TOURNAMENT_NO_PLAYER for a Swiss draw
+	ratingOutcomes firstPlayerOutcome;
+	ULONG randomState;								// xorshift state of the room's bots
+}tournamentRoom;
+#endif //TOURNAMENT_SCHEDULER
+
+#ifdef SELF_PLAY_ENGINE
+//Self-play engine constants & structs - built ONLY when SELF_PLAY_ENGINE is defined (see SelfPlayEngine.c)
+#define SELF_PLAY_DEFAULT_NUM_OF_GAMES 1000000
+#define SELF_PLAY_MAX_THREADS MAXIMUM_WAIT_OBJECTS		//The engine waits for all of its threads at once
+#define SELF_PLAY_MAX_GAME_ROUNDS 16					//A game no one won within 16 rounds is a draw, counted as unfinished
+#define SELF_PLAY_MINIMAX_SAMPLES 8						//Candidates the minimax strategy weighs per guess
+
+	//Solver strategies - every strategy guesses a candidate consistent with all the results it got, they differ in which one
+typedef enum { SELF_PLAY_STRATEGY_FIRST, SELF_PLAY_STRATEGY_RANDOM, SELF_PLAY_STRATEGY_MINIMAX, NUM_OF_SELF_PLAY_STRATEGIES } selfPlayStrategies;
+
+	//selfPlayStatistics structure accumulates the games of a thread, and then of all the threads
+typedef struct _selfPlayStatistics {
+	LONGLONG numOfGames;
+	LONGLONG outcomes[RATING_OUTCOME_WIN + 1];				// of the first strategy, indexed by 'ratingOutcomes'
+	LONGLONG numOfRounds;									// summed over the finished games
+	LONGLONG gameLengths[SELF_PLAY_MAX_GAME_ROUNDS + 1];	// # of games per length in rounds - index 0 counts the unfinished games
+}selfPlayStatistics;
+
+	//selfPlayThreadPackage structure is the input & output of a single self-play thread - its games, its random state & its bots' candidates
+typedef CACHE_ALIGNED struct _selfPlayThreadPackage {
+	LONGLONG numOfGames;
+	selfPlayStrategies strategies[2];
+	ULONG randomState;										// xorshift state, never 0
+	candidateSet candidates[2];								// the numbers bot i may still guess
+	int numOfCandidates[2];
+	selfPlayStatistics statistics;
+}selfPlayThreadPackage;
+#endif //SELF_PLAY_ENGINE
+
+#ifdef OPENING_BOOK_BUILDER
+//Opening book builder constants & structs - built ONLY when OPENING_BOOK_BUILDER is defined (see OpeningBookBuilder.c)
+#define OPENING_BOOK_BUILDER_MAX_THREADS MAXIMUM_WAIT_OBJECTS	//The builder waits for all of its threads at once
+#define OPENING_BOOK_SUBTREE_INITIAL_CAPACITY 1024				//Nodes of a subtree, doubled whenever it is full
+
+	//openingBookSubtree structure is the subtree under a result of the first guess, built by a single builder thread into nodes of its own (its root
+	// first, children indexes local to the subtree). Its candidates are a range of every depth's candidates - the ranges of the subtrees never overlap
+typedef struct _openingBookSubtree {
+	BYTE scoreCode;							// the first guess's result that leads to the subtree
+	int firstCandidate;
+	int numOfCandidates;
+	openingBookNode* p_nodes;
+	LONG numOfNodes;
+	LONG capacity;
+	LONG maxDepth;							// guesses of the subtree's longest path, the first guess included
+	BOOL isFailed;
+}openingBookSubtree;
+#endif //OPENING_BOOK_BUILDER
+
 #endif //__HARD_CODED_DATA_H__
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <malloc.h>
 #include <assert.h>
 
 #ifndef WIN32_LEAN_AND_MEAN
@@ -23,6 +24,7 @@
 
 // Projects includes ---------------------------------------------------------------------
 #include "MemoryHandling.h"
+#include "SlabAllocationTools.h"
 
 
 // Constants -----------------------------------------------------------------------------
@@ -120,8 +122,8 @@ void freeTheMessage(message* p_message)
 {
 	//Freeing the Nested-List factor structs in message
 	if (p_message->p_parameters != NULL)  freeTheParameters(p_message->p_parameters);
-	//Freeing the message struct
-	if (p_message != NULL)  free(p_message);
+	//Returning the message struct to its slab
+	if (p_message != NULL)  freeSlabObject(p_message);
 	//For future use: It is possible to define message** p_p_message = &p_message, then, before free(p_message), place p_p_message=&p_message -> free -> *p_p_message= NULL
 }
 
@@ -137,8 +139,9 @@ static void freeTheParameters(parameter* p_firstParameter)
 		//If the Nested-List still has factor structures in it, the smallest pointer is updated to next factor struct(cell)
 		if (p_firstParameter->p_nextParameter != NULL)  p_firstParameter = p_firstParameter->p_nextParameter;
 		else p_firstParameter = NULL;
-		//Freeing the current smallest factor struct(cell)
-		free(p_currentParameter);
+		//Returning the current smallest factor string & struct(cell) to their slabs
+		freeSlabObject(p_currentParameter->p_parameter);
+		freeSlabObject(p_currentParameter);
 	}
 }
 
@@ -147,10 +150,10 @@ static void freeTheParameters(parameter* p_firstParameter)
 
 void freeTheString(messageString* p_messageStringStruct)
 {
-	//Freeing the dynamically allocated memory of the string
-	if (NULL != p_messageStringStruct->p_messageBuffer) free(p_messageStringStruct->p_messageBuffer);
-	//Freeing the message string struct
-	if (NULL != p_messageStringStruct) free(p_messageStringStruct);
+	//Returning the string buffer to its slab (or to the Heap, if it was a long one)
+	if (NULL != p_messageStringStruct->p_messageBuffer) freeSlabObject(p_messageStringStruct->p_messageBuffer);
+	//Returning the message string struct to its slab
+	if (NULL != p_messageStringStruct) freeSlabObject(p_messageStringStruct);
 }
 
 
@@ -165,7 +168,6 @@ void freeTheString(messageString* p_messageStringStruct)
 void freeTheWorkingThreadPackages(workingThreadPackage** p_p_threadParameters)
 {
 	workingThreadPackage* p_tempPackage = NULL;
-	int p = 0;
 	if (NULL != p_p_threadParameters) {
 		p_tempPackage = *p_p_threadParameters;
 		//Resource 1 - Number of Current Connected Clients to Server
@@ -177,11 +179,15 @@ void freeTheWorkingThreadPackages(workingThreadPackage** p_p_threadParameters)
 		//"Exit" & "Error" Events
 		closeHandleProcedure(p_tempPackage->p_h_errorEvent);
 		closeHandleProcedure(p_tempPackage->p_h_exitEvent);
+		//Hot restart Events
+		closeHandleProcedure(p_tempPackage->p_h_handoffEvent);
+		closeHandleProcedure(p_tempPackage->p_h_handoffCancelEvent);
+		//Resource 3 - Game Room state
+		freeTheGameRoom(p_tempPackage->p_gameRoom);
 		//Accept - VALIDATE
 		closeSocketProcedure(p_tempPackage->p_s_acceptSocket);
-		//Freeing every workingThreadPackage allocated for every Worker thread
-		for (p; p < NUM_OF_WORKER_THREADS; p++)
-			if(NULL != *(p_p_threadParameters + p))   free(*(p_p_threadParameters + p)); // 'CHECK' FindFirstUnusedThreadSlot
+		//Freeing the contiguous block of ALL the workingThreadPackages (the first package is the start of the block)
+		_aligned_free(p_tempPackage);
 	}
 	
 
@@ -189,42 +195,43 @@ void freeTheWorkingThreadPackages(workingThreadPackage** p_p_threadParameters)
 	free(p_p_threadParameters);
 }
 
+void freeTheGameRoom(gameRoom* p_gameRoom)
+{
+	if (NULL != p_gameRoom) {
+		//Close the quit Event & free its Handle
+		closeHandleProcedure(p_gameRoom->p_h_roomQuitEvent);
+		//Free the Game Room struct (cache line aligned allocation)
+		_aligned_free(p_gameRoom);
+	}
+}
 
-void freeThePlayer(workingThreadPackage* p_threadParameters)
+
+void resetThePlayer(workingThreadPackage* p_threadParameters, playerResetScopes resetScope)
 {
 	if (NULL != p_threadParameters) {
-		//Free the memory allcations of ALL numbers & names of both, the Other player & self,
-		//	and pointes their pointers to NULL
-
-		//Other current guess
-		if (NULL != p_threadParameters->p_otherCurrentGuess) {
-			free(p_threadParameters->p_otherCurrentGuess);
-			p_threadParameters->p_otherCurrentGuess = NULL;
-		}
-		//Self current guess
-		if (NULL != p_threadParameters->p_selfCurrentGuess) {
-			free(p_threadParameters->p_selfCurrentGuess);
-			p_threadParameters->p_selfCurrentGuess = NULL;
-		}
-		//Other initial number
-		if (NULL != p_threadParameters->p_otherInitialNumber) {
-			free(p_threadParameters->p_otherInitialNumber);
+		//The strings live in the package's inline storage - pointing at NULL is all it takes to discard them. 
+		//	Every wider scope also resets the narrower ones (cases fall through)
+		switch (resetScope) {
+		case PLAYER_RESET_CONNECTION:
+			//Self name
+			p_threadParameters->p_selfPlayerName = NULL;
+			//fall through
+		case PLAYER_RESET_GAME:
+			//Other name & both initial numbers
+			p_threadParameters->p_otherPlayerName = NULL;
 			p_threadParameters->p_otherInitialNumber = NULL;
-		}
-		//Self initial number
-		if (NULL != p_threadParameters->p_selfInitialNumber) {
-			free(p_threadParameters->p_selfInitialNumber);
 			p_threadParameters->p_selfInitialNumber = NULL;
-		}
-		//Other name
-		if (NULL != p_threadParameters->p_otherPlayerName) {
-			free(p_threadParameters->p_otherPlayerName);
-			p_threadParameters->p_otherPlayerName = NULL;
-		}
-		//Self name  - 'CHECK'
-		if (NULL != p_threadParameters->p_selfPlayerName) {
-			free(p_threadParameters->p_selfPlayerName);
-			p_threadParameters->p_selfPlayerName = NULL;
+			p_threadParameters->gameRound = 0;
+			p_threadParameters->lastRoundResults.resultsIndex = 0;
+			//fall through
+		case PLAYER_RESET_ROUND:
+			//Both current guesses
+			p_threadParameters->p_otherCurrentGuess = NULL;
+			p_threadParameters->p_selfCurrentGuess = NULL;
+			break;
+
+		default: /*ignored*/
+			printf("Error: Bad inputs to function: %s\n", __func__); break;
 		}
 	}
 }
@@ -79,11 +79,18 @@ void freeTheString(messageString* p_messageStringStruct);
 void freeTheWorkingThreadPackages(workingThreadPackage** p_p_threadParameters);
 
 /// <summary>
-///  Description - This function receives a "workingThreadPackage" struct pointer frees all of the data in it that points at a couple of players
-/// in a game e.g. "self player" Initial number and Guesses(one guess at a time. guesses were allocated & erased at every game phase) number,
-/// & "other player" Name, Initial number and Guesses number.
+/// Description - This function receives a "gameRoom" struct pointer, closes the Handle of its quit Event and frees the struct itself.
+/// </summary>
+/// <param name="gameRoom* p_gameRoom - pointer to a 'gameRoom' struct shared by the two Worker threads of a game (may be NULL)"></param>
+void freeTheGameRoom(gameRoom* p_gameRoom);
+
+/// <summary>
+///  Description - This function receives a "workingThreadPackage" struct pointer and resets, in O(1), the players strings of the given scope.
+/// The strings are stored inline in the package ('playerNames' & 'playerNumbers'), so nothing is freed - the pointers to them are set to NULL:
+/// PLAYER_RESET_ROUND - both guesses.  PLAYER_RESET_GAME - also both initial numbers & the opponent name.  PLAYER_RESET_CONNECTION - also self name.
 /// </summary>
 /// <param name="workingThreadPackage* p_threadParameters - pointer to a 'workingThreadPackage' struct that was used for a single Worker thread"></param>
-void freeThePlayer(workingThreadPackage* p_threadParameters);
+/// <param name="playerResetScopes resetScope - PLAYER_RESET_ROUND, PLAYER_RESET_GAME or PLAYER_RESET_CONNECTION"></param>
+void resetThePlayer(workingThreadPackage* p_threadParameters, playerResetScopes resetScope);
 
 #endif //__MEMORY_HANDLING_H__
\ No newline at end of file
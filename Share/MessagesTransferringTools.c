@@ -22,12 +22,15 @@
 #include <Windows.h>
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <intrin.h>
 
 #pragma comment(lib, "Ws2_32.lib")
 
 
 // Projects includes -----------------------------------------------------------
 #include "MessagesTransferringTools.h"
+#include "SlabAllocationTools.h"
+#include "EventLoggingTools.h"
 
 
 
@@ -67,11 +70,11 @@ static messageString* constructMessageStringWithParameters(char* p_messageTypeSt
 //Start: Set '1' of functions contructing a "messageString" struct updated with a pointer to a buffer that contains data to transmit to some Client from the Server
 //		 Some receives no parameters and use constructMessageStringWithNoParameters(.) for message string construction, while other have multiple parameters
 //		 and use constructMessageStringWithParameters(.) for message string construction. The out put is a pointer to that "messageString" that contains the buffer and its size
-static messageString* constructServerMainMenuMessageString();
-static messageString* constructServerApprovedMessageString();
+static messageString* constructServerMainMenuMessageString(char* p_paramOne/*#Games*/, char* p_paramTwo/*#Wins*/, char* p_paramThree/*#Draws*/, char* p_paramFour/*latest games*/);
+static messageString* constructServerApprovedMessageString(char* p_paramOne/*session token*/, char* p_paramTwo/*reattached phase*/, char* p_paramThree/*results index*/);
 static messageString* constructServerDeniedMessageString(/*char* p_paramOne Denied reason*/);
 static messageString* constructServerInviteMessageString(char* p_paramOne /*Other player name*/);
-static messageString* constructServerSetupRequestMessageString();
+static messageString* constructServerSetupRequestMessageString(char* p_paramOne/*number length*/, char* p_paramTwo/*alphabet size*/, char* p_paramThree/*repeats*/, char* p_paramFour/*resumed initial number*/);
 static messageString* constructServerPlayerMoveRequestMessageString();
 static messageString* constructServerGameResultsMessageString(char* p_paramOne/*#Bulls*/, char* p_paramTwo/*Cows*/, char* p_paramThree/*other player name*/, char* p_paramFour/*other guess*/);
 static messageString* constructServerWinMessageString(char* p_paramOne/*winner name*/, char* p_paramTwo/*Other player's initial number*/);
@@ -81,7 +84,7 @@ static messageString* constructServerOpponentQuitMessageString();
 //End set '1'
 
 //Start: Set '2' of functions with similiar functionality as set '1', but the data will be transmitted to the Server from some Client 
-static messageString* constructClientRequestMessageString(char* p_paramOne /*User name*/);
+static messageString* constructClientRequestMessageString(char* p_paramOne /*User name*/, char* p_paramTwo /*session token*/);
 static messageString* constructClientVersusMessageString();
 static messageString* constructClientSetupMessageString(char* p_paramOne /*Initial self number*/);
 static messageString* constructClientPlayerMoveMessageString(char* p_paramOne /*self guess of opponent number*/);
@@ -105,15 +108,25 @@ static message* allocateMemoryForMessageStruct();
 /// <returns>a pointer to that allocated struct, or NULL if failed</returns>
 static parameter* allocateMemoryForParameterStruct(int parameterStringLength, char* p_bufferInitialCopyPosition);
 
+#ifdef SSE2_SCANNING
 /// <summary>
-/// Description - This function assist in finding a certain byte character, assuming it exists, or if the string has a Carriage Return in it... (function to analize received messages)
-/// (Since it was decided for a sending message to appear as "<data>\r\n\0" then the last character of the last parameter in a string will be folled by CR 
+/// Description - This function compares a 16 bytes aligned chunk against four characters at once (SSE2 compare & movemask)
+/// </summary>
+/// <param name="const char* p_alignedChunk - 16 bytes aligned chunk address"></param>
+/// <param name="char first, second, third, fourth - the looked for characters"></param>
+/// <returns>mask whose bit i is set if byte i of the chunk equals one of the characters</returns>
+static unsigned int fetchChunkMatchMask(const char* p_alignedChunk, char first, char second, char third, char fourth);
+#endif //SSE2_SCANNING
+
+/// <summary>
+/// Description - This function finds, in a single pass over the received buffer, where the message type & every parameter end (function to analize received messages)
+/// (Since it was decided for a sending message to appear as "<type>:<param>;<param>\r\n\0" then the message type ends at ':' (or at CR if there are no parameters),
+/// every parameter ends at ';' and the last parameter is followed by CR. A '\0' before the CR ends the message as well)
 /// </summary>
 /// <param name="char* p_receivedBuffer - received buffer from recv(.) function"></param>
-/// <param name="int scanStartingPosition - starting scanning position in the received buffer"></param>
-/// <param name="char mark - character indicator for end-of-scan"></param>
-/// <returns>length of scanned section in bytes</returns>
-static int findPositionOffsetOfGivenCharacterInBuffer(char* p_receivedBuffer, int scanStartingPosition, char mark);
+/// <param name="int* p_sliceEnds - array of MESSAGE_MAX_SLICES positions: the end of the message type, then the end of every parameter"></param>
+/// <returns># of slices (message type included), or 0 if the message has more than MESSAGE_MAX_SLICES slices</returns>
+static int findMessageSliceEnds(char* p_receivedBuffer, int* p_sliceEnds);
 
 /// <summary>
 /// Description - This function already KNOW what is the the type of the received message, and it receives the received message buffer and
@@ -123,9 +136,10 @@ static int findPositionOffsetOfGivenCharacterInBuffer(char* p_receivedBuffer, in
 /// <param name="char* p_receivedBuffer - received message buffer pointer"></param>
 /// <param name="message* p_receivedMessageInfo - message struct pointer to insert the new constructed message parameter nested list into it"></param>
 /// <param name="int messageTypeSerialNumber - message type identifier number"></param>
-/// <param name="int bufferCurrentPosition - current position in the received message buffer where the message type string exectly ended  - ':' character"></param>
+/// <param name="const int* p_sliceEnds - the slices ends found by findMessageSliceEnds(.) - the message type's first, then the parameters'"></param>
+/// <param name="int numOfSlices - # of slices (message type included)"></param>
 /// <returns>True if succeeded. False otherwise</returns>
-static BOOL extractMessageParameters(char* p_receivedBuffer, message* p_receivedMessageInfo, int messageTypeSerialNumber, int bufferCurrentPosition);
+static BOOL extractMessageParameters(char* p_receivedBuffer, message* p_receivedMessageInfo, int messageTypeSerialNumber, const int* p_sliceEnds, int numOfSlices);
 
 /// <summary>
 /// Description - This function updates a newly allocated inputted 'message' object with the message's fields - types and parameters, using
@@ -147,21 +161,21 @@ messageString* constructMessageForSendingServer(int messageType, char* p_paramOn
 {
 	//Input integrity validation
 	if ((SERVER_OPPONENT_QUIT_NUM < messageType) || (SERVER_MAIN_MENU_NUM > messageType)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return NULL;
 	}
 	//Construct message according to the message type's number....
 	switch (messageType) {
 		//Server messages (for sending)
 	case SERVER_MAIN_MENU_NUM:
-		return constructServerMainMenuMessageString(); break; //if(NULL == constructServerMainMenuMessageString())
+		return constructServerMainMenuMessageString(p_paramOne, p_paramTwo, p_paramThree, p_paramFour); break; //p (player's history, if any)
 	case SERVER_APPROVED_NUM:
-		return constructServerApprovedMessageString(); break;
+		return constructServerApprovedMessageString(p_paramOne, p_paramTwo, p_paramThree); break; //p (session token, reattached phase & results index, if any)
 	case SERVER_DENIED_NUM:
 		return constructServerDeniedMessageString(p_paramOne/*temp need to check in forum*/); break; //p
 	case SERVER_INVITE_NUM:
 		return constructServerInviteMessageString(p_paramOne); break; //p
 	case SERVER_SETUP_REQUSET_NUM:
-		return constructServerSetupRequestMessageString(); break;
+		return constructServerSetupRequestMessageString(p_paramOne, p_paramTwo, p_paramThree, p_paramFour); break; //p (game variant & resumed initial number, if any)
 	case SERVER_PLAYER_MOVE_REQUEST_NUM:
 		return constructServerPlayerMoveRequestMessageString(); break;
 	case SERVER_GAME_RESULTS_NUM:
@@ -180,17 +194,17 @@ messageString* constructMessageForSendingServer(int messageType, char* p_paramOn
 	default: return NULL; break;
 	}
 }
-messageString* constructMessageForSendingClient(int messageType, char* p_paramOne)
+messageString* constructMessageForSendingClient(int messageType, char* p_paramOne, char* p_paramTwo)
 {
 	//Input integrity validation
 	if ((CLIENT_DISCONNECT_NUM < messageType) || (CLIENT_REQUEST_NUM > messageType)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return NULL;
 	}
 	//Construct message according to the message type's number....
 	switch (messageType) {
 		//Client messages (for sending)
 	case CLIENT_REQUEST_NUM:
-		return constructClientRequestMessageString(p_paramOne); break; //p
+		return constructClientRequestMessageString(p_paramOne, p_paramTwo); break; //p (& session token, if any)
 	case CLIENT_VERSUS_NUM:
 		return constructClientVersusMessageString(); break;
 	case CLIENT_SETUP_NUM:
@@ -213,12 +227,11 @@ message* translateReceivedMessageToMessageStruct(char* p_receivedBuffer)
 	message* p_receivedMessageInfo = NULL;
 	//Input integrity validation
 	if (NULL == p_receivedBuffer) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return NULL;
 	}
 
 	if (NULL == (p_receivedMessageInfo = allocateMemoryForMessageStruct())) {
-		printf("Error: Failed to create a 'message' struct to contain the received message information.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to create a 'message' struct to contain the received message information", 0, 0);
 		return NULL;
 	}
 
@@ -227,15 +240,14 @@ message* translateReceivedMessageToMessageStruct(char* p_receivedBuffer)
 	// so we can simply search for a ':'.  OR  the message doesn't contain parameters, so the after the message type a 
 	// Carriage Return & Line Feed will be found...
 	if (STATUS_CODE_FAILURE == extractMessageInfo(p_receivedBuffer, p_receivedMessageInfo)) {
-		printf("Error: Failed to extract the input message information from the received buffer.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to extract the input message information from the received buffer", 0, 0);
 		freeTheMessage(p_receivedMessageInfo);
 		//There is no need for the received buffer after analyzing it..
-		free(p_receivedBuffer);
+		freeSlabObject(p_receivedBuffer);
 		return NULL;
 	}
 	//There is no need for the received buffer after analyzing it.. (all parameters are placed in separate strings)
-	free(p_receivedBuffer); //maybe not 'CHECK'
+	freeSlabObject(p_receivedBuffer); //maybe not 'CHECK'
 
 	//Return the message struct info: type & parameters
 	return p_receivedMessageInfo;
@@ -253,42 +265,69 @@ message* translateReceivedMessageToMessageStruct(char* p_receivedBuffer)
 //0oo0ooo0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o Functions mainly to construct a message to be sent
 int fetchStringLength(char* p_stringBuffer)
 {
-	int currentLength = 0;
-	char* p_currentPointerPosition = NULL;
 	//Assert
 	assert(NULL != p_stringBuffer);
 
-	p_currentPointerPosition = p_stringBuffer;
-
-	//Search length
-	while ('\0' != *(p_stringBuffer + currentLength))
-		currentLength++;
-
-	//When p_stringBuffer in currentLength position is the 'zero' character, then the end of the message was reached 
-	// and currentLength has become the TRUE length of the message in the buffer!
-	return currentLength;
+	//The position of the 'zero' character is the TRUE length of the string in the buffer!
+	return findFirstOfCharacters(p_stringBuffer, 0, '\0', '\0', '\0', '\0');
+}
+int findFirstOfCharacters(const char* p_buffer, int scanStartingPosition, char first, char second, char third, char fourth)
+{
+#ifdef SSE2_SCANNING
+	const char* p_chunk = NULL;
+	unsigned int matchMask = 0;
+	unsigned long matchIndex = 0;
+#endif
+	//Asserts
+	assert(NULL != p_buffer);
+	assert(0 <= scanStartingPosition);
+
+#ifdef SSE2_SCANNING
+	//The first chunk starts at the aligned address below the starting position - the bytes before the starting position are masked out
+	p_chunk = (const char*)((ULONG_PTR)(p_buffer + scanStartingPosition) & ~(ULONG_PTR)(SCAN_CHUNK_SIZE - 1));
+	matchMask = fetchChunkMatchMask(p_chunk, first, second, third, fourth) & (0xFFFFu << (p_buffer + scanStartingPosition - p_chunk));
+
+	//Advance a whole chunk at a time until one of the characters appears
+	while (0 == matchMask) {
+		p_chunk += SCAN_CHUNK_SIZE;
+		matchMask = fetchChunkMatchMask(p_chunk, first, second, third, fourth);
+	}
+	_BitScanForward(&matchIndex, matchMask);
+	return (int)(p_chunk + matchIndex - p_buffer);
+#else
+	//Scan the buffer byte by byte...
+	while ((first != *(p_buffer + scanStartingPosition)) && (second != *(p_buffer + scanStartingPosition)) &&
+		(third != *(p_buffer + scanStartingPosition)) && (fourth != *(p_buffer + scanStartingPosition)))
+		scanStartingPosition++;
+	return scanStartingPosition;
+#endif
 }
 int concatenateStringToStringThatMayContainNullCharacters(char* p_destBuffer, char* p_sourceBuffer, int currentPositionOfDestBuffer, int numberOfBytesToWrite)
 {
-	int i = 0;
 	//Asserts
 	assert(NULL != p_destBuffer);
 	assert(NULL != p_sourceBuffer);
 	assert(0 <= currentPositionOfDestBuffer);
-	assert(0 < numberOfBytesToWrite);
+	assert(0 <= numberOfBytesToWrite);
+
+	//Copy\concatenate the bytes - memcpy(.) copies whatever the bytes are ('\0' included), with the widest moves the processor has
+	memcpy(p_destBuffer + currentPositionOfDestBuffer, p_sourceBuffer, numberOfBytesToWrite);
 
-	//Begin strings copy\concatenation
-	while (numberOfBytesToWrite > 0) {
-		*(p_destBuffer + currentPositionOfDestBuffer) = *(p_sourceBuffer + i); //Pointers arithmetics
-		i++;								//Advance the source buffer position 
-		numberOfBytesToWrite--;				//Decrement the number bytes remaining to write to the destination buffer
-		currentPositionOfDestBuffer++;		//Advance the destination buffer current position
-	}
-	
 	//Return the last position index the concatenation had reached....
-	return currentPositionOfDestBuffer;
+	return currentPositionOfDestBuffer + numberOfBytesToWrite;
 }
 
+#ifdef SSE2_SCANNING
+static unsigned int fetchChunkMatchMask(const char* p_alignedChunk, char first, char second, char third, char fourth)
+{
+	__m128i chunk = _mm_load_si128((const __m128i*)p_alignedChunk);
+
+	return (unsigned int)_mm_movemask_epi8(_mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(first)), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(second))),
+		_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(third)), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(fourth)))));
+}
+#endif //SSE2_SCANNING
+
 
 
 
@@ -296,10 +335,9 @@ static messageString* constructMessageStringWithNoParameters(char* p_messageType
 {
 	messageString* p_messageString = NULL;
 	int messageTypeStringLength = 0;
-	//Allocate Heap memory for a "message" struct
-	if (NULL == (p_messageString = (messageString*)calloc(sizeof(messageString), SINGLE_OBJECT))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) for a 'messageString' struct.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//Allocate a "messageString" struct from the thread's slab
+	if (NULL == (p_messageString = (messageString*)allocateSlabObject(SLAB_MESSAGE_STRING))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a 'messageString' struct", 0, 0);
 		return NULL;
 	}
 
@@ -307,19 +345,17 @@ static messageString* constructMessageStringWithNoParameters(char* p_messageType
 	messageTypeStringLength = fetchStringLength(p_messageTypeString);
 
 	//Allocate Heap memory for a "message"'s type string
-	if (NULL == (p_messageString->p_messageBuffer = (TCHAR*)calloc(sizeof(TCHAR), messageTypeStringLength+3))) { // 3== CR + LF + '\0'
-		printf("Error: Failed to allocate dynamic memory (Heap) string.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		free(p_messageString);
+	if (NULL == (p_messageString->p_messageBuffer = (TCHAR*)allocateSlabBuffer(sizeof(TCHAR) * (messageTypeStringLength+3)))) { // 3== CR + LF + '\0'
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a string", 0, 0);
+		freeSlabObject(p_messageString);
 		return NULL;
 	}
 
 	//Insert message type string into messageString struct - NOTE: HERE string function e.g. sprintf_s would work because there are no '\0' data involved.
 	if (EOF == sprintf_s(p_messageString->p_messageBuffer, messageTypeStringLength + 3, "%s\r\n", p_messageTypeString)) {
-		printf("Error: Failed to copy the message type into a 'message' struct\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		free(p_messageString->p_messageBuffer);
-		free(p_messageString);
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to copy the message type into a 'message' struct", 0, 0);
+		freeSlabObject(p_messageString->p_messageBuffer);
+		freeSlabObject(p_messageString);
 		return NULL;
 	}
 
@@ -339,10 +375,9 @@ static messageString* constructMessageStringWithParameters(char* p_messageTypeSt
 	messageString* p_messageString = NULL;
 	int messageTypeStringLength = 0, paramOneLength = 0, paramTwoLength = 0, paramThreeLength = 0, paramFourLength=0, totalLen = 0, currentBufferPosition= 0;
 
-	//Allocate Heap memory for a "message" struct
-	if (NULL == (p_messageString = (messageString*)calloc(sizeof(messageString), SINGLE_OBJECT))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) for a 'messageString' struct.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//Allocate a "messageString" struct from the thread's slab
+	if (NULL == (p_messageString = (messageString*)allocateSlabObject(SLAB_MESSAGE_STRING))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a 'messageString' struct", 0, 0);
 		return NULL;
 	}
 
@@ -369,10 +404,9 @@ static messageString* constructMessageStringWithParameters(char* p_messageTypeSt
 	
 	
 	//Allocate Heap memory for a "message"'s type string
-	if (NULL == (p_messageString->p_messageBuffer = (TCHAR*)calloc(sizeof(TCHAR), totalLen))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) string.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		free(p_messageString);
+	if (NULL == (p_messageString->p_messageBuffer = (TCHAR*)allocateSlabBuffer(sizeof(TCHAR) * totalLen))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a string", 0, 0);
+		freeSlabObject(p_messageString);
 		return NULL;
 	}
 
@@ -383,10 +417,9 @@ static messageString* constructMessageStringWithParameters(char* p_messageTypeSt
 
 	//Insert message type string into messageString struct - NOTE: HERE string function e.g. sprintf_s would work because there are no '\0' data involved.
 	if (EOF == (currentBufferPosition = sprintf_s(p_messageString->p_messageBuffer, messageTypeStringLength + 1, "%s", p_messageTypeString))) {
-		printf("Error: Failed to copy the message type into a 'messageString' struct's string\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		free(p_messageString->p_messageBuffer);
-		free(p_messageString);
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to copy the message type into a 'messageString' struct's string", 0, 0);
+		freeSlabObject(p_messageString->p_messageBuffer);
+		freeSlabObject(p_messageString);
 		return NULL;
 	}
 
@@ -438,13 +471,14 @@ static messageString* constructMessageStringWithParameters(char* p_messageTypeSt
 
 //0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o Server messages
 //---SERVER_MAIN_MENU
-static messageString* constructServerMainMenuMessageString()
+static messageString* constructServerMainMenuMessageString(char* p_paramOne/*#Games*/, char* p_paramTwo/*#Wins*/, char* p_paramThree/*#Draws*/, char* p_paramFour/*latest games*/)
 {
 	messageString* p_messageString = NULL;
 
-	//Allocate Heap memory for a "messageString" struct & Insert the message string..
-	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_MAIN_MENU))) {
-		printf("Error: Failed to construct 'SERVER_MAIN_MENU' message buffer for the Server to send to Client.\n");
+	//Allocate Heap memory for a "messageString" struct & Insert the message string.. (with the player's history, if it was given)
+	if (NULL == (p_messageString = (NULL == p_paramOne) ? constructMessageStringWithNoParameters(SERVER_MAIN_MENU) :
+		constructMessageStringWithParameters(SERVER_MAIN_MENU, p_paramOne, p_paramTwo, p_paramThree, p_paramFour))) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_MAIN_MENU' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -453,13 +487,14 @@ static messageString* constructServerMainMenuMessageString()
 }
 
 //---SERVER_APPROVED
-static messageString* constructServerApprovedMessageString()
+static messageString* constructServerApprovedMessageString(char* p_paramOne/*session token*/, char* p_paramTwo/*reattached phase*/, char* p_paramThree/*results index*/)
 {
 	messageString* p_messageString = NULL;
 
-	//Allocate Heap memory for a "messageString" struct & Insert the message string..
-	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_APPROVED))) {
-		printf("Error: Failed to construct 'SERVER_APPROVED' message buffer for the Server to send to Client.\n");
+	//Allocate Heap memory for a "messageString" struct & Insert the message string.. (with the session token, a reattached game's phase & results index, if given)
+	if (NULL == (p_messageString = (NULL == p_paramOne) ? constructMessageStringWithNoParameters(SERVER_APPROVED) :
+		constructMessageStringWithParameters(SERVER_APPROVED, p_paramOne, p_paramTwo, p_paramThree, NULL))) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_APPROVED' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -474,7 +509,7 @@ static messageString* constructServerDeniedMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_DENIED))) {
-		printf("Error: Failed to construct 'SERVER_DENIED' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_DENIED' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -491,7 +526,7 @@ static messageString* constructServerInviteMessageString(char* p_paramOne)
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithParameters(SERVER_INVITE, p_paramOne, NULL, NULL, NULL))) {
-		printf("Error: Failed to construct 'SERVER_INVITE' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_INVITE' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -500,13 +535,14 @@ static messageString* constructServerInviteMessageString(char* p_paramOne)
 }
 
 //---SERVER_SETUP_REQUSET
-static messageString* constructServerSetupRequestMessageString()
+static messageString* constructServerSetupRequestMessageString(char* p_paramOne/*number length*/, char* p_paramTwo/*alphabet size*/, char* p_paramThree/*repeats*/, char* p_paramFour/*resumed initial number*/)
 {
 	messageString* p_messageString = NULL;
 
-	//Allocate Heap memory for a "messageString" struct & Insert the message string..
-	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_SETUP_REQUSET))) {
-		printf("Error: Failed to construct 'SERVER_SETUP_REQUSET' message buffer for the Server to send to Client.\n");
+	//Allocate Heap memory for a "messageString" struct & Insert the message string.. (with the game variant & a resumed game's initial number, if given)
+	if (NULL == (p_messageString = (NULL == p_paramOne) ? constructMessageStringWithNoParameters(SERVER_SETUP_REQUSET) :
+		constructMessageStringWithParameters(SERVER_SETUP_REQUSET, p_paramOne, p_paramTwo, p_paramThree, p_paramFour))) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_SETUP_REQUSET' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -521,7 +557,7 @@ static messageString* constructServerPlayerMoveRequestMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_PLAYER_MOVE_REQUEST))) {
-		printf("Error: Failed to construct 'SERVER_PLAYER_MOVE_REQUEST' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_PLAYER_MOVE_REQUEST' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -542,7 +578,7 @@ static messageString* constructServerGameResultsMessageString(char* p_paramOne/*
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithParameters(SERVER_GAME_RESULTS, p_paramOne, p_paramTwo, p_paramThree, p_paramFour))) {
-		printf("Error: Failed to construct 'SERVER_GAME_RESULTS' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_GAME_RESULTS' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -560,7 +596,7 @@ static messageString* constructServerWinMessageString(char* p_paramOne, char* p_
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithParameters(SERVER_WIN, p_paramOne, p_paramTwo, NULL, NULL))) {
-		printf("Error: Failed to construct 'SERVER_WIN' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_WIN' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -575,7 +611,7 @@ static messageString* constructServerDrawMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_DRAW))) {
-		printf("Error: Failed to construct 'SERVER_DRAW' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_DRAW' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -590,7 +626,7 @@ static messageString* constructServerNoOpponentsMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_NO_OPPONENTS))) {
-		printf("Error: Failed to construct 'SERVER_NO_OPPONENTS' message buffer for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_NO_OPPONENTS' message buffer for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -605,7 +641,7 @@ static messageString* constructServerOpponentQuitMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(SERVER_OPPONENT_QUIT))) {
-		printf("Error: Failed to construct 'SERVER_OPPONENT_QUIT' for the Server to send to Client.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'SERVER_OPPONENT_QUIT' for the Server to send to Client", 0, 0);
 		return NULL;
 	}
 
@@ -618,15 +654,15 @@ static messageString* constructServerOpponentQuitMessageString()
 
 //0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o Client messages
 //---CLIENT_REQUEST
-static messageString* constructClientRequestMessageString(char* p_paramOne /*User name*/)
+static messageString* constructClientRequestMessageString(char* p_paramOne /*User name*/, char* p_paramTwo /*session token*/)
 {
 	messageString* p_messageString = NULL;
 	//Assert
 	assert(NULL != p_paramOne);
 
-	//Allocate Heap memory for a "messageString" struct & Insert the message string..
-	if (NULL == (p_messageString = constructMessageStringWithParameters(CLIENT_REQUEST, p_paramOne, NULL, NULL, NULL))) {
-		printf("Error: Failed to construct 'CLIENT_REQUEST' message buffer for the Client to send to Server.\n");
+	//Allocate Heap memory for a "messageString" struct & Insert the message string.. (with the previous connection's session token, if given)
+	if (NULL == (p_messageString = constructMessageStringWithParameters(CLIENT_REQUEST, p_paramOne, p_paramTwo, NULL, NULL))) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'CLIENT_REQUEST' message buffer for the Client to send to Server", 0, 0);
 		return NULL;
 	}
 
@@ -641,7 +677,7 @@ static messageString* constructClientVersusMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(CLIENT_VERSUS))) {
-		printf("Error: Failed to construct 'CLIENT_VERSUS' message buffer for the Client to send to Server.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'CLIENT_VERSUS' message buffer for the Client to send to Server", 0, 0);
 		return NULL;
 	}
 
@@ -658,7 +694,7 @@ static messageString* constructClientSetupMessageString(char* p_paramOne /*Initi
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithParameters(CLIENT_SETUP, p_paramOne, NULL, NULL, NULL))) {
-		printf("Error: Failed to construct 'CLIENT_SETUP' message buffer for the Client to send to Server.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'CLIENT_SETUP' message buffer for the Client to send to Server", 0, 0);
 		return NULL;
 	}
 
@@ -675,7 +711,7 @@ static messageString* constructClientPlayerMoveMessageString(char* p_paramOne /*
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithParameters(CLIENT_PLAYER_MOVE, p_paramOne, NULL, NULL, NULL))) {
-		printf("Error: Failed to construct 'CLIENT_PLAYER_MOVE' message buffer for the Client to send to Server.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'CLIENT_PLAYER_MOVE' message buffer for the Client to send to Server", 0, 0);
 		return NULL;
 	}
 
@@ -690,7 +726,7 @@ static messageString* constructClientDisconnectMessageString()
 
 	//Allocate Heap memory for a "messageString" struct & Insert the message string..
 	if (NULL == (p_messageString = constructMessageStringWithNoParameters(CLIENT_DISCONNECT))) {
-		printf("Error: Failed to construct 'CLIENT_DISCONNECT' message buffer for the Client to send to Server.\n");
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to construct 'CLIENT_DISCONNECT' message buffer for the Client to send to Server", 0, 0);
 		return NULL;
 	}
 
@@ -713,10 +749,9 @@ static message* allocateMemoryForMessageStruct()
 {
 	message* p_message = NULL;
 
-	//Allocate Heap memory for a "message" struct
-	if (NULL == (p_message = (message*)calloc(sizeof(message), SINGLE_OBJECT))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) for a 'message' struct.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//Allocate a "message" struct from the thread's slab
+	if (NULL == (p_message = (message*)allocateSlabObject(SLAB_MESSAGE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a 'message' struct", 0, 0);
 		return NULL;
 	}
 
@@ -728,17 +763,16 @@ static parameter* allocateMemoryForParameterStruct(int parameterStringLength, ch
 {
 	parameter* p_parameter = NULL;
 
-	//Allocate Heap memory for a "parameter" struct
-	if (NULL == (p_parameter = (parameter*)calloc(sizeof(parameter), SINGLE_OBJECT))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) for a 'parameter' struct.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//Allocate a "parameter" struct from the thread's slab
+	if (NULL == (p_parameter = (parameter*)allocateSlabObject(SLAB_PARAMETER))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a 'parameter' struct", 0, 0);
 		return NULL;
 	}
 
-	//Allocate Heap memory for the received parameter string
-	if (NULL == (p_parameter->p_parameter = (char*)calloc(sizeof(char), parameterStringLength + 1))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) string.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//Allocate memory for the received parameter string (short parameters come from the thread's slab)
+	if (NULL == (p_parameter->p_parameter = allocateSlabBuffer(parameterStringLength + 1))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a string", 0, 0);
+		freeSlabObject(p_parameter);
 		return NULL;
 	}
 
@@ -750,57 +784,56 @@ static parameter* allocateMemoryForParameterStruct(int parameterStringLength, ch
 	return p_parameter;
 }
 
-static int findPositionOffsetOfGivenCharacterInBuffer(char* p_receivedBuffer, int scanStartingPosition,char mark)
+static int findMessageSliceEnds(char* p_receivedBuffer, int* p_sliceEnds)
 {
-	//Assert
+	int numOfSlices = 0, position = 0;
+	char separator = ':';
+	//Asserts
 	assert(NULL != p_receivedBuffer);
-	//mark will most likely be ';'
-	
-	//Scan the received buffer...   
-	while (TRUE)
-	{
-		//Validate if the buffer marker reached the end of the 'message type' field in the buffer data OR the end of a 'message parameter' field
-		if ((*(p_receivedBuffer + scanStartingPosition) == '\r') || (*(p_receivedBuffer + scanStartingPosition) == mark)) {//'CHECK' '\n'
-			break;
-		}
-		scanStartingPosition++;  //Advance the buffer's front edge
+	assert(NULL != p_sliceEnds);
+
+	//Scan the received buffer once, from slice to slice... (the message type ends at ':', the parameters at ';')
+	while (MESSAGE_MAX_SLICES > numOfSlices) {
+		position = findFirstOfCharacters(p_receivedBuffer, position, separator, '\r', '\0', '\0');
+		*(p_sliceEnds + numOfSlices++) = position;
+
+		//The end of the message was reached
+		if (separator != *(p_receivedBuffer + position)) return numOfSlices;
+		separator = ';';
+		position++;  //Advance the buffer's front edge past the separator
 	}
-	//scanStartingPosition has become the position of the 'mark' character
-	return scanStartingPosition; 
+	LOG_EVENT(LOG_EVENT_UNEXPECTED, "The received message has too many parameters", MESSAGE_MAX_SLICES, 0);
+	return 0;
 }
 
-static BOOL extractMessageParameters(char* p_receivedBuffer, message* p_receivedMessageInfo, int messageTypeSerialNumber, int bufferCurrentPosition)
+static BOOL extractMessageParameters(char* p_receivedBuffer, message* p_receivedMessageInfo, int messageTypeSerialNumber, const int* p_sliceEnds, int numOfSlices)
 {
-	int bufferStartingPosition = 0, paramIndex = 0;;
+	int slice = 0;
 	parameter* p_next = NULL, *p_current = NULL;
 	//Assert
 	assert(NULL != p_receivedBuffer);
 	assert(NULL != p_receivedMessageInfo);
 	assert((SERVER_MAIN_MENU_NUM <= messageTypeSerialNumber) && (CLIENT_DISCONNECT_NUM >= messageTypeSerialNumber));
-	assert(0 < bufferCurrentPosition);
+	assert(NULL != p_sliceEnds);
+	assert(0 < numOfSlices);
 
 	//Insert message type serial number to the message info struct
 	p_receivedMessageInfo->messageType = messageTypeSerialNumber;
 
 	
 
-	//Keep scanning for parameters in the received buffer...  (':' for the first parameter & ';' for additional parameters)
-	while ((*(p_receivedBuffer + bufferCurrentPosition) == ';') || (*(p_receivedBuffer + bufferCurrentPosition) == ':')) {
-		//Update the starting scanning position
-		bufferStartingPosition = bufferCurrentPosition;
-		//Find next parameter if exists (Pay Attention that only messages that must have at least one parameter arrived at this function)
-		bufferCurrentPosition = findPositionOffsetOfGivenCharacterInBuffer(p_receivedBuffer, bufferStartingPosition + 1, ';');
+	//Every slice after the message type is a parameter, that begins right after the previous slice's separator (':' for the first parameter & ';' for additional parameters)
+	for (slice = 1; slice < numOfSlices; slice++) {
 		//Create a "parameter" struct, Update it with the string describing the parameter value & Insert it to the "message" struct
 		if (NULL == (p_next = allocateMemoryForParameterStruct(
-			bufferCurrentPosition - bufferStartingPosition-1,		/* the difference between the initial byte index in the buffer, and the final byte index of the section */
-			p_receivedBuffer + bufferStartingPosition + 1))) {		/* pointer to the address from which the first parameter's section in the string begins */
+			*(p_sliceEnds + slice) - *(p_sliceEnds + slice - 1) - 1,	/* the difference between the initial byte index in the buffer, and the final byte index of the section */
+			p_receivedBuffer + *(p_sliceEnds + slice - 1) + 1))) {		/* pointer to the address from which the parameter's section in the string begins */
 			
-			printf("Error: Failed to create a parameter struct for a received message tp contain one of the message's parameter's info.\n");
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_FAILURE, "Failed to create a parameter struct for a received message tp contain one of the message's parameter's info", 0, 0);
 			return STATUS_CODE_FAILURE;
 		}
 		//Update parameters nested list
-		if (0 == paramIndex) {
+		if (1 == slice) {
 			p_receivedMessageInfo->p_parameters = p_next;	//Starting the parameters next list
 			p_current = p_receivedMessageInfo->p_parameters;//pointing a temp pointer at the current last parameter in the list == the first
 		}
@@ -808,8 +841,6 @@ static BOOL extractMessageParameters(char* p_receivedBuffer, message* p_received
 			p_current->p_nextParameter = p_next; //Chaining the links (parameters)
 			p_current = p_next;				 	 //Advancing to the next link
 		}
-		//Prepare for more parameters
-		paramIndex++;
 	}
 
 	//"message" struct updated as needed...
@@ -818,19 +849,19 @@ static BOOL extractMessageParameters(char* p_receivedBuffer, message* p_received
 
 static BOOL extractMessageInfo(char* p_receivedBuffer, message* p_receivedMessageInfo)
 {
-	int receivedMessageTypeLength = 0;
+	int receivedMessageTypeLength = 0, sliceEnds[MESSAGE_MAX_SLICES] = { 0 }, numOfSlices = 0;
 	char* p_receivedMessageTypeString = NULL;
 	//Assert
 	assert(NULL != p_receivedBuffer);
 	//assert(0 < messageLength); 'CHECK'
 
-	//Find the index of the last character of the received message type part of the buffer  (also #MessageTypeBytes)
-	receivedMessageTypeLength = findPositionOffsetOfGivenCharacterInBuffer(p_receivedBuffer, 0, ':');
+	//Find where the message type & every parameter end, in a single pass. The end of the message type is also #MessageTypeBytes
+	if (0 == (numOfSlices = findMessageSliceEnds(p_receivedBuffer, sliceEnds))) return STATUS_CODE_FAILURE;
+	receivedMessageTypeLength = sliceEnds[0];
 
-	//Allocate Heap memory for the received message type string
-	if (NULL == (p_receivedMessageTypeString = (char*)calloc(sizeof(char), receivedMessageTypeLength + 1))) {
-		printf("Error: Failed to allocate dynamic memory (Heap) string.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+	//Allocate memory for the received message type string (from the thread's slab)
+	if (NULL == (p_receivedMessageTypeString = allocateSlabBuffer(receivedMessageTypeLength + 1))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a string", 0, 0);
 		return STATUS_CODE_FAILURE;
 	}
 
@@ -839,9 +870,8 @@ static BOOL extractMessageInfo(char* p_receivedBuffer, message* p_receivedMessag
 	///SECOND Note: In fact both sscanf_s & sprintf_s failed to write data from BIGGER buffer to a SMALLER buffer
 	// without any unconvertable characters - READ https://docs.microsoft.com/en-us/cpp/c-runtime-library/scanf-width-specification?view=msvc-160 
 	if (EOF == sscanf_s(p_receivedBuffer, "%s", p_receivedMessageTypeString, receivedMessageTypeLength)) {
-		printf("Error: Failed to copy the message type into a new buffer\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
-		free(p_receivedMessageTypeString);
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to copy the message type into a new buffer", 0, 0);
+		freeSlabObject(p_receivedMessageTypeString);
 		return STATUS_CODE_FAILURE;
 	}*/
 
@@ -850,31 +880,46 @@ static BOOL extractMessageInfo(char* p_receivedBuffer, message* p_receivedMessag
 
 	//Compare the extracted message type string to all possible types...
 	//Server
-	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_MAIN_MENU, receivedMessageTypeLength + 1))  p_receivedMessageInfo->messageType = SERVER_MAIN_MENU_NUM;
-	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_APPROVED, receivedMessageTypeLength + 1))  p_receivedMessageInfo->messageType = SERVER_APPROVED_NUM;
+	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_MAIN_MENU, receivedMessageTypeLength + 1))
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_MAIN_MENU_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
+			return STATUS_CODE_FAILURE;
+		}
+
+	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_APPROVED, receivedMessageTypeLength + 1))
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_APPROVED_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
+			return STATUS_CODE_FAILURE;
+		}
+
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_DENIED, receivedMessageTypeLength + 1)) 
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_DENIED_NUM, receivedMessageTypeLength)){
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_DENIED_NUM, sliceEnds, numOfSlices)){
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_INVITE, receivedMessageTypeLength + 1)) 
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_INVITE_NUM, receivedMessageTypeLength)) {
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_INVITE_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
+			return STATUS_CODE_FAILURE;
+		}
+
+	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_SETUP_REQUSET, receivedMessageTypeLength + 1))
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_SETUP_REQUSET_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
-	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_SETUP_REQUSET, receivedMessageTypeLength + 1))  p_receivedMessageInfo->messageType = SERVER_SETUP_REQUSET_NUM;
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_PLAYER_MOVE_REQUEST, receivedMessageTypeLength + 1))  p_receivedMessageInfo->messageType = SERVER_PLAYER_MOVE_REQUEST_NUM;
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_GAME_RESULTS, receivedMessageTypeLength + 1))  
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_GAME_RESULTS_NUM, receivedMessageTypeLength)) {
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_GAME_RESULTS_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, SERVER_WIN, receivedMessageTypeLength + 1))  
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_WIN_NUM, receivedMessageTypeLength)) {
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, SERVER_WIN_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
@@ -886,27 +931,27 @@ static BOOL extractMessageInfo(char* p_receivedBuffer, message* p_receivedMessag
 
 	//Client
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, CLIENT_REQUEST, receivedMessageTypeLength + 1)) 
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, CLIENT_REQUEST_NUM, receivedMessageTypeLength)) {
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, CLIENT_REQUEST_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, CLIENT_VERSUS, receivedMessageTypeLength + 1))  p_receivedMessageInfo->messageType = CLIENT_VERSUS_NUM;
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, CLIENT_SETUP, receivedMessageTypeLength + 1))  
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, CLIENT_SETUP_NUM, receivedMessageTypeLength)) {
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, CLIENT_SETUP_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, CLIENT_PLAYER_MOVE, receivedMessageTypeLength + 1)) 
-		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, CLIENT_PLAYER_MOVE_NUM, receivedMessageTypeLength)) {
-			free(p_receivedMessageTypeString);
+		if (STATUS_CODE_SUCCESS != extractMessageParameters(p_receivedBuffer, p_receivedMessageInfo, CLIENT_PLAYER_MOVE_NUM, sliceEnds, numOfSlices)) {
+			freeSlabObject(p_receivedMessageTypeString);
 			return STATUS_CODE_FAILURE;
 		}
 
 	if (STRINGS_ARE_EQUAL(p_receivedMessageTypeString, CLIENT_DISCONNECT, receivedMessageTypeLength + 1))  p_receivedMessageInfo->messageType = CLIENT_DISCONNECT_NUM;
 
 	//Free the message type temporary (used for comparisons only) string
-	free(p_receivedMessageTypeString);
+	freeSlabObject(p_receivedMessageTypeString);
 	return STATUS_CODE_SUCCESS;
 }
@@ -40,8 +40,9 @@ messageString* constructMessageForSendingServer(int messageType, char* p_paramOn
 /// </summary>
 // <param name="int messageType - message type identifier number"></param>
 /// <param name="char* p_paramOne - param 1 buffer"></param>
+/// <param name="char* p_paramTwo - param 2 buffer (CLIENT_REQUEST's session token only)"></param>
 /// <returns>'messageString' pointer containing the prepared string and its size in bytes if successful, and NULL if failed</returns>
-messageString* constructMessageForSendingClient(int messageType, char* p_paramOne);
+messageString* constructMessageForSendingClient(int messageType, char* p_paramOne, char* p_paramTwo);
 
 /// <summary>
 /// Descirption - Translates the received message buffer into separated pieces of information, message type and parmeters
@@ -57,15 +58,25 @@ message* translateReceivedMessageToMessageStruct(char* p_receivedBuffer);
 
 //0o0o0oo0o0o0o0o0oUtility functions
 /// <summary>
-/// Description - function receives a pointer to a string, and calculates its' length (until '\0')
+/// Description - function receives a pointer to a string, and calculates its' length (until '\0'), 16 bytes at a time (SSE2_SCANNING)
 /// </summary>
 /// <param name="char* p_stringBuffer - pointer to string"></param>
 /// <returns>length integer value</returns>
 int fetchStringLength(char* p_stringBuffer);
 
+/// <summary>
+/// Description - function scans a buffer, starting at a given position, for the first byte that equals one of four characters (repeat a character
+/// to look for fewer), 16 bytes at a time (SSE2_SCANNING). One of the characters MUST appear in the buffer at or after the starting position
+/// </summary>
+/// <param name="const char* p_buffer - pointer to the scanned buffer"></param>
+/// <param name="int scanStartingPosition - starting scanning position in the buffer"></param>
+/// <param name="char first, second, third, fourth - the looked for characters"></param>
+/// <returns>position of the first matching byte in the buffer</returns>
+int findFirstOfCharacters(const char* p_buffer, int scanStartingPosition, char first, char second, char third, char fourth);
+
 /// <summary>
 ///  Description - function a destination buffer pointer, a source buffer pointer, current position in the destination buffer, starting from
-///  which, it is needed to copy a given number of bytes -> Brute Force string copy!!!!
+///  which, it is needed to copy a given number of bytes (any bytes, '\0' included) -> wide moves with memcpy(.)
 /// </summary>
 /// <param name="char* p_destBuffer - destination buffer pointer"></param>
 /// <param name="char* p_sourceBuffer - source buffer pointer"></param>
@@ -0,0 +1,359 @@
+/* MetricsTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the metrics registry of the Server:
+		messages & bytes counters per message type, timeouts per Worker phase,
+		admission denials, and latency histograms (send, parse, opponent waiting,
+		guessing rounds). Every processor records into its own cache line aligned
+		shard, so threads on different processors never share a written line,
+		and a snapshot merges all the shards without stopping the Worker threads.
+		Histograms are log-linear (HDR-style): a power of 2 is split into
+		METRICS_HISTOGRAM_SUB_BUCKETS linear sub-buckets, so recording is a bit
+		scan & an increment, and the relative error is bounded by 1/8.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <intrin.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "MetricsTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const LONGLONG MICROSECONDS_IN_SECOND = 1000000;
+static const double PERCENT = 100.0;
+
+// Global variables ------------------------------------------------------------
+//Shards (a contiguous, cache line aligned block) & their number. NULL until the registry is initialized
+static metricsShard* g_p_metricsShards = NULL;
+static int g_numOfMetricsShards = 0;
+
+//Performance counter frequency - converts the measured ticks to microseconds
+static LONGLONG g_metricsClockFrequency = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function fetches the shard of the processor the calling thread currently runs on
+/// </summary>
+/// <returns>pointer to the shard</returns>
+static metricsShard* fetchCurrentProcessorShard();
+
+/// <summary>
+/// Description - This function records the duration since the given ticks into a shard's histogram
+/// </summary>
+/// <param name="metricsHistogram* p_histogram - pointer to the shard's histogram"></param>
+/// <param name="LONGLONG startTicks - readMetricsClock(.) value taken at the start of the duration"></param>
+static void recordDurationIntoHistogram(metricsHistogram* p_histogram, LONGLONG startTicks);
+
+/// <summary>
+/// Description - This function calculates the bucket a value falls into: values below 2 * METRICS_HISTOGRAM_SUB_BUCKETS have a bucket each,
+/// larger values are placed by their highest set bit (the power of 2) & the METRICS_HISTOGRAM_SUB_BUCKET_BITS bits that follow it (the sub-bucket)
+/// </summary>
+/// <param name="LONGLONG microseconds - the recorded value"></param>
+/// <returns>bucket index</returns>
+static int fetchHistogramBucketIndex(LONGLONG microseconds);
+
+/// <summary>
+/// Description - This function reads a 64 bit counter that other threads may be incrementing (atomic also on 32 bit builds)
+/// </summary>
+/// <param name="volatile LONG64* p_counter - pointer to the counter"></param>
+/// <returns>the counter's value</returns>
+static LONG64 readShardCounter(volatile LONG64* p_counter);
+
+/// <summary>
+/// Description - This function adds a shard's histogram to a merged histogram
+/// </summary>
+/// <param name="metricsHistogramSnapshot* p_merged - pointer to the merged histogram"></param>
+/// <param name="metricsHistogram* p_shardHistogram - pointer to the shard's histogram"></param>
+static void mergeHistogramIntoSnapshot(metricsHistogramSnapshot* p_merged, metricsHistogram* p_shardHistogram);
+
+
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeMetricsRegistry()
+{
+	SYSTEM_INFO systemInfo;
+	LARGE_INTEGER frequency;
+
+	//Sample the performance counter frequency once (it is fixed at boot)
+	if (FALSE == QueryPerformanceFrequency(&frequency)) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to query the performance counter frequency", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	g_metricsClockFrequency = frequency.QuadPart;
+
+	//A shard per processor, up to METRICS_MAX_SHARDS
+	GetSystemInfo(&systemInfo);
+	g_numOfMetricsShards = (int)systemInfo.dwNumberOfProcessors;
+	if (0 >= g_numOfMetricsShards) g_numOfMetricsShards = 1;
+	if (METRICS_MAX_SHARDS < g_numOfMetricsShards) g_numOfMetricsShards = METRICS_MAX_SHARDS;
+
+	//Allocate all the shards as a single cache line aligned block & zero them
+	if (NULL == (g_p_metricsShards = (metricsShard*)_aligned_malloc(g_numOfMetricsShards * sizeof(metricsShard), CACHE_LINE_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "the metrics registry shards", 0, 0);
+		g_numOfMetricsShards = 0;
+		return STATUS_CODE_FAILURE;
+	}
+	memset(g_p_metricsShards, 0, g_numOfMetricsShards * sizeof(metricsShard));
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyMetricsRegistry()
+{
+	if (NULL != g_p_metricsShards) {
+		_aligned_free(g_p_metricsShards);
+		g_p_metricsShards = NULL;
+		g_numOfMetricsShards = 0;
+	}
+}
+
+LONGLONG readMetricsClock()
+{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	return ticks.QuadPart;
+}
+
+void recordMessageSent(int messageType, DWORD bytes, LONGLONG startTicks)
+{
+	metricsShard* p_shard = NULL;
+	//Registry not initialized (Client process) or an unknown message type - nothing to record
+	if ((NULL == g_p_metricsShards) || (0 >= messageType) || (NUM_OF_MESSAGE_TYPES <= messageType)) return;
+
+	p_shard = fetchCurrentProcessorShard();
+	InterlockedIncrement64(&p_shard->messagesSent[messageType]);
+	InterlockedExchangeAdd64(&p_shard->bytesSent[messageType], (LONG64)bytes);
+	recordDurationIntoHistogram(&p_shard->sendTime[messageType], startTicks);
+}
+
+void recordMessageReceived(int messageType, DWORD bytes, LONGLONG startTicks)
+{
+	metricsShard* p_shard = NULL;
+	//Registry not initialized (Client process) or an unknown message type - nothing to record
+	if ((NULL == g_p_metricsShards) || (0 >= messageType) || (NUM_OF_MESSAGE_TYPES <= messageType)) return;
+
+	p_shard = fetchCurrentProcessorShard();
+	InterlockedIncrement64(&p_shard->messagesReceived[messageType]);
+	InterlockedExchangeAdd64(&p_shard->bytesReceived[messageType], (LONG64)bytes);
+	recordDurationIntoHistogram(&p_shard->parseTime[messageType], startTicks);
+}
+
+void recordOpponentWait(workerPhases phase, LONGLONG startTicks)
+{
+	if ((NULL == g_p_metricsShards) || (0 > phase) || (NUM_OF_WORKER_PHASES <= phase)) return;
+	recordDurationIntoHistogram(&fetchCurrentProcessorShard()->opponentWaitTime[phase], startTicks);
+}
+
+void recordRoundDuration(LONGLONG startTicks)
+{
+	if (NULL == g_p_metricsShards) return;
+	recordDurationIntoHistogram(&fetchCurrentProcessorShard()->roundDuration, startTicks);
+}
+
+void recordWorkerPhaseTimeout(workerPhases phase)
+{
+	if ((NULL == g_p_metricsShards) || (0 > phase) || (NUM_OF_WORKER_PHASES <= phase)) return;
+	InterlockedIncrement64(&fetchCurrentProcessorShard()->timeouts[phase]);
+}
+
+void recordAdmissionDenial()
+{
+	if (NULL == g_p_metricsShards) return;
+	InterlockedIncrement64(&fetchCurrentProcessorShard()->admissionDenials);
+}
+
+void recordInvalidPlayerNumber()
+{
+	if (NULL == g_p_metricsShards) return;
+	InterlockedIncrement64(&fetchCurrentProcessorShard()->invalidPlayerNumbers);
+}
+
+void recordMatchmakingOutcome(matchmakingOutcomes outcome, LONGLONG startTicks)
+{
+	metricsShard* p_shard = NULL;
+	if ((NULL == g_p_metricsShards) || (0 > outcome) || (NUM_OF_MATCHMAKING_OUTCOMES <= outcome)) return;
+
+	p_shard = fetchCurrentProcessorShard();
+	InterlockedIncrement64(&p_shard->matchmakingOutcomes[outcome]);
+	if ((MATCHMAKING_MATCHED_PLAYER == outcome) || (MATCHMAKING_MATCHED_BOT == outcome))
+		recordDurationIntoHistogram(&p_shard->matchLatency, startTicks);
+}
+
+BOOL takeMetricsSnapshot(metricsSnapshot* p_snapshot)
+{
+	metricsShard* p_shard = NULL;
+	int shard = 0, type = 0, phase = 0, outcome = 0;
+	//Input integrity validation
+	if (NULL == p_snapshot) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+	if (NULL == g_p_metricsShards) return STATUS_CODE_FAILURE;
+
+	memset(p_snapshot, 0, sizeof(metricsSnapshot));
+	//Sum every shard - the Worker threads keep recording meanwhile
+	for (shard = 0; shard < g_numOfMetricsShards; shard++) {
+		p_shard = g_p_metricsShards + shard;
+		for (type = 0; type < NUM_OF_MESSAGE_TYPES; type++) {
+			p_snapshot->messagesSent[type] += readShardCounter(&p_shard->messagesSent[type]);
+			p_snapshot->bytesSent[type] += readShardCounter(&p_shard->bytesSent[type]);
+			p_snapshot->messagesReceived[type] += readShardCounter(&p_shard->messagesReceived[type]);
+			p_snapshot->bytesReceived[type] += readShardCounter(&p_shard->bytesReceived[type]);
+			mergeHistogramIntoSnapshot(&p_snapshot->sendTime[type], &p_shard->sendTime[type]);
+			mergeHistogramIntoSnapshot(&p_snapshot->parseTime[type], &p_shard->parseTime[type]);
+		}
+		for (phase = 0; phase < NUM_OF_WORKER_PHASES; phase++) {
+			p_snapshot->timeouts[phase] += readShardCounter(&p_shard->timeouts[phase]);
+			mergeHistogramIntoSnapshot(&p_snapshot->opponentWaitTime[phase], &p_shard->opponentWaitTime[phase]);
+		}
+		p_snapshot->admissionDenials += readShardCounter(&p_shard->admissionDenials);
+		p_snapshot->invalidPlayerNumbers += readShardCounter(&p_shard->invalidPlayerNumbers);
+		for (outcome = 0; outcome < NUM_OF_MATCHMAKING_OUTCOMES; outcome++)
+			p_snapshot->matchmakingOutcomes[outcome] += readShardCounter(&p_shard->matchmakingOutcomes[outcome]);
+		mergeHistogramIntoSnapshot(&p_snapshot->roundDuration, &p_shard->roundDuration);
+		mergeHistogramIntoSnapshot(&p_snapshot->matchLatency, &p_shard->matchLatency);
+	}
+	p_snapshot->numOfShards = g_numOfMetricsShards;
+
+	return STATUS_CODE_SUCCESS;
+}
+
+LONGLONG fetchHistogramBucketUpperBound(int bucket)
+{
+	int exponent = 0, subBucket = 0;
+	assert((0 <= bucket) && (METRICS_HISTOGRAM_NUM_OF_BUCKETS > bucket));
+
+	//The first sub-buckets hold a single value each
+	if (METRICS_HISTOGRAM_SUB_BUCKETS > bucket) return (LONGLONG)bucket;
+
+	//Reverse fetchHistogramBucketIndex(.): the power of 2 & the sub-bucket within it
+	exponent = bucket / METRICS_HISTOGRAM_SUB_BUCKETS + METRICS_HISTOGRAM_SUB_BUCKET_BITS - 1;
+	subBucket = bucket % METRICS_HISTOGRAM_SUB_BUCKETS;
+	return (((LONGLONG)(METRICS_HISTOGRAM_SUB_BUCKETS + subBucket + 1)) << (exponent - METRICS_HISTOGRAM_SUB_BUCKET_BITS)) - 1;
+}
+
+LONGLONG fetchHistogramPercentile(const metricsHistogramSnapshot* p_histogram, double percentile)
+{
+	LONG64 rank = 0, accumulated = 0;
+	LONGLONG upperBound = 0;
+	int bucket = 0;
+	//Input integrity validation
+	if ((NULL == p_histogram) || (0.0 > percentile) || (PERCENT < percentile)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return 0;
+	}
+	if (0 == p_histogram->count) return 0;
+
+	//The rank of the percentile value (1 based, rounded up)
+	rank = (LONG64)((percentile / PERCENT) * (double)p_histogram->count + 0.999999);
+	if (1 > rank) rank = 1;
+
+	//Walk the buckets until the rank is reached
+	for (bucket = 0; bucket < METRICS_HISTOGRAM_NUM_OF_BUCKETS; bucket++) {
+		accumulated += p_histogram->buckets[bucket];
+		if (accumulated >= rank) break;
+	}
+	if (METRICS_HISTOGRAM_NUM_OF_BUCKETS == bucket) bucket = METRICS_HISTOGRAM_NUM_OF_BUCKETS - 1;
+
+	//A bucket's upper bound may exceed every value recorded into it
+	upperBound = fetchHistogramBucketUpperBound(bucket);
+	return (upperBound > p_histogram->maxMicroseconds) ? p_histogram->maxMicroseconds : upperBound;
+}
+
+
+
+
+//......................................Static functions..........................................
+
+static metricsShard* fetchCurrentProcessorShard()
+{
+	return g_p_metricsShards + (GetCurrentProcessorNumber() % (DWORD)g_numOfMetricsShards);
+}
+
+static void recordDurationIntoHistogram(metricsHistogram* p_histogram, LONGLONG startTicks)
+{
+	LONG64 microseconds = 0, currentMaximum = 0, previousMaximum = 0;
+	assert(NULL != p_histogram);
+
+	//Ticks to microseconds (a negative duration is impossible, unless the start was never taken)
+	microseconds = ((readMetricsClock() - startTicks) * MICROSECONDS_IN_SECOND) / g_metricsClockFrequency;
+	if (0 > microseconds) microseconds = 0;
+
+	InterlockedIncrement(&p_histogram->buckets[fetchHistogramBucketIndex(microseconds)]);
+	InterlockedExchangeAdd64(&p_histogram->sumMicroseconds, microseconds);
+
+	//Raise the maximum - retried only if another thread raised it in the meanwhile
+	currentMaximum = p_histogram->maxMicroseconds;
+	while (microseconds > currentMaximum) {
+		previousMaximum = InterlockedCompareExchange64(&p_histogram->maxMicroseconds, microseconds, currentMaximum);
+		if (previousMaximum == currentMaximum) break;
+		currentMaximum = previousMaximum;
+	}
+}
+
+static int fetchHistogramBucketIndex(LONGLONG microseconds)
+{
+	unsigned long exponent = 0;
+
+	//Values below METRICS_HISTOGRAM_SUB_BUCKETS are their own bucket
+	if (METRICS_HISTOGRAM_SUB_BUCKETS > microseconds) return (0 > microseconds) ? 0 : (int)microseconds;
+
+	//Highest set bit - scanned as two 32 bit halves, so 32 bit builds use the same code
+	if (0 != (ULONG)(microseconds >> 32)) {
+		_BitScanReverse(&exponent, (ULONG)(microseconds >> 32));
+		exponent += 32;
+	}
+	else _BitScanReverse(&exponent, (ULONG)microseconds);
+
+	//Values of 2^METRICS_HISTOGRAM_MAX_EXPONENT & above share the last bucket
+	if (METRICS_HISTOGRAM_MAX_EXPONENT <= exponent) return METRICS_HISTOGRAM_NUM_OF_BUCKETS - 1;
+
+	//The power of 2 selects a group of sub-buckets, the bits right below the highest bit select the sub-bucket
+	return (int)((exponent - METRICS_HISTOGRAM_SUB_BUCKET_BITS + 1) * METRICS_HISTOGRAM_SUB_BUCKETS +
+		((microseconds >> (exponent - METRICS_HISTOGRAM_SUB_BUCKET_BITS)) & (METRICS_HISTOGRAM_SUB_BUCKETS - 1)));
+}
+
+static LONG64 readShardCounter(volatile LONG64* p_counter)
+{
+	//Compare-exchange with equal values never changes the counter, but reads all its 64 bits at once
+	return InterlockedCompareExchange64(p_counter, 0, 0);
+}
+
+static void mergeHistogramIntoSnapshot(metricsHistogramSnapshot* p_merged, metricsHistogram* p_shardHistogram)
+{
+	LONG64 bucketCount = 0, shardMaximum = 0;
+	int bucket = 0;
+	assert(NULL != p_merged);
+	assert(NULL != p_shardHistogram);
+
+	for (bucket = 0; bucket < METRICS_HISTOGRAM_NUM_OF_BUCKETS; bucket++) {
+		bucketCount = p_shardHistogram->buckets[bucket];
+		p_merged->buckets[bucket] += bucketCount;
+		p_merged->count += bucketCount;
+	}
+	p_merged->sumMicroseconds += readShardCounter(&p_shardHistogram->sumMicroseconds);
+	shardMaximum = readShardCounter(&p_shardHistogram->maxMicroseconds);
+	if (shardMaximum > p_merged->maxMicroseconds) p_merged->maxMicroseconds = shardMaximum;
+}
@@ -0,0 +1,118 @@
+/* MetricsTools.h
+------------------------------------------------------------------
+	Module Description - header module for MetricsTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __METRICS_TOOLS_H__
+#define __METRICS_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function prepares the metrics registry: allocates a zeroed shard per processor (up to METRICS_MAX_SHARDS) & samples the
+/// performance counter frequency. Must be called once, before any thread is created. Until it is called (e.g. in the Client process) all the
+/// record functions return at once
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeMetricsRegistry();
+
+/// <summary>
+/// Description - This function frees the shards. Must be called once, after all other threads ended
+/// </summary>
+void destroyMetricsRegistry();
+
+/// <summary>
+/// Description - This function reads the metrics clock (QueryPerformanceCounter ticks). Its value is passed to the record functions as the start of the measured duration
+/// </summary>
+/// <returns>current ticks</returns>
+LONGLONG readMetricsClock();
+
+/// <summary>
+/// Description - This function counts a sent message & its bytes and records its construction & send duration, in the calling processor's shard
+/// </summary>
+/// <param name="int messageType - the message type serial number"></param>
+/// <param name="DWORD bytes - # of bytes sent, length prefix included"></param>
+/// <param name="LONGLONG startTicks - readMetricsClock(.) value taken before the message was constructed"></param>
+void recordMessageSent(int messageType, DWORD bytes, LONGLONG startTicks);
+
+/// <summary>
+/// Description - This function counts a received message & its bytes and records its translation (parsing) duration, in the calling processor's shard
+/// </summary>
+/// <param name="int messageType - the message type serial number"></param>
+/// <param name="DWORD bytes - # of bytes received, length prefix included"></param>
+/// <param name="LONGLONG startTicks - readMetricsClock(.) value taken before the message was translated"></param>
+void recordMessageReceived(int messageType, DWORD bytes, LONGLONG startTicks);
+
+/// <summary>
+/// Description - This function records the time a Worker thread was blocked on its opponent's Worker thread at the given phase
+/// </summary>
+/// <param name="workerPhases phase - WORKER_PHASE_PAIRING, WORKER_PHASE_SETUP or WORKER_PHASE_GUESSING"></param>
+/// <param name="LONGLONG startTicks - readMetricsClock(.) value taken before the wait"></param>
+void recordOpponentWait(workerPhases phase, LONGLONG startTicks);
+
+/// <summary>
+/// Description - This function records the duration of a whole guessing round
+/// </summary>
+/// <param name="LONGLONG startTicks - readMetricsClock(.) value taken when the round began"></param>
+void recordRoundDuration(LONGLONG startTicks);
+
+/// <summary>
+/// Description - This function counts a timeout at the given Worker phase
+/// </summary>
+/// <param name="workerPhases phase - the phase at which the timeout was reached"></param>
+void recordWorkerPhaseTimeout(workerPhases phase);
+
+/// <summary>
+/// Description - This function counts a Client declined with SERVER_DENIED
+/// </summary>
+void recordAdmissionDenial();
+
+/// <summary>
+/// Description - This function counts a CLIENT_SETUP\CLIENT_PLAYER_MOVE number the Game Room's variant does not allow (the Client is disconnected)
+/// </summary>
+void recordInvalidPlayerNumber();
+
+/// <summary>
+/// Description - This function counts a CLIENT_VERSUS request by its matchmaking outcome, and for a matched player also records the time it took to find the opponent
+/// </summary>
+/// <param name="matchmakingOutcomes outcome - the matchmaking outcome"></param>
+/// <param name="LONGLONG startTicks - readMetricsClock(.) value taken when the request was received"></param>
+void recordMatchmakingOutcome(matchmakingOutcomes outcome, LONGLONG startTicks);
+
+/// <summary>
+/// Description - This function merges all the shards into the given snapshot, while the Worker threads keep recording (nothing is locked or stopped).
+/// Every single counter & bucket is exact, but values recorded during the merge may be missing from some of them
+/// </summary>
+/// <param name="metricsSnapshot* p_snapshot - pointer to the snapshot that will be filled"></param>
+/// <returns>True if succeeded. False if the registry is not initialized</returns>
+BOOL takeMetricsSnapshot(metricsSnapshot* p_snapshot);
+
+/// <summary>
+/// Description - This function calculates the largest value (microseconds) a histogram bucket holds
+/// </summary>
+/// <param name="int bucket - bucket index (0 to METRICS_HISTOGRAM_NUM_OF_BUCKETS - 1)"></param>
+/// <returns>the bucket's upper bound in microseconds (inclusive)</returns>
+LONGLONG fetchHistogramBucketUpperBound(int bucket);
+
+/// <summary>
+/// Description - This function calculates a percentile of a merged histogram
+/// </summary>
+/// <param name="const metricsHistogramSnapshot* p_histogram - pointer to the histogram"></param>
+/// <param name="double percentile - 0.0 to 100.0 (e.g. 99.9)"></param>
+/// <returns>upper bound (microseconds) of the bucket holding the percentile, capped by the largest recorded value. 0 if the histogram is empty</returns>
+LONGLONG fetchHistogramPercentile(const metricsHistogramSnapshot* p_histogram, double percentile);
+
+
+#endif //__METRICS_TOOLS_H__
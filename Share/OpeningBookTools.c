@@ -0,0 +1,136 @@
+/* OpeningBookTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the opening book - the solver's
+		decision tree of the classic variant, built offline by the
+		OPENING_BOOK_BUILDER build of the Server (OpeningBookBuilder.c). The
+		book file is mapped read-only once, before any thread plays it, and is
+		never written, so the Server's bot & the Client's hints read it without
+		a lock. A move is a pointer chase - the next node of a result is the
+		node's first child plus the # of lower results that have a child.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <intrin.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "OpeningBookTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const LONG OPENING_BOOK_ROOT = 0;
+
+// Global variables ------------------------------------------------------------
+//The book file, its mapping & view, and the view's nodes
+static HANDLE g_h_openingBookFile = INVALID_HANDLE_VALUE;
+static HANDLE g_h_openingBookMapping = NULL;
+static const char* g_p_openingBookView = NULL;
+static const openingBookNode* g_p_openingBookNodes = NULL;
+static LONG g_numOfOpeningBookNodes = 0;
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL loadOpeningBook(const char* p_bookPath)
+{
+	const openingBookHeader* p_header = NULL;
+	LARGE_INTEGER bookFileSize;
+	//Input integrity validation
+	if (NULL == p_bookPath) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+
+	//Map the whole file
+	if (INVALID_HANDLE_VALUE == (g_h_openingBookFile = CreateFile(p_bookPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to open the opening book file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	if ((FALSE == GetFileSizeEx(g_h_openingBookFile, &bookFileSize)) || ((LONGLONG)sizeof(openingBookHeader) > bookFileSize.QuadPart) ||
+		(NULL == (g_h_openingBookMapping = CreateFileMapping(g_h_openingBookFile, NULL, PAGE_READONLY, 0, 0, NULL))) ||
+		(NULL == (g_p_openingBookView = (const char*)MapViewOfFile(g_h_openingBookMapping, FILE_MAP_READ, 0, 0, 0)))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to map the opening book file", GetLastError(), 0);
+		unloadOpeningBook();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Check the header only - a node's children are checked when followed
+	p_header = (const openingBookHeader*)g_p_openingBookView;
+	if ((OPENING_BOOK_MAGIC != p_header->magic) || (PLAYER_NUMBER_LEN != p_header->numberLength) || (0 >= p_header->numOfNodes) ||
+		((LONGLONG)sizeof(openingBookHeader) + (LONGLONG)sizeof(openingBookNode) * p_header->numOfNodes != bookFileSize.QuadPart)) {
+		LOG_EVENT(LOG_EVENT_UNEXPECTED, "The opening book file is not a book of the classic variant", p_header->magic, bookFileSize.QuadPart);
+		unloadOpeningBook();
+		return STATUS_CODE_FAILURE;
+	}
+	g_p_openingBookNodes = (const openingBookNode*)(g_p_openingBookView + sizeof(openingBookHeader));
+	g_numOfOpeningBookNodes = p_header->numOfNodes;
+	return STATUS_CODE_SUCCESS;
+}
+
+void unloadOpeningBook()
+{
+	g_p_openingBookNodes = NULL;
+	g_numOfOpeningBookNodes = 0;
+	if (NULL != g_p_openingBookView) {
+		UnmapViewOfFile(g_p_openingBookView);
+		g_p_openingBookView = NULL;
+	}
+	if (NULL != g_h_openingBookMapping) {
+		CloseHandle(g_h_openingBookMapping);
+		g_h_openingBookMapping = NULL;
+	}
+	if (INVALID_HANDLE_VALUE != g_h_openingBookFile) {
+		CloseHandle(g_h_openingBookFile);
+		g_h_openingBookFile = INVALID_HANDLE_VALUE;
+	}
+}
+
+LONG fetchOpeningBookRoot()
+{
+	return (NULL != g_p_openingBookNodes) ? OPENING_BOOK_ROOT : OPENING_BOOK_NO_NODE;
+}
+
+void fetchOpeningBookGuess(LONG node, char* p_guess)
+{
+	//Asserts
+	assert((0 <= node) && (node < g_numOfOpeningBookNodes));
+	assert(NULL != p_guess);
+
+	memcpy(p_guess, g_p_openingBookNodes[node].guess, PLAYER_NUMBER_LEN);
+	p_guess[PLAYER_NUMBER_LEN] = '\0';
+}
+
+LONG followOpeningBook(LONG node, SHORT bulls, SHORT cows)
+{
+	const openingBookNode* p_node = NULL;
+	ULONG scoreCode = 0;
+	LONG child = 0;
+	//Assert
+	assert((0 <= node) && (node < g_numOfOpeningBookNodes));
+
+	if ((0 > bulls) || (0 > cows) || (PLAYER_NUMBER_LEN < bulls + cows)) return OPENING_BOOK_NO_NODE;
+	p_node = g_p_openingBookNodes + node;
+	scoreCode = SCORE_CODE(bulls, cows);
+	if (0 == (p_node->childrenMask & (1UL << scoreCode))) return OPENING_BOOK_NO_NODE;
+
+	//The children are ordered by score code - skip the ones of the lower results
+	child = p_node->firstChild + (LONG)__popcnt(p_node->childrenMask & ((1UL << scoreCode) - 1));
+	return ((0 < child) && (child < g_numOfOpeningBookNodes)) ? child : OPENING_BOOK_NO_NODE;
+}
@@ -0,0 +1,59 @@
+/* OpeningBookTools.h
+------------------------------------------------------------------
+	Module Description - header module for OpeningBookTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __OPENING_BOOK_TOOLS_H__
+#define __OPENING_BOOK_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function maps the opening book file read-only. Only the header is checked, so the book is ready at once whatever its size.
+/// Must be called before any thread that plays the book is created
+/// </summary>
+/// <param name="const char* p_bookPath - the book's path (OPENING_BOOK_PATH)"></param>
+/// <returns>True if succeeded. False otherwise (e.g. no book was built) - then the book has no root, and the callers play without it</returns>
+BOOL loadOpeningBook(const char* p_bookPath);
+
+/// <summary>
+/// Description - This function unmaps the opening book. Must be called after all the threads that play the book ended. Does nothing if no book is mapped
+/// </summary>
+void unloadOpeningBook();
+
+/// <summary>
+/// Description - This function returns the book's root - the node of the first guess
+/// </summary>
+/// <returns>the root's index, or OPENING_BOOK_NO_NODE if no book is mapped</returns>
+LONG fetchOpeningBookRoot();
+
+/// <summary>
+/// Description - This function copies a node's guess
+/// </summary>
+/// <param name="LONG node - a node's index (not OPENING_BOOK_NO_NODE)"></param>
+/// <param name="char* p_guess - buffer of PLAYER_NUMBER_LEN + 1 bytes, the guess is terminated"></param>
+void fetchOpeningBookGuess(LONG node, char* p_guess);
+
+/// <summary>
+/// Description - This function follows the result of a node's guess to the next node - a mask & a popcount, no candidate is filtered
+/// </summary>
+/// <param name="LONG node - a node's index (not OPENING_BOOK_NO_NODE)"></param>
+/// <param name="SHORT bulls - bulls of the node's guess"></param>
+/// <param name="SHORT cows - cows of the node's guess"></param>
+/// <returns>the next node's index, or OPENING_BOOK_NO_NODE if the result has none (the number was guessed, or the result is not consistent with the book)</returns>
+LONG followOpeningBook(LONG node, SHORT bulls, SHORT cows);
+
+
+#endif //__OPENING_BOOK_TOOLS_H__
@@ -0,0 +1,447 @@
+/* SendQueueTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the bounded per-connection send queues.
+		Every Worker thread attaches a queue to its Client's socket, and its sends
+		append frames (length prefix & message) to the queue, which is flushed with
+		non-blocking send(.)s - a Client that stops reading can no longer block its
+		Worker thread (and through it, the opponent) in send(.). A frame that doesn't
+		fit below the high watermark applies the queue's policy (drop the Client,
+		park the Worker thread until the Client reads, or coalesce the unsent
+		SERVER_GAME_RESULTS frames), and a Client that still has no room is evicted.
+		The queue is drained before every receive, since a Client answers only what
+		it has read. Queues depths & policies counters are served by the admin endpoint.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "SendQueueTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int SINGLE_OBJECT = 1;
+static const DWORD DONT_WAIT = 0;
+
+//Message type whose unsent frames may be removed by SEND_QUEUE_POLICY_COALESCE - a newer result supersedes them
+static const int COALESCABLE_MESSAGE_TYPE = SERVER_GAME_RESULTS_NUM;
+
+// Global variables ------------------------------------------------------------
+//Fiber Local Storage slot holding the calling thread's send queue
+static DWORD g_sendQueueFlsIndex = FLS_OUT_OF_INDEXES;
+//Registry of all attached send queues (touched on attach\detach & by statistics) and its lock
+static CRITICAL_SECTION g_sendQueuesRegistryLock;
+static sendQueue* g_p_sendQueuesRegistry = NULL;
+//Policies counters (InterlockedIncrement)
+static volatile LONG g_sendQueueEvictions = 0;
+static volatile LONG g_sendQueueParks = 0;
+static volatile LONG g_sendQueueCoalescedFrames = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function fetches the calling thread's send queue
+/// </summary>
+/// <returns>pointer to the calling thread's send queue, or NULL if none is attached (or the send queues were not initialized)</returns>
+static sendQueue* fetchCurrentThreadSendQueue();
+
+/// <summary>
+/// Description - Fiber Local Storage callback, called when a thread exits (or when the slot is freed). It unregisters & frees the thread's send queue
+/// </summary>
+/// <param name="PVOID p_flsData - the exiting thread's send queue"></param>
+static VOID WINAPI releaseSendQueueOnThreadExit(PVOID p_flsData);
+
+/// <summary>
+/// Description - This function sends the queue's bytes with non-blocking send(.)s until the queue holds at most the given # of bytes & frames.
+/// Whenever the socket's send buffer is full, it waits with select(.) for the socket to become writable, up to the given timeout
+/// </summary>
+/// <param name="sendQueue* p_queue - the calling thread's send queue"></param>
+/// <param name="LONG maxQueuedBytes - # of bytes the queue may still hold when the function returns"></param>
+/// <param name="LONG maxQueuedFrames - # of frames the queue may still hold when the function returns"></param>
+/// <param name="DWORD timeout - in milliseconds (DONT_WAIT sends only what the socket takes at once)"></param>
+/// <returns>TRANSFER_SUCCEEDED if the queue shrank enough ; TRANSFER_TIMEOUT if the Client didn't read enough in time ; TRANSFER_FAILED if the socket failed</returns>
+static transferResults flushSendQueue(sendQueue* p_queue, LONG maxQueuedBytes, LONG maxQueuedFrames, DWORD timeout);
+
+/// <summary>
+/// Description - This function removes the given # of sent bytes from the start of the queue, and the frames that were sent whole
+/// </summary>
+/// <param name="sendQueue* p_queue - the calling thread's send queue"></param>
+/// <param name="int sentBytes - # of bytes send(.) has just taken"></param>
+static void removeSentBytes(sendQueue* p_queue, int sentBytes);
+
+/// <summary>
+/// Description - This function removes every frame of COALESCABLE_MESSAGE_TYPE that wasn't started to be sent (a partly sent head frame must go out whole)
+/// </summary>
+/// <param name="sendQueue* p_queue - the calling thread's send queue"></param>
+static void coalesceQueuedResults(sendQueue* p_queue);
+
+/// <summary>
+/// Description - This function applies the queue's policy when a frame doesn't fit below the high watermark
+/// </summary>
+/// <param name="sendQueue* p_queue - the calling thread's send queue"></param>
+/// <param name="int frameLength - # of bytes of the frame to be queued"></param>
+/// <returns>TRANSFER_SUCCEEDED if there is room for the frame. TRANSFER_FAILED if the Client was evicted</returns>
+static transferResults applyHighWatermarkPolicy(sendQueue* p_queue, int frameLength);
+
+/// <summary>
+/// Description - This function evicts the queue's Client: drops its unsent frames & shuts its socket down, so the Client notices the disconnection
+/// and every following send\drain of the Worker thread fails
+/// </summary>
+/// <param name="sendQueue* p_queue - the calling thread's send queue"></param>
+/// <param name="const char* p_reason - string literal describing why the Client is evicted"></param>
+/// <returns>TRANSFER_FAILED, always</returns>
+static transferResults evictClient(sendQueue* p_queue, const char* p_reason);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeSendQueues()
+{
+	//Allocate the Fiber Local Storage slot. Unlike a TLS slot, its callback is called on thread exit
+	if (FLS_OUT_OF_INDEXES == (g_sendQueueFlsIndex = FlsAlloc(releaseSendQueueOnThreadExit))) {
+		printf("Error: Failed to allocate a Fiber Local Storage slot for the send queues, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		return STATUS_CODE_FAILURE;
+	}
+
+	InitializeCriticalSection(&g_sendQueuesRegistryLock);
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroySendQueues()
+{
+	sendQueue* p_queue = NULL;
+
+	if (FLS_OUT_OF_INDEXES == g_sendQueueFlsIndex) return; //Never initialized
+
+	//Freeing the slot calls the callback for the queues still attached
+	FlsFree(g_sendQueueFlsIndex);
+	g_sendQueueFlsIndex = FLS_OUT_OF_INDEXES;
+
+	//Free whatever was left registered
+	while (NULL != g_p_sendQueuesRegistry) {
+		p_queue = g_p_sendQueuesRegistry;
+		g_p_sendQueuesRegistry = p_queue->p_nextQueue;
+		free(p_queue);
+	}
+
+	DeleteCriticalSection(&g_sendQueuesRegistryLock);
+}
+
+BOOL attachSendQueue(SOCKET s_socket, sendQueuePolicies policy)
+{
+	sendQueue* p_queue = NULL;
+	//Input integrity validation
+	if ((INVALID_SOCKET == s_socket) || (FLS_OUT_OF_INDEXES == g_sendQueueFlsIndex)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+
+	//A thread serves one connection at a time
+	detachSendQueue();
+
+	if (NULL == (p_queue = (sendQueue*)calloc(sizeof(sendQueue), SINGLE_OBJECT))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "sendQueue struct", 0, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	p_queue->s_socket = s_socket;
+	p_queue->policy = policy;
+
+	EnterCriticalSection(&g_sendQueuesRegistryLock);
+	p_queue->p_nextQueue = g_p_sendQueuesRegistry;
+	g_p_sendQueuesRegistry = p_queue;
+	LeaveCriticalSection(&g_sendQueuesRegistryLock);
+
+	if (FALSE == FlsSetValue(g_sendQueueFlsIndex, p_queue)) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to store the send queue in the Fiber Local Storage slot", GetLastError(), 0);
+		releaseSendQueueOnThreadExit(p_queue);
+		return STATUS_CODE_FAILURE;
+	}
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void detachSendQueue()
+{
+	sendQueue* p_queue = NULL;
+
+	if (NULL == (p_queue = fetchCurrentThreadSendQueue())) return;
+
+	FlsSetValue(g_sendQueueFlsIndex, NULL);
+	releaseSendQueueOnThreadExit(p_queue);
+}
+
+BOOL isSendQueueAttached(SOCKET s_socket)
+{
+	sendQueue* p_queue = fetchCurrentThreadSendQueue();
+
+	return ((NULL != p_queue) && (s_socket == p_queue->s_socket));
+}
+
+transferResults queueFrameForSending(SOCKET s_socket, int messageType, const char* p_message, int messageLength)
+{
+	sendQueue* p_queue = fetchCurrentThreadSendQueue();
+	int frameLength = (int)sizeof(messageLength) + messageLength;
+	//Input integrity validation
+	if ((NULL == p_message) || (0 >= messageLength) || (NULL == p_queue) || (s_socket != p_queue->s_socket)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return TRANSFER_FAILED;
+	}
+	if (TRUE == p_queue->isEvicted) return TRANSFER_FAILED;
+	if (SEND_QUEUE_HIGH_WATERMARK < frameLength) {
+		LOG_EVENT(LOG_EVENT_MESSAGE_FAILURE, "The frame is longer than a whole send queue", messageType, 0);
+		return evictClient(p_queue, "Evicted - a frame longer than the send queue");
+	}
+
+	//Make room below the high watermark: first send what the socket takes at once, and only if that is not enough apply the policy
+	if ((SEND_QUEUE_HIGH_WATERMARK < p_queue->queuedBytes + frameLength) || (SEND_QUEUE_MAX_FRAMES <= p_queue->numOfFrames)) {
+		if (TRANSFER_FAILED == flushSendQueue(p_queue, SEND_QUEUE_HIGH_WATERMARK - frameLength, SEND_QUEUE_MAX_FRAMES - 1, DONT_WAIT))
+			return evictClient(p_queue, "Evicted - send(.) failed");
+		if ((SEND_QUEUE_HIGH_WATERMARK < p_queue->queuedBytes + frameLength) || (SEND_QUEUE_MAX_FRAMES <= p_queue->numOfFrames))
+			if (TRANSFER_SUCCEEDED != applyHighWatermarkPolicy(p_queue, frameLength)) return TRANSFER_FAILED;
+	}
+
+	//Append the frame - the length prefix, then the message itself (same wire format as sendString(.))
+	memcpy(p_queue->buffer + p_queue->queuedBytes, &messageLength, sizeof(messageLength));
+	memcpy(p_queue->buffer + p_queue->queuedBytes + sizeof(messageLength), p_message, messageLength);
+	p_queue->frames[p_queue->numOfFrames].messageType = messageType;
+	p_queue->frames[p_queue->numOfFrames].frameLength = frameLength;
+	p_queue->numOfFrames++;
+	p_queue->queuedBytes += frameLength;
+
+	//Send what the socket takes at once - a Client that reads leaves the queue empty
+	if (TRANSFER_FAILED == flushSendQueue(p_queue, 0, 0, DONT_WAIT)) return evictClient(p_queue, "Evicted - send(.) failed");
+
+	return TRANSFER_SUCCEEDED;
+}
+
+transferResults drainSendQueue(SOCKET s_socket, DWORD timeout)
+{
+	sendQueue* p_queue = fetchCurrentThreadSendQueue();
+
+	//Sockets without a queue were sent to with blocking send(.)s - nothing is pending
+	if ((NULL == p_queue) || (s_socket != p_queue->s_socket)) return TRANSFER_SUCCEEDED;
+	if (TRUE == p_queue->isEvicted) return TRANSFER_FAILED;
+
+	switch (flushSendQueue(p_queue, 0, 0, timeout)) {
+	case TRANSFER_SUCCEEDED: return TRANSFER_SUCCEEDED;
+	case TRANSFER_TIMEOUT: return evictClient(p_queue, "Evicted - the Client didn't read its pending frames in time");
+	default: return evictClient(p_queue, "Evicted - send(.) failed");
+	}
+}
+
+void fetchSendQueueStatistics(sendQueueStatistics* p_statistics)
+{
+	sendQueue* p_queue = NULL;
+	LONG queuedBytes = 0;
+	//Assert
+	assert(NULL != p_statistics);
+
+	memset(p_statistics, 0, sizeof(sendQueueStatistics));
+	if (FLS_OUT_OF_INDEXES == g_sendQueueFlsIndex) return;
+
+	//The depths are sampled while their queues can't be freed
+	EnterCriticalSection(&g_sendQueuesRegistryLock);
+	for (p_queue = g_p_sendQueuesRegistry; NULL != p_queue; p_queue = p_queue->p_nextQueue) {
+		queuedBytes = p_queue->queuedBytes;
+		p_statistics->numOfQueues++;
+		p_statistics->queuedBytes += queuedBytes;
+		p_statistics->queuedFrames += p_queue->numOfFrames;
+		if (p_statistics->maxQueuedBytes < queuedBytes) p_statistics->maxQueuedBytes = queuedBytes;
+	}
+	LeaveCriticalSection(&g_sendQueuesRegistryLock);
+
+	p_statistics->evictions = g_sendQueueEvictions;
+	p_statistics->parks = g_sendQueueParks;
+	p_statistics->coalescedFrames = g_sendQueueCoalescedFrames;
+}
+
+
+
+
+//......................................Static functions..........................................
+
+static sendQueue* fetchCurrentThreadSendQueue()
+{
+	if (FLS_OUT_OF_INDEXES == g_sendQueueFlsIndex) return NULL;
+
+	return (sendQueue*)FlsGetValue(g_sendQueueFlsIndex);
+}
+
+static VOID WINAPI releaseSendQueueOnThreadExit(PVOID p_flsData)
+{
+	sendQueue* p_queue = (sendQueue*)p_flsData;
+	sendQueue** p_p_link = NULL;
+
+	if (NULL == p_queue) return;
+
+	EnterCriticalSection(&g_sendQueuesRegistryLock);
+	for (p_p_link = &g_p_sendQueuesRegistry; NULL != *p_p_link; p_p_link = &(*p_p_link)->p_nextQueue)
+		if (p_queue == *p_p_link) {
+			*p_p_link = p_queue->p_nextQueue;
+			break;
+		}
+	LeaveCriticalSection(&g_sendQueuesRegistryLock);
+
+	free(p_queue);
+}
+
+static transferResults flushSendQueue(sendQueue* p_queue, LONG maxQueuedBytes, LONG maxQueuedFrames, DWORD timeout)
+{
+	ULONGLONG deadline = GetTickCount64() + timeout, now = 0;
+	u_long nonBlockingMode = 1, blockingMode = 0;
+	int bytesTransferred = 0, lastError = 0, selectResult = 0;
+	fd_set writableSet;
+	struct timeval selectTimeout;
+	//Assert
+	assert(NULL != p_queue);
+
+	while ((maxQueuedBytes < p_queue->queuedBytes) || (maxQueuedFrames < p_queue->numOfFrames)) {
+		//Send without blocking - the socket takes as much as its send buffer has room for. The socket stays blocking for every other operation
+		if (SOCKET_ERROR == ioctlsocket(p_queue->s_socket, FIONBIO, &nonBlockingMode)) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to set the socket to non-blocking mode", WSAGetLastError(), 0);
+			return TRANSFER_FAILED;
+		}
+		bytesTransferred = send(p_queue->s_socket, p_queue->buffer, p_queue->queuedBytes, 0 /* no flags */);
+		lastError = WSAGetLastError();
+		if (SOCKET_ERROR == ioctlsocket(p_queue->s_socket, FIONBIO, &blockingMode)) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to return the socket to blocking mode", WSAGetLastError(), 0);
+			return TRANSFER_FAILED;
+		}
+
+		if (SOCKET_ERROR != bytesTransferred) {
+			removeSentBytes(p_queue, bytesTransferred);
+			continue;
+		}
+		if (WSAEWOULDBLOCK != lastError) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "send() function failed", lastError, 0);
+			return TRANSFER_FAILED;
+		}
+
+		//The socket's send buffer is full (the Client doesn't read) - wait for it to become writable, up to the deadline
+		if (deadline <= (now = GetTickCount64())) return TRANSFER_TIMEOUT;
+		FD_ZERO(&writableSet);
+		FD_SET(p_queue->s_socket, &writableSet);
+		selectTimeout.tv_sec = (long)((deadline - now) / 1000);
+		selectTimeout.tv_usec = (long)(((deadline - now) % 1000) * 1000);
+		if (SOCKET_ERROR == (selectResult = select(0 /*ignored*/, NULL, &writableSet, NULL, &selectTimeout))) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to wait for the socket to become writable", WSAGetLastError(), 0);
+			return TRANSFER_FAILED;
+		}
+		if (0 == selectResult) return TRANSFER_TIMEOUT;
+	}
+
+	return TRANSFER_SUCCEEDED;
+}
+
+static void removeSentBytes(sendQueue* p_queue, int sentBytes)
+{
+	//Assert
+	assert(NULL != p_queue);
+	assert((0 <= sentBytes) && (sentBytes <= p_queue->queuedBytes));
+
+	p_queue->queuedBytes -= sentBytes;
+	p_queue->headFrameSentBytes += sentBytes;
+
+	//Pop the frames that were sent whole
+	while ((0 < p_queue->numOfFrames) && (p_queue->frames[0].frameLength <= p_queue->headFrameSentBytes)) {
+		p_queue->headFrameSentBytes -= p_queue->frames[0].frameLength;
+		p_queue->numOfFrames--;
+		memmove(p_queue->frames, p_queue->frames + 1, p_queue->numOfFrames * sizeof(sendQueueFrame));
+	}
+
+	//Keep the unsent bytes at the start of the buffer
+	memmove(p_queue->buffer, p_queue->buffer + sentBytes, p_queue->queuedBytes);
+}
+
+static void coalesceQueuedResults(sendQueue* p_queue)
+{
+	int frameIndex = 0, keptFrames = 0, frameOffset = 0, frameLength = 0;
+	LONG numOfCoalescedFrames = 0;
+	//Assert
+	assert(NULL != p_queue);
+
+	//A partly sent head frame is kept - the Client already has its beginning
+	if ((0 < p_queue->numOfFrames) && (0 < p_queue->headFrameSentBytes)) {
+		frameOffset = p_queue->frames[0].frameLength - p_queue->headFrameSentBytes;
+		frameIndex = keptFrames = 1;
+	}
+
+	for (; frameIndex < p_queue->numOfFrames; frameIndex++) {
+		frameLength = p_queue->frames[frameIndex].frameLength;
+		if (COALESCABLE_MESSAGE_TYPE == p_queue->frames[frameIndex].messageType) {
+			memmove(p_queue->buffer + frameOffset, p_queue->buffer + frameOffset + frameLength, p_queue->queuedBytes - frameOffset - frameLength);
+			p_queue->queuedBytes -= frameLength;
+			numOfCoalescedFrames++;
+		}
+		else {
+			p_queue->frames[keptFrames++] = p_queue->frames[frameIndex];
+			frameOffset += frameLength;
+		}
+	}
+	p_queue->numOfFrames = keptFrames;
+
+	if (0 < numOfCoalescedFrames) InterlockedExchangeAdd(&g_sendQueueCoalescedFrames, numOfCoalescedFrames);
+}
+
+static transferResults applyHighWatermarkPolicy(sendQueue* p_queue, int frameLength)
+{
+	//Assert
+	assert(NULL != p_queue);
+
+	switch (p_queue->policy) {
+	case SEND_QUEUE_POLICY_PARK:
+		//Block the Worker thread until its Client reads enough, up to SEND_QUEUE_PARK_TIMEOUT_MS
+		InterlockedIncrement(&g_sendQueueParks);
+		switch (flushSendQueue(p_queue, SEND_QUEUE_HIGH_WATERMARK - frameLength, SEND_QUEUE_MAX_FRAMES - 1, SEND_QUEUE_PARK_TIMEOUT_MS)) {
+		case TRANSFER_SUCCEEDED: return TRANSFER_SUCCEEDED;
+		case TRANSFER_TIMEOUT: return evictClient(p_queue, "Evicted - the Client didn't read while its Worker thread was parked");
+		default: return evictClient(p_queue, "Evicted - send(.) failed");
+		}
+
+	case SEND_QUEUE_POLICY_COALESCE:
+		//Older results are superseded by the newer frames - remove them & check again
+		coalesceQueuedResults(p_queue);
+		if ((SEND_QUEUE_HIGH_WATERMARK >= p_queue->queuedBytes + frameLength) && (SEND_QUEUE_MAX_FRAMES > p_queue->numOfFrames)) return TRANSFER_SUCCEEDED;
+		return evictClient(p_queue, "Evicted - the send queue is over its high watermark after coalescing");
+
+	default: //SEND_QUEUE_POLICY_DROP
+		return evictClient(p_queue, "Evicted - the send queue reached its high watermark");
+	}
+}
+
+static transferResults evictClient(sendQueue* p_queue, const char* p_reason)
+{
+	//Assert
+	assert(NULL != p_queue);
+
+	LOG_EVENT(LOG_EVENT_CONNECTION, p_reason, p_queue->queuedBytes, p_queue->policy);
+	InterlockedIncrement(&g_sendQueueEvictions);
+	p_queue->isEvicted = TRUE;
+	p_queue->queuedBytes = 0;
+	p_queue->numOfFrames = 0;
+	p_queue->headFrameSentBytes = 0;
+
+	//The Client notices the disconnection, and the Worker thread's next receive fails at once
+	if (SOCKET_ERROR == shutdown(p_queue->s_socket, SD_BOTH))
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to shutdown an evicted Client's socket", WSAGetLastError(), 0);
+
+	return TRANSFER_FAILED;
+}
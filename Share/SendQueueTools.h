@@ -0,0 +1,86 @@
+/* SendQueueTools.h
+------------------------------------------------------------------
+	Module Description - header module for SendQueueTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __SEND_QUEUE_TOOLS_H__
+#define __SEND_QUEUE_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function prepares the send queues: it allocates a Fiber Local Storage slot that will hold every Worker thread's send queue
+/// (its callback detaches the queue when the thread exits) and initializes the lock of the queues registry. Must be called once, before any thread is created.
+/// Until it is called (e.g. in the Client process) no queue is ever attached, so every send blocks as before
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeSendQueues();
+
+/// <summary>
+/// Description - This function frees ALL the send queues and releases the Fiber Local Storage slot. Must be called once, after all other threads ended.
+/// </summary>
+void destroySendQueues();
+
+/// <summary>
+/// Description - This function binds a bounded send queue for the given connection to the calling thread. From now on, sends of this thread on this socket
+/// go through queueFrameForSending(.). The queue is detached & freed when the thread exits (or by detachSendQueue(.))
+/// </summary>
+/// <param name="SOCKET s_socket - the connection's socket"></param>
+/// <param name="sendQueuePolicies policy - SEND_QUEUE_POLICY_DROP, SEND_QUEUE_POLICY_PARK or SEND_QUEUE_POLICY_COALESCE"></param>
+/// <returns>True if succeeded. False otherwise (the thread keeps sending without a queue)</returns>
+BOOL attachSendQueue(SOCKET s_socket, sendQueuePolicies policy);
+
+/// <summary>
+/// Description - This function unbinds the calling thread's send queue, dropping its unsent frames, and frees it. Does nothing if no queue is attached
+/// </summary>
+void detachSendQueue();
+
+/// <summary>
+/// Description - This function checks whether the calling thread has a send queue attached to the given socket
+/// </summary>
+/// <param name="SOCKET s_socket - the connection's socket"></param>
+/// <returns>True if attached. False otherwise</returns>
+BOOL isSendQueueAttached(SOCKET s_socket);
+
+/// <summary>
+/// Description - This function queues a frame (length prefix & message) on the calling thread's send queue and flushes as much of the queue as the socket
+/// takes without blocking. If the frame doesn't fit below SEND_QUEUE_HIGH_WATERMARK, the queue's policy is applied first: DROP evicts the Client,
+/// PARK blocks until the Client reads enough (up to SEND_QUEUE_PARK_TIMEOUT_MS) & COALESCE removes the unsent SERVER_GAME_RESULTS frames.
+/// If there is still no room, the Client is evicted - its socket is shut down & every following send\drain fails
+/// </summary>
+/// <param name="SOCKET s_socket - the connection's socket (a queue must be attached to it)"></param>
+/// <param name="int messageType - message type serial number"></param>
+/// <param name="const char* p_message - pointer to the message buffer"></param>
+/// <param name="int messageLength - # of bytes of the message, terminating zero included"></param>
+/// <returns>TRANSFER_SUCCEEDED if queued (not necessarily sent yet). TRANSFER_FAILED if the Client was evicted or the socket failed</returns>
+transferResults queueFrameForSending(SOCKET s_socket, int messageType, const char* p_message, int messageLength);
+
+/// <summary>
+/// Description - This function sends all the frames left in the calling thread's send queue, blocking up to the given timeout.
+/// A Client that doesn't read within the timeout is evicted. Does nothing if no queue is attached to the given socket
+/// </summary>
+/// <param name="SOCKET s_socket - the connection's socket"></param>
+/// <param name="DWORD timeout - in milliseconds"></param>
+/// <returns>TRANSFER_SUCCEEDED if the queue is empty. TRANSFER_FAILED if the Client was evicted or the socket failed</returns>
+transferResults drainSendQueue(SOCKET s_socket, DWORD timeout);
+
+/// <summary>
+/// Description - This function sums the depths of all the send queues & reads the policies counters into the given struct
+/// </summary>
+/// <param name="sendQueueStatistics* p_statistics - pointer to the struct that will be filled"></param>
+void fetchSendQueueStatistics(sendQueueStatistics* p_statistics);
+
+
+#endif //__SEND_QUEUE_TOOLS_H__
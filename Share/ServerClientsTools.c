@@ -25,6 +25,10 @@
 
 // Projects includes -----------------------------------------------------------
 #include "ServerClientsTools.h"
+#include "SlabAllocationTools.h"
+#include "EventLoggingTools.h"
+#include "MetricsTools.h"
+#include "SendQueueTools.h"
 
 // Constants
 static const BOOL STATUS_CODE_FAILURE = FALSE;
@@ -69,15 +73,6 @@ static int fetchMessageStringLength(const char* p_stringBuffer);
 
 
 
-/// <summary>
-/// Description - sendString(.) is a wrapper that uses sendBuffer to send a complete buffer. It uses a socket to send a string.
-/// </summary>
-/// <param name="const char* p_messageToBeSent - pointer to the buffer containing the data in bytes to be sent"></param>
-/// <param name="SOCKET s_socket - Socket Handle to send data through"></param>
-/// <returns></returns>
-static transferResults sendString(const char* p_messageToBeSent, SOCKET s_socket);
-
-
 /// <summary>
 /// Description - sendBuffer() uses a socket to send a buffer.
 /// </summary>
@@ -88,15 +83,6 @@ static transferResults sendString(const char* p_messageToBeSent, SOCKET s_socket
 static transferResults sendBuffer(const char* p_buffer, int bytesToSend, SOCKET s_socket);
 
 
-/// <summary>
-/// Description - receiveString(.) is a wrapper that uses receiveBuffer to receive a complete buffer. It uses a socket to send a string.
-/// </summary>
-/// <param name="char** p_p_outputStringPointer - pointer address to that will evantually point at the newly memory allocated & updated buffer containing the data read"></param>
-/// <param name="SOCKET s_socket - Socket Handle to receive data from"></param>
-/// <returns>TRANSFER_SUCCEEDED - if receiving succeeded ; TRANSFER_DISCONNECTED - if the socket was disconnected gracefully ; TRANSFER_TIMEOUT - if recv(.) timeout ; TRANSFER_FAILED - if Server\Client disconnected abruptly</returns>
-static transferResults receiveString(char** p_p_outputStringPointer, SOCKET s_socket);
-
-
 /// <summary>
 ///  Description - receiveBuffer() uses a socket to receive a buffer.
 /// </summary>
@@ -179,7 +165,7 @@ int incrementDecrementCheckNumberOfConnectedClients(USHORT* p_currentNumOfConnec
 	int result = 0;
 	//Input integrity validation
 	if ((NULL == p_currentNumOfConnectedClients) || (NULL == p_h_connectedClientsNumMutex) || (!((-1 <= increDecreVal) && (1 >= increDecreVal))) ) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return STATUS_CODE_FAILURE;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
 	}
 
 	
@@ -198,7 +184,7 @@ int incrementDecrementCheckNumberOfConnectedClients(USHORT* p_currentNumOfConnec
 
 	//Release the ownership over the resource Mutex
 	if (MUTEX_RELEASE_FAILED == ReleaseMutex(*p_h_connectedClientsNumMutex)) {
-		printf("Error: Thread no. %lu failed to release the Number of currently connected Clients Mutex, with code: %d.\nExiting...\n", GetCurrentThreadId(), GetLastError());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to release the Number of currently connected Clients Mutex", GetLastError(), 0);
 		return -1;
 	}
 
@@ -327,8 +313,7 @@ static transferResults sendBuffer(const char* p_buffer, int bytesToSend, SOCKET
 		//Send does not guarantee that the entire message is sent 
 		bytesTransferred = send(s_socket, p_currentPointerPosition, remainingBytesToSend, 0 /* no flags */);
 		if (bytesTransferred == SOCKET_ERROR){
-			printf("Error: send() function failed, with error code no. %ld.\n", WSAGetLastError());
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "send() function failed", WSAGetLastError(), 0);
 			return TRANSFER_FAILED;
 		}
 
@@ -341,13 +326,13 @@ static transferResults sendBuffer(const char* p_buffer, int bytesToSend, SOCKET
 	return TRANSFER_SUCCEEDED;
 }
 
-static transferResults sendString(const char* p_messageToBeSent, SOCKET s_socket)
+transferResults sendString(const char* p_messageToBeSent, SOCKET s_socket)
 {
 	int totalStringSizeInBytes = 0;
 	transferResults sendResult = TRANSFER_FAILED;
 	//Input integrity validation
 	if ((NULL == p_messageToBeSent) || (INVALID_SOCKET == s_socket)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return TRANSFER_FAILED;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return TRANSFER_FAILED;
 	}
 
 	/* Sending protocol is agreed to divide the message into two parts & send every part individually:
@@ -375,20 +360,19 @@ static transferResults sendString(const char* p_messageToBeSent, SOCKET s_socket
 }
 
 //OVERALL - RETURNED VALUES MAY BE: TRANSFER_FAILED, TRANSFER_SUCCEEDED, TRANSFER_PREVENTED -> SERVER_DISCONNECTED, COMMUNICATION_SUCCEEDED, COMMUNICATION_FAILED
-communicationResults sendMessageClientSide(SOCKET* p_s_clientCommunicationSocket, int messageTypeSerialNumber, char* p_paramOne/*, int timeoutForNextResponse*/)
+communicationResults sendMessageClientSide(SOCKET* p_s_clientCommunicationSocket, int messageTypeSerialNumber, char* p_paramOne, char* p_paramTwo/*, int timeoutForNextResponse*/)
 {
 	messageString* p_messageOrResponseToServer = NULL;
 	//int setClientSocketReceiveTimeoutResult = 0, socketReceiveFromServerTimeoutDuration = 0;
 	//Input integrity validation
 	if ((NULL == p_s_clientCommunicationSocket) || (CLIENT_DISCONNECT_NUM < messageTypeSerialNumber) || (SERVER_MAIN_MENU_NUM > messageTypeSerialNumber)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return COMMUNICATION_FAILED; //parameters pointer may be NULL
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return COMMUNICATION_FAILED; //parameters pointer may be NULL
 	}
 
 	//Construct the output message buffer & Send to Server
-	if (NULL != (p_messageOrResponseToServer = constructMessageForSendingClient(messageTypeSerialNumber, p_paramOne))) {
+	if (NULL != (p_messageOrResponseToServer = constructMessageForSendingClient(messageTypeSerialNumber, p_paramOne, p_paramTwo))) {
 		if (TRANSFER_SUCCEEDED != sendString(p_messageOrResponseToServer->p_messageBuffer, *p_s_clientCommunicationSocket)) {
-			printf("Error: Failed to send message whose type is %d from Client to Server.\n", messageTypeSerialNumber); //'CHECK' maybe somehow change to message type string (maybe print outside)
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_MESSAGE_FAILURE, "Failed to send a message from Client to Server", messageTypeSerialNumber, 0);
 			freeTheString(p_messageOrResponseToServer);
 			
 			return (communicationResults)TRANSFER_FAILED; 
@@ -433,16 +417,28 @@ communicationResults sendMessageServerSide(SOCKET* p_s_serverCommunicationSocket
 	char* p_paramOne, char* p_paramTwo, char* p_paramThree, char* p_paramFour/*, int timeoutForNextResponse*/)
 {
 	messageString* p_messageOrResponseToClient = NULL;
+	transferResults sendResult = TRANSFER_FAILED;
+	LONGLONG sendStartTicks = 0;
+	DWORD bytesSent = 0;
 	//int setServerWorkerSocketReceiveTimeoutResult = 0, socketReceiveFromClientTimeoutDuration = 0;
 	//Input integrity validation
 	if ((NULL == p_s_serverCommunicationSocket) || (CLIENT_DISCONNECT_NUM < messageTypeSerialNumber) || (SERVER_MAIN_MENU_NUM > messageTypeSerialNumber)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return COMMUNICATION_FAILED; //parameters pointer may be NULL
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return COMMUNICATION_FAILED; //parameters pointer may be NULL
 	}
 
+	//Metrics - the send duration includes the message construction
+	sendStartTicks = readMetricsClock();
+
 	//Construct the output message buffer & Send to Client
 	if (NULL != (p_messageOrResponseToClient = constructMessageForSendingServer(messageTypeSerialNumber, p_paramOne, p_paramTwo, p_paramThree, p_paramFour))) {
-		if (TRANSFER_SUCCEEDED != sendString(p_messageOrResponseToClient->p_messageBuffer, *p_s_serverCommunicationSocket)) {
-			printf("Error: Failed to send message whose type is %d from Client to Server.\n", messageTypeSerialNumber); //'CHECK' maybe somehow change to message type string (maybe print outside)
+		//A Worker thread's connection has a bounded send queue - the message is queued & flushed without blocking (a slow Client is evicted)
+		if (TRUE == isSendQueueAttached(*p_s_serverCommunicationSocket))
+			sendResult = queueFrameForSending(*p_s_serverCommunicationSocket, messageTypeSerialNumber, p_messageOrResponseToClient->p_messageBuffer,
+				fetchMessageStringLength(p_messageOrResponseToClient->p_messageBuffer) + 1); // terminating zero also sent
+		else
+			sendResult = sendString(p_messageOrResponseToClient->p_messageBuffer, *p_s_serverCommunicationSocket);
+		if (TRANSFER_SUCCEEDED != sendResult) {
+			LOG_EVENT(LOG_EVENT_MESSAGE_FAILURE, "Failed to send a message from Server to Client", messageTypeSerialNumber, 0);
 			freeTheString(p_messageOrResponseToClient);
 			
 			return (communicationResults)TRANSFER_FAILED;
@@ -476,6 +472,10 @@ communicationResults sendMessageServerSide(SOCKET* p_s_serverCommunicationSocket
 	}*/
 
 
+	//Metrics - count the message & its bytes as sent by sendString(.) (length prefix, message & terminating zero)
+	bytesSent = (DWORD)(sizeof(int) + fetchMessageStringLength(p_messageOrResponseToClient->p_messageBuffer) + 1);
+	recordMessageSent(messageTypeSerialNumber, bytesSent, sendStartTicks);
+
 	//Free the buffer struct used to send the message to the Server
 	freeTheString(p_messageOrResponseToClient);
 	//Sending was successful.....
@@ -500,12 +500,11 @@ static transferResults receiveBuffer(char* p_outputBuffer, int bytesToReceive, S
 		if (bytesJustTransferred == SOCKET_ERROR) {  
 			//SOCKET_ERROR may indicate the 'receive' function has reached its predetermined timeout..
 			if (WSAGetLastError() == WSAETIMEDOUT) {
-				printf("recv(.) function's running time duration reached its timeout. Exiting\n");
-				return TRANSFER_TIMEOUT; //'CHECK' add printf for every message that cause timeout
+				LOG_EVENT(LOG_EVENT_TIMEOUT, "recv(.) function's running time duration", 0, 0);
+				return TRANSFER_TIMEOUT;
 			}
 			//else, the 'receive' function failed completely...
-			printf("Error: recv() failed, with error code %ld.\n", WSAGetLastError());
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "recv() failed", WSAGetLastError(), 0);
 			return TRANSFER_FAILED;
 		}
 		//The communicating Server & Client disconnected "Gracefuly"
@@ -521,14 +520,14 @@ static transferResults receiveBuffer(char* p_outputBuffer, int bytesToReceive, S
 	return TRANSFER_SUCCEEDED;
 }
 
-static transferResults receiveString(char** p_p_outputStringPointer, SOCKET s_socket)
+transferResults receiveString(char** p_p_outputStringPointer, SOCKET s_socket)
 {
 	int totalStringSizeInBytes = 0;
 	transferResults receiveResult = TRANSFER_FAILED;
 	char* p_messageBuffer = NULL;
 	//Input integrity validation
 	if ((NULL == p_p_outputStringPointer) || (*p_p_outputStringPointer != NULL) || (INVALID_SOCKET == s_socket)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return TRANSFER_FAILED;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return TRANSFER_FAILED;
 	}
 
 	/*
@@ -554,10 +553,9 @@ static transferResults receiveString(char** p_p_outputStringPointer, SOCKET s_so
 	if (receiveResult != TRANSFER_SUCCEEDED) return receiveResult;			
 
 
-	//Allocate dynamic memory for the incoming message
-	if (NULL == (p_messageBuffer = (char*)malloc(totalStringSizeInBytes * sizeof(char)))) {
-		printf("Error: Failed to allocate memory for the received message string.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//Allocate memory for the incoming message (short messages come from the thread's slab)
+	if (NULL == (p_messageBuffer = allocateSlabBuffer(totalStringSizeInBytes * sizeof(char)))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "the received message string", 0, 0);
 		return TRANSFER_FAILED;
 	}
 	
@@ -569,7 +567,7 @@ static transferResults receiveString(char** p_p_outputStringPointer, SOCKET s_so
 
 	if (receiveResult == TRANSFER_SUCCEEDED) *p_p_outputStringPointer = p_messageBuffer;
 	else 
-		free(p_messageBuffer);
+		freeSlabObject(p_messageBuffer);
 
 	//If the transfer was successful then p_p_outputStringPointer points at the message's pointer's address & receiveResult is set to TRANSFER_SUCCEEDED
 	// else the allocated memory for the message's buffer was freed & receiveResult is set to TRANSFER_FAILED
@@ -580,15 +578,18 @@ transferResults receiveMessage(SOCKET* p_s_communicationSocket, message** p_p_re
 {
 	int receiveResult = 0, setClientSocketReceiveTimeoutResult = 0, socketReceiveFromServerTimeoutDuration = 0;// , selectRes = 0;
 	char* p_receivedMessageBuffer = NULL;
+	LONGLONG parseStartTicks = 0;
+	DWORD bytesReceived = 0;
 	//fd_set set;
 	//struct timeval timeout;
 
 	//Input integrity validation
 	if ((NULL == p_s_communicationSocket) || (NULL == p_p_receivedMessageInfo)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return TRANSFER_FAILED; //parameters pointer may be NULL
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return TRANSFER_FAILED; //parameters pointer may be NULL
 	}
 
-
+	//A Client answers only what it has read - send everything still queued first (a Client that doesn't read in time is evicted)
+	if (TRANSFER_SUCCEEDED != drainSendQueue(*p_s_communicationSocket, SEND_QUEUE_DRAIN_TIMEOUT_MS)) return TRANSFER_FAILED;
 
 
 	//Implement the receive timeout altering duration!
@@ -612,8 +613,7 @@ transferResults receiveMessage(SOCKET* p_s_communicationSocket, message** p_p_re
 
 		//Validate setsockopt(.) operation result
 		if (SOCKET_ERROR == setClientSocketReceiveTimeoutResult) {
-			printf("Error: Failed to alter the socket's 'receive' timeout duration, with error code no. %d.\n", WSAGetLastError());
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to alter the socket's 'receive' timeout duration", WSAGetLastError(), 0);
 			return TRANSFER_FAILED;
 		}
 	}
@@ -644,7 +644,7 @@ transferResults receiveMessage(SOCKET* p_s_communicationSocket, message** p_p_re
 		//This is also the case where Client-side socket stops receiving due to self timeout
 		//NOTE: the sentence above in fact shows the true nature of COMMUNICATION_DISCONNECT which was supposed to be the same as TRANSFER_DISCONNECT,
 		//		but the latter means that the current side, the executes this function, disconnected Gracefully, thus, COMMUNICATION_DISCONNECT isn't noticed 'CHECK'
-		printf("One of the sides either disconnected VIOLENTLY   or   some other failure occured at recv(.)\n");
+		LOG_EVENT(LOG_EVENT_CONNECTION, "One of the sides either disconnected VIOLENTLY or some other failure occured at recv(.)", receiveResult, 0);
 		return TRANSFER_FAILED; break;
 	
 	case TRANSFER_DISCONNECTED:
@@ -656,6 +656,9 @@ transferResults receiveMessage(SOCKET* p_s_communicationSocket, message** p_p_re
 		return TRANSFER_TIMEOUT; break;
 
 	case TRANSFER_SUCCEEDED:
+		//Metrics - the received bytes (length prefix, message & terminating zero) & the translation duration
+		bytesReceived = (DWORD)(sizeof(int) + fetchMessageStringLength(p_receivedMessageBuffer) + 1);
+		parseStartTicks = readMetricsClock();
 		//Translate (Analyze) the received message into a "message" struct that is divided to the message type & parameters..
 		*p_p_receivedMessageInfo = translateReceivedMessageToMessageStruct(p_receivedMessageBuffer);
 		//Validate translation result
@@ -663,33 +666,99 @@ transferResults receiveMessage(SOCKET* p_s_communicationSocket, message** p_p_re
 			//translateReceivedMessageToMessageStruct(.) failed...
 			return TRANSFER_FAILED;
 		}
+		recordMessageReceived((*p_p_receivedMessageInfo)->messageType, bytesReceived, parseStartTicks);
 		return TRANSFER_SUCCEEDED;
 
 	default: /*ignored*/
-		printf("Default: not supposed to reach here.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		LOG_EVENT(LOG_EVENT_UNEXPECTED, "Default: not supposed to reach here", receiveResult, 0);
 		return TRANSFER_FAILED; break;
 	}
 
 }
 
+transferResults receiveMessageOrAbortOnEvent(SOCKET* p_s_communicationSocket, message** p_p_receivedMessageInfo, int responseReceiveTimeoutValue, HANDLE* p_h_abortEvent)
+{
+	//Input integrity validation
+	if (NULL == p_h_abortEvent) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return TRANSFER_FAILED;
+	}
+	//A single abort Event
+	return receiveMessageOrAbortOnEvents(p_s_communicationSocket, p_p_receivedMessageInfo, responseReceiveTimeoutValue, p_h_abortEvent, SINGLE_OBJECT, NULL);
+}
+
+transferResults receiveMessageOrAbortOnEvents(SOCKET* p_s_communicationSocket, message** p_p_receivedMessageInfo, int responseReceiveTimeoutValue,
+	HANDLE* p_h_abortEvents, int numOfAbortEvents, int* p_abortingEventIndex)
+{
+	WSAEVENT h_socketEvent = WSA_INVALID_EVENT;
+	HANDLE p_h_awaitedObjects[MAXIMUM_WAIT_OBJECTS];
+	u_long blockingMode = 0;
+	DWORD waitCode = 0;
+	int e = 0;
+	//Input integrity validation
+	if ((NULL == p_s_communicationSocket) || (NULL == p_p_receivedMessageInfo) || (0 > numOfAbortEvents) || (MAXIMUM_WAIT_OBJECTS <= numOfAbortEvents) ||
+		((0 < numOfAbortEvents) && (NULL == p_h_abortEvents))) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return TRANSFER_FAILED;
+	}
+
+	//Send everything still queued before waiting - the socket can't be switched back to blocking mode while it's associated with an Event
+	if (TRANSFER_SUCCEEDED != drainSendQueue(*p_s_communicationSocket, SEND_QUEUE_DRAIN_TIMEOUT_MS)) return TRANSFER_FAILED;
+
+	//Create an Event object that will be signaled by Winsock when the socket becomes readable (data arrived or peer closed)
+	if (WSA_INVALID_EVENT == (h_socketEvent = WSACreateEvent())) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to create a socket Event", WSAGetLastError(), 0);
+		return TRANSFER_FAILED;
+	}
+	//Associate the Event with the socket's 'read' & 'close' network events. If data is already pending the Event is signaled immediately
+	if (SOCKET_ERROR == WSAEventSelect(*p_s_communicationSocket, h_socketEvent, FD_READ | FD_CLOSE)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to associate the socket with its Event", WSAGetLastError(), 0);
+		WSACloseEvent(h_socketEvent);
+		return TRANSFER_FAILED;
+	}
+
+	//Block until the socket is readable, one of the abort Events is signaled, or timeout (the socket comes first - a message that already arrived is received)
+	p_h_awaitedObjects[0] = h_socketEvent;
+	for (e = 0; e < numOfAbortEvents; e++) p_h_awaitedObjects[1 + e] = p_h_abortEvents[e];
+	waitCode = WaitForMultipleObjects(1 + numOfAbortEvents, p_h_awaitedObjects, FALSE/*wait for any*/, (KEEP_RECEIVE_TIMEOUT == responseReceiveTimeoutValue) ? INFINITE : responseReceiveTimeoutValue);
+
+	//Cancel the association & return the socket to blocking mode (WSAEventSelect(.) sets it to non-blocking) before any recv(.)
+	WSAEventSelect(*p_s_communicationSocket, NULL, 0);
+	WSACloseEvent(h_socketEvent);
+	if (SOCKET_ERROR == ioctlsocket(*p_s_communicationSocket, FIONBIO, &blockingMode)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to return the socket to blocking mode", WSAGetLastError(), 0);
+		return TRANSFER_FAILED;
+	}
+
+	//An abort Event was signaled while waiting - nothing was read from the socket
+	if ((WAIT_OBJECT_0 + 1 <= waitCode) && (WAIT_OBJECT_0 + (DWORD)numOfAbortEvents >= waitCode)) {
+		if (NULL != p_abortingEventIndex) *p_abortingEventIndex = (int)(waitCode - (WAIT_OBJECT_0 + 1));
+		return TRANSFER_ABORTED;
+	}
+
+	switch (waitCode) {
+	case WAIT_OBJECT_0:
+		//Socket is readable - the message (or the disconnection) is already here, so receive it as usual
+		return receiveMessage(p_s_communicationSocket, p_p_receivedMessageInfo, responseReceiveTimeoutValue);
+
+	case WAIT_TIMEOUT:
+		LOG_EVENT(LOG_EVENT_TIMEOUT, "Waiting for a message", 0, 0);
+		return TRANSFER_TIMEOUT;
+
+	default:
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait on the socket & abort events using WaitForMultipleObjects(.)", GetLastError(), 0);
+		return TRANSFER_FAILED;
+	}
+}
+
 
 static int fetchMessageStringLength(const char* p_stringBuffer)
 {
-	int currentLength = 0;
-	const char* p_currentPointerPosition = p_stringBuffer;
 	//Assert
 	assert(NULL != p_stringBuffer);
 
 	//Since the Buffer containing the message's bytes (and is described as a string of characters) MUST
 	// end with a 'LineFeed' character - '\n', AND may contain zero characters '\0', then NO STRING FUNCTIONS
-	// may be used!!!   so the length of the message, either for sending or receiving will be calculated manually!!!
-	while ('\n' != *(p_stringBuffer + currentLength))
-		currentLength++;
-	
-	//When p_stringBuffer in currentLength position is the Line Feed character, then the end of the message was reached 
-	// and currentLength has become the TRUE length of the message in the buffer!
-	return currentLength;
+	// may be used!!!   so the length of the message is the position of the Line Feed character, scanned for manually (16 bytes at a time)
+	return findFirstOfCharacters(p_stringBuffer, 0, '\n', '\n', '\n', '\n');
 }
 
 
@@ -703,11 +772,13 @@ communicationResults gracefulDisconnect(SOCKET* p_s_socket)
 	//Assert
 	assert(NULL != p_s_socket);
 
+	//Send everything still queued, so the other side reads the last messages before the shutdown (an evicted Client's socket is already shut down)
+	drainSendQueue(*p_s_socket, GRACEFUL_DISCONNECT_WAITING_TIMEOUT);
+
 	//Attempt shutting down the (Client\Server Worker) communication socket for sending operations, 
 	// so the (Server Worker\Client) thread socket will receive '0' as a message and will close itself.....
 	if (SOCKET_ERROR == shutdown(*p_s_socket, SD_SEND)) {
-		printf("Error: Failed to shutdown the socket for sending operation for a 'Graceful Disconnection' procedure, with error code no. %d\nGraceful Disconnect failed!\n", WSAGetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to shutdown the socket for sending operation - Graceful Disconnect failed", WSAGetLastError(), 0);
 		return COMMUNICATION_FAILED;
 	}
 
@@ -721,19 +792,18 @@ communicationResults gracefulDisconnect(SOCKET* p_s_socket)
 
 	//Validate setsockopt(.) operation result
 	if (SOCKET_ERROR == setSocketReceiveTimeoutResultForClosure) {
-		printf("Error: Failed to alter the socket's 'receive' timeout duration, with error code no. %d.\nGraceful Disconnect failed!\n", WSAGetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to alter the socket's 'receive' timeout duration - Graceful Disconnect failed", WSAGetLastError(), 0);
 		return COMMUNICATION_FAILED;
 	}
 
 	//Block the Client thread to receive the Server Worker's thread shutdown validation
 	if (TRANSFER_DISCONNECTED == receiveString(&p_blankBuffer, *p_s_socket)) {
 		//Graceful disconnect was noticed by the Server
-		printf("Graceful Disconnect succeeded!\n");
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Graceful Disconnect succeeded", GRACEFUL_DISCONNECT, 0);
 		return GRACEFUL_DISCONNECT;
 	}
 	else {
-		printf("Graceful Disconnect failed!\n");
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Graceful Disconnect failed", SERVER_DISCONNECTED, 0);
 		return SERVER_DISCONNECTED;
 	}
 }
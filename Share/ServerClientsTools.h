@@ -83,8 +83,9 @@ int incrementDecrementCheckNumberOfConnectedClients(USHORT* p_currentNumOfConnec
 /// <param name="SOCKET* p_s_clientCommunicationSocket - communication socket"></param>
 /// <param name="int messageTypeSerialNumber - message type value as determined in HardCodedData.h"></param>
 /// <param name="char* p_paramOne - pointer to buffer of a single paramter if exists (Clients' messages may have up to a single parameter only)"></param>
+/// <param name="char* p_paramTwo - pointer to buffer of a second paramter - CLIENT_REQUEST's session token, if the Client reconnects (NULL otherwise)"></param>
 /// <returns>'communicationResults' enum value which may be COMMUNICATION_SUCCEEDED(if sending succeeded) ; COMMUNICATION_FAILED(if fatal error occured e.g. mem alloc.) ; SERVER_DISCONNECT(if send(.) failed which was probably cause by disconnection from server)</returns>
-communicationResults sendMessageClientSide(SOCKET* p_s_clientCommunicationSocket, int messageTypeSerialNumber, char* p_paramOne);
+communicationResults sendMessageClientSide(SOCKET* p_s_clientCommunicationSocket, int messageTypeSerialNumber, char* p_paramOne, char* p_paramTwo);
 
 /// <summary>
 /// Description - A wrapper that can send any chosen message directed to a Client from the Server  through a given socket, after assembling the message
@@ -109,6 +110,49 @@ communicationResults sendMessageServerSide(SOCKET* p_s_serverCommunicationSocket
 /// <returns>'communicationResults' enum value which may be COMMUNICATION_SUCCEEDED(if receive succeeded) ; COMMUNICATION_FAILED(if fatal error occured e.g. mem alloc.) ; SERVER_DISCONNECT(if recv(.) failed which was probably caused by disconnection from server) ; COMMUNICATION_TIMEOUT(if recv(.) timedout)</returns>
 transferResults receiveMessage(SOCKET* p_s_clientCommunicatonSocket, message** p_p_receivedMessageInfo, int responseReceiveTimeoutValue);
 
+/// <summary>
+///  Description - The same as receiveMessage(.), but before blocking on recv(.) the function waits on BOTH the socket (using WSAEventSelect(.)) and
+/// a given Event. If the Event is signaled first, the function leaves immediately without reading from the socket. This allows a Worker thread that
+/// awaits a human's response for a long time to be woken up by another thread (e.g. when the opponent quits the game)
+/// </summary>
+/// <param name="SOCKET* p_s_communicationSocket - pointer to a communication Socket"></param>
+/// <param name="message** p_p_receivedMessageInfo - pointer address of 'message' struct that will be allocated memory to, if operation succeeded"></param>
+/// <param name="int responseReceiveTimeoutValue - timeout duration value of the wait & of recv(.)"></param>
+/// <param name="HANDLE* p_h_abortEvent - pointer to the Handle of the Event that aborts the wait"></param>
+/// <returns>the same codes as receiveMessage(.), or TRANSFER_ABORTED if the abort Event was signaled before a message arrived</returns>
+transferResults receiveMessageOrAbortOnEvent(SOCKET* p_s_communicationSocket, message** p_p_receivedMessageInfo, int responseReceiveTimeoutValue, HANDLE* p_h_abortEvent);
+
+/// <summary>
+///  Description - The same as receiveMessageOrAbortOnEvent(.), with several abort Events (or none). If an abort Event is signaled first, the index of
+/// the Event that aborted the wait is returned, so a caller may tell e.g. the opponent's quit from a hot restart request
+/// </summary>
+/// <param name="SOCKET* p_s_communicationSocket - pointer to a communication Socket"></param>
+/// <param name="message** p_p_receivedMessageInfo - pointer address of 'message' struct that will be allocated memory to, if operation succeeded"></param>
+/// <param name="int responseReceiveTimeoutValue - timeout duration value of the wait & of recv(.)"></param>
+/// <param name="HANDLE* p_h_abortEvents - array of the Handles of the Events that abort the wait"></param>
+/// <param name="int numOfAbortEvents - # of abort Events (less than MAXIMUM_WAIT_OBJECTS)"></param>
+/// <param name="int* p_abortingEventIndex - output: index of the Event that aborted the wait (may be NULL)"></param>
+/// <returns>the same codes as receiveMessage(.), or TRANSFER_ABORTED if an abort Event was signaled before a message arrived</returns>
+transferResults receiveMessageOrAbortOnEvents(SOCKET* p_s_communicationSocket, message** p_p_receivedMessageInfo, int responseReceiveTimeoutValue,
+	HANDLE* p_h_abortEvents, int numOfAbortEvents, int* p_abortingEventIndex);
+
+/// <summary>
+/// Description - sendString(.) is a wrapper that uses sendBuffer to send a complete buffer. It uses a socket to send a string.
+/// </summary>
+/// <param name="const char* p_messageToBeSent - pointer to the buffer containing the data in bytes to be sent"></param>
+/// <param name="SOCKET s_socket - Socket Handle to send data through"></param>
+/// <returns>TRANSFER_SUCCEEDED - if sending succeeded ; TRANSFER_FAILED - otherwise</returns>
+transferResults sendString(const char* p_messageToBeSent, SOCKET s_socket);
+
+/// <summary>
+/// Description - receiveString(.) is a wrapper that uses receiveBuffer to receive a complete buffer. It uses a socket to send a string.
+/// The received buffer is freed with freeSlabObject(.)
+/// </summary>
+/// <param name="char** p_p_outputStringPointer - pointer address to that will evantually point at the newly memory allocated & updated buffer containing the data read"></param>
+/// <param name="SOCKET s_socket - Socket Handle to receive data from"></param>
+/// <returns>TRANSFER_SUCCEEDED - if receiving succeeded ; TRANSFER_DISCONNECTED - if the socket was disconnected gracefully ; TRANSFER_TIMEOUT - if recv(.) timeout ; TRANSFER_FAILED - if Server\Client disconnected abruptly</returns>
+transferResults receiveString(char** p_p_outputStringPointer, SOCKET s_socket);
+
 
 /// <summary>
 /// Description - This function performs the 'Graceful Disconnect' procedure by using shutdown and using recv(.) to receive byte-read value of 0.
@@ -0,0 +1,336 @@
+/* SlabAllocationTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains a per-thread slab allocator for the
+		small fixed-size objects of the messages path - 'message', 'parameter' and
+		'messageString' structs, and short strings (up to SLAB_SMALL_BUFFER_SIZE).
+		Every thread owns a slab cache with a free list per object type, so
+		allocating & freeing is a pointer pop\push without any lock & without
+		touching the process Heap. Objects freed by another thread are pushed to
+		the owner's remote free list (lock-free), and the owner takes them back
+		when its own free list runs empty.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "SlabAllocationTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int SINGLE_OBJECT = 1;
+
+//Object size of every slab object type (ordered as 'slabObjectTypes')
+static const size_t SLAB_OBJECT_SIZES[NUM_OF_SLAB_OBJECT_TYPES] = { sizeof(message), sizeof(parameter), sizeof(messageString), SLAB_SMALL_BUFFER_SIZE };
+
+// Global variables ------------------------------------------------------------
+//Fiber Local Storage slot holding the calling thread's slab cache
+static DWORD g_slabCacheFlsIndex = FLS_OUT_OF_INDEXES;
+//Registry of all slab caches (touched only when a thread gets its cache, when a thread exits, & by statistics) and its lock
+static CRITICAL_SECTION g_slabCachesRegistryLock;
+static slabThreadCache* g_p_slabCachesRegistry = NULL;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function fetches the calling thread's slab cache. On the thread's first call, it adopts an orphaned cache (whose thread exited)
+/// or allocates a new one, and registers it
+/// </summary>
+/// <returns>pointer to the calling thread's slab cache, or NULL if failed</returns>
+static slabThreadCache* fetchCurrentThreadSlabCache();
+
+/// <summary>
+/// Description - Fiber Local Storage callback, called when a thread exits (or when the slot is freed). It orphans the thread's slab cache,
+/// so the next new thread adopts it together with all its free blocks
+/// </summary>
+/// <param name="PVOID p_flsData - the exiting thread's slab cache"></param>
+static VOID WINAPI orphanSlabCacheOnThreadExit(PVOID p_flsData);
+
+/// <summary>
+/// Description - This function allocates a chunk of SLAB_BLOCKS_PER_CHUNK blocks of the given type from the Heap and pushes them all to the cache's free list
+/// </summary>
+/// <param name="slabThreadCache* p_cache - the calling thread's slab cache"></param>
+/// <param name="slabObjectTypes objectType - type of the blocks"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL carveNewChunkIntoFreeList(slabThreadCache* p_cache, slabObjectTypes objectType);
+
+/// <summary>
+/// Description - This function calculates the size of a single block of the given type - header & object, rounded up to pointer alignment
+/// </summary>
+/// <param name="slabObjectTypes objectType - type of the block"></param>
+/// <returns>block size in bytes</returns>
+static size_t calculateSlabBlockSize(slabObjectTypes objectType);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeSlabAllocator()
+{
+	//Allocate the Fiber Local Storage slot. Unlike a TLS slot, its callback is called on thread exit
+	if (FLS_OUT_OF_INDEXES == (g_slabCacheFlsIndex = FlsAlloc(orphanSlabCacheOnThreadExit))) {
+		printf("Error: Failed to allocate a Fiber Local Storage slot for the slab caches, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		return STATUS_CODE_FAILURE;
+	}
+
+	InitializeCriticalSection(&g_slabCachesRegistryLock);
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroySlabAllocator()
+{
+	slabThreadCache* p_cache = NULL;
+	slabChunk* p_chunk = NULL;
+
+	if (FLS_OUT_OF_INDEXES == g_slabCacheFlsIndex) return; //Never initialized
+
+	//Freeing the slot calls the callback for the calling thread's cache as well
+	FlsFree(g_slabCacheFlsIndex);
+	g_slabCacheFlsIndex = FLS_OUT_OF_INDEXES;
+
+	//Free every cache & all its chunks
+	while (NULL != g_p_slabCachesRegistry) {
+		p_cache = g_p_slabCachesRegistry;
+		g_p_slabCachesRegistry = p_cache->p_nextCache;
+		while (NULL != p_cache->p_chunks) {
+			p_chunk = p_cache->p_chunks;
+			p_cache->p_chunks = p_chunk->p_nextChunk;
+			free(p_chunk);
+		}
+		_aligned_free(p_cache);
+	}
+
+	DeleteCriticalSection(&g_slabCachesRegistryLock);
+}
+
+void* allocateSlabObject(slabObjectTypes objectType)
+{
+	slabThreadCache* p_cache = NULL;
+	slabBlockHeader* p_block = NULL;
+	//Input integrity validation
+	if ((SLAB_MESSAGE > objectType) || (NUM_OF_SLAB_OBJECT_TYPES <= objectType)) {
+		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+	}
+
+	if (NULL == (p_cache = fetchCurrentThreadSlabCache())) return NULL;
+
+	if (NULL == p_cache->p_freeLists[objectType]) {
+		//The free list is empty - take back ALL the blocks other threads returned, with a single exchange
+		p_cache->p_freeLists[objectType] = (slabBlockHeader*)InterlockedExchangePointer((PVOID volatile*)&p_cache->p_remoteFreeLists[objectType], NULL);
+		//Still empty - grow the slab by a chunk
+		if ((NULL == p_cache->p_freeLists[objectType]) && (STATUS_CODE_FAILURE == carveNewChunkIntoFreeList(p_cache, objectType))) return NULL;
+	}
+
+	//O(1) - pop the head of the free list
+	p_block = p_cache->p_freeLists[objectType];
+	p_cache->p_freeLists[objectType] = p_block->p_nextFreeBlock;
+	p_block->p_nextFreeBlock = NULL;
+	p_cache->statistics.allocations[objectType]++;
+
+	//Objects are handed out zeroed, exactly as calloc(.) did
+	memset(p_block + 1, 0, SLAB_OBJECT_SIZES[objectType]);
+	return (void*)(p_block + 1);
+}
+
+char* allocateSlabBuffer(int bufferSize)
+{
+	slabThreadCache* p_cache = NULL;
+	slabBlockHeader* p_block = NULL;
+	//Input integrity validation
+	if (0 > bufferSize) {
+		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+	}
+
+	//Short buffer - slab object
+	if (SLAB_SMALL_BUFFER_SIZE >= bufferSize) return (char*)allocateSlabObject(SLAB_SMALL_BUFFER);
+
+	//Long buffer - Heap, with a header that has no owner cache
+	if (NULL == (p_block = (slabBlockHeader*)calloc(sizeof(slabBlockHeader) + bufferSize, SINGLE_OBJECT))) {
+		printf("Error: Failed to allocate dynamic memory (Heap) for a buffer.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		return NULL;
+	}
+	p_block->objectType = SLAB_SMALL_BUFFER;
+	if (NULL != (p_cache = fetchCurrentThreadSlabCache())) p_cache->statistics.heapBufferAllocations++;
+
+	return (char*)(p_block + 1);
+}
+
+void freeSlabObject(void* p_object)
+{
+	slabBlockHeader* p_block = NULL, * p_remoteHead = NULL;
+	slabThreadCache* p_ownerCache = NULL;
+
+	if (NULL == p_object) return;
+
+	p_block = ((slabBlockHeader*)p_object) - 1;
+	p_ownerCache = p_block->p_ownerCache;
+
+	//Long buffer - back to the Heap
+	if (NULL == p_ownerCache) {
+		free(p_block);
+		return;
+	}
+
+	//O(1) - the owner thread pushes the block to its own free list
+	if (p_ownerCache == (slabThreadCache*)FlsGetValue(g_slabCacheFlsIndex)) {
+		p_block->p_nextFreeBlock = p_ownerCache->p_freeLists[p_block->objectType];
+		p_ownerCache->p_freeLists[p_block->objectType] = p_block;
+		p_ownerCache->statistics.localFrees[p_block->objectType]++;
+		return;
+	}
+
+	//Cross-thread return - lock-free push to the owner's remote free list. Only the owner empties the list (in a single exchange), so there is no ABA
+	do {
+		p_remoteHead = p_ownerCache->p_remoteFreeLists[p_block->objectType];
+		p_block->p_nextFreeBlock = p_remoteHead;
+	} while (p_remoteHead != InterlockedCompareExchangePointer((PVOID volatile*)&p_ownerCache->p_remoteFreeLists[p_block->objectType], p_block, p_remoteHead));
+	InterlockedIncrement(&p_ownerCache->remoteFrees[p_block->objectType]);
+}
+
+void fetchSlabAllocatorStatistics(slabStatistics* p_statistics)
+{
+	slabThreadCache* p_cache = NULL;
+	int type = 0;
+	//Input integrity validation
+	if (NULL == p_statistics) {
+		printf("Error: Bad inputs to function: %s\n", __func__); return;
+	}
+
+	memset(p_statistics, 0, sizeof(slabStatistics));
+	if (FLS_OUT_OF_INDEXES == g_slabCacheFlsIndex) return; //Never initialized
+
+	//The counters of other threads' caches are sampled without stopping them - the totals are approximate while threads run
+	EnterCriticalSection(&g_slabCachesRegistryLock);
+	for (p_cache = g_p_slabCachesRegistry; NULL != p_cache; p_cache = p_cache->p_nextCache) {
+		for (type = 0; type < NUM_OF_SLAB_OBJECT_TYPES; type++) {
+			p_statistics->allocations[type] += p_cache->statistics.allocations[type];
+			p_statistics->localFrees[type] += p_cache->statistics.localFrees[type];
+			p_statistics->remoteFrees[type] += p_cache->remoteFrees[type];
+			p_statistics->chunksAllocated[type] += p_cache->statistics.chunksAllocated[type];
+		}
+		p_statistics->heapBufferAllocations += p_cache->statistics.heapBufferAllocations;
+		p_statistics->numOfThreadCaches++;
+	}
+	LeaveCriticalSection(&g_slabCachesRegistryLock);
+}
+
+
+
+
+//......................................Static functions..........................................
+
+static slabThreadCache* fetchCurrentThreadSlabCache()
+{
+	slabThreadCache* p_cache = NULL;
+
+	if (FLS_OUT_OF_INDEXES == g_slabCacheFlsIndex) {
+		printf("Error: The slab allocator was not initialized.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		return NULL;
+	}
+
+	//Fast path - the thread already has a cache
+	if (NULL != (p_cache = (slabThreadCache*)FlsGetValue(g_slabCacheFlsIndex))) return p_cache;
+
+	EnterCriticalSection(&g_slabCachesRegistryLock);
+	//Adopt an orphaned cache if exists (its free blocks are reused as is)
+	for (p_cache = g_p_slabCachesRegistry; NULL != p_cache; p_cache = p_cache->p_nextCache)
+		if (0 == p_cache->ownerThreadId) break;
+
+	//Otherwise, allocate a new cache & register it
+	if (NULL == p_cache) {
+		//Cache line aligned, so the cross-thread section of one cache never shares a line with another cache's owner section
+		if (NULL == (p_cache = (slabThreadCache*)_aligned_malloc(sizeof(slabThreadCache), CACHE_LINE_SIZE))) {
+			LeaveCriticalSection(&g_slabCachesRegistryLock);
+			printf("Error: Failed to allocate memory for a slabThreadCache struct.\n");
+			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			return NULL;
+		}
+		memset(p_cache, 0, sizeof(slabThreadCache));
+		p_cache->p_nextCache = g_p_slabCachesRegistry;
+		g_p_slabCachesRegistry = p_cache;
+	}
+	p_cache->ownerThreadId = GetCurrentThreadId();
+	LeaveCriticalSection(&g_slabCachesRegistryLock);
+
+	if (FALSE == FlsSetValue(g_slabCacheFlsIndex, p_cache)) {
+		printf("Error: Failed to store the slab cache in the Fiber Local Storage slot, with error code no. %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		orphanSlabCacheOnThreadExit(p_cache);
+		return NULL;
+	}
+
+	return p_cache;
+}
+
+static VOID WINAPI orphanSlabCacheOnThreadExit(PVOID p_flsData)
+{
+	slabThreadCache* p_cache = (slabThreadCache*)p_flsData;
+
+	if (NULL == p_cache) return;
+
+	EnterCriticalSection(&g_slabCachesRegistryLock);
+	p_cache->ownerThreadId = 0;
+	LeaveCriticalSection(&g_slabCachesRegistryLock);
+}
+
+static BOOL carveNewChunkIntoFreeList(slabThreadCache* p_cache, slabObjectTypes objectType)
+{
+	slabChunk* p_chunk = NULL;
+	slabBlockHeader* p_block = NULL;
+	size_t blockSize = 0;
+	int b = 0;
+	//Assert
+	assert(NULL != p_cache);
+
+	blockSize = calculateSlabBlockSize(objectType);
+
+	//A single Heap allocation serves SLAB_BLOCKS_PER_CHUNK objects
+	if (NULL == (p_chunk = (slabChunk*)calloc(sizeof(slabChunk) + (blockSize * SLAB_BLOCKS_PER_CHUNK), SINGLE_OBJECT))) {
+		printf("Error: Failed to allocate dynamic memory (Heap) for a slab chunk.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		return STATUS_CODE_FAILURE;
+	}
+	p_chunk->p_nextChunk = p_cache->p_chunks;
+	p_cache->p_chunks = p_chunk;
+	p_cache->statistics.chunksAllocated[objectType]++;
+
+	//Push every block of the chunk to the free list
+	for (b = 0; b < SLAB_BLOCKS_PER_CHUNK; b++) {
+		p_block = (slabBlockHeader*)((char*)(p_chunk + 1) + (b * blockSize));
+		p_block->p_ownerCache = p_cache;
+		p_block->objectType = objectType;
+		p_block->p_nextFreeBlock = p_cache->p_freeLists[objectType];
+		p_cache->p_freeLists[objectType] = p_block;
+	}
+
+	return STATUS_CODE_SUCCESS;
+}
+
+static size_t calculateSlabBlockSize(slabObjectTypes objectType)
+{
+	size_t blockSize = sizeof(slabBlockHeader) + SLAB_OBJECT_SIZES[objectType];
+
+	//Round up to pointer size, so the header of the following block is aligned
+	return (blockSize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+}
@@ -0,0 +1,65 @@
+/* SlabAllocationTools.h
+------------------------------------------------------------------
+	Module Description - header module for SlabAllocationTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __SLAB_ALLOCATION_TOOLS_H__
+#define __SLAB_ALLOCATION_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function prepares the slab allocator for use: it allocates a Fiber Local Storage slot that will hold every thread's slab cache
+/// (its callback orphans the cache when the thread exits) and initializes the lock of the caches registry. Must be called once, before any thread is created.
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeSlabAllocator();
+
+/// <summary>
+/// Description - This function frees ALL the slab caches & their chunks and releases the Fiber Local Storage slot. Must be called once, after all other threads ended.
+/// </summary>
+void destroySlabAllocator();
+
+/// <summary>
+/// Description - This function hands out a zeroed object of the given type from the calling thread's slab cache in O(1) (free list pop).
+/// If the free list is empty, objects returned by other threads are taken back, and only if there are none the slab grows by a chunk (Heap)
+/// </summary>
+/// <param name="slabObjectTypes objectType - SLAB_MESSAGE, SLAB_PARAMETER, SLAB_MESSAGE_STRING or SLAB_SMALL_BUFFER"></param>
+/// <returns>pointer to the zeroed object, or NULL if failed</returns>
+void* allocateSlabObject(slabObjectTypes objectType);
+
+/// <summary>
+/// Description - This function hands out a zeroed buffer. Buffers of up to SLAB_SMALL_BUFFER_SIZE bytes are SLAB_SMALL_BUFFER objects,
+/// longer buffers are allocated from the Heap (with the same header, so freeSlabObject(.) frees both kinds)
+/// </summary>
+/// <param name="int bufferSize - size of the buffer in bytes"></param>
+/// <returns>pointer to the zeroed buffer, or NULL if failed</returns>
+char* allocateSlabBuffer(int bufferSize);
+
+/// <summary>
+/// Description - This function returns an object (or buffer) to its slab cache in O(1). If the calling thread owns the cache the object is pushed to
+/// the cache's free list, otherwise it is pushed to the cache's remote free list with InterlockedCompareExchangePointer (cross-thread return)
+/// </summary>
+/// <param name="void* p_object - pointer to an object handed out by allocateSlabObject(.) or allocateSlabBuffer(.) (may be NULL)"></param>
+void freeSlabObject(void* p_object);
+
+/// <summary>
+/// Description - This function sums the counters of all slab caches into the given struct
+/// </summary>
+/// <param name="slabStatistics* p_statistics - pointer to the struct that will be filled"></param>
+void fetchSlabAllocatorStatistics(slabStatistics* p_statistics);
+
+
+#endif //__SLAB_ALLOCATION_TOOLS_H__
@@ -29,6 +29,10 @@
 // Projects includes -----------------------------------------------------------
 #include "HardCodedData.h"
 #include "ClientSideSpeakerThreadRoutine.h"
+#include "GameVariantTools.h"
+#include "EventLoggingTools.h"
+#include "OpeningBookTools.h"
+#include "CandidateSetTools.h"
 
 
 // Constants ------------------------------------------------------------
@@ -41,14 +45,19 @@ static const int SINGLE_OBJECT = 1;
 static const int SHORT_SERVER_RESPONSE_WAITING_TIMEOUT = 15000;	// 15 Seconds
 static const int LONG_SERVER_RESPONSE_WAITING_TIMEOUT = 600000; // 600 Seconds = 10 Min
 static const int KEEP_RECEIVE_TIMEOUT = -1;
+static const int NO_RECEIVE_TIMEOUT = 0;	// A spectator waits for the next round as long as the game takes
 
 
 static const int COPY_OPPONENT_NAME_FAILED = -1;
 
 // Global variables ------------------------------------------------------------
 //char* g_p_otherPlayerName = NULL;
-char g_initialPlayerNumber[] = "null"; //Random string of length 5, length of game-numbers
-char g_clientUserGuess[] = "null"; //4-digits inputs - Initialization - Random string of length 5, length of game-numbers
+char g_initialPlayerNumber[MAX_PLAYER_NUMBER_LEN + 1] = "null"; //Initialization - Random string, a game-number of the longest variant fits
+char g_clientUserGuess[MAX_PLAYER_NUMBER_LEN + 1] = "null"; //Guess inputs - Initialization - Random string, a game-number of the longest variant fits
+gameVariant g_gameVariant; //The variant of the current game, as received in SERVER_SETUP_REQUSET
+char g_sessionToken[SESSION_TOKEN_STRING_LEN] = { 0 }; //The session token of the last SERVER_APPROVED - presented when reconnecting (empty - none yet)
+LONG g_numOfShownResults = 0; //# of SERVER_GAME_RESULTS shown since the current game's SERVER_SETUP_REQUSET
+LONG g_reattachedResultsIndex = 0; //The index of the results a reattached game's Server sends again (shown only if not shown yet)
 
 
 // Functions declerations ------------------------------------------------------
@@ -57,11 +66,22 @@ char g_clientUserGuess[] = "null"; //4-digits inputs - Initialization - Random s
 /// Description - this function will send the CLIENT_REQUEST message and await the Server's response and act accordingly
 /// If SERVER_APPROVED is received, the thread will continue to the Server main menu section, otherwise if SERVER_DENIED is
 /// received, it means that this Client is a third player and it is rejected from communications back to "Connections menu"
-/// where the User may decide to reconnect
+/// where the User may decide to reconnect. The request carries the previous connection's session token, so a Client whose connection dropped in
+/// the middle of a game is reattached to it - SERVER_APPROVED then carries the phase of the game's pending request (& the index of its last results)
 /// </summary>
 /// <param name="clientThreadPackage* p_params - thread's inputs (pointers to players name and Socket)"></param>
+/// <param name="char* p_reattachedPhase - output buffer of SESSION_REATTACHED_PHASE_LEN characters - the reattached game's phase (empty if not reattached)"></param>
 /// <returns>'communicationResults' code according to most of the codes possible</returns>
-static communicationResults clientRequestSendingAndReceivingResponse(clientThreadPackage* p_params);
+static communicationResults clientRequestSendingAndReceivingResponse(clientThreadPackage* p_params, char* p_reattachedPhase);
+/// <summary>
+/// Description - This function goes on with a game the Client was reattached to after it reconnected: from SERVER_SETUP_REQUSET if the Server still
+/// awaits the User's initial number, otherwise from the last round's results (if the game had rounds) & SERVER_PLAYER_MOVE_REQUEST (without hints -
+/// only the last results are known)
+/// </summary>
+/// <param name="clientThreadPackage* p_params - thread's inputs (pointers to players name and Socket)"></param>
+/// <param name="const char* p_reattachedPhase - SESSION_REATTACHED_SETUP or SESSION_REATTACHED_GUESSING"></param>
+/// <returns>'communicationResults' code according to most of the codes possible </returns>
+static communicationResults resumeReattachedGame(clientThreadPackage* p_params, const char* p_reattachedPhase);
 /// <summary>
 /// Description - This is the Server's Main Menu loop function which always starts by expecting a SERVER_MAIN_MENU message, then it expects the
 /// User (blocking) to enter a choice - if 1 is taken, then the Client will send the CLIENT_VERSUS in order to play a game, if - is chosen then the Client
@@ -92,10 +112,30 @@ static communicationResults gameRoomEntrance(clientThreadPackage* p_params);
 /// though a CLIENT_PLAYER_MOVE message followed by awaiting the SERVER_GAME_RESULTS\SERVER_WIN or SERVER_DRAW messages, while attempting to intercept the
 /// SERVER_OPPONENT_QUIT message (broken functionality at the moment probably because of the Server). When one of the last three messages (of the 4) arrives,
 /// the client Speaker thread return to Server's main menu to decide if the find another player to play against, or to quit... 
+/// In a classic game, the opening book's guess is shown as a hint for as long as the User guessed the hints. Off the book, the hint is the # of numbers
+/// that are consistent with every result so far, and one of them. A resumed game shows no hints - its results so far are not known (a reattached
+/// game's last results, sent again before SERVER_PLAYER_MOVE_REQUEST, are only printed - if they weren't before the connection dropped)
+/// </summary>
+/// <param name="clientThreadPackage* p_params - thread's inputs (pointers to players name and Socket)"></param>
+/// <param name="BOOL isResumedGame - TRUE if the game was resumed after the Server restarted"></param>
+/// <returns>'communicationResults' code according to most of the codes possible </returns>
+static communicationResults gameLoop(clientThreadPackage* p_params, BOOL isResumedGame);
+/// <summary>
+/// Description - This function watches the Game Room from the spectators port - it expects SERVER_APPROVED (SERVER_DENIED if the spectators are full),
+/// then prints every SERVER_GAME_RESULTS (once per player's guess), SERVER_WIN & SERVER_DRAW the Server fans out, game after game, until the Server disconnects.
+/// A spectator never sends a message
 /// </summary>
 /// <param name="clientThreadPackage* p_params - thread's inputs (pointers to players name and Socket)"></param>
 /// <returns>'communicationResults' code according to most of the codes possible </returns>
-static communicationResults gameLoop(clientThreadPackage* p_params);
+static communicationResults spectateGameRoom(clientThreadPackage* p_params);
+/// <summary>
+/// Description - This function prompts the User for a number of the current game's variant (g_gameVariant) and blocks on STDin until a valid one
+/// is entered - an invalid number is reported & the User is prompted again
+/// </summary>
+/// <param name="const char* p_prompt - the prompt, e.g. "Choose your guess""></param>
+/// <param name="char* p_number - buffer of MAX_PLAYER_NUMBER_LEN + 1 bytes that will hold the number"></param>
+/// <returns>True if succeeded. False if STDin failed</returns>
+static BOOL readPlayerNumberFromUser(const char* p_prompt, char* p_number);
 
 /// <summary>
 /// This function prints the results of every round in a "Bulls and Cows" game
@@ -107,6 +147,11 @@ static void printTheCurrentPhaseResultsToTheScreen(parameter* p_parameters);
 /// </summary>
 /// <param name="parameter* p_parameters - parameters will contain the opponent initial number and the winner name. all buffers with the struct(nested list)"></param>
 static void printTheWinnerToTheScreen(parameter* p_parameters);
+/// <summary>
+/// This function prints the player's history which the Server sends along with the main menu - # of games, wins & draws, the win rate and the latest games
+/// </summary>
+/// <param name="parameter* p_parameters - parameters will contain the # of games, # of wins, # of draws and the latest games. all buffers with the struct(nested list)"></param>
+static void printThePlayerHistoryToTheScreen(parameter* p_parameters);
 
 
 //typedef enum { TRANSFER_FAILED, TRANSFER_SUCCEEDED, TRANSFER_TIMEOUT, TRANSFER_DISCONNECTED } transferResults;
@@ -130,21 +175,26 @@ communicationResults WINAPI clientSideSpeakerThreadRoutine(LPVOID lpParam)
 	message* p_receivedMessageFromServer = NULL;
 	transferResults tranRes = 0;
 	communicationResults mainMenuRes = 0, sendRes = 0, recvRes = 0, graceRes = 0;
+	char reattachedPhase[SESSION_REATTACHED_PHASE_LEN] = { 0 };
 	//Check whether lpParam is NULL - Input integrity validation
 	if (NULL == lpParam) return EMPTY_THREAD_PARAMETERS;
 	//Parameters input conversion from void pointer to section struct pointer by explicit type casting
 	p_params = (clientThreadPackage*)lpParam;
 
+	//A spectator only watches - no request, no main menu
+	if (p_params->isSpectator) return spectateGameRoom(p_params);
+
 
 
 	// Send ^CLIENT REQUEST^   &   Receive   _SERVER_DENIED_       OR        _SERVER_APPROVED_
-	recvRes = clientRequestSendingAndReceivingResponse(p_params);
+	recvRes = clientRequestSendingAndReceivingResponse(p_params, reattachedPhase);
 	if (COMMUNICATION_SUCCEEDED != recvRes) return recvRes;
 
 
 
-	//Expect Main Menu....
-	mainMenuRes = serverMainMenuLoop(p_params);
+	//A Client reattached to its game goes on with it first, then expects the Main Menu as usual....
+	mainMenuRes = ('\0' == reattachedPhase[0]) ? BACK_TO_MENU : resumeReattachedGame(p_params, reattachedPhase);
+	if ((BACK_TO_MENU == mainMenuRes) || (PLAYER_DISCONNECTED == mainMenuRes)) mainMenuRes = serverMainMenuLoop(p_params);
 	//Validate Game procedure result.....
 	switch (mainMenuRes) {
 	case COMMUNICATION_SUCCEEDED: //Attemmpt Graceful Disconnect
@@ -179,13 +229,14 @@ communicationResults WINAPI clientSideSpeakerThreadRoutine(LPVOID lpParam)
 
 //......................................Static functions..........................................
 
-static communicationResults clientRequestSendingAndReceivingResponse(clientThreadPackage* p_params)
+static communicationResults clientRequestSendingAndReceivingResponse(clientThreadPackage* p_params, char* p_reattachedPhase)
 {
 	message* p_receivedMessageFromServer = NULL;
 	transferResults tranRes = 0;
 	communicationResults  sendRes = 0;
-	//Assert
+	//Asserts
 	assert(NULL != p_params);
+	assert(NULL != p_reattachedPhase);
 
 
 	// Send   ^ CLIENT_REQUEST ^
@@ -193,7 +244,8 @@ static communicationResults clientRequestSendingAndReceivingResponse(clientThrea
 	if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageClientSide(
 		p_params->p_s_clientSocket,					/* Client Socket */
 		CLIENT_REQUEST_NUM,							/* Send CLIENT_REQUEST along with our(Player) name */
-		p_params->p_playerName))) {					/* User's name (Our\Player) */
+		p_params->p_playerName,						/* User's name (Our\Player) */
+		('\0' == g_sessionToken[0]) ? NULL : g_sessionToken))) { /* the previous connection's session token, if any */
 
 		// "Send" return with a different output code than COMMUNICATION_SUCCEEDED.. return that code
 		return sendRes; //Graceful disconnect is included if needed (when a fatal error occurs)
@@ -210,6 +262,18 @@ static communicationResults clientRequestSendingAndReceivingResponse(clientThrea
 	if (TRANSFER_SUCCEEDED == tranRes) //Validate the receive operation result...
 		switch (p_receivedMessageFromServer->messageType) {
 		case SERVER_APPROVED_NUM:
+			//Keep the session token for a reconnection. A second parameter means the Server reattached this Client to its game (a third - the index of
+			// the results it sends again)
+			*p_reattachedPhase = '\0';
+			g_reattachedResultsIndex = 0;
+			if (NULL != p_receivedMessageFromServer->p_parameters) {
+				_snprintf_s(g_sessionToken, sizeof(g_sessionToken), _TRUNCATE, "%s", p_receivedMessageFromServer->p_parameters->p_parameter);
+				if (NULL != p_receivedMessageFromServer->p_parameters->p_nextParameter) {
+					_snprintf_s(p_reattachedPhase, SESSION_REATTACHED_PHASE_LEN, _TRUNCATE, "%s", p_receivedMessageFromServer->p_parameters->p_nextParameter->p_parameter);
+					if (NULL != p_receivedMessageFromServer->p_parameters->p_nextParameter->p_nextParameter)
+						g_reattachedResultsIndex = strtol(p_receivedMessageFromServer->p_parameters->p_nextParameter->p_nextParameter->p_parameter, NULL, 10);
+				}
+			}
 			freeTheMessage(p_receivedMessageFromServer);
 			return COMMUNICATION_SUCCEEDED;//Continue...>>>>>>>>>>>>
 			break;
@@ -254,6 +318,8 @@ static communicationResults serverMainMenuLoop(clientThreadPackage* p_params)
 		tranRes = receiveMessage(p_params->p_s_clientSocket, &p_receivedMessageFromServer, KEEP_RECEIVE_TIMEOUT);
 		if (TRANSFER_SUCCEEDED == tranRes) //Validate the receive operation result...
 			if (SERVER_MAIN_MENU_NUM == p_receivedMessageFromServer->messageType) {
+				//A player who already played gets its history along with the main menu
+				if (NULL != p_receivedMessageFromServer->p_parameters) printThePlayerHistoryToTheScreen(p_receivedMessageFromServer->p_parameters);
 				freeTheMessage(p_receivedMessageFromServer);
 				//Continue >>>>>>>>>>>>>>>>>>>>>>>>
 			}
@@ -298,7 +364,7 @@ static communicationResults serverMainMenuLoop(clientThreadPackage* p_params)
 				if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageClientSide(
 					p_params->p_s_clientSocket,					/* Client Socket */
 					CLIENT_DISCONNECT_NUM,						/* Send CLIENT_DISCONNECT to QUIT */
-					NULL))) {									/* no parameters */
+					NULL, NULL))) {									/* no parameters */
 
 					// send   CLIENT_SETUP  may or no may not failed 
 					// "Send" return with a different output code than COMMUNICATION_SUCCEEDED.. return that code....
@@ -357,7 +423,7 @@ static communicationResults clientVersusSendingAndReceivingResponse(clientThread
 	if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageClientSide(
 		p_params->p_s_clientSocket,					/* Client Socket */
 		CLIENT_VERSUS_NUM,							/* Send CLIENT_VERSUS to begin a match */
-		NULL))) {									/* no parameters */
+		NULL, NULL))) {									/* no parameters */
 
 		// "Send" return with a different output code than COMMUNICATION_SUCCEEDED.. return that code
 		return sendRes;
@@ -410,6 +476,8 @@ static communicationResults gameRoomEntrance(clientThreadPackage* p_params)
 	communicationResults sendRes = 0;
 	transferResults tranRes = 0;
 	message* p_receivedMessageFromServer = NULL;
+	const char* p_resumedInitialNumber = NULL;
+	BOOL isResumedGame = FALSE;
 	//Assert
 	assert(NULL != p_params);
 
@@ -421,14 +489,27 @@ static communicationResults gameRoomEntrance(clientThreadPackage* p_params)
 	tranRes = receiveMessage(p_params->p_s_clientSocket, &p_receivedMessageFromServer, SHORT_SERVER_RESPONSE_WAITING_TIMEOUT);
 	if (TRANSFER_SUCCEEDED == tranRes) //Validate the receive operation result...
 		if (SERVER_SETUP_REQUSET_NUM == p_receivedMessageFromServer->messageType) {
+			g_numOfShownResults = 0;
+			//The request carries the game's variant (none - the classic 4 different digits)
+			if (STATUS_CODE_FAILURE == decodeGameVariantParameters(p_receivedMessageFromServer->p_parameters, &g_gameVariant)) {
+				printf("Error: Received an invalid game variant. Exiting\n");
+				printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+				freeTheMessage(p_receivedMessageFromServer);
+				return COMMUNICATION_FAILED;
+			}
+			//A game the Server resumed (it restarted mid-game) carries the User's initial number - the game goes on from its next round
+			if (NULL != (p_resumedInitialNumber = fetchResumedInitialNumber(p_receivedMessageFromServer->p_parameters))) {
+				isResumedGame = TRUE;
+				_snprintf_s(g_initialPlayerNumber, sizeof(g_initialPlayerNumber), _TRUNCATE, "%s", p_resumedInitialNumber);
+				printf("Your game was resumed - your initial number is %s\n", g_initialPlayerNumber);
+			}
 			freeTheMessage(p_receivedMessageFromServer);
 			/*...........................................................*/
 			/*...***...***...***	Input from User	   ***...***...***...*/
 			/*...........................................................*/
-			printf("Choose your 4 digits:\n");
 			//Proceed to block this Client Speaker thread to receive an input from STDin,
-			// which is expected to be the INITIAL 4-digits number for the game...
-			if (SINGLE_OBJECT > scanf_s("%s", &g_initialPlayerNumber, EXIT_GUESS_LEN)) {
+			// which is expected to be the INITIAL number for the game...
+			if ((FALSE == isResumedGame) && (STATUS_CODE_FAILURE == readPlayerNumberFromUser("Choose your initial number", g_initialPlayerNumber))) {
 				// scanf_s failed
 				printf("Error: Failed to collect a valid answer from STDin at Server's main menu.\n");
 				printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
@@ -459,11 +540,11 @@ static communicationResults gameRoomEntrance(clientThreadPackage* p_params)
 
 	//printf("\n\n9\n");
 
-	//Send  ^ CLIENT_SETUP ^
-	if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageClientSide(
+	//Send  ^ CLIENT_SETUP ^  (a resumed game's number is already the Server's)
+	if ((FALSE == isResumedGame) && (communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageClientSide(
 		p_params->p_s_clientSocket,					/* Client Socket */
 		CLIENT_SETUP_NUM,							/* Send CLIENT_SETUP to send self number */
-		(char*)&g_initialPlayerNumber))) {			/* self player's number */
+		(char*)&g_initialPlayerNumber, NULL))) {			/* self player's number */
 
 		// send   CLIENT_SETUP  may or no may not failed 
 		// "Send" return with a different output code than COMMUNICATION_SUCCEEDED.. return that code....
@@ -473,7 +554,7 @@ static communicationResults gameRoomEntrance(clientThreadPackage* p_params)
 
 	//printf("\n\n10\n"); 'DELETE'
 	//Enter Game loop.....
-	switch(gameLoop(p_params)){
+	switch(gameLoop(p_params, isResumedGame)){
 	case BACK_TO_MENU:					return BACK_TO_MENU; break;
 	case PLAYER_DISCONNECTED:			return PLAYER_DISCONNECTED; break;
 	case SERVER_DISCONNECTED:			return SERVER_DISCONNECTED; break;
@@ -484,14 +565,36 @@ static communicationResults gameRoomEntrance(clientThreadPackage* p_params)
 }
 
 
-static communicationResults gameLoop(clientThreadPackage* p_params)
+static communicationResults resumeReattachedGame(clientThreadPackage* p_params, const char* p_reattachedPhase)
+{
+	//Asserts
+	assert(NULL != p_params);
+	assert(NULL != p_reattachedPhase);
+
+	printf("Reconnected to your game.\n");
+	//The Server sends the pending request again - SERVER_SETUP_REQUSET (the game's variant is in it) or SERVER_PLAYER_MOVE_REQUEST, after the last round's results
+	if (0 == strcmp(p_reattachedPhase, SESSION_REATTACHED_SETUP)) return gameRoomEntrance(p_params);
+	return gameLoop(p_params, TRUE);
+}
+
+static communicationResults gameLoop(clientThreadPackage* p_params, BOOL isResumedGame)
 {
 	communicationResults sendRes = 0;
 	transferResults tranRes = 0;
 	message* p_receivedMessageFromServer = NULL;
+	char hint[PLAYER_NUMBER_LEN + 1] = { 0 };
+	LONG hintNode = OPENING_BOOK_NO_NODE;
+	candidateSet hintCandidates;
+	int numOfHintCandidates = 0;
 	//Assert
 	assert(NULL != p_params);
 
+	//The opening book & the candidates are of the classic variant only (no book is mapped - the candidates hint from the first guess)
+	if ((FALSE == isResumedGame) && (TRUE == isClassicGameVariant(&g_gameVariant))) {
+		hintNode = fetchOpeningBookRoot();
+		numOfHintCandidates = fillCandidateSet(&hintCandidates);
+	}
+
 	//GAME LOOP
 	while (TRUE) {
 		//Receive _SERVER_PLAYER_MOVE_REQUEST_ 
@@ -504,18 +607,36 @@ static communicationResults gameLoop(clientThreadPackage* p_params)
 				/*...........................................................*/
 				/*...***...***...***	Input from User	   ***...***...***...*/
 				/*...........................................................*/
-				printf("Choose your guess:\n");
 				//Proceed to block this Client Speaker thread to receive an input from STDin,
-				// which is expected to be a GUESS of a 4-digits number for the a phase in the game...
-				if (SINGLE_OBJECT > scanf_s("%s", &g_clientUserGuess, EXIT_GUESS_LEN)) {
+				// which is expected to be a GUESS of the opponent's number for the a phase in the game...
+				if (OPENING_BOOK_NO_NODE != hintNode) {
+					fetchOpeningBookGuess(hintNode, hint);
+					printf("Hint: the solver would guess %s\n", hint);
+				}
+				else if (0 < numOfHintCandidates)
+					printf("Hint: %d numbers are still possible, e.g. %s\n", numOfHintCandidates,
+						fetchCandidateNumber(fetchNthCandidate(&hintCandidates, 0)));
+				if (STATUS_CODE_FAILURE == readPlayerNumberFromUser("Choose your guess", g_clientUserGuess)) {
 					// scanf_s failed
 					printf("Error: Failed to collect a correct answer from STDin at Server's main menu.\n");
 					printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
 					//gracefulDisconnect(p_params->p_s_clientSocket); //Operaion failed regardless of gracefulDisconnect operation
 					return COMMUNICATION_FAILED;
 				}
+				//The book's next hint depends on its own guess - a different guess ends the hints
+				if ((OPENING_BOOK_NO_NODE != hintNode) && (0 != strcmp(hint, g_clientUserGuess))) hintNode = OPENING_BOOK_NO_NODE;
 				freeTheMessage(p_receivedMessageFromServer);
 				break; //Continue... >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+			case SERVER_GAME_RESULTS_NUM:
+				//A reattached game - the last round's results may have been lost with the dropped connection, the move request follows.
+				// Results that were shown before the connection dropped are not shown twice
+				if (g_numOfShownResults < g_reattachedResultsIndex) {
+					printTheCurrentPhaseResultsToTheScreen(p_receivedMessageFromServer->p_parameters);
+					g_numOfShownResults = g_reattachedResultsIndex;
+				}
+				freeTheMessage(p_receivedMessageFromServer);
+				continue; break;
 			
 			case SERVER_OPPONENT_QUIT_NUM:
 				printf("\nOpponent quit.\n");
@@ -542,7 +663,7 @@ static communicationResults gameLoop(clientThreadPackage* p_params)
 		if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageClientSide(
 			p_params->p_s_clientSocket,					/* Client Socket */
 			CLIENT_PLAYER_MOVE_NUM,						/* Send CLIENT_PLAYER_MOVE to send a 'guess' number of the opponent */
-			(char*)&g_clientUserGuess))) {				/* self player's guess number of the opponent number */
+			(char*)&g_clientUserGuess, NULL))) {				/* self player's guess number of the opponent number */
 
 			// send   CLIENT_PLAYER_MOVE  failed may or no may not failed 
 			// "Send" return with a different output code than COMMUNICATION_SUCCEEDED.. return that code....
@@ -562,6 +683,16 @@ static communicationResults gameLoop(clientThreadPackage* p_params)
 			switch(p_receivedMessageFromServer->messageType){
 			case SERVER_GAME_RESULTS_NUM:
 				printTheCurrentPhaseResultsToTheScreen(p_receivedMessageFromServer->p_parameters);
+				g_numOfShownResults++;
+				//Follow the result of the hinted guess (the first two parameters - bulls & cows)
+				if (OPENING_BOOK_NO_NODE != hintNode)
+					hintNode = followOpeningBook(hintNode, (SHORT)strtol(p_receivedMessageFromServer->p_parameters->p_parameter, NULL, 10),
+						(SHORT)strtol(p_receivedMessageFromServer->p_parameters->p_nextParameter->p_parameter, NULL, 10));
+				//Keep the numbers that score the User's guess the same (no number left - the hints stop)
+				if (0 < numOfHintCandidates)
+					numOfHintCandidates = filterCandidateSet(&hintCandidates, g_clientUserGuess,
+						(SHORT)strtol(p_receivedMessageFromServer->p_parameters->p_parameter, NULL, 10),
+						(SHORT)strtol(p_receivedMessageFromServer->p_parameters->p_nextParameter->p_parameter, NULL, 10));
 				freeTheMessage(p_receivedMessageFromServer);
 				//LOOP FOR ANOTHER ROUND ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 				continue; break;
@@ -603,6 +734,64 @@ static communicationResults gameLoop(clientThreadPackage* p_params)
 
 
 
+static communicationResults spectateGameRoom(clientThreadPackage* p_params)
+{
+	message* p_receivedMessageFromServer = NULL;
+	transferResults tranRes = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	// Receive _SERVER_APPROVED_  OR  _SERVER_DENIED_   - the Server replies as soon as it accepts the spectator
+	tranRes = receiveMessage(p_params->p_s_clientSocket, &p_receivedMessageFromServer, SHORT_SERVER_RESPONSE_WAITING_TIMEOUT);
+	if (TRANSFER_SUCCEEDED != tranRes) {
+		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_clientSocket)) return COMMUNICATION_FAILED;
+		return (communicationResults)tranRes;
+	}
+	switch (p_receivedMessageFromServer->messageType) {
+	case SERVER_APPROVED_NUM:
+		freeTheMessage(p_receivedMessageFromServer);
+		printf("Watching the Game Room...\n");
+		break;
+
+	case SERVER_DENIED_NUM: //All the spectator slots are taken
+		freeTheMessage(p_receivedMessageFromServer);
+		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_clientSocket)) return COMMUNICATION_FAILED;
+		return SERVER_DENIED_COMM; break;
+
+	default:/* no other message is expected from the Server at this point */
+		freeTheMessage(p_receivedMessageFromServer);
+		return gracefulDisconnect(p_params->p_s_clientSocket);
+	}
+
+
+	//Watch - game after game, until the Server disconnects
+	while (TRUE) {
+		tranRes = receiveMessage(p_params->p_s_clientSocket, &p_receivedMessageFromServer, NO_RECEIVE_TIMEOUT);
+		if (TRANSFER_SUCCEEDED != tranRes) return (communicationResults)tranRes; //SERVER_DISCONNECTED returns to the "Connections menu"
+
+		switch (p_receivedMessageFromServer->messageType) {
+		case SERVER_GAME_RESULTS_NUM:
+			printTheCurrentPhaseResultsToTheScreen(p_receivedMessageFromServer->p_parameters);
+			break;
+
+		case SERVER_WIN_NUM:
+			printTheWinnerToTheScreen(p_receivedMessageFromServer->p_parameters);
+			printf("Watching the Game Room...\n");
+			break;
+
+		case SERVER_DRAW_NUM:
+			printf("\nIt's a tie\n");
+			printf("Watching the Game Room...\n");
+			break;
+
+		default: //Ignored - a spectator only prints the Game Room's results
+			LOG_EVENT(LOG_EVENT_UNEXPECTED, "A spectator received an unexpected message", p_receivedMessageFromServer->messageType, 0);
+			break;
+		}
+		freeTheMessage(p_receivedMessageFromServer);
+	}
+}
+
 static void printTheCurrentPhaseResultsToTheScreen(parameter* p_parameters)
 {
 	parameter* temp = NULL;
@@ -646,3 +835,44 @@ static void printTheWinnerToTheScreen(parameter* p_parameters)
 	printf("opponents number was %s\n", p_parameters->p_parameter);
 }
 
+static void printThePlayerHistoryToTheScreen(parameter* p_parameters)
+{
+	long numOfGames = 0, numOfWins = 0, numOfDraws = 0;
+	//Assert
+	assert(NULL != p_parameters);
+
+	//.......Print _SERVER_MAIN_MENU_ parameters.........
+
+	// Get the # of games, wins & draws
+	numOfGames = strtol(p_parameters->p_parameter, NULL, 10);
+	if (NULL == (p_parameters = p_parameters->p_nextParameter)) return;
+	numOfWins = strtol(p_parameters->p_parameter, NULL, 10);
+	if (NULL == (p_parameters = p_parameters->p_nextParameter)) return;
+	numOfDraws = strtol(p_parameters->p_parameter, NULL, 10);
+	if (0 >= numOfGames) return;
+	// Print them with the win rate
+	printf("\nYour games: %ld (wins: %ld, draws: %ld, losses: %ld) - win rate %.1f%%\n",
+		numOfGames, numOfWins, numOfDraws, numOfGames - numOfWins - numOfDraws, (100.0 * numOfWins) / numOfGames);
+
+	// Get the next parameter 
+	if (NULL == (p_parameters = p_parameters->p_nextParameter)) return;
+	// Print the latest games - outcome & opponent, latest first
+	printf("Latest games: %s\n\n", p_parameters->p_parameter);
+}
+
+static BOOL readPlayerNumberFromUser(const char* p_prompt, char* p_number)
+{
+	char variantDescription[GAME_VARIANT_DESCRIPTION_LEN] = { 0 };
+	//Asserts
+	assert(NULL != p_prompt);
+	assert(NULL != p_number);
+
+	describeGameVariant(&g_gameVariant, variantDescription);
+	while (TRUE) {
+		printf("%s (%s):\n", p_prompt, variantDescription);
+		if (SINGLE_OBJECT > scanf_s("%s", p_number, MAX_PLAYER_NUMBER_LEN + 1)) return STATUS_CODE_FAILURE;
+		if (TRUE == isValidPlayerNumber(&g_gameVariant, p_number)) return STATUS_CODE_SUCCESS;
+		printf("%s is not %s\n", p_number, variantDescription);
+	}
+}
+
@@ -71,6 +71,8 @@ static const BOOL DONT_INHERIT_HANDLE = FALSE;
 
 //clientThreadPackage
 clientThreadPackage* g_p_clientSpeakerThreadPackage = NULL;
+//TRUE if the Client only watches the Game Room - copied to every Speaker thread package (a reconnection recreates it)
+static BOOL g_isSpectator = FALSE;
 
 
 
@@ -136,7 +138,7 @@ static BOOL communicationTerminationProcedure(HANDLE* p_h_serverCommunicationThr
 
 // Functions definitions -------------------------------------------------------
 
-BOOL setCommmunicationClientSide(char* p_ipAddressString, unsigned short serverPortNumber, char* p_playerNameString)
+BOOL setCommmunicationClientSide(char* p_ipAddressString, unsigned short serverPortNumber, char* p_playerNameString, BOOL isSpectator)
 {
 	//Winsock connectivity variables & pointers
 	WSADATA wsaData;
@@ -154,6 +156,7 @@ BOOL setCommmunicationClientSide(char* p_ipAddressString, unsigned short serverP
 	if ( (NULL == p_ipAddressString) || (NULL == p_playerNameString) ) {
 		printf("Error: Bad inputs to function: %s\n", __func__); return STATUS_CODE_FAILURE;
 	}
+	g_isSpectator = isSpectator;
 
 
 
@@ -428,6 +431,7 @@ static BOOL initiateSpeakerThreadPackages(char* p_playerNameString, SOCKET* p_s_
 	//Update the Client thread package struct's fields with ALL the needed pointers 
 	g_p_clientSpeakerThreadPackage->p_playerName = p_playerNameString;
 	g_p_clientSpeakerThreadPackage->p_s_clientSocket = p_s_clientSocket;
+	g_p_clientSpeakerThreadPackage->isSpectator = g_isSpectator;
 
 
 
@@ -22,6 +22,6 @@
 #include "ClientSideSpeakerThreadRoutine.h"
 
 //Functions Declarations
-BOOL setCommmunicationClientSide(char* p_ipAddressString, unsigned short serverPortNumber, char* p_playerNameString);
+BOOL setCommmunicationClientSide(char* p_ipAddressString, unsigned short serverPortNumber, char* p_playerNameString, BOOL isSpectator);
 
 #endif //__SET_COMMUNICATION_CLIENT_SIDE_H__
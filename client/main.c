@@ -10,6 +10,7 @@
 
 // Library includes -------------------------------------------------------------------------------------
 #include <stdio.h>
+#include <string.h>
 #include <Windows.h>
 
 // Projects includes ------------------------------------------------------------------------------------
@@ -19,6 +20,10 @@
 #include "MessagesTransferringTools.h"
 #include "ServerClientsTools.h"
 #include "MemoryHandling.h"
+#include "SlabAllocationTools.h"
+#include "EventLoggingTools.h"
+#include "OpeningBookTools.h"
+#include "CandidateSetTools.h"
 
 
 
@@ -33,14 +38,22 @@ int main(int argc, char* argv[]) {
 	unsigned short serverPortNumber = 0;
 	int clientUserResponse = 0;
 	char inputFromServerUser[] = "null";
+	BOOL isSpectator = FALSE;
 
 	
 
-	//Validating the number of command line arguments
-	if ((argc != 4) || (argv[1] == NULL) || (argv[2] == NULL) || (argv[3] == NULL) ) {
+	//Validating the number of command line arguments (an optional 4th one, CLIENT_SPECTATE_OPTION, watches the Game Room instead of playing)
+	if (((argc != 4) && (argc != 5)) || (argv[1] == NULL) || (argv[2] == NULL) || (argv[3] == NULL) ) {
 		printf("Error: Incorrect number of arguments.\n");
 		return 1;
 	}
+	if (5 == argc) {
+		if ((argv[4] == NULL) || (0 != strcmp(argv[4], CLIENT_SPECTATE_OPTION))) {
+			printf("Error: Unknown option, the only option is \"%s\".\n", CLIENT_SPECTATE_OPTION);
+			return 1;
+		}
+		isSpectator = TRUE;
+	}
 
 
 	/* ------------------------------------------------------------------------------------------------- */
@@ -48,6 +61,20 @@ int main(int argc, char* argv[]) {
 	/*							A number between 0 - 65536												 */
 	/* ------------------------------------------------------------------------------------------------- */
 	if (STATUS_CODE_FAILURE == fetchAndValidateCommandLineArguments(argv[2], &serverPortNumber, argv[1], argv[3])) return 1;
+	//Spectators connect to the Server's spectators port
+	if (isSpectator) serverPortNumber = (unsigned short)(serverPortNumber + SPECTATOR_ENDPOINT_PORT_OFFSET);
+
+	//Start the event logger (diagnostics) & prepare the per-thread slab caches of the messages objects, before any thread is created
+	if (STATUS_CODE_FAILURE == initializeEventLogger()) return 1;
+	if (STATUS_CODE_FAILURE == initializeSlabAllocator()) {
+		destroyEventLogger();
+		return 1;
+	}
+	//Map the opening book for the hints, if one was built (the candidates hint without it)
+	if (FALSE == isSpectator) {
+		initializeCandidateSets();
+		loadOpeningBook(OPENING_BOOK_PATH);
+	}
 
 
 	
@@ -62,8 +89,11 @@ int main(int argc, char* argv[]) {
 	/* the Server by creating a socket a binding it to local address comprised of the analyzed inputs.							   */
 	//	Also, it will execute the operation termination by freeing allocated memory and closing sockets.						   */
 	/* --------------------------------------------------------------------------------------------------------------------------- */
-	if (STATUS_CODE_FAILURE == setCommmunicationClientSide(argv[1], serverPortNumber, argv[3])) {
+	if (STATUS_CODE_FAILURE == setCommmunicationClientSide(argv[1], serverPortNumber, argv[3], isSpectator)) {
 		printf("FINAL Error: Failed to communicate with designated Server properly.\n\n\n\n");
+		unloadOpeningBook();
+		destroySlabAllocator();
+		destroyEventLogger();
 		return 1;
 	}
 
@@ -72,6 +102,11 @@ int main(int argc, char* argv[]) {
 
 
 
+	//All threads ended - unmap the opening book, free the slab caches & print the remaining diagnostics
+	unloadOpeningBook();
+	destroySlabAllocator();
+	destroyEventLogger();
+
 	printf("Communication with designated Server was successful !!!!!\n\n\n\n\n\n");
 	return 0;
 }
@@ -0,0 +1,498 @@
+/* AdminEndpointTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the Server's admin endpoint: a thread
+		listening on a localhost port (the game port + ADMIN_ENDPOINT_PORT_OFFSET),
+		that answers every HTTP request with the live telemetry in the Prometheus
+		text format - connected Clients, active rooms, rounds per second, message
+		counters, latency percentiles, slab allocator, log rings & send queues depths.
+		A scrape never stalls the Worker threads: the metrics registry is merged
+		without any lock, the connected Clients count & the Game Room state word
+		are read without their Mutex\Interlocked functions, and the allocator &
+		logger registries are locked only while their list heads are sampled.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "AdminEndpointTools.h"
+#include "MetricsTools.h"
+#include "SlabAllocationTools.h"
+#include "EventLoggingTools.h"
+#include "SendQueueTools.h"
+#include "MatchmakingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL MANUAL_RESET = TRUE;
+static const BOOL INITIALLY_NON_SIGNALED = FALSE;
+static const BOOL INETPTONS_SUCCESS = 1;
+static const int SINGLE_OBJECT = 1;
+
+static const long ADMIN_SELECT_TIMEOUT_MICRO_SEC = 500000;		// the stop Event is sampled every 0.5 Seconds
+static const DWORD ADMIN_CLIENT_TIMEOUT_MS = 1000;				// a scraper gets 1 Second to send its request & to receive the response
+static const DWORD ADMIN_THREAD_STOP_TIMEOUT_MS = 5000;
+static const int ADMIN_LISTEN_BACKLOG = 4;
+
+static const double MICROSECONDS_IN_SECOND = 1000000.0;
+
+//Served percentiles & their Prometheus quantile labels
+static const double SERVED_PERCENTILES[] = { 50.0, 99.0, 99.9 };
+static const char* SERVED_QUANTILE_LABELS[] = { "0.5", "0.99", "0.999" };
+
+//Label values (ordered as the message type serial numbers, 'workerPhases' & 'slabObjectTypes')
+static const char* MESSAGE_TYPE_LABELS[NUM_OF_MESSAGE_TYPES] = { "",
+	SERVER_MAIN_MENU, SERVER_APPROVED, SERVER_DENIED, SERVER_INVITE, SERVER_SETUP_REQUSET, SERVER_PLAYER_MOVE_REQUEST, SERVER_GAME_RESULTS,
+	SERVER_WIN, SERVER_DRAW, SERVER_NO_OPPONENTS, SERVER_OPPONENT_QUIT,
+	CLIENT_REQUEST, CLIENT_VERSUS, CLIENT_SETUP, CLIENT_PLAYER_MOVE, CLIENT_DISCONNECT };
+static const char* WORKER_PHASE_LABELS[NUM_OF_WORKER_PHASES] = { "admission", "main_menu", "pairing", "setup", "guessing" };
+static const char* SLAB_OBJECT_TYPE_LABELS[NUM_OF_SLAB_OBJECT_TYPES] = { "message", "parameter", "message_string", "small_buffer" };
+static const char* MATCHMAKING_OUTCOME_LABELS[NUM_OF_MATCHMAKING_OUTCOMES] = { "matched_player", "matched_bot", "no_opponent", "aborted", "failed" };
+
+static const char ADMIN_METRICS_PATH[] = "GET /metrics ";
+static const char ADMIN_ROOT_PATH[] = "GET / ";
+static const char ADMIN_OK_HEADERS[] = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n";
+static const char ADMIN_NOT_FOUND_RESPONSE[] = "HTTP/1.0 404 Not Found\r\nContent-Type: text/plain\r\nConnection: close\r\n\r\nTry GET /metrics\n";
+
+
+// Global variables ------------------------------------------------------------
+//Admin thread, its stop Event & its listening socket
+static HANDLE g_h_adminThread = NULL;
+static HANDLE g_h_adminStopEvent = NULL;
+static SOCKET g_s_adminListeningSocket = INVALID_SOCKET;
+
+//The telemetry sources (read only)
+static USHORT* g_p_adminConnectedClientsNum = NULL;
+static gameRoom* g_p_adminGameRoom = NULL;
+
+//Scrape buffers - allocated once, used by the admin thread only
+static metricsSnapshot* g_p_adminSnapshot = NULL;
+static char* g_p_adminResponseBody = NULL;
+
+//Rounds per second is the rounds count difference between two scrapes (or since the endpoint was started)
+static LARGE_INTEGER g_adminTicksFrequency;
+static LONGLONG g_previousScrapeTicks = 0;
+static LONG64 g_previousNumOfRounds = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function creates the admin listening socket, binds it to SERVER_ADDRESS_STR & the input port and starts listening
+/// </summary>
+/// <param name="unsigned short adminPortNumber - port number"></param>
+/// <returns>the listening socket, or INVALID_SOCKET if failed</returns>
+static SOCKET createAdminListeningSocket(unsigned short adminPortNumber);
+
+/// <summary>
+/// Description - Admin thread routine. Waits for scrapers with select(.) & serves them one at a time, until the stop Event is signaled
+/// </summary>
+/// <param name="LPVOID lpParam - ignored"></param>
+/// <returns>0</returns>
+static DWORD WINAPI adminThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function reads a single HTTP request from an accepted scraper socket and sends back the telemetry (or a 404 response)
+/// </summary>
+/// <param name="SOCKET s_scraperSocket - accepted socket (closed by the caller)"></param>
+static void serveSingleScrape(SOCKET s_scraperSocket);
+
+/// <summary>
+/// Description - This function formats the whole telemetry into the response body buffer
+/// </summary>
+/// <returns>length of the body</returns>
+static size_t formatTelemetry();
+
+/// <summary>
+/// Description - This function formats a Prometheus summary (p50, p99, p99.9, sum & count, in seconds) of a merged histogram
+/// </summary>
+/// <param name="size_t* p_bodyLength - pointer to the current body length (updated)"></param>
+/// <param name="const char* p_metricName - the summary name"></param>
+/// <param name="const char* p_labelName - name of an extra label, or NULL"></param>
+/// <param name="const char* p_labelValue - value of the extra label"></param>
+/// <param name="const metricsHistogramSnapshot* p_histogram - pointer to the histogram"></param>
+static void appendSummary(size_t* p_bodyLength, const char* p_metricName, const char* p_labelName, const char* p_labelValue,
+	const metricsHistogramSnapshot* p_histogram);
+
+/// <summary>
+/// Description - This function appends a formatted string to the response body buffer. Text beyond ADMIN_RESPONSE_BUFFER_SIZE is truncated
+/// </summary>
+/// <param name="size_t* p_bodyLength - pointer to the current body length (updated)"></param>
+/// <param name="const char* p_format - printf format"></param>
+static void appendToResponseBody(size_t* p_bodyLength, const char* p_format, ...);
+
+/// <summary>
+/// Description - This function sends a whole buffer, calling send(.) until all of it was sent
+/// </summary>
+/// <param name="SOCKET s_socket - the socket"></param>
+/// <param name="const char* p_buffer - the buffer"></param>
+/// <param name="size_t length - # of bytes to send"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL sendWholeBuffer(SOCKET s_socket, const char* p_buffer, size_t length);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL startAdminEndpoint(unsigned short adminPortNumber, USHORT* p_currentNumOfConnectedClients, gameRoom* p_gameRoom)
+{
+	LARGE_INTEGER startTicks;
+	//Input integrity validation
+	if ((0 == adminPortNumber) || (NULL == p_currentNumOfConnectedClients) || (NULL == p_gameRoom)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, "", 0, 0);
+		return STATUS_CODE_FAILURE;
+	}
+
+	g_p_adminConnectedClientsNum = p_currentNumOfConnectedClients;
+	g_p_adminGameRoom = p_gameRoom;
+	QueryPerformanceFrequency(&g_adminTicksFrequency);
+	QueryPerformanceCounter(&startTicks);
+	g_previousScrapeTicks = startTicks.QuadPart;
+	g_previousNumOfRounds = 0;
+
+	//Scrape buffers - the snapshot is too large for the thread's Stack
+	if (NULL == (g_p_adminSnapshot = (metricsSnapshot*)calloc(sizeof(metricsSnapshot), SINGLE_OBJECT))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a metricsSnapshot struct", 0, 0);
+		stopAdminEndpoint();
+		return STATUS_CODE_FAILURE;
+	}
+	if (NULL == (g_p_adminResponseBody = (char*)malloc(ADMIN_RESPONSE_BUFFER_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "the admin response buffer", 0, 0);
+		stopAdminEndpoint();
+		return STATUS_CODE_FAILURE;
+	}
+
+	if (INVALID_SOCKET == (g_s_adminListeningSocket = createAdminListeningSocket(adminPortNumber))) {
+		stopAdminEndpoint();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Admin thread & its stop Event
+	if (NULL == (g_h_adminStopEvent = CreateEvent(NULL, MANUAL_RESET, INITIALLY_NON_SIGNALED, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the admin thread stop Event", GetLastError(), 0);
+		stopAdminEndpoint();
+		return STATUS_CODE_FAILURE;
+	}
+	if (NULL == (g_h_adminThread = CreateThread(NULL, 0, adminThreadRoutine, NULL, 0, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the admin thread", GetLastError(), 0);
+		stopAdminEndpoint();
+		return STATUS_CODE_FAILURE;
+	}
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void stopAdminEndpoint()
+{
+	//Stop the admin thread (it samples the stop Event every ADMIN_SELECT_TIMEOUT_MICRO_SEC)
+	if (NULL != g_h_adminThread) {
+		SetEvent(g_h_adminStopEvent);
+		if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_adminThread, ADMIN_THREAD_STOP_TIMEOUT_MS))
+			LOG_EVENT(LOG_EVENT_TIMEOUT, "Stopping the admin thread", ADMIN_THREAD_STOP_TIMEOUT_MS, 0);
+		CloseHandle(g_h_adminThread);
+		g_h_adminThread = NULL;
+	}
+	if (NULL != g_h_adminStopEvent) {
+		CloseHandle(g_h_adminStopEvent);
+		g_h_adminStopEvent = NULL;
+	}
+
+	if (INVALID_SOCKET != g_s_adminListeningSocket) {
+		if (SOCKET_ERROR == closesocket(g_s_adminListeningSocket))
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to close the admin listening socket", WSAGetLastError(), 0);
+		g_s_adminListeningSocket = INVALID_SOCKET;
+	}
+
+	free(g_p_adminSnapshot);
+	g_p_adminSnapshot = NULL;
+	free(g_p_adminResponseBody);
+	g_p_adminResponseBody = NULL;
+	g_p_adminConnectedClientsNum = NULL;
+	g_p_adminGameRoom = NULL;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static SOCKET createAdminListeningSocket(unsigned short adminPortNumber)
+{
+	SOCKET s_listeningSocket = INVALID_SOCKET;
+	SOCKADDR_IN service;
+
+	if (INVALID_SOCKET == (s_listeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to create the admin listening socket", WSAGetLastError(), 0);
+		return INVALID_SOCKET;
+	}
+
+	//Local address ONLY - the telemetry is never exposed outside the Server's machine
+	memset(&service, 0, sizeof(service));
+	service.sin_family = AF_INET;
+	service.sin_port = htons(adminPortNumber);
+	if (INETPTONS_SUCCESS != InetPton(AF_INET, SERVER_ADDRESS_STR, &service.sin_addr.s_addr)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to translate the admin address", WSAGetLastError(), 0);
+		closesocket(s_listeningSocket);
+		return INVALID_SOCKET;
+	}
+
+	if (SOCKET_ERROR == bind(s_listeningSocket, (SOCKADDR*)&service, sizeof(service))) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to bind the admin listening socket (is the admin port taken?)", WSAGetLastError(), 0);
+		closesocket(s_listeningSocket);
+		return INVALID_SOCKET;
+	}
+	if (SOCKET_ERROR == listen(s_listeningSocket, ADMIN_LISTEN_BACKLOG)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed listening on the admin socket", WSAGetLastError(), 0);
+		closesocket(s_listeningSocket);
+		return INVALID_SOCKET;
+	}
+
+	return s_listeningSocket;
+}
+
+static DWORD WINAPI adminThreadRoutine(LPVOID lpParam)
+{
+	SOCKET s_scraperSocket = INVALID_SOCKET;
+	fd_set listeningSocketSet;
+	struct timeval selectTimeout;
+	int selectResult = 0;
+
+	while (WAIT_TIMEOUT == WaitForSingleObject(g_h_adminStopEvent, 0))
+	{
+		//select(.) modifies both the set & the timeout - reset them every time
+		FD_ZERO(&listeningSocketSet);
+		FD_SET(g_s_adminListeningSocket, &listeningSocketSet);
+		selectTimeout.tv_sec = 0;
+		selectTimeout.tv_usec = ADMIN_SELECT_TIMEOUT_MICRO_SEC;
+
+		selectResult = select(0, &listeningSocketSet, NULL, NULL, &selectTimeout);
+		if (SOCKET_ERROR == selectResult) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to sample the admin listening socket - the admin endpoint is closed", WSAGetLastError(), 0);
+			break; //The games are served regardless
+		}
+		if (NO_CLIENT_PENDING_CONNECTION == selectResult) continue;
+
+		if (INVALID_SOCKET == (s_scraperSocket = accept(g_s_adminListeningSocket, NULL, NULL))) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to accept an admin connection", WSAGetLastError(), 0);
+			continue;
+		}
+		serveSingleScrape(s_scraperSocket);
+		closesocket(s_scraperSocket);
+	}
+
+	return 0;
+}
+
+static void serveSingleScrape(SOCKET s_scraperSocket)
+{
+	char request[ADMIN_REQUEST_BUFFER_SIZE] = { 0 };
+	size_t bodyLength = 0;
+	int requestLength = 0;
+
+	//A slow (or silent) scraper can't hold the admin thread for more than ADMIN_CLIENT_TIMEOUT_MS
+	setsockopt(s_scraperSocket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&ADMIN_CLIENT_TIMEOUT_MS, sizeof(ADMIN_CLIENT_TIMEOUT_MS));
+	setsockopt(s_scraperSocket, SOL_SOCKET, SO_SNDTIMEO, (const char*)&ADMIN_CLIENT_TIMEOUT_MS, sizeof(ADMIN_CLIENT_TIMEOUT_MS));
+
+	//The request line arrives in the first segment - the rest of the request (headers) is ignored
+	if (0 >= (requestLength = recv(s_scraperSocket, request, sizeof(request) - 1, 0))) return;
+
+	if ((0 != strncmp(request, ADMIN_METRICS_PATH, sizeof(ADMIN_METRICS_PATH) - 1)) &&
+		(0 != strncmp(request, ADMIN_ROOT_PATH, sizeof(ADMIN_ROOT_PATH) - 1))) {
+		sendWholeBuffer(s_scraperSocket, ADMIN_NOT_FOUND_RESPONSE, sizeof(ADMIN_NOT_FOUND_RESPONSE) - 1);
+		return;
+	}
+
+	bodyLength = formatTelemetry();
+	if (STATUS_CODE_SUCCESS == sendWholeBuffer(s_scraperSocket, ADMIN_OK_HEADERS, sizeof(ADMIN_OK_HEADERS) - 1))
+		sendWholeBuffer(s_scraperSocket, g_p_adminResponseBody, bodyLength);
+}
+
+static size_t formatTelemetry()
+{
+	metricsSnapshot* p_snapshot = g_p_adminSnapshot;
+	slabStatistics slabTotals;
+	sendQueueStatistics sendQueueTotals;
+	LARGE_INTEGER scrapeTicks;
+	LONG roomStateWord = 0, roomPhase = 0, pendingLogEvents = 0, droppedLogEvents = 0;
+	double elapsedSeconds = 0, roundsPerSecond = 0;
+	size_t bodyLength = 0;
+	int type = 0, phase = 0, outcome = 0;
+
+	//Sample every source - nothing here blocks a Worker thread
+	if (STATUS_CODE_FAILURE == takeMetricsSnapshot(p_snapshot)) memset(p_snapshot, 0, sizeof(metricsSnapshot));
+	fetchSlabAllocatorStatistics(&slabTotals);
+	fetchEventLoggerQueueDepths(&pendingLogEvents, &droppedLogEvents);
+	fetchSendQueueStatistics(&sendQueueTotals);
+	roomStateWord = g_p_adminGameRoom->roomStateWord;
+	roomPhase = GAME_ROOM_PHASE(roomStateWord);
+
+	QueryPerformanceCounter(&scrapeTicks);
+	if (0 != g_adminTicksFrequency.QuadPart)
+		elapsedSeconds = (double)(scrapeTicks.QuadPart - g_previousScrapeTicks) / (double)g_adminTicksFrequency.QuadPart;
+	if (0 < elapsedSeconds)
+		roundsPerSecond = (double)(p_snapshot->roundDuration.count - g_previousNumOfRounds) / elapsedSeconds;
+	g_previousScrapeTicks = scrapeTicks.QuadPart;
+	g_previousNumOfRounds = p_snapshot->roundDuration.count;
+
+	//.....Server state
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_connected_clients Clients currently connected to the Server.\n"
+		"# TYPE bulls_and_cows_connected_clients gauge\nbulls_and_cows_connected_clients %hu\n", *(volatile USHORT*)g_p_adminConnectedClientsNum);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_active_rooms Game Rooms in the SETUP or GUESSING phase.\n"
+		"# TYPE bulls_and_cows_active_rooms gauge\nbulls_and_cows_active_rooms %d\n",
+		((GAME_ROOM_SETUP == roomPhase) || (GAME_ROOM_GUESSING == roomPhase)) ? 1 : 0);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_rounds_total Guessing rounds played.\n"
+		"# TYPE bulls_and_cows_rounds_total counter\nbulls_and_cows_rounds_total %lld\n", p_snapshot->roundDuration.count);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_rounds_per_second Guessing rounds per second since the previous scrape.\n"
+		"# TYPE bulls_and_cows_rounds_per_second gauge\nbulls_and_cows_rounds_per_second %.3f\n", roundsPerSecond);
+
+	//.....Messages
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_messages_sent_total Messages sent, per message type.\n# TYPE bulls_and_cows_messages_sent_total counter\n");
+	for (type = SERVER_MAIN_MENU_NUM; type < NUM_OF_MESSAGE_TYPES; type++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_messages_sent_total{type=\"%s\"} %lld\n", MESSAGE_TYPE_LABELS[type], p_snapshot->messagesSent[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_bytes_sent_total Bytes sent (length prefix included), per message type.\n# TYPE bulls_and_cows_bytes_sent_total counter\n");
+	for (type = SERVER_MAIN_MENU_NUM; type < NUM_OF_MESSAGE_TYPES; type++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_bytes_sent_total{type=\"%s\"} %lld\n", MESSAGE_TYPE_LABELS[type], p_snapshot->bytesSent[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_messages_received_total Messages received, per message type.\n# TYPE bulls_and_cows_messages_received_total counter\n");
+	for (type = SERVER_MAIN_MENU_NUM; type < NUM_OF_MESSAGE_TYPES; type++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_messages_received_total{type=\"%s\"} %lld\n", MESSAGE_TYPE_LABELS[type], p_snapshot->messagesReceived[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_bytes_received_total Bytes received (length prefix included), per message type.\n# TYPE bulls_and_cows_bytes_received_total counter\n");
+	for (type = SERVER_MAIN_MENU_NUM; type < NUM_OF_MESSAGE_TYPES; type++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_bytes_received_total{type=\"%s\"} %lld\n", MESSAGE_TYPE_LABELS[type], p_snapshot->bytesReceived[type]);
+
+	//.....Latencies
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_duration_seconds Message construction & send duration, per message type.\n# TYPE bulls_and_cows_send_duration_seconds summary\n");
+	for (type = SERVER_MAIN_MENU_NUM; type < NUM_OF_MESSAGE_TYPES; type++)
+		appendSummary(&bodyLength, "bulls_and_cows_send_duration_seconds", "type", MESSAGE_TYPE_LABELS[type], &p_snapshot->sendTime[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_parse_duration_seconds Received message translation duration, per message type.\n# TYPE bulls_and_cows_parse_duration_seconds summary\n");
+	for (type = SERVER_MAIN_MENU_NUM; type < NUM_OF_MESSAGE_TYPES; type++)
+		appendSummary(&bodyLength, "bulls_and_cows_parse_duration_seconds", "type", MESSAGE_TYPE_LABELS[type], &p_snapshot->parseTime[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_opponent_wait_seconds Time a Worker thread was blocked on its opponent, per phase.\n# TYPE bulls_and_cows_opponent_wait_seconds summary\n");
+	for (phase = WORKER_PHASE_PAIRING; phase < NUM_OF_WORKER_PHASES; phase++)
+		appendSummary(&bodyLength, "bulls_and_cows_opponent_wait_seconds", "phase", WORKER_PHASE_LABELS[phase], &p_snapshot->opponentWaitTime[phase]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_round_duration_seconds Whole guessing round duration.\n# TYPE bulls_and_cows_round_duration_seconds summary\n");
+	appendSummary(&bodyLength, "bulls_and_cows_round_duration_seconds", NULL, NULL, &p_snapshot->roundDuration);
+
+	//.....Timeouts & denials
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_timeouts_total Timeouts, per Worker phase.\n# TYPE bulls_and_cows_timeouts_total counter\n");
+	for (phase = WORKER_PHASE_ADMISSION; phase < NUM_OF_WORKER_PHASES; phase++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_timeouts_total{phase=\"%s\"} %lld\n", WORKER_PHASE_LABELS[phase], p_snapshot->timeouts[phase]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_admission_denials_total Clients declined with SERVER_DENIED.\n"
+		"# TYPE bulls_and_cows_admission_denials_total counter\nbulls_and_cows_admission_denials_total %lld\n", p_snapshot->admissionDenials);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_invalid_player_numbers_total Initial numbers & guesses the Game Room's variant does not allow (the Client is disconnected).\n"
+		"# TYPE bulls_and_cows_invalid_player_numbers_total counter\nbulls_and_cows_invalid_player_numbers_total %lld\n", p_snapshot->invalidPlayerNumbers);
+
+	//.....Matchmaking
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_matchmaking_total CLIENT_VERSUS requests, per matchmaking outcome.\n# TYPE bulls_and_cows_matchmaking_total counter\n");
+	for (outcome = 0; outcome < NUM_OF_MATCHMAKING_OUTCOMES; outcome++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_matchmaking_total{outcome=\"%s\"} %lld\n", MATCHMAKING_OUTCOME_LABELS[outcome], p_snapshot->matchmakingOutcomes[outcome]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_match_latency_seconds CLIENT_VERSUS received -> opponent found.\n# TYPE bulls_and_cows_match_latency_seconds summary\n");
+	appendSummary(&bodyLength, "bulls_and_cows_match_latency_seconds", NULL, NULL, &p_snapshot->matchLatency);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_matchmaking_waiting Players waiting for an opponent.\n"
+		"# TYPE bulls_and_cows_matchmaking_waiting gauge\nbulls_and_cows_matchmaking_waiting %ld\n", fetchMatchmakingQueueDepth());
+
+	//.....Allocator & queues depths
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_slab_objects_in_use Slab objects handed out & not freed yet, per object type.\n# TYPE bulls_and_cows_slab_objects_in_use gauge\n");
+	for (type = SLAB_MESSAGE; type < NUM_OF_SLAB_OBJECT_TYPES; type++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_slab_objects_in_use{object=\"%s\"} %ld\n", SLAB_OBJECT_TYPE_LABELS[type],
+			slabTotals.allocations[type] - slabTotals.localFrees[type] - slabTotals.remoteFrees[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_slab_chunks_total Heap chunks allocated to grow the slabs, per object type.\n# TYPE bulls_and_cows_slab_chunks_total counter\n");
+	for (type = SLAB_MESSAGE; type < NUM_OF_SLAB_OBJECT_TYPES; type++)
+		appendToResponseBody(&bodyLength, "bulls_and_cows_slab_chunks_total{object=\"%s\"} %ld\n", SLAB_OBJECT_TYPE_LABELS[type], slabTotals.chunksAllocated[type]);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_slab_thread_caches Slab thread caches (one per thread that ever allocated).\n"
+		"# TYPE bulls_and_cows_slab_thread_caches gauge\nbulls_and_cows_slab_thread_caches %ld\n", slabTotals.numOfThreadCaches);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_log_events_pending Log events waiting in the log rings for the formatter thread.\n"
+		"# TYPE bulls_and_cows_log_events_pending gauge\nbulls_and_cows_log_events_pending %ld\n", pendingLogEvents);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_log_events_dropped_total Log events dropped on full log rings.\n"
+		"# TYPE bulls_and_cows_log_events_dropped_total counter\nbulls_and_cows_log_events_dropped_total %ld\n", droppedLogEvents);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queues Connections with a bounded send queue.\n"
+		"# TYPE bulls_and_cows_send_queues gauge\nbulls_and_cows_send_queues %ld\n", sendQueueTotals.numOfQueues);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queue_bytes Unsent bytes in all the send queues.\n"
+		"# TYPE bulls_and_cows_send_queue_bytes gauge\nbulls_and_cows_send_queue_bytes %ld\n", sendQueueTotals.queuedBytes);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queue_frames Unsent frames in all the send queues.\n"
+		"# TYPE bulls_and_cows_send_queue_frames gauge\nbulls_and_cows_send_queue_frames %ld\n", sendQueueTotals.queuedFrames);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queue_max_bytes Unsent bytes in the deepest send queue.\n"
+		"# TYPE bulls_and_cows_send_queue_max_bytes gauge\nbulls_and_cows_send_queue_max_bytes %ld\n", sendQueueTotals.maxQueuedBytes);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queue_evictions_total Slow Clients evicted by their send queue policy.\n"
+		"# TYPE bulls_and_cows_send_queue_evictions_total counter\nbulls_and_cows_send_queue_evictions_total %ld\n", sendQueueTotals.evictions);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queue_parks_total Worker threads parked until their Client read.\n"
+		"# TYPE bulls_and_cows_send_queue_parks_total counter\nbulls_and_cows_send_queue_parks_total %ld\n", sendQueueTotals.parks);
+	appendToResponseBody(&bodyLength, "# HELP bulls_and_cows_send_queue_coalesced_frames_total SERVER_GAME_RESULTS frames removed before being sent.\n"
+		"# TYPE bulls_and_cows_send_queue_coalesced_frames_total counter\nbulls_and_cows_send_queue_coalesced_frames_total %ld\n", sendQueueTotals.coalescedFrames);
+
+	return bodyLength;
+}
+
+static void appendSummary(size_t* p_bodyLength, const char* p_metricName, const char* p_labelName, const char* p_labelValue,
+	const metricsHistogramSnapshot* p_histogram)
+{
+	char labels[LOG_FORMATTED_EVENT_LEN] = { 0 };
+	int q = 0;
+
+	if (NULL != p_labelName) _snprintf_s(labels, sizeof(labels), _TRUNCATE, "%s=\"%s\"", p_labelName, p_labelValue);
+
+	for (q = 0; q < (int)(sizeof(SERVED_PERCENTILES) / sizeof(SERVED_PERCENTILES[0])); q++)
+		appendToResponseBody(p_bodyLength, "%s{%s%squantile=\"%s\"} %.6f\n", p_metricName, labels, (NULL != p_labelName) ? "," : "",
+			SERVED_QUANTILE_LABELS[q], (double)fetchHistogramPercentile(p_histogram, SERVED_PERCENTILES[q]) / MICROSECONDS_IN_SECOND);
+
+	if (NULL != p_labelName) {
+		appendToResponseBody(p_bodyLength, "%s_sum{%s} %.6f\n", p_metricName, labels, (double)p_histogram->sumMicroseconds / MICROSECONDS_IN_SECOND);
+		appendToResponseBody(p_bodyLength, "%s_count{%s} %lld\n", p_metricName, labels, p_histogram->count);
+	}
+	else {
+		appendToResponseBody(p_bodyLength, "%s_sum %.6f\n", p_metricName, (double)p_histogram->sumMicroseconds / MICROSECONDS_IN_SECOND);
+		appendToResponseBody(p_bodyLength, "%s_count %lld\n", p_metricName, p_histogram->count);
+	}
+}
+
+static void appendToResponseBody(size_t* p_bodyLength, const char* p_format, ...)
+{
+	va_list arguments;
+	int appendedLength = 0;
+
+	if (ADMIN_RESPONSE_BUFFER_SIZE - 1 <= *p_bodyLength) return; //Already full
+
+	va_start(arguments, p_format);
+	appendedLength = _vsnprintf_s(g_p_adminResponseBody + *p_bodyLength, ADMIN_RESPONSE_BUFFER_SIZE - *p_bodyLength, _TRUNCATE, p_format, arguments);
+	va_end(arguments);
+
+	//A negative length means the text was truncated & the buffer is full
+	*p_bodyLength = (0 > appendedLength) ? ADMIN_RESPONSE_BUFFER_SIZE - 1 : *p_bodyLength + appendedLength;
+}
+
+static BOOL sendWholeBuffer(SOCKET s_socket, const char* p_buffer, size_t length)
+{
+	int sentLength = 0;
+
+	while (0 < length) {
+		if (SOCKET_ERROR == (sentLength = send(s_socket, p_buffer, (int)length, 0))) {
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to send an admin response", WSAGetLastError(), 0);
+			return STATUS_CODE_FAILURE;
+		}
+		p_buffer += sentLength;
+		length -= sentLength;
+	}
+	return STATUS_CODE_SUCCESS;
+}
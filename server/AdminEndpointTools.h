@@ -0,0 +1,41 @@
+/* AdminEndpointTools.h
+------------------------------------------------------------------
+	Module Description - header module for AdminEndpointTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __ADMIN_ENDPOINT_TOOLS_H__
+#define __ADMIN_ENDPOINT_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function creates the admin listening socket, bound to SERVER_ADDRESS_STR & the input port, allocates the scrape buffers
+/// and starts the admin thread, which answers every HTTP request with the live telemetry in the Prometheus text format.
+/// Must be called after Winsock was initialized & after the inputs were allocated. The inputs are only read (without their Mutex)
+/// </summary>
+/// <param name="unsigned short adminPortNumber - port number 1 - 65535 (the game port + ADMIN_ENDPOINT_PORT_OFFSET)"></param>
+/// <param name="USHORT* p_currentNumOfConnectedClients - pointer to the connected Clients count"></param>
+/// <param name="gameRoom* p_gameRoom - pointer to the Game Room"></param>
+/// <returns>True if succeeded. False otherwise (nothing is left allocated)</returns>
+BOOL startAdminEndpoint(unsigned short adminPortNumber, USHORT* p_currentNumOfConnectedClients, gameRoom* p_gameRoom);
+
+/// <summary>
+/// Description - This function stops the admin thread, closes the admin listening socket & frees the scrape buffers.
+/// Must be called before the inputs of startAdminEndpoint(.) are freed. Does nothing if the endpoint was not started
+/// </summary>
+void stopAdminEndpoint();
+
+
+#endif //__ADMIN_ENDPOINT_TOOLS_H__
@@ -35,13 +35,12 @@
 #include "MemoryHandling.h"
 #include "ServerClientsTools.h"
 #include "MessagesTransferringTools.h"
+#include "EventLoggingTools.h"
 
 // Constants --------------------------------------------------------------------
 static const BOOL STATUS_CODE_FAILURE = FALSE;
 static const BOOL STATUS_CODE_SUCCESS = TRUE;
 
-static const int SINGLE_OBJECT = 1;
-
 //Mutex
 static const long GAME_SESSION_FILE_MUTEX_OWNERSHIP_TIMEOUT = 2200; // 2.2 Seconds - GameSession.txt timeout
 static const BOOL MUTEX_OWNERSHIP_RELEASE_FAILED = 0;
@@ -61,8 +60,16 @@ static const BOOL STATUS_FILE_WRITING_FAILED = (BOOL)0;
 /// <param name="DWORD creationDisposition - Handle creation method - OPEN EXISTING, CREATE ALWAYS etc."></param>
 /// <param name="int playerId - which player entered, 1st or 2nd, considering some phase of the communication - for printing purposes"></param>
 /// <param name="HANDLE* p_h_errorEvent - pointer to 'ERROR' event Handle"></param>
-/// <returns>pointer to mem alloc. Handle to file, or NULL if failed</returns>
-static HANDLE* openFileForReadingAndWritingWithErrorEventScenario(char* p_filePath, DWORD creationDisposition, int playerId, HANDLE* p_h_errorEvent);
+/// <param name="HANDLE* p_h_fileHandle - pointer to the caller's (stack) Handle that will receive the Handle to file"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL openFileForReadingAndWritingWithErrorEventScenario(char* p_filePath, DWORD creationDisposition, int playerId, HANDLE* p_h_errorEvent, HANDLE* p_h_fileHandle);
+
+/// <summary>
+/// Description - This function closes a Handle to "GameSession.txt" opened by openFileForReadingAndWritingWithErrorEventScenario(.). 
+/// Unlike closeHandleProcedure(.), it doesn't free the Handle pointer, since the Handle lives on the caller's stack
+/// </summary>
+/// <param name="HANDLE* p_h_gameSessionFile - pointer to the Handle to GameSession.txt file"></param>
+static void closeGameSessionFileHandle(HANDLE* p_h_gameSessionFile);
 
 
 /// <summary>
@@ -84,8 +91,10 @@ static BOOL writeToFile(HANDLE* p_h_gameSessionsFile, LPTSTR p_dataString, DWORD
 /// then read the data into a buffer.
 /// </summary>
 /// <param name="HANDLE* p_h_gameSessionsFile - pointer to the Handle to GameSession.txt file"></param>
-/// <returns>pointer to the buffer containing the read data, which may be the players names, their initial numbers or their guess numbers</returns>
-static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile);
+/// <param name="LPSTR p_readDataString - caller's buffer that will contain the read data, which may be the players names, their initial numbers or their guess numbers"></param>
+/// <param name="DWORD readDataBufferSize - size of the caller's buffer in bytes, including the '\0' - longer data is truncated"></param>
+/// <returns>True if successful,   False otherwise</returns>
+static BOOL readFromFile(HANDLE* p_h_gameSessionsFile, LPSTR p_readDataString, DWORD readDataBufferSize);
 
 
 // Functions definitions -------------------------------------------------------
@@ -96,62 +105,65 @@ static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile);
 
 BOOL firstToReachTheFileWriteWrapper(workingThreadPackage* p_threadInputs, char* p_dataToBeTransferredToOtherPlayerBuffer, DWORD creationDisposition)
 {
-	HANDLE* p_h_gameSessionFile = NULL;
+	HANDLE h_gameSessionFile = NULL;
 	//Input integrity validation
 	if ((NULL == p_threadInputs) || (NULL == p_dataToBeTransferredToOtherPlayerBuffer)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return STATUS_CODE_FAILURE;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
 	}
 
-	//Allocate dynamic memory for a Handle object
-	if (NULL == (p_h_gameSessionFile = openFileForReadingAndWritingWithErrorEventScenario(
+	//Open a Handle (on the stack) to the file
+	if (STATUS_CODE_FAILURE == openFileForReadingAndWritingWithErrorEventScenario(
 		GAME_SESSION_PATH,					/* "GameSession.txt" relative file path */
 		creationDisposition,				/* open the pre-created "GameSession.txt" file or create it */
 		1,									/* this is a wrapper for writing for the first player that accesses the file this round */
-		p_threadInputs->p_h_errorEvent))) {	/* "ERROR" event handle pointer */
+		p_threadInputs->p_h_errorEvent,		/* "ERROR" event handle pointer */
+		&h_gameSessionFile)) {				/* output Handle */
 		return STATUS_CODE_FAILURE;
 	}
 
 	//Perform writing the buffer representing data concerning the game's data e.g. players names, players guesses
 	if (STATUS_CODE_FAILURE == writeToFile(
-		p_h_gameSessionFile,													/*"GameSession.txt" file handle*/
+		&h_gameSessionFile,														/*"GameSession.txt" file handle*/
 		(LPSTR)p_dataToBeTransferredToOtherPlayerBuffer,						/*buffer pointer*/
 		(DWORD)fetchStringLength(p_dataToBeTransferredToOtherPlayerBuffer))) {	/*length of the data in buffer*/
-		//maybe free(p_dataToBeTransferredToOtherPlayerBuffer);
+		closeGameSessionFileHandle(&h_gameSessionFile);
 		return STATUS_CODE_FAILURE;
 	}
 
 	//Close the "GameSession.txt" file handle
-	closeHandleProcedure(p_h_gameSessionFile);
+	closeGameSessionFileHandle(&h_gameSessionFile);
 	return STATUS_CODE_SUCCESS;
 }
 
-char* firstToReachTheFileReadWrapper(workingThreadPackage* p_threadInputs)
+char* firstToReachTheFileReadWrapper(workingThreadPackage* p_threadInputs, char* p_readDataBuffer, int readDataBufferSize)
 {
-	HANDLE* p_h_gameSessionFile = NULL;
-	LPSTR p_readDataBufferFromOtherPlayer = NULL;
+	HANDLE h_gameSessionFile = NULL;
 	//Input integrity validation
-	if (NULL == p_threadInputs) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+	if ((NULL == p_threadInputs) || (NULL == p_readDataBuffer) || (0 >= readDataBufferSize)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return NULL;
 	}
 
-	//Allocate dynamic memory for a Handle object
-	if (NULL == (p_h_gameSessionFile = openFileForReadingAndWritingWithErrorEventScenario(
+	//Open a Handle (on the stack) to the file
+	if (STATUS_CODE_FAILURE == openFileForReadingAndWritingWithErrorEventScenario(
 		GAME_SESSION_PATH,					/* "GameSession.txt" relative file path */
 		OPEN_EXISTING,						/* open the pre-created "GameSession.txt" file */
 		1,									/* this is a wrapper for reading for the first player that accesses the file this round (meaning after write-read-write operations have already happened) */
-		p_threadInputs->p_h_errorEvent))) {	/* "ERROR" event handle pointer */
+		p_threadInputs->p_h_errorEvent,		/* "ERROR" event handle pointer */
+		&h_gameSessionFile)) {				/* output Handle */
 		return NULL;
 	}
 
-	//Perform writing the buffer representing data concerning the game's data e.g. players names, players guesses
-	if (NULL == (p_readDataBufferFromOtherPlayer = readFromFile(p_h_gameSessionFile	/*"GameSession.txt" file handle*/)))
+	//Perform reading the data concerning the game's data e.g. players names, players guesses into the caller's buffer
+	if (STATUS_CODE_FAILURE == readFromFile(&h_gameSessionFile, (LPSTR)p_readDataBuffer, (DWORD)readDataBufferSize)) {
+		closeGameSessionFileHandle(&h_gameSessionFile);
 		return NULL;
+	}
 	
 
 	//Close the "GameSession.txt" file handle
-	closeHandleProcedure(p_h_gameSessionFile);
+	closeGameSessionFileHandle(&h_gameSessionFile);
 	//Return the read buffer string
-	return (char*)p_readDataBufferFromOtherPlayer;
+	return p_readDataBuffer;
 }
 
 
@@ -159,21 +171,21 @@ char* firstToReachTheFileReadWrapper(workingThreadPackage* p_threadInputs)
 
 
 
-char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInputs, char* p_dataToBeTransferredToOtherPlayerBuffer)
+char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInputs, char* p_dataToBeTransferredToOtherPlayerBuffer, char* p_readDataBuffer, int readDataBufferSize)
 {
-	HANDLE* p_h_gameSessionFile = NULL;
-	LPSTR p_readDataBufferFromOtherPlayer = NULL;
+	HANDLE h_gameSessionFile = NULL;
 	//Input integrity validation
-	if ((NULL == p_threadInputs) || (NULL == p_dataToBeTransferredToOtherPlayerBuffer)) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return NULL;
+	if ((NULL == p_threadInputs) || (NULL == p_dataToBeTransferredToOtherPlayerBuffer) || (NULL == p_readDataBuffer) || (0 >= readDataBufferSize)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return NULL;
 	}
 
-	//Allocate dynamic memory for a Handle object
-	if (NULL == (p_h_gameSessionFile = openFileForReadingAndWritingWithErrorEventScenario(
+	//Open a Handle (on the stack) to the file
+	if (STATUS_CODE_FAILURE == openFileForReadingAndWritingWithErrorEventScenario(
 		GAME_SESSION_PATH,					/* "GameSession.txt" relative file path */
 		OPEN_EXISTING,						/* open the pre-created "GameSession.txt" file */
 		0,									/* this is a wrapper for reading & then writing for the second player that accesses the file this round */
-		p_threadInputs->p_h_errorEvent))) {	/* "ERROR" event handle pointer */
+		p_threadInputs->p_h_errorEvent,		/* "ERROR" event handle pointer */
+		&h_gameSessionFile)) {				/* output Handle */
 		return NULL;
 	}
 
@@ -181,18 +193,19 @@ char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInp
 
 
 	//First, it is needed to read the data written by the first player
-	//Perform writing the buffer representing data concerning the game's data e.g. players names, players guesses
-	if (NULL == (p_readDataBufferFromOtherPlayer = readFromFile(p_h_gameSessionFile	/*"GameSession.txt" file handle*/)))
+	//Perform reading the data concerning the game's data e.g. players names, players guesses into the caller's buffer
+	if (STATUS_CODE_FAILURE == readFromFile(&h_gameSessionFile, (LPSTR)p_readDataBuffer, (DWORD)readDataBufferSize)) {
+		closeGameSessionFileHandle(&h_gameSessionFile);
 		return NULL;
+	}
 
 	//Second, write to the file the data we need to transfer to the first player, by RUNNING OVER the data the first player wrote
 	//Perform writing the buffer representing data concerning the game's data e.g. players names, players guesses
 		if (STATUS_CODE_FAILURE == writeToFile(
-			p_h_gameSessionFile,													/*"GameSession.txt" file handle*/
+			&h_gameSessionFile,														/*"GameSession.txt" file handle*/
 			(LPSTR)p_dataToBeTransferredToOtherPlayerBuffer,						/*buffer pointer*/
 			(DWORD)fetchStringLength(p_dataToBeTransferredToOtherPlayerBuffer))) {	/*length of the data in buffer*/
-			//operation failed -> free the data received from 1st player
-			free(p_readDataBufferFromOtherPlayer);
+			closeGameSessionFileHandle(&h_gameSessionFile);
 			return NULL;
 		}
 
@@ -200,8 +213,8 @@ char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInp
 
 
 	//Close the "GameSession.txt" file handle
-	closeHandleProcedure(p_h_gameSessionFile);
-	return p_readDataBufferFromOtherPlayer;
+	closeGameSessionFileHandle(&h_gameSessionFile);
+	return p_readDataBuffer;
 
 }
 
@@ -210,24 +223,25 @@ char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInp
 
 BOOL fileTruncationForWhenGameEnds(workingThreadPackage* p_threadInputs)
 {
-	HANDLE* p_h_gameSessionFile = NULL;
+	HANDLE h_gameSessionFile = NULL;
 	//Input integrity validation
 	if (NULL == p_threadInputs) {
-		printf("Error: Bad inputs to function: %s\n", __func__); return STATUS_CODE_FAILURE;
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
 	}
 
-	//Allocate dynamic memory for a Handle object and open the file in CREATE_ALWAYS to erase its contents!!!
-	if (NULL == (p_h_gameSessionFile = openFileForReadingAndWritingWithErrorEventScenario(
+	//Open a Handle (on the stack) to the file in CREATE_ALWAYS to erase its contents!!!
+	if (STATUS_CODE_FAILURE == openFileForReadingAndWritingWithErrorEventScenario(
 		GAME_SESSION_PATH,					/* "GameSession.txt" relative file path */
 		CREATE_ALWAYS,						/* use CREATE_ALWAYS to erase to contents of the file for the following game session */
 		1,									/* don't care (according to moodle instructions clarifications) */
-		p_threadInputs->p_h_errorEvent))) {	/* "ERROR" event handle pointer */
+		p_threadInputs->p_h_errorEvent,		/* "ERROR" event handle pointer */
+		&h_gameSessionFile)) {				/* output Handle */
 		return STATUS_CODE_FAILURE;
 	}
 
 
 	//Immediately close the "GameSession.txt" file handle after creating it. It has no need without creating it for truncating
-	closeHandleProcedure(p_h_gameSessionFile);
+	closeGameSessionFileHandle(&h_gameSessionFile);
 	//Return the read buffer string
 	return STATUS_CODE_SUCCESS;
 }
@@ -238,22 +252,11 @@ BOOL fileTruncationForWhenGameEnds(workingThreadPackage* p_threadInputs)
 
 //......................................Static functions..........................................
 
-static HANDLE* openFileForReadingAndWritingWithErrorEventScenario(char* p_filePath, DWORD creationDisposition, int playerId, HANDLE* p_h_errorEvent)
+static BOOL openFileForReadingAndWritingWithErrorEventScenario(char* p_filePath, DWORD creationDisposition, int playerId, HANDLE* p_h_errorEvent, HANDLE* p_h_fileHandle)
 {
-	HANDLE* p_h_fileHandle = NULL;
-	//Assert
+	//Asserts
 	assert(NULL != p_filePath);
-
-	//Allocating dynamic memory (Heap) for a file Handle pointer
-	if (NULL == (p_h_fileHandle = (HANDLE*)calloc(sizeof(HANDLE), SINGLE_OBJECT))) {
-		printf("Error: Failed to allocate memory for a Handle to file '%s'.\n", p_filePath);
-		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*p_h_errorEvent)) {  //reason: Second Player Event was not set on time by First Player
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
-		}
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		return  NULL;
-	}
+	assert(NULL != p_h_fileHandle);
 
 	//Open file for reading
 	*p_h_fileHandle = CreateFile(
@@ -267,18 +270,28 @@ static HANDLE* openFileForReadingAndWritingWithErrorEventScenario(char* p_filePa
 	);
 	//File Handle creation validation
 	if (INVALID_HANDLE_VALUE == *p_h_fileHandle) {
-		if (playerId == 1) printf("Error: Failed to create a Handle to GameSession.txt file by creating the file by 1st Player, with code: %d.\n", GetLastError());
-		else printf("Error: Failed to create a Handle to GameSession.txt file by opening the file by 2nd Player, with code: %d.\n", GetLastError());
+		if (playerId == 1) LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create a Handle to GameSession.txt file by creating the file by 1st Player", GetLastError(), 0);
+		else LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create a Handle to GameSession.txt file by opening the file by 2nd Player", GetLastError(), 0);
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*p_h_errorEvent)) {  //reason: Second Player Event was not set on time by First Player
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 		}
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		free(p_h_fileHandle);
-		return NULL;
+		*p_h_fileHandle = NULL;
+		return STATUS_CODE_FAILURE;
 	}
-	//Returning a pointer to the created handle to file
-	return p_h_fileHandle;
+	//The caller's Handle now holds the created handle to file
+	return STATUS_CODE_SUCCESS;
+}
+
+static void closeGameSessionFileHandle(HANDLE* p_h_gameSessionFile)
+{
+	//Assert
+	assert(NULL != p_h_gameSessionFile);
+
+	if (FALSE == CloseHandle(*p_h_gameSessionFile)) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed close handle", GetLastError(), 0);
+	}
+	*p_h_gameSessionFile = NULL;
 }
 
 
@@ -304,8 +317,7 @@ static BOOL writeToFile(HANDLE* p_h_gameSessionsFile, LPTSTR p_dataString, DWORD
 	//Validate Handle pointing succeeded...
 	if (INVALID_SET_FILE_POINTER == retValSet) {
 		//Initial byte position of wasn't found
-		printf("Error: Failed to reset the file Handle pointer position for printing, with code: %d.\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to reset the file Handle pointer position for printing", GetLastError(), 0);
 		return STATUS_CODE_FAILURE;
 	}
 	//Writing to file the size of the data at the first 4 bytes at the desired position
@@ -318,8 +330,7 @@ static BOOL writeToFile(HANDLE* p_h_gameSessionsFile, LPTSTR p_dataString, DWORD
 	);
 	if (STATUS_FILE_WRITING_FAILED == retValWrite) {
 		//Failed to write the number of bytes to be written to file
-		printf("Error: Failed to write the number of bytes to be written to the file Handle. Exited with code: %d\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to write the number of bytes to be written to the file Handle", GetLastError(), 0);
 		return STATUS_CODE_FAILURE;
 	}
 
@@ -339,8 +350,7 @@ static BOOL writeToFile(HANDLE* p_h_gameSessionsFile, LPTSTR p_dataString, DWORD
 	//Validate Handle pointing succeeded...
 	if (INVALID_SET_FILE_POINTER == retValSet) {
 		//Initial byte position of wasn't found
-		printf("Error: Failed to reset the file Handle pointer position for printing, with code: %d.\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to reset the file Handle pointer position for printing", GetLastError(), 0);
 		return STATUS_CODE_FAILURE;
 	}
 
@@ -355,8 +365,7 @@ static BOOL writeToFile(HANDLE* p_h_gameSessionsFile, LPTSTR p_dataString, DWORD
 	);
 	if (STATUS_FILE_WRITING_FAILED == retValWrite) {
 		//Failed to write the needed memory from the file
-		printf("Error: Failed to write to the file Handle. Exited with code: %d\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to write to the file Handle", GetLastError(), 0);
 		return STATUS_CODE_FAILURE;
 	}
 
@@ -365,13 +374,14 @@ static BOOL writeToFile(HANDLE* p_h_gameSessionsFile, LPTSTR p_dataString, DWORD
 }
 
 
-static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile)
+static BOOL readFromFile(HANDLE* p_h_gameSessionsFile, LPSTR p_readDataString, DWORD readDataBufferSize)
 {
 	DWORD retValSet = 0, numberOfBytesRead = 0, totalStringSizeInBytes = 0;
 	BOOL retValWrite = FALSE;
-	LPTSTR p_readDataString = NULL;
 	//Asserts
 	assert(p_h_gameSessionsFile != NULL);
+	assert(p_readDataString != NULL);
+	assert(0 < readDataBufferSize);
 
 	/*.........................*/
 	/* Read the size of buffer */
@@ -387,9 +397,8 @@ static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile)
 	//Validate Handle pointing succeeded...
 	if (INVALID_SET_FILE_POINTER == retValSet) {
 		//Initial byte position of wasn't found
-		printf("Error: Failed to reset the file Handle pointer position for printing, with code: %d.\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		return NULL;
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to reset the file Handle pointer position for printing", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
 	}
 	//Reading from file the size of the data at the first 4 bytes at the desired position
 	retValWrite = ReadFile(
@@ -401,18 +410,13 @@ static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile)
 	);
 	if (STATUS_FILE_WRITING_FAILED == retValWrite) {
 		//Failed to write the number of bytes to be written to file
-		printf("Error: Failed to read the number of bytes to be read to the file Handle. Exited with code: %d\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		return NULL;
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to read the number of bytes to be read to the file Handle", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
 	}
 
 
-	//Allocating dynamic memory (Heap) for a buffer data(string)
-	if (NULL == (p_readDataString = (TCHAR*)calloc(sizeof(TCHAR), totalStringSizeInBytes + 1))) {
-		printf("Error: Failed to allocate memory for a the buffer that will contain the data that is supposed to be read,.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		return  NULL;
-	}
+	//The data is read into the caller's (fixed size) buffer - longer data is truncated, keeping room for the '\0'
+	if (totalStringSizeInBytes > readDataBufferSize - 1) totalStringSizeInBytes = readDataBufferSize - 1;
 
 	/*.........................*/
 	/* Read the data in buffer */
@@ -428,9 +432,8 @@ static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile)
 	//Validate Handle pointing succeeded...
 	if (INVALID_SET_FILE_POINTER == retValSet) {
 		//Initial byte position of wasn't found
-		printf("Error: Failed to reset the file Handle pointer position for reading, with code: %d.\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		return NULL;
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to reset the file Handle pointer position for reading", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
 	}
 
 
@@ -444,14 +447,13 @@ static LPSTR readFromFile(HANDLE* p_h_gameSessionsFile)
 	);
 	if (STATUS_FILE_WRITING_FAILED == retValWrite) {
 		//Failed to read the needed memory from the file
-		printf("Error: Failed to read to the file Handle. Exited with code: %d\n", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-		return NULL;
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to read to the file Handle", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
 	}
 
 
-	*(p_readDataString + totalStringSizeInBytes) = '\0'; //Assuring it is a string
+	*(p_readDataString + numberOfBytesRead) = '\0'; //Assuring it is a string
 
 	//Reading the buffer from file was successful...
-	return p_readDataString;
+	return STATUS_CODE_SUCCESS;
 }
@@ -38,8 +38,10 @@ BOOL firstToReachTheFileWriteWrapper(workingThreadPackage* p_threadInputs, char*
 /// It is named "1st Player" because it indicates the first ARRIVER to the file accessing current phase. 
 /// </summary>
 /// <param name="workingThreadPackage* p_threadInputs - current threads inputs - Pointers, Handles, Socket"></param>
-/// <returns>pointer to the read buffer of data transferred by the second ARRIVER player if successful, or NULL if failure taken place</returns>
-char* firstToReachTheFileReadWrapper(workingThreadPackage* p_threadInputs);
+/// <param name="char* p_readDataBuffer - caller's buffer the data is read into (e.g. one of the package's inline 'playerNames'\'playerNumbers')"></param>
+/// <param name="int readDataBufferSize - size of the caller's buffer in bytes, including the '\0' - longer data is truncated"></param>
+/// <returns>p_readDataBuffer holding the data transferred by the second ARRIVER player if successful, or NULL if failure taken place</returns>
+char* firstToReachTheFileReadWrapper(workingThreadPackage* p_threadInputs, char* p_readDataBuffer, int readDataBufferSize);
 
 ///'CHECK'
 BOOL firstToReachTheFileReadWrapperWithMutexLockAndRelease(workingThreadPackage* p_threadInputs, int dataTypeBit);
@@ -52,8 +54,10 @@ BOOL firstToReachTheFileReadWrapperWithMutexLockAndRelease(workingThreadPackage*
 /// </summary>
 /// <param name="workingThreadPackage* p_threadInputs - current threads inputs - Pointers, Handles, Socket"></param>
 /// <param name="char* p_dataToBeTransferredToOtherPlayerBuffer - buffer of bytes meant to be written to the file after finishing reading"></param>
-/// <returns>pointer to the read buffer of data transferred by the first ARRIVER player if successful, or NULL if failure taken place</returns>
-char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInputs, char* p_dataToBeTransferredToOtherPlayerBuffer);
+/// <param name="char* p_readDataBuffer - caller's buffer the data is read into (e.g. one of the package's inline 'playerNames'\'playerNumbers')"></param>
+/// <param name="int readDataBufferSize - size of the caller's buffer in bytes, including the '\0' - longer data is truncated"></param>
+/// <returns>p_readDataBuffer holding the data transferred by the first ARRIVER player if successful, or NULL if failure taken place</returns>
+char* secondToReachTheFileReadThenWriteWrapper(workingThreadPackage* p_threadInputs, char* p_dataToBeTransferredToOtherPlayerBuffer, char* p_readDataBuffer, int readDataBufferSize);
 
 
 
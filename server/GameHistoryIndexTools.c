@@ -0,0 +1,542 @@
+/* GameHistoryIndexTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the game history index - a file
+		mapped to memory that holds every finished game of the game journal, so
+		a player's latest games & win rate are read in microseconds, without a
+		lock & without reading the journal. The file holds a record per player
+		name (an open addressing table keyed by the name's hash, with the
+		player's counts & its latest entry) and columns of entries - a game is
+		an entry per player, linked to the player's previous entry. A folding
+		thread reads only the journal records appended since the last fold
+		(the folded length is kept in the file) every
+		GAME_HISTORY_FOLD_INTERVAL_MS, so the Server maps the existing file
+		when it starts instead of rebuilding it. The folding thread is the only
+		writer: entries are written before they are linked, and a player's
+		record is written between two increments of its version, which the
+		readers check (sequence lock).
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "GameHistoryIndexTools.h"
+#include "ServerClientsTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const ULONG FNV_OFFSET_BASIS = 2166136261UL;
+static const ULONG FNV_PRIME = 16777619UL;
+static const DWORD FOLDING_THREAD_EXIT_TIMEOUT = 5000; // 5 Seconds
+static const int OPENER = 0;
+static const int JOINER = 1;
+
+// Global variables ------------------------------------------------------------
+//The index file, its mapping & view
+static HANDLE g_h_historyIndexFile = INVALID_HANDLE_VALUE;
+static HANDLE g_h_historyIndexMapping = NULL;
+static char* g_p_historyIndexView = NULL;
+//The view's parts - the header, the players records & the entries columns
+static gameHistoryIndexHeader* g_p_historyHeader = NULL;
+static gameHistoryPlayer* g_p_historyPlayers = NULL;
+static LONGLONG* g_p_entryGameIds = NULL;
+static LONGLONG* g_p_entryTimestamps = NULL;
+static LONG* g_p_entryPreviousEntries = NULL;
+static SHORT* g_p_entryNumOfRounds = NULL;
+static char* g_p_entryOutcomes = NULL;
+static char (*g_p_entryOpponentNames)[MAX_PLAYER_NAME_LEN + 1] = NULL;
+//Folding - the journal, the games folded at the moment, the read buffer, the folding thread & its stop Event
+static const char* g_p_historyJournalPath = NULL;
+static foldedGame g_foldedGames[GAME_HISTORY_MAX_OPEN_GAMES];
+static gameJournalRecord* g_p_foldBuffer = NULL;
+static HANDLE g_h_historyFoldingThread = NULL;
+static HANDLE g_h_historyFoldingStopEvent = NULL;
+static BOOL g_isIndexFullReported = FALSE;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function lays the index parts out in a view (every part starts on a cache line), or only computes the view's size
+/// </summary>
+/// <param name="char* p_view - the mapped view, or NULL to compute the size only"></param>
+/// <returns>the size of the index file, in bytes</returns>
+static SIZE_T layOutGameHistoryIndex(char* p_view);
+
+/// <summary>
+/// Description - This function empties the index - no player, no entry, nothing of the journal folded
+/// </summary>
+static void resetGameHistoryIndex();
+
+/// <summary>
+/// Description - This function hashes a player name (FNV-1a)
+/// </summary>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <returns>the name's hash</returns>
+static ULONG hashPlayerName(const char* p_playerName);
+
+/// <summary>
+/// Description - This function finds a player's record (linear probing). Readers call it without a lock - a record being written is waited for
+/// </summary>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <returns>pointer to the player's record, or NULL if the player has none</returns>
+static gameHistoryPlayer* findGameHistoryPlayer(const char* p_playerName);
+
+/// <summary>
+/// Description - This function finds a player's record and adds it if missing. Called by the folding thread only
+/// </summary>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <returns>pointer to the player's record, or NULL if the players table is full</returns>
+static gameHistoryPlayer* findOrAddGameHistoryPlayer(const char* p_playerName);
+
+/// <summary>
+/// Description - Folding thread routine: folds the new journal records every GAME_HISTORY_FOLD_INTERVAL_MS, until the stop Event is signaled
+/// </summary>
+/// <param name="LPVOID lpParam - not used"></param>
+/// <returns>True if every fold succeeded. False otherwise</returns>
+static BOOL WINAPI historyFoldingThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function reads the journal from the folded length to its end, whole records only, and folds them. A record that is not
+/// a journal record (not fully written yet) ends the fold - it is read again by the next fold
+/// </summary>
+/// <returns>True if succeeded (or the journal doesn't exist yet). False otherwise</returns>
+static BOOL foldNewJournalRecords();
+
+/// <summary>
+/// Description - This function folds a single journal record: a SESSION record starts over the epochs, a PAIRING record opens a game,
+/// ROUND records are counted, and an OUTCOME record adds the game's entries
+/// </summary>
+/// <param name="const gameJournalRecord* p_record - the journal record"></param>
+static void foldJournalRecord(const gameJournalRecord* p_record);
+
+/// <summary>
+/// Description - This function adds a player's entry of a finished game, links it to the player's previous entry, and updates the player's record
+/// </summary>
+/// <param name="const foldedGame* p_game - the finished game"></param>
+/// <param name="int player - OPENER or JOINER"></param>
+/// <param name="ratingOutcomes outcome - the player's outcome"></param>
+/// <param name="LONGLONG timestamp - the game's end"></param>
+static void addGameHistoryEntry(const foldedGame* p_game, int player, ratingOutcomes outcome, LONGLONG timestamp);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeGameHistoryIndex(const char* p_indexPath, const char* p_journalPath)
+{
+	WIN32_FILE_ATTRIBUTE_DATA journalAttributes;
+	LARGE_INTEGER indexFileSize;
+	SIZE_T indexSize = 0;
+	DWORD threadId = 0;
+	BOOL isValidIndex = FALSE;
+	//Input integrity validation
+	if ((NULL == p_indexPath) || (NULL == p_journalPath)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+	g_p_historyJournalPath = p_journalPath;
+	memset(g_foldedGames, 0, sizeof(g_foldedGames));
+	g_isIndexFullReported = FALSE;
+
+	//Map the index file - a smaller (or new) file is extended by the mapping
+	indexSize = layOutGameHistoryIndex(NULL);
+	if (INVALID_HANDLE_VALUE == (g_h_historyIndexFile = CreateFile(p_indexPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to open the game history index file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	isValidIndex = (GetFileSizeEx(g_h_historyIndexFile, &indexFileSize) && ((LONGLONG)indexSize == indexFileSize.QuadPart));
+	if ((NULL == (g_h_historyIndexMapping = CreateFileMapping(g_h_historyIndexFile, NULL, PAGE_READWRITE,
+			(DWORD)((ULONGLONG)indexSize >> 32), (DWORD)(indexSize & 0xFFFFFFFF), NULL))) ||
+		(NULL == (g_p_historyIndexView = (char*)MapViewOfFile(g_h_historyIndexMapping, FILE_MAP_ALL_ACCESS, 0, 0, indexSize)))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to map the game history index file", GetLastError(), 0);
+		destroyGameHistoryIndex();
+		return STATUS_CODE_FAILURE;
+	}
+	layOutGameHistoryIndex(g_p_historyIndexView);
+
+	//Rebuild an index of other sizes, or of a journal that was replaced since
+	isValidIndex = isValidIndex && (GAME_HISTORY_INDEX_MAGIC == g_p_historyHeader->magic) &&
+		(GAME_HISTORY_MAX_PLAYERS == g_p_historyHeader->maxPlayers) && (GAME_HISTORY_MAX_ENTRIES == g_p_historyHeader->maxEntries);
+	if (GetFileAttributesEx(p_journalPath, GetFileExInfoStandard, &journalAttributes))
+		isValidIndex = isValidIndex &&
+			(g_p_historyHeader->journalOffset <= (LONGLONG)(((ULONGLONG)journalAttributes.nFileSizeHigh << 32) | journalAttributes.nFileSizeLow));
+	else isValidIndex = isValidIndex && (0 == g_p_historyHeader->journalOffset);
+	if (FALSE == isValidIndex) resetGameHistoryIndex();
+
+	//Fold what was journaled since the last fold, before any Client connects
+	if (NULL == (g_p_foldBuffer = (gameJournalRecord*)calloc(sizeof(gameJournalRecord), GAME_JOURNAL_RING_CAPACITY))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the game history fold buffer", 0, 0);
+		destroyGameHistoryIndex();
+		return STATUS_CODE_FAILURE;
+	}
+	foldNewJournalRecords();
+
+	//Start the folding thread
+	if (NULL == (g_h_historyFoldingStopEvent = CreateEvent(NULL, TRUE, FALSE, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the game history folding stop Event", GetLastError(), 0);
+		destroyGameHistoryIndex();
+		return STATUS_CODE_FAILURE;
+	}
+	if (INVALID_HANDLE_VALUE == (g_h_historyFoldingThread = createThreadSimple((LPTHREAD_START_ROUTINE)historyFoldingThreadRoutine, NULL, &threadId))) {
+		g_h_historyFoldingThread = NULL;
+		destroyGameHistoryIndex();
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyGameHistoryIndex()
+{
+	//Stop the folding thread, then fold the journal's last records
+	if (NULL != g_h_historyFoldingThread) {
+		SetEvent(g_h_historyFoldingStopEvent);
+		if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_historyFoldingThread, FOLDING_THREAD_EXIT_TIMEOUT))
+			LOG_EVENT(LOG_EVENT_TIMEOUT, "The game history folding thread did not exit in time", 0, 0);
+		CloseHandle(g_h_historyFoldingThread);
+		g_h_historyFoldingThread = NULL;
+		foldNewJournalRecords();
+	}
+	if (NULL != g_h_historyFoldingStopEvent) {
+		CloseHandle(g_h_historyFoldingStopEvent);
+		g_h_historyFoldingStopEvent = NULL;
+	}
+	free(g_p_foldBuffer);
+	g_p_foldBuffer = NULL;
+
+	//Unmap & close the index file
+	if (NULL != g_p_historyIndexView) {
+		FlushViewOfFile(g_p_historyIndexView, 0);
+		UnmapViewOfFile(g_p_historyIndexView);
+		g_p_historyIndexView = NULL;
+		g_p_historyHeader = NULL;
+	}
+	if (NULL != g_h_historyIndexMapping) {
+		CloseHandle(g_h_historyIndexMapping);
+		g_h_historyIndexMapping = NULL;
+	}
+	if (INVALID_HANDLE_VALUE != g_h_historyIndexFile) {
+		CloseHandle(g_h_historyIndexFile);
+		g_h_historyIndexFile = INVALID_HANDLE_VALUE;
+	}
+}
+
+BOOL fetchPlayerGameHistory(const char* p_playerName, int numOfLastGames, gameHistory* p_history)
+{
+	gameHistoryPlayer* p_player = NULL;
+	gameHistoryEntry* p_entry = NULL;
+	LONG version = 0, entry = 0;
+	//Input integrity validation
+	if ((NULL == p_playerName) || (NULL == p_history) || (0 > numOfLastGames)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return FALSE;
+	}
+	memset(p_history, 0, sizeof(gameHistory));
+	if ((NULL == g_p_historyHeader) || (NULL == (p_player = findGameHistoryPlayer(p_playerName)))) return FALSE;
+	if (GAME_HISTORY_MAX_LAST_GAMES < numOfLastGames) numOfLastGames = GAME_HISTORY_MAX_LAST_GAMES;
+
+	//Read the player's record, and follow its entries links (entries never change once linked). Retry if the record changed meanwhile
+	do {
+		while (0 != ((version = p_player->version) & 1)) YieldProcessor();
+		MemoryBarrier();
+		p_history->numOfGames = p_player->numOfGames;
+		p_history->numOfWins = p_player->numOfWins;
+		p_history->numOfDraws = p_player->numOfDraws;
+		for (p_history->numOfLastGames = 0, entry = p_player->lastEntry;
+			(p_history->numOfLastGames < numOfLastGames) && (GAME_HISTORY_NO_ENTRY != entry);
+			p_history->numOfLastGames++, entry = g_p_entryPreviousEntries[entry]) {
+			p_entry = p_history->lastGames + p_history->numOfLastGames;
+			p_entry->gameId = g_p_entryGameIds[entry];
+			p_entry->timestamp = g_p_entryTimestamps[entry];
+			p_entry->numOfRounds = g_p_entryNumOfRounds[entry];
+			p_entry->outcome = (ratingOutcomes)g_p_entryOutcomes[entry];
+			memcpy(p_entry->opponentName, g_p_entryOpponentNames[entry], sizeof(p_entry->opponentName));
+		}
+		MemoryBarrier();
+	} while (version != p_player->version);
+
+	return (0 < p_history->numOfGames);
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static SIZE_T layOutGameHistoryIndex(char* p_view)
+{
+	SIZE_T offset = 0;
+
+	//Every part starts on a cache line
+#define NEXT_GAME_HISTORY_PART( PartSize ) ( offset += (((PartSize) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE )
+	if (NULL != p_view) g_p_historyHeader = (gameHistoryIndexHeader*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(gameHistoryIndexHeader));
+	if (NULL != p_view) g_p_historyPlayers = (gameHistoryPlayer*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(gameHistoryPlayer) * GAME_HISTORY_MAX_PLAYERS);
+	if (NULL != p_view) g_p_entryGameIds = (LONGLONG*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(LONGLONG) * GAME_HISTORY_MAX_ENTRIES);
+	if (NULL != p_view) g_p_entryTimestamps = (LONGLONG*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(LONGLONG) * GAME_HISTORY_MAX_ENTRIES);
+	if (NULL != p_view) g_p_entryPreviousEntries = (LONG*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(LONG) * GAME_HISTORY_MAX_ENTRIES);
+	if (NULL != p_view) g_p_entryNumOfRounds = (SHORT*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(SHORT) * GAME_HISTORY_MAX_ENTRIES);
+	if (NULL != p_view) g_p_entryOutcomes = (char*)(p_view + offset);
+	NEXT_GAME_HISTORY_PART(sizeof(char) * GAME_HISTORY_MAX_ENTRIES);
+	if (NULL != p_view) g_p_entryOpponentNames = (char(*)[MAX_PLAYER_NAME_LEN + 1])(p_view + offset);
+	NEXT_GAME_HISTORY_PART((MAX_PLAYER_NAME_LEN + 1) * GAME_HISTORY_MAX_ENTRIES);
+#undef NEXT_GAME_HISTORY_PART
+
+	return offset;
+}
+
+static void resetGameHistoryIndex()
+{
+	int player = 0;
+
+	memset(g_p_historyIndexView, 0, layOutGameHistoryIndex(NULL));
+	for (player = 0; player < GAME_HISTORY_MAX_PLAYERS; player++) g_p_historyPlayers[player].lastEntry = GAME_HISTORY_NO_ENTRY;
+	g_p_historyHeader->magic = GAME_HISTORY_INDEX_MAGIC;
+	g_p_historyHeader->maxPlayers = GAME_HISTORY_MAX_PLAYERS;
+	g_p_historyHeader->maxEntries = GAME_HISTORY_MAX_ENTRIES;
+}
+
+static ULONG hashPlayerName(const char* p_playerName)
+{
+	ULONG hash = FNV_OFFSET_BASIS;
+	int c = 0;
+	//Assert
+	assert(NULL != p_playerName);
+
+	for (c = 0; (c < MAX_PLAYER_NAME_LEN) && ('\0' != p_playerName[c]); c++) {
+		hash ^= (unsigned char)p_playerName[c];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+static gameHistoryPlayer* findGameHistoryPlayer(const char* p_playerName)
+{
+	gameHistoryPlayer* p_player = NULL;
+	LONG version = 0;
+	ULONG firstSlot = 0;
+	int probe = 0;
+	BOOL isFound = FALSE, isFree = FALSE;
+	//Assert
+	assert(NULL != p_playerName);
+
+	firstSlot = hashPlayerName(p_playerName);
+	for (probe = 0; probe < GAME_HISTORY_MAX_PLAYERS; probe++) {
+		p_player = g_p_historyPlayers + ((firstSlot + probe) & (GAME_HISTORY_MAX_PLAYERS - 1));
+		//A name is written once, under the record's version - read it again if it was being written
+		do {
+			while (0 != ((version = p_player->version) & 1)) YieldProcessor();
+			MemoryBarrier();
+			isFree = ('\0' == p_player->playerName[0]);
+			isFound = (FALSE == isFree) && (0 == strncmp(p_player->playerName, p_playerName, MAX_PLAYER_NAME_LEN));
+			MemoryBarrier();
+		} while (version != p_player->version);
+
+		if (TRUE == isFound) return p_player;
+		if (TRUE == isFree) return NULL; //A free record ends the probing - the player has none
+	}
+	return NULL;
+}
+
+static gameHistoryPlayer* findOrAddGameHistoryPlayer(const char* p_playerName)
+{
+	gameHistoryPlayer* p_player = NULL;
+	ULONG firstSlot = 0;
+	int probe = 0, nameLength = 0;
+	//Assert
+	assert(NULL != p_playerName);
+
+	for (nameLength = 0; (nameLength < MAX_PLAYER_NAME_LEN) && ('\0' != p_playerName[nameLength]); nameLength++);
+	if (0 == nameLength) return NULL;
+
+	//The folding thread is the only writer, so the records it reads here never change under it
+	firstSlot = hashPlayerName(p_playerName);
+	for (probe = 0; probe < GAME_HISTORY_MAX_PLAYERS; probe++) {
+		p_player = g_p_historyPlayers + ((firstSlot + probe) & (GAME_HISTORY_MAX_PLAYERS - 1));
+		if ('\0' != p_player->playerName[0]) {
+			if (0 == strncmp(p_player->playerName, p_playerName, MAX_PLAYER_NAME_LEN)) return p_player;
+			continue;
+		}
+		//A free record - write the name under the record's version
+		InterlockedIncrement(&p_player->version);
+		memcpy(p_player->playerName, p_playerName, nameLength);
+		p_player->playerName[nameLength] = '\0';
+		InterlockedIncrement(&p_player->version);
+		return p_player;
+	}
+	return NULL; //The players table is full
+}
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Folding
+static BOOL WINAPI historyFoldingThreadRoutine(LPVOID lpParam)
+{
+	BOOL isSucceeded = TRUE;
+
+	while (TRUE) {
+		switch (WaitForSingleObject(g_h_historyFoldingStopEvent, GAME_HISTORY_FOLD_INTERVAL_MS)) {
+		case WAIT_TIMEOUT:
+			if (STATUS_CODE_FAILURE == foldNewJournalRecords()) isSucceeded = FALSE;
+			break;
+
+		case WAIT_OBJECT_0: //Stopped - destroyGameHistoryIndex(.) folds the last records
+			return isSucceeded;
+
+		default:
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait on the game history folding stop Event", GetLastError(), 0);
+			return STATUS_CODE_FAILURE;
+		}
+	}
+}
+
+static BOOL foldNewJournalRecords()
+{
+	HANDLE h_journalFile = INVALID_HANDLE_VALUE;
+	LARGE_INTEGER journalOffset;
+	DWORD bytesRead = 0, numOfRecords = 0, r = 0;
+
+	if ((NULL == g_p_historyHeader) || (NULL == g_p_foldBuffer)) return STATUS_CODE_FAILURE;
+
+	//The journal writer keeps appending meanwhile - read only whole records, from the folded length on
+	if (INVALID_HANDLE_VALUE == (h_journalFile = CreateFile(g_p_historyJournalPath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		if (ERROR_FILE_NOT_FOUND == GetLastError()) return STATUS_CODE_SUCCESS; //Nothing journaled yet
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to open the game journal for folding", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	journalOffset.QuadPart = g_p_historyHeader->journalOffset;
+	if (FALSE == SetFilePointerEx(h_journalFile, journalOffset, NULL, FILE_BEGIN)) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to seek the game journal for folding", GetLastError(), 0);
+		CloseHandle(h_journalFile);
+		return STATUS_CODE_FAILURE;
+	}
+
+	do {
+		if (FALSE == ReadFile(h_journalFile, g_p_foldBuffer, sizeof(gameJournalRecord) * GAME_JOURNAL_RING_CAPACITY, &bytesRead, NULL)) {
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to read the game journal for folding", GetLastError(), 0);
+			CloseHandle(h_journalFile);
+			return STATUS_CODE_FAILURE;
+		}
+		numOfRecords = bytesRead / sizeof(gameJournalRecord);
+		for (r = 0; r < numOfRecords; r++) {
+			if (GAME_JOURNAL_MAGIC != g_p_foldBuffer[r].magic) {
+				LOG_EVENT(LOG_EVENT_TRACE, "Game history fold stopped at a partial journal record", g_p_historyHeader->journalOffset, 0);
+				CloseHandle(h_journalFile);
+				return STATUS_CODE_SUCCESS;
+			}
+			foldJournalRecord(g_p_foldBuffer + r);
+			g_p_historyHeader->journalOffset += sizeof(gameJournalRecord);
+		}
+	} while (GAME_JOURNAL_RING_CAPACITY == numOfRecords);
+
+	CloseHandle(h_journalFile);
+	return STATUS_CODE_SUCCESS;
+}
+
+static void foldJournalRecord(const gameJournalRecord* p_record)
+{
+	foldedGame* p_game = NULL;
+	ratingOutcomes openerOutcome = RATING_OUTCOME_DRAW;
+	int g = 0;
+	//Assert
+	assert(NULL != p_record);
+
+	//The game of the record's epoch, if one is being folded
+	for (g = 0; g < GAME_HISTORY_MAX_OPEN_GAMES; g++)
+		if ((TRUE == g_foldedGames[g].isOpen) && (p_record->gameEpoch == g_foldedGames[g].gameEpoch)) {
+			p_game = g_foldedGames + g;
+			break;
+		}
+
+	switch (p_record->recordType) {
+	case JOURNAL_RECORD_SESSION: //The Server started - the epochs start over, and the games left open were never finished
+		memset(g_foldedGames, 0, sizeof(g_foldedGames));
+		g_p_historyHeader->numOfSessions++;
+		break;
+
+	case JOURNAL_RECORD_PAIRING:
+		//A game still open on this epoch was left by a player
+		if (NULL == p_game)
+			for (g = 0; (g < GAME_HISTORY_MAX_OPEN_GAMES) && (NULL == p_game); g++)
+				if (FALSE == g_foldedGames[g].isOpen) p_game = g_foldedGames + g;
+		if (NULL == p_game) break; //Too many games at once - this one is not indexed
+		memset(p_game, 0, sizeof(foldedGame));
+		p_game->isOpen = TRUE;
+		p_game->gameEpoch = p_record->gameEpoch;
+		memcpy(p_game->playerNames[OPENER], p_record->openerField, MAX_PLAYER_NAME_LEN);
+		memcpy(p_game->playerNames[JOINER], p_record->joinerField, MAX_PLAYER_NAME_LEN);
+		break;
+
+	case JOURNAL_RECORD_ROUND:
+		if (NULL != p_game) p_game->numOfRounds++;
+		break;
+
+	case JOURNAL_RECORD_OUTCOME:
+		if (NULL == p_game) break;
+		if ((RATING_OUTCOME_LOSS <= p_record->results[0]) && (RATING_OUTCOME_WIN >= p_record->results[0])) openerOutcome = (ratingOutcomes)p_record->results[0];
+		addGameHistoryEntry(p_game, OPENER, openerOutcome, p_record->timestamp);
+		addGameHistoryEntry(p_game, JOINER, (ratingOutcomes)(RATING_OUTCOME_WIN - openerOutcome), p_record->timestamp);
+		p_game->isOpen = FALSE;
+		break;
+
+	default: //JOURNAL_RECORD_SETUP - the initial numbers are not indexed
+		break;
+	}
+}
+
+static void addGameHistoryEntry(const foldedGame* p_game, int player, ratingOutcomes outcome, LONGLONG timestamp)
+{
+	gameHistoryPlayer* p_player = NULL;
+	LONG entry = 0;
+	//Assert
+	assert(NULL != p_game);
+
+	if ((GAME_HISTORY_MAX_ENTRIES <= (entry = g_p_historyHeader->numOfEntries)) || (NULL == (p_player = findOrAddGameHistoryPlayer(p_game->playerNames[player])))) {
+		if (FALSE == g_isIndexFullReported) LOG_EVENT(LOG_EVENT_FAILURE, "The game history index is full - new games are not indexed", entry, 0);
+		g_isIndexFullReported = TRUE;
+		return;
+	}
+
+	//Write the entry first - readers reach it only through the player's record
+	g_p_entryGameIds[entry] = ((LONGLONG)g_p_historyHeader->numOfSessions << 32) | (ULONG)p_game->gameEpoch;
+	g_p_entryTimestamps[entry] = timestamp;
+	g_p_entryPreviousEntries[entry] = p_player->lastEntry;
+	g_p_entryNumOfRounds[entry] = p_game->numOfRounds;
+	g_p_entryOutcomes[entry] = (char)outcome;
+	memcpy(g_p_entryOpponentNames[entry], p_game->playerNames[1 - player], MAX_PLAYER_NAME_LEN + 1);
+	InterlockedExchange(&g_p_historyHeader->numOfEntries, entry + 1);
+
+	//Link it & count it, under the record's version (the interlocked increments are full barriers)
+	InterlockedIncrement(&p_player->version);
+	p_player->lastEntry = entry;
+	p_player->numOfGames++;
+	if (RATING_OUTCOME_WIN == outcome) p_player->numOfWins++;
+	else if (RATING_OUTCOME_DRAW == outcome) p_player->numOfDraws++;
+	InterlockedIncrement(&p_player->version);
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
@@ -0,0 +1,50 @@
+/* GameHistoryIndexTools.h
+----------------------------------------------------------------------
+	Module Description - header module for GameHistoryIndexTools.c
+----------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __GAME_HISTORY_INDEX_TOOLS_H__
+#define __GAME_HISTORY_INDEX_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function maps the game history index file (creates it if missing, rebuilds it if it isn't a valid index of the current sizes
+/// or if the journal is shorter than what was folded), folds the journal records appended since the last fold, and starts the folding thread, which
+/// folds new records every GAME_HISTORY_FOLD_INTERVAL_MS. Must be called once, after initializeGameJournal(.) & before any Worker thread is created
+/// </summary>
+/// <param name="const char* p_indexPath - path of the index file (GAME_HISTORY_INDEX_PATH)"></param>
+/// <param name="const char* p_journalPath - path of the game journal (GAME_JOURNAL_PATH)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeGameHistoryIndex(const char* p_indexPath, const char* p_journalPath);
+
+/// <summary>
+/// Description - This function stops the folding thread, folds the last journal records, flushes & unmaps the index file.
+/// Must be called once, after destroyGameJournal(.)
+/// </summary>
+void destroyGameHistoryIndex();
+
+/// <summary>
+/// Description - This function reads a player's history without any lock: its # of games, wins & draws (its win rate) and its latest games,
+/// latest first. A read that overlaps the folding of the player's new game is retried
+/// </summary>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <param name="int numOfLastGames - # of latest games to read (at most GAME_HISTORY_MAX_LAST_GAMES)"></param>
+/// <param name="gameHistory* p_history - pointer to the struct that will hold the history"></param>
+/// <returns>True if the player has a history. False otherwise (no game, or the index is not initialized)</returns>
+BOOL fetchPlayerGameHistory(const char* p_playerName, int numOfLastGames, gameHistory* p_history);
+
+
+#endif //__GAME_HISTORY_INDEX_TOOLS_H__
@@ -0,0 +1,511 @@
+/* GameJournalAuditor.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the game journal auditor, built
+		ONLY when GAME_JOURNAL_AUDIT is defined, so the audit never runs on
+		the Server's hot path. It reads the records of a journal written by
+		GameJournalTools.c into memory, groups them by game & links every
+		game's rounds, and then audits the games on a thread per processor,
+		each claiming the next game with an interlocked increment. A game is
+		checked for results the Server could not have produced - numbers its
+		variant does not allow, results that differ from their re-scoring,
+		and outcomes the rounds contradict - and for players that look
+		automated: rounds at a fast or a metronome pace, or every guess
+		consistent with all the results the player got before it.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef GAME_JOURNAL_AUDIT
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "GameJournalAuditor.h"
+#include "GameVariantTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int OPENER = 0;
+static const int JOINER = 1;
+static const double FILETIME_TICKS_IN_MILLISECOND = 10000.0;
+
+//The opener's 'ratingOutcomes' value a round ends the game with, indexed by the round's 'gameRoundOutcomes' value (of the opener)
+static const SHORT OPENER_OUTCOME_OF_ROUND[] = { JOURNAL_AUDIT_NO_OUTCOME, RATING_OUTCOME_WIN, RATING_OUTCOME_LOSS, RATING_OUTCOME_DRAW };
+
+//Command line options
+static const char THREADS_OPTION[] = "--threads";
+
+
+// Global variables ------------------------------------------------------------
+//The journal's records & the next ROUND record of the same game, per record - read only once the threads start
+static gameJournalRecord* g_p_auditedRecords = NULL;
+static LONG* g_p_nextRoundRecords = NULL;
+static LONG g_numOfAuditedRecords = 0;
+static LONG g_auditedRecordsCapacity = 0;
+//The games & the next one to claim
+static auditedGame* g_p_auditedGames = NULL;
+static LONG g_numOfAuditedGames = 0;
+static LONG g_auditedGamesCapacity = 0;
+static volatile LONG g_nextAuditedGame = -1;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function parses the auditor's command line - the journal file, then an optional --threads <n>
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <param name="const char** p_p_journalPath - pointer to the journal's path"></param>
+/// <param name="int* p_numOfThreads - pointer to the # of threads"></param>
+/// <returns>True if the journal is given & every option is known & its value is valid. False otherwise</returns>
+static BOOL fetchAuditorOptions(int argc, char* argv[], const char** p_p_journalPath, int* p_numOfThreads);
+
+/// <summary>
+/// Description - This function reads the journal's records, groups them by game (a session's serial number & the game's epoch) and links every
+/// game's ROUND records. A torn last record (the Server stopped in the middle of a commit) ends the read
+/// </summary>
+/// <param name="const char* p_journalPath - the journal's path"></param>
+/// <param name="int* p_numOfSessions - pointer to the # of sessions"></param>
+/// <returns>True if succeeded. False otherwise (the journal could not be read, or no memory)</returns>
+static BOOL readJournalGames(const char* p_journalPath, int* p_numOfSessions);
+
+/// <summary>
+/// Description - This function appends a record, doubling the records & their links when they are full
+/// </summary>
+/// <param name="const gameJournalRecord* p_record - the record"></param>
+/// <returns>index of the appended record, or JOURNAL_AUDIT_NO_RECORD if the allocation failed</returns>
+static LONG appendAuditedRecord(const gameJournalRecord* p_record);
+
+/// <summary>
+/// Description - This function appends an empty game, doubling the games when they are full
+/// </summary>
+/// <returns>index of the appended game, or JOURNAL_AUDIT_NO_RECORD if the allocation failed</returns>
+static LONG appendAuditedGame();
+
+/// <summary>
+/// Description - This function finds the open game of an epoch
+/// </summary>
+/// <param name="const LONG* p_openGames - the open games table (indexes of games, JOURNAL_AUDIT_NO_RECORD for a free slot)"></param>
+/// <param name="LONG gameEpoch - the game's epoch"></param>
+/// <returns>the table's slot of the game, or JOURNAL_AUDIT_NO_RECORD if no game of this epoch is open</returns>
+static int findOpenAuditedGame(const LONG* p_openGames, LONG gameEpoch);
+
+/// <summary>
+/// Description - Auditor thread routine. Claims the next game and audits it, until no game is left
+/// </summary>
+/// <param name="LPVOID lpParam - not used"></param>
+/// <returns>0</returns>
+static DWORD WINAPI gameJournalAuditorThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function audits a game's numbers, results & outcome, then its pace & its players' guesses, into the game's findings
+/// </summary>
+/// <param name="auditedGame* p_game - the game"></param>
+static void auditJournaledGame(auditedGame* p_game);
+
+/// <summary>
+/// Description - This function measures the pace of a game's rounds - the mean & the variation of the intervals between them
+/// </summary>
+/// <param name="auditedGame* p_game - the game"></param>
+/// <returns>True if the game has enough rounds & their pace looks scripted. False otherwise</returns>
+static BOOL isScriptedRoundPace(auditedGame* p_game);
+
+/// <summary>
+/// Description - This function checks whether every guess of a player was still a possible secret - scored against each earlier guess of the
+/// player, it gets the result that guess got
+/// </summary>
+/// <param name="const auditedGame* p_game - the game"></param>
+/// <param name="int side - OPENER or JOINER"></param>
+/// <returns>True if the player made at least JOURNAL_AUDIT_MIN_SOLVER_GUESSES guesses, all consistent. False otherwise</returns>
+static BOOL isSolverLikePlayer(const auditedGame* p_game, int side);
+
+/// <summary>
+/// Description - This function prints a flagged game & its findings
+/// </summary>
+/// <param name="const auditedGame* p_game - the game"></param>
+static void printAuditedGame(const auditedGame* p_game);
+
+/// <summary>
+/// Description - This function frees the records, their links & the games
+/// </summary>
+static void freeGameJournalAuditor();
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runGameJournalAuditor(int argc, char* argv[])
+{
+	SYSTEM_INFO systemInfo;
+	HANDLE h_threads[JOURNAL_AUDIT_MAX_THREADS] = { NULL };
+	const char* p_journalPath = NULL;
+	int numOfThreads = 0, numOfStartedThreads = 0, numOfSessions = 0, t = 0;
+	LONG g = 0, numOfImpossibleGames = 0, numOfAutomatedGames = 0;
+	BOOL isAudited = FALSE;
+
+	GetSystemInfo(&systemInfo);
+	numOfThreads = (JOURNAL_AUDIT_MAX_THREADS < (int)systemInfo.dwNumberOfProcessors) ? JOURNAL_AUDIT_MAX_THREADS : (int)systemInfo.dwNumberOfProcessors;
+	if (STATUS_CODE_FAILURE == fetchAuditorOptions(argc, argv, &p_journalPath, &numOfThreads)) {
+		printf("Usage: %s <journal file> [%s <threads>]\n", argv[0], THREADS_OPTION);
+		return STATUS_CODE_FAILURE;
+	}
+	if (STATUS_CODE_FAILURE == readJournalGames(p_journalPath, &numOfSessions)) {
+		freeGameJournalAuditor();
+		return STATUS_CODE_FAILURE;
+	}
+	printf("Auditing %ld game(s) of %d session(s) (%ld records, %d threads)\n", g_numOfAuditedGames, numOfSessions, g_numOfAuditedRecords, numOfThreads);
+
+	//Audit the games in parallel
+	g_nextAuditedGame = -1;
+	for (numOfStartedThreads = 0; numOfStartedThreads < numOfThreads; numOfStartedThreads++)
+		if (NULL == (h_threads[numOfStartedThreads] = CreateThread(NULL, 0, gameJournalAuditorThreadRoutine, NULL, 0, NULL))) {
+			printf("Error: Failed to create an auditor thread, with error code no. %ld.\n", GetLastError());
+			break;
+		}
+	if ((0 < numOfStartedThreads) && (WAIT_FAILED == WaitForMultipleObjects((DWORD)numOfStartedThreads, h_threads, TRUE, INFINITE)))
+		printf("Error: Failed to wait for the auditor threads, with error code no. %ld.\n", GetLastError());
+	for (t = 0; t < numOfStartedThreads; t++) CloseHandle(h_threads[t]);
+
+	//A thread that failed to start left its games to the others - every game is audited unless none started
+	isAudited = (0 < numOfStartedThreads);
+	if (TRUE == isAudited) {
+		for (g = 0; g < g_numOfAuditedGames; g++) {
+			if (0 == g_p_auditedGames[g].findings) continue;
+			printAuditedGame(g_p_auditedGames + g);
+			if (0 != (JOURNAL_AUDIT_IMPOSSIBLE_RESULTS & g_p_auditedGames[g].findings)) numOfImpossibleGames++;
+			else numOfAutomatedGames++;
+		}
+		printf("\n%ld game(s) audited: %ld with impossible results, %ld that look automated\n", g_numOfAuditedGames, numOfImpossibleGames, numOfAutomatedGames);
+	}
+
+	freeGameJournalAuditor();
+	return (TRUE == isAudited) && (0 == numOfImpossibleGames);
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL fetchAuditorOptions(int argc, char* argv[], const char** p_p_journalPath, int* p_numOfThreads)
+{
+	int a = 0;
+	long value = 0;
+
+	if ((2 > argc) || (NULL == argv[1])) return STATUS_CODE_FAILURE;
+	*p_p_journalPath = argv[1];
+
+	for (a = 2; a < argc; a++) {
+		if (a + 1 >= argc) return STATUS_CODE_FAILURE; //Every option takes a value
+
+		if (STRINGS_ARE_EQUAL(argv[a], THREADS_OPTION, sizeof(THREADS_OPTION))) {
+			value = strtol(argv[a + 1], NULL, 10);
+			if ((0 >= value) || (JOURNAL_AUDIT_MAX_THREADS < value)) return STATUS_CODE_FAILURE;
+			*p_numOfThreads = (int)value;
+		}
+		else return STATUS_CODE_FAILURE;
+		a++;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL readJournalGames(const char* p_journalPath, int* p_numOfSessions)
+{
+	LONG openGames[JOURNAL_AUDIT_MAX_OPEN_GAMES];
+	gameJournalRecord record;
+	auditedGame* p_game = NULL;
+	HANDLE h_journalFile = INVALID_HANDLE_VALUE;
+	DWORD bytesRead = 0;
+	LONG recordIndex = 0, gameIndex = 0;
+	int slot = 0;
+	BOOL isRead = TRUE;
+	//Asserts
+	assert(NULL != p_journalPath);
+	assert(NULL != p_numOfSessions);
+
+	if (INVALID_HANDLE_VALUE == (h_journalFile = CreateFile(p_journalPath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		printf("Error: Failed to open the game journal %s, with error code no. %ld.\n", p_journalPath, GetLastError());
+		return STATUS_CODE_FAILURE;
+	}
+	for (slot = 0; slot < JOURNAL_AUDIT_MAX_OPEN_GAMES; slot++) openGames[slot] = JOURNAL_AUDIT_NO_RECORD;
+	*p_numOfSessions = 0;
+
+	while (TRUE) {
+		if (FALSE == ReadFile(h_journalFile, &record, sizeof(record), &bytesRead, NULL)) {
+			printf("Error: Failed to read the game journal, with error code no. %ld.\n", GetLastError());
+			isRead = FALSE;
+			break;
+		}
+		if (0 == bytesRead) break; //End of the journal
+		if ((sizeof(record) != bytesRead) || (GAME_JOURNAL_MAGIC != record.magic) ||
+			(JOURNAL_RECORD_SESSION > record.recordType) || (NUM_OF_JOURNAL_RECORD_TYPES <= record.recordType)) {
+			printf("Warning: Record no. %ld is torn or is not a journal record - the audit stops there.\n", g_numOfAuditedRecords);
+			break;
+		}
+		record.openerField[MAX_PLAYER_NAME_LEN] = '\0';
+		record.joinerField[MAX_PLAYER_NAME_LEN] = '\0';
+		if (JOURNAL_AUDIT_NO_RECORD == (recordIndex = appendAuditedRecord(&record))) {
+			isRead = FALSE;
+			break;
+		}
+
+		//The Server started - the epochs start over, and the games still open were left by a player
+		if (JOURNAL_RECORD_SESSION == record.recordType) {
+			for (slot = 0; slot < JOURNAL_AUDIT_MAX_OPEN_GAMES; slot++) openGames[slot] = JOURNAL_AUDIT_NO_RECORD;
+			(*p_numOfSessions)++;
+			continue;
+		}
+		slot = findOpenAuditedGame(openGames, record.gameEpoch);
+
+		if (JOURNAL_RECORD_PAIRING == record.recordType) {
+			//A new game of an epoch that is still open means the previous one was left without an outcome
+			if (JOURNAL_AUDIT_NO_RECORD == slot)
+				for (slot = 0; (slot < JOURNAL_AUDIT_MAX_OPEN_GAMES) && (JOURNAL_AUDIT_NO_RECORD != openGames[slot]); slot++);
+			if (JOURNAL_AUDIT_MAX_OPEN_GAMES == slot) {
+				printf("Warning: More than %d open games - game %d.%ld is skipped.\n", JOURNAL_AUDIT_MAX_OPEN_GAMES, *p_numOfSessions, record.gameEpoch);
+				continue;
+			}
+			if (JOURNAL_AUDIT_NO_RECORD == (gameIndex = appendAuditedGame())) {
+				isRead = FALSE;
+				break;
+			}
+			openGames[slot] = gameIndex;
+			p_game = g_p_auditedGames + gameIndex;
+			p_game->sessionNumber = *p_numOfSessions;
+			p_game->gameEpoch = record.gameEpoch;
+			setClassicGameVariant(&p_game->variant);
+			memcpy(p_game->playerNames[OPENER], record.openerField, sizeof(p_game->playerNames[OPENER]));
+			memcpy(p_game->playerNames[JOINER], record.joinerField, sizeof(p_game->playerNames[JOINER]));
+			continue;
+		}
+		if (JOURNAL_AUDIT_NO_RECORD == slot) continue; //Its pairing was skipped
+		p_game = g_p_auditedGames + openGames[slot];
+
+		switch (record.recordType) {
+		case JOURNAL_RECORD_SETUP:
+			memcpy(p_game->initialNumbers[OPENER], record.openerField, sizeof(p_game->initialNumbers[OPENER]));
+			memcpy(p_game->initialNumbers[JOINER], record.joinerField, sizeof(p_game->initialNumbers[JOINER]));
+			//A journal that predates the variants has no variant (classic). An invalid one is audited as classic as well
+			if (0 != record.results[0]) setGameVariant(record.results[0], record.results[1], (BOOL)record.results[2], &p_game->variant);
+			break;
+
+		case JOURNAL_RECORD_ROUND:
+			if (JOURNAL_AUDIT_NO_RECORD == p_game->firstRound) p_game->firstRound = recordIndex;
+			else g_p_nextRoundRecords[p_game->lastRound] = recordIndex;
+			p_game->lastRound = recordIndex;
+			p_game->numOfRounds++;
+			break;
+
+		default: //JOURNAL_RECORD_OUTCOME
+			p_game->outcome = record.results[0];
+			openGames[slot] = JOURNAL_AUDIT_NO_RECORD;
+			break;
+		}
+	}
+	CloseHandle(h_journalFile);
+	return isRead;
+}
+
+static LONG appendAuditedRecord(const gameJournalRecord* p_record)
+{
+	gameJournalRecord* p_records = NULL;
+	LONG* p_nextRoundRecords = NULL;
+	LONG capacity = 0;
+	//Assert
+	assert(NULL != p_record);
+
+	if (g_numOfAuditedRecords == g_auditedRecordsCapacity) {
+		capacity = (0 == g_auditedRecordsCapacity) ? JOURNAL_AUDIT_INITIAL_CAPACITY : (2 * g_auditedRecordsCapacity);
+		if (NULL != (p_records = (gameJournalRecord*)realloc(g_p_auditedRecords, sizeof(gameJournalRecord) * capacity))) g_p_auditedRecords = p_records;
+		if (NULL != (p_nextRoundRecords = (LONG*)realloc(g_p_nextRoundRecords, sizeof(LONG) * capacity))) g_p_nextRoundRecords = p_nextRoundRecords;
+		if ((NULL == p_records) || (NULL == p_nextRoundRecords)) {
+			printf("Error: Failed to allocate memory for %ld journal records.\n", capacity);
+			return JOURNAL_AUDIT_NO_RECORD;
+		}
+		g_auditedRecordsCapacity = capacity;
+	}
+	g_p_auditedRecords[g_numOfAuditedRecords] = *p_record;
+	g_p_nextRoundRecords[g_numOfAuditedRecords] = JOURNAL_AUDIT_NO_RECORD;
+	return g_numOfAuditedRecords++;
+}
+
+static LONG appendAuditedGame()
+{
+	auditedGame* p_games = NULL;
+	LONG capacity = 0;
+
+	if (g_numOfAuditedGames == g_auditedGamesCapacity) {
+		capacity = (0 == g_auditedGamesCapacity) ? JOURNAL_AUDIT_INITIAL_CAPACITY : (2 * g_auditedGamesCapacity);
+		if (NULL == (p_games = (auditedGame*)realloc(g_p_auditedGames, sizeof(auditedGame) * capacity))) {
+			printf("Error: Failed to allocate memory for %ld journaled games.\n", capacity);
+			return JOURNAL_AUDIT_NO_RECORD;
+		}
+		g_p_auditedGames = p_games;
+		g_auditedGamesCapacity = capacity;
+	}
+	memset(g_p_auditedGames + g_numOfAuditedGames, 0, sizeof(auditedGame));
+	g_p_auditedGames[g_numOfAuditedGames].outcome = JOURNAL_AUDIT_NO_OUTCOME;
+	g_p_auditedGames[g_numOfAuditedGames].firstRound = JOURNAL_AUDIT_NO_RECORD;
+	g_p_auditedGames[g_numOfAuditedGames].lastRound = JOURNAL_AUDIT_NO_RECORD;
+	return g_numOfAuditedGames++;
+}
+
+static int findOpenAuditedGame(const LONG* p_openGames, LONG gameEpoch)
+{
+	int slot = 0;
+	//Assert
+	assert(NULL != p_openGames);
+
+	for (slot = 0; slot < JOURNAL_AUDIT_MAX_OPEN_GAMES; slot++)
+		if ((JOURNAL_AUDIT_NO_RECORD != p_openGames[slot]) && (gameEpoch == g_p_auditedGames[p_openGames[slot]].gameEpoch)) return slot;
+	return JOURNAL_AUDIT_NO_RECORD;
+}
+
+static DWORD WINAPI gameJournalAuditorThreadRoutine(LPVOID lpParam)
+{
+	LONG game = 0;
+
+	while (g_numOfAuditedGames > (game = InterlockedIncrement(&g_nextAuditedGame)))
+		auditJournaledGame(g_p_auditedGames + game);
+	return 0;
+}
+
+static void auditJournaledGame(auditedGame* p_game)
+{
+	const gameJournalRecord* p_round = NULL;
+	SHORT openerGuessBulls = 0, openerGuessCows = 0, joinerGuessBulls = 0, joinerGuessCows = 0;
+	gameRoundOutcomes roundOutcome = GAME_ROUND_CONTINUES;
+	BOOL isSetUp = FALSE;
+	LONG r = 0;
+	//Assert
+	assert(NULL != p_game);
+
+	//Numbers the Server should have refused - a game whose setup is missing can't be re-scored
+	isSetUp = ('\0' != p_game->initialNumbers[OPENER][0]) && ('\0' != p_game->initialNumbers[JOINER][0]);
+	if ((TRUE == isSetUp) && ((FALSE == isValidPlayerNumber(&p_game->variant, p_game->initialNumbers[OPENER])) ||
+		(FALSE == isValidPlayerNumber(&p_game->variant, p_game->initialNumbers[JOINER]))))
+		p_game->findings |= JOURNAL_AUDIT_INVALID_NUMBER;
+
+	for (r = p_game->firstRound; JOURNAL_AUDIT_NO_RECORD != r; r = g_p_nextRoundRecords[r]) {
+		p_round = g_p_auditedRecords + r;
+		if ((FALSE == isValidPlayerNumber(&p_game->variant, p_round->openerField)) || (FALSE == isValidPlayerNumber(&p_game->variant, p_round->joinerField)))
+			p_game->findings |= JOURNAL_AUDIT_INVALID_NUMBER;
+		if (GAME_ROUND_CONTINUES != roundOutcome) p_game->findings |= JOURNAL_AUDIT_OUTCOME_MISMATCH; //Played after the game was decided
+
+		//Re-score - a guess is scored against the opponent's initial number
+		if (TRUE == isSetUp) {
+			p_game->variant.p_scoreGuess(p_game->initialNumbers[JOINER], p_round->openerField, &openerGuessBulls, &openerGuessCows);
+			p_game->variant.p_scoreGuess(p_game->initialNumbers[OPENER], p_round->joinerField, &joinerGuessBulls, &joinerGuessCows);
+			if ((openerGuessBulls != p_round->results[0]) || (openerGuessCows != p_round->results[1]) ||
+				(joinerGuessBulls != p_round->results[2]) || (joinerGuessCows != p_round->results[3]))
+				p_game->findings |= JOURNAL_AUDIT_RESCORE_MISMATCH;
+		}
+		roundOutcome = judgeGameRound(&p_game->variant, p_round->results[0], p_round->results[2]);
+	}
+	//The outcome is the last round's
+	if ((JOURNAL_AUDIT_NO_OUTCOME != p_game->outcome) && (OPENER_OUTCOME_OF_ROUND[roundOutcome] != p_game->outcome))
+		p_game->findings |= JOURNAL_AUDIT_OUTCOME_MISMATCH;
+
+	//Players that look automated - the Server's own bot is one by design
+	if (TRUE == isScriptedRoundPace(p_game)) p_game->findings |= JOURNAL_AUDIT_BOT_TIMING;
+	if ((FALSE == STRINGS_ARE_EQUAL(p_game->playerNames[OPENER], MATCHMAKING_BOT_NAME, sizeof(MATCHMAKING_BOT_NAME))) && (TRUE == isSolverLikePlayer(p_game, OPENER)))
+		p_game->findings |= JOURNAL_AUDIT_OPENER_SOLVER;
+	if ((FALSE == STRINGS_ARE_EQUAL(p_game->playerNames[JOINER], MATCHMAKING_BOT_NAME, sizeof(MATCHMAKING_BOT_NAME))) && (TRUE == isSolverLikePlayer(p_game, JOINER)))
+		p_game->findings |= JOURNAL_AUDIT_JOINER_SOLVER;
+}
+
+static BOOL isScriptedRoundPace(auditedGame* p_game)
+{
+	double interval = 0, sumOfIntervals = 0, sumOfSquares = 0, variance = 0;
+	int numOfIntervals = 0;
+	LONG r = 0;
+	//Assert
+	assert(NULL != p_game);
+
+	//A round is journaled once both guesses are in, so the intervals are the pace of the slower player
+	if (JOURNAL_AUDIT_NO_RECORD == p_game->firstRound) return FALSE;
+	for (r = p_game->firstRound; JOURNAL_AUDIT_NO_RECORD != g_p_nextRoundRecords[r]; r = g_p_nextRoundRecords[r]) {
+		interval = (double)(g_p_auditedRecords[g_p_nextRoundRecords[r]].timestamp - g_p_auditedRecords[r].timestamp) / FILETIME_TICKS_IN_MILLISECOND;
+		sumOfIntervals += interval;
+		sumOfSquares += interval * interval;
+		numOfIntervals++;
+	}
+	if (JOURNAL_AUDIT_MIN_TIMED_ROUNDS > numOfIntervals) return FALSE;
+
+	p_game->meanRoundMilliseconds = sumOfIntervals / numOfIntervals;
+	variance = sumOfSquares / numOfIntervals - p_game->meanRoundMilliseconds * p_game->meanRoundMilliseconds;
+	p_game->roundVariation = ((0 < variance) && (0 < p_game->meanRoundMilliseconds)) ? (sqrt(variance) / p_game->meanRoundMilliseconds) : 0;
+	return (JOURNAL_AUDIT_BOT_MAX_MEAN_MS > p_game->meanRoundMilliseconds) || (JOURNAL_AUDIT_BOT_MAX_VARIATION > p_game->roundVariation);
+}
+
+static BOOL isSolverLikePlayer(const auditedGame* p_game, int side)
+{
+	const char* p_guess = NULL;
+	SHORT bulls = 0, cows = 0;
+	int numOfGuesses = 0;
+	LONG r = 0, earlier = 0;
+	//Assert
+	assert(NULL != p_game);
+
+	for (r = p_game->firstRound; JOURNAL_AUDIT_NO_RECORD != r; r = g_p_nextRoundRecords[r], numOfGuesses++) {
+		p_guess = (OPENER == side) ? g_p_auditedRecords[r].openerField : g_p_auditedRecords[r].joinerField;
+		for (earlier = p_game->firstRound; earlier != r; earlier = g_p_nextRoundRecords[earlier]) {
+			p_game->variant.p_scoreGuess(p_guess, (OPENER == side) ? g_p_auditedRecords[earlier].openerField : g_p_auditedRecords[earlier].joinerField, &bulls, &cows);
+			if ((bulls != g_p_auditedRecords[earlier].results[2 * side]) || (cows != g_p_auditedRecords[earlier].results[2 * side + 1])) return FALSE;
+		}
+	}
+	return (JOURNAL_AUDIT_MIN_SOLVER_GUESSES <= numOfGuesses);
+}
+
+static void printAuditedGame(const auditedGame* p_game)
+{
+	//Assert
+	assert(NULL != p_game);
+
+	printf("Game %d.%ld: %s vs %s, %d round(s)", p_game->sessionNumber, p_game->gameEpoch,
+		p_game->playerNames[OPENER], p_game->playerNames[JOINER], p_game->numOfRounds);
+	if (0 != (JOURNAL_AUDIT_INVALID_NUMBER & p_game->findings)) printf(" - invalid numbers");
+	if (0 != (JOURNAL_AUDIT_RESCORE_MISMATCH & p_game->findings)) printf(" - re-scoring mismatch");
+	if (0 != (JOURNAL_AUDIT_OUTCOME_MISMATCH & p_game->findings)) printf(" - outcome contradicts the rounds");
+	if (0 != (JOURNAL_AUDIT_BOT_TIMING & p_game->findings))
+		printf(" - scripted pace (%.0f ms per round, variation %.3f)", p_game->meanRoundMilliseconds, p_game->roundVariation);
+	if (0 != (JOURNAL_AUDIT_OPENER_SOLVER & p_game->findings)) printf(" - %s guesses as a solver", p_game->playerNames[OPENER]);
+	if (0 != (JOURNAL_AUDIT_JOINER_SOLVER & p_game->findings)) printf(" - %s guesses as a solver", p_game->playerNames[JOINER]);
+	printf("\n");
+}
+
+static void freeGameJournalAuditor()
+{
+	free(g_p_auditedRecords);
+	free(g_p_nextRoundRecords);
+	free(g_p_auditedGames);
+	g_p_auditedRecords = NULL;
+	g_p_nextRoundRecords = NULL;
+	g_p_auditedGames = NULL;
+	g_numOfAuditedRecords = g_auditedRecordsCapacity = 0;
+	g_numOfAuditedGames = g_auditedGamesCapacity = 0;
+}
+
+#endif //GAME_JOURNAL_AUDIT
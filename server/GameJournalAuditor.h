@@ -0,0 +1,37 @@
+/* GameJournalAuditor.h
+------------------------------------------------------------------
+	Module Description - header module for GameJournalAuditor.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __GAME_JOURNAL_AUDITOR_H__
+#define __GAME_JOURNAL_AUDITOR_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef GAME_JOURNAL_AUDIT
+/// <summary>
+/// Description - This function reads a game journal into memory and audits its games on a thread per processor: numbers the game's variant does
+/// not allow, results that differ from their re-scoring & outcomes that contradict the rounds (impossible results), and players whose pace or guesses
+/// look automated. Only the flagged games are printed. Built ONLY when GAME_JOURNAL_AUDIT is defined - the Server then runs it instead of serving Clients:
+///		server.exe <journal file> [--threads <n>]
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if the journal was read & no game has an impossible result. False otherwise</returns>
+BOOL runGameJournalAuditor(int argc, char* argv[]);
+#endif //GAME_JOURNAL_AUDIT
+
+
+#endif //__GAME_JOURNAL_AUDITOR_H__
@@ -0,0 +1,268 @@
+/* GameJournalReplay.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the game journal reader, built
+		ONLY when GAME_JOURNAL_REPLAY is defined. It reads the records of a
+		journal written by GameJournalTools.c in order, and replays every game:
+		its players, their initial numbers, every round & the outcome. Every
+		round is re-scored with the scorer of the game's journaled variant
+		(GameVariantTools.c) from the journaled initial numbers & guesses, so a journaled result that differs
+		from its re-scoring is reported (audit). A torn last record (the Server
+		stopped in the middle of a commit) ends the replay.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef GAME_JOURNAL_REPLAY
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "GameJournalReplay.h"
+#include "ServerSideWorkerThreadRoutine.h"
+#include "GameVariantTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int OPENER = 0;
+static const int JOINER = 1;
+
+//Outcome of the Game Room opener, as printed (ordered as 'ratingOutcomes')
+static const char* OPENER_OUTCOME_NAMES[] = { "lost", "drew", "won" };
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function finds the open game of an epoch
+/// </summary>
+/// <param name="replayedGame* p_games - the open games table"></param>
+/// <param name="LONG gameEpoch - the game's epoch"></param>
+/// <returns>pointer to the game, or NULL if no game of this epoch is open</returns>
+static replayedGame* findOpenGame(replayedGame* p_games, LONG gameEpoch);
+
+/// <summary>
+/// Description - This function closes every open game of the session - games with no outcome record were left by a player
+/// </summary>
+/// <param name="replayedGame* p_games - the open games table"></param>
+/// <param name="int sessionNumber - the session's serial number (for printing)"></param>
+/// <param name="int* p_numOfAbandonedGames - pointer to the # of abandoned games"></param>
+static void closeOpenGames(replayedGame* p_games, int sessionNumber, int* p_numOfAbandonedGames);
+
+/// <summary>
+/// Description - This function replays a ROUND record: prints both guesses & results, and re-scores them
+/// </summary>
+/// <param name="replayedGame* p_game - the record's game"></param>
+/// <param name="const gameJournalRecord* p_record - the ROUND record"></param>
+/// <returns>True if both journaled results equal their re-scoring. False otherwise</returns>
+static BOOL replayRound(replayedGame* p_game, const gameJournalRecord* p_record);
+
+/// <summary>
+/// Description - This function prints a record's timestamp (UTC) without a new line
+/// </summary>
+/// <param name="LONGLONG timestamp - FILETIME value of the record"></param>
+static void printJournalTimestamp(LONGLONG timestamp);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runGameJournalReplay(int argc, char* argv[])
+{
+	replayedGame games[JOURNAL_REPLAY_MAX_OPEN_GAMES];
+	gameJournalRecord record;
+	replayedGame* p_game = NULL;
+	HANDLE h_journalFile = INVALID_HANDLE_VALUE;
+	DWORD bytesRead = 0;
+	LONGLONG numOfRecords = 0;
+	int sessionNumber = 0, numOfGames = 0, numOfFinishedGames = 0, numOfAbandonedGames = 0, numOfRounds = 0, numOfMismatches = 0, g = 0;
+	BOOL isReplayed = TRUE;
+
+	if ((2 != argc) || (NULL == argv[1])) {
+		printf("Usage: %s <journal file>\n", argv[0]);
+		return STATUS_CODE_FAILURE;
+	}
+	if (INVALID_HANDLE_VALUE == (h_journalFile = CreateFile(argv[1], GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		printf("Error: Failed to open the game journal %s, with error code no. %ld.\n", argv[1], GetLastError());
+		return STATUS_CODE_FAILURE;
+	}
+	memset(games, 0, sizeof(games));
+
+	while (TRUE) {
+		if (FALSE == ReadFile(h_journalFile, &record, sizeof(record), &bytesRead, NULL)) {
+			printf("Error: Failed to read the game journal, with error code no. %ld.\n", GetLastError());
+			isReplayed = FALSE;
+			break;
+		}
+		if (0 == bytesRead) break; //End of the journal
+		if ((sizeof(record) != bytesRead) || (GAME_JOURNAL_MAGIC != record.magic) ||
+			(JOURNAL_RECORD_SESSION > record.recordType) || (NUM_OF_JOURNAL_RECORD_TYPES <= record.recordType)) {
+			printf("Warning: Record no. %lld is torn or is not a journal record - the replay stops there.\n", numOfRecords);
+			break;
+		}
+		numOfRecords++;
+		record.openerField[MAX_PLAYER_NAME_LEN] = '\0';
+		record.joinerField[MAX_PLAYER_NAME_LEN] = '\0';
+
+		switch (record.recordType) {
+		case JOURNAL_RECORD_SESSION: //The Server started - the epochs start over
+			closeOpenGames(games, sessionNumber, &numOfAbandonedGames);
+			printf("\nSession %d started at ", ++sessionNumber);
+			printJournalTimestamp(record.timestamp);
+			printf("\n");
+			break;
+
+		case JOURNAL_RECORD_PAIRING:
+			//A new game of an epoch that is still open means the previous one was left without an outcome
+			if (NULL != (p_game = findOpenGame(games, record.gameEpoch))) {
+				printf("Game %d.%ld: left by a player after %d round(s)\n", sessionNumber, p_game->gameEpoch, p_game->numOfRounds);
+				p_game->isOpen = FALSE;
+				numOfAbandonedGames++;
+			}
+			for (g = 0; (g < JOURNAL_REPLAY_MAX_OPEN_GAMES) && (TRUE == games[g].isOpen); g++);
+			if (JOURNAL_REPLAY_MAX_OPEN_GAMES == g) {
+				printf("Warning: More than %d open games - game %d.%ld is skipped.\n", JOURNAL_REPLAY_MAX_OPEN_GAMES, sessionNumber, record.gameEpoch);
+				break;
+			}
+			p_game = games + g;
+			memset(p_game, 0, sizeof(replayedGame));
+			p_game->isOpen = TRUE;
+			p_game->gameEpoch = record.gameEpoch;
+			setClassicGameVariant(&p_game->variant);
+			memcpy(p_game->playerNames[OPENER], record.openerField, sizeof(p_game->playerNames[OPENER]));
+			memcpy(p_game->playerNames[JOINER], record.joinerField, sizeof(p_game->playerNames[JOINER]));
+			numOfGames++;
+			printf("Game %d.%ld: %s vs %s, paired at ", sessionNumber, record.gameEpoch, record.openerField, record.joinerField);
+			printJournalTimestamp(record.timestamp);
+			printf("\n");
+			break;
+
+		case JOURNAL_RECORD_SETUP:
+			if (NULL == (p_game = findOpenGame(games, record.gameEpoch))) break; //Its pairing was skipped
+			memcpy(p_game->initialNumbers[OPENER], record.openerField, sizeof(p_game->initialNumbers[OPENER]));
+			memcpy(p_game->initialNumbers[JOINER], record.joinerField, sizeof(p_game->initialNumbers[JOINER]));
+			//A journal that predates the variants has no variant (classic). An invalid one is re-scored as classic as well
+			if ((0 != record.results[0]) && (STATUS_CODE_FAILURE == setGameVariant(record.results[0], record.results[1], (BOOL)record.results[2], &p_game->variant)))
+				printf("\tInvalid variant %dx%d, re-scored as classic\n", record.results[0], record.results[1]);
+			printf("\tInitial numbers: %s %s, %s %s\n", p_game->playerNames[OPENER], record.openerField, p_game->playerNames[JOINER], record.joinerField);
+			break;
+
+		case JOURNAL_RECORD_ROUND:
+			if (NULL == (p_game = findOpenGame(games, record.gameEpoch))) break;
+			numOfRounds++;
+			if (STATUS_CODE_FAILURE == replayRound(p_game, &record)) numOfMismatches++;
+			break;
+
+		default: //JOURNAL_RECORD_OUTCOME
+			if (NULL == (p_game = findOpenGame(games, record.gameEpoch))) break;
+			if ((RATING_OUTCOME_LOSS > record.results[0]) || (RATING_OUTCOME_WIN < record.results[0])) record.results[0] = RATING_OUTCOME_DRAW;
+			printf("\tOutcome: %s %s against %s after %d round(s)\n", p_game->playerNames[OPENER], OPENER_OUTCOME_NAMES[record.results[0]],
+				p_game->playerNames[JOINER], p_game->numOfRounds);
+			p_game->isOpen = FALSE;
+			numOfFinishedGames++;
+			break;
+		}
+	}
+	CloseHandle(h_journalFile);
+	closeOpenGames(games, sessionNumber, &numOfAbandonedGames);
+
+	printf("\n%lld record(s), %d session(s), %d game(s): %d finished, %d left by a player. %d round(s), %d re-scoring mismatch(es)\n",
+		numOfRecords, sessionNumber, numOfGames, numOfFinishedGames, numOfAbandonedGames, numOfRounds, numOfMismatches);
+	return (TRUE == isReplayed) && (0 == numOfMismatches);
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static replayedGame* findOpenGame(replayedGame* p_games, LONG gameEpoch)
+{
+	int g = 0;
+	//Assert
+	assert(NULL != p_games);
+
+	for (g = 0; g < JOURNAL_REPLAY_MAX_OPEN_GAMES; g++)
+		if ((TRUE == p_games[g].isOpen) && (gameEpoch == p_games[g].gameEpoch)) return p_games + g;
+	return NULL;
+}
+
+static void closeOpenGames(replayedGame* p_games, int sessionNumber, int* p_numOfAbandonedGames)
+{
+	int g = 0;
+	//Asserts
+	assert(NULL != p_games);
+	assert(NULL != p_numOfAbandonedGames);
+
+	for (g = 0; g < JOURNAL_REPLAY_MAX_OPEN_GAMES; g++) {
+		if (FALSE == p_games[g].isOpen) continue;
+		printf("Game %d.%ld: left by a player after %d round(s)\n", sessionNumber, p_games[g].gameEpoch, p_games[g].numOfRounds);
+		p_games[g].isOpen = FALSE;
+		(*p_numOfAbandonedGames)++;
+	}
+}
+
+static BOOL replayRound(replayedGame* p_game, const gameJournalRecord* p_record)
+{
+	char openerGuess[MAX_PLAYER_NAME_LEN + 1] = { 0 }, joinerGuess[MAX_PLAYER_NAME_LEN + 1] = { 0 };
+	SHORT openerGuessBulls = 0, openerGuessCows = 0, joinerGuessBulls = 0, joinerGuessCows = 0;
+	BOOL isMatching = TRUE;
+	//Asserts
+	assert(NULL != p_game);
+	assert(NULL != p_record);
+
+	p_game->numOfRounds++;
+	printf("\tRound %d: %s %s -> %d bulls %d cows | %s %s -> %d bulls %d cows", p_game->numOfRounds,
+		p_game->playerNames[OPENER], p_record->openerField, p_record->results[0], p_record->results[1],
+		p_game->playerNames[JOINER], p_record->joinerField, p_record->results[2], p_record->results[3]);
+
+	//Re-score - a guess is scored against the opponent's initial number. A game whose setup is missing can't be re-scored
+	if (('\0' != p_game->initialNumbers[OPENER][0]) && ('\0' != p_game->initialNumbers[JOINER][0])) {
+		memcpy(openerGuess, p_record->openerField, sizeof(openerGuess));
+		memcpy(joinerGuess, p_record->joinerField, sizeof(joinerGuess));
+		p_game->variant.p_scoreGuess(p_game->initialNumbers[JOINER], openerGuess, &openerGuessBulls, &openerGuessCows);
+		p_game->variant.p_scoreGuess(p_game->initialNumbers[OPENER], joinerGuess, &joinerGuessBulls, &joinerGuessCows);
+		isMatching = (openerGuessBulls == p_record->results[0]) && (openerGuessCows == p_record->results[1]) &&
+			(joinerGuessBulls == p_record->results[2]) && (joinerGuessCows == p_record->results[3]);
+	}
+
+	if (TRUE == isMatching) printf("\n");
+	else printf("   <-- MISMATCH, re-scored %d bulls %d cows | %d bulls %d cows\n", openerGuessBulls, openerGuessCows, joinerGuessBulls, joinerGuessCows);
+	return isMatching;
+}
+
+static void printJournalTimestamp(LONGLONG timestamp)
+{
+	FILETIME fileTime;
+	SYSTEMTIME systemTime;
+
+	fileTime.dwLowDateTime = (DWORD)(timestamp & 0xFFFFFFFF);
+	fileTime.dwHighDateTime = (DWORD)((ULONGLONG)timestamp >> 32);
+	if (FALSE == FileTimeToSystemTime(&fileTime, &systemTime)) {
+		printf("<bad time>");
+		return;
+	}
+	printf("%04d-%02d-%02d %02d:%02d:%02d.%03d UTC", systemTime.wYear, systemTime.wMonth, systemTime.wDay,
+		systemTime.wHour, systemTime.wMinute, systemTime.wSecond, systemTime.wMilliseconds);
+}
+
+#endif //GAME_JOURNAL_REPLAY
@@ -0,0 +1,37 @@
+/* GameJournalReplay.h
+------------------------------------------------------------------
+	Module Description - header module for GameJournalReplay.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __GAME_JOURNAL_REPLAY_H__
+#define __GAME_JOURNAL_REPLAY_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef GAME_JOURNAL_REPLAY
+/// <summary>
+/// Description - This function decodes a game journal and replays its games in order: the pairing, the initial numbers, every round (re-scored with
+/// playSingleGamePhase(.) & compared to the journaled bulls & cows) and the outcome. A game with no outcome record was left by a player.
+/// Built ONLY when GAME_JOURNAL_REPLAY is defined - the Server then runs it instead of serving Clients:
+///		server.exe <journal file>
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if the journal was read & every round re-scored to its journaled results. False otherwise</returns>
+BOOL runGameJournalReplay(int argc, char* argv[]);
+#endif //GAME_JOURNAL_REPLAY
+
+
+#endif //__GAME_JOURNAL_REPLAY_H__
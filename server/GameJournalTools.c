@@ -0,0 +1,375 @@
+/* GameJournalTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the game journal - an append-only
+		binary file holding every game's pairing, initial numbers, rounds (both
+		guesses & their bulls & cows) and outcome, for replay & audit.
+		GameSession.txt is truncated when a game ends, the journal is not.
+		The Game Room opener's Worker thread reserves a cell of a bounded ring
+		with InterlockedCompareExchange & fills it - no lock, no file access.
+		A writer thread wakes up every GAME_JOURNAL_COMMIT_INTERVAL_MS, copies
+		the published records to a batch, appends the batch with a single
+		WriteFile(.) & flushes the file once (group commit). A full ring drops
+		new records & counts them - the journal never slows a round down.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "GameJournalTools.h"
+#include "ServerClientsTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const LONG GAME_JOURNAL_RING_MASK = GAME_JOURNAL_RING_CAPACITY - 1;
+static const DWORD WRITER_THREAD_EXIT_TIMEOUT = 5000; // 5 Seconds
+
+// Global variables ------------------------------------------------------------
+//The ring, and the batch the writer thread copies the published records to
+static gameJournalRing* g_p_journalRing = NULL;
+static gameJournalRecord* g_p_journalBatch = NULL;
+//Journal file, writer thread & its stop Event
+static HANDLE g_h_journalFile = INVALID_HANDLE_VALUE;
+static HANDLE g_h_journalWriterThread = NULL;
+static HANDLE g_h_journalWriterStopEvent = NULL;
+//# of dropped records the writer already reported
+static LONG g_reportedDroppedRecords = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function reserves the next free cell of the ring (InterlockedCompareExchange on the enqueue position) and zeroes its record
+/// </summary>
+/// <param name="LONG* p_position - pointer to a LONG that will hold the reserved position (the cell is published with it)"></param>
+/// <returns>pointer to the reserved cell, or NULL if the ring is full (the record is dropped & counted) or the journal is not initialized</returns>
+static gameJournalCell* reserveJournalCell(LONG* p_position);
+
+/// <summary>
+/// Description - This function stamps the cell's record (magic, time, type & epoch) and publishes it to the writer thread
+/// </summary>
+/// <param name="gameJournalCell* p_cell - pointer to the reserved cell, with its record's fields & results filled"></param>
+/// <param name="LONG position - the reserved position"></param>
+/// <param name="journalRecordTypes recordType - the record's type"></param>
+/// <param name="LONG gameEpoch - the game's Game Room epoch"></param>
+static void publishJournalCell(gameJournalCell* p_cell, LONG position, journalRecordTypes recordType, LONG gameEpoch);
+
+/// <summary>
+/// Description - This function copies a string of up to MAX_PLAYER_NAME_LEN characters into a (zeroed) record field. An absent string leaves the field empty
+/// </summary>
+/// <param name="char* p_field - the record field"></param>
+/// <param name="const char* p_string - the string, or NULL"></param>
+static void copyJournalField(char* p_field, const char* p_string);
+
+/// <summary>
+/// Description - Writer thread routine: commits the ring every GAME_JOURNAL_COMMIT_INTERVAL_MS, until the stop Event is signaled (then commits once more)
+/// </summary>
+/// <param name="LPVOID lpParam - not used"></param>
+/// <returns>True if every commit succeeded. False otherwise</returns>
+static BOOL WINAPI journalWriterThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function copies the published records to the batch (releasing their cells at once), appends the batch to the journal file
+/// with a single WriteFile(.) and flushes the file once. Records published meanwhile are left to the next commit
+/// </summary>
+/// <returns>True if succeeded (or nothing to commit). False otherwise</returns>
+static BOOL commitGameJournalBatch();
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeGameJournal(const char* p_journalPath)
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0;
+	DWORD threadId = 0;
+	int cell = 0;
+	//Input integrity validation
+	if (NULL == p_journalPath) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+
+	//Allocate the ring - every cell's sequence starts at its index, so the first lap of records finds them free - and the batch
+	if (NULL == (g_p_journalRing = (gameJournalRing*)_aligned_malloc(sizeof(gameJournalRing), CACHE_LINE_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the game journal ring", 0, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	memset(g_p_journalRing, 0, sizeof(gameJournalRing));
+	for (cell = 0; cell < GAME_JOURNAL_RING_CAPACITY; cell++) g_p_journalRing->cells[cell].sequence = cell;
+	g_reportedDroppedRecords = 0;
+	if (NULL == (g_p_journalBatch = (gameJournalRecord*)calloc(sizeof(gameJournalRecord), GAME_JOURNAL_RING_CAPACITY))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the game journal batch", 0, 0);
+		destroyGameJournal();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Open the journal for appending only - records of previous runs are never rewritten
+	if (INVALID_HANDLE_VALUE == (g_h_journalFile = CreateFile(p_journalPath, FILE_APPEND_DATA, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to open the game journal file", GetLastError(), 0);
+		destroyGameJournal();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//A new session - the Game Room epochs start over
+	if (NULL != (p_cell = reserveJournalCell(&position))) publishJournalCell(p_cell, position, JOURNAL_RECORD_SESSION, 0);
+
+	//Start the writer thread
+	if (NULL == (g_h_journalWriterStopEvent = CreateEvent(NULL, TRUE, FALSE, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the game journal writer stop Event", GetLastError(), 0);
+		destroyGameJournal();
+		return STATUS_CODE_FAILURE;
+	}
+	if (INVALID_HANDLE_VALUE == (g_h_journalWriterThread = createThreadSimple((LPTHREAD_START_ROUTINE)journalWriterThreadRoutine, NULL, &threadId))) {
+		g_h_journalWriterThread = NULL;
+		destroyGameJournal();
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyGameJournal()
+{
+	flushGameJournal();
+
+	free(g_p_journalBatch);
+	g_p_journalBatch = NULL;
+	if (NULL != g_p_journalRing) {
+		_aligned_free(g_p_journalRing);
+		g_p_journalRing = NULL;
+	}
+}
+
+void flushGameJournal()
+{
+	//Stop the writer thread - it commits the remaining records on its way out
+	if (NULL != g_h_journalWriterThread) {
+		SetEvent(g_h_journalWriterStopEvent);
+		if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_journalWriterThread, WRITER_THREAD_EXIT_TIMEOUT))
+			LOG_EVENT(LOG_EVENT_TIMEOUT, "The game journal writer thread did not exit in time", 0, 0);
+		CloseHandle(g_h_journalWriterThread);
+		g_h_journalWriterThread = NULL;
+	}
+	if (NULL != g_h_journalWriterStopEvent) {
+		CloseHandle(g_h_journalWriterStopEvent);
+		g_h_journalWriterStopEvent = NULL;
+	}
+	if (INVALID_HANDLE_VALUE != g_h_journalFile) {
+		CloseHandle(g_h_journalFile);
+		g_h_journalFile = INVALID_HANDLE_VALUE;
+	}
+}
+
+void journalGamePairing(workingThreadPackage* p_params)
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	if (GAME_ROOM_OPENER_SLOT != p_params->gameRoomSlot) return;
+	if (NULL == (p_cell = reserveJournalCell(&position))) return;
+
+	copyJournalField(p_cell->record.openerField, p_params->p_selfPlayerName);
+	copyJournalField(p_cell->record.joinerField, p_params->p_otherPlayerName);
+	publishJournalCell(p_cell, position, JOURNAL_RECORD_PAIRING, p_params->gameRoomEpoch);
+}
+
+void journalGameSetup(workingThreadPackage* p_params)
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	if (GAME_ROOM_OPENER_SLOT != p_params->gameRoomSlot) return;
+	if (NULL == (p_cell = reserveJournalCell(&position))) return;
+
+	copyJournalField(p_cell->record.openerField, p_params->p_selfInitialNumber);
+	copyJournalField(p_cell->record.joinerField, p_params->p_otherInitialNumber);
+	p_cell->record.results[0] = p_params->p_gameRoom->variant.numberLength;
+	p_cell->record.results[1] = p_params->p_gameRoom->variant.alphabetSize;
+	p_cell->record.results[2] = (SHORT)p_params->p_gameRoom->variant.isRepeatAllowed;
+	publishJournalCell(p_cell, position, JOURNAL_RECORD_SETUP, p_params->gameRoomEpoch);
+}
+
+void journalGameRound(workingThreadPackage* p_params, SHORT selfGuessBulls, SHORT selfGuessCows, SHORT otherGuessBulls, SHORT otherGuessCows)
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	if (GAME_ROOM_OPENER_SLOT != p_params->gameRoomSlot) return;
+	if (NULL == (p_cell = reserveJournalCell(&position))) return;
+
+	copyJournalField(p_cell->record.openerField, p_params->p_selfCurrentGuess);
+	copyJournalField(p_cell->record.joinerField, p_params->p_otherCurrentGuess);
+	p_cell->record.results[0] = selfGuessBulls;
+	p_cell->record.results[1] = selfGuessCows;
+	p_cell->record.results[2] = otherGuessBulls;
+	p_cell->record.results[3] = otherGuessCows;
+	publishJournalCell(p_cell, position, JOURNAL_RECORD_ROUND, p_params->gameRoomEpoch);
+}
+
+void journalGameOutcome(workingThreadPackage* p_params, ratingOutcomes selfOutcome)
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	if (GAME_ROOM_OPENER_SLOT != p_params->gameRoomSlot) return;
+	if (NULL == (p_cell = reserveJournalCell(&position))) return;
+
+	p_cell->record.results[0] = (SHORT)selfOutcome;
+	publishJournalCell(p_cell, position, JOURNAL_RECORD_OUTCOME, p_params->gameRoomEpoch);
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static gameJournalCell* reserveJournalCell(LONG* p_position)
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0, observedPosition = 0, sequenceDifference = 0;
+	//Assert
+	assert(NULL != p_position);
+
+	if (NULL == g_p_journalRing) return NULL; //Not journaling
+
+	position = g_p_journalRing->enqueuePosition;
+	while (TRUE) {
+		p_cell = g_p_journalRing->cells + (position & GAME_JOURNAL_RING_MASK);
+		sequenceDifference = p_cell->sequence - position;
+		//The cell is free at this lap - take the position
+		if (0 == sequenceDifference) {
+			if (position == (observedPosition = InterlockedCompareExchange(&g_p_journalRing->enqueuePosition, position + 1, position))) break;
+			position = observedPosition;
+		}
+		//The cell still holds the previous lap's record - the ring is full (the writer is behind the disk)
+		else if (0 > sequenceDifference) {
+			InterlockedIncrement(&g_p_journalRing->droppedRecords);
+			return NULL;
+		}
+		//Another Worker thread took the position
+		else position = g_p_journalRing->enqueuePosition;
+	}
+
+	//No stale bytes of the previous lap reach the file
+	memset(&p_cell->record, 0, sizeof(gameJournalRecord));
+	*p_position = position;
+	return p_cell;
+}
+
+static void publishJournalCell(gameJournalCell* p_cell, LONG position, journalRecordTypes recordType, LONG gameEpoch)
+{
+	FILETIME now;
+	//Assert
+	assert(NULL != p_cell);
+
+	GetSystemTimeAsFileTime(&now);
+	p_cell->record.timestamp = ((LONGLONG)now.dwHighDateTime << 32) | (LONGLONG)now.dwLowDateTime;
+	p_cell->record.magic = GAME_JOURNAL_MAGIC;
+	p_cell->record.gameEpoch = gameEpoch;
+	p_cell->record.recordType = (SHORT)recordType;
+
+	//Publish the record (full barrier)
+	InterlockedExchange(&p_cell->sequence, position + 1);
+}
+
+static void copyJournalField(char* p_field, const char* p_string)
+{
+	int c = 0;
+	//Assert
+	assert(NULL != p_field);
+
+	if (NULL == p_string) return;
+	for (c = 0; (c < MAX_PLAYER_NAME_LEN) && ('\0' != p_string[c]); c++) p_field[c] = p_string[c];
+}
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Writer
+static BOOL WINAPI journalWriterThreadRoutine(LPVOID lpParam)
+{
+	BOOL isSucceeded = TRUE;
+
+	while (TRUE) {
+		switch (WaitForSingleObject(g_h_journalWriterStopEvent, GAME_JOURNAL_COMMIT_INTERVAL_MS)) {
+		case WAIT_TIMEOUT:
+			if (STATUS_CODE_FAILURE == commitGameJournalBatch()) isSucceeded = FALSE;
+			break;
+
+		case WAIT_OBJECT_0: //Stopped - the last commit, of the records journaled right before
+			if (STATUS_CODE_FAILURE == commitGameJournalBatch()) isSucceeded = FALSE;
+			return isSucceeded;
+
+		default:
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait on the game journal writer stop Event", GetLastError(), 0);
+			return STATUS_CODE_FAILURE;
+		}
+	}
+}
+
+static BOOL commitGameJournalBatch()
+{
+	gameJournalCell* p_cell = NULL;
+	LONG position = 0, droppedRecords = 0;
+	DWORD numOfRecords = 0, bytesToWrite = 0, bytesWritten = 0;
+
+	//Report the dropped records
+	if ((droppedRecords = g_p_journalRing->droppedRecords) != g_reportedDroppedRecords) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "Game journal records were dropped (the ring was full)", droppedRecords - g_reportedDroppedRecords, 0);
+		g_reportedDroppedRecords = droppedRecords;
+	}
+
+	//Copy the published records in position order, and release every cell to the next lap at once. Stop at the first record still being filled
+	position = g_p_journalRing->commitPosition;
+	for (numOfRecords = 0; numOfRecords < GAME_JOURNAL_RING_CAPACITY; numOfRecords++, position++) {
+		p_cell = g_p_journalRing->cells + (position & GAME_JOURNAL_RING_MASK);
+		if (position + 1 != p_cell->sequence) break;
+		g_p_journalBatch[numOfRecords] = p_cell->record;
+		InterlockedExchange(&p_cell->sequence, position + GAME_JOURNAL_RING_CAPACITY);
+	}
+	g_p_journalRing->commitPosition = position;
+	if (0 == numOfRecords) return STATUS_CODE_SUCCESS;
+
+	//Group commit - a single append & a single flush for the whole batch
+	bytesToWrite = numOfRecords * sizeof(gameJournalRecord);
+	if ((FALSE == WriteFile(g_h_journalFile, g_p_journalBatch, bytesToWrite, &bytesWritten, NULL)) || (bytesToWrite != bytesWritten)) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to append to the game journal file", GetLastError(), (int)numOfRecords);
+		return STATUS_CODE_FAILURE;
+	}
+	if (FALSE == FlushFileBuffers(g_h_journalFile)) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to flush the game journal file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
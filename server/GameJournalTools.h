@@ -0,0 +1,75 @@
+/* GameJournalTools.h
+------------------------------------------------------------------
+	Module Description - header module for GameJournalTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __GAME_JOURNAL_TOOLS_H__
+#define __GAME_JOURNAL_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function allocates the journal ring, opens the journal file for appending (creates it if missing), records a SESSION record
+/// and starts the writer thread, which commits the ring to the file every GAME_JOURNAL_COMMIT_INTERVAL_MS. Must be called once, before any Worker thread is created.
+/// Until it is called, games are not journaled
+/// </summary>
+/// <param name="const char* p_journalPath - path of the journal file (GAME_JOURNAL_PATH)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeGameJournal(const char* p_journalPath);
+
+/// <summary>
+/// Description - This function stops the writer thread after it commits the remaining records, closes the journal file and frees the ring.
+/// Must be called once, after all Worker threads ended
+/// </summary>
+void destroyGameJournal();
+
+/// <summary>
+/// Description - This function stops the writer thread after it commits the remaining records & closes the journal file, but leaves the ring to the
+/// Worker threads that still run (what they journal from now on is dropped). Called instead of destroyGameJournal() when the Server was handed off
+/// </summary>
+void flushGameJournal();
+
+/// <summary>
+/// Description - This function journals the pairing of a game (both players names). Only the Game Room opener journals - the joiner's call returns at once
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (Game Room slot & epoch, players names)"></param>
+void journalGamePairing(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - This function journals the setup of a game (both players initial numbers). Only the Game Room opener journals
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (Game Room slot & epoch, players initial numbers)"></param>
+void journalGameSetup(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - This function journals a round of a game (both players guesses & their bulls & cows). Only the Game Room opener journals
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (Game Room slot & epoch, players current guesses)"></param>
+/// <param name="SHORT selfGuessBulls - bulls of this thread's player guess"></param>
+/// <param name="SHORT selfGuessCows - cows of this thread's player guess"></param>
+/// <param name="SHORT otherGuessBulls - bulls of the opponent's guess"></param>
+/// <param name="SHORT otherGuessCows - cows of the opponent's guess"></param>
+void journalGameRound(workingThreadPackage* p_params, SHORT selfGuessBulls, SHORT selfGuessCows, SHORT otherGuessBulls, SHORT otherGuessCows);
+
+/// <summary>
+/// Description - This function journals the outcome of a game that ended with a winner or a draw (a game left by a player has no outcome record).
+/// Only the Game Room opener journals
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (Game Room slot & epoch)"></param>
+/// <param name="ratingOutcomes selfOutcome - RATING_OUTCOME_WIN, RATING_OUTCOME_DRAW or RATING_OUTCOME_LOSS, of this thread's player"></param>
+void journalGameOutcome(workingThreadPackage* p_params, ratingOutcomes selfOutcome);
+
+
+#endif //__GAME_JOURNAL_TOOLS_H__
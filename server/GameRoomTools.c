@@ -0,0 +1,221 @@
+/* GameRoomTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains functions meant for managing the state
+		of a Game Room, which is shared by the two Worker threads of a single game.
+		The state is kept in a single LONG "state word" that packs the room's phase,
+		a quit flag per player & an epoch that is renewed for every game:
+			<bits 16-30 epoch><bits 8-9 quit flags><bits 0-7 phase>
+		The word is accessed ONLY with Interlocked functions (no Mutex), and a
+		manual-reset quit Event is signaled whenever a quit flag is raised, so the
+		opponent's Worker thread is woken up immediately.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "GameRoomTools.h"
+#include "MemoryHandling.h"
+#include "ServerClientsTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+//0o0o0o Events initialization parameters values
+static const BOOL MANUAL_RESET = TRUE;
+static const BOOL INITIALLY_NON_SIGNALED = FALSE;
+
+static const BOOL RESET_EVENT_FAILED = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function atomically samples the Game Room state word (InterlockedCompareExchange with identical exchange & comparand values)
+/// </summary>
+/// <param name="gameRoom* p_gameRoom - pointer to the Game Room"></param>
+/// <returns>the current state word</returns>
+static LONG sampleGameRoomStateWord(gameRoom* p_gameRoom);
+
+/// <summary>
+/// Description - This function restores the "1st Player" Event to signaled & the "2nd Player" Event to non-signaled, which are the states
+/// the "Steps accessing" procedure expects when a new couple arrives. It is called ONLY by the last player to leave an abandoned room.
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (players Events)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL restorePlayersEventsToInitialStates(workingThreadPackage* p_params);
+
+
+// Functions definitions -------------------------------------------------------
+
+gameRoom* allocateMemoryForGameRoomAndCreateQuitEvent(const gameVariant* p_variant)
+{
+	gameRoom* p_gameRoom = NULL;
+	//Assert
+	assert(NULL != p_variant);
+
+	//gameRoom struct dynamic memory allocation - on a cache line of its own, since both Worker threads of a game write its state word
+	if (NULL == (p_gameRoom = (gameRoom*)_aligned_malloc(sizeof(gameRoom), CACHE_LINE_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a gameRoom struct", 0, 0);
+		return NULL;
+	}
+	//Zero the state word - IDLE phase, no quit flags, epoch 0
+	memset(p_gameRoom, 0, sizeof(gameRoom));
+	//The rules of the room's games - only read from now on
+	p_gameRoom->variant = *p_variant;
+
+	//Allocating dynamic memory (Heap) for the Game Room quit Event Handle & Creating the Event and fetching its handle's pointer
+	if (NULL == (p_gameRoom->p_h_roomQuitEvent = allocateMemoryForHandleAndCreateEvent(
+		MANUAL_RESET,					/* stays signaled, so EVERY following wait of the remaining player notices the quit */
+		INITIALLY_NON_SIGNALED,			/* no player has quit yet */
+		NULL))) {						/* un-named */
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to allocate memory for the Game Room quit Event Handle & to create the Event object", 0, 0);
+		_aligned_free(p_gameRoom);
+		return NULL;
+	}
+
+	//Game Room creation was successful
+	return p_gameRoom;
+}
+
+BOOL openGameRoomForNewGame(workingThreadPackage* p_params)
+{
+	LONG currentStateWord = 0;
+	//Assert
+	assert(NULL != p_params);
+	assert(NULL != p_params->p_gameRoom);
+
+	//Un-signal the quit Event BEFORE publishing the new epoch. A player that sees the new epoch is guaranteed to see a non-signaled Event
+	// unless one of the NEW couple quits
+	if (RESET_EVENT_FAILED == ResetEvent(*(p_params->p_gameRoom->p_h_roomQuitEvent))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set the Game Room quit event to non-signaled state", GetLastError(), 0);
+		SetEvent(*(p_params->p_h_errorEvent)); //reason: ResetEvent function failed
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Publish the next epoch with the SETUP phase and no quit flags. Only the SECOND ARRIVER gets here, while the FIRST ARRIVER is stuck
+	// on the "2nd Player" Event, so nothing else modifies the state word at this moment - a plain exchange is enough
+	currentStateWord = sampleGameRoomStateWord(p_params->p_gameRoom);
+	InterlockedExchange(&p_params->p_gameRoom->roomStateWord, GAME_ROOM_STATE_WORD(GAME_ROOM_EPOCH(currentStateWord) + 1, 0, GAME_ROOM_SETUP));
+
+	//The SECOND ARRIVER owns the opener slot
+	p_params->gameRoomSlot = GAME_ROOM_OPENER_SLOT;
+	return STATUS_CODE_SUCCESS;
+}
+
+void joinGameRoomCurrentEpoch(workingThreadPackage* p_params)
+{
+	//Assert
+	assert(NULL != p_params);
+	assert(NULL != p_params->p_gameRoom);
+
+	//Remember the epoch of this game. Quit flags raised in any other epoch (previous games) will be ignored
+	p_params->gameRoomEpoch = GAME_ROOM_EPOCH(sampleGameRoomStateWord(p_params->p_gameRoom));
+}
+
+void setGameRoomPhase(workingThreadPackage* p_params, gameRoomPhases phase)
+{
+	LONG currentStateWord = 0, updatedStateWord = 0;
+	//Assert
+	assert(NULL != p_params);
+	assert(NULL != p_params->p_gameRoom);
+
+	//Compare-and-swap loop - replace ONLY the phase bits, and ONLY while the room is still in this thread's epoch
+	do {
+		currentStateWord = sampleGameRoomStateWord(p_params->p_gameRoom);
+		if (p_params->gameRoomEpoch != GAME_ROOM_EPOCH(currentStateWord)) return; //Room was already re-opened for another game
+		updatedStateWord = (currentStateWord & ~GAME_ROOM_PHASE_MASK) | GAME_ROOM_PHASE(phase);
+	} while (currentStateWord != InterlockedCompareExchange(&p_params->p_gameRoom->roomStateWord, updatedStateWord, currentStateWord));
+}
+
+BOOL isOpponentQuitInGameRoom(workingThreadPackage* p_params)
+{
+	LONG currentStateWord = 0;
+	//Assert
+	assert(NULL != p_params);
+	assert(NULL != p_params->p_gameRoom);
+
+	currentStateWord = sampleGameRoomStateWord(p_params->p_gameRoom);
+	//The opponent's slot is the slot that isn't this thread's slot
+	return ((p_params->gameRoomEpoch == GAME_ROOM_EPOCH(currentStateWord)) &&
+		(0 != (currentStateWord & GAME_ROOM_QUIT_FLAG(1 - p_params->gameRoomSlot))));
+}
+
+BOOL raiseQuitFlagInGameRoomAndWakeOpponent(workingThreadPackage* p_params)
+{
+	LONG currentStateWord = 0, updatedStateWord = 0;
+	BOOL lastToLeaveBit = FALSE;
+	//Assert
+	assert(NULL != p_params);
+	assert(NULL != p_params->p_gameRoom);
+
+	//Compare-and-swap loop - raise this thread's quit flag ONLY while the room is still in this thread's epoch
+	do {
+		currentStateWord = sampleGameRoomStateWord(p_params->p_gameRoom);
+		if (p_params->gameRoomEpoch != GAME_ROOM_EPOCH(currentStateWord)) return STATUS_CODE_SUCCESS; //Room was already re-opened - nothing to notify
+		//If the opponent already left, this thread is the last one in the room and the room becomes CLOSED
+		lastToLeaveBit = (0 != (currentStateWord & GAME_ROOM_QUIT_FLAG(1 - p_params->gameRoomSlot)));
+		updatedStateWord = currentStateWord | GAME_ROOM_QUIT_FLAG(p_params->gameRoomSlot);
+		if (lastToLeaveBit) updatedStateWord = (updatedStateWord & ~GAME_ROOM_PHASE_MASK) | GAME_ROOM_CLOSED;
+	} while (currentStateWord != InterlockedCompareExchange(&p_params->p_gameRoom->roomStateWord, updatedStateWord, currentStateWord));
+
+	//Wake the opponent's Worker thread from any wait it is blocked on (players Events, recv(.))
+	if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_gameRoom->p_h_roomQuitEvent))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set the Game Room quit event to signaled state", GetLastError(), 0);
+		SetEvent(*(p_params->p_h_errorEvent)); //reason: SetEvent function failed
+		return STATUS_CODE_FAILURE;
+	}
+
+	//The last player to leave hands the players Events back to the next couple
+	if (lastToLeaveBit) return restorePlayersEventsToInitialStates(p_params);
+
+	return STATUS_CODE_SUCCESS;
+}
+
+
+
+
+//......................................Static functions..........................................
+
+static LONG sampleGameRoomStateWord(gameRoom* p_gameRoom)
+{
+	//Assert
+	assert(NULL != p_gameRoom);
+
+	//Exchange 0 with 0 - the state word is never modified, but the read is atomic and fenced
+	return InterlockedCompareExchange(&p_gameRoom->roomStateWord, 0, 0);
+}
+
+static BOOL restorePlayersEventsToInitialStates(workingThreadPackage* p_params)
+{
+	//Assert
+	assert(NULL != p_params);
+
+	//"1st Player" Event is initially signaled & "2nd Player" Event is initially non-signaled
+	if ((SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_firstPlayerEvent))) ||
+		(RESET_EVENT_FAILED == ResetEvent(*(p_params->p_h_secondPlayerEvent)))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to restore the players events to their initial states", GetLastError(), 0);
+		SetEvent(*(p_params->p_h_errorEvent)); //reason: SetEvent\ResetEvent functions failed
+		return STATUS_CODE_FAILURE;
+	}
+
+	return STATUS_CODE_SUCCESS;
+}
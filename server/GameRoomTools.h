@@ -0,0 +1,70 @@
+/* GameRoomTools.h
+---------------------------------------------------------------
+	Module Description - header module for GameRoomTools.c
+---------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __GAME_ROOM_TOOLS_H__
+#define __GAME_ROOM_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function allocates a 'gameRoom' struct, zeroes its state word (IDLE phase, no quit flags, epoch 0), sets the variant
+/// of its games and creates its manual-reset, initially non-signaled, quit Event
+/// </summary>
+/// <param name="const gameVariant* p_variant - the rules of the room's games"></param>
+/// <returns>pointer to the allocated Game Room, or NULL if failed</returns>
+gameRoom* allocateMemoryForGameRoomAndCreateQuitEvent(const gameVariant* p_variant);
+
+/// <summary>
+/// Description - This function is called by the SECOND ARRIVER of a new couple, while the FIRST ARRIVER is still stuck on the "2nd Player" Event.
+/// It opens a new epoch with the SETUP phase and no quit flags, so quit flags left by the previous game are ignored from now on, and un-signals the quit Event.
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (pointer to the Game Room)"></param>
+/// <returns>True if succeeded. False otherwise (after signaling the 'ERROR' event)</returns>
+BOOL openGameRoomForNewGame(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - This function atomically samples the Game Room state word and stores the current epoch in the thread's inputs package.
+/// It is called by both players after the names exchange, thus after the room was opened by the SECOND ARRIVER
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (pointer to the Game Room)"></param>
+void joinGameRoomCurrentEpoch(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - This function moves the Game Room to the given phase, only if the room is still in this thread's epoch. Quit flags are kept.
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (pointer to the Game Room)"></param>
+/// <param name="gameRoomPhases phase - the new phase"></param>
+void setGameRoomPhase(workingThreadPackage* p_params, gameRoomPhases phase);
+
+/// <summary>
+/// Description - This function atomically samples the Game Room state word and checks whether the opponent's quit flag was raised in this thread's epoch
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (pointer to the Game Room)"></param>
+/// <returns>True if the opponent quit the current game. False otherwise</returns>
+BOOL isOpponentQuitInGameRoom(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - This function raises this thread's quit flag in the Game Room state word (using InterlockedCompareExchange) and signals the quit Event,
+/// so the opponent's Worker thread wakes up immediately from any wait on the players Events or on recv(.). If the opponent's quit flag was already raised,
+/// this thread is the last to leave the room, so it also restores the "1st Player" & "2nd Player" Events to their initial states and closes the room.
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (pointer to the Game Room, players Events, 'ERROR' event)"></param>
+/// <returns>True if succeeded. False otherwise (after signaling the 'ERROR' event)</returns>
+BOOL raiseQuitFlagInGameRoomAndWakeOpponent(workingThreadPackage* p_params);
+
+
+#endif //__GAME_ROOM_TOOLS_H__
@@ -0,0 +1,490 @@
+/* HotRestartTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the Server's hot restart: 'restart' on
+		the Server's STDin hands the listening socket & the live Clients' connections
+		over to a new Server process, so an upgrade doesn't disconnect anyone.
+		The Worker threads park at their next wait for a Client or an opponent, the old
+		process starts the new one & duplicates the sockets for it (WSADuplicateSocket),
+		and sends them with the Game Room & the parked Worker threads state over an
+		anonymous pipe. Once the new process acknowledges, the old one leaves without
+		closing the connections, and the new one resumes every Worker thread at the
+		step it was parked at - GameSession.txt is re-opened on every access, so
+		nothing else is carried over.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "HotRestartTools.h"
+#include "MemoryHandling.h"
+#include "SessionTokenTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int SINGLE_OBJECT = 1;
+static const int SAMPLE = 0;
+static const DWORD HANDED_OFF_PROCESS_EXIT_CODE = 1;	// exit code of a new process terminated by the old one (restart cancelled)
+
+
+// Global variables ------------------------------------------------------------
+//New Server process - the state handed off by the old process & the sockets re-created from it
+static BOOL g_isHandedOffServer = FALSE;
+static hotRestartState g_handedOffState;
+static SOCKET g_s_handedOffListeningSocket = INVALID_SOCKET;
+static SOCKET g_s_handedOffConnections[NUM_OF_WORKER_THREADS];
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function waits until every live Worker thread is parked (HOT_RESTART_QUIESCE_TIMEOUT_MS at most)
+/// </summary>
+/// <param name="HANDLE* p_h_workersThreads - pointer to the Worker threads Handles array"></param>
+/// <param name="workingThreadPackage** p_p_threadPackages - pointer to the Worker threads packages array"></param>
+/// <returns>True if all are parked. False if timed out, or 'Exit'\'Error' was signaled meanwhile</returns>
+static BOOL awaitAllWorkerThreadsParked(HANDLE* p_h_workersThreads, workingThreadPackage** p_p_threadPackages);
+
+/// <summary>
+/// Description - This function checks whether a Worker thread serves a Client (its thread was created & didn't finish)
+/// </summary>
+/// <param name="HANDLE h_workerThread - Handle of the Worker thread (may be NULL)"></param>
+/// <returns>True if it does. False otherwise</returns>
+static BOOL isWorkerThreadAlive(HANDLE h_workerThread);
+
+/// <summary>
+/// Description - This function creates the state & acknowledgement pipes, and starts the new Server process inheriting ONLY its ends of them
+/// </summary>
+/// <param name="unsigned short serverPortNumber - the Server's port number"></param>
+/// <param name="const gameVariant* p_gameVariant - the Game Room's variant"></param>
+/// <param name="HANDLE* p_h_stateWrite - output: the old process end of the state pipe"></param>
+/// <param name="HANDLE* p_h_ackRead - output: the old process end of the acknowledgement pipe"></param>
+/// <param name="PROCESS_INFORMATION* p_processInfo - output: the new process information"></param>
+/// <returns>True if succeeded. False otherwise (nothing is left open)</returns>
+static BOOL startNewServerProcess(unsigned short serverPortNumber, const gameVariant* p_gameVariant, HANDLE* p_h_stateWrite, HANDLE* p_h_ackRead,
+	PROCESS_INFORMATION* p_processInfo);
+
+/// <summary>
+/// Description - This function fills the state sent to the new process - the duplicated sockets, the Game Room state word & the parked Worker threads state
+/// </summary>
+/// <param name="SOCKET* p_s_listeningSocket - pointer to the Server's listening socket"></param>
+/// <param name="HANDLE* p_h_workersThreads - pointer to the Worker threads Handles array"></param>
+/// <param name="workingThreadPackage** p_p_threadPackages - pointer to the Worker threads packages array"></param>
+/// <param name="DWORD newProcessId - the new Server process ID"></param>
+/// <param name="hotRestartState* p_state - output: the state"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL fillHotRestartState(SOCKET* p_s_listeningSocket, HANDLE* p_h_workersThreads, workingThreadPackage** p_p_threadPackages, DWORD newProcessId,
+	hotRestartState* p_state);
+
+/// <summary>
+/// Description - This function writes\reads a whole buffer to\from a pipe
+/// </summary>
+/// <param name="HANDLE h_pipe - the pipe end"></param>
+/// <param name="void* p_buffer - pointer to the buffer"></param>
+/// <param name="DWORD bufferSize - # of bytes"></param>
+/// <param name="BOOL isWrite - True to write, False to read"></param>
+/// <returns>True if all the bytes were transferred. False otherwise</returns>
+static BOOL transferWholeBufferThroughPipe(HANDLE h_pipe, void* p_buffer, DWORD bufferSize, BOOL isWrite);
+
+/// <summary>
+/// Description - This function re-creates the handed off sockets from their duplicated descriptions
+/// </summary>
+/// <returns>True if succeeded. False otherwise (nothing is left open)</returns>
+static BOOL createHandedOffSockets();
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL handOffServerToNewProcess(SOCKET* p_s_listeningSocket, HANDLE* p_h_workersThreads, workingThreadPackage** p_p_threadPackages,
+	unsigned short serverPortNumber, const gameVariant* p_gameVariant)
+{
+	HANDLE h_stateWrite = NULL, h_ackRead = NULL;
+	PROCESS_INFORMATION processInfo;
+	hotRestartState* p_state = NULL;
+	char ack = 0;
+	BOOL isHandedOff = FALSE;
+	//Input integrity validation
+	if ((NULL == p_s_listeningSocket) || (NULL == p_h_workersThreads) || (NULL == p_p_threadPackages) || (NULL == p_gameVariant)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+
+	printf("Restarting - waiting for the Worker threads to park...\n");
+	//1st - every Worker thread must be parked, so no socket is read or written while it is handed off
+	if ((STATUS_CODE_SUCCESS == awaitAllWorkerThreadsParked(p_h_workersThreads, p_p_threadPackages)) &&
+		//2nd - start the new process, then duplicate the sockets for it & send them with the state. The old process leaves only once the new one acknowledges
+		(STATUS_CODE_SUCCESS == startNewServerProcess(serverPortNumber, p_gameVariant, &h_stateWrite, &h_ackRead, &processInfo))) {
+
+		if (NULL == (p_state = (hotRestartState*)calloc(sizeof(hotRestartState), SINGLE_OBJECT)))
+			printf("Error: Failed to allocate memory for the hot restart state.\n");
+		else if ((STATUS_CODE_SUCCESS == fillHotRestartState(p_s_listeningSocket, p_h_workersThreads, p_p_threadPackages, processInfo.dwProcessId, p_state)) &&
+			(STATUS_CODE_SUCCESS == transferWholeBufferThroughPipe(h_stateWrite, p_state, sizeof(hotRestartState), TRUE)) &&
+			(STATUS_CODE_SUCCESS == transferWholeBufferThroughPipe(h_ackRead, &ack, sizeof(ack), FALSE)) && (HOT_RESTART_ACK == ack)) {
+			printf("The Server was handed over to process %lu with %d Client(s)\n", processInfo.dwProcessId, p_state->numOfConnections);
+			isHandedOff = TRUE;
+		}
+		else printf("Error: The new Server process did not take the Server over.\n");
+
+		//A new process that didn't acknowledge is terminated - the sockets stay with this one
+		if (FALSE == isHandedOff) TerminateProcess(processInfo.hProcess, HANDED_OFF_PROCESS_EXIT_CODE);
+		free(p_state);
+		CloseHandle(h_stateWrite);
+		CloseHandle(h_ackRead);
+		CloseHandle(processInfo.hThread);
+		CloseHandle(processInfo.hProcess);
+	}
+	if (TRUE == isHandedOff) return STATUS_CODE_SUCCESS;
+
+	//The restart is cancelled - the parked Worker threads go on (the restart Event is reset first, so they don't park again)
+	printf("The restart was cancelled, the Server goes on.\n");
+	ResetEvent(*(p_p_threadPackages[0]->p_h_handoffEvent));
+	if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_p_threadPackages[0]->p_h_handoffCancelEvent))) {
+		printf("Error: Failed to set the restart cancel Event to signaled state, with error code no. %ld.\n", GetLastError());
+		SetEvent(*(p_p_threadPackages[0]->p_h_errorEvent)); //The parked Worker threads are released by the 'Error' Event instead
+	}
+	return STATUS_CODE_FAILURE;
+}
+
+BOOL adoptHandedOffServer(const char* p_statePipeString, const char* p_ackPipeString, const char* p_oldProcessIdString)
+{
+	WSADATA wsaData;
+	HANDLE h_stateRead = NULL, h_ackWrite = NULL, h_oldProcess = NULL;
+	char ack = HOT_RESTART_ACK;
+	BOOL isAdopted = FALSE;
+	//Input integrity validation
+	if ((NULL == p_statePipeString) || (NULL == p_ackPipeString) || (NULL == p_oldProcessIdString)) return STATUS_CODE_FAILURE;
+
+	//The pipes' ends were inherited - their Handle values are the old process's
+	h_stateRead = (HANDLE)(ULONG_PTR)_strtoui64(p_statePipeString, NULL, 10);
+	h_ackWrite = (HANDLE)(ULONG_PTR)_strtoui64(p_ackPipeString, NULL, 10);
+	if (NULL == (h_oldProcess = OpenProcess(SYNCHRONIZE, FALSE, strtoul(p_oldProcessIdString, NULL, 10))))
+		printf("Error: Failed to open the old Server process, with error code no. %ld.\n", GetLastError());
+	else if (NO_ERROR != WSAStartup(MAKEWORD(2, 2), &wsaData))
+		printf("Error: Failed to initalize Winsock API using WSAStartup( ) with error code no. %ld.\n", WSAGetLastError());
+	else {
+		//Read the state & take the sockets, then acknowledge - from now on the old process leaves without closing the connections
+		if ((STATUS_CODE_SUCCESS == transferWholeBufferThroughPipe(h_stateRead, &g_handedOffState, sizeof(hotRestartState), FALSE)) &&
+			(HOT_RESTART_STATE_MAGIC == g_handedOffState.magic) && (0 <= g_handedOffState.numOfConnections) &&
+			(NUM_OF_WORKER_THREADS >= g_handedOffState.numOfConnections) && (STATUS_CODE_SUCCESS == createHandedOffSockets())) {
+			if (STATUS_CODE_SUCCESS == transferWholeBufferThroughPipe(h_ackWrite, &ack, sizeof(ack), TRUE)) isAdopted = TRUE;
+			else printf("Error: Failed to acknowledge the handed off Server, with error code no. %ld.\n", GetLastError());
+		}
+		else printf("Error: Failed to receive the handed off Server.\n");
+
+		if (FALSE == isAdopted) WSACleanup(); //Closes the sockets that were already created
+	}
+	CloseHandle(h_stateRead);
+	CloseHandle(h_ackWrite);
+
+	//The old process owns the game journal & the stores until it leaves - wait for it before they are opened
+	if ((TRUE == isAdopted) && (WAIT_OBJECT_0 != WaitForSingleObject(h_oldProcess, HOT_RESTART_OLD_PROCESS_EXIT_TIMEOUT_MS)))
+		printf("Warning: The old Server process did not leave in time, starting regardless.\n");
+	if (NULL != h_oldProcess) CloseHandle(h_oldProcess);
+
+	g_isHandedOffServer = isAdopted;
+	return isAdopted;
+}
+
+BOOL isHandedOffServer()
+{
+	return g_isHandedOffServer;
+}
+
+BOOL takeOverHandedOffListeningSocket(SOCKET** p_p_s_mainServerSocket, SOCKADDR_IN** p_p_service)
+{
+	int serviceLength = sizeof(SOCKADDR_IN);
+	//Input integrity validation
+	if ((NULL == p_p_s_mainServerSocket) || (NULL == p_p_service) || (FALSE == g_isHandedOffServer)) return STATUS_CODE_FAILURE;
+
+	//SOCKET & SOCKADDR_IN structs dynamic memory allocation - freed by closeListeningSocketProcedure(.), as a new listening socket's
+	if (NULL == (*p_p_s_mainServerSocket = (SOCKET*)calloc(sizeof(SOCKET), SINGLE_OBJECT))) {
+		printf("Error: Failed to allocate memory for a SOCKET struct.\n");
+		return STATUS_CODE_FAILURE;
+	}
+	if (NULL == (*p_p_service = (SOCKADDR_IN*)calloc(sizeof(SOCKADDR_IN), SINGLE_OBJECT))) {
+		printf("Error: Failed to allocate memory for a SOCKADDR_IN struct.\n");
+		free(*p_p_s_mainServerSocket);
+		*p_p_s_mainServerSocket = NULL;
+		return STATUS_CODE_FAILURE;
+	}
+
+	//The socket is already bound & listening - its local address is only kept
+	**p_p_s_mainServerSocket = g_s_handedOffListeningSocket;
+	g_s_handedOffListeningSocket = INVALID_SOCKET;
+	getsockname(**p_p_s_mainServerSocket, (SOCKADDR*)*p_p_service, &serviceLength);
+	return STATUS_CODE_SUCCESS;
+}
+
+void restoreHandedOffGameRoom(gameRoom* p_gameRoom)
+{
+	if ((NULL == p_gameRoom) || (FALSE == g_isHandedOffServer)) return;
+
+	InterlockedExchange(&p_gameRoom->roomStateWord, g_handedOffState.roomStateWord);
+	//A player that quit before the restart - its opponent must still be woken
+	if (0 != (g_handedOffState.roomStateWord & GAME_ROOM_QUIT_FLAGS_MASK)) SetEvent(*(p_gameRoom->p_h_roomQuitEvent));
+}
+
+int fetchNumOfHandedOffConnections()
+{
+	return (TRUE == g_isHandedOffServer) ? g_handedOffState.numOfConnections : 0;
+}
+
+SOCKET* restoreHandedOffConnection(int connectionIndex, workingThreadPackage* p_package)
+{
+	handedOffConnection* p_connection = NULL;
+	SOCKET* p_s_acceptSocket = NULL;
+	//Input integrity validation
+	if ((NULL == p_package) || (0 > connectionIndex) || (fetchNumOfHandedOffConnections() <= connectionIndex)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return NULL;
+	}
+	p_connection = &g_handedOffState.connections[connectionIndex];
+
+	//SOCKET struct dynamic memory allocation - as an accepted connection's
+	if (NULL == (p_s_acceptSocket = (SOCKET*)calloc(sizeof(SOCKET), SINGLE_OBJECT))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Handed off connection SOCKET", 0, 0);
+		closesocket(g_s_handedOffConnections[connectionIndex]);
+		return NULL;
+	}
+	*p_s_acceptSocket = g_s_handedOffConnections[connectionIndex];
+	g_s_handedOffConnections[connectionIndex] = INVALID_SOCKET;
+
+	//The Worker thread state - the strings' pointers point at the same inline storage they pointed at in the old process
+	p_package->resumePoint = p_connection->parkPoint;
+	p_package->gameRoomSlot = p_connection->gameRoomSlot;
+	p_package->gameRoomEpoch = p_connection->gameRoomEpoch;
+	p_package->gameRound = p_connection->gameRound;
+	p_package->playerNumbersStorage = p_connection->playerNumbersStorage;
+	p_package->playerNamesStorage = p_connection->playerNamesStorage;
+	p_package->p_selfPlayerName = (p_connection->setStrings & HOT_RESTART_SELF_NAME) ? p_package->playerNamesStorage.selfPlayerName : NULL;
+	p_package->p_otherPlayerName = (p_connection->setStrings & HOT_RESTART_OTHER_NAME) ? p_package->playerNamesStorage.otherPlayerName : NULL;
+	p_package->p_selfInitialNumber = (p_connection->setStrings & HOT_RESTART_SELF_INITIAL_NUMBER) ? p_package->playerNumbersStorage.selfInitialNumber : NULL;
+	p_package->p_otherInitialNumber = (p_connection->setStrings & HOT_RESTART_OTHER_INITIAL_NUMBER) ? p_package->playerNumbersStorage.otherInitialNumber : NULL;
+	p_package->p_selfCurrentGuess = (p_connection->setStrings & HOT_RESTART_SELF_GUESS) ? p_package->playerNumbersStorage.selfCurrentGuess : NULL;
+	p_package->p_otherCurrentGuess = (p_connection->setStrings & HOT_RESTART_OTHER_GUESS) ? p_package->playerNumbersStorage.otherCurrentGuess : NULL;
+	p_package->lastRoundResults = p_connection->lastRoundResults;
+	//The Client keeps its session - a drop after the restart is reattached as before it (a session that can't be registered is dropped)
+	p_package->sessionToken = p_connection->sessionToken;
+	restoreSession(p_package);
+
+	return p_s_acceptSocket;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL awaitAllWorkerThreadsParked(HANDLE* p_h_workersThreads, workingThreadPackage** p_p_threadPackages)
+{
+	HANDLE h_exitErrorEvents[2];
+	DWORD elapsedTime = 0;
+	int t = 0;
+	BOOL areAllParked = FALSE;
+	//Asserts
+	assert(NULL != p_h_workersThreads);
+	assert(NULL != p_p_threadPackages);
+
+	h_exitErrorEvents[0] = *(p_p_threadPackages[0]->p_h_exitEvent);
+	h_exitErrorEvents[1] = *(p_p_threadPackages[0]->p_h_errorEvent);
+
+	//Poll the park points - a Worker thread in the middle of a step (e.g. matchmaking, a GameSession.txt access) parks at its next wait
+	while (TRUE) {
+		for (t = 0, areAllParked = TRUE; (t < NUM_OF_WORKER_THREADS) && (TRUE == areAllParked); t++)
+			if ((TRUE == isWorkerThreadAlive(p_h_workersThreads[t])) && (WORKER_NOT_PARKED == InterlockedCompareExchange(&p_p_threadPackages[t]->parkPoint, 0, 0)))
+				areAllParked = FALSE;
+		if (TRUE == areAllParked) return STATUS_CODE_SUCCESS;
+
+		if (HOT_RESTART_QUIESCE_TIMEOUT_MS <= elapsedTime) {
+			printf("Error: Not every Worker thread parked within %d Seconds.\n", HOT_RESTART_QUIESCE_TIMEOUT_MS / 1000);
+			return STATUS_CODE_FAILURE;
+		}
+		//'Exit'\'Error' meanwhile - the Server exits instead
+		if (WAIT_TIMEOUT != WaitForMultipleObjects(2, h_exitErrorEvents, FALSE, HOT_RESTART_QUIESCE_POLL_MS)) return STATUS_CODE_FAILURE;
+		elapsedTime += HOT_RESTART_QUIESCE_POLL_MS;
+	}
+}
+
+static BOOL isWorkerThreadAlive(HANDLE h_workerThread)
+{
+	return (NULL != h_workerThread) && (WAIT_TIMEOUT == WaitForSingleObject(h_workerThread, SAMPLE));
+}
+
+static BOOL startNewServerProcess(unsigned short serverPortNumber, const gameVariant* p_gameVariant, HANDLE* p_h_stateWrite, HANDLE* p_h_ackRead,
+	PROCESS_INFORMATION* p_processInfo)
+{
+	SECURITY_ATTRIBUTES pipeAttributes = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE/*inheritable*/ };
+	STARTUPINFOEX startupInfo;
+	LPPROC_THREAD_ATTRIBUTE_LIST p_attributeList = NULL;
+	SIZE_T attributeListSize = 0;
+	HANDLE h_stateRead = NULL, h_ackWrite = NULL, h_inheritedHandles[2];
+	char modulePath[MAX_PATH], commandLine[HOT_RESTART_COMMAND_LINE_LEN];
+	BOOL isStarted = FALSE;
+	//Asserts
+	assert(NULL != p_gameVariant);
+	assert(NULL != p_h_stateWrite);
+	assert(NULL != p_h_ackRead);
+	assert(NULL != p_processInfo);
+
+	//State pipe: old -> new, acknowledgement pipe: new -> old. Only the new process's ends are inheritable
+	if (FALSE == CreatePipe(&h_stateRead, p_h_stateWrite, &pipeAttributes, sizeof(hotRestartState))) {
+		printf("Error: Failed to create the hot restart state pipe, with error code no. %ld.\n", GetLastError());
+		return STATUS_CODE_FAILURE;
+	}
+	if (FALSE == CreatePipe(p_h_ackRead, &h_ackWrite, &pipeAttributes, 0)) {
+		printf("Error: Failed to create the hot restart acknowledgement pipe, with error code no. %ld.\n", GetLastError());
+		CloseHandle(h_stateRead); CloseHandle(*p_h_stateWrite);
+		return STATUS_CODE_FAILURE;
+	}
+	SetHandleInformation(*p_h_stateWrite, HANDLE_FLAG_INHERIT, 0);
+	SetHandleInformation(*p_h_ackRead, HANDLE_FLAG_INHERIT, 0);
+
+	//server.exe <port> <variant> --handoff <state pipe> <ack pipe> <old process id>
+	if ((0 == GetModuleFileNameA(NULL, modulePath, sizeof(modulePath))) ||
+		(0 > _snprintf_s(commandLine, sizeof(commandLine), _TRUNCATE, "\"%s\" %hu %hdx%hd%s %s %llu %llu %lu", modulePath, serverPortNumber,
+			p_gameVariant->numberLength, p_gameVariant->alphabetSize, (TRUE == p_gameVariant->isRepeatAllowed) ? "r" : "", HOT_RESTART_ARGUMENT,
+			(unsigned long long)(ULONG_PTR)h_stateRead, (unsigned long long)(ULONG_PTR)h_ackWrite, GetCurrentProcessId())))
+		printf("Error: Failed to compose the new Server process command line.\n");
+
+	//The new process inherits ONLY the pipes' ends - not the sockets & Handles of this one (they are inheritable by default)
+	else if ((FALSE == InitializeProcThreadAttributeList(NULL, SINGLE_OBJECT, 0, &attributeListSize)) && (ERROR_INSUFFICIENT_BUFFER != GetLastError()))
+		printf("Error: Failed to size the new Server process attributes, with error code no. %ld.\n", GetLastError());
+	else if (NULL == (p_attributeList = (LPPROC_THREAD_ATTRIBUTE_LIST)malloc(attributeListSize)))
+		printf("Error: Failed to allocate memory for the new Server process attributes.\n");
+	else if (FALSE == InitializeProcThreadAttributeList(p_attributeList, SINGLE_OBJECT, 0, &attributeListSize))
+		printf("Error: Failed to initialize the new Server process attributes, with error code no. %ld.\n", GetLastError());
+	else {
+		h_inheritedHandles[0] = h_stateRead;
+		h_inheritedHandles[1] = h_ackWrite;
+		memset(&startupInfo, 0, sizeof(startupInfo));
+		startupInfo.StartupInfo.cb = sizeof(startupInfo);
+		if (FALSE == UpdateProcThreadAttribute(p_attributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST, h_inheritedHandles, sizeof(h_inheritedHandles), NULL, NULL))
+			printf("Error: Failed to set the new Server process inherited Handles, with error code no. %ld.\n", GetLastError());
+		else {
+			startupInfo.lpAttributeList = p_attributeList;
+			//The new process shares this console - it reads 'exit'\'restart' once this process leaves
+			if (FALSE == (isStarted = CreateProcessA(NULL, commandLine, NULL, NULL, TRUE/*inherit the listed Handles*/, EXTENDED_STARTUPINFO_PRESENT,
+				NULL, NULL, &startupInfo.StartupInfo, p_processInfo)))
+				printf("Error: Failed to start the new Server process, with error code no. %ld.\n", GetLastError());
+		}
+		DeleteProcThreadAttributeList(p_attributeList);
+	}
+	free(p_attributeList);
+
+	//The new process's ends are its own now (or nobody's)
+	CloseHandle(h_stateRead);
+	CloseHandle(h_ackWrite);
+	if (FALSE == isStarted) {
+		CloseHandle(*p_h_stateWrite);
+		CloseHandle(*p_h_ackRead);
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL fillHotRestartState(SOCKET* p_s_listeningSocket, HANDLE* p_h_workersThreads, workingThreadPackage** p_p_threadPackages, DWORD newProcessId,
+	hotRestartState* p_state)
+{
+	workingThreadPackage* p_package = NULL;
+	handedOffConnection* p_connection = NULL;
+	int t = 0;
+	//Asserts
+	assert(NULL != p_s_listeningSocket);
+	assert(NULL != p_h_workersThreads);
+	assert(NULL != p_p_threadPackages);
+	assert(NULL != p_state);
+
+	p_state->magic = HOT_RESTART_STATE_MAGIC;
+	p_state->roomStateWord = InterlockedCompareExchange(&p_p_threadPackages[0]->p_gameRoom->roomStateWord, 0, 0);
+	if (SOCKET_ERROR == WSADuplicateSocket(*p_s_listeningSocket, newProcessId, &p_state->listeningSocketInfo)) {
+		printf("Error: Failed to duplicate the listening socket, with error code no. %ld.\n", WSAGetLastError());
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Every parked Worker thread - its Client's socket & the state its steps left in the package
+	for (t = 0, p_state->numOfConnections = 0; t < NUM_OF_WORKER_THREADS; t++) {
+		p_package = p_p_threadPackages[t];
+		if (FALSE == isWorkerThreadAlive(p_h_workersThreads[t])) continue;
+		p_connection = &p_state->connections[p_state->numOfConnections];
+
+		if (SOCKET_ERROR == WSADuplicateSocket(*(p_package->p_s_acceptSocket), newProcessId, &p_connection->socketInfo)) {
+			printf("Error: Failed to duplicate a Client's socket, with error code no. %ld.\n", WSAGetLastError());
+			return STATUS_CODE_FAILURE;
+		}
+		p_connection->parkPoint = (workerParkPoints)InterlockedCompareExchange(&p_package->parkPoint, 0, 0);
+		p_connection->gameRoomSlot = p_package->gameRoomSlot;
+		p_connection->gameRoomEpoch = p_package->gameRoomEpoch;
+		p_connection->gameRound = p_package->gameRound;
+		p_connection->playerNumbersStorage = p_package->playerNumbersStorage;
+		p_connection->playerNamesStorage = p_package->playerNamesStorage;
+		p_connection->sessionToken = p_package->sessionToken;
+		p_connection->lastRoundResults = p_package->lastRoundResults;
+		p_connection->setStrings =
+			((NULL != p_package->p_selfPlayerName) ? HOT_RESTART_SELF_NAME : 0) |
+			((NULL != p_package->p_otherPlayerName) ? HOT_RESTART_OTHER_NAME : 0) |
+			((NULL != p_package->p_selfInitialNumber) ? HOT_RESTART_SELF_INITIAL_NUMBER : 0) |
+			((NULL != p_package->p_otherInitialNumber) ? HOT_RESTART_OTHER_INITIAL_NUMBER : 0) |
+			((NULL != p_package->p_selfCurrentGuess) ? HOT_RESTART_SELF_GUESS : 0) |
+			((NULL != p_package->p_otherCurrentGuess) ? HOT_RESTART_OTHER_GUESS : 0);
+		p_state->numOfConnections++;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL transferWholeBufferThroughPipe(HANDLE h_pipe, void* p_buffer, DWORD bufferSize, BOOL isWrite)
+{
+	DWORD transferred = 0, totalTransferred = 0;
+	BOOL isSucceeded = FALSE;
+	//Assert
+	assert(NULL != p_buffer);
+
+	//A pipe may transfer fewer bytes than asked for - loop until the whole buffer was transferred (a broken pipe fails)
+	while (totalTransferred < bufferSize) {
+		isSucceeded = (TRUE == isWrite) ?
+			WriteFile(h_pipe, (char*)p_buffer + totalTransferred, bufferSize - totalTransferred, &transferred, NULL) :
+			ReadFile(h_pipe, (char*)p_buffer + totalTransferred, bufferSize - totalTransferred, &transferred, NULL);
+		if ((FALSE == isSucceeded) || (0 == transferred)) return STATUS_CODE_FAILURE;
+		totalTransferred += transferred;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL createHandedOffSockets()
+{
+	int c = 0;
+
+	//The sockets keep their state - the listening socket its backlog, the Clients' sockets their pending data
+	if (INVALID_SOCKET == (g_s_handedOffListeningSocket = WSASocket(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO,
+		&g_handedOffState.listeningSocketInfo, 0, WSA_FLAG_OVERLAPPED))) {
+		printf("Error: Failed to create the handed off listening socket, with error code no. %ld.\n", WSAGetLastError());
+		return STATUS_CODE_FAILURE;
+	}
+	for (c = 0; c < g_handedOffState.numOfConnections; c++)
+		if (INVALID_SOCKET == (g_s_handedOffConnections[c] = WSASocket(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO,
+			&g_handedOffState.connections[c].socketInfo, 0, WSA_FLAG_OVERLAPPED))) {
+			printf("Error: Failed to create a handed off Client's socket, with error code no. %ld.\n", WSAGetLastError());
+			return STATUS_CODE_FAILURE; //The created sockets are closed by WSACleanup(.)
+		}
+	return STATUS_CODE_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/* HotRestartTools.h
+------------------------------------------------------------------
+	Module Description - header module for HotRestartTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __HOT_RESTART_TOOLS_H__
+#define __HOT_RESTART_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+//....Old Server process
+
+/// <summary>
+/// Description - This function hands the Server over to a new Server process (hot restart): it waits until every Worker thread is parked,
+/// starts the new process (the same executable, port & variant), duplicates the listening socket & the parked Clients' sockets for it, and sends
+/// them with the Game Room & the Worker threads state over an anonymous pipe. If anything fails before the new process acknowledges, the new
+/// process is terminated & the parked Worker threads are released (the restart is cancelled)
+/// </summary>
+/// <param name="SOCKET* p_s_listeningSocket - pointer to the Server's listening socket"></param>
+/// <param name="HANDLE* p_h_workersThreads - pointer to the Worker threads Handles array"></param>
+/// <param name="workingThreadPackage** p_p_threadPackages - pointer to the Worker threads packages array"></param>
+/// <param name="unsigned short serverPortNumber - the Server's port number"></param>
+/// <param name="const gameVariant* p_gameVariant - the Game Room's variant"></param>
+/// <returns>True if the new process owns the sockets - the old process must leave without closing the Clients' connections. False otherwise</returns>
+BOOL handOffServerToNewProcess(SOCKET* p_s_listeningSocket, HANDLE* p_h_workersThreads, workingThreadPackage** p_p_threadPackages,
+	unsigned short serverPortNumber, const gameVariant* p_gameVariant);
+
+
+//....New Server process
+
+/// <summary>
+/// Description - This function receives the Server from the old Server process: it reads the state from the pipe, re-creates the sockets from their
+/// duplicated descriptions, acknowledges, and waits for the old process to leave (it owns the game journal & the stores until then).
+/// Must be called before anything else is initialized
+/// </summary>
+/// <param name="const char* p_statePipeString - the inherited read Handle of the state pipe (decimal)"></param>
+/// <param name="const char* p_ackPipeString - the inherited write Handle of the acknowledgement pipe (decimal)"></param>
+/// <param name="const char* p_oldProcessIdString - the old Server process ID (decimal)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL adoptHandedOffServer(const char* p_statePipeString, const char* p_ackPipeString, const char* p_oldProcessIdString);
+
+/// <summary>
+/// Description - This function checks whether the Server was handed off by an old Server process (adoptHandedOffServer(.) succeeded)
+/// </summary>
+/// <returns>True if handed off. False otherwise</returns>
+BOOL isHandedOffServer();
+
+/// <summary>
+/// Description - This function allocates the SOCKET & SOCKADDR_IN structs of the handed off listening socket, as socketCreationAndLocalAddressBindingAndListening(.)
+/// does for a new one. The socket is already bound & listening
+/// </summary>
+/// <param name="SOCKET** p_p_s_mainServerSocket - pointer address to a SOCKET struct"></param>
+/// <param name="SOCKADDR_IN** p_p_service - pointer address to a SOCKADDR_IN struct"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL takeOverHandedOffListeningSocket(SOCKET** p_p_s_mainServerSocket, SOCKADDR_IN** p_p_service);
+
+/// <summary>
+/// Description - This function restores the handed off Game Room state word, and signals the quit Event if a player had already quit
+/// </summary>
+/// <param name="gameRoom* p_gameRoom - pointer to the Game Room"></param>
+void restoreHandedOffGameRoom(gameRoom* p_gameRoom);
+
+/// <summary>
+/// Description - This function fetches the # of handed off Clients' connections
+/// </summary>
+/// <returns># of connections (0 if the Server was not handed off)</returns>
+int fetchNumOfHandedOffConnections();
+
+/// <summary>
+/// Description - This function restores a handed off Worker thread state into a package - its Game Room slot & epoch, its players' strings & the
+/// step it resumes at - and allocates its Client's SOCKET struct, as an accepted connection's
+/// </summary>
+/// <param name="int connectionIndex - index of the handed off connection"></param>
+/// <param name="workingThreadPackage* p_package - the package of the Worker thread that will serve the connection"></param>
+/// <returns>pointer to the connection's SOCKET struct. NULL if failed (the socket is closed)</returns>
+SOCKET* restoreHandedOffConnection(int connectionIndex, workingThreadPackage* p_package);
+
+
+#endif //__HOT_RESTART_TOOLS_H__
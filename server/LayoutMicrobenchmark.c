@@ -0,0 +1,381 @@
+/* LayoutMicrobenchmark.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains a microbenchmark of the Worker threads
+		packages layout, built ONLY when LAYOUT_MICROBENCHMARK is defined:
+		(1) Game round - the fields a round reads & writes (socket, Game Room state
+			word, guesses & initial numbers) are accessed in a random packages order,
+			once over the previous layout (package & every string allocated one by
+			one) and once over the contiguous, cache line aligned, packages array
+			with the hot fields first and the strings inline.
+		(2) False sharing - NUM_OF_WORKER_THREADS threads increment a counter of
+			their own, once with all counters in one cache line & once with every
+			counter padded to a cache line.
+		The times are measured with QueryPerformanceCounter(.) & printed.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef LAYOUT_MICROBENCHMARK
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "LayoutMicrobenchmark.h"
+#include "MemoryHandling.h"
+
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int SINGLE_OBJECT = 1;
+
+//0o0o0o Game round measurement
+static const int NUM_OF_BENCHMARK_PACKAGES = 1 << 16;	// far more packages than fit in the caches, so every access pattern is a memory pattern
+static const int NUM_OF_BENCHMARK_PASSES = 20;			// every pass plays one round of every package
+
+//0o0o0o False sharing measurement
+static const LONG NUM_OF_COUNTER_INCREMENTS = 50000000;
+static const BOOL MANUAL_RESET = TRUE;
+static const BOOL INITIALLY_NON_SIGNALED = FALSE;
+
+static const double NANOSECONDS_IN_SECOND = 1000000000.0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function plays the memory accesses of a single game round of some package: reads the socket & the Game Room state word,
+/// scores the guess against the opponent's initial number (bulls & cows) and writes the next guess
+/// </summary>
+/// <returns>a value depending on everything read, so the accesses are not optimized away</returns>
+static int playBenchmarkRound(SOCKET* p_s_acceptSocket, gameRoom* p_gameRoom, char* p_selfCurrentGuess, char* p_otherInitialNumber);
+
+/// <summary>
+/// Description - This function fills the given array with a random permutation of 0..numOfIndices-1 (Fisher-Yates), the packages visiting order
+/// </summary>
+static void shuffleBenchmarkOrder(int* p_order, int numOfIndices);
+
+/// <summary>
+/// Description - This function measures the game round over the previous & the current packages layouts and prints the results
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL measureGameRoundLayouts();
+
+/// <summary>
+/// Description - This function measures NUM_OF_WORKER_THREADS threads incrementing packed counters vs padded counters and prints the results
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL measureCountersFalseSharing();
+
+/// <summary>
+/// Description - This function creates NUM_OF_WORKER_THREADS counting threads, one per given counter, releases them at once & waits for all of them
+/// </summary>
+/// <param name="volatile LONG** p_p_counters - array of pointers to the counters"></param>
+/// <param name="double* p_elapsedNanoseconds - pointer to the measured time (output)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL runCountingThreads(volatile LONG** p_p_counters, double* p_elapsedNanoseconds);
+
+/// <summary>
+/// Description - Thread routine - waits for the start Event and increments its counter NUM_OF_COUNTER_INCREMENTS times
+/// </summary>
+/// <param name="LPVOID lpParam - pointer to a 'benchmarkCounterPackage' struct"></param>
+/// <returns>0</returns>
+static DWORD WINAPI countingThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function converts the given QueryPerformanceCounter(.) ticks interval to nanoseconds
+/// </summary>
+static double convertTicksToNanoseconds(LARGE_INTEGER startTicks, LARGE_INTEGER endTicks);
+
+
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runLayoutMicrobenchmark()
+{
+	printf("Layout microbenchmark: %d packages (%d bytes each, cache line %d bytes), %d passes\n\n",
+		NUM_OF_BENCHMARK_PACKAGES, (int)sizeof(workingThreadPackage), CACHE_LINE_SIZE, NUM_OF_BENCHMARK_PASSES);
+
+	if (STATUS_CODE_FAILURE == measureGameRoundLayouts()) return STATUS_CODE_FAILURE;
+	if (STATUS_CODE_FAILURE == measureCountersFalseSharing()) return STATUS_CODE_FAILURE;
+
+	return STATUS_CODE_SUCCESS;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static int playBenchmarkRound(SOCKET* p_s_acceptSocket, gameRoom* p_gameRoom, char* p_selfCurrentGuess, char* p_otherInitialNumber)
+{
+	int bulls = 0, cows = 0, d = 0, o = 0;
+	char nextDigit = 0;
+
+	//Score the guess (bulls & cows) against the opponent's initial number
+	for (d = 0; d < PLAYER_NUMBER_LEN; d++)
+		for (o = 0; o < PLAYER_NUMBER_LEN; o++)
+			if (p_selfCurrentGuess[d] == p_otherInitialNumber[o]) {
+				if (d == o) bulls++;
+				else cows++;
+			}
+
+	//Write the next guess (rotate its digits)
+	nextDigit = p_selfCurrentGuess[0];
+	for (d = 0; d < PLAYER_NUMBER_LEN - 1; d++) p_selfCurrentGuess[d] = p_selfCurrentGuess[d + 1];
+	p_selfCurrentGuess[PLAYER_NUMBER_LEN - 1] = nextDigit;
+
+	return (int)*p_s_acceptSocket + (int)p_gameRoom->roomStateWord + (bulls * 10) + cows;
+}
+
+static void shuffleBenchmarkOrder(int* p_order, int numOfIndices)
+{
+	int i = 0, j = 0, temp = 0;
+
+	for (i = 0; i < numOfIndices; i++) p_order[i] = i;
+	//rand(.) is 15 bits wide - combine two calls for the larger arrays
+	for (i = numOfIndices - 1; i > 0; i--) {
+		j = ((rand() << 15) | rand()) % (i + 1);
+		temp = p_order[i]; p_order[i] = p_order[j]; p_order[j] = temp;
+	}
+}
+
+static BOOL measureGameRoundLayouts()
+{
+	legacyThreadPackage** p_p_legacyPackages = NULL;
+	workingThreadPackage* p_packagesBlock = NULL;
+	gameRoom* p_gameRoom = NULL;
+	int* p_order = NULL;
+	int p = 0, pass = 0, sink = 0;
+	BOOL allocationsSucceeded = TRUE, packagesBlockZeroed = FALSE;
+	LARGE_INTEGER startTicks, endTicks;
+	double legacyNanoseconds = 0, contiguousNanoseconds = 0;
+
+	//Shared allocations: the Game Room (single, as in the Server), the visiting order & the packages arrays
+	p_gameRoom = (gameRoom*)_aligned_malloc(sizeof(gameRoom), CACHE_LINE_SIZE);
+	p_order = (int*)calloc(sizeof(int), NUM_OF_BENCHMARK_PACKAGES);
+	p_p_legacyPackages = (legacyThreadPackage**)calloc(sizeof(legacyThreadPackage*), NUM_OF_BENCHMARK_PACKAGES);
+	p_packagesBlock = (workingThreadPackage*)_aligned_malloc(sizeof(workingThreadPackage) * NUM_OF_BENCHMARK_PACKAGES, CACHE_LINE_SIZE);
+	if ((NULL == p_gameRoom) || (NULL == p_order) || (NULL == p_p_legacyPackages) || (NULL == p_packagesBlock)) {
+		printf("Error: Failed to allocate memory for the game round measurement.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		allocationsSucceeded = FALSE;
+	}
+	else {
+		memset(p_gameRoom, 0, sizeof(gameRoom));
+		memset(p_packagesBlock, 0, sizeof(workingThreadPackage) * NUM_OF_BENCHMARK_PACKAGES);
+		packagesBlockZeroed = TRUE;
+		shuffleBenchmarkOrder(p_order, NUM_OF_BENCHMARK_PACKAGES);
+	}
+
+	//Previous layout - every package, socket & string allocated one by one (as the Worker threads did when a connection\message arrived)
+	for (p = 0; (TRUE == allocationsSucceeded) && (p < NUM_OF_BENCHMARK_PACKAGES); p++) {
+		if ((NULL == (*(p_p_legacyPackages + p) = (legacyThreadPackage*)calloc(sizeof(legacyThreadPackage), SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_s_acceptSocket = (SOCKET*)calloc(sizeof(SOCKET), SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_selfPlayerName = (char*)calloc(MAX_PLAYER_NAME_LEN + 1, SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_otherPlayerName = (char*)calloc(MAX_PLAYER_NAME_LEN + 1, SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_selfInitialNumber = (char*)calloc(PLAYER_NUMBER_LEN + 1, SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_otherInitialNumber = (char*)calloc(PLAYER_NUMBER_LEN + 1, SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_selfCurrentGuess = (char*)calloc(PLAYER_NUMBER_LEN + 1, SINGLE_OBJECT))) ||
+			(NULL == ((*(p_p_legacyPackages + p))->p_otherCurrentGuess = (char*)calloc(PLAYER_NUMBER_LEN + 1, SINGLE_OBJECT)))) {
+			printf("Error: Failed to allocate memory for a legacy package of the game round measurement.\n");
+			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			allocationsSucceeded = FALSE;
+			break;
+		}
+		(*(p_p_legacyPackages + p))->p_gameRoom = p_gameRoom;
+		*(*(p_p_legacyPackages + p))->p_s_acceptSocket = (SOCKET)p;
+		memcpy((*(p_p_legacyPackages + p))->p_selfCurrentGuess, "1234", PLAYER_NUMBER_LEN);
+		memcpy((*(p_p_legacyPackages + p))->p_otherInitialNumber, "4321", PLAYER_NUMBER_LEN);
+	}
+
+	//Current layout - the packages block, strings inline (the accept socket is still allocated per connection)
+	for (p = 0; (TRUE == allocationsSucceeded) && (p < NUM_OF_BENCHMARK_PACKAGES); p++) {
+		if (NULL == ((p_packagesBlock + p)->p_s_acceptSocket = (SOCKET*)calloc(sizeof(SOCKET), SINGLE_OBJECT))) {
+			printf("Error: Failed to allocate memory for a socket of the game round measurement.\n");
+			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			allocationsSucceeded = FALSE;
+			break;
+		}
+		(p_packagesBlock + p)->p_gameRoom = p_gameRoom;
+		*(p_packagesBlock + p)->p_s_acceptSocket = (SOCKET)p;
+		(p_packagesBlock + p)->p_selfCurrentGuess = (p_packagesBlock + p)->playerNumbersStorage.selfCurrentGuess;
+		(p_packagesBlock + p)->p_otherInitialNumber = (p_packagesBlock + p)->playerNumbersStorage.otherInitialNumber;
+		memcpy((p_packagesBlock + p)->p_selfCurrentGuess, "1234", PLAYER_NUMBER_LEN);
+		memcpy((p_packagesBlock + p)->p_otherInitialNumber, "4321", PLAYER_NUMBER_LEN);
+	}
+
+	if (TRUE == allocationsSucceeded) {
+		//Previous layout
+		QueryPerformanceCounter(&startTicks);
+		for (pass = 0; pass < NUM_OF_BENCHMARK_PASSES; pass++)
+			for (p = 0; p < NUM_OF_BENCHMARK_PACKAGES; p++)
+				sink += playBenchmarkRound((*(p_p_legacyPackages + p_order[p]))->p_s_acceptSocket, (*(p_p_legacyPackages + p_order[p]))->p_gameRoom,
+					(*(p_p_legacyPackages + p_order[p]))->p_selfCurrentGuess, (*(p_p_legacyPackages + p_order[p]))->p_otherInitialNumber);
+		QueryPerformanceCounter(&endTicks);
+		legacyNanoseconds = convertTicksToNanoseconds(startTicks, endTicks);
+
+		//Current layout
+		QueryPerformanceCounter(&startTicks);
+		for (pass = 0; pass < NUM_OF_BENCHMARK_PASSES; pass++)
+			for (p = 0; p < NUM_OF_BENCHMARK_PACKAGES; p++)
+				sink += playBenchmarkRound((p_packagesBlock + p_order[p])->p_s_acceptSocket, (p_packagesBlock + p_order[p])->p_gameRoom,
+					(p_packagesBlock + p_order[p])->p_selfCurrentGuess, (p_packagesBlock + p_order[p])->p_otherInitialNumber);
+		QueryPerformanceCounter(&endTicks);
+		contiguousNanoseconds = convertTicksToNanoseconds(startTicks, endTicks);
+
+		printf("Game round (random package order):\n");
+		printf("\tprevious layout   - %8.2f ns per round\n", legacyNanoseconds / ((double)NUM_OF_BENCHMARK_PASSES * NUM_OF_BENCHMARK_PACKAGES));
+		printf("\tcontiguous layout - %8.2f ns per round\n", contiguousNanoseconds / ((double)NUM_OF_BENCHMARK_PASSES * NUM_OF_BENCHMARK_PACKAGES));
+		printf("\tspeedup           - %8.2fx\t(checksum %d)\n\n", legacyNanoseconds / contiguousNanoseconds, sink);
+	}
+
+	//Free everything allocated (the packages were zeroed, so unallocated pointers are NULL)
+	for (p = 0; (NULL != p_p_legacyPackages) && (p < NUM_OF_BENCHMARK_PACKAGES); p++) {
+		if (NULL == *(p_p_legacyPackages + p)) continue;
+		free((*(p_p_legacyPackages + p))->p_s_acceptSocket);
+		free((*(p_p_legacyPackages + p))->p_selfPlayerName);
+		free((*(p_p_legacyPackages + p))->p_otherPlayerName);
+		free((*(p_p_legacyPackages + p))->p_selfInitialNumber);
+		free((*(p_p_legacyPackages + p))->p_otherInitialNumber);
+		free((*(p_p_legacyPackages + p))->p_selfCurrentGuess);
+		free((*(p_p_legacyPackages + p))->p_otherCurrentGuess);
+		free(*(p_p_legacyPackages + p));
+	}
+	for (p = 0; (TRUE == packagesBlockZeroed) && (p < NUM_OF_BENCHMARK_PACKAGES); p++)
+		free((p_packagesBlock + p)->p_s_acceptSocket);
+	free(p_p_legacyPackages);
+	free(p_order);
+	_aligned_free(p_packagesBlock);
+	_aligned_free(p_gameRoom);
+
+	return allocationsSucceeded;
+}
+
+static BOOL measureCountersFalseSharing()
+{
+	benchmarkPackedCounters* p_packedCounters = NULL;
+	benchmarkPaddedCounter* p_paddedCounters = NULL;
+	volatile LONG* p_counters[NUM_OF_WORKER_THREADS] = { NULL };
+	double packedNanoseconds = 0, paddedNanoseconds = 0;
+	int th = 0;
+	BOOL measurementSucceeded = FALSE;
+
+	p_packedCounters = (benchmarkPackedCounters*)_aligned_malloc(sizeof(benchmarkPackedCounters), CACHE_LINE_SIZE);
+	p_paddedCounters = (benchmarkPaddedCounter*)_aligned_malloc(sizeof(benchmarkPaddedCounter) * NUM_OF_WORKER_THREADS, CACHE_LINE_SIZE);
+	if ((NULL == p_packedCounters) || (NULL == p_paddedCounters)) {
+		printf("Error: Failed to allocate memory for the false sharing measurement counters.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	}
+	else {
+		memset(p_packedCounters, 0, sizeof(benchmarkPackedCounters));
+		memset(p_paddedCounters, 0, sizeof(benchmarkPaddedCounter) * NUM_OF_WORKER_THREADS);
+
+		//Packed - all counters in a single cache line
+		for (th = 0; th < NUM_OF_WORKER_THREADS; th++) p_counters[th] = &p_packedCounters->counters[th];
+		if (STATUS_CODE_SUCCESS == runCountingThreads(p_counters, &packedNanoseconds)) {
+			//Padded - a cache line per counter
+			for (th = 0; th < NUM_OF_WORKER_THREADS; th++) p_counters[th] = &(p_paddedCounters + th)->counter;
+			if (STATUS_CODE_SUCCESS == runCountingThreads(p_counters, &paddedNanoseconds)) {
+				printf("Per-thread counters (%d threads, %ld increments each):\n", NUM_OF_WORKER_THREADS, NUM_OF_COUNTER_INCREMENTS);
+				printf("\tpacked (one cache line)   - %8.2f ms\n", packedNanoseconds / 1000000.0);
+				printf("\tpadded (line per counter) - %8.2f ms\n", paddedNanoseconds / 1000000.0);
+				printf("\tspeedup                   - %8.2fx\n\n", packedNanoseconds / paddedNanoseconds);
+				measurementSucceeded = TRUE;
+			}
+		}
+	}
+
+	_aligned_free(p_packedCounters);
+	_aligned_free(p_paddedCounters);
+	return measurementSucceeded;
+}
+
+static BOOL runCountingThreads(volatile LONG** p_p_counters, double* p_elapsedNanoseconds)
+{
+	benchmarkCounterPackage counterPackages[NUM_OF_WORKER_THREADS];
+	HANDLE h_countingThreads[NUM_OF_WORKER_THREADS] = { NULL };
+	HANDLE h_startEvent = NULL;
+	LARGE_INTEGER startTicks, endTicks;
+	int th = 0, numOfCreatedThreads = 0;
+	BOOL measurementSucceeded = TRUE;
+
+	//Manual-reset Event, so a single SetEvent(.) releases all counting threads
+	if (NULL == (h_startEvent = CreateEvent(NULL, MANUAL_RESET, INITIALLY_NON_SIGNALED, NULL))) {
+		printf("Error: Failed to create the counting threads start Event with code: %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		return STATUS_CODE_FAILURE;
+	}
+
+	for (th = 0; th < NUM_OF_WORKER_THREADS; th++) {
+		counterPackages[th].p_counter = p_p_counters[th];
+		counterPackages[th].p_h_startEvent = &h_startEvent;
+		if (NULL == (h_countingThreads[th] = CreateThread(NULL, 0, countingThreadRoutine, &counterPackages[th], 0, NULL))) {
+			printf("Error: Failed to create a counting thread with code: %ld.\n", GetLastError());
+			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			measurementSucceeded = FALSE;
+			break;
+		}
+		numOfCreatedThreads++;
+	}
+
+	//Release the threads (also when not all were created - so the created ones end) and wait for all of them
+	QueryPerformanceCounter(&startTicks);
+	SetEvent(h_startEvent);
+	if ((0 < numOfCreatedThreads) && (WAIT_FAILED == WaitForMultipleObjects(numOfCreatedThreads, h_countingThreads, TRUE, INFINITE))) {
+		printf("Error: Failed to wait for the counting threads with code: %ld.\n", GetLastError());
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		measurementSucceeded = FALSE;
+	}
+	QueryPerformanceCounter(&endTicks);
+	*p_elapsedNanoseconds = convertTicksToNanoseconds(startTicks, endTicks);
+
+	for (th = 0; th < numOfCreatedThreads; th++) CloseHandle(h_countingThreads[th]);
+	CloseHandle(h_startEvent);
+	return measurementSucceeded;
+}
+
+static DWORD WINAPI countingThreadRoutine(LPVOID lpParam)
+{
+	benchmarkCounterPackage* p_package = (benchmarkCounterPackage*)lpParam;
+	LONG i = 0;
+	//Assert
+	assert(NULL != p_package);
+
+	WaitForSingleObject(*p_package->p_h_startEvent, INFINITE);
+	//Plain (volatile) increments - every one of them writes the counter's cache line
+	for (i = 0; i < NUM_OF_COUNTER_INCREMENTS; i++) (*p_package->p_counter)++;
+
+	return 0;
+}
+
+static double convertTicksToNanoseconds(LARGE_INTEGER startTicks, LARGE_INTEGER endTicks)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return ((double)(endTicks.QuadPart - startTicks.QuadPart) * NANOSECONDS_IN_SECOND) / (double)frequency.QuadPart;
+}
+
+#endif //LAYOUT_MICROBENCHMARK
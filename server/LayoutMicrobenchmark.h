@@ -0,0 +1,35 @@
+/* LayoutMicrobenchmark.h
+---------------------------------------------------------------------
+	Module Description - header module for LayoutMicrobenchmark.c
+---------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __LAYOUT_MICROBENCHMARK_H__
+#define __LAYOUT_MICROBENCHMARK_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef LAYOUT_MICROBENCHMARK
+/// <summary>
+/// Description - This function measures the Worker threads packages layout & prints the results:
+/// (1) a game round's fields access over the previous (scattered, Heap strings) package layout vs the contiguous cache line aligned one, and
+/// (2) per-thread counters packed in a single cache line vs counters padded to a cache line each (false sharing).
+/// Built ONLY when LAYOUT_MICROBENCHMARK is defined - the Server then runs it instead of serving Clients.
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL runLayoutMicrobenchmark();
+#endif //LAYOUT_MICROBENCHMARK
+
+
+#endif //__LAYOUT_MICROBENCHMARK_H__
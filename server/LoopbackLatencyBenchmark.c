@@ -0,0 +1,566 @@
+/* LoopbackLatencyBenchmark.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the end-to-end round trip latency
+		benchmark, built ONLY when LOOPBACK_LATENCY_BENCHMARK is defined. The
+		Server is started in-process on a free loopback port, and scripted
+		Clients, two per Game Room, go through CLIENT_REQUEST, CLIENT_VERSUS &
+		CLIENT_SETUP and play a given number of rounds. Every round, a Client
+		measures the time from sending CLIENT_PLAYER_MOVE to receiving
+		SERVER_GAME_RESULTS - which includes the opponent's Worker thread
+		synchronization, the GameSession.txt exchange & the scoring. The rounds
+		are swept over 1..N concurrent Game Rooms, and p50, p99, p99.9 & max
+		are printed per room count.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef LOOPBACK_LATENCY_BENCHMARK
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "LoopbackLatencyBenchmark.h"
+#include "MemoryHandling.h"
+#include "ServerClientsTools.h"
+#include "SetCommunicationServerSide.h"
+#include "SlabAllocationTools.h"
+#include "EventLoggingTools.h"
+#include "MetricsTools.h"
+#include "SendQueueTools.h"
+#include "MatchmakingTools.h"
+#include "GameVariantTools.h"
+
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL INETPTONS_SUCCESS = 1;
+
+//Benchmark parameters
+static const int DEFAULT_NUM_OF_ROUNDS = 1000;
+static const int CLIENT_RECEIVE_TIMEOUT = 30000;		// 30 Seconds - a scripted Client answers at once, so only a stuck Server reaches it
+static const int CONNECT_ATTEMPTS = 100;				// The Server may not listen yet, or the previous room count's Clients may not have left yet
+static const int VERSUS_ATTEMPTS = 100;					// The opponent may not be approved yet when CLIENT_VERSUS arrives (SERVER_NO_OPPONENTS)
+static const DWORD RETRY_INTERVAL_MS = 50;
+static const double MICROSECONDS_IN_SECOND = 1000000.0;
+
+//Percentiles printed per room count
+static const double PERCENTILE_MEDIAN = 50.0;
+static const double PERCENTILE_TAIL = 99.0;
+static const double PERCENTILE_FAR_TAIL = 99.9;
+static const double PERCENT = 100.0;
+
+//Command line options
+static const char ROUNDS_OPTION[] = "--rounds";
+static const char ROOMS_OPTION[] = "--rooms";
+
+
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function parses the benchmark's command line options (--rounds <n>, --rooms <n>). Missing options keep their defaults
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <param name="int* p_numOfRounds - pointer to the rounds per room"></param>
+/// <param name="int* p_maxNumOfRooms - pointer to the largest number of concurrent rooms"></param>
+/// <returns>True if every option is known & its value is a positive number. False otherwise</returns>
+static BOOL fetchBenchmarkOptions(int argc, char* argv[], int* p_numOfRounds, int* p_maxNumOfRooms);
+
+/// <summary>
+/// Description - This function finds a free loopback port by binding a socket to port 0 & reading the port the system picked with getsockname(.).
+/// The socket is closed before the Server binds the port
+/// </summary>
+/// <param name="unsigned short* p_portNumber - pointer to the found port number"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL fetchFreeLoopbackPort(unsigned short* p_portNumber);
+
+/// <summary>
+/// Description - In-process Server thread routine. Runs setCommmunicationServerSide(.) on the port passed as the thread parameter, with the classic variant
+/// </summary>
+/// <param name="LPVOID lpParam - the Server's port number"></param>
+/// <returns>The return value of setCommmunicationServerSide(.)</returns>
+static BOOL WINAPI inProcessServerThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function runs two scripted Clients per Game Room for a given number of concurrent rooms, waits for all of them to finish
+/// their games & prints the percentiles of all their rounds as a single row
+/// </summary>
+/// <param name="unsigned short serverPortNumber - the in-process Server's port"></param>
+/// <param name="int numOfRooms - # of concurrent Game Rooms"></param>
+/// <param name="int numOfRounds - # of measured rounds per room"></param>
+/// <returns>True if every Client completed its game. False otherwise</returns>
+static BOOL runConcurrentRooms(unsigned short serverPortNumber, int numOfRooms, int numOfRounds);
+
+/// <summary>
+/// Description - Scripted Client thread routine. Connects to the Server, joins a game, plays the rounds while measuring them, ends the game
+/// with a draw & disconnects. The result is marked in the Client's 'isSucceeded' field
+/// </summary>
+/// <param name="LPVOID lpParam - pointer to the Client's latencyBenchmarkClient struct"></param>
+/// <returns>True if the Client completed its game. False otherwise</returns>
+static BOOL WINAPI scriptedClientThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function connects a scripted Client to the Server until it is approved (SERVER_APPROVED), then answers the main menu with
+/// CLIENT_VERSUS until it is invited to a game (SERVER_INVITE). The opponent's initial number is taken from the opponent's name
+/// </summary>
+/// <param name="latencyBenchmarkClient* p_client - pointer to the Client's struct"></param>
+/// <param name="SOCKET* p_s_clientSocket - pointer to the Client's socket (INVALID_SOCKET on entry)"></param>
+/// <param name="char* p_opponentInitialNumber - buffer of PLAYER_NUMBER_LEN + 1 bytes for the opponent's initial number"></param>
+/// <returns>True if the Client was invited to a game. False otherwise</returns>
+static BOOL connectAndJoinGame(latencyBenchmarkClient* p_client, SOCKET* p_s_clientSocket, char* p_opponentInitialNumber);
+
+/// <summary>
+/// Description - This function plays the measured rounds (guessing the Client's own initial number, so no one wins), then guesses the opponent's
+/// initial number - both Clients do so on the same round, so the game ends with SERVER_DRAW
+/// </summary>
+/// <param name="latencyBenchmarkClient* p_client - pointer to the Client's struct"></param>
+/// <param name="SOCKET* p_s_clientSocket - pointer to the Client's socket"></param>
+/// <param name="char* p_opponentInitialNumber - the opponent's initial number"></param>
+/// <returns>True if every round was answered with SERVER_GAME_RESULTS & the last with SERVER_DRAW. False otherwise</returns>
+static BOOL playMeasuredRounds(latencyBenchmarkClient* p_client, SOCKET* p_s_clientSocket, char* p_opponentInitialNumber);
+
+/// <summary>
+/// Description - This function receives a message & validates it is of the expected type
+/// </summary>
+/// <param name="SOCKET* p_s_clientSocket - pointer to the Client's socket"></param>
+/// <param name="int expectedMessageType - the expected message type"></param>
+/// <param name="message** p_p_receivedMessage - pointer to the received message pointer (the caller frees it), or NULL to free it here"></param>
+/// <returns>True if a message of the expected type was received. False otherwise</returns>
+static BOOL receiveExpectedMessage(SOCKET* p_s_clientSocket, int expectedMessageType, message** p_p_receivedMessage);
+
+/// <summary>
+/// Description - qsort(.) comparison function of two latencies
+/// </summary>
+static int compareLatencies(const void* p_first, const void* p_second);
+
+/// <summary>
+/// Description - This function fetches a percentile of sorted latencies (nearest rank)
+/// </summary>
+/// <param name="const LONGLONG* p_sortedLatencyTicks - sorted latencies"></param>
+/// <param name="int numOfLatencies - # of latencies (at least 1)"></param>
+/// <param name="double percentile - percentile, 0 - 100"></param>
+/// <returns>The latency at the percentile, in QueryPerformanceCounter ticks</returns>
+static LONGLONG fetchPercentileTicks(const LONGLONG* p_sortedLatencyTicks, int numOfLatencies, double percentile);
+
+
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runLoopbackLatencyBenchmark(int argc, char* argv[])
+{
+	WSADATA wsaData;
+	HANDLE h_serverThread = NULL;
+	DWORD serverThreadId = 0;
+	unsigned short serverPortNumber = 0;
+	int numOfRounds = DEFAULT_NUM_OF_ROUNDS, maxNumOfRooms = LATENCY_BENCHMARK_MAX_ROOMS, numOfRooms = 0;
+	BOOL benchmarkSucceeded = TRUE;
+
+	if (STATUS_CODE_FAILURE == fetchBenchmarkOptions(argc, argv, &numOfRounds, &maxNumOfRooms)) {
+		printf("Usage: %s [%s <rounds per room>] [%s <max concurrent rooms>]\n", argv[0], ROUNDS_OPTION, ROOMS_OPTION);
+		return STATUS_CODE_FAILURE;
+	}
+	if (LATENCY_BENCHMARK_MAX_ROOMS < maxNumOfRooms) {
+		printf("Warning: The Server holds at most %d concurrent Game Room(s), the sweep stops there.\n", LATENCY_BENCHMARK_MAX_ROOMS);
+		maxNumOfRooms = LATENCY_BENCHMARK_MAX_ROOMS;
+	}
+
+	//The in-process Server needs everything main(.) prepares for it
+	if (STATUS_CODE_FAILURE == initializeEventLogger()) return STATUS_CODE_FAILURE;
+	if (STATUS_CODE_FAILURE == initializeSlabAllocator()) {
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+	if (STATUS_CODE_FAILURE == initializeMetricsRegistry()) {
+		destroySlabAllocator();
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+	if (STATUS_CODE_FAILURE == initializeSendQueues()) {
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+	//The scripted Clients are paired with each other only - no bot may take a room
+	if (STATUS_CODE_FAILURE == initializeMatchmaking(MATCHMAKING_DEFAULT_MODE, FALSE, 0)) {
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+	if (NO_ERROR != WSAStartup(MAKEWORD(2, 2), &wsaData)) {
+		printf("Error: Failed to initalize Winsock API using WSAStartup( ) with error code no. %ld.\n", WSAGetLastError());
+		destroyMatchmaking();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Start the Server on a free loopback port. The scripted Clients retry connecting until it listens
+	if ((STATUS_CODE_FAILURE == fetchFreeLoopbackPort(&serverPortNumber)) ||
+		(INVALID_HANDLE_VALUE == (h_serverThread = createThreadSimple(
+			(LPTHREAD_START_ROUTINE)inProcessServerThreadRoutine,	/* in-process Server thread routine */
+			(LPVOID)(ULONG_PTR)serverPortNumber,					/* the Server's port number, passed by value */
+			&serverThreadId)))) {									/* thread ID number address */
+		WSACleanup();
+		destroyMatchmaking();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Sweep the concurrent rooms (progress goes to stderr, the results to stdout)
+	fprintf(stderr, "In-process Server on %s:%hu, %d rounds per room\n", SERVER_ADDRESS_STR, serverPortNumber, numOfRounds);
+	printf("Round trip latency - CLIENT_PLAYER_MOVE sent -> SERVER_GAME_RESULTS received, %d rounds per room\n", numOfRounds);
+	printf("%-6s %10s %12s %12s %12s %12s\n", "Rooms", "Samples", "p50(us)", "p99(us)", "p99.9(us)", "Max(us)");
+	for (numOfRooms = 1; (TRUE == benchmarkSucceeded) && (numOfRooms <= maxNumOfRooms); numOfRooms++) {
+		fprintf(stderr, "Running %d concurrent room(s)...\n", numOfRooms);
+		if (STATUS_CODE_FAILURE == (benchmarkSucceeded = runConcurrentRooms(serverPortNumber, numOfRooms, numOfRounds)))
+			printf("Error: The latency benchmark failed at %d concurrent room(s).\n", numOfRooms);
+	}
+
+	//The Server keeps serving until the process exits (its 'exit' thread is blocked on STDin), so the logger, the slab caches, the metrics, the send queues & the matchmaking
+	// it uses are left for the process exit to release as well
+	CloseHandle(h_serverThread);
+	WSACleanup();
+	return benchmarkSucceeded;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Benchmark preparation
+static BOOL fetchBenchmarkOptions(int argc, char* argv[], int* p_numOfRounds, int* p_maxNumOfRooms)
+{
+	int a = 0;
+	long value = 0;
+
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) return STATUS_CODE_FAILURE; //Every option takes a value
+		value = strtol(argv[a + 1], NULL, 10);
+		if (0 >= value) return STATUS_CODE_FAILURE;
+
+		if (STRINGS_ARE_EQUAL(argv[a], ROUNDS_OPTION, sizeof(ROUNDS_OPTION))) *p_numOfRounds = (int)value;
+		else if (STRINGS_ARE_EQUAL(argv[a], ROOMS_OPTION, sizeof(ROOMS_OPTION))) *p_maxNumOfRooms = (int)value;
+		else return STATUS_CODE_FAILURE;
+		a++;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL fetchFreeLoopbackPort(unsigned short* p_portNumber)
+{
+	SOCKET s_probingSocket = INVALID_SOCKET;
+	SOCKADDR_IN service;
+	int serviceLength = sizeof(service);
+	BOOL portFound = FALSE;
+
+	//Port 0 - the system picks a free port
+	memset(&service, 0, sizeof(service));
+	service.sin_family = AF_INET;
+	service.sin_port = 0;
+	if ((INETPTONS_SUCCESS == InetPton(AF_INET, SERVER_ADDRESS_STR, &service.sin_addr.s_addr)) &&
+		(INVALID_SOCKET != (s_probingSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) &&
+		(SOCKET_ERROR != bind(s_probingSocket, (SOCKADDR*)&service, sizeof(service))) &&
+		(SOCKET_ERROR != getsockname(s_probingSocket, (SOCKADDR*)&service, &serviceLength))) {
+		*p_portNumber = ntohs(service.sin_port);
+		portFound = TRUE;
+	}
+	else
+		printf("Error: Failed to find a free loopback port, with error code no. %ld.\n", WSAGetLastError());
+
+	if (INVALID_SOCKET != s_probingSocket) closesocket(s_probingSocket);
+	return portFound;
+}
+
+static BOOL WINAPI inProcessServerThreadRoutine(LPVOID lpParam)
+{
+	gameVariant classicVariant;
+
+	//The scripted Clients play the classic variant
+	setClassicGameVariant(&classicVariant);
+	return setCommmunicationServerSide((unsigned short)(ULONG_PTR)lpParam, &classicVariant);
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
+
+
+
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Room count sweep step
+static BOOL runConcurrentRooms(unsigned short serverPortNumber, int numOfRooms, int numOfRounds)
+{
+	latencyBenchmarkClient* p_clients = NULL;
+	HANDLE* p_h_clientThreads = NULL;
+	LONGLONG* p_allLatencyTicks = NULL;
+	LARGE_INTEGER frequency;
+	DWORD threadId = 0;
+	int numOfClients = 2 * numOfRooms, numOfStartedClients = 0, numOfLatencies = 0, c = 0, d = 0;
+	double microsecondsPerTick = 0;
+	BOOL stepSucceeded = TRUE;
+
+	p_clients = (latencyBenchmarkClient*)calloc(numOfClients, sizeof(latencyBenchmarkClient));
+	p_h_clientThreads = (HANDLE*)calloc(numOfClients, sizeof(HANDLE));
+	p_allLatencyTicks = (LONGLONG*)calloc((size_t)numOfClients * numOfRounds, sizeof(LONGLONG));
+	if ((NULL == p_clients) || (NULL == p_h_clientThreads) || (NULL == p_allLatencyTicks)) {
+		printf("Error: Failed to allocate memory for the scripted Clients.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		free(p_clients);
+		free(p_h_clientThreads);
+		free(p_allLatencyTicks);
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Every Client gets a distinct initial number (consecutive digits, starting at its index) carried in its name, so its opponent can guess it
+	// on the last round. Each Client writes its rounds into its own slice of the latencies block
+	for (c = 0; c < numOfClients; c++) {
+		(p_clients + c)->serverPortNumber = serverPortNumber;
+		(p_clients + c)->numOfRounds = numOfRounds;
+		for (d = 0; d < PLAYER_NUMBER_LEN; d++) (p_clients + c)->initialNumber[d] = (char)('0' + ((c + d) % 10));
+		_snprintf_s((p_clients + c)->playerName, sizeof((p_clients + c)->playerName), _TRUNCATE, "%s%s", LATENCY_BENCHMARK_NAME_PREFIX, (p_clients + c)->initialNumber);
+		(p_clients + c)->p_latencyTicks = p_allLatencyTicks + (size_t)c * numOfRounds;
+	}
+
+	for (c = 0; c < numOfClients; c++) {
+		if (INVALID_HANDLE_VALUE == (*(p_h_clientThreads + c) = createThreadSimple((LPTHREAD_START_ROUTINE)scriptedClientThreadRoutine, p_clients + c, &threadId))) {
+			*(p_h_clientThreads + c) = NULL;
+			stepSucceeded = FALSE;
+			break;
+		}
+		numOfStartedClients++;
+	}
+
+	//Every Client leaves on its own - at worst once its receive timeout is reached
+	if (0 < numOfStartedClients) WaitForMultipleObjects(numOfStartedClients, p_h_clientThreads, TRUE, INFINITE);
+	for (c = 0; c < numOfStartedClients; c++) {
+		CloseHandle(*(p_h_clientThreads + c));
+		if (FALSE == (p_clients + c)->isSucceeded) stepSucceeded = FALSE;
+	}
+
+	if (TRUE == stepSucceeded) {
+		//Gather all the Clients' slices into a single sorted block
+		for (c = 0; c < numOfClients; c++) {
+			memmove(p_allLatencyTicks + numOfLatencies, (p_clients + c)->p_latencyTicks, (size_t)(p_clients + c)->numOfLatencies * sizeof(LONGLONG));
+			numOfLatencies += (p_clients + c)->numOfLatencies;
+		}
+		qsort(p_allLatencyTicks, numOfLatencies, sizeof(LONGLONG), compareLatencies);
+
+		QueryPerformanceFrequency(&frequency);
+		microsecondsPerTick = MICROSECONDS_IN_SECOND / (double)frequency.QuadPart;
+		printf("%-6d %10d %12.1f %12.1f %12.1f %12.1f\n", numOfRooms, numOfLatencies,
+			fetchPercentileTicks(p_allLatencyTicks, numOfLatencies, PERCENTILE_MEDIAN) * microsecondsPerTick,
+			fetchPercentileTicks(p_allLatencyTicks, numOfLatencies, PERCENTILE_TAIL) * microsecondsPerTick,
+			fetchPercentileTicks(p_allLatencyTicks, numOfLatencies, PERCENTILE_FAR_TAIL) * microsecondsPerTick,
+			p_allLatencyTicks[numOfLatencies - 1] * microsecondsPerTick);
+	}
+
+	free(p_clients);
+	free(p_h_clientThreads);
+	free(p_allLatencyTicks);
+	return stepSucceeded;
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
+
+
+
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Scripted Client
+static BOOL WINAPI scriptedClientThreadRoutine(LPVOID lpParam)
+{
+	latencyBenchmarkClient* p_client = (latencyBenchmarkClient*)lpParam;
+	SOCKET s_clientSocket = INVALID_SOCKET;
+	char opponentInitialNumber[PLAYER_NUMBER_LEN + 1] = { 0 };
+	//Assert
+	assert(NULL != p_client);
+
+	if ((STATUS_CODE_SUCCESS == connectAndJoinGame(p_client, &s_clientSocket, opponentInitialNumber)) &&
+		//Receive ^ SERVER_SETUP_REQUSET ^ & send ^ CLIENT_SETUP ^
+		(STATUS_CODE_SUCCESS == receiveExpectedMessage(&s_clientSocket, SERVER_SETUP_REQUSET_NUM, NULL)) &&
+		((communicationResults)TRANSFER_SUCCEEDED == sendMessageClientSide(&s_clientSocket, CLIENT_SETUP_NUM, p_client->initialNumber, NULL)) &&
+		(STATUS_CODE_SUCCESS == playMeasuredRounds(p_client, &s_clientSocket, opponentInitialNumber)) &&
+		//Back at the main menu - leave with ^ CLIENT_DISCONNECT ^, so the Worker thread is free for the next room count
+		(STATUS_CODE_SUCCESS == receiveExpectedMessage(&s_clientSocket, SERVER_MAIN_MENU_NUM, NULL)) &&
+		((communicationResults)TRANSFER_SUCCEEDED == sendMessageClientSide(&s_clientSocket, CLIENT_DISCONNECT_NUM, NULL, NULL))) {
+		gracefulDisconnect(&s_clientSocket);
+		p_client->isSucceeded = TRUE;
+	}
+	else
+		printf("Error: The scripted Client %s failed to complete its game.\n", p_client->playerName);
+
+	if (INVALID_SOCKET != s_clientSocket) closesocket(s_clientSocket);
+	return p_client->isSucceeded;
+}
+
+static BOOL connectAndJoinGame(latencyBenchmarkClient* p_client, SOCKET* p_s_clientSocket, char* p_opponentInitialNumber)
+{
+	SOCKADDR_IN service;
+	message* p_receivedMessage = NULL;
+	int attempt = 0, messageType = 0, nameLength = 0;
+	//Asserts
+	assert(NULL != p_client);
+	assert(NULL != p_s_clientSocket);
+	assert(NULL != p_opponentInitialNumber);
+
+	memset(&service, 0, sizeof(service));
+	service.sin_family = AF_INET;
+	service.sin_port = htons(p_client->serverPortNumber);
+	if (INETPTONS_SUCCESS != InetPton(AF_INET, SERVER_ADDRESS_STR, &service.sin_addr.s_addr)) return STATUS_CODE_FAILURE;
+
+	//Connect & send ^ CLIENT_REQUEST ^ until ^ SERVER_APPROVED ^ arrives
+	for (attempt = 0; attempt < CONNECT_ATTEMPTS; attempt++) {
+		if (0 < attempt) Sleep(RETRY_INTERVAL_MS);
+		if (INVALID_SOCKET != *p_s_clientSocket) closesocket(*p_s_clientSocket);
+		if (INVALID_SOCKET == (*p_s_clientSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) return STATUS_CODE_FAILURE;
+
+		if (SOCKET_ERROR == connect(*p_s_clientSocket, (SOCKADDR*)&service, sizeof(service))) continue; //The Server does not listen yet
+		if ((communicationResults)TRANSFER_SUCCEEDED != sendMessageClientSide(p_s_clientSocket, CLIENT_REQUEST_NUM, p_client->playerName, NULL)) continue;
+		if (TRANSFER_SUCCEEDED != receiveMessage(p_s_clientSocket, &p_receivedMessage, CLIENT_RECEIVE_TIMEOUT)) continue;
+		messageType = p_receivedMessage->messageType;
+		freeTheMessage(p_receivedMessage);
+		if (SERVER_APPROVED_NUM == messageType) break;
+		//SERVER_DENIED - the Worker threads of the previous room count's Clients did not leave yet
+	}
+	if (CONNECT_ATTEMPTS == attempt) return STATUS_CODE_FAILURE;
+
+	//Answer ^ SERVER_MAIN_MENU ^ with ^ CLIENT_VERSUS ^ until ^ SERVER_INVITE ^ arrives
+	for (attempt = 0; attempt < VERSUS_ATTEMPTS; attempt++) {
+		if (STATUS_CODE_FAILURE == receiveExpectedMessage(p_s_clientSocket, SERVER_MAIN_MENU_NUM, NULL)) return STATUS_CODE_FAILURE;
+		if ((communicationResults)TRANSFER_SUCCEEDED != sendMessageClientSide(p_s_clientSocket, CLIENT_VERSUS_NUM, NULL, NULL)) return STATUS_CODE_FAILURE;
+		if (TRANSFER_SUCCEEDED != receiveMessage(p_s_clientSocket, &p_receivedMessage, CLIENT_RECEIVE_TIMEOUT)) return STATUS_CODE_FAILURE;
+
+		if (SERVER_INVITE_NUM == p_receivedMessage->messageType) {
+			//The opponent's initial number ends its name
+			if ((NULL == p_receivedMessage->p_parameters) || (NULL == p_receivedMessage->p_parameters->p_parameter) ||
+				(PLAYER_NUMBER_LEN > (nameLength = (int)strlen(p_receivedMessage->p_parameters->p_parameter)))) {
+				freeTheMessage(p_receivedMessage);
+				return STATUS_CODE_FAILURE;
+			}
+			memcpy(p_opponentInitialNumber, p_receivedMessage->p_parameters->p_parameter + nameLength - PLAYER_NUMBER_LEN, PLAYER_NUMBER_LEN);
+			freeTheMessage(p_receivedMessage);
+			return STATUS_CODE_SUCCESS;
+		}
+
+		messageType = p_receivedMessage->messageType;
+		freeTheMessage(p_receivedMessage);
+		if (SERVER_NO_OPPONENTS_NUM != messageType) return STATUS_CODE_FAILURE;
+		//SERVER_NO_OPPONENTS - the opponent was not approved yet. The Server sends the main menu again
+		Sleep(RETRY_INTERVAL_MS);
+	}
+	return STATUS_CODE_FAILURE;
+}
+
+static BOOL playMeasuredRounds(latencyBenchmarkClient* p_client, SOCKET* p_s_clientSocket, char* p_opponentInitialNumber)
+{
+	message* p_receivedMessage = NULL;
+	LARGE_INTEGER sendTicks, receiveTicks;
+	int round = 0, messageType = 0;
+	//Asserts
+	assert(NULL != p_client);
+	assert(NULL != p_s_clientSocket);
+	assert(NULL != p_opponentInitialNumber);
+
+	//The measured rounds, then a single last round that ends the game
+	for (round = 0; round <= p_client->numOfRounds; round++) {
+		if (STATUS_CODE_FAILURE == receiveExpectedMessage(p_s_clientSocket, SERVER_PLAYER_MOVE_REQUEST_NUM, NULL)) return STATUS_CODE_FAILURE;
+
+		QueryPerformanceCounter(&sendTicks);
+		if ((communicationResults)TRANSFER_SUCCEEDED != sendMessageClientSide(p_s_clientSocket, CLIENT_PLAYER_MOVE_NUM,
+			(round < p_client->numOfRounds) ? p_client->initialNumber : p_opponentInitialNumber, NULL)) return STATUS_CODE_FAILURE;
+		if (TRANSFER_SUCCEEDED != receiveMessage(p_s_clientSocket, &p_receivedMessage, CLIENT_RECEIVE_TIMEOUT)) return STATUS_CODE_FAILURE;
+		QueryPerformanceCounter(&receiveTicks);
+
+		messageType = p_receivedMessage->messageType;
+		freeTheMessage(p_receivedMessage);
+		if (round < p_client->numOfRounds) {
+			if (SERVER_GAME_RESULTS_NUM != messageType) return STATUS_CODE_FAILURE;
+			*(p_client->p_latencyTicks + p_client->numOfLatencies++) = receiveTicks.QuadPart - sendTicks.QuadPart;
+		}
+		else if (SERVER_DRAW_NUM != messageType) return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL receiveExpectedMessage(SOCKET* p_s_clientSocket, int expectedMessageType, message** p_p_receivedMessage)
+{
+	message* p_receivedMessage = NULL;
+	transferResults recvRes = 0;
+
+	if (TRANSFER_SUCCEEDED != (recvRes = receiveMessage(p_s_clientSocket, &p_receivedMessage, CLIENT_RECEIVE_TIMEOUT))) {
+		printf("Error: A scripted Client failed to receive message type %d, with transfer result %d.\n", expectedMessageType, (int)recvRes);
+		return STATUS_CODE_FAILURE;
+	}
+	if (expectedMessageType != p_receivedMessage->messageType) {
+		printf("Error: A scripted Client received message type %d instead of %d.\n", p_receivedMessage->messageType, expectedMessageType);
+		freeTheMessage(p_receivedMessage);
+		return STATUS_CODE_FAILURE;
+	}
+
+	if (NULL != p_p_receivedMessage) *p_p_receivedMessage = p_receivedMessage;
+	else freeTheMessage(p_receivedMessage);
+	return STATUS_CODE_SUCCESS;
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
+
+
+
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Percentiles
+static int compareLatencies(const void* p_first, const void* p_second)
+{
+	LONGLONG first = *(const LONGLONG*)p_first, second = *(const LONGLONG*)p_second;
+
+	return (first > second) - (first < second);
+}
+
+static LONGLONG fetchPercentileTicks(const LONGLONG* p_sortedLatencyTicks, int numOfLatencies, double percentile)
+{
+	int rank = 0;
+	//Assert
+	assert(0 < numOfLatencies);
+
+	//Nearest rank - the smallest latency that at least 'percentile' percent of the latencies do not exceed
+	rank = (int)ceil((percentile / PERCENT) * numOfLatencies);
+	if (1 > rank) rank = 1;
+	if (numOfLatencies < rank) rank = numOfLatencies;
+	return p_sortedLatencyTicks[rank - 1];
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
+
+#endif //LOOPBACK_LATENCY_BENCHMARK
@@ -0,0 +1,39 @@
+/* LoopbackLatencyBenchmark.h
+-------------------------------------------------------------------------
+	Module Description - header module for LoopbackLatencyBenchmark.c
+-------------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __LOOPBACK_LATENCY_BENCHMARK_H__
+#define __LOOPBACK_LATENCY_BENCHMARK_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef LOOPBACK_LATENCY_BENCHMARK
+/// <summary>
+/// Description - This function starts the Server in-process on a free loopback port, and for every number of concurrent Game Rooms from 1 up to
+/// the requested number, pairs two scripted Clients per room (CLIENT_REQUEST, CLIENT_VERSUS, CLIENT_SETUP) that play the requested number of rounds.
+/// The time from sending CLIENT_PLAYER_MOVE to receiving SERVER_GAME_RESULTS is measured on every round, and p50, p99, p99.9 & max are printed per room count.
+/// Built ONLY when LOOPBACK_LATENCY_BENCHMARK is defined - the Server then runs it instead of serving Clients:
+///		server.exe [--rounds <rounds per room>] [--rooms <max concurrent rooms>]
+/// The Server's 'exit' thread reads STDin, so STDin must stay open while the benchmark runs
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL runLoopbackLatencyBenchmark(int argc, char* argv[]);
+#endif //LOOPBACK_LATENCY_BENCHMARK
+
+
+#endif //__LOOPBACK_LATENCY_BENCHMARK_H__
@@ -0,0 +1,270 @@
+/* MatchmakingBotTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the Server's bot, summoned by the
+		matchmaking for a player that waited too long for an opponent. The bot
+		is a regular Client played by a Server thread over loopback - it is
+		admitted, matched & served by a Worker thread like any other Client, so
+		the Game Room & the game flow need no special case. It plays the
+		opening book (OpeningBookTools.c) when one is mapped - a guess is the
+		node's, and a result leads to the next node - so its rounds cost no
+		more than a human's. Without a book, it keeps the 5040 possible
+		numbers in a candidate set (CandidateSetTools.c), and guesses one
+		that is consistent with every SERVER_GAME_RESULTS received so far.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "MatchmakingBotTools.h"
+#include "MemoryHandling.h"
+#include "ServerClientsTools.h"
+#include "ServerSideWorkerThreadRoutine.h"
+#include "EventLoggingTools.h"
+#include "OpeningBookTools.h"
+#include "CandidateSetTools.h"
+#include "GameVariantTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL INETPTONS_SUCCESS = 1;
+static const int BOT_RECEIVE_TIMEOUT = 660000;		// 11 Minutes - the human opponent has 10 Minutes to answer each request
+static const DWORD BOT_EXIT_TIMEOUT = 5000;			// 5 Seconds - the Worker threads disconnect the bot when the Server exits
+
+// Global variables ------------------------------------------------------------
+//TRUE while a bot plays (InterlockedCompareExchange) and the handle of the bot thread started last
+static volatile LONG g_isMatchmakingBotRunning = FALSE;
+static HANDLE g_h_matchmakingBotThread = NULL;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - The bot thread routine: connects, plays a single game & disconnects
+/// </summary>
+/// <param name="LPVOID lpParam - the Server's port number, passed by value"></param>
+/// <returns>True if the game was completed. False otherwise</returns>
+static BOOL WINAPI matchmakingBotThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function connects the bot, sends CLIENT_REQUEST, and answers SERVER_MAIN_MENU with CLIENT_VERSUS
+/// </summary>
+/// <param name="unsigned short serverPortNumber - the Server's port number"></param>
+/// <param name="SOCKET* p_s_botSocket - pointer to the socket that will be connected"></param>
+/// <returns>True if succeeded. False otherwise (e.g. the Server denied the bot)</returns>
+static BOOL connectBotAndRequestGame(unsigned short serverPortNumber, SOCKET* p_s_botSocket);
+
+/// <summary>
+/// Description - This function answers the Server's requests until the game ends (SERVER_WIN, SERVER_DRAW, SERVER_OPPONENT_QUIT), or the matched player
+/// is gone before the game began (SERVER_NO_OPPONENTS). The guesses follow the opening book, if mapped, and are drawn from the candidates otherwise
+/// </summary>
+/// <param name="SOCKET* p_s_botSocket - pointer to the bot's socket"></param>
+/// <returns>True if the game ended. False otherwise</returns>
+static BOOL playBotGame(SOCKET* p_s_botSocket);
+
+/// <summary>
+/// Description - This function receives the next message and checks it is of the expected type
+/// </summary>
+/// <param name="SOCKET* p_s_botSocket - pointer to the bot's socket"></param>
+/// <param name="int expectedMessageType - the expected message type serial number"></param>
+/// <returns>True if the expected message arrived. False otherwise</returns>
+static BOOL receiveExpectedMessage(SOCKET* p_s_botSocket, int expectedMessageType);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL startMatchmakingBot(unsigned short serverPortNumber)
+{
+	DWORD threadId = 0;
+
+	//A single bot at a time
+	if (FALSE != InterlockedCompareExchange(&g_isMatchmakingBotRunning, TRUE, FALSE)) return STATUS_CODE_FAILURE;
+
+	//The previous bot has left - close its handle
+	if (NULL != g_h_matchmakingBotThread) {
+		CloseHandle(g_h_matchmakingBotThread);
+		g_h_matchmakingBotThread = NULL;
+	}
+	if (INVALID_HANDLE_VALUE == (g_h_matchmakingBotThread = createThreadSimple(
+		(LPTHREAD_START_ROUTINE)matchmakingBotThreadRoutine,	/* bot thread routine */
+		(LPVOID)(ULONG_PTR)serverPortNumber,					/* the Server's port number, passed by value */
+		&threadId))) {											/* thread ID number address */
+		g_h_matchmakingBotThread = NULL;
+		InterlockedExchange(&g_isMatchmakingBotRunning, FALSE);
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+void stopMatchmakingBot()
+{
+	if (NULL == g_h_matchmakingBotThread) return;
+
+	if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_matchmakingBotThread, BOT_EXIT_TIMEOUT))
+		LOG_EVENT(LOG_EVENT_TIMEOUT, "The matchmaking bot did not leave in time", 0, 0);
+	CloseHandle(g_h_matchmakingBotThread);
+	g_h_matchmakingBotThread = NULL;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL WINAPI matchmakingBotThreadRoutine(LPVOID lpParam)
+{
+	unsigned short serverPortNumber = (unsigned short)(ULONG_PTR)lpParam;
+	SOCKET s_botSocket = INVALID_SOCKET;
+	BOOL isSucceeded = FALSE;
+
+	//The CRT random generator is per thread
+	srand((unsigned int)(GetTickCount() ^ GetCurrentThreadId()));
+
+	if ((STATUS_CODE_SUCCESS == connectBotAndRequestGame(serverPortNumber, &s_botSocket)) &&
+		(STATUS_CODE_SUCCESS == playBotGame(&s_botSocket)) &&
+		//Back at the main menu - leave with ^ CLIENT_DISCONNECT ^, so the Worker thread is free again
+		(STATUS_CODE_SUCCESS == receiveExpectedMessage(&s_botSocket, SERVER_MAIN_MENU_NUM)) &&
+		((communicationResults)TRANSFER_SUCCEEDED == sendMessageClientSide(&s_botSocket, CLIENT_DISCONNECT_NUM, NULL, NULL))) {
+		gracefulDisconnect(&s_botSocket);
+		isSucceeded = TRUE;
+	}
+	if (FALSE == isSucceeded) LOG_EVENT(LOG_EVENT_FAILURE, "The matchmaking bot failed to complete its game", 0, 0);
+
+	if (INVALID_SOCKET != s_botSocket) closesocket(s_botSocket);
+	InterlockedExchange(&g_isMatchmakingBotRunning, FALSE);
+	return isSucceeded;
+}
+
+static BOOL connectBotAndRequestGame(unsigned short serverPortNumber, SOCKET* p_s_botSocket)
+{
+	SOCKADDR_IN service;
+	//Assert
+	assert(NULL != p_s_botSocket);
+
+	memset(&service, 0, sizeof(service));
+	service.sin_family = AF_INET;
+	service.sin_port = htons(serverPortNumber);
+	if (INETPTONS_SUCCESS != InetPton(AF_INET, SERVER_ADDRESS_STR, &service.sin_addr.s_addr)) return STATUS_CODE_FAILURE;
+
+	//Connect & send ^ CLIENT_REQUEST ^
+	if ((INVALID_SOCKET == (*p_s_botSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) ||
+		(SOCKET_ERROR == connect(*p_s_botSocket, (SOCKADDR*)&service, sizeof(service))) ||
+		((communicationResults)TRANSFER_SUCCEEDED != sendMessageClientSide(p_s_botSocket, CLIENT_REQUEST_NUM, MATCHMAKING_BOT_NAME, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "The matchmaking bot failed to connect", WSAGetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Expect ^ SERVER_APPROVED ^ (SERVER_DENIED - no Worker thread is free) followed by ^ SERVER_MAIN_MENU ^
+	if ((STATUS_CODE_FAILURE == receiveExpectedMessage(p_s_botSocket, SERVER_APPROVED_NUM)) ||
+		(STATUS_CODE_FAILURE == receiveExpectedMessage(p_s_botSocket, SERVER_MAIN_MENU_NUM))) return STATUS_CODE_FAILURE;
+
+	//Send ^ CLIENT_VERSUS ^
+	return ((communicationResults)TRANSFER_SUCCEEDED == sendMessageClientSide(p_s_botSocket, CLIENT_VERSUS_NUM, NULL, NULL)) ? STATUS_CODE_SUCCESS : STATUS_CODE_FAILURE;
+}
+
+static BOOL playBotGame(SOCKET* p_s_botSocket)
+{
+	message* p_receivedMessage = NULL;
+	char initialNumber[PLAYER_NUMBER_LEN + 1] = { 0 }, guess[PLAYER_NUMBER_LEN + 1] = { 0 };
+	candidateSet candidates;
+	int numOfCandidates = 0;
+	LONG bookNode = OPENING_BOOK_NO_NODE;
+	BOOL isGameOver = FALSE, isFailed = FALSE;
+	//Assert
+	assert(NULL != p_s_botSocket);
+
+	numOfCandidates = fillCandidateSet(&candidates);
+	bookNode = fetchOpeningBookRoot();
+	memcpy(initialNumber, fetchCandidateNumber((SHORT)(rand() % NUM_OF_PLAYER_NUMBERS)), PLAYER_NUMBER_LEN);
+
+	while ((FALSE == isGameOver) && (FALSE == isFailed)) {
+		if (TRANSFER_SUCCEEDED != receiveMessage(p_s_botSocket, &p_receivedMessage, BOT_RECEIVE_TIMEOUT)) return STATUS_CODE_FAILURE;
+
+		switch (p_receivedMessage->messageType) {
+		case SERVER_INVITE_NUM: break; //The opponent's name - nothing to do
+
+		case SERVER_SETUP_REQUSET_NUM:
+			//A resumed game keeps the bot's initial number of the previous Server process - nothing to send (its results so far are lost, the candidates start over)
+			if (NULL == fetchResumedInitialNumber(p_receivedMessage->p_parameters))
+				isFailed = ((communicationResults)TRANSFER_SUCCEEDED != sendMessageClientSide(p_s_botSocket, CLIENT_SETUP_NUM, initialNumber, NULL));
+			break;
+
+		case SERVER_PLAYER_MOVE_REQUEST_NUM:
+			//Guess the book's guess, or one of the numbers that are consistent with every result so far
+			if (OPENING_BOOK_NO_NODE != bookNode) fetchOpeningBookGuess(bookNode, guess);
+			else memcpy(guess, fetchCandidateNumber(fetchNthCandidate(&candidates, rand() % numOfCandidates)), PLAYER_NUMBER_LEN);
+			isFailed = ((communicationResults)TRANSFER_SUCCEEDED != sendMessageClientSide(p_s_botSocket, CLIENT_PLAYER_MOVE_NUM, guess, NULL));
+			break;
+
+		case SERVER_GAME_RESULTS_NUM:
+			//Parameters - bulls, cows, opponent name, opponent guess
+			if ((NULL == p_receivedMessage->p_parameters) || (NULL == p_receivedMessage->p_parameters->p_nextParameter)) {
+				isFailed = TRUE; break;
+			}
+			//In the book - follow the result, no candidate is filtered. A result the book has no node for is a number that was guessed (the game
+			// ends) or a result no number gets, and the candidates start over as below
+			if (OPENING_BOOK_NO_NODE != bookNode) {
+				if (OPENING_BOOK_NO_NODE == (bookNode = followOpeningBook(bookNode,
+					(SHORT)(*(p_receivedMessage->p_parameters->p_parameter) - '0'), (SHORT)(*(p_receivedMessage->p_parameters->p_nextParameter->p_parameter) - '0'))))
+					numOfCandidates = fillCandidateSet(&candidates);
+				break;
+			}
+			numOfCandidates = filterCandidateSet(&candidates, guess,
+				(SHORT)(*(p_receivedMessage->p_parameters->p_parameter) - '0'), (SHORT)(*(p_receivedMessage->p_parameters->p_nextParameter->p_parameter) - '0'));
+			//The opponent's number cannot be lost - start over if it somehow was
+			if (0 == numOfCandidates) numOfCandidates = fillCandidateSet(&candidates);
+			break;
+
+		case SERVER_WIN_NUM:
+		case SERVER_DRAW_NUM:
+		case SERVER_OPPONENT_QUIT_NUM:
+		case SERVER_NO_OPPONENTS_NUM: //The matched player left before the game began
+			isGameOver = TRUE; break;
+
+		default:
+			LOG_EVENT(LOG_EVENT_UNEXPECTED, "The matchmaking bot received an unexpected message", p_receivedMessage->messageType, 0);
+			isFailed = TRUE;
+		}
+		freeTheMessage(p_receivedMessage);
+		p_receivedMessage = NULL;
+	}
+	return (TRUE == isGameOver) ? STATUS_CODE_SUCCESS : STATUS_CODE_FAILURE;
+}
+
+
+
+static BOOL receiveExpectedMessage(SOCKET* p_s_botSocket, int expectedMessageType)
+{
+	message* p_receivedMessage = NULL;
+	int messageType = 0;
+	//Assert
+	assert(NULL != p_s_botSocket);
+
+	if (TRANSFER_SUCCEEDED != receiveMessage(p_s_botSocket, &p_receivedMessage, BOT_RECEIVE_TIMEOUT)) return STATUS_CODE_FAILURE;
+	messageType = p_receivedMessage->messageType;
+	freeTheMessage(p_receivedMessage);
+	return (expectedMessageType == messageType) ? STATUS_CODE_SUCCESS : STATUS_CODE_FAILURE;
+}
+
@@ -0,0 +1,38 @@
+/* MatchmakingBotTools.h
+---------------------------------------------------------------------
+	Module Description - header module for MatchmakingBotTools.c
+---------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __MATCHMAKING_BOT_TOOLS_H__
+#define __MATCHMAKING_BOT_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function starts the Server's bot: a thread that connects to the Server over loopback as a regular Client named MATCHMAKING_BOT_NAME,
+/// sends CLIENT_VERSUS, plays a single game (random initial number, guesses consistent with every result so far) & disconnects.
+/// At most one bot plays at a time
+/// </summary>
+/// <param name="unsigned short serverPortNumber - the Server's port number"></param>
+/// <returns>True if the bot was started. False if a bot already plays, or the thread creation failed</returns>
+BOOL startMatchmakingBot(unsigned short serverPortNumber);
+
+/// <summary>
+/// Description - This function waits (a bounded time) for the bot that was started last to leave, and closes its thread handle
+/// </summary>
+void stopMatchmakingBot();
+
+
+#endif //__MATCHMAKING_BOT_TOOLS_H__
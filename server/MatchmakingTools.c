@@ -0,0 +1,430 @@
+/* MatchmakingTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the matchmaking of the players that
+		sent CLIENT_VERSUS. A player first claims the earliest player waiting in
+		its own bucket (a single bucket in FIFO mode, rating buckets in skill
+		mode, searched outwards to the neighbouring buckets), and if nobody
+		waits, it enqueues a ticket & waits to be claimed - widening its rating
+		window every few seconds. The waiting queues are
+		bounded lock-free rings, and a waiting ticket is claimed (or cancelled by
+		its owner) with a single InterlockedCompareExchange on its state word,
+		so players never block each other while pairing. A player left alone
+		for too long may be offered the Server's bot (MatchmakingBotTools.c).
+		The outcomes & the match latency are recorded by the metrics registry.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "MatchmakingTools.h"
+#include "MatchmakingBotTools.h"
+#include "EventLoggingTools.h"
+#include "MetricsTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const LONG MATCHMAKING_QUEUE_MASK = MATCHMAKING_QUEUE_CAPACITY - 1;
+static const DWORD MATCHED_SIGNAL_TIMEOUT = 5000; // 5 Seconds - a player that claimed a ticket signals its owner at once
+static const int NUM_OF_WAIT_EVENTS = 3;
+
+// Global variables ------------------------------------------------------------
+//The waiting queues - a single one in MATCHMAKING_MODE_FIFO, one per rating bucket in MATCHMAKING_MODE_SKILL_BUCKETS
+static matchmakingQueue* g_p_matchmakingQueues = NULL;
+static int g_numOfMatchmakingQueues = 0;
+//The tickets & the free list of the idle ones
+static matchmakingTicket* g_p_matchmakingTickets = NULL;
+static SLIST_HEADER g_freeMatchmakingTickets;
+//Configuration
+static matchmakingModes g_matchmakingMode = MATCHMAKING_DEFAULT_MODE;
+static BOOL g_isBotFallbackEnabled = FALSE;
+static unsigned short g_matchmakingServerPortNumber = 0;
+//# of players currently waiting (InterlockedIncrement\Decrement)
+static volatile LONG g_numOfWaitingPlayers = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function maps a rating to its bucket (the single bucket in MATCHMAKING_MODE_FIFO)
+/// </summary>
+/// <param name="int skillRating - the player's rating"></param>
+/// <returns>bucket index</returns>
+static int fetchRatingBucket(int skillRating);
+
+/// <summary>
+/// Description - This function claims the earliest waiting player of the given bucket, then of the neighbouring buckets up to the given spread away.
+/// Entries of tickets whose owners stopped waiting are dropped on the way
+/// </summary>
+/// <param name="int bucket - the claiming player's bucket"></param>
+/// <param name="int spread - # of neighbouring buckets searched on each side"></param>
+/// <param name="BOOL isBot - TRUE if the claiming player is the Server's bot (told to the claimed player)"></param>
+/// <param name="BOOL* p_isOpponentBot - pointer to a BOOL that will tell whether the claimed player is the Server's bot"></param>
+/// <returns>True if a waiting player was claimed. False if nobody waits</returns>
+static BOOL claimWaitingPlayer(int bucket, int spread, BOOL isBot, BOOL* p_isOpponentBot);
+
+/// <summary>
+/// Description - This function enqueues a ticket at the given bucket and waits for it to be claimed, for the 'EXIT'\'ERROR' Events, or for the timeouts to
+/// pass. In skill mode, every MATCHMAKING_WINDOW_WIDEN_INTERVAL_MS the ticket is withdrawn, the rating window widens by a bucket on each side and the player
+/// tries to claim a waiting player in it, before it is enqueued again. When the wait ends without a claim, the ticket is cancelled - and if an opponent
+/// claimed it meanwhile, the match is taken after all
+/// </summary>
+/// <param name="int bucket - the waiting player's bucket"></param>
+/// <param name="BOOL isBotFallbackAllowed - TRUE if the bot may be summoned after MATCHMAKING_WAIT_TIMEOUT_MS"></param>
+/// <param name="HANDLE* p_h_exitEvent - pointer to the 'EXIT' Event"></param>
+/// <param name="HANDLE* p_h_errorEvent - pointer to the 'ERROR' Event"></param>
+/// <returns>the matchmaking outcome</returns>
+static matchmakingOutcomes waitToBeClaimed(int bucket, BOOL isBotFallbackAllowed, HANDLE* p_h_exitEvent, HANDLE* p_h_errorEvent);
+
+/// <summary>
+/// Description - This function appends a waiting ticket to a queue (bounded multi-producer multi-consumer ring - the enqueue position is advanced by
+/// InterlockedCompareExchange, and the cell's sequence publishes the entry to the dequeuers)
+/// </summary>
+/// <param name="matchmakingQueue* p_queue - pointer to the queue"></param>
+/// <param name="matchmakingTicket* p_ticket - pointer to the waiting ticket"></param>
+/// <param name="LONG waitingStateWord - the ticket's state word while it waits"></param>
+/// <returns>True if succeeded. False if the queue is full</returns>
+static BOOL enqueueWaitingTicket(matchmakingQueue* p_queue, matchmakingTicket* p_ticket, LONG waitingStateWord);
+
+/// <summary>
+/// Description - This function removes the earliest entry of a queue. The entry's ticket may have stopped waiting since - the caller's claim decides
+/// </summary>
+/// <param name="matchmakingQueue* p_queue - pointer to the queue"></param>
+/// <param name="matchmakingTicket** p_p_ticket - address of a pointer that will point to the entry's ticket"></param>
+/// <param name="LONG* p_waitingStateWord - pointer to a LONG that will hold the ticket's state word of when it was enqueued"></param>
+/// <returns>True if an entry was removed. False if the queue is empty</returns>
+static BOOL dequeueWaitingTicket(matchmakingQueue* p_queue, matchmakingTicket** p_p_ticket, LONG* p_waitingStateWord);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeMatchmaking(matchmakingModes mode, BOOL isBotFallbackEnabled, unsigned short serverPortNumber)
+{
+	int q = 0, cell = 0, t = 0;
+
+	g_matchmakingMode = mode;
+	g_isBotFallbackEnabled = isBotFallbackEnabled;
+	g_matchmakingServerPortNumber = serverPortNumber;
+	g_numOfMatchmakingQueues = (MATCHMAKING_MODE_SKILL_BUCKETS == mode) ? MATCHMAKING_NUM_OF_BUCKETS : 1;
+
+	//Allocate the queues - every cell's sequence starts at its index, so the first lap of enqueues finds them free
+	if (NULL == (g_p_matchmakingQueues = (matchmakingQueue*)_aligned_malloc(sizeof(matchmakingQueue) * g_numOfMatchmakingQueues, CACHE_LINE_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the matchmaking queues", 0, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	memset(g_p_matchmakingQueues, 0, sizeof(matchmakingQueue) * g_numOfMatchmakingQueues);
+	for (q = 0; q < g_numOfMatchmakingQueues; q++)
+		for (cell = 0; cell < MATCHMAKING_QUEUE_CAPACITY; cell++)
+			g_p_matchmakingQueues[q].cells[cell].sequence = cell;
+
+	//Allocate the tickets, each with its auto-reset "matched" Event, and push them to the free list
+	if (NULL == (g_p_matchmakingTickets = (matchmakingTicket*)_aligned_malloc(sizeof(matchmakingTicket) * MATCHMAKING_MAX_TICKETS, CACHE_LINE_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the matchmaking tickets", 0, 0);
+		destroyMatchmaking();
+		return STATUS_CODE_FAILURE;
+	}
+	memset(g_p_matchmakingTickets, 0, sizeof(matchmakingTicket) * MATCHMAKING_MAX_TICKETS);
+	InitializeSListHead(&g_freeMatchmakingTickets);
+	for (t = 0; t < MATCHMAKING_MAX_TICKETS; t++) {
+		if (NULL == (g_p_matchmakingTickets[t].h_matchedEvent = CreateEvent(NULL, FALSE, FALSE, NULL))) {
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create a matchmaking ticket 'matched' Event", GetLastError(), 0);
+			destroyMatchmaking();
+			return STATUS_CODE_FAILURE;
+		}
+		g_p_matchmakingTickets[t].stateWord = MATCHMAKING_TICKET_STATE_WORD(0, MATCHMAKING_TICKET_IDLE);
+		InterlockedPushEntrySList(&g_freeMatchmakingTickets, &g_p_matchmakingTickets[t].freeListEntry);
+	}
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyMatchmaking()
+{
+	int t = 0;
+
+	//The bot may still be leaving
+	stopMatchmakingBot();
+
+	if (NULL != g_p_matchmakingTickets) {
+		for (t = 0; t < MATCHMAKING_MAX_TICKETS; t++)
+			if (NULL != g_p_matchmakingTickets[t].h_matchedEvent) CloseHandle(g_p_matchmakingTickets[t].h_matchedEvent);
+		_aligned_free(g_p_matchmakingTickets);
+		g_p_matchmakingTickets = NULL;
+	}
+	if (NULL != g_p_matchmakingQueues) {
+		_aligned_free(g_p_matchmakingQueues);
+		g_p_matchmakingQueues = NULL;
+	}
+	g_numOfMatchmakingQueues = 0;
+}
+
+matchmakingOutcomes findOpponent(int skillRating, BOOL isBot, BOOL isBotFallbackAllowed, HANDLE* p_h_exitEvent, HANDLE* p_h_errorEvent)
+{
+	matchmakingOutcomes outcome = MATCHMAKING_FAILED;
+	LONGLONG startTicks = 0;
+	BOOL isOpponentBot = FALSE;
+	int bucket = 0;
+	//Input integrity validation
+	if ((NULL == p_h_exitEvent) || (NULL == p_h_errorEvent)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return MATCHMAKING_FAILED;
+	}
+	if (NULL == g_p_matchmakingQueues) return MATCHMAKING_FAILED;
+
+	startTicks = readMetricsClock();
+	bucket = fetchRatingBucket(skillRating);
+
+	//1st - claim a waiting player. 2nd - wait to be claimed (the bot never waits - it was summoned for a player that is already waiting, at any rating)
+	if (STATUS_CODE_SUCCESS == claimWaitingPlayer(bucket, (TRUE == isBot) ? MATCHMAKING_NUM_OF_BUCKETS : MATCHMAKING_BUCKET_SPREAD, isBot, &isOpponentBot))
+		outcome = (TRUE == isOpponentBot) ? MATCHMAKING_MATCHED_BOT : MATCHMAKING_MATCHED_PLAYER;
+	else if (TRUE == isBot)
+		outcome = MATCHMAKING_NO_OPPONENT;
+	else
+		outcome = waitToBeClaimed(bucket, isBotFallbackAllowed, p_h_exitEvent, p_h_errorEvent);
+
+	//Metrics - the players' outcomes only
+	if (FALSE == isBot) recordMatchmakingOutcome(outcome, startTicks);
+	return outcome;
+}
+
+LONG fetchMatchmakingQueueDepth()
+{
+	return g_numOfWaitingPlayers;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static int fetchRatingBucket(int skillRating)
+{
+	int bucket = 0;
+
+	if (MATCHMAKING_MODE_SKILL_BUCKETS != g_matchmakingMode) return 0;
+	bucket = skillRating / MATCHMAKING_BUCKET_WIDTH;
+	if (0 > bucket) return 0;
+	if (g_numOfMatchmakingQueues <= bucket) return g_numOfMatchmakingQueues - 1;
+	return bucket;
+}
+
+static BOOL claimWaitingPlayer(int bucket, int spread, BOOL isBot, BOOL* p_isOpponentBot)
+{
+	matchmakingTicket* p_waitingTicket = NULL;
+	LONG waitingStateWord = 0;
+	int distance = 0, side = 0, searchedBucket = 0;
+	//Assert
+	assert(NULL != p_isOpponentBot);
+
+	//Own bucket first, then outwards - the nearest ratings are preferred
+	for (distance = 0; distance <= spread; distance++) {
+		for (side = -1; side <= 1; side += 2) {
+			if ((0 == distance) && (1 == side)) break; //The own bucket is searched once
+			searchedBucket = bucket + side * distance;
+			if ((0 > searchedBucket) || (g_numOfMatchmakingQueues <= searchedBucket)) continue;
+
+			while (STATUS_CODE_SUCCESS == dequeueWaitingTicket(g_p_matchmakingQueues + searchedBucket, &p_waitingTicket, &waitingStateWord)) {
+				//Claim the ticket - fails if its owner cancelled it (or already waits again with a newer generation), so the entry is dropped
+				if (waitingStateWord != InterlockedCompareExchange(&p_waitingTicket->stateWord,
+					MATCHMAKING_TICKET_STATE_WORD(MATCHMAKING_TICKET_GENERATION(waitingStateWord), MATCHMAKING_TICKET_MATCHED), waitingStateWord)) continue;
+
+				//Claimed - the owner reads the opponent's kind only after the "matched" Event
+				p_waitingTicket->isOpponentBot = isBot;
+				*p_isOpponentBot = p_waitingTicket->isBot;
+				if (FALSE == SetEvent(p_waitingTicket->h_matchedEvent))
+					LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to signal a claimed matchmaking ticket", GetLastError(), 0);
+				return STATUS_CODE_SUCCESS;
+			}
+		}
+	}
+	return STATUS_CODE_FAILURE;
+}
+
+static matchmakingOutcomes waitToBeClaimed(int bucket, BOOL isBotFallbackAllowed, HANDLE* p_h_exitEvent, HANDLE* p_h_errorEvent)
+{
+	matchmakingTicket* p_ticket = NULL;
+	matchmakingOutcomes outcome = MATCHMAKING_FAILED;
+	HANDLE h_waitEvents[3] = { NULL, NULL, NULL };
+	LONG generation = 0, waitingStateWord = 0;
+	ULONGLONG deadlineTicks = 0, nowTicks = 0;
+	DWORD waitCode = WAIT_TIMEOUT, waitInterval = 0;
+	int spread = MATCHMAKING_BUCKET_SPREAD;
+	BOOL isArmed = FALSE, isWidening = FALSE, isBotSummoned = FALSE, isOpponentClaimed = FALSE, isOpponentBot = FALSE;
+	//Asserts
+	assert(NULL != p_h_exitEvent);
+	assert(NULL != p_h_errorEvent);
+
+	//Take an idle ticket - there is one per Worker thread
+	if (NULL == (p_ticket = (matchmakingTicket*)InterlockedPopEntrySList(&g_freeMatchmakingTickets))) {
+		LOG_EVENT(LOG_EVENT_UNEXPECTED, "No idle matchmaking ticket", 0, 0);
+		return MATCHMAKING_FAILED;
+	}
+	p_ticket->isBot = FALSE;
+	h_waitEvents[0] = p_ticket->h_matchedEvent;
+	h_waitEvents[1] = *p_h_exitEvent;
+	h_waitEvents[2] = *p_h_errorEvent;
+
+	InterlockedIncrement(&g_numOfWaitingPlayers);
+	deadlineTicks = GetTickCount64() + MATCHMAKING_WAIT_TIMEOUT_MS;
+	while (TRUE) {
+		//(Re)arm the ticket with a new generation & enqueue it
+		if (FALSE == isArmed) {
+			p_ticket->isOpponentBot = FALSE;
+			generation = MATCHMAKING_TICKET_GENERATION(p_ticket->stateWord) + 1;
+			waitingStateWord = MATCHMAKING_TICKET_STATE_WORD(generation, MATCHMAKING_TICKET_WAITING);
+			InterlockedExchange(&p_ticket->stateWord, waitingStateWord);
+			isArmed = TRUE;
+			if (STATUS_CODE_FAILURE == enqueueWaitingTicket(g_p_matchmakingQueues + bucket, p_ticket, waitingStateWord)) {
+				LOG_EVENT(LOG_EVENT_UNEXPECTED, "Matchmaking queue is full", bucket, 0);
+				break; //Leave as if nobody arrived
+			}
+		}
+
+		//Wait for a claim until the deadline - in skill mode, wake up every MATCHMAKING_WINDOW_WIDEN_INTERVAL_MS to widen the rating window
+		nowTicks = GetTickCount64();
+		waitInterval = (deadlineTicks > nowTicks) ? (DWORD)(deadlineTicks - nowTicks) : 0;
+		isWidening = (MATCHMAKING_MODE_SKILL_BUCKETS == g_matchmakingMode) && (MATCHMAKING_NUM_OF_BUCKETS - 1 > spread) &&
+			(MATCHMAKING_WINDOW_WIDEN_INTERVAL_MS < waitInterval);
+		waitCode = WaitForMultipleObjects(NUM_OF_WAIT_EVENTS, h_waitEvents, FALSE, (TRUE == isWidening) ? MATCHMAKING_WINDOW_WIDEN_INTERVAL_MS : waitInterval);
+		if (WAIT_TIMEOUT != waitCode) break;
+
+		if (TRUE == isWidening) {
+			//Withdraw the ticket (fails if it was claimed meanwhile - the match is taken below), then claim a player of the wider window
+			spread++;
+			if (waitingStateWord != InterlockedCompareExchange(&p_ticket->stateWord,
+				MATCHMAKING_TICKET_STATE_WORD(generation, MATCHMAKING_TICKET_CANCELLED), waitingStateWord)) break;
+			isArmed = FALSE;
+			if (STATUS_CODE_SUCCESS == claimWaitingPlayer(bucket, spread, FALSE, &isOpponentBot)) {
+				isOpponentClaimed = TRUE;
+				break;
+			}
+			continue;
+		}
+
+		//Nobody arrived - summon the bot once (if one already plays, it is not summoned again), and give it time to connect & claim the ticket
+		if ((TRUE == isBotSummoned) || (FALSE == isBotFallbackAllowed) || (FALSE == g_isBotFallbackEnabled) ||
+			(STATUS_CODE_FAILURE == startMatchmakingBot(g_matchmakingServerPortNumber))) break;
+		LOG_EVENT(LOG_EVENT_TRACE, "No opponent arrived - the matchmaking bot was summoned", bucket, 0);
+		isBotSummoned = TRUE;
+		deadlineTicks = GetTickCount64() + MATCHMAKING_BOT_ARRIVAL_TIMEOUT_MS;
+	}
+
+	if (TRUE == isOpponentClaimed)
+		outcome = (TRUE == isOpponentBot) ? MATCHMAKING_MATCHED_BOT : MATCHMAKING_MATCHED_PLAYER;
+	else if (WAIT_OBJECT_0 == waitCode)
+		outcome = (TRUE == p_ticket->isOpponentBot) ? MATCHMAKING_MATCHED_BOT : MATCHMAKING_MATCHED_PLAYER;
+	//Cancel the ticket - its queue entry is dropped by whoever dequeues it
+	else if (waitingStateWord == InterlockedCompareExchange(&p_ticket->stateWord,
+		MATCHMAKING_TICKET_STATE_WORD(generation, MATCHMAKING_TICKET_CANCELLED), waitingStateWord)) {
+		switch (waitCode) {
+		case WAIT_TIMEOUT: outcome = MATCHMAKING_NO_OPPONENT; break;
+		case WAIT_OBJECT_0 + 1:
+		case WAIT_OBJECT_0 + 2: outcome = MATCHMAKING_ABORTED; break;
+		default:
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait for a matchmaking opponent using WaitForMultipleObjects(.)", GetLastError(), 0);
+			outcome = MATCHMAKING_FAILED;
+		}
+	}
+	//Claimed just before the cancel - the opponent is signaling, so consume the "matched" Event
+	else if (WAIT_OBJECT_0 != WaitForSingleObject(p_ticket->h_matchedEvent, MATCHED_SIGNAL_TIMEOUT)) {
+		LOG_EVENT(LOG_EVENT_UNEXPECTED, "A claimed matchmaking ticket was never signaled", 0, 0);
+		outcome = MATCHMAKING_FAILED;
+	}
+	else if (WAIT_TIMEOUT == waitCode)
+		outcome = (TRUE == p_ticket->isOpponentBot) ? MATCHMAKING_MATCHED_BOT : MATCHMAKING_MATCHED_PLAYER;
+	else
+		outcome = MATCHMAKING_ABORTED; //The 'EXIT'\'ERROR' Events were signaled - the opponent's wait for this player times out
+
+	InterlockedDecrement(&g_numOfWaitingPlayers);
+
+	//Return the ticket - its generation stays, so its stale queue entries (if any) still fail to claim it
+	InterlockedExchange(&p_ticket->stateWord, MATCHMAKING_TICKET_STATE_WORD(generation, MATCHMAKING_TICKET_IDLE));
+	InterlockedPushEntrySList(&g_freeMatchmakingTickets, &p_ticket->freeListEntry);
+	return outcome;
+}
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Waiting queues
+static BOOL enqueueWaitingTicket(matchmakingQueue* p_queue, matchmakingTicket* p_ticket, LONG waitingStateWord)
+{
+	matchmakingCell* p_cell = NULL;
+	LONG position = 0, observedPosition = 0, sequenceDifference = 0;
+	//Asserts
+	assert(NULL != p_queue);
+	assert(NULL != p_ticket);
+
+	position = p_queue->enqueuePosition;
+	while (TRUE) {
+		p_cell = p_queue->cells + (position & MATCHMAKING_QUEUE_MASK);
+		sequenceDifference = p_cell->sequence - position;
+		//The cell is free at this lap - take the position
+		if (0 == sequenceDifference) {
+			if (position == (observedPosition = InterlockedCompareExchange(&p_queue->enqueuePosition, position + 1, position))) break;
+			position = observedPosition;
+		}
+		//The cell still holds the previous lap's entry - the queue is full
+		else if (0 > sequenceDifference) return STATUS_CODE_FAILURE;
+		//Another enqueuer took the position
+		else position = p_queue->enqueuePosition;
+	}
+
+	p_cell->p_ticket = p_ticket;
+	p_cell->waitingStateWord = waitingStateWord;
+	//Publish the entry (full barrier)
+	InterlockedExchange(&p_cell->sequence, position + 1);
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL dequeueWaitingTicket(matchmakingQueue* p_queue, matchmakingTicket** p_p_ticket, LONG* p_waitingStateWord)
+{
+	matchmakingCell* p_cell = NULL;
+	LONG position = 0, observedPosition = 0, sequenceDifference = 0;
+	//Asserts
+	assert(NULL != p_queue);
+	assert(NULL != p_p_ticket);
+	assert(NULL != p_waitingStateWord);
+
+	position = p_queue->dequeuePosition;
+	while (TRUE) {
+		p_cell = p_queue->cells + (position & MATCHMAKING_QUEUE_MASK);
+		sequenceDifference = p_cell->sequence - (position + 1);
+		//The cell holds a published entry - take the position
+		if (0 == sequenceDifference) {
+			if (position == (observedPosition = InterlockedCompareExchange(&p_queue->dequeuePosition, position + 1, position))) break;
+			position = observedPosition;
+		}
+		//Nothing was published at this position - the queue is empty
+		else if (0 > sequenceDifference) return STATUS_CODE_FAILURE;
+		//Another dequeuer took the position
+		else position = p_queue->dequeuePosition;
+	}
+
+	*p_p_ticket = p_cell->p_ticket;
+	*p_waitingStateWord = p_cell->waitingStateWord;
+	//Free the cell for the next lap (full barrier)
+	InterlockedExchange(&p_cell->sequence, position + MATCHMAKING_QUEUE_MASK + 1);
+	return STATUS_CODE_SUCCESS;
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
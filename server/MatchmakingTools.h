@@ -0,0 +1,60 @@
+/* MatchmakingTools.h
+------------------------------------------------------------------
+	Module Description - header module for MatchmakingTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __MATCHMAKING_TOOLS_H__
+#define __MATCHMAKING_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function allocates the matchmaking queues (a single one in MATCHMAKING_MODE_FIFO, MATCHMAKING_NUM_OF_BUCKETS in MATCHMAKING_MODE_SKILL_BUCKETS)
+/// and the waiting tickets, each with its "matched" Event, and keeps the idle tickets in an interlocked free list. Must be called once, before any Worker thread is created
+/// </summary>
+/// <param name="matchmakingModes mode - MATCHMAKING_MODE_FIFO or MATCHMAKING_MODE_SKILL_BUCKETS"></param>
+/// <param name="BOOL isBotFallbackEnabled - TRUE if a player left alone may be offered the Server's bot"></param>
+/// <param name="unsigned short serverPortNumber - the port the bot connects to"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeMatchmaking(matchmakingModes mode, BOOL isBotFallbackEnabled, unsigned short serverPortNumber);
+
+/// <summary>
+/// Description - This function waits for the bot (if one is playing) and frees the queues & the tickets. Must be called once, after all Worker threads ended
+/// </summary>
+void destroyMatchmaking();
+
+/// <summary>
+/// Description - This function finds an opponent for a player that sent CLIENT_VERSUS. It first claims the earliest waiting player of its own bucket
+/// (then of the neighbouring buckets), without any lock - an InterlockedCompareExchange on the waiter's ticket decides which of the racing players gets it.
+/// If nobody waits, the player enqueues a ticket and waits up to MATCHMAKING_WAIT_TIMEOUT_MS to be claimed (in skill mode, its rating window widens while it waits). A player left alone may summon the Server's bot
+/// and wait for it MATCHMAKING_BOT_ARRIVAL_TIMEOUT_MS more. The outcome & the match latency are recorded by the metrics registry
+/// </summary>
+/// <param name="int skillRating - the player's rating (ignored in MATCHMAKING_MODE_FIFO)"></param>
+/// <param name="BOOL isBot - TRUE if the player is the Server's bot (a bot only claims waiting players, it never waits)"></param>
+/// <param name="BOOL isBotFallbackAllowed - TRUE if the bot may be summoned for this player (there is a free Worker thread for it)"></param>
+/// <param name="HANDLE* p_h_exitEvent - pointer to the 'EXIT' Event, which ends the wait"></param>
+/// <param name="HANDLE* p_h_errorEvent - pointer to the 'ERROR' Event, which ends the wait"></param>
+/// <returns>MATCHMAKING_MATCHED_PLAYER\BOT if an opponent was found, MATCHMAKING_NO_OPPONENT if none arrived in time,
+/// MATCHMAKING_ABORTED if the 'EXIT'\'ERROR' Events were signaled, MATCHMAKING_FAILED otherwise</returns>
+matchmakingOutcomes findOpponent(int skillRating, BOOL isBot, BOOL isBotFallbackAllowed, HANDLE* p_h_exitEvent, HANDLE* p_h_errorEvent);
+
+/// <summary>
+/// Description - This function fetches the # of players currently waiting for an opponent
+/// </summary>
+/// <returns># of waiting players</returns>
+LONG fetchMatchmakingQueueDepth();
+
+
+#endif //__MATCHMAKING_TOOLS_H__
@@ -0,0 +1,776 @@
+/* MicrobenchmarkSuite.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the microbenchmark suite of the
+		messages & game hot paths, built ONLY when MICROBENCHMARK_SUITE is defined:
+		scoring (playSingleGamePhase), the solver's candidates filtering (each
+		number re-scored, and a candidate set), received messages translation, messages
+		construction (Server & Client builders), the string utilities and a
+		sendString(.)\receiveString(.) round trip over a loopback connection.
+		Every case is run with a growing number of iterations until a run lasts
+		at least BENCHMARK_MIN_RUN_SEC, and the last run is reported as ns/op,
+		allocations/op (slab allocator counters) & throughput - as a table, or
+		as JSON (--json). A previous JSON output may be given as a baseline
+		(--baseline <file>), and every case is then compared against it.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef MICROBENCHMARK_SUITE
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "MicrobenchmarkSuite.h"
+#include "MemoryHandling.h"
+#include "MessagesTransferringTools.h"
+#include "ServerClientsTools.h"
+#include "ServerSideWorkerThreadRoutine.h"
+#include "SlabAllocationTools.h"
+#include "GameVariantTools.h"
+#include "CandidateSetTools.h"
+
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL INETPTONS_SUCCESS = 1;
+
+//0o0o0o Iterations growth - as Google Benchmark: predict the iterations that reach the minimal run time (with a margin), growing at most 10x a run
+static const double BENCHMARK_MIN_RUN_SEC = 0.5;
+static const double BENCHMARK_GROWTH_MARGIN = 1.4;
+static const double BENCHMARK_MAX_GROWTH = 10.0;
+static const LONGLONG BENCHMARK_MAX_ITERATIONS = 1000000000;
+
+static const unsigned int BENCHMARK_RANDOM_SEED = 2021;	// the scoring pairs are the same in every run
+static const SHORT BENCHMARK_HEX_NUMBER_LEN = 6;			// the 6x16 variant
+static const SHORT BENCHMARK_HEX_ALPHABET_SIZE = 16;
+static const double NANOSECONDS_IN_SECOND = 1000000000.0;
+static const double PERCENT = 100.0;
+
+//0o0o0o Command line options
+static const char JSON_OUTPUT_OPTION[] = "--json";
+static const char BASELINE_OPTION[] = "--baseline";
+
+//0o0o0o Message parameters (a round's results of an 8 letters player name)
+static char BENCHMARK_BULLS[] = "2";
+static char BENCHMARK_COWS[] = "1";
+static char BENCHMARK_PLAYER_NAME[] = "Benchmar";
+static char BENCHMARK_GUESS[] = "1234";
+
+
+// Functions declerations ------------------------------------------------------
+
+//......Cases
+
+/// <summary>
+/// Description - Case: scores a guess against an initial number with playSingleGamePhase(.), cycling BENCHMARK_NUM_OF_SCORING_PAIRS random pairs
+/// </summary>
+static BOOL benchmarkPlaySingleGamePhase(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: translates a received SERVER_GAME_RESULTS buffer (allocated & filled as receiveString(.) does) & frees the message
+/// </summary>
+static BOOL benchmarkTranslateGameResults(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: translates a received CLIENT_PLAYER_MOVE buffer (allocated & filled as receiveString(.) does) & frees the message
+/// </summary>
+static BOOL benchmarkTranslatePlayerMove(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: constructs a SERVER_GAME_RESULTS message with constructMessageForSendingServer(.) & frees it
+/// </summary>
+static BOOL benchmarkConstructGameResults(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: constructs a CLIENT_PLAYER_MOVE message with constructMessageForSendingClient(.) & frees it
+/// </summary>
+static BOOL benchmarkConstructPlayerMove(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: scores the classic pairs with the variant kernel specialized for 4x10 (compare with BM_playSingleGamePhase)
+/// </summary>
+static BOOL benchmarkScoreGuessClassic(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: scores the 6x16 pairs with the variant kernel specialized for 6x16
+/// </summary>
+static BOOL benchmarkScoreGuessHex(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: scores the 6x16 pairs with the generic kernel (the 6x16 variant with repeats)
+/// </summary>
+static BOOL benchmarkScoreGuessHexRepeats(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - This function scores the pairs of a scoring case with a variant's scorer
+/// </summary>
+/// <param name="const gameVariant* p_variant - the variant"></param>
+/// <param name="char (*p_initialNumbers)[MAX_PLAYER_NUMBER_LEN + 1], (*p_guesses)[..] - the pairs (BENCHMARK_NUM_OF_SCORING_PAIRS)"></param>
+/// <returns>the sum of the scores, so the calls are not optimized away</returns>
+static LONGLONG scoreBenchmarkPairs(const gameVariant* p_variant, char (*p_initialNumbers)[MAX_PLAYER_NUMBER_LEN + 1], char (*p_guesses)[MAX_PLAYER_NUMBER_LEN + 1], LONGLONG iterations);
+
+/// <summary>
+/// Description - Case: filters every classic number by a pair's result, re-scoring each one with the classic kernel (the bot's filter before the candidate sets)
+/// </summary>
+static BOOL benchmarkFilterCandidatesNaive(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: filters every classic number by a pair's result with filterCandidateSet(.) (compare with BM_filterCandidates/naive)
+/// </summary>
+static BOOL benchmarkFilterCandidatesBitset(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: copies BENCHMARK_STRING_LEN bytes with concatenateStringToStringThatMayContainNullCharacters(.)
+/// </summary>
+static BOOL benchmarkConcatenateString(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: measures a BENCHMARK_STRING_LEN characters string with fetchStringLength(.)
+/// </summary>
+static BOOL benchmarkFetchStringLength(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+/// <summary>
+/// Description - Case: sends a SERVER_GAME_RESULTS message with sendString(.) & receives it with receiveString(.) over the loopback connection
+/// </summary>
+static BOOL benchmarkLoopbackRoundTrip(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed);
+
+//......Suite
+
+/// <summary>
+/// Description - This function reads the command line options of the suite
+/// </summary>
+/// <param name="BOOL* p_isJsonOutput - pointer to the JSON output flag (output)"></param>
+/// <param name="char** p_p_baselinePath - pointer to the baseline file path, NULL if not given (output)"></param>
+/// <returns>True if the options are valid. False otherwise</returns>
+static BOOL fetchSuiteOptions(int argc, char* argv[], BOOL* p_isJsonOutput, char** p_p_baselinePath);
+
+/// <summary>
+/// Description - This function prepares the inputs of all the cases: scoring pairs, strings, messages & the loopback connection
+/// </summary>
+/// <param name="benchmarkContext* p_context - pointer to a zeroed context"></param>
+/// <returns>True if succeeded. False otherwise (the context is released by releaseBenchmarkContext(.) regardless)</returns>
+static BOOL prepareBenchmarkContext(benchmarkContext* p_context);
+
+/// <summary>
+/// Description - This function calculates the # of bytes sendString(.) sends of a constructed message: up to & including its '\n'
+/// (the buffer may contain '\0' characters, so string functions are not used)
+/// </summary>
+static int fetchMessageWireLength(const messageString* p_messageString);
+
+/// <summary>
+/// Description - This function frees the messages & closes the loopback connection of the context
+/// </summary>
+static void releaseBenchmarkContext(benchmarkContext* p_context);
+
+/// <summary>
+/// Description - This function connects a socket to a listening socket on SERVER_ADDRESS_STR (any free port) and accepts the connection
+/// </summary>
+/// <param name="SOCKET* p_s_sendingSocket - pointer to the connecting socket (output)"></param>
+/// <param name="SOCKET* p_s_receivingSocket - pointer to the accepted socket (output)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL createLoopbackConnection(SOCKET* p_s_sendingSocket, SOCKET* p_s_receivingSocket);
+
+/// <summary>
+/// Description - This function runs a case with growing iterations until a run lasts BENCHMARK_MIN_RUN_SEC, and measures its last run
+/// </summary>
+/// <param name="const benchmarkCase* p_case - pointer to the case"></param>
+/// <param name="benchmarkContext* p_context - pointer to the prepared context"></param>
+/// <param name="benchmarkResult* p_result - pointer to the result (output)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL runBenchmarkCase(const benchmarkCase* p_case, benchmarkContext* p_context, benchmarkResult* p_result);
+
+/// <summary>
+/// Description - This function sums the objects & buffers the slab allocator has ever handed out
+/// </summary>
+static LONGLONG fetchTotalAllocations();
+
+/// <summary>
+/// Description - This function reads a whole baseline file into a zero-terminated Heap buffer
+/// </summary>
+/// <returns>pointer to the buffer (freed by the caller), or NULL if failed</returns>
+static char* loadBaselineFile(const char* p_baselinePath);
+
+/// <summary>
+/// Description - This function finds a case in a baseline (a previous --json output) & fetches its ns/op
+/// </summary>
+/// <returns>the case's ns/op, or 0 if the case is not in the baseline</returns>
+static double fetchBaselineNanosecondsPerOperation(const char* p_baseline, const char* p_caseName);
+
+/// <summary>
+/// Description - This function prints the results as a table (with the change vs the baseline, if exists)
+/// </summary>
+static void printResultsTable(const benchmarkResult* p_results, int numOfResults);
+
+/// <summary>
+/// Description - This function prints the results as JSON, in Google Benchmark's layout (with the baseline fields, if exists)
+/// </summary>
+static void printResultsJson(const benchmarkResult* p_results, int numOfResults);
+
+
+//The cases, in their printing order
+static const benchmarkCase BENCHMARK_CASES[] = {
+	{ "BM_playSingleGamePhase", benchmarkPlaySingleGamePhase },
+	{ "BM_scoreGuess/4x10", benchmarkScoreGuessClassic },
+	{ "BM_scoreGuess/6x16", benchmarkScoreGuessHex },
+	{ "BM_scoreGuess/6x16r", benchmarkScoreGuessHexRepeats },
+	{ "BM_filterCandidates/naive", benchmarkFilterCandidatesNaive },
+	{ "BM_filterCandidates/bitset", benchmarkFilterCandidatesBitset },
+	{ "BM_translateReceivedMessageToMessageStruct/SERVER_GAME_RESULTS", benchmarkTranslateGameResults },
+	{ "BM_translateReceivedMessageToMessageStruct/CLIENT_PLAYER_MOVE", benchmarkTranslatePlayerMove },
+	{ "BM_constructMessageForSendingServer/SERVER_GAME_RESULTS", benchmarkConstructGameResults },
+	{ "BM_constructMessageForSendingClient/CLIENT_PLAYER_MOVE", benchmarkConstructPlayerMove },
+	{ "BM_concatenateStringToStringThatMayContainNullCharacters/64", benchmarkConcatenateString },
+	{ "BM_fetchStringLength/64", benchmarkFetchStringLength },
+	{ "BM_sendStringReceiveString/loopback", benchmarkLoopbackRoundTrip } };
+
+
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runMicrobenchmarkSuite(int argc, char* argv[])
+{
+	benchmarkContext* p_context = NULL;
+	benchmarkResult* p_results = NULL;
+	WSADATA wsaData;
+	char* p_baselinePath = NULL, *p_baseline = NULL;
+	int numOfCases = (int)(sizeof(BENCHMARK_CASES) / sizeof(BENCHMARK_CASES[0])), c = 0;
+	BOOL isJsonOutput = FALSE, suiteSucceeded = TRUE;
+
+	if (STATUS_CODE_FAILURE == fetchSuiteOptions(argc, argv, &isJsonOutput, &p_baselinePath)) {
+		printf("Usage: %s [%s] [%s <a previous %s output>]\n", argv[0], JSON_OUTPUT_OPTION, BASELINE_OPTION, JSON_OUTPUT_OPTION);
+		return STATUS_CODE_FAILURE;
+	}
+	if ((NULL != p_baselinePath) && (NULL == (p_baseline = loadBaselineFile(p_baselinePath)))) return STATUS_CODE_FAILURE;
+
+	//The builders & receiveString(.) allocate from the slab caches, and the round trip needs Winsock
+	if (STATUS_CODE_FAILURE == initializeSlabAllocator()) {
+		free(p_baseline);
+		return STATUS_CODE_FAILURE;
+	}
+	if (NO_ERROR != WSAStartup(MAKEWORD(2, 2), &wsaData)) {
+		printf("Error: Failed to initalize Winsock API using WSAStartup( ) with error code no. %ld.\n", WSAGetLastError());
+		destroySlabAllocator();
+		free(p_baseline);
+		return STATUS_CODE_FAILURE;
+	}
+
+	p_context = (benchmarkContext*)calloc(sizeof(benchmarkContext), 1);
+	p_results = (benchmarkResult*)calloc(sizeof(benchmarkResult), numOfCases);
+	if ((NULL == p_context) || (NULL == p_results)) {
+		printf("Error: Failed to allocate memory for the microbenchmark context & results.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		suiteSucceeded = FALSE;
+	}
+	else {
+		p_context->s_sendingSocket = INVALID_SOCKET;
+		p_context->s_receivingSocket = INVALID_SOCKET;
+		suiteSucceeded = prepareBenchmarkContext(p_context);
+	}
+
+	//Run every case (progress goes to stderr, so the JSON output stays clean)
+	for (c = 0; (TRUE == suiteSucceeded) && (c < numOfCases); c++) {
+		fprintf(stderr, "Running %s...\n", BENCHMARK_CASES[c].p_name);
+		if (STATUS_CODE_FAILURE == (suiteSucceeded = runBenchmarkCase(&BENCHMARK_CASES[c], p_context, p_results + c))) {
+			printf("Error: The microbenchmark case %s failed.\n", BENCHMARK_CASES[c].p_name);
+			break;
+		}
+		if (NULL != p_baseline)
+			(p_results + c)->baselineNanosecondsPerOperation = fetchBaselineNanosecondsPerOperation(p_baseline, BENCHMARK_CASES[c].p_name);
+	}
+
+	if (TRUE == suiteSucceeded) {
+		if (TRUE == isJsonOutput) printResultsJson(p_results, numOfCases);
+		else printResultsTable(p_results, numOfCases);
+	}
+
+	if (NULL != p_context) releaseBenchmarkContext(p_context);
+	free(p_context);
+	free(p_results);
+	free(p_baseline);
+	WSACleanup();
+	destroySlabAllocator();
+	return suiteSucceeded;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Cases
+static BOOL benchmarkPlaySingleGamePhase(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	LONGLONG i = 0, sink = 0;
+	SHORT bulls = 0, cows = 0;
+	int pair = 0;
+
+	for (i = 0; i < iterations; i++) {
+		pair = (int)(i & (BENCHMARK_NUM_OF_SCORING_PAIRS - 1));
+		playSingleGamePhase(p_context->initialNumbers[pair], p_context->guesses[pair], &bulls, &cows);
+		sink += (bulls << 4) + cows;
+	}
+
+	p_context->sink += sink;
+	*p_bytesProcessed = 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkScoreGuessClassic(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	p_context->sink += scoreBenchmarkPairs(&p_context->classicVariant, p_context->classicInitialNumbers, p_context->classicGuesses, iterations);
+	*p_bytesProcessed = 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkScoreGuessHex(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	p_context->sink += scoreBenchmarkPairs(&p_context->hexVariant, p_context->hexInitialNumbers, p_context->hexGuesses, iterations);
+	*p_bytesProcessed = 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkScoreGuessHexRepeats(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	p_context->sink += scoreBenchmarkPairs(&p_context->hexRepeatsVariant, p_context->hexInitialNumbers, p_context->hexGuesses, iterations);
+	*p_bytesProcessed = 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static LONGLONG scoreBenchmarkPairs(const gameVariant* p_variant, char (*p_initialNumbers)[MAX_PLAYER_NUMBER_LEN + 1], char (*p_guesses)[MAX_PLAYER_NUMBER_LEN + 1], LONGLONG iterations)
+{
+	LONGLONG i = 0, sink = 0;
+	SHORT bulls = 0, cows = 0;
+	int pair = 0;
+
+	for (i = 0; i < iterations; i++) {
+		pair = (int)(i & (BENCHMARK_NUM_OF_SCORING_PAIRS - 1));
+		p_variant->p_scoreGuess(p_initialNumbers[pair], p_guesses[pair], &bulls, &cows);
+		sink += (bulls << 4) + cows;
+	}
+	return sink;
+}
+
+static BOOL benchmarkFilterCandidatesNaive(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	LONGLONG i = 0, sink = 0;
+	SHORT bulls = 0, cows = 0;
+	int pair = 0, candidate = 0, numOfKept = 0;
+
+	for (i = 0; i < iterations; i++) {
+		pair = (int)(i & (BENCHMARK_NUM_OF_SCORING_PAIRS - 1));
+		for (candidate = 0, numOfKept = 0; candidate < NUM_OF_PLAYER_NUMBERS; candidate++) {
+			p_context->classicVariant.p_scoreGuess(p_context->candidateNumbers[candidate], p_context->classicGuesses[pair], &bulls, &cows);
+			if ((p_context->filterBulls[pair] == bulls) && (p_context->filterCows[pair] == cows)) p_context->keptCandidates[numOfKept++] = (SHORT)candidate;
+		}
+		sink += numOfKept;
+	}
+
+	p_context->sink += sink;
+	*p_bytesProcessed = 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkFilterCandidatesBitset(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	candidateSet candidates;
+	LONGLONG i = 0, sink = 0;
+	int pair = 0;
+
+	for (i = 0; i < iterations; i++) {
+		pair = (int)(i & (BENCHMARK_NUM_OF_SCORING_PAIRS - 1));
+		fillCandidateSet(&candidates);
+		sink += filterCandidateSet(&candidates, p_context->classicGuesses[pair], p_context->filterBulls[pair], p_context->filterCows[pair]);
+	}
+
+	p_context->sink += sink;
+	*p_bytesProcessed = 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkTranslateGameResults(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	messageString* p_sentMessage = p_context->p_gameResultsMessage;
+	int wireLength = p_context->gameResultsWireLength;
+	message* p_message = NULL;
+	char* p_receivedBuffer = NULL;
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++) {
+		//As receiveString(.) hands the buffer over - translateReceivedMessageToMessageStruct(.) frees it
+		if (NULL == (p_receivedBuffer = allocateSlabBuffer(wireLength + 1))) return STATUS_CODE_FAILURE;
+		memcpy(p_receivedBuffer, p_sentMessage->p_messageBuffer, wireLength);
+		if (NULL == (p_message = translateReceivedMessageToMessageStruct(p_receivedBuffer))) return STATUS_CODE_FAILURE;
+		p_context->sink += p_message->messageType;
+		freeTheMessage(p_message);
+	}
+
+	*p_bytesProcessed = iterations * wireLength;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkTranslatePlayerMove(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	messageString* p_sentMessage = p_context->p_playerMoveMessage;
+	int wireLength = p_context->playerMoveWireLength;
+	message* p_message = NULL;
+	char* p_receivedBuffer = NULL;
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++) {
+		if (NULL == (p_receivedBuffer = allocateSlabBuffer(wireLength + 1))) return STATUS_CODE_FAILURE;
+		memcpy(p_receivedBuffer, p_sentMessage->p_messageBuffer, wireLength);
+		if (NULL == (p_message = translateReceivedMessageToMessageStruct(p_receivedBuffer))) return STATUS_CODE_FAILURE;
+		p_context->sink += p_message->messageType;
+		freeTheMessage(p_message);
+	}
+
+	*p_bytesProcessed = iterations * wireLength;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkConstructGameResults(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	messageString* p_messageString = NULL;
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++) {
+		if (NULL == (p_messageString = constructMessageForSendingServer(SERVER_GAME_RESULTS_NUM, BENCHMARK_BULLS, BENCHMARK_COWS, BENCHMARK_PLAYER_NAME, BENCHMARK_GUESS)))
+			return STATUS_CODE_FAILURE;
+		p_context->sink += p_messageString->messageLength;
+		freeTheString(p_messageString);
+	}
+
+	*p_bytesProcessed = iterations * p_context->gameResultsWireLength;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkConstructPlayerMove(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	messageString* p_messageString = NULL;
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++) {
+		if (NULL == (p_messageString = constructMessageForSendingClient(CLIENT_PLAYER_MOVE_NUM, BENCHMARK_GUESS, NULL))) return STATUS_CODE_FAILURE;
+		p_context->sink += p_messageString->messageLength;
+		freeTheString(p_messageString);
+	}
+
+	*p_bytesProcessed = iterations * p_context->playerMoveWireLength;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkConcatenateString(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++)
+		p_context->sink += concatenateStringToStringThatMayContainNullCharacters(p_context->destinationString, p_context->sourceString, 0, BENCHMARK_STRING_LEN);
+
+	*p_bytesProcessed = iterations * BENCHMARK_STRING_LEN;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkFetchStringLength(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++)
+		p_context->sink += fetchStringLength(p_context->sourceString);
+
+	*p_bytesProcessed = iterations * BENCHMARK_STRING_LEN;
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL benchmarkLoopbackRoundTrip(benchmarkContext* p_context, LONGLONG iterations, LONGLONG* p_bytesProcessed)
+{
+	char* p_receivedBuffer = NULL;
+	LONGLONG i = 0;
+
+	for (i = 0; i < iterations; i++) {
+		if (TRANSFER_SUCCEEDED != sendString(p_context->p_gameResultsMessage->p_messageBuffer, p_context->s_sendingSocket)) return STATUS_CODE_FAILURE;
+		p_receivedBuffer = NULL;
+		if (TRANSFER_SUCCEEDED != receiveString(&p_receivedBuffer, p_context->s_receivingSocket)) return STATUS_CODE_FAILURE;
+		p_context->sink += *p_receivedBuffer;
+		freeSlabObject(p_receivedBuffer);
+	}
+
+	//Length prefix & message, as counted by the metrics registry
+	*p_bytesProcessed = iterations * (LONGLONG)(sizeof(int) + p_context->gameResultsWireLength);
+	return STATUS_CODE_SUCCESS;
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
+
+
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Suite
+static BOOL fetchSuiteOptions(int argc, char* argv[], BOOL* p_isJsonOutput, char** p_p_baselinePath)
+{
+	int a = 0;
+
+	for (a = 1; a < argc; a++) {
+		if (STRINGS_ARE_EQUAL(argv[a], JSON_OUTPUT_OPTION, sizeof(JSON_OUTPUT_OPTION))) *p_isJsonOutput = TRUE;
+		else if (STRINGS_ARE_EQUAL(argv[a], BASELINE_OPTION, sizeof(BASELINE_OPTION)) && (a + 1 < argc)) *p_p_baselinePath = argv[++a];
+		else return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL prepareBenchmarkContext(benchmarkContext* p_context)
+{
+	int pair = 0, d = 0, swapIndex = 0, i = 0, candidate = 0;
+	char digits[] = "0123456789", hexSymbols[] = "0123456789abcdef", temp = 0;
+
+	//Scoring pairs - random numbers of 4 distinct digits (as the Clients validate them)
+	srand(BENCHMARK_RANDOM_SEED);
+	for (pair = 0; pair < BENCHMARK_NUM_OF_SCORING_PAIRS; pair++) {
+		for (d = 0; d < PLAYER_NUMBER_LEN; d++) {
+			swapIndex = d + rand() % (10 - d);
+			temp = digits[d]; digits[d] = digits[swapIndex]; digits[swapIndex] = temp;
+		}
+		memcpy(p_context->initialNumbers[pair], digits, PLAYER_NUMBER_LEN);
+		for (d = 0; d < PLAYER_NUMBER_LEN; d++) {
+			swapIndex = d + rand() % (10 - d);
+			temp = digits[d]; digits[d] = digits[swapIndex]; digits[swapIndex] = temp;
+		}
+		memcpy(p_context->guesses[pair], digits, PLAYER_NUMBER_LEN);
+		memcpy(p_context->classicInitialNumbers[pair], p_context->initialNumbers[pair], PLAYER_NUMBER_LEN);
+		memcpy(p_context->classicGuesses[pair], p_context->guesses[pair], PLAYER_NUMBER_LEN);
+	}
+
+	//Variant pairs - the classic pairs above, & random numbers of 6 distinct hexadecimal symbols (scored by the 6x16 & the generic kernels)
+	setClassicGameVariant(&p_context->classicVariant);
+	if ((STATUS_CODE_FAILURE == setGameVariant(BENCHMARK_HEX_NUMBER_LEN, BENCHMARK_HEX_ALPHABET_SIZE, FALSE, &p_context->hexVariant)) ||
+		(STATUS_CODE_FAILURE == setGameVariant(BENCHMARK_HEX_NUMBER_LEN, BENCHMARK_HEX_ALPHABET_SIZE, TRUE, &p_context->hexRepeatsVariant))) {
+		printf("Error: Failed to set the microbenchmark game variants.\n");
+		return STATUS_CODE_FAILURE;
+	}
+	for (pair = 0; pair < BENCHMARK_NUM_OF_SCORING_PAIRS; pair++) {
+		for (d = 0; d < BENCHMARK_HEX_NUMBER_LEN; d++) {
+			swapIndex = d + rand() % (BENCHMARK_HEX_ALPHABET_SIZE - d);
+			temp = hexSymbols[d]; hexSymbols[d] = hexSymbols[swapIndex]; hexSymbols[swapIndex] = temp;
+		}
+		memcpy(p_context->hexInitialNumbers[pair], hexSymbols, BENCHMARK_HEX_NUMBER_LEN);
+		for (d = 0; d < BENCHMARK_HEX_NUMBER_LEN; d++) {
+			swapIndex = d + rand() % (BENCHMARK_HEX_ALPHABET_SIZE - d);
+			temp = hexSymbols[d]; hexSymbols[d] = hexSymbols[swapIndex]; hexSymbols[swapIndex] = temp;
+		}
+		memcpy(p_context->hexGuesses[pair], hexSymbols, BENCHMARK_HEX_NUMBER_LEN);
+	}
+
+	//Candidates filtering - every classic number, and the result of each classic pair
+	initializeCandidateSets();
+	for (candidate = 0; candidate < NUM_OF_PLAYER_NUMBERS; candidate++)
+		memcpy(p_context->candidateNumbers[candidate], fetchCandidateNumber((SHORT)candidate), PLAYER_NUMBER_LEN + 1);
+	for (pair = 0; pair < BENCHMARK_NUM_OF_SCORING_PAIRS; pair++)
+		p_context->classicVariant.p_scoreGuess(p_context->classicInitialNumbers[pair], p_context->classicGuesses[pair], p_context->filterBulls + pair, p_context->filterCows + pair);
+
+	for (i = 0; i < BENCHMARK_STRING_LEN; i++) p_context->sourceString[i] = (char)('a' + (i % 26));
+
+	//The messages as they are sent - their buffers are the inputs of the translation & round trip cases
+	if ((NULL == (p_context->p_gameResultsMessage = constructMessageForSendingServer(SERVER_GAME_RESULTS_NUM, BENCHMARK_BULLS, BENCHMARK_COWS, BENCHMARK_PLAYER_NAME, BENCHMARK_GUESS))) ||
+		(NULL == (p_context->p_playerMoveMessage = constructMessageForSendingClient(CLIENT_PLAYER_MOVE_NUM, BENCHMARK_GUESS, NULL)))) {
+		printf("Error: Failed to construct the microbenchmark messages.\n");
+		return STATUS_CODE_FAILURE;
+	}
+	p_context->gameResultsWireLength = fetchMessageWireLength(p_context->p_gameResultsMessage);
+	p_context->playerMoveWireLength = fetchMessageWireLength(p_context->p_playerMoveMessage);
+
+	return createLoopbackConnection(&p_context->s_sendingSocket, &p_context->s_receivingSocket);
+}
+
+static int fetchMessageWireLength(const messageString* p_messageString)
+{
+	int wireLength = 0;
+
+	while ('\n' != p_messageString->p_messageBuffer[wireLength]) wireLength++;
+	return wireLength + 1;
+}
+
+static void releaseBenchmarkContext(benchmarkContext* p_context)
+{
+	if (NULL != p_context->p_gameResultsMessage) freeTheString(p_context->p_gameResultsMessage);
+	if (NULL != p_context->p_playerMoveMessage) freeTheString(p_context->p_playerMoveMessage);
+	if (INVALID_SOCKET != p_context->s_sendingSocket) closesocket(p_context->s_sendingSocket);
+	if (INVALID_SOCKET != p_context->s_receivingSocket) closesocket(p_context->s_receivingSocket);
+	p_context->p_gameResultsMessage = p_context->p_playerMoveMessage = NULL;
+	p_context->s_sendingSocket = p_context->s_receivingSocket = INVALID_SOCKET;
+}
+
+static BOOL createLoopbackConnection(SOCKET* p_s_sendingSocket, SOCKET* p_s_receivingSocket)
+{
+	SOCKET s_listeningSocket = INVALID_SOCKET;
+	SOCKADDR_IN service;
+	int serviceLength = sizeof(service);
+	BOOL connectionSucceeded = FALSE;
+
+	//Port 0 - the system picks a free port, read back with getsockname(.). The sockets keep the default options, as the Server's & Client's do
+	memset(&service, 0, sizeof(service));
+	service.sin_family = AF_INET;
+	service.sin_port = 0;
+	if ((INETPTONS_SUCCESS == InetPton(AF_INET, SERVER_ADDRESS_STR, &service.sin_addr.s_addr)) &&
+		(INVALID_SOCKET != (s_listeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) &&
+		(SOCKET_ERROR != bind(s_listeningSocket, (SOCKADDR*)&service, sizeof(service))) &&
+		(SOCKET_ERROR != listen(s_listeningSocket, 1)) &&
+		(SOCKET_ERROR != getsockname(s_listeningSocket, (SOCKADDR*)&service, &serviceLength)) &&
+		(INVALID_SOCKET != (*p_s_sendingSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) &&
+		(SOCKET_ERROR != connect(*p_s_sendingSocket, (SOCKADDR*)&service, sizeof(service))) &&
+		(INVALID_SOCKET != (*p_s_receivingSocket = accept(s_listeningSocket, NULL, NULL))))
+		connectionSucceeded = TRUE;
+	else
+		printf("Error: Failed to create the microbenchmark loopback connection, with error code no. %ld.\n", WSAGetLastError());
+
+	if (INVALID_SOCKET != s_listeningSocket) closesocket(s_listeningSocket);
+	return connectionSucceeded;
+}
+
+static BOOL runBenchmarkCase(const benchmarkCase* p_case, benchmarkContext* p_context, benchmarkResult* p_result)
+{
+	LARGE_INTEGER frequency, startTicks, endTicks;
+	LONGLONG iterations = 1, bytesProcessed = 0, allocationsBefore = 0, allocationsAfter = 0;
+	double elapsedSeconds = 0, growth = 0;
+
+	QueryPerformanceFrequency(&frequency);
+	while (TRUE) {
+		allocationsBefore = fetchTotalAllocations();
+		QueryPerformanceCounter(&startTicks);
+		if (STATUS_CODE_FAILURE == p_case->p_routine(p_context, iterations, &bytesProcessed)) return STATUS_CODE_FAILURE;
+		QueryPerformanceCounter(&endTicks);
+		allocationsAfter = fetchTotalAllocations();
+
+		elapsedSeconds = (double)(endTicks.QuadPart - startTicks.QuadPart) / (double)frequency.QuadPart;
+		if ((BENCHMARK_MIN_RUN_SEC <= elapsedSeconds) || (BENCHMARK_MAX_ITERATIONS <= iterations)) break;
+
+		//Predict the iterations of a long enough run. Runs too short to predict from grow by the maximal factor
+		growth = ((BENCHMARK_MIN_RUN_SEC / BENCHMARK_MAX_GROWTH) < elapsedSeconds) ? (BENCHMARK_MIN_RUN_SEC * BENCHMARK_GROWTH_MARGIN / elapsedSeconds) : BENCHMARK_MAX_GROWTH;
+		if (BENCHMARK_MAX_GROWTH < growth) growth = BENCHMARK_MAX_GROWTH;
+		iterations = ((LONGLONG)(iterations * growth) > iterations) ? (LONGLONG)(iterations * growth) : iterations + 1;
+		if (BENCHMARK_MAX_ITERATIONS < iterations) iterations = BENCHMARK_MAX_ITERATIONS;
+	}
+
+	p_result->iterations = iterations;
+	p_result->nanosecondsPerOperation = (elapsedSeconds * NANOSECONDS_IN_SECOND) / (double)iterations;
+	p_result->allocationsPerOperation = (double)(allocationsAfter - allocationsBefore) / (double)iterations;
+	p_result->operationsPerSecond = (0 < elapsedSeconds) ? ((double)iterations / elapsedSeconds) : 0;
+	p_result->bytesPerSecond = (0 < elapsedSeconds) ? ((double)bytesProcessed / elapsedSeconds) : 0;
+	return STATUS_CODE_SUCCESS;
+}
+
+static LONGLONG fetchTotalAllocations()
+{
+	slabStatistics statistics;
+	LONGLONG totalAllocations = 0;
+	int type = 0;
+
+	fetchSlabAllocatorStatistics(&statistics);
+	for (type = 0; type < NUM_OF_SLAB_OBJECT_TYPES; type++) totalAllocations += statistics.allocations[type];
+	return totalAllocations + statistics.heapBufferAllocations;
+}
+
+static char* loadBaselineFile(const char* p_baselinePath)
+{
+	HANDLE h_baselineFile = NULL;
+	DWORD fileSize = 0, bytesRead = 0;
+	char* p_baseline = NULL;
+
+	if (INVALID_HANDLE_VALUE == (h_baselineFile = CreateFile(p_baselinePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		printf("Error: Failed to open the baseline file %s, with error code no. %ld.\n", p_baselinePath, GetLastError());
+		return NULL;
+	}
+
+	if ((INVALID_FILE_SIZE == (fileSize = GetFileSize(h_baselineFile, NULL))) ||
+		(NULL == (p_baseline = (char*)calloc(fileSize + 1, sizeof(char)))) ||
+		(FALSE == ReadFile(h_baselineFile, p_baseline, fileSize, &bytesRead, NULL)) || (bytesRead != fileSize)) {
+		printf("Error: Failed to read the baseline file %s, with error code no. %ld.\n", p_baselinePath, GetLastError());
+		free(p_baseline);
+		p_baseline = NULL;
+	}
+
+	CloseHandle(h_baselineFile);
+	return p_baseline;
+}
+
+static double fetchBaselineNanosecondsPerOperation(const char* p_baseline, const char* p_caseName)
+{
+	char nameField[LOG_FORMATTED_EVENT_LEN] = { 0 };
+	const char* p_field = NULL;
+
+	//Every case is a JSON object whose "name" comes first & whose "real_time" comes before the next case's "name"
+	_snprintf_s(nameField, sizeof(nameField), _TRUNCATE, "\"name\": \"%s\"", p_caseName);
+	if (NULL == (p_field = strstr(p_baseline, nameField))) return 0;
+	if (NULL == (p_field = strstr(p_field, "\"real_time\": "))) return 0;
+
+	return strtod(p_field + sizeof("\"real_time\": ") - 1, NULL);
+}
+
+static void printResultsTable(const benchmarkResult* p_results, int numOfResults)
+{
+	int c = 0;
+
+	printf("%-64s %14s %12s %10s %14s %14s %10s\n", "Benchmark", "Time(ns/op)", "Iterations", "Allocs/op", "Items/s", "Bytes/s", "vs base");
+	for (c = 0; c < numOfResults; c++) {
+		printf("%-64s %14.2f %12lld %10.2f %14.0f %14.0f", BENCHMARK_CASES[c].p_name, p_results[c].nanosecondsPerOperation, p_results[c].iterations,
+			p_results[c].allocationsPerOperation, p_results[c].operationsPerSecond, p_results[c].bytesPerSecond);
+		if (0 < p_results[c].baselineNanosecondsPerOperation)
+			printf(" %+9.1f%%\n", (p_results[c].nanosecondsPerOperation / p_results[c].baselineNanosecondsPerOperation - 1.0) * PERCENT);
+		else
+			printf(" %10s\n", "-");
+	}
+}
+
+static void printResultsJson(const benchmarkResult* p_results, int numOfResults)
+{
+	SYSTEMTIME localTime;
+	SYSTEM_INFO systemInfo;
+	int c = 0;
+
+	GetLocalTime(&localTime);
+	GetSystemInfo(&systemInfo);
+
+	printf("{\n  \"context\": {\n");
+	printf("    \"date\": \"%04d-%02d-%02dT%02d:%02d:%02d\",\n", localTime.wYear, localTime.wMonth, localTime.wDay, localTime.wHour, localTime.wMinute, localTime.wSecond);
+	printf("    \"num_cpus\": %lu,\n", systemInfo.dwNumberOfProcessors);
+#ifdef _DEBUG
+	printf("    \"library_build_type\": \"debug\"\n");
+#else
+	printf("    \"library_build_type\": \"release\"\n");
+#endif
+	printf("  },\n  \"benchmarks\": [\n");
+	for (c = 0; c < numOfResults; c++) {
+		printf("    {\n      \"name\": \"%s\",\n      \"iterations\": %lld,\n      \"real_time\": %.3f,\n      \"time_unit\": \"ns\",\n",
+			BENCHMARK_CASES[c].p_name, p_results[c].iterations, p_results[c].nanosecondsPerOperation);
+		printf("      \"allocs_per_op\": %.3f,\n      \"items_per_second\": %.1f,\n      \"bytes_per_second\": %.1f",
+			p_results[c].allocationsPerOperation, p_results[c].operationsPerSecond, p_results[c].bytesPerSecond);
+		if (0 < p_results[c].baselineNanosecondsPerOperation)
+			printf(",\n      \"baseline_real_time\": %.3f,\n      \"change_percent\": %.2f",
+				p_results[c].baselineNanosecondsPerOperation, (p_results[c].nanosecondsPerOperation / p_results[c].baselineNanosecondsPerOperation - 1.0) * PERCENT);
+		printf("\n    }%s\n", (c + 1 < numOfResults) ? "," : "");
+	}
+	printf("  ]\n}\n");
+}
+
+#endif //MICROBENCHMARK_SUITE
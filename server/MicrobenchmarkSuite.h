@@ -0,0 +1,37 @@
+/* MicrobenchmarkSuite.h
+--------------------------------------------------------------------
+	Module Description - header module for MicrobenchmarkSuite.c
+--------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __MICROBENCHMARK_SUITE_H__
+#define __MICROBENCHMARK_SUITE_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef MICROBENCHMARK_SUITE
+/// <summary>
+/// Description - This function runs every microbenchmark case (scoring, message parsing & construction, string utilities & a loopback
+/// sendString(.)\receiveString(.) round trip) and prints ns/op, allocations/op & throughput per case, as a table or as JSON.
+/// Built ONLY when MICROBENCHMARK_SUITE is defined - the Server then runs it instead of serving Clients:
+///		server.exe [--json] [--baseline <a previous --json output>]
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL runMicrobenchmarkSuite(int argc, char* argv[]);
+#endif //MICROBENCHMARK_SUITE
+
+
+#endif //__MICROBENCHMARK_SUITE_H__
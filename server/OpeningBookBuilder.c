@@ -0,0 +1,522 @@
+/* OpeningBookBuilder.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the opening book builder, built
+		ONLY when OPENING_BOOK_BUILDER is defined. It builds the solver's
+		decision tree of the classic variant offline: at every node, of every
+		number, the guess whose largest group of candidates sharing a result
+		is the smallest (fewer groups lose a tie, a candidate wins it). All
+		first guesses are alike, so the root guesses the first number, and
+		the subtrees of its results are built by a thread per processor, each
+		claiming the next subtree with an interlocked increment. Every pair of
+		numbers is scored once into a table of score codes, with the classic
+		variant's kernel. The subtrees are then laid out after the root as the
+		book file (OpeningBookTools.c), which is mapped back & played against
+		every number, so the written file itself is verified.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef OPENING_BOOK_BUILDER
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "OpeningBookBuilder.h"
+#include "OpeningBookTools.h"
+#include "GameVariantTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int NUM_OF_DIGITS = 10;
+static const SHORT FIRST_GUESS = 0;
+static const double MILLISECONDS_IN_SECOND = 1000.0;
+
+//Command line options
+static const char THREADS_OPTION[] = "--threads";
+static const char OUTPUT_OPTION[] = "--output";
+
+
+// Global variables ------------------------------------------------------------
+//The numbers of 4 distinct digits & the score code of every (secret, guess) pair - read only once the threads start
+static char (*g_p_candidateNumbers)[PLAYER_NUMBER_LEN + 1] = NULL;
+static BYTE* g_p_scoreCodes = NULL;
+static gameVariant g_classicVariant;
+//The candidates of every depth - row d holds the candidates of the nodes of depth d, grouped by result in row d + 1. Every node owns a range of
+// its row, so the builder threads never share a range
+static SHORT (*g_p_candidatesByDepth)[NUM_OF_PLAYER_NUMBERS] = NULL;
+//The first guess's subtrees & the next one to claim
+static openingBookSubtree* g_p_openingBookSubtrees = NULL;
+static int g_numOfOpeningBookSubtrees = 0;
+static volatile LONG g_nextOpeningBookSubtree = -1;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function parses the builder's command line options (--threads <n>, --output <path>). Missing options keep their defaults
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <param name="int* p_numOfThreads - pointer to the # of threads"></param>
+/// <param name="const char** p_p_bookPath - pointer to the book's path"></param>
+/// <returns>True if every option is known & its value is valid. False otherwise</returns>
+static BOOL fetchBuilderOptions(int argc, char* argv[], int* p_numOfThreads, const char** p_p_bookPath);
+
+/// <summary>
+/// Description - This function fills the numbers of 4 distinct digits & scores every pair of them into the score codes table
+/// </summary>
+static void fillCandidatesAndScoreCodes();
+
+/// <summary>
+/// Description - This function groups the candidates of a node by the result the node's guess gets from each of them. The groups are written,
+/// ordered by score code, to the same range of the next depth's row
+/// </summary>
+/// <param name="int depth - the node's depth (its candidates are a range of row depth)"></param>
+/// <param name="int firstCandidate - the range's start"></param>
+/// <param name="int numOfCandidates - the range's length"></param>
+/// <param name="SHORT guess - index of the node's guess"></param>
+/// <param name="int* p_groupSizes - array of NUM_OF_SCORE_CODES group sizes"></param>
+static void groupOpeningBookCandidates(int depth, int firstCandidate, int numOfCandidates, SHORT guess, int* p_groupSizes);
+
+/// <summary>
+/// Description - This function chooses a node's guess among all the numbers - the one whose largest group is the smallest, then the one of more
+/// groups, then a candidate (it may win at once). A node of at most 2 candidates guesses its first one
+/// </summary>
+/// <param name="int depth - the node's depth"></param>
+/// <param name="int firstCandidate - the range's start"></param>
+/// <param name="int numOfCandidates - the range's length"></param>
+/// <returns>index of the chosen guess</returns>
+static SHORT chooseOpeningBookGuess(int depth, int firstCandidate, int numOfCandidates);
+
+/// <summary>
+/// Description - Builder thread routine. Claims the next subtree and builds it, until no subtree is left
+/// </summary>
+/// <param name="LPVOID lpParam - not used"></param>
+/// <returns>0</returns>
+static DWORD WINAPI openingBookBuilderThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function builds a node of a subtree and, recursively, the nodes under it. The children of the node are appended together,
+/// so they are contiguous
+/// </summary>
+/// <param name="openingBookSubtree* p_subtree - the subtree"></param>
+/// <param name="LONG node - the node's index in the subtree"></param>
+/// <param name="int depth - the node's depth (the root of the book is of depth 0)"></param>
+/// <param name="int firstCandidate - start of the node's candidates range"></param>
+/// <param name="int numOfCandidates - # of the node's candidates"></param>
+/// <returns>True if succeeded. False otherwise (allocation failure, or a path longer than OPENING_BOOK_MAX_DEPTH)</returns>
+static BOOL buildOpeningBookNode(openingBookSubtree* p_subtree, LONG node, int depth, int firstCandidate, int numOfCandidates);
+
+/// <summary>
+/// Description - This function appends nodes to a subtree, doubling its capacity when it is full
+/// </summary>
+/// <param name="openingBookSubtree* p_subtree - the subtree"></param>
+/// <param name="LONG numOfNodes - # of nodes to append"></param>
+/// <returns>index of the first appended node, or OPENING_BOOK_NO_NODE if the allocation failed</returns>
+static LONG appendOpeningBookNodes(openingBookSubtree* p_subtree, LONG numOfNodes);
+
+/// <summary>
+/// Description - This function lays the root & the subtrees out as the book's nodes - the root, its children (the subtrees roots), then the rest
+/// of every subtree in turn - and writes them after the header
+/// </summary>
+/// <param name="const char* p_bookPath - the book's path"></param>
+/// <param name="LONG* p_numOfNodes - pointer to the # of written nodes"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL writeOpeningBook(const char* p_bookPath, LONG* p_numOfNodes);
+
+/// <summary>
+/// Description - This function maps the written book & plays it against every number, counting the guesses each takes
+/// </summary>
+/// <param name="const char* p_bookPath - the book's path"></param>
+/// <param name="LONG* p_guessesHistogram - array of OPENING_BOOK_MAX_DEPTH + 1 counts, by # of guesses"></param>
+/// <returns>True if the book guessed every number. False otherwise</returns>
+static BOOL verifyOpeningBook(const char* p_bookPath, LONG* p_guessesHistogram);
+
+/// <summary>
+/// Description - This function frees the subtrees & the tables
+/// </summary>
+static void freeOpeningBookBuilder();
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runOpeningBookBuilder(int argc, char* argv[])
+{
+	SYSTEM_INFO systemInfo;
+	HANDLE h_threads[OPENING_BOOK_BUILDER_MAX_THREADS] = { NULL };
+	int groupSizes[NUM_OF_SCORE_CODES];
+	LONG guessesHistogram[OPENING_BOOK_MAX_DEPTH + 1] = { 0 };
+	LARGE_INTEGER startTicks, endTicks, ticksPerSecond;
+	const char* p_bookPath = OPENING_BOOK_PATH;
+	LONG numOfNodes = 0, maxDepth = 0, sumOfGuesses = 0;
+	int numOfThreads = 0, numOfStartedThreads = 0, t = 0, code = 0, firstCandidate = 0, s = 0, guesses = 0;
+	BOOL isSucceeded = FALSE;
+
+	GetSystemInfo(&systemInfo);
+	numOfThreads = (OPENING_BOOK_BUILDER_MAX_THREADS < (int)systemInfo.dwNumberOfProcessors) ? OPENING_BOOK_BUILDER_MAX_THREADS : (int)systemInfo.dwNumberOfProcessors;
+	if (STATUS_CODE_FAILURE == fetchBuilderOptions(argc, argv, &numOfThreads, &p_bookPath)) {
+		printf("Usage: %s [%s <threads>] [%s <path>]\n", argv[0], THREADS_OPTION, OUTPUT_OPTION);
+		return STATUS_CODE_FAILURE;
+	}
+	setClassicGameVariant(&g_classicVariant);
+
+	//Numbers, score codes, the candidates of every depth & a subtree per result of the first guess
+	g_p_candidateNumbers = (char (*)[PLAYER_NUMBER_LEN + 1])calloc(sizeof(*g_p_candidateNumbers), NUM_OF_PLAYER_NUMBERS);
+	g_p_scoreCodes = (BYTE*)malloc((size_t)NUM_OF_PLAYER_NUMBERS * NUM_OF_PLAYER_NUMBERS);
+	g_p_candidatesByDepth = (SHORT (*)[NUM_OF_PLAYER_NUMBERS])calloc(sizeof(*g_p_candidatesByDepth), OPENING_BOOK_MAX_DEPTH + 1);
+	g_p_openingBookSubtrees = (openingBookSubtree*)calloc(sizeof(openingBookSubtree), NUM_OF_SCORE_CODES);
+	if ((NULL == g_p_candidateNumbers) || (NULL == g_p_scoreCodes) || (NULL == g_p_candidatesByDepth) || (NULL == g_p_openingBookSubtrees)) {
+		printf("Error: Failed to allocate memory for the score codes table & the candidates.\n");
+		freeOpeningBookBuilder();
+		return STATUS_CODE_FAILURE;
+	}
+	fillCandidatesAndScoreCodes();
+
+	printf("Building the opening book (%d threads)\n", numOfThreads);
+	QueryPerformanceFrequency(&ticksPerSecond);
+	QueryPerformanceCounter(&startTicks);
+
+	//The root - every number is a candidate of the first guess, and every result but a win is a subtree
+	for (s = 0; s < NUM_OF_PLAYER_NUMBERS; s++) g_p_candidatesByDepth[0][s] = (SHORT)s;
+	groupOpeningBookCandidates(0, 0, NUM_OF_PLAYER_NUMBERS, FIRST_GUESS, groupSizes);
+	g_numOfOpeningBookSubtrees = 0;
+	for (code = 0, firstCandidate = 0; code < NUM_OF_SCORE_CODES; firstCandidate += groupSizes[code], code++) {
+		if ((0 == groupSizes[code]) || (SCORE_CODE(PLAYER_NUMBER_LEN, 0) == code)) continue;
+		g_p_openingBookSubtrees[g_numOfOpeningBookSubtrees].scoreCode = (BYTE)code;
+		g_p_openingBookSubtrees[g_numOfOpeningBookSubtrees].firstCandidate = firstCandidate;
+		g_p_openingBookSubtrees[g_numOfOpeningBookSubtrees].numOfCandidates = groupSizes[code];
+		g_numOfOpeningBookSubtrees++;
+	}
+
+	//Build the subtrees in parallel
+	g_nextOpeningBookSubtree = -1;
+	for (numOfStartedThreads = 0; numOfStartedThreads < numOfThreads; numOfStartedThreads++)
+		if (NULL == (h_threads[numOfStartedThreads] = CreateThread(NULL, 0, openingBookBuilderThreadRoutine, NULL, 0, NULL))) {
+			printf("Error: Failed to create a builder thread, with error code no. %ld.\n", GetLastError());
+			break;
+		}
+	if ((0 < numOfStartedThreads) && (WAIT_FAILED == WaitForMultipleObjects((DWORD)numOfStartedThreads, h_threads, TRUE, INFINITE)))
+		printf("Error: Failed to wait for the builder threads, with error code no. %ld.\n", GetLastError());
+	QueryPerformanceCounter(&endTicks);
+	for (t = 0; t < numOfStartedThreads; t++) CloseHandle(h_threads[t]);
+
+	//Every subtree must be built - then write the book & verify it
+	isSucceeded = (numOfThreads == numOfStartedThreads);
+	for (s = 0; s < g_numOfOpeningBookSubtrees; s++) {
+		isSucceeded = isSucceeded && (FALSE == g_p_openingBookSubtrees[s].isFailed) && (0 < g_p_openingBookSubtrees[s].numOfNodes);
+		if (maxDepth < g_p_openingBookSubtrees[s].maxDepth) maxDepth = g_p_openingBookSubtrees[s].maxDepth;
+	}
+	if (FALSE == isSucceeded) printf("Error: Failed to build the opening book (a path longer than %d guesses, or no memory).\n", OPENING_BOOK_MAX_DEPTH);
+	else if (STATUS_CODE_FAILURE == (isSucceeded = writeOpeningBook(p_bookPath, &numOfNodes)))
+		printf("Error: Failed to write the opening book to %s, with error code no. %ld.\n", p_bookPath, GetLastError());
+	else if (STATUS_CODE_FAILURE == (isSucceeded = verifyOpeningBook(p_bookPath, guessesHistogram)))
+		printf("Error: The opening book written to %s does not guess every number.\n", p_bookPath);
+	else {
+		printf("Built in %.3f ms - %ld nodes (%ld bytes), written to %s\n",
+			(double)(endTicks.QuadPart - startTicks.QuadPart) * MILLISECONDS_IN_SECOND / (double)ticksPerSecond.QuadPart,
+			numOfNodes, (LONG)(sizeof(openingBookHeader) + sizeof(openingBookNode) * numOfNodes), p_bookPath);
+		for (guesses = 1; guesses <= OPENING_BOOK_MAX_DEPTH; guesses++) sumOfGuesses += guesses * guessesHistogram[guesses];
+		printf("Every number is guessed within %ld guesses, %.4f on average\n", maxDepth, (double)sumOfGuesses / NUM_OF_PLAYER_NUMBERS);
+		for (guesses = 1; guesses <= OPENING_BOOK_MAX_DEPTH; guesses++)
+			if (0 < guessesHistogram[guesses]) printf("  %2d guesses %6ld\n", guesses, guessesHistogram[guesses]);
+	}
+
+	freeOpeningBookBuilder();
+	return isSucceeded;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL fetchBuilderOptions(int argc, char* argv[], int* p_numOfThreads, const char** p_p_bookPath)
+{
+	int a = 0;
+	long value = 0;
+
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) return STATUS_CODE_FAILURE; //Every option takes a value
+
+		if (STRINGS_ARE_EQUAL(argv[a], OUTPUT_OPTION, sizeof(OUTPUT_OPTION))) *p_p_bookPath = argv[a + 1];
+		else if (STRINGS_ARE_EQUAL(argv[a], THREADS_OPTION, sizeof(THREADS_OPTION))) {
+			value = strtol(argv[a + 1], NULL, 10);
+			if ((0 >= value) || (OPENING_BOOK_BUILDER_MAX_THREADS < value)) return STATUS_CODE_FAILURE;
+			*p_numOfThreads = (int)value;
+		}
+		else return STATUS_CODE_FAILURE;
+		a++;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static void fillCandidatesAndScoreCodes()
+{
+	int numOfCandidates = 0, first = 0, second = 0, third = 0, fourth = 0, secret = 0, guess = 0;
+	SHORT bulls = 0, cows = 0;
+
+	for (first = 0; first < NUM_OF_DIGITS; first++)
+		for (second = 0; second < NUM_OF_DIGITS; second++) {
+			if (second == first) continue;
+			for (third = 0; third < NUM_OF_DIGITS; third++) {
+				if ((third == first) || (third == second)) continue;
+				for (fourth = 0; fourth < NUM_OF_DIGITS; fourth++) {
+					if ((fourth == first) || (fourth == second) || (fourth == third)) continue;
+					g_p_candidateNumbers[numOfCandidates][0] = (char)('0' + first);
+					g_p_candidateNumbers[numOfCandidates][1] = (char)('0' + second);
+					g_p_candidateNumbers[numOfCandidates][2] = (char)('0' + third);
+					g_p_candidateNumbers[numOfCandidates][3] = (char)('0' + fourth);
+					g_p_candidateNumbers[numOfCandidates][PLAYER_NUMBER_LEN] = '\0';
+					numOfCandidates++;
+				}
+			}
+		}
+	assert(NUM_OF_PLAYER_NUMBERS == numOfCandidates);
+
+	//Every pair is scored once, by the same kernel the Worker threads score a round with
+	for (secret = 0; secret < NUM_OF_PLAYER_NUMBERS; secret++)
+		for (guess = 0; guess < NUM_OF_PLAYER_NUMBERS; guess++) {
+			g_classicVariant.p_scoreGuess(g_p_candidateNumbers[secret], g_p_candidateNumbers[guess], &bulls, &cows);
+			g_p_scoreCodes[(size_t)secret * NUM_OF_PLAYER_NUMBERS + guess] = SCORE_CODE(bulls, cows);
+		}
+}
+
+static void groupOpeningBookCandidates(int depth, int firstCandidate, int numOfCandidates, SHORT guess, int* p_groupSizes)
+{
+	int groupStarts[NUM_OF_SCORE_CODES];
+	const SHORT* p_candidates = g_p_candidatesByDepth[depth] + firstCandidate;
+	SHORT* p_groups = g_p_candidatesByDepth[depth + 1] + firstCandidate;
+	const BYTE* p_guessScoreCodes = g_p_scoreCodes + (size_t)guess * NUM_OF_PLAYER_NUMBERS;
+	int c = 0, code = 0, start = 0;
+	//Assert
+	assert(OPENING_BOOK_MAX_DEPTH > depth);
+
+	//Count, then place every candidate in its group (the table is symmetric - a pair scores the same both ways)
+	memset(p_groupSizes, 0, sizeof(int) * NUM_OF_SCORE_CODES);
+	for (c = 0; c < numOfCandidates; c++) p_groupSizes[p_guessScoreCodes[p_candidates[c]]]++;
+	for (code = 0, start = 0; code < NUM_OF_SCORE_CODES; start += p_groupSizes[code], code++) groupStarts[code] = start;
+	for (c = 0; c < numOfCandidates; c++) p_groups[groupStarts[p_guessScoreCodes[p_candidates[c]]]++] = p_candidates[c];
+}
+
+static SHORT chooseOpeningBookGuess(int depth, int firstCandidate, int numOfCandidates)
+{
+	int groupSizes[NUM_OF_SCORE_CODES];
+	const SHORT* p_candidates = g_p_candidatesByDepth[depth] + firstCandidate;
+	const BYTE* p_guessScoreCodes = NULL;
+	int c = 0, code = 0, largestGroup = 0, numOfGroups = 0, bestLargestGroup = 0, bestNumOfGroups = 0;
+	BOOL isCandidate = FALSE, isBestCandidate = FALSE;
+	SHORT guess = 0, bestGuess = 0;
+
+	if (2 >= numOfCandidates) return p_candidates[0];
+
+	bestLargestGroup = numOfCandidates + 1;
+	for (guess = 0; guess < NUM_OF_PLAYER_NUMBERS; guess++) {
+		memset(groupSizes, 0, sizeof(groupSizes));
+		p_guessScoreCodes = g_p_scoreCodes + (size_t)guess * NUM_OF_PLAYER_NUMBERS;
+		for (c = 0; c < numOfCandidates; c++) groupSizes[p_guessScoreCodes[p_candidates[c]]]++;
+		for (code = 0, largestGroup = 0, numOfGroups = 0; code < NUM_OF_SCORE_CODES; code++) {
+			if (largestGroup < groupSizes[code]) largestGroup = groupSizes[code];
+			if (0 < groupSizes[code]) numOfGroups++;
+		}
+		isCandidate = (0 < groupSizes[SCORE_CODE(PLAYER_NUMBER_LEN, 0)]);
+
+		if ((largestGroup < bestLargestGroup) ||
+			((largestGroup == bestLargestGroup) && ((numOfGroups > bestNumOfGroups) ||
+				((numOfGroups == bestNumOfGroups) && (TRUE == isCandidate) && (FALSE == isBestCandidate))))) {
+			bestLargestGroup = largestGroup;
+			bestNumOfGroups = numOfGroups;
+			isBestCandidate = isCandidate;
+			bestGuess = guess;
+		}
+	}
+	return bestGuess;
+}
+
+static DWORD WINAPI openingBookBuilderThreadRoutine(LPVOID lpParam)
+{
+	openingBookSubtree* p_subtree = NULL;
+	LONG subtree = 0;
+
+	while (g_numOfOpeningBookSubtrees > (subtree = InterlockedIncrement(&g_nextOpeningBookSubtree))) {
+		p_subtree = g_p_openingBookSubtrees + subtree;
+		p_subtree->isFailed = (OPENING_BOOK_NO_NODE == appendOpeningBookNodes(p_subtree, 1)) ||
+			(STATUS_CODE_FAILURE == buildOpeningBookNode(p_subtree, 0, 1, p_subtree->firstCandidate, p_subtree->numOfCandidates));
+	}
+	return 0;
+}
+
+static BOOL buildOpeningBookNode(openingBookSubtree* p_subtree, LONG node, int depth, int firstCandidate, int numOfCandidates)
+{
+	int groupSizes[NUM_OF_SCORE_CODES];
+	ULONG childrenMask = 0;
+	LONG firstChild = 0, child = 0;
+	int code = 0, groupStart = 0, numOfChildren = 0;
+	SHORT guess = 0;
+	//Assert
+	assert(0 < numOfCandidates);
+
+	//The node's guess is its (depth + 1)th
+	guess = chooseOpeningBookGuess(depth, firstCandidate, numOfCandidates);
+	memcpy(p_subtree->p_nodes[node].guess, g_p_candidateNumbers[guess], PLAYER_NUMBER_LEN);
+	if (p_subtree->maxDepth < depth + 1) p_subtree->maxDepth = depth + 1;
+
+	//A child for every result but a win
+	groupOpeningBookCandidates(depth, firstCandidate, numOfCandidates, guess, groupSizes);
+	for (code = 0; code < NUM_OF_SCORE_CODES; code++)
+		if ((0 < groupSizes[code]) && (SCORE_CODE(PLAYER_NUMBER_LEN, 0) != code)) {
+			childrenMask |= (1UL << code);
+			numOfChildren++;
+		}
+	p_subtree->p_nodes[node].childrenMask = childrenMask;
+	p_subtree->p_nodes[node].firstChild = OPENING_BOOK_NO_NODE;
+	if (0 == numOfChildren) return STATUS_CODE_SUCCESS;
+	if (OPENING_BOOK_MAX_DEPTH <= depth + 1) return STATUS_CODE_FAILURE;
+
+	//Append the children together (the nodes may move - only indexes are kept), then build each of them
+	if (OPENING_BOOK_NO_NODE == (firstChild = appendOpeningBookNodes(p_subtree, numOfChildren))) return STATUS_CODE_FAILURE;
+	p_subtree->p_nodes[node].firstChild = firstChild;
+	for (code = 0, groupStart = firstCandidate, child = firstChild; code < NUM_OF_SCORE_CODES; groupStart += groupSizes[code], code++) {
+		if (0 == (childrenMask & (1UL << code))) continue;
+		if (STATUS_CODE_FAILURE == buildOpeningBookNode(p_subtree, child++, depth + 1, groupStart, groupSizes[code])) return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static LONG appendOpeningBookNodes(openingBookSubtree* p_subtree, LONG numOfNodes)
+{
+	openingBookNode* p_nodes = NULL;
+	LONG capacity = 0, firstNode = 0;
+
+	if (p_subtree->numOfNodes + numOfNodes > p_subtree->capacity) {
+		capacity = (0 == p_subtree->capacity) ? OPENING_BOOK_SUBTREE_INITIAL_CAPACITY : 2 * p_subtree->capacity;
+		while (p_subtree->numOfNodes + numOfNodes > capacity) capacity *= 2;
+		if (NULL == (p_nodes = (openingBookNode*)realloc(p_subtree->p_nodes, sizeof(openingBookNode) * capacity))) return OPENING_BOOK_NO_NODE;
+		p_subtree->p_nodes = p_nodes;
+		p_subtree->capacity = capacity;
+	}
+	firstNode = p_subtree->numOfNodes;
+	p_subtree->numOfNodes += numOfNodes;
+	return firstNode;
+}
+
+static BOOL writeOpeningBook(const char* p_bookPath, LONG* p_numOfNodes)
+{
+	openingBookHeader header;
+	openingBookNode node;
+	HANDLE h_bookFile = INVALID_HANDLE_VALUE;
+	LONG* p_subtreeBases = NULL;
+	LONG base = 0, n = 0;
+	DWORD numOfWrittenBytes = 0;
+	int s = 0;
+	BOOL isSucceeded = TRUE;
+
+	//A subtree's root is a child of the root, the rest of its nodes follow the previous subtree's. A local index n > 0 becomes base + n - 1
+	if (NULL == (p_subtreeBases = (LONG*)calloc(sizeof(LONG), g_numOfOpeningBookSubtrees))) return STATUS_CODE_FAILURE;
+	for (s = 0, base = 1 + g_numOfOpeningBookSubtrees; s < g_numOfOpeningBookSubtrees; base += g_p_openingBookSubtrees[s].numOfNodes - 1, s++)
+		p_subtreeBases[s] = base;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = OPENING_BOOK_MAGIC;
+	header.numberLength = PLAYER_NUMBER_LEN;
+	header.numOfNodes = *p_numOfNodes = base;
+	for (s = 0; s < g_numOfOpeningBookSubtrees; s++)
+		if (header.maxDepth < g_p_openingBookSubtrees[s].maxDepth) header.maxDepth = g_p_openingBookSubtrees[s].maxDepth;
+
+	if (INVALID_HANDLE_VALUE == (h_bookFile = CreateFile(p_bookPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		free(p_subtreeBases);
+		return STATUS_CODE_FAILURE;
+	}
+#define WRITE_OPENING_BOOK( p_Data, Size ) ( isSucceeded = isSucceeded && WriteFile(h_bookFile, (p_Data), (DWORD)(Size), &numOfWrittenBytes, NULL) && ((DWORD)(Size) == numOfWrittenBytes) )
+	WRITE_OPENING_BOOK(&header, sizeof(header));
+
+	//The root, then the subtrees roots
+	memset(&node, 0, sizeof(node));
+	memcpy(node.guess, g_p_candidateNumbers[FIRST_GUESS], PLAYER_NUMBER_LEN);
+	node.firstChild = 1;
+	for (s = 0; s < g_numOfOpeningBookSubtrees; s++) node.childrenMask |= (1UL << g_p_openingBookSubtrees[s].scoreCode);
+	WRITE_OPENING_BOOK(&node, sizeof(node));
+	for (s = 0; s < g_numOfOpeningBookSubtrees; s++) {
+		node = g_p_openingBookSubtrees[s].p_nodes[0];
+		if (0 != node.childrenMask) node.firstChild = p_subtreeBases[s] + node.firstChild - 1;
+		WRITE_OPENING_BOOK(&node, sizeof(node));
+	}
+
+	//The rest of every subtree
+	for (s = 0; s < g_numOfOpeningBookSubtrees; s++)
+		for (n = 1; n < g_p_openingBookSubtrees[s].numOfNodes; n++) {
+			node = g_p_openingBookSubtrees[s].p_nodes[n];
+			if (0 != node.childrenMask) node.firstChild = p_subtreeBases[s] + node.firstChild - 1;
+			WRITE_OPENING_BOOK(&node, sizeof(node));
+		}
+#undef WRITE_OPENING_BOOK
+
+	CloseHandle(h_bookFile);
+	free(p_subtreeBases);
+	return isSucceeded;
+}
+
+static BOOL verifyOpeningBook(const char* p_bookPath, LONG* p_guessesHistogram)
+{
+	char guess[PLAYER_NUMBER_LEN + 1] = { 0 };
+	LONG node = OPENING_BOOK_NO_NODE;
+	SHORT bulls = 0, cows = 0;
+	int secret = 0, guesses = 0;
+	BOOL isSucceeded = TRUE;
+
+	if (STATUS_CODE_FAILURE == loadOpeningBook(p_bookPath)) return STATUS_CODE_FAILURE;
+
+	//Play the book as the bot plays it - a guess, its result, the next node
+	for (secret = 0; (secret < NUM_OF_PLAYER_NUMBERS) && (TRUE == isSucceeded); secret++) {
+		for (node = fetchOpeningBookRoot(), guesses = 1; OPENING_BOOK_NO_NODE != node; guesses++) {
+			fetchOpeningBookGuess(node, guess);
+			g_classicVariant.p_scoreGuess(g_p_candidateNumbers[secret], guess, &bulls, &cows);
+			if (PLAYER_NUMBER_LEN == bulls) break;
+			node = followOpeningBook(node, bulls, cows);
+		}
+		isSucceeded = (OPENING_BOOK_NO_NODE != node) && (OPENING_BOOK_MAX_DEPTH >= guesses);
+		if (TRUE == isSucceeded) p_guessesHistogram[guesses]++;
+	}
+
+	unloadOpeningBook();
+	return isSucceeded;
+}
+
+static void freeOpeningBookBuilder()
+{
+	int s = 0;
+
+	if (NULL != g_p_openingBookSubtrees)
+		for (s = 0; s < g_numOfOpeningBookSubtrees; s++) free(g_p_openingBookSubtrees[s].p_nodes);
+	free(g_p_openingBookSubtrees);
+	free(g_p_candidatesByDepth);
+	free(g_p_scoreCodes);
+	free(g_p_candidateNumbers);
+	g_p_openingBookSubtrees = NULL;
+	g_numOfOpeningBookSubtrees = 0;
+	g_p_candidatesByDepth = NULL;
+	g_p_scoreCodes = NULL;
+	g_p_candidateNumbers = NULL;
+}
+
+#endif //OPENING_BOOK_BUILDER
@@ -0,0 +1,38 @@
+/* OpeningBookBuilder.h
+---------------------------------------------------------------------
+	Module Description - header module for OpeningBookBuilder.c
+---------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __OPENING_BOOK_BUILDER_H__
+#define __OPENING_BOOK_BUILDER_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef OPENING_BOOK_BUILDER
+/// <summary>
+/// Description - This function builds the opening book of the classic variant - at every node the guess (any number) whose largest group of
+/// candidates sharing a result is the smallest - on a thread per processor, a subtree of the first guess at a time. It then writes the book,
+/// maps it back & plays it against every number to verify it. Built ONLY when OPENING_BOOK_BUILDER is defined - the Server then runs it
+/// instead of serving Clients:
+///		server.exe [--threads <n>] [--output <path>]
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if the book was written & verified. False otherwise</returns>
+BOOL runOpeningBookBuilder(int argc, char* argv[]);
+#endif //OPENING_BOOK_BUILDER
+
+
+#endif //__OPENING_BOOK_BUILDER_H__
@@ -0,0 +1,410 @@
+/* RatingStoreTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the players' rating store. Every
+		player name has an Elo rating, updated when a game ends with a winner or
+		a draw. The names are hashed into shards, each an open addressing table
+		with a lock of its own - lookups share it, a rated game locks only the
+		shards of its two players. A snapshot thread writes the store to a file
+		every RATING_STORE_SNAPSHOT_INTERVAL_MS (a temporary file replaces the
+		previous snapshot, so a crash never leaves a torn one), and the snapshot
+		is loaded when the Server starts.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "RatingStoreTools.h"
+#include "ServerClientsTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const ULONG FNV_OFFSET_BASIS = 2166136261UL;
+static const ULONG FNV_PRIME = 16777619UL;
+static const double OUTCOME_TO_SCORE = 0.5;			// ratingOutcomes are twice the score
+static const double RATING_ODDS_BASE = 10.0;
+static const DWORD SNAPSHOT_THREAD_EXIT_TIMEOUT = 5000; // 5 Seconds
+
+// Global variables ------------------------------------------------------------
+//The shards, and the snapshot buffer (used by the snapshot thread, then by destroyRatingStore(.))
+static ratingStoreShard* g_p_ratingShards = NULL;
+static ratingRecord* g_p_ratingSnapshotRecords = NULL;
+//Snapshot file, thread & its stop Event
+static const char* g_p_ratingSnapshotPath = NULL;
+static HANDLE g_h_ratingSnapshotThread = NULL;
+static HANDLE g_h_ratingSnapshotStopEvent = NULL;
+//# of rated games (InterlockedIncrement) - the snapshot thread writes only when it changed
+static volatile LONG g_numOfRatedGames = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function hashes a player name (FNV-1a). The low bits pick the shard, the rest pick the first probed slot
+/// </summary>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <returns>the name's hash</returns>
+static ULONG hashPlayerName(const char* p_playerName);
+
+/// <summary>
+/// Description - This function finds a name's record in its shard (linear probing), and may add it. The caller holds the shard's lock (exclusive if adding)
+/// </summary>
+/// <param name="ratingStoreShard* p_shard - pointer to the name's shard"></param>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <param name="ULONG hash - the name's hash"></param>
+/// <param name="BOOL isAdding - TRUE to add a record rated RATING_INITIAL if the name is missing"></param>
+/// <returns>pointer to the record, or NULL if the name is missing (and wasn't added, or the shard is full)</returns>
+static ratingRecord* findRatingRecord(ratingStoreShard* p_shard, const char* p_playerName, ULONG hash, BOOL isAdding);
+
+/// <summary>
+/// Description - This function computes a player's rating change (Elo) - a provisional player's K factor is larger, so its rating settles sooner
+/// </summary>
+/// <param name="const ratingRecord* p_record - the player's record"></param>
+/// <param name="LONG opponentRating - the opponent's rating before the game"></param>
+/// <param name="double score - 1 for a win, 0.5 for a draw, 0 for a loss"></param>
+/// <returns>the rating change</returns>
+static LONG computeRatingChange(const ratingRecord* p_record, LONG opponentRating, double score);
+
+/// <summary>
+/// Description - Snapshot thread routine: writes the store every RATING_STORE_SNAPSHOT_INTERVAL_MS if games were rated since, until the stop Event is signaled
+/// </summary>
+/// <param name="LPVOID lpParam - not used"></param>
+/// <returns>True if every snapshot succeeded. False otherwise</returns>
+static BOOL WINAPI ratingSnapshotThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function copies every record (each shard under its shared lock) and writes them to the temporary file, which then replaces the snapshot
+/// </summary>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL writeRatingSnapshot();
+
+/// <summary>
+/// Description - This function loads the snapshot file into the shards. A missing file is a fresh store
+/// </summary>
+/// <returns>True if succeeded. False if the file exists but could not be read</returns>
+static BOOL loadRatingSnapshot();
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeRatingStore(const char* p_snapshotPath)
+{
+	DWORD threadId = 0;
+	int shard = 0;
+
+	//Allocate the shards & the snapshot buffer
+	if (NULL == (g_p_ratingShards = (ratingStoreShard*)_aligned_malloc(sizeof(ratingStoreShard) * RATING_STORE_NUM_OF_SHARDS, CACHE_LINE_SIZE))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the rating store shards", 0, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	memset(g_p_ratingShards, 0, sizeof(ratingStoreShard) * RATING_STORE_NUM_OF_SHARDS);
+	for (shard = 0; shard < RATING_STORE_NUM_OF_SHARDS; shard++) InitializeSRWLock(&g_p_ratingShards[shard].lock);
+	g_numOfRatedGames = 0;
+
+	//In memory only
+	if (NULL == (g_p_ratingSnapshotPath = p_snapshotPath)) return STATUS_CODE_SUCCESS;
+
+	if (NULL == (g_p_ratingSnapshotRecords = (ratingRecord*)calloc(sizeof(ratingRecord), RATING_STORE_NUM_OF_SHARDS * RATING_STORE_SHARD_CAPACITY))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "Failed to allocate the rating snapshot buffer", 0, 0);
+		destroyRatingStore();
+		return STATUS_CODE_FAILURE;
+	}
+	if (STATUS_CODE_FAILURE == loadRatingSnapshot()) {
+		destroyRatingStore();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Start the snapshot thread
+	if (NULL == (g_h_ratingSnapshotStopEvent = CreateEvent(NULL, TRUE, FALSE, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the rating snapshot stop Event", GetLastError(), 0);
+		destroyRatingStore();
+		return STATUS_CODE_FAILURE;
+	}
+	if (INVALID_HANDLE_VALUE == (g_h_ratingSnapshotThread = createThreadSimple((LPTHREAD_START_ROUTINE)ratingSnapshotThreadRoutine, NULL, &threadId))) {
+		g_h_ratingSnapshotThread = NULL;
+		destroyRatingStore();
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyRatingStore()
+{
+	flushRatingStore();
+
+	free(g_p_ratingSnapshotRecords);
+	g_p_ratingSnapshotRecords = NULL;
+	if (NULL != g_p_ratingShards) {
+		_aligned_free(g_p_ratingShards);
+		g_p_ratingShards = NULL;
+	}
+	g_p_ratingSnapshotPath = NULL;
+}
+
+void flushRatingStore()
+{
+	//Stop the snapshot thread, then write the last snapshot
+	if (NULL != g_h_ratingSnapshotThread) {
+		SetEvent(g_h_ratingSnapshotStopEvent);
+		if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_ratingSnapshotThread, SNAPSHOT_THREAD_EXIT_TIMEOUT))
+			LOG_EVENT(LOG_EVENT_TIMEOUT, "The rating snapshot thread did not exit in time", 0, 0);
+		CloseHandle(g_h_ratingSnapshotThread);
+		g_h_ratingSnapshotThread = NULL;
+		writeRatingSnapshot();
+	}
+	if (NULL != g_h_ratingSnapshotStopEvent) {
+		CloseHandle(g_h_ratingSnapshotStopEvent);
+		g_h_ratingSnapshotStopEvent = NULL;
+	}
+}
+
+int fetchPlayerRating(const char* p_playerName)
+{
+	ratingStoreShard* p_shard = NULL;
+	ratingRecord* p_record = NULL;
+	ULONG hash = 0;
+	int rating = RATING_INITIAL;
+	//Input integrity validation
+	if ((NULL == p_playerName) || (NULL == g_p_ratingShards)) return RATING_INITIAL;
+
+	hash = hashPlayerName(p_playerName);
+	p_shard = g_p_ratingShards + (hash & (RATING_STORE_NUM_OF_SHARDS - 1));
+	AcquireSRWLockShared(&p_shard->lock);
+	if (NULL != (p_record = findRatingRecord(p_shard, p_playerName, hash, FALSE))) rating = (int)p_record->rating;
+	ReleaseSRWLockShared(&p_shard->lock);
+	return rating;
+}
+
+BOOL recordRatedGame(const char* p_firstPlayerName, const char* p_secondPlayerName, ratingOutcomes firstPlayerOutcome)
+{
+	ratingStoreShard* p_firstShard = NULL, *p_secondShard = NULL;
+	ratingRecord* p_firstRecord = NULL, *p_secondRecord = NULL;
+	ULONG firstHash = 0, secondHash = 0;
+	LONG firstChange = 0, secondChange = 0;
+	double firstScore = 0.0;
+	//Input integrity validation
+	if ((NULL == p_firstPlayerName) || (NULL == p_secondPlayerName)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+	if (NULL == g_p_ratingShards) return STATUS_CODE_FAILURE;
+
+	firstHash = hashPlayerName(p_firstPlayerName);
+	secondHash = hashPlayerName(p_secondPlayerName);
+	p_firstShard = g_p_ratingShards + (firstHash & (RATING_STORE_NUM_OF_SHARDS - 1));
+	p_secondShard = g_p_ratingShards + (secondHash & (RATING_STORE_NUM_OF_SHARDS - 1));
+	firstScore = (double)firstPlayerOutcome * OUTCOME_TO_SCORE;
+
+	//Lock the two shards in shard order, so two games never wait for each other's shards
+	AcquireSRWLockExclusive(&((p_firstShard < p_secondShard) ? p_firstShard : p_secondShard)->lock);
+	if (p_firstShard != p_secondShard) AcquireSRWLockExclusive(&((p_firstShard < p_secondShard) ? p_secondShard : p_firstShard)->lock);
+
+	if ((NULL != (p_firstRecord = findRatingRecord(p_firstShard, p_firstPlayerName, firstHash, TRUE))) &&
+		(NULL != (p_secondRecord = findRatingRecord(p_secondShard, p_secondPlayerName, secondHash, TRUE)))) {
+		//Both changes are computed from the ratings before the game
+		firstChange = computeRatingChange(p_firstRecord, p_secondRecord->rating, firstScore);
+		secondChange = computeRatingChange(p_secondRecord, p_firstRecord->rating, 1.0 - firstScore);
+		p_firstRecord->rating += firstChange;
+		p_firstRecord->gamesPlayed++;
+		p_secondRecord->rating += secondChange;
+		p_secondRecord->gamesPlayed++;
+	}
+
+	if (p_firstShard != p_secondShard) ReleaseSRWLockExclusive(&((p_firstShard < p_secondShard) ? p_secondShard : p_firstShard)->lock);
+	ReleaseSRWLockExclusive(&((p_firstShard < p_secondShard) ? p_firstShard : p_secondShard)->lock);
+
+	if (NULL == p_secondRecord) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "Rating store shard is full - the game was not rated", (int)firstPlayerOutcome, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	InterlockedIncrement(&g_numOfRatedGames);
+	return STATUS_CODE_SUCCESS;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static ULONG hashPlayerName(const char* p_playerName)
+{
+	ULONG hash = FNV_OFFSET_BASIS;
+	int c = 0;
+	//Assert
+	assert(NULL != p_playerName);
+
+	for (c = 0; (c < MAX_PLAYER_NAME_LEN) && ('\0' != p_playerName[c]); c++) {
+		hash ^= (unsigned char)p_playerName[c];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+static ratingRecord* findRatingRecord(ratingStoreShard* p_shard, const char* p_playerName, ULONG hash, BOOL isAdding)
+{
+	ratingRecord* p_record = NULL;
+	int firstSlot = 0, probe = 0, nameLength = 0;
+	//Asserts
+	assert(NULL != p_shard);
+	assert(NULL != p_playerName);
+
+	firstSlot = (int)((hash / RATING_STORE_NUM_OF_SHARDS) & (RATING_STORE_SHARD_CAPACITY - 1));
+	for (probe = 0; probe < RATING_STORE_SHARD_CAPACITY; probe++) {
+		p_record = p_shard->records + ((firstSlot + probe) & (RATING_STORE_SHARD_CAPACITY - 1));
+		if ('\0' != p_record->playerName[0]) {
+			if (0 == strncmp(p_record->playerName, p_playerName, MAX_PLAYER_NAME_LEN)) return p_record;
+			continue;
+		}
+
+		//A free slot ends the probing - the name is missing
+		if (FALSE == isAdding) return NULL;
+		for (nameLength = 0; (nameLength < MAX_PLAYER_NAME_LEN) && ('\0' != p_playerName[nameLength]); nameLength++);
+		if (0 == nameLength) return NULL;
+		memcpy(p_record->playerName, p_playerName, nameLength);
+		p_record->playerName[nameLength] = '\0';
+		p_record->rating = RATING_INITIAL;
+		p_record->gamesPlayed = 0;
+		p_shard->numOfRecords++;
+		return p_record;
+	}
+	return NULL; //The shard is full
+}
+
+static LONG computeRatingChange(const ratingRecord* p_record, LONG opponentRating, double score)
+{
+	double expectedScore = 0.0;
+	int kFactor = 0;
+	//Assert
+	assert(NULL != p_record);
+
+	expectedScore = 1.0 / (1.0 + pow(RATING_ODDS_BASE, (double)(opponentRating - p_record->rating) / RATING_SCALE));
+	kFactor = (RATING_PROVISIONAL_GAMES > p_record->gamesPlayed) ? RATING_PROVISIONAL_K_FACTOR : RATING_K_FACTOR;
+	return (LONG)floor((double)kFactor * (score - expectedScore) + 0.5);
+}
+
+
+
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    Snapshots
+static BOOL WINAPI ratingSnapshotThreadRoutine(LPVOID lpParam)
+{
+	LONG numOfRatedGames = 0, numOfSnapshottedGames = g_numOfRatedGames;
+	BOOL isSucceeded = TRUE;
+
+	while (TRUE) {
+		switch (WaitForSingleObject(g_h_ratingSnapshotStopEvent, RATING_STORE_SNAPSHOT_INTERVAL_MS)) {
+		case WAIT_TIMEOUT:
+			if (numOfSnapshottedGames == (numOfRatedGames = g_numOfRatedGames)) break; //Nothing changed
+			if (STATUS_CODE_SUCCESS == writeRatingSnapshot()) numOfSnapshottedGames = numOfRatedGames;
+			else isSucceeded = FALSE;
+			break;
+
+		case WAIT_OBJECT_0: //Stopped - destroyRatingStore(.) writes the last snapshot
+			return isSucceeded;
+
+		default:
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait on the rating snapshot stop Event", GetLastError(), 0);
+			return STATUS_CODE_FAILURE;
+		}
+	}
+}
+
+static BOOL writeRatingSnapshot()
+{
+	ratingSnapshotHeader header;
+	HANDLE h_snapshotFile = INVALID_HANDLE_VALUE;
+	DWORD numOfRecords = 0, bytesToWrite = 0, bytesWritten = 0;
+	int shard = 0, slot = 0;
+	BOOL isWritten = FALSE;
+
+	if ((NULL == g_p_ratingSnapshotPath) || (NULL == g_p_ratingSnapshotRecords)) return STATUS_CODE_FAILURE;
+
+	//Copy the records - every shard is locked (shared) only while it is copied
+	for (shard = 0; shard < RATING_STORE_NUM_OF_SHARDS; shard++) {
+		AcquireSRWLockShared(&g_p_ratingShards[shard].lock);
+		for (slot = 0; slot < RATING_STORE_SHARD_CAPACITY; slot++)
+			if ('\0' != g_p_ratingShards[shard].records[slot].playerName[0])
+				g_p_ratingSnapshotRecords[numOfRecords++] = g_p_ratingShards[shard].records[slot];
+		ReleaseSRWLockShared(&g_p_ratingShards[shard].lock);
+	}
+
+	//Write the temporary file, then replace the snapshot with it
+	header.magic = RATING_STORE_MAGIC;
+	header.numOfRecords = numOfRecords;
+	bytesToWrite = numOfRecords * sizeof(ratingRecord);
+	if (INVALID_HANDLE_VALUE == (h_snapshotFile = CreateFile(RATING_STORE_TEMP_PATH, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the rating snapshot file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	isWritten = (WriteFile(h_snapshotFile, &header, sizeof(header), &bytesWritten, NULL) && (sizeof(header) == bytesWritten) &&
+		WriteFile(h_snapshotFile, g_p_ratingSnapshotRecords, bytesToWrite, &bytesWritten, NULL) && (bytesToWrite == bytesWritten) &&
+		FlushFileBuffers(h_snapshotFile));
+	CloseHandle(h_snapshotFile);
+
+	if ((FALSE == isWritten) || (FALSE == MoveFileEx(RATING_STORE_TEMP_PATH, g_p_ratingSnapshotPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to write the rating snapshot file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL loadRatingSnapshot()
+{
+	ratingSnapshotHeader header;
+	ratingRecord record;
+	ratingRecord* p_record = NULL;
+	HANDLE h_snapshotFile = INVALID_HANDLE_VALUE;
+	ratingStoreShard* p_shard = NULL;
+	DWORD r = 0, bytesRead = 0;
+	ULONG hash = 0;
+
+	if (INVALID_HANDLE_VALUE == (h_snapshotFile = CreateFile(g_p_ratingSnapshotPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		if (ERROR_FILE_NOT_FOUND == GetLastError()) return STATUS_CODE_SUCCESS; //First run - a fresh store
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to open the rating snapshot file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+
+	if ((FALSE == ReadFile(h_snapshotFile, &header, sizeof(header), &bytesRead, NULL)) || (sizeof(header) != bytesRead) || (RATING_STORE_MAGIC != header.magic)) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "The rating snapshot file is not a rating snapshot", 0, 0);
+		CloseHandle(h_snapshotFile);
+		return STATUS_CODE_FAILURE;
+	}
+	//No other thread runs yet - the shards are not locked
+	for (r = 0; r < header.numOfRecords; r++) {
+		if ((FALSE == ReadFile(h_snapshotFile, &record, sizeof(record), &bytesRead, NULL)) || (sizeof(record) != bytesRead)) {
+			LOG_EVENT(LOG_EVENT_FAILURE, "The rating snapshot file is truncated", (int)r, (int)header.numOfRecords);
+			break;
+		}
+		record.playerName[MAX_PLAYER_NAME_LEN] = '\0';
+		hash = hashPlayerName(record.playerName);
+		p_shard = g_p_ratingShards + (hash & (RATING_STORE_NUM_OF_SHARDS - 1));
+		if (NULL == (p_record = findRatingRecord(p_shard, record.playerName, hash, TRUE))) continue;
+		p_record->rating = record.rating;
+		p_record->gamesPlayed = record.gamesPlayed;
+	}
+	CloseHandle(h_snapshotFile);
+	return STATUS_CODE_SUCCESS;
+}
+//0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o
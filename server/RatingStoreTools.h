@@ -0,0 +1,61 @@
+/* RatingStoreTools.h
+------------------------------------------------------------------
+	Module Description - header module for RatingStoreTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __RATING_STORE_TOOLS_H__
+#define __RATING_STORE_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function allocates the rating store shards. If a snapshot path is given, the ratings saved there are loaded, and a thread that
+/// writes the store back every RATING_STORE_SNAPSHOT_INTERVAL_MS (if it changed) is started. Must be called once, before any Worker thread is created.
+/// Until it is called, every player is rated RATING_INITIAL and no game is rated
+/// </summary>
+/// <param name="const char* p_snapshotPath - path of the snapshot file (RATING_STORE_PATH), or NULL to keep the ratings in memory only"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeRatingStore(const char* p_snapshotPath);
+
+/// <summary>
+/// Description - This function stops the snapshot thread, writes a last snapshot and frees the shards. Must be called once, after all Worker threads ended
+/// </summary>
+void destroyRatingStore();
+
+/// <summary>
+/// Description - This function stops the snapshot thread & writes a last snapshot, but leaves the shards to the Worker threads that still run.
+/// Called instead of destroyRatingStore() when the Server was handed off
+/// </summary>
+void flushRatingStore();
+
+/// <summary>
+/// Description - This function fetches a player's rating (under its shard's shared lock)
+/// </summary>
+/// <param name="const char* p_playerName - the player's name"></param>
+/// <returns>the player's rating, or RATING_INITIAL for a player that was never rated</returns>
+int fetchPlayerRating(const char* p_playerName);
+
+/// <summary>
+/// Description - This function rates a finished game: both players' ratings move by their K factor times the difference between their score and
+/// their expected score (Elo). Only the shards of the two names are locked, in shard order
+/// </summary>
+/// <param name="const char* p_firstPlayerName - the first player's name"></param>
+/// <param name="const char* p_secondPlayerName - the second player's name"></param>
+/// <param name="ratingOutcomes firstPlayerOutcome - RATING_OUTCOME_WIN, RATING_OUTCOME_DRAW or RATING_OUTCOME_LOSS, of the first player"></param>
+/// <returns>True if the game was rated. False otherwise (e.g. a full shard)</returns>
+BOOL recordRatedGame(const char* p_firstPlayerName, const char* p_secondPlayerName, ratingOutcomes firstPlayerOutcome);
+
+
+#endif //__RATING_STORE_TOOLS_H__
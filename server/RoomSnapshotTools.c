@@ -0,0 +1,334 @@
+/* RoomSnapshotTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the room snapshots - a file mapped
+		to memory that holds a checkpoint of every Worker thread's game (the
+		players names, initial numbers, the round & the pending guess), so a
+		Server that crashed, or exited while games were played, lets the players
+		resume their games once they reconnect & are paired again. The resume
+		is by re-pairing - the same two players paired in a Game Room again
+		pick up both seats of their game together (no game waits for them). A Worker
+		thread checkpoints at the game's phase boundaries into its own slot of
+		two records - it writes the record its last checkpoint isn't in, then
+		publishes it by the slot's sequence, so a checkpoint never takes a lock,
+		never waits for the disk (the system writes the mapped pages back, also
+		after the process crashed) & never tears the last published record.
+		A record of a system crash that was written back partly fails its
+		checksum - the previous record of the slot is read instead.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "RoomSnapshotTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const ULONG FNV_OFFSET_BASIS = 2166136261UL;
+static const ULONG FNV_PRIME = 16777619UL;
+
+// Global variables ------------------------------------------------------------
+//The snapshots file, its mapping & view
+static HANDLE g_h_snapshotsFile = INVALID_HANDLE_VALUE;
+static HANDLE g_h_snapshotsMapping = NULL;
+static roomSnapshotFile* g_p_snapshotsView = NULL;
+//The games read back from the previous Server process, both seats of a game together - a game is claimed once, by the Game Room that resumes it
+// (0 - not claimed, otherwise the claiming Game Room's epoch + 1), so both Worker threads of that room resume it
+static roomSnapshotRecord g_recoveredGames[ROOM_SNAPSHOT_MAX_RECOVERED_GAMES][ROOM_SNAPSHOT_NUM_OF_SEATS];
+static volatile LONG g_recoveredGameClaimerEpoch[ROOM_SNAPSHOT_MAX_RECOVERED_GAMES];
+static int g_numOfRecoveredGames = 0;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function computes the checksum of a record (FNV-1a of the record from 'phase' on)
+/// </summary>
+/// <param name="const roomSnapshotRecord* p_record - the record"></param>
+/// <returns>the record's checksum</returns>
+static ULONG computeRoomSnapshotChecksum(const roomSnapshotRecord* p_record);
+
+/// <summary>
+/// Description - This function checks that a record is a whole checkpoint of the given sequence
+/// </summary>
+/// <param name="const roomSnapshotRecord* p_record - the record"></param>
+/// <param name="LONG sequence - the sequence the record must hold"></param>
+/// <returns>True if valid. False otherwise</returns>
+static BOOL isValidRoomSnapshotRecord(const roomSnapshotRecord* p_record, LONG sequence);
+
+/// <summary>
+/// Description - This function reads back the games of the slots - the published record of every slot, or the one before it if the published
+/// record is not valid. Slots of no game, or of a game whose player's initial number was not received yet, are skipped. A game is kept only if
+/// both its players' records were read back - a record whose opponent's record is missing (or not valid) is discarded, and so is its game
+/// </summary>
+static void recoverCheckpointedGames();
+
+/// <summary>
+/// Description - This function checks that two records are the two seats of the same game (same Game Room epoch & variant, opposite names)
+/// </summary>
+/// <param name="const roomSnapshotRecord* p_record - one record"></param>
+/// <param name="const roomSnapshotRecord* p_otherRecord - the other record"></param>
+/// <returns>True if they are. False otherwise</returns>
+static BOOL areSeatsOfTheSameGame(const roomSnapshotRecord* p_record, const roomSnapshotRecord* p_otherRecord);
+
+/// <summary>
+/// Description - This function copies a string of the package into a record's field, or empties the field if the string is not set
+/// </summary>
+/// <param name="char* p_field - the record's field"></param>
+/// <param name="int fieldSize - size of the field, in bytes"></param>
+/// <param name="const char* p_string - the package's string, or NULL"></param>
+static void copyRoomSnapshotString(char* p_field, int fieldSize, const char* p_string);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL initializeRoomSnapshots(const char* p_snapshotsPath, BOOL isRecovering)
+{
+	LARGE_INTEGER snapshotsFileSize;
+	BOOL isValidFile = FALSE;
+	//Input integrity validation
+	if (NULL == p_snapshotsPath) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return STATUS_CODE_FAILURE;
+	}
+	memset(g_recoveredGames, 0, sizeof(g_recoveredGames));
+	memset((void*)g_recoveredGameClaimerEpoch, 0, sizeof(g_recoveredGameClaimerEpoch));
+	g_numOfRecoveredGames = 0;
+
+	//Map the snapshots file - a smaller (or new) file is extended by the mapping
+	if (INVALID_HANDLE_VALUE == (g_h_snapshotsFile = CreateFile(p_snapshotsPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to open the room snapshots file", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	}
+	isValidFile = (GetFileSizeEx(g_h_snapshotsFile, &snapshotsFileSize) && ((LONGLONG)sizeof(roomSnapshotFile) == snapshotsFileSize.QuadPart));
+	if ((NULL == (g_h_snapshotsMapping = CreateFileMapping(g_h_snapshotsFile, NULL, PAGE_READWRITE, 0, (DWORD)sizeof(roomSnapshotFile), NULL))) ||
+		(NULL == (g_p_snapshotsView = (roomSnapshotFile*)MapViewOfFile(g_h_snapshotsMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(roomSnapshotFile))))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to map the room snapshots file", GetLastError(), 0);
+		destroyRoomSnapshots();
+		return STATUS_CODE_FAILURE;
+	}
+	isValidFile = isValidFile && (ROOM_SNAPSHOT_MAGIC == g_p_snapshotsView->magic) && (NUM_OF_WORKER_THREADS == g_p_snapshotsView->numOfSlots);
+
+	//Read the games of the previous Server process back (a copy of a few records - they are resumed from memory), then start over with no game.
+	// Emptying the file also touches its pages, so the first checkpoints don't fault them in
+	if ((TRUE == isValidFile) && (TRUE == isRecovering)) recoverCheckpointedGames();
+	memset(g_p_snapshotsView, 0, sizeof(roomSnapshotFile));
+	g_p_snapshotsView->magic = ROOM_SNAPSHOT_MAGIC;
+	g_p_snapshotsView->numOfSlots = NUM_OF_WORKER_THREADS;
+	if (0 < g_numOfRecoveredGames) printf("Recovered %d game(s) of the previous Server - players paired again resume them\n", g_numOfRecoveredGames);
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void destroyRoomSnapshots()
+{
+	//Unmap & close the snapshots file
+	if (NULL != g_p_snapshotsView) {
+		FlushViewOfFile(g_p_snapshotsView, 0);
+		UnmapViewOfFile(g_p_snapshotsView);
+		g_p_snapshotsView = NULL;
+	}
+	if (NULL != g_h_snapshotsMapping) {
+		CloseHandle(g_h_snapshotsMapping);
+		g_h_snapshotsMapping = NULL;
+	}
+	if (INVALID_HANDLE_VALUE != g_h_snapshotsFile) {
+		CloseHandle(g_h_snapshotsFile);
+		g_h_snapshotsFile = INVALID_HANDLE_VALUE;
+	}
+}
+
+void checkpointRoomSnapshot(workingThreadPackage* p_params, roomSnapshotPhases phase)
+{
+	roomSnapshotSlot* p_slot = NULL;
+	roomSnapshotRecord* p_record = NULL;
+	FILETIME now;
+	LONG sequence = 0;
+	//Input integrity validation
+	if ((NULL == p_params) || (0 > p_params->snapshotSlot) || (NUM_OF_WORKER_THREADS <= p_params->snapshotSlot)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return;
+	}
+	if (NULL == g_p_snapshotsView) return; //Not initialized - games are not checkpointed
+	p_slot = &g_p_snapshotsView->slots[p_params->snapshotSlot];
+
+	//Only this Worker thread writes its slot - the record the published one is not in is free
+	sequence = p_slot->publishedSequence + 1;
+	p_record = &p_slot->records[(ULONG)sequence & (ROOM_SNAPSHOT_NUM_OF_BUFFERS - 1)];
+	memset(p_record, 0, sizeof(roomSnapshotRecord));
+	p_record->magic = ROOM_SNAPSHOT_MAGIC;
+	p_record->sequence = sequence;
+	p_record->phase = (LONG)phase;
+	GetSystemTimeAsFileTime(&now);
+	p_record->timestamp = (LONGLONG)(((ULONGLONG)now.dwHighDateTime << 32) | now.dwLowDateTime);
+	if (ROOM_SNAPSHOT_EMPTY != phase) {
+		p_record->gameRoomEpoch = p_params->gameRoomEpoch;
+		p_record->gameRound = p_params->gameRound;
+		p_record->numberLength = p_params->p_gameRoom->variant.numberLength;
+		p_record->alphabetSize = p_params->p_gameRoom->variant.alphabetSize;
+		p_record->isRepeatAllowed = p_params->p_gameRoom->variant.isRepeatAllowed;
+		copyRoomSnapshotString(p_record->names.selfPlayerName, sizeof(p_record->names.selfPlayerName), p_params->p_selfPlayerName);
+		copyRoomSnapshotString(p_record->names.otherPlayerName, sizeof(p_record->names.otherPlayerName), p_params->p_otherPlayerName);
+		copyRoomSnapshotString(p_record->numbers.selfInitialNumber, sizeof(p_record->numbers.selfInitialNumber), p_params->p_selfInitialNumber);
+		copyRoomSnapshotString(p_record->numbers.otherInitialNumber, sizeof(p_record->numbers.otherInitialNumber), p_params->p_otherInitialNumber);
+		copyRoomSnapshotString(p_record->numbers.selfCurrentGuess, sizeof(p_record->numbers.selfCurrentGuess), p_params->p_selfCurrentGuess);
+		copyRoomSnapshotString(p_record->numbers.otherCurrentGuess, sizeof(p_record->numbers.otherCurrentGuess), p_params->p_otherCurrentGuess);
+	}
+	p_record->checksum = computeRoomSnapshotChecksum(p_record);
+
+	//Publish - the record is written before the sequence, so a crash in between leaves the previous checkpoint published
+	InterlockedExchange(&p_slot->publishedSequence, sequence);
+}
+
+BOOL resumeRecoveredGame(workingThreadPackage* p_params)
+{
+	roomSnapshotRecord* p_seat = NULL;
+	const gameVariant* p_variant = NULL;
+	LONG claimerEpoch = 0;
+	int g = 0, s = 0;
+	//Input integrity validation
+	if ((NULL == p_params) || (NULL == p_params->p_selfPlayerName) || (NULL == p_params->p_otherPlayerName)) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, NULL, 0, 0); return FALSE;
+	}
+	p_variant = &p_params->p_gameRoom->variant;
+
+	//A game of the same two players & variant - the player's seat is the record of its name. Players of the same name can't tell their seats apart
+	for (g = 0; g < g_numOfRecoveredGames; g++) {
+		if (0 == strcmp(g_recoveredGames[g][0].names.selfPlayerName, g_recoveredGames[g][1].names.selfPlayerName)) continue;
+		for (s = 0; s < ROOM_SNAPSHOT_NUM_OF_SEATS; s++)
+			if ((0 == strcmp(g_recoveredGames[g][s].names.selfPlayerName, p_params->p_selfPlayerName)) &&
+				(0 == strcmp(g_recoveredGames[g][s].names.otherPlayerName, p_params->p_otherPlayerName))) break;
+		if (ROOM_SNAPSHOT_NUM_OF_SEATS == s) continue;
+		p_seat = &g_recoveredGames[g][s];
+		if ((p_seat->numberLength != p_variant->numberLength) || (p_seat->alphabetSize != p_variant->alphabetSize) ||
+			((FALSE != p_seat->isRepeatAllowed) != (FALSE != p_variant->isRepeatAllowed))) continue;
+		//The first Worker thread of the Game Room claims the game for the room, the other one finds it claimed by its own room -
+		// both seats are resumed, or none (a game claimed by another Game Room is skipped by both)
+		claimerEpoch = InterlockedCompareExchange(&g_recoveredGameClaimerEpoch[g], p_params->gameRoomEpoch + 1, 0);
+		if ((0 != claimerEpoch) && (p_params->gameRoomEpoch + 1 != claimerEpoch)) continue;
+
+		//The player keeps its initial number - the opponent's is exchanged as in any game - and the rounds go on from the last one both played
+		memcpy(p_params->playerNumbersStorage.selfInitialNumber, p_seat->numbers.selfInitialNumber, sizeof(p_params->playerNumbersStorage.selfInitialNumber));
+		p_params->p_selfInitialNumber = p_params->playerNumbersStorage.selfInitialNumber;
+		p_params->gameRound = p_seat->gameRound;
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Recovered game resumed at round", p_seat->gameRound, p_seat->gameRoomEpoch);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static ULONG computeRoomSnapshotChecksum(const roomSnapshotRecord* p_record)
+{
+	const unsigned char* p_byte = NULL;
+	ULONG hash = FNV_OFFSET_BASIS;
+	SIZE_T b = 0;
+	//Assert
+	assert(NULL != p_record);
+
+	for (p_byte = (const unsigned char*)p_record + offsetof(roomSnapshotRecord, phase), b = 0; b < sizeof(roomSnapshotRecord) - offsetof(roomSnapshotRecord, phase); b++) {
+		hash ^= p_byte[b];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+static BOOL isValidRoomSnapshotRecord(const roomSnapshotRecord* p_record, LONG sequence)
+{
+	//Assert
+	assert(NULL != p_record);
+
+	return ((ROOM_SNAPSHOT_MAGIC == p_record->magic) && (sequence == p_record->sequence) &&
+		(computeRoomSnapshotChecksum(p_record) == p_record->checksum) &&
+		(ROOM_SNAPSHOT_EMPTY <= p_record->phase) && (ROOM_SNAPSHOT_GUESSING >= p_record->phase));
+}
+
+static void recoverCheckpointedGames()
+{
+	roomSnapshotRecord records[NUM_OF_WORKER_THREADS];
+	BOOL isPaired[NUM_OF_WORKER_THREADS] = { FALSE };
+	roomSnapshotSlot* p_slot = NULL;
+	const roomSnapshotRecord* p_record = NULL;
+	roomSnapshotRecord* p_game = NULL;
+	LONG sequence = 0;
+	int numOfRecords = 0, s = 0, r = 0;
+
+	for (s = 0; s < NUM_OF_WORKER_THREADS; s++) {
+		p_slot = &g_p_snapshotsView->slots[s];
+		sequence = p_slot->publishedSequence;
+		p_record = &p_slot->records[(ULONG)sequence & (ROOM_SNAPSHOT_NUM_OF_BUFFERS - 1)];
+		if (FALSE == isValidRoomSnapshotRecord(p_record, sequence)) {
+			p_record = &p_slot->records[(ULONG)(sequence - 1) & (ROOM_SNAPSHOT_NUM_OF_BUFFERS - 1)];
+			if (FALSE == isValidRoomSnapshotRecord(p_record, sequence - 1)) continue;
+		}
+		if ((ROOM_SNAPSHOT_EMPTY == p_record->phase) || ('\0' == p_record->numbers.selfInitialNumber[0])) continue;
+
+		//Keep the record - its strings are terminated regardless of what was read
+		p_game = &records[numOfRecords++];
+		*p_game = *p_record;
+		p_game->names.selfPlayerName[MAX_PLAYER_NAME_LEN] = '\0';
+		p_game->names.otherPlayerName[MAX_PLAYER_NAME_LEN] = '\0';
+		p_game->numbers.selfInitialNumber[MAX_PLAYER_NUMBER_LEN] = '\0';
+	}
+
+	//Pair the seats of every game - a Worker thread may have checkpointed one round ahead of its opponent's, so both go on from the earlier one
+	for (s = 0; s < numOfRecords; s++)
+		for (r = s + 1; (FALSE == isPaired[s]) && (r < numOfRecords); r++) {
+			if ((TRUE == isPaired[r]) || (FALSE == areSeatsOfTheSameGame(&records[s], &records[r]))) continue;
+			isPaired[s] = isPaired[r] = TRUE;
+			if (records[s].gameRound > records[r].gameRound) records[s].gameRound = records[r].gameRound;
+			else records[r].gameRound = records[s].gameRound;
+			g_recoveredGames[g_numOfRecoveredGames][0] = records[s];
+			g_recoveredGames[g_numOfRecoveredGames++][1] = records[r];
+		}
+	for (s = 0; s < numOfRecords; s++)
+		if (FALSE == isPaired[s]) LOG_EVENT(LOG_EVENT_UNEXPECTED, "Discarded a recovered game missing its opponent's record", records[s].gameRoomEpoch, records[s].gameRound);
+}
+
+static BOOL areSeatsOfTheSameGame(const roomSnapshotRecord* p_record, const roomSnapshotRecord* p_otherRecord)
+{
+	//Assert
+	assert(NULL != p_record);
+	assert(NULL != p_otherRecord);
+
+	return ((p_record->gameRoomEpoch == p_otherRecord->gameRoomEpoch) &&
+		(0 == strcmp(p_record->names.selfPlayerName, p_otherRecord->names.otherPlayerName)) &&
+		(0 == strcmp(p_record->names.otherPlayerName, p_otherRecord->names.selfPlayerName)) &&
+		(p_record->numberLength == p_otherRecord->numberLength) && (p_record->alphabetSize == p_otherRecord->alphabetSize) &&
+		((FALSE != p_record->isRepeatAllowed) == (FALSE != p_otherRecord->isRepeatAllowed)));
+}
+
+static void copyRoomSnapshotString(char* p_field, int fieldSize, const char* p_string)
+{
+	//Assert
+	assert(NULL != p_field);
+
+	if (NULL == p_string) p_field[0] = '\0';
+	else _snprintf_s(p_field, fieldSize, _TRUNCATE, "%s", p_string);
+}
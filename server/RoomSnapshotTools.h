@@ -0,0 +1,58 @@
+/* RoomSnapshotTools.h
+------------------------------------------------------------------
+	Module Description - header module for RoomSnapshotTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __ROOM_SNAPSHOT_TOOLS_H__
+#define __ROOM_SNAPSHOT_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function maps the room snapshots file (creates it if missing, empties it if it isn't a snapshots file of the current size).
+/// If recovering, the games checkpointed by the previous Server process are read back first (kept in memory until resumed), then the file is emptied.
+/// Must be called once, before any Worker thread is created. Until it is called, games are not checkpointed
+/// </summary>
+/// <param name="const char* p_snapshotsPath - path of the snapshots file (ROOM_SNAPSHOT_PATH)"></param>
+/// <param name="BOOL isRecovering - TRUE to read the checkpointed games back. FALSE if they are still played (a handed off Server)"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+BOOL initializeRoomSnapshots(const char* p_snapshotsPath, BOOL isRecovering);
+
+/// <summary>
+/// Description - This function flushes & unmaps the room snapshots file. The checkpoints of the games that did not end stay in the file.
+/// Must be called once, after all Worker threads ended
+/// </summary>
+void destroyRoomSnapshots();
+
+/// <summary>
+/// Description - This function checkpoints the Worker thread's game to its slot without any lock: the record is written to the slot's free
+/// buffer & published. ROOM_SNAPSHOT_EMPTY marks that the Worker thread has no game (the game ended)
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (snapshot slot, Game Room epoch & variant, round, players strings)"></param>
+/// <param name="roomSnapshotPhases phase - the game's phase"></param>
+void checkpointRoomSnapshot(workingThreadPackage* p_params, roomSnapshotPhases phase);
+
+/// <summary>
+/// Description - This function looks for a game the player played with the same opponent & variant before the previous Server process ended,
+/// and if found, claims it for the Game Room (a recovered game is resumed once, by both Worker threads of the room) and restores the player's
+/// initial number & the game's round into the package. Only games of which both seats were recovered are resumed, and only by re-pairing -
+/// called after the two players were paired again (a Client that reconnects is not matched to its game otherwise)
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (players names & Game Room variant)"></param>
+/// <returns>True if a game is resumed. False otherwise</returns>
+BOOL resumeRecoveredGame(workingThreadPackage* p_params);
+
+
+#endif //__ROOM_SNAPSHOT_TOOLS_H__
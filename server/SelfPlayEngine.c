@@ -0,0 +1,436 @@
+/* SelfPlayEngine.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the self-play engine, built ONLY
+		when SELF_PLAY_ENGINE is defined. Two solver strategies play full games
+		against each other in-process - no socket, no Game Room, no message -
+		on a thread per processor, each with its own xorshift random numbers
+		& its own statistics, merged once the threads end. A bot keeps its
+		candidates in a candidate set (CandidateSetTools.c), filtered a word
+		at a time, a guess is scored with the classic variant's kernel, and
+		every round is judged with judgeGameRound(.), as
+		prepareResultsOfCurrentRoundAndSend(.) judges it. The engine prints
+		the win rates, the average game length & the game lengths histogram.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef SELF_PLAY_ENGINE
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "SelfPlayEngine.h"
+#include "GameVariantTools.h"
+#include "CandidateSetTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const int FIRST = 0;
+static const int SECOND = 1;
+static const int HISTOGRAM_BAR_WIDTH = 50;
+static const double PERCENT = 100.0;
+static const double MILLISECONDS_IN_SECOND = 1000.0;
+
+//Command line options
+static const char GAMES_OPTION[] = "--games";
+static const char THREADS_OPTION[] = "--threads";
+static const char FIRST_STRATEGY_OPTION[] = "--first";
+static const char SECOND_STRATEGY_OPTION[] = "--second";
+static const char SEED_OPTION[] = "--seed";
+
+//Strategies names, as given on the command line (ordered as 'selfPlayStrategies')
+static const char* STRATEGY_NAMES[] = { "first", "random", "minimax" };
+
+
+// Global variables ------------------------------------------------------------
+//The classic variant, whose kernel scores the guesses - read only once the threads start
+static gameVariant g_classicVariant;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function parses the engine's command line options (--games <n>, --threads <n>, --first <strategy>, --second <strategy>, --seed <n>).
+/// Missing options keep their defaults
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <param name="LONGLONG* p_numOfGames - pointer to the # of games"></param>
+/// <param name="int* p_numOfThreads - pointer to the # of threads"></param>
+/// <param name="selfPlayStrategies* p_strategies - pointer to the two strategies"></param>
+/// <param name="ULONG* p_seed - pointer to the seed of the threads' random numbers"></param>
+/// <returns>True if every option is known & its value is valid. False otherwise</returns>
+static BOOL fetchSelfPlayOptions(int argc, char* argv[], LONGLONG* p_numOfGames, int* p_numOfThreads, selfPlayStrategies* p_strategies, ULONG* p_seed);
+
+/// <summary>
+/// Description - This function finds a strategy by its name
+/// </summary>
+/// <param name="const char* p_name - the strategy's name"></param>
+/// <param name="selfPlayStrategies* p_strategy - pointer to the found strategy"></param>
+/// <returns>True if found. False otherwise</returns>
+static BOOL fetchStrategyByName(const char* p_name, selfPlayStrategies* p_strategy);
+
+/// <summary>
+/// Description - Self-play thread routine. Plays the thread's games, accumulating their statistics in the thread's package
+/// </summary>
+/// <param name="LPVOID lpParam - pointer to the thread's selfPlayThreadPackage struct"></param>
+/// <returns>0</returns>
+static DWORD WINAPI selfPlayThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function plays a single game - random initial numbers, then rounds of both bots guessing until one of them guesses
+/// (or SELF_PLAY_MAX_GAME_ROUNDS rounds pass) - and accumulates it
+/// </summary>
+/// <param name="selfPlayThreadPackage* p_package - the thread's package"></param>
+static void playSelfPlayGame(selfPlayThreadPackage* p_package);
+
+/// <summary>
+/// Description - This function chooses a bot's guess among its candidates, by its strategy
+/// </summary>
+/// <param name="selfPlayThreadPackage* p_package - the thread's package"></param>
+/// <param name="int side - FIRST or SECOND, the guessing bot"></param>
+/// <returns>index of the guessed number</returns>
+static SHORT chooseSelfPlayGuess(selfPlayThreadPackage* p_package, int side);
+
+/// <summary>
+/// Description - The minimax strategy - weighs up to SELF_PLAY_MINIMAX_SAMPLES random candidates and guesses the one whose largest group of candidates
+/// sharing a result is the smallest. The first guess is random (all first guesses are alike)
+/// </summary>
+/// <param name="selfPlayThreadPackage* p_package - the thread's package"></param>
+/// <param name="int side - FIRST or SECOND, the guessing bot"></param>
+/// <returns>index of the guessed number</returns>
+static SHORT chooseMinimaxGuess(selfPlayThreadPackage* p_package, int side);
+
+/// <summary>
+/// Description - This function keeps only the candidates of a bot that score the given code against its guess
+/// </summary>
+/// <param name="selfPlayThreadPackage* p_package - the thread's package"></param>
+/// <param name="int side - FIRST or SECOND, the guessing bot"></param>
+/// <param name="SHORT guess - index of the guessed number"></param>
+/// <param name="BYTE scoreCode - the guess's score code"></param>
+static void filterSelfPlayCandidates(selfPlayThreadPackage* p_package, int side, SHORT guess, BYTE scoreCode);
+
+/// <summary>
+/// Description - This function adds a thread's statistics to the totals
+/// </summary>
+/// <param name="selfPlayStatistics* p_totals - the totals"></param>
+/// <param name="const selfPlayStatistics* p_statistics - a thread's statistics"></param>
+static void mergeSelfPlayStatistics(selfPlayStatistics* p_totals, const selfPlayStatistics* p_statistics);
+
+/// <summary>
+/// Description - This function prints the win rates, the average game length & the game lengths histogram
+/// </summary>
+/// <param name="const selfPlayStatistics* p_totals - the totals"></param>
+/// <param name="const selfPlayStrategies* p_strategies - the two strategies"></param>
+static void printSelfPlayStatistics(const selfPlayStatistics* p_totals, const selfPlayStrategies* p_strategies);
+
+/// <summary>
+/// Description - This function advances a xorshift generator
+/// </summary>
+/// <param name="ULONG* p_state - pointer to the generator's state (never 0)"></param>
+/// <returns>the next pseudo random number</returns>
+static ULONG nextRandomNumber(ULONG* p_state);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runSelfPlayEngine(int argc, char* argv[])
+{
+	SYSTEM_INFO systemInfo;
+	selfPlayThreadPackage* p_packages = NULL;
+	HANDLE h_threads[SELF_PLAY_MAX_THREADS] = { NULL };
+	selfPlayStatistics totals;
+	selfPlayStrategies strategies[2] = { SELF_PLAY_STRATEGY_RANDOM, SELF_PLAY_STRATEGY_RANDOM };
+	LARGE_INTEGER startTicks, endTicks, ticksPerSecond;
+	LONGLONG numOfGames = SELF_PLAY_DEFAULT_NUM_OF_GAMES;
+	ULONG seed = 0;
+	int numOfThreads = 0, numOfStartedThreads = 0, t = 0;
+	double elapsedMilliseconds = 0;
+	BOOL engineSucceeded = FALSE;
+
+	GetSystemInfo(&systemInfo);
+	numOfThreads = (SELF_PLAY_MAX_THREADS < (int)systemInfo.dwNumberOfProcessors) ? SELF_PLAY_MAX_THREADS : (int)systemInfo.dwNumberOfProcessors;
+	seed = GetTickCount();
+	if (STATUS_CODE_FAILURE == fetchSelfPlayOptions(argc, argv, &numOfGames, &numOfThreads, strategies, &seed)) {
+		printf("Usage: %s [%s <games>] [%s <threads>] [%s <strategy>] [%s <strategy>] [%s <n>]\n", argv[0],
+			GAMES_OPTION, THREADS_OPTION, FIRST_STRATEGY_OPTION, SECOND_STRATEGY_OPTION, SEED_OPTION);
+		printf("       a strategy is %s, %s or %s\n", STRATEGY_NAMES[SELF_PLAY_STRATEGY_FIRST], STRATEGY_NAMES[SELF_PLAY_STRATEGY_RANDOM], STRATEGY_NAMES[SELF_PLAY_STRATEGY_MINIMAX]);
+		return STATUS_CODE_FAILURE;
+	}
+	if (SELF_PLAY_MAX_THREADS < numOfThreads) {
+		printf("Warning: The engine runs at most %d threads.\n", SELF_PLAY_MAX_THREADS);
+		numOfThreads = SELF_PLAY_MAX_THREADS;
+	}
+	setClassicGameVariant(&g_classicVariant);
+
+	//The candidate sets' tables & a package per thread (its candidate sets are vectors - aligned)
+	initializeCandidateSets();
+	if (NULL == (p_packages = (selfPlayThreadPackage*)_aligned_malloc(sizeof(selfPlayThreadPackage) * numOfThreads, CACHE_LINE_SIZE))) {
+		printf("Error: Failed to allocate memory for %d threads.\n", numOfThreads);
+		return STATUS_CODE_FAILURE;
+	}
+	memset(p_packages, 0, sizeof(selfPlayThreadPackage) * numOfThreads);
+
+	//The games are split evenly - the first threads play the remainder
+	for (t = 0; t < numOfThreads; t++) {
+		p_packages[t].numOfGames = numOfGames / numOfThreads + ((t < numOfGames % numOfThreads) ? 1 : 0);
+		p_packages[t].strategies[FIRST] = strategies[FIRST];
+		p_packages[t].strategies[SECOND] = strategies[SECOND];
+		p_packages[t].randomState = (seed ^ (0x9E3779B9UL * (ULONG)(t + 1))) | 1;
+	}
+
+	printf("Self-play of %lld games, %s vs %s, %d threads (seed %lu)\n", numOfGames, STRATEGY_NAMES[strategies[FIRST]], STRATEGY_NAMES[strategies[SECOND]], numOfThreads, seed);
+	QueryPerformanceFrequency(&ticksPerSecond);
+	QueryPerformanceCounter(&startTicks);
+	for (numOfStartedThreads = 0; numOfStartedThreads < numOfThreads; numOfStartedThreads++)
+		if (NULL == (h_threads[numOfStartedThreads] = CreateThread(NULL, 0, selfPlayThreadRoutine, p_packages + numOfStartedThreads, 0, NULL))) {
+			printf("Error: Failed to create a self-play thread, with error code no. %ld.\n", GetLastError());
+			break;
+		}
+	if ((0 < numOfStartedThreads) && (WAIT_FAILED == WaitForMultipleObjects((DWORD)numOfStartedThreads, h_threads, TRUE, INFINITE)))
+		printf("Error: Failed to wait for the self-play threads, with error code no. %ld.\n", GetLastError());
+	QueryPerformanceCounter(&endTicks);
+	for (t = 0; t < numOfStartedThreads; t++) CloseHandle(h_threads[t]);
+
+	//Merge the threads' statistics
+	if (numOfThreads == numOfStartedThreads) {
+		memset(&totals, 0, sizeof(totals));
+		for (t = 0; t < numOfThreads; t++) mergeSelfPlayStatistics(&totals, &p_packages[t].statistics);
+		elapsedMilliseconds = (double)(endTicks.QuadPart - startTicks.QuadPart) * MILLISECONDS_IN_SECOND / (double)ticksPerSecond.QuadPart;
+		printf("Completed in %.3f ms (%.0f games per second)\n", elapsedMilliseconds,
+			(0 < elapsedMilliseconds) ? (double)totals.numOfGames * MILLISECONDS_IN_SECOND / elapsedMilliseconds : 0.0);
+		printSelfPlayStatistics(&totals, strategies);
+		engineSucceeded = (numOfGames == totals.numOfGames);
+	}
+
+	_aligned_free(p_packages);
+	return engineSucceeded;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL fetchSelfPlayOptions(int argc, char* argv[], LONGLONG* p_numOfGames, int* p_numOfThreads, selfPlayStrategies* p_strategies, ULONG* p_seed)
+{
+	int a = 0;
+	long value = 0;
+
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) return STATUS_CODE_FAILURE; //Every option takes a value
+
+		//Strategies are given by name, the rest by a positive number
+		if (STRINGS_ARE_EQUAL(argv[a], FIRST_STRATEGY_OPTION, sizeof(FIRST_STRATEGY_OPTION))) {
+			if (STATUS_CODE_FAILURE == fetchStrategyByName(argv[a + 1], p_strategies + FIRST)) return STATUS_CODE_FAILURE;
+		}
+		else if (STRINGS_ARE_EQUAL(argv[a], SECOND_STRATEGY_OPTION, sizeof(SECOND_STRATEGY_OPTION))) {
+			if (STATUS_CODE_FAILURE == fetchStrategyByName(argv[a + 1], p_strategies + SECOND)) return STATUS_CODE_FAILURE;
+		}
+		else {
+			value = strtol(argv[a + 1], NULL, 10);
+			if (0 >= value) return STATUS_CODE_FAILURE;
+
+			if (STRINGS_ARE_EQUAL(argv[a], GAMES_OPTION, sizeof(GAMES_OPTION))) *p_numOfGames = value;
+			else if (STRINGS_ARE_EQUAL(argv[a], THREADS_OPTION, sizeof(THREADS_OPTION))) *p_numOfThreads = (int)value;
+			else if (STRINGS_ARE_EQUAL(argv[a], SEED_OPTION, sizeof(SEED_OPTION))) *p_seed = (ULONG)value;
+			else return STATUS_CODE_FAILURE;
+		}
+		a++;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL fetchStrategyByName(const char* p_name, selfPlayStrategies* p_strategy)
+{
+	int s = 0;
+	//Asserts
+	assert(NULL != p_name);
+	assert(NULL != p_strategy);
+
+	for (s = 0; s < NUM_OF_SELF_PLAY_STRATEGIES; s++)
+		if (0 == strcmp(p_name, STRATEGY_NAMES[s])) {
+			*p_strategy = (selfPlayStrategies)s;
+			return STATUS_CODE_SUCCESS;
+		}
+	return STATUS_CODE_FAILURE;
+}
+
+static DWORD WINAPI selfPlayThreadRoutine(LPVOID lpParam)
+{
+	selfPlayThreadPackage* p_package = NULL;
+	LONGLONG g = 0;
+	//Assert
+	assert(NULL != lpParam);
+
+	p_package = (selfPlayThreadPackage*)lpParam;
+	for (g = 0; g < p_package->numOfGames; g++) playSelfPlayGame(p_package);
+	return 0;
+}
+
+static void playSelfPlayGame(selfPlayThreadPackage* p_package)
+{
+	SHORT initialNumbers[2] = { 0 }, guesses[2] = { 0 }, bulls = 0, cows = 0;
+	BYTE scoreCodes[2] = { 0 };
+	gameRoundOutcomes roundOutcome = GAME_ROUND_CONTINUES;
+	int side = 0, round = 0;
+	//Assert
+	assert(NULL != p_package);
+
+	//A new game - random initial numbers, every number a candidate
+	for (side = FIRST; side <= SECOND; side++) {
+		initialNumbers[side] = (SHORT)(nextRandomNumber(&p_package->randomState) % NUM_OF_PLAYER_NUMBERS);
+		p_package->numOfCandidates[side] = fillCandidateSet(p_package->candidates + side);
+	}
+
+	for (round = 1; round <= SELF_PLAY_MAX_GAME_ROUNDS; round++) {
+		//Both bots guess the opponent's number, then the round is judged as the Worker threads judge it
+		for (side = FIRST; side <= SECOND; side++) {
+			guesses[side] = chooseSelfPlayGuess(p_package, side);
+			g_classicVariant.p_scoreGuess(fetchCandidateNumber(initialNumbers[1 - side]), fetchCandidateNumber(guesses[side]), &bulls, &cows);
+			scoreCodes[side] = SCORE_CODE(bulls, cows);
+		}
+		roundOutcome = judgeGameRound(&g_classicVariant, SCORE_CODE_BULLS(scoreCodes[FIRST]), SCORE_CODE_BULLS(scoreCodes[SECOND]));
+		if (GAME_ROUND_CONTINUES != roundOutcome) break;
+
+		for (side = FIRST; side <= SECOND; side++) filterSelfPlayCandidates(p_package, side, guesses[side], scoreCodes[side]);
+	}
+
+	//Accumulate - an unfinished game is a draw of length 0
+	p_package->statistics.numOfGames++;
+	switch (roundOutcome) {
+	case GAME_ROUND_SELF_WINS: p_package->statistics.outcomes[RATING_OUTCOME_WIN]++; break;
+	case GAME_ROUND_OTHER_WINS: p_package->statistics.outcomes[RATING_OUTCOME_LOSS]++; break;
+	default: p_package->statistics.outcomes[RATING_OUTCOME_DRAW]++; break;
+	}
+	if (GAME_ROUND_CONTINUES == roundOutcome) p_package->statistics.gameLengths[0]++;
+	else {
+		p_package->statistics.gameLengths[round]++;
+		p_package->statistics.numOfRounds += round;
+	}
+}
+
+static SHORT chooseSelfPlayGuess(selfPlayThreadPackage* p_package, int side)
+{
+	//Assert
+	assert(0 < p_package->numOfCandidates[side]);
+
+	switch (p_package->strategies[side]) {
+	case SELF_PLAY_STRATEGY_FIRST:
+		return fetchNthCandidate(p_package->candidates + side, 0);
+	case SELF_PLAY_STRATEGY_MINIMAX:
+		return chooseMinimaxGuess(p_package, side);
+	default:
+		return fetchNthCandidate(p_package->candidates + side, (int)(nextRandomNumber(&p_package->randomState) % (ULONG)p_package->numOfCandidates[side]));
+	}
+}
+
+static SHORT chooseMinimaxGuess(selfPlayThreadPackage* p_package, int side)
+{
+	int groupSizes[NUM_OF_SCORE_CODES];
+	const candidateSet* p_candidates = p_package->candidates + side;
+	int numOfCandidates = p_package->numOfCandidates[side], numOfSamples = 0, s = 0, code = 0, largestGroup = 0, bestLargestGroup = 0;
+	SHORT sample = 0, bestGuess = 0;
+
+	//All first guesses are alike, and a few candidates are all weighed
+	if (NUM_OF_PLAYER_NUMBERS == numOfCandidates)
+		return fetchNthCandidate(p_candidates, (int)(nextRandomNumber(&p_package->randomState) % (ULONG)numOfCandidates));
+	numOfSamples = (numOfCandidates < SELF_PLAY_MINIMAX_SAMPLES) ? numOfCandidates : SELF_PLAY_MINIMAX_SAMPLES;
+
+	bestLargestGroup = numOfCandidates + 1;
+	for (s = 0; s < numOfSamples; s++) {
+		sample = fetchNthCandidate(p_candidates, (numOfCandidates <= SELF_PLAY_MINIMAX_SAMPLES) ? s :
+			(int)(nextRandomNumber(&p_package->randomState) % (ULONG)numOfCandidates));
+
+		//Group the candidates by the result the sample would get from each of them
+		countCandidateSetGroups(p_candidates, fetchCandidateNumber(sample), groupSizes);
+		for (code = 0, largestGroup = 0; code < NUM_OF_SCORE_CODES; code++)
+			if (largestGroup < groupSizes[code]) largestGroup = groupSizes[code];
+
+		if (largestGroup < bestLargestGroup) {
+			bestLargestGroup = largestGroup;
+			bestGuess = sample;
+		}
+	}
+	return bestGuess;
+}
+
+static void filterSelfPlayCandidates(selfPlayThreadPackage* p_package, int side, SHORT guess, BYTE scoreCode)
+{
+	p_package->numOfCandidates[side] = filterCandidateSet(p_package->candidates + side, fetchCandidateNumber(guess),
+		SCORE_CODE_BULLS(scoreCode), SCORE_CODE_COWS(scoreCode));
+}
+
+static void mergeSelfPlayStatistics(selfPlayStatistics* p_totals, const selfPlayStatistics* p_statistics)
+{
+	int i = 0;
+
+	p_totals->numOfGames += p_statistics->numOfGames;
+	p_totals->numOfRounds += p_statistics->numOfRounds;
+	for (i = 0; i <= RATING_OUTCOME_WIN; i++) p_totals->outcomes[i] += p_statistics->outcomes[i];
+	for (i = 0; i <= SELF_PLAY_MAX_GAME_ROUNDS; i++) p_totals->gameLengths[i] += p_statistics->gameLengths[i];
+}
+
+static void printSelfPlayStatistics(const selfPlayStatistics* p_totals, const selfPlayStrategies* p_strategies)
+{
+	LONGLONG numOfFinishedGames = 0, mostGames = 0;
+	double games = 0;
+	int length = 0, b = 0, barWidth = 0;
+
+	if (0 == p_totals->numOfGames) return;
+	games = (double)p_totals->numOfGames;
+	numOfFinishedGames = p_totals->numOfGames - p_totals->gameLengths[0];
+
+	printf("%s won %.2f%%, drew %.2f%%, %s won %.2f%%\n",
+		STRATEGY_NAMES[p_strategies[FIRST]], PERCENT * (double)p_totals->outcomes[RATING_OUTCOME_WIN] / games,
+		PERCENT * (double)p_totals->outcomes[RATING_OUTCOME_DRAW] / games,
+		STRATEGY_NAMES[p_strategies[SECOND]], PERCENT * (double)p_totals->outcomes[RATING_OUTCOME_LOSS] / games);
+	printf("Average game length: %.3f rounds (guesses per player), %lld unfinished games\n",
+		(0 < numOfFinishedGames) ? (double)p_totals->numOfRounds / (double)numOfFinishedGames : 0.0, p_totals->gameLengths[0]);
+
+	//Histogram - a bar is scaled to the most common length
+	for (length = 1; length <= SELF_PLAY_MAX_GAME_ROUNDS; length++)
+		if (mostGames < p_totals->gameLengths[length]) mostGames = p_totals->gameLengths[length];
+	printf("Game lengths:\n");
+	for (length = 1; length <= SELF_PLAY_MAX_GAME_ROUNDS; length++) {
+		if (0 == p_totals->gameLengths[length]) continue;
+		printf("  %2d rounds %12lld %6.2f%% ", length, p_totals->gameLengths[length], PERCENT * (double)p_totals->gameLengths[length] / games);
+		barWidth = (int)((HISTOGRAM_BAR_WIDTH * p_totals->gameLengths[length] + mostGames - 1) / mostGames);
+		for (b = 0; b < barWidth; b++) putchar('#');
+		putchar('\n');
+	}
+}
+
+static ULONG nextRandomNumber(ULONG* p_state)
+{
+	ULONG state = *p_state;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	*p_state = state;
+	return state;
+}
+
+#endif //SELF_PLAY_ENGINE
@@ -0,0 +1,38 @@
+/* SelfPlayEngine.h
+------------------------------------------------------------------
+	Module Description - header module for SelfPlayEngine.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __SELF_PLAY_ENGINE_H__
+#define __SELF_PLAY_ENGINE_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef SELF_PLAY_ENGINE
+/// <summary>
+/// Description - This function plays games between two solver strategies entirely in-process - no socket, no Game Room - on a thread per processor,
+/// each with its own random numbers, and prints the win rates, the average game length & the game lengths histogram. Every round is scored & judged
+/// as the Worker threads score & judge it. Built ONLY when SELF_PLAY_ENGINE is defined - the Server then runs it instead of serving Clients:
+///		server.exe [--games <n>] [--threads <n>] [--first <strategy>] [--second <strategy>] [--seed <n>]
+/// where a strategy is first, random or minimax
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if every game was played. False otherwise</returns>
+BOOL runSelfPlayEngine(int argc, char* argv[]);
+#endif //SELF_PLAY_ENGINE
+
+
+#endif //__SELF_PLAY_ENGINE_H__
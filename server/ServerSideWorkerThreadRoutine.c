@@ -27,10 +27,23 @@
 
 // Projects includes -----------------------------------------------------------
 #include "HardCodedData.h"
+#include "ServerSideWorkerThreadRoutine.h"
 #include "MemoryHandling.h"
 #include "ServerClientsTools.h"
 #include "MessagesTransferringTools.h"
 #include "FilesHandlingTools.h"
+#include "GameRoomTools.h"
+#include "EventLoggingTools.h"
+#include "MetricsTools.h"
+#include "SendQueueTools.h"
+#include "MatchmakingTools.h"
+#include "RatingStoreTools.h"
+#include "GameJournalTools.h"
+#include "GameHistoryIndexTools.h"
+#include "GameVariantTools.h"
+#include "SpectatorFanoutTools.h"
+#include "RoomSnapshotTools.h"
+#include "SessionTokenTools.h"
 
 
 
@@ -58,10 +71,6 @@ static const BOOL MUTEX_OWNERSHIP_RELEASE_FAILED = 0;
 //static const BOOL STATUS_SERVER_ERROR = -1;
 //static const BOOL STATUS_SERVER_EXIT = -2;
 
-// Global variables ------------------------------------------------------------
-//Player disconnection bit
-int g_serverOpponentQuitBit = 0;
-
 // Functions declerations ------------------------------------------------------
 
 /// <summary>
@@ -120,9 +129,9 @@ static communicationResults initiateMainMenuProcedure(workingThreadPackage* p_pa
 /// <returns>'communicationResults' code according to all of the Exit codes possible</returns>
 static communicationResults mainMenuClientResponses(workingThreadPackage* p_params);
 /// <summary>
-/// Description - This function mainly vaildates the availability of another player to play a game. It first checks the "Current Connected Clients Number", if it equals 1
-/// then the function will send back to the user the SERVER_NO_OPPONENTS message, and loop back to SERVER_MAIN_MENU (along with sending main menu message). If there are two players
-/// currently connected, the function will perform the Sync between them (under the assumption both will player against one another). Following that another ERROR'\'EXIT' events statuses
+/// Description - This function mainly finds another player to play a game. It asks the matchmaking (MatchmakingTools.c) for an opponent, and if none arrives in time (a Server's bot
+/// included, when a Worker thread is free for it), the function will send back to the user the SERVER_NO_OPPONENTS message, and loop back to SERVER_MAIN_MENU (along with sending main menu message).
+/// If an opponent was matched, the function will perform the Sync between them (both will play against one another). Following that another ERROR'\'EXIT' events statuses
 /// check is performed***. (if the number of Curre Conn Clie is -1, the Mutex ownership has probably failed -> that is a fatal error and the thread will leave with COMMUNICATION_FAILED)
 /// If Syncing the players takes too long (10 min) the player that had already sent CLIENT_VERSUS, will be outputted back to main menu with SERVER_NO_OPPONENTS
 /// </summary>
@@ -168,6 +177,13 @@ static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient
 /// <param name="HANDLE*p_h_releaseEvent - pointer to the handle of the event the player will RELEASE to allow the other player to proceed to his next STEP"></param>
 /// <returns>'communicationResults' code indicating different results for this function, mainly fail(fatal error) or succeed</returns>
 static communicationResults stepsStyleAccessingGameSessionFile(workingThreadPackage* p_params, int dataTypeBit, int firstPlayerBit, int writeBit, HANDLE* p_h_stuckEvent, HANDLE* p_h_releaseEvent);
+/// <summary>
+/// Description - This function is called when the opponent quit the current game (or took too long to respond). It sends SERVER_OPPONENT_QUIT to the Client,
+/// and leaves the Game Room by raising this thread's quit flag as well. The last of the two players to leave restores the players Events for the next couple.
+/// </summary>
+/// <param name="workingThreadPackage* p_params - thread's inputs (pointers to Game Room, Event objects, Socket)"></param>
+/// <returns>PLAYER_DISCONNECTED if the Client was notified and may return to Server's main menu. SERVER_DISCONNECTED or COMMUNICATION_FAILED otherwise</returns>
+static communicationResults notifyClientOpponentQuitAndLeaveGameRoom(workingThreadPackage* p_params);
 
 
 
@@ -185,12 +201,27 @@ static communicationResults beginGame(workingThreadPackage* p_params);
 
 /// <summary>
 /// Desciption - This function performs the sending of SERVER_INVITE  and SERVER_SETUP_REQUEST,   while allowing between them to notice an abrupt disconnection 
-/// of the OTHER Client, and send SERVER_OPPONENT_QUIT INSTEAD, and leave back to menu (currently broken) then it awaits CLIENT_SETUP which will tranfer the initial
+/// of the OTHER Client, and send SERVER_OPPONENT_QUIT INSTEAD, and leave back to menu, then it awaits CLIENT_SETUP which will tranfer the initial
 /// Users numbers to the Server Worker threads...
 /// </summary>
 /// <param name="workingThreadPackage* p_params - thread's inputs (pointers to Event objects, Mutex object, players data items, Socket)"></param>
 /// <returns>'communicationResults' codes - COMM_SUCCEEDED, FAILED,   SERVER DISCONNECT, BACK TO MENU, SERVER EXIT etc.</returns>
 static communicationResults receiveInitialPlayerNumber(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - This function sends SERVER_SETUP_REQUSET with the Game Room's variant & the player's initial number (NULL unless the game was resumed)
+/// </summary>
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <returns>the send operation's 'transferResults' code</returns>
+static transferResults sendSetupRequest(workingThreadPackage* p_params);
+
+/// <summary>
+/// Description - The game's guessing rounds - each round receives both players' guesses, exchanges them and sends back the round's results,
+/// until the game ends or one of the players leaves. A game handed off by the previous Server process resumes here
+/// </summary>
+/// <param name="workingThreadPackage* p_params - pointer to a thread package (struct) that contains the Client's & the Game Room's data"></param>
+/// <returns>communicationResults value which represents the game's outcome</returns>
+static communicationResults playGuessingRounds(workingThreadPackage* p_params);
 /// <summary>
 /// Description - this function utilizes awaitBothPlayersByMarkingFirstClientThenSecondClient(.) and the "Steps Syncing" procedure to exchange the received 
 /// initial Users numbers. Afterwards it perform another 'EXIT' and 'ERROR' events statu check***.
@@ -205,7 +236,6 @@ static communicationResults syncPlayersAndTransferNumbers(workingThreadPackage*
 /// gameing procedure go as planned to receive the player guess numbers (at every round). Then it will await the Client response with the guess number -> 
 /// CLIENT_PLAYER_MOVE. Following the numbers arrival  at the Worker threads, the function will perform another "Steps Sync" procedure to exchanges the guess numbers.
 /// Finally, it will proceed to compute the results of the current round - Win, Tie, Proceed		
-/// (currently SERVER_OPPONENT_QUIT which leads to PLAYER_DISCONNECT is broken)
 /// </summary>
 /// <param name="workingThreadPackage* p_params - thread's inputs (pointers to Event objects, Mutex object, players data items, Socket)"></param>
 /// <returns>'communicationResults' codes - COMM_SUCCEEDED, FAILED,   SERVER DISCONNECT, BACK TO MENU, SERVER EXIT etc.</returns>
@@ -213,7 +243,7 @@ static communicationResults receivePlayersGuessesAndComputeResults(workingThread
 
 /// <summary>
 /// Description - This function fetches the "Bulls and Cows" round result aand sends the appropriate message to  the players. It proceeds
-/// to either Server Main Menu, another guess round, complete termination etc... (currently SERVER_OPPONENT_QUIT which leads to PLAYER_DISCONNECT is broken)
+/// to either Server Main Menu, another guess round, complete termination etc... (or PLAYER_DISCONNECTED if the opponent quit)
 /// </summary>
 /// <param name="workingThreadPackage* p_params - thread's inputs (pointers to Event objects, Mutex object, players data items, Socket)"></param>
 /// <returns>'communicationResults' codes - COMM_SUCCEEDED, FAILED,   SERVER PLAYER DISCONNECT, BACK TO MENU etc.</returns>
@@ -222,14 +252,14 @@ static communicationResults prepareResultsOfCurrentRoundAndSend(workingThreadPac
 
 /// <summary>
 ///  Description - function to send a SERVER_DRAW messaage with the desired parameters, free the player no-longer needed data and leave...
-/// (currently SERVER_OPPONENT_QUIT which leads to PLAYER_DISCONNECT is broken)
+/// (or SERVER_OPPONENT_QUIT if the opponent quit, which leads to PLAYER_DISCONNECTED)
 /// </summary>
 /// <param name="workingThreadPackage* p_params - thread's inputs (pointers to Event objects, Mutex object, players data items, Socket)"></param>
 /// <returns>'communicationResults' codes - COMM_SUCCEEDED, FAILED,   SERVER PLAYER DISCONNECT, BACK TO MENU etc.</returns>
 static communicationResults sendDraw(workingThreadPackage* p_params);
 /// <summary>
 ///  Description - function to send a SERVER_WIN messaage with the desired parameters, free the player no-longer needed data and leave...
-/// (currently SERVER_OPPONENT_QUIT which leads to PLAYER_DISCONNECT is broken)
+/// (or SERVER_OPPONENT_QUIT if the opponent quit, which leads to PLAYER_DISCONNECTED)
 /// </summary>
 /// <param name="workingThreadPackage* p_params - thread's inputs (pointers to Event objects, Mutex object, players data items, Socket)"></param>
 /// <param name="char* p_winner - pointer to the winner name buffer"></param>
@@ -238,19 +268,76 @@ static communicationResults sendWinner(workingThreadPackage* p_params, char* p_w
 
 /// <summary>
 /// Description - This function utilizes concatenateStringToStringThatMayContainNullCharacters(.) to perform a BRUTE FORCE copy of the data transferred
+/// into one of the package's inline 'playerNames'\'playerNumbers' buffers (truncated to the buffer's size), and points the player's string pointer at it. No memory is allocated.
 /// </summary>
 /// <param name="message* p_receivedMessageFromClient - the messag struct of the Client response"></param>
-/// <param name="char** p_p_playerDataInMessage - some parameter address pointer buffer"></param>
+/// <param name="char** p_p_playerDataInMessage - address of the player's string pointer in the package"></param>
+/// <param name="char* p_playerDataStorage - the inline buffer that will hold the copy"></param>
+/// <param name="int playerDataStorageSize - size of the inline buffer in bytes, including the '\0'"></param>
 /// <returns>0 if successful, -1 if failed</returns>
-static int copyPlayerNameOrFourDigitNumberString(message* p_receivedMessageFromClient, char** p_p_playerNameInMessage);
+static int copyPlayerNameOrFourDigitNumberString(message* p_receivedMessageFromClient, char** p_p_playerNameInMessage, char* p_playerDataStorage, int playerDataStorageSize);
+
 /// <summary>
-/// Description - This function conducts a single classic round of "Bulls and Cows" by comparing the number(string representation)
+/// Description - This function checks a received initial number or guess against the Game Room's variant (isValidPlayerNumber(.)). A number the variant
+/// does not allow is counted, the opponent is told this player quit, and the Client is disconnected
 /// </summary>
-/// <param name="TCHAR* p_opponentInitialDigits - pointer to buffer containing an initial number of one player"></param>
-/// <param name="TCHAR*p_selfPlayerGuessDigits - pointer to buffer containing an guess number of the other player"></param>
-/// <param name="SHORT* p_cowsAddress - address of the number of cows"></param>
-/// <param name="SHORT* p_bullsAddress - address of the number of bulls"></param>
-static void playSingleGamePhase(TCHAR* p_opponentInitialDigits, TCHAR* p_selfPlayerGuessDigits, SHORT* p_cowsAddress, SHORT* p_bullsAddress);
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <param name="const char* p_number - the copied number"></param>
+/// <returns>True if valid. False if the Client was disconnected</returns>
+static BOOL validateReceivedPlayerNumber(workingThreadPackage* p_params, const char* p_number);
+
+/// <summary>
+/// Description - This function parks the Worker thread for a hot restart: the thread publishes where it stopped (its park point) and waits until the
+/// restart is cancelled, or the Server exits. If the restart succeeds, the Server process ends while the thread is parked, and the new Server process
+/// resumes the Client's connection at the same park point
+/// </summary>
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <param name="workerParkPoints parkPoint - the step the Worker thread parks at"></param>
+/// <returns>True if the restart was cancelled & the thread goes on. False if 'Exit' was entered or a fatal error occured</returns>
+static BOOL parkWorkerForHandoff(workingThreadPackage* p_params, workerParkPoints parkPoint);
+
+/// <summary>
+/// Description - This function awaits a Client's message while the Worker thread may be asked to park for a hot restart (and in a Game Room, while
+/// the opponent may quit). A Worker thread parked & released, since the restart was cancelled, goes on awaiting the message
+/// </summary>
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <param name="message** p_p_receivedMessageFromClient - pointer address of 'message' struct that will be allocated memory to"></param>
+/// <param name="workerParkPoints parkPoint - the step the Worker thread parks at (WORKER_PARKED_MAIN_MENU - no Game Room quit Event)"></param>
+/// <returns>the same codes as receiveMessageOrAbortOnEvent(.) - TRANSFER_ABORTED if the opponent quit, or the restart could not be parked</returns>
+static transferResults receiveClientMessageOrParkForHandoff(workingThreadPackage* p_params, message** p_p_receivedMessageFromClient, workerParkPoints parkPoint);
+
+/// <summary>
+/// Description - This function awaits a player's initial number or guess, copies it into the package's inline storage & validates it against the
+/// Game Room's variant. Any other message, a disconnection or a timeout ends the game, and the opponent is notified
+/// </summary>
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <param name="int expectedMessageType - CLIENT_SETUP_NUM or CLIENT_PLAYER_MOVE_NUM"></param>
+/// <param name="char** p_p_playerNumber - address of the player's number pointer in the package"></param>
+/// <param name="char* p_playerNumberStorage - the inline buffer that will hold the copy"></param>
+/// <param name="int playerNumberStorageSize - size of the inline buffer in bytes, including the '\0'"></param>
+/// <param name="workerParkPoints parkPoint - the step the Worker thread parks at, if a hot restart is requested meanwhile"></param>
+/// <param name="workerPhases phase - the phase a timeout is counted for"></param>
+/// <returns>communicationResults value which represents the receive procedure outcome</returns>
+static communicationResults receivePlayerNumber(workingThreadPackage* p_params, int expectedMessageType, char** p_p_playerNumber, char* p_playerNumberStorage,
+	int playerNumberStorageSize, workerParkPoints parkPoint, workerPhases phase);
+
+/// <summary>
+/// Description - This function holds the game for a Client whose connection dropped while its initial number or guess was awaited. If the Client
+/// reconnects with its session token within the grace period (unless the opponent quits or the Server exits first), the new connection replaces
+/// the dropped one, and SERVER_APPROVED with the game's phase, the last round's results (if any) & the pending request are sent on it
+/// </summary>
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <param name="workerParkPoints parkPoint - WORKER_PARKED_SETUP (SERVER_SETUP_REQUSET is pending) or WORKER_PARKED_PLAYER_MOVE (SERVER_PLAYER_MOVE_REQUEST)"></param>
+/// <returns>True if the Client reconnected - its number is awaited again. False otherwise</returns>
+static BOOL reattachReconnectedClient(workingThreadPackage* p_params, workerParkPoints parkPoint);
+
+/// <summary>
+/// Description - This function ends the Worker thread's game, however it ended: its room snapshot is emptied - unless the Server exits, so the next
+/// Server resumes it - and the game's numbers & opponent are discarded
+/// </summary>
+/// <param name="workingThreadPackage* p_params - Worker thread's package"></param>
+/// <param name="communicationResults gameResult - the game's outcome, as beginGame(.) returned it"></param>
+static void endGameAndRoomSnapshot(workingThreadPackage* p_params, communicationResults gameResult);
 
 
 // Functions definitions -------------------------------------------------------
@@ -274,18 +361,22 @@ communicationResults WINAPI serverSideWorkerThreadRoutine(LPVOID lpParam)
 	//Parameters input conversion from void pointer to section struct pointer by explicit type casting
 	p_params = (workingThreadPackage*)lpParam;
 	
+	//Bind a bounded send queue to the Client's connection (freed when this thread exits). If it fails, the Client is served with blocking sends
+	attachSendQueue(*(p_params->p_s_acceptSocket), SEND_QUEUE_DEFAULT_POLICY);
 
+	//A Client handed off by the previous Server process (hot restart) was already admitted - it resumes where its Worker thread was parked
+	if (WORKER_NOT_PARKED != p_params->resumePoint) LOG_EVENT(LOG_EVENT_CONNECTION, "Handed off Client resumed", p_params->resumePoint, 0);
 	//Expect Connected Client's CLIENT_REQUEST message, and respond with either SERVER_DENIED, or SERVER_APPROVED followed by SERVER_MAIN_MENU
-	switch (decideIfNewlyConnectedClientIsThirdPlayerAndApproveOrDeclineConnection(p_params)) {
+	else switch (decideIfNewlyConnectedClientIsThirdPlayerAndApproveOrDeclineConnection(p_params)) {
 	
 	case COMMUNICATION_FAILED: /*CLOSING THREAD - CLIENT LEAVES*/
-		freeThePlayer(p_params);	 //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION);	 //Free the Worker thread players parameters
 		incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/);
 		SetEvent(*(p_params->p_h_errorEvent));  //reason: various fatal error may have occured
 		return COMMUNICATION_FAILED; break;
 
 	case COMMUNICATION_EXIT: /*CLOSING THREAD - CLIENT LEAVES*/
-		freeThePlayer(p_params);	//Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION);	//Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED;
 		return COMMUNICATION_EXIT; break;
 
@@ -295,13 +386,14 @@ communicationResults WINAPI serverSideWorkerThreadRoutine(LPVOID lpParam)
 		return GRACEFUL_DISCONNECT; break;
 
 	case COMMUNICATION_TIMEOUT: /*CLOSING THREAD - CLIENT LEAVES*/
-		printf("Reached timeout on CLIENT_REQUEST\n"); //Client name was not attained
+		LOG_EVENT(LOG_EVENT_TIMEOUT, "CLIENT_REQUEST receive", 0, 0); //Client name was not attained
+		recordWorkerPhaseTimeout(WORKER_PHASE_ADMISSION);
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED;
 		return COMMUNICATION_TIMEOUT; break;
 
 	case SERVER_DISCONNECTED: /*CLOSING THREAD - CLIENT LEAVES*/
-		printf("Client disconnected\n");
-		freeThePlayer(p_params);	//Free the Worker thread players parameters
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Client disconnected", SERVER_DISCONNECTED, 0);
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION);	//Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED;
 		return SERVER_DISCONNECTED; break;
 
@@ -309,6 +401,12 @@ communicationResults WINAPI serverSideWorkerThreadRoutine(LPVOID lpParam)
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED;
 		return SERVER_DENIED_COMM; break;
 
+	case CLIENT_REATTACHED: /*CLOSING THREAD - THE CLIENT GOES ON WITH THE WORKER THREAD THAT HOLDS ITS GAME*/
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Reconnected Client handed to the Worker thread that holds its game", CLIENT_REATTACHED, 0);
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION);	//Free the Worker thread players parameters
+		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED;
+		return CLIENT_REATTACHED; break;
+
 	default:// COMMUNICATION_SUCCEEDED: 
 		break; // Proceed...>>>>
 	}
@@ -323,47 +421,47 @@ communicationResults WINAPI serverSideWorkerThreadRoutine(LPVOID lpParam)
 	//Following the Client's User response, a GameSession.txt will be initialized (Created\Opened & fed with player's name) & 
 	switch (initiateMainMenuProcedure(p_params)) {
 	case COMMUNICATION_FAILED: 
-		freeThePlayer(p_params); //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION); //Free the Worker thread players parameters
 		incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/); //Thread Terminates
 		SetEvent(*(p_params->p_h_errorEvent));  //reason: various fatal error may have occured
-		printf("COMMUNICATION_FAILED\n");
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure COMMUNICATION_FAILED", COMMUNICATION_FAILED, 0);
 		return COMMUNICATION_FAILED; break;
 
 	case COMMUNICATION_EXIT: 
-		freeThePlayer(p_params); //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION); //Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED; //Thread Terminates
-		printf("COMMUNICATION_EXIT\n");
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure COMMUNICATION_EXIT", COMMUNICATION_EXIT, 0);
 		return COMMUNICATION_EXIT; break;
 
 	case COMMUNICATION_TIMEOUT:
-		freeThePlayer(p_params); //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION); //Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED; //Thread Terminates
-		printf("COMMUNICATION_TIMEOUT\n");
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure COMMUNICATION_TIMEOUT", COMMUNICATION_TIMEOUT, 0);
 		return COMMUNICATION_TIMEOUT; break;
 
 	case SERVER_DISCONNECTED: 
-		freeThePlayer(p_params); //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION); //Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED; //Thread Terminates
-		 printf("SERVER_DISCONNECTED\n"); 
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure SERVER_DISCONNECTED", SERVER_DISCONNECTED, 0);
 		 return SERVER_DISCONNECTED; break;
 
 	case PLAYER_DISCONNECTED: //Client messaged CLIENT_DISCONNECT
-		freeThePlayer(p_params); //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION); //Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED; //Thread Terminatesreturn 
-		printf("PLAYER_DISCONNECTED\n");
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure PLAYER_DISCONNECTED", PLAYER_DISCONNECTED, 0);
 		return PLAYER_DISCONNECTED; break;
 	
 	case GRACEFUL_DISCONNECT:
-		freeThePlayer(p_params); //Free the Worker thread players parameters
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION); //Free the Worker thread players parameters
 		if (-1 == incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, -1/*decrement*/)) return COMMUNICATION_FAILED; //Thread Terminatesreturn PLAYER_DISCONNECTED; break
-		printf("GRACEFUL_DISCONNECT\n");
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure GRACEFUL_DISCONNECT", GRACEFUL_DISCONNECT, 0);
 		return GRACEFUL_DISCONNECT;
 
 	default:// COMMUNICATION_SUCCEEDED: 
-		freeThePlayer(p_params);
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION);
 		//gracefulDisconnect()?
 		//Communication finished properly.....
-		printf("COMMUNICATION_SUCCEEDED\n");
+		LOG_EVENT(LOG_EVENT_COMMUNICATION_RESULT, "Main Menu procedure COMMUNICATION_SUCCEEDED", COMMUNICATION_SUCCEEDED, 0);
 		return COMMUNICATION_SUCCEEDED;
 	}
 
@@ -397,8 +495,7 @@ static int incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(workingThre
 		gracefulDisconnect(p_params->p_s_acceptSocket); // no need to check return code, because general operation failed
 		//Set 'ERROR' event due to error that just occured HERE!
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mutex ownership\release failed
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 		}
 		return -1; break; // not communication timeout
@@ -419,16 +516,14 @@ static BOOL validateErrorExitEventsStatusInWorkerThread(HANDLE* p_h_errorEvent,
 		case WAIT_TIMEOUT: return KEEP_GOING; break; //proceed... to KEEP_GOING
 
 		case WAIT_OBJECT_0:
-			printf("'EXIT' event indicates an 'exit' had been entered via STDin...\nThread no. %ld exiting...\n", GetCurrentThreadId());  //'DELETE' DEBUG MESSAGE
+			LOG_EVENT(LOG_EVENT_THREAD_EXIT, "'EXIT' event indicates an 'exit' had been entered via STDin", 0, 0);
 			return STATUS_SERVER_EXIT; break;
 
 		default:
-			printf("Error: Failed to sample Server-side 'EXIT' Event's status using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to sample Server-side 'EXIT' Event's status using WaitForSingleObject(.)", GetLastError(), 0);
 			//Signal 'Error' Event....
 			if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*p_h_errorEvent)) {  //Error event was probably already set 'FUNC'
-				printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-				printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+				LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			}
 
 			return STATUS_SERVER_ERROR;
@@ -438,16 +533,14 @@ static BOOL validateErrorExitEventsStatusInWorkerThread(HANDLE* p_h_errorEvent,
 
 	case WAIT_OBJECT_0:
 		//"Error" Event was signaled by an error that occured in the Server 
-		printf("'ERROR' event indicates an error has occured...\nThread no. %ld exiting...\n", GetCurrentThreadId());  //'DELETE' DEBUG MESSAGE
+		LOG_EVENT(LOG_EVENT_THREAD_EXIT, "'ERROR' event indicates an error has occured", 0, 0);
 		return STATUS_SERVER_ERROR; break;
 
 	default:
-		printf("Error: Failed to sample Server-side 'ERROR' Event's status using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to sample Server-side 'ERROR' Event's status using WaitForSingleObject(.)", GetLastError(), 0);
 		//Signal 'Error' Event....
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*p_h_errorEvent)) {  //Error event was probably already set
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 		}
 
@@ -474,25 +567,33 @@ static communicationResults decideIfNewlyConnectedClientIsThirdPlayerAndApproveO
 		switch (p_receivedMessageFromClient->messageType) {
 		case CLIENT_REQUEST_NUM:
 			//Copy the newly connected peer's name..
-			if (COPY_OPPONENT_NAME_FAILED == copyPlayerNameOrFourDigitNumberString(p_receivedMessageFromClient, &p_params->p_selfPlayerName)) {
+			if (COPY_OPPONENT_NAME_FAILED == copyPlayerNameOrFourDigitNumberString(p_receivedMessageFromClient, &p_params->p_selfPlayerName,
+				p_params->playerNamesStorage.selfPlayerName, sizeof(p_params->playerNamesStorage.selfPlayerName))) {
 				freeTheMessage(p_receivedMessageFromClient);
 				if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mem alloc failed
-					printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-					printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+					LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 					//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 				}
 				//Notify Client Speaker thread, that his connection, a Worker thread, disconnects due to faulty
 				gracefulDisconnect(p_params->p_s_acceptSocket);
 				return COMMUNICATION_FAILED;
 			}
+			//A Client that presents a session token may be reconnecting to a game its Worker thread holds - the connection is handed over
+			// (its send queue is left behind) & this Worker thread leaves without closing it
+			if ((NULL != p_receivedMessageFromClient->p_parameters->p_nextParameter) &&
+				(STATUS_CODE_SUCCESS == reattachSession(p_receivedMessageFromClient->p_parameters->p_nextParameter->p_parameter, p_params->p_selfPlayerName, p_params->p_s_acceptSocket))) {
+				freeTheMessage(p_receivedMessageFromClient);
+				detachSendQueue();
+				p_params->p_s_acceptSocket = NULL;
+				return CLIENT_REATTACHED;
+			}
 			//Free the received message arranged in a 'message' struct
 			freeTheMessage(p_receivedMessageFromClient);
 			//Continue... >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 			break;
 
 		default: //Received a wrong message /* no other message is expected from the Server at this point */
-			printf("Recived an unexpected message. Exiting\n");
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_UNEXPECTED, "Recived an unexpected message. Exiting", p_receivedMessageFromClient->messageType, 0);
 			freeTheMessage(p_receivedMessageFromClient);
 			gracefulDisconnect(p_params->p_s_acceptSocket); //'CHECK TIMEOUT CASE'
 			return COMMUNICATION_FAILED; break;
@@ -529,12 +630,13 @@ static communicationResults decideIfNewlyConnectedClientIsThirdPlayerAndApproveO
 	//Answer to the Client (its Speaker thread) by sending back SERVER_APPROVED or SERVER_DENIED
 	switch (responseToClientRequestMessage(p_params)) {
 	case SERVER_DENIED_COMM: //Sent ^ SERVER_DENIED ^ 
-		printf("Declining Client speaking with Server Worker thread no. %ld\n", GetCurrentThreadId()); //'DELETE' DEBUG MESSAGE
-		free(p_params->p_selfPlayerName);
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Declining Client speaking with Server Worker thread", SERVER_DENIED_COMM, 0);
+		recordAdmissionDenial();
+		resetThePlayer(p_params, PLAYER_RESET_CONNECTION);
 		return SERVER_DENIED_COMM; break;
 
 	case COMMUNICATION_SUCCEEDED: //Sent ^ SERVER_APPROVED ^  &  ^ SERVER_MAIN_MENU ^
-		printf("Client speaking with Server Worker thread no. %ld is APPROVED by SERVER into (Game Room) Main Menu\n", GetCurrentThreadId()); //'DELETE' DEBUG MESSAGE
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Client speaking with Server Worker thread is APPROVED by SERVER into (Game Room) Main Menu", COMMUNICATION_SUCCEEDED, 0);
 		break; //Proceed.........>>>>
 
 	case SERVER_DISCONNECTED:
@@ -542,7 +644,7 @@ static communicationResults decideIfNewlyConnectedClientIsThirdPlayerAndApproveO
 		break;
 
 	default: //COMMUNICATION_FAILED
-		printf("Error has occured at thread no. %ld   decideIfNewlyConnectedClientIsThirdPlayerAndApproveOrDeclineConnection\n", GetCurrentThreadId());
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to respond to the Client's CLIENT_REQUEST", 0, 0);
 		return COMMUNICATION_FAILED; break;
 	}
 
@@ -569,6 +671,8 @@ static communicationResults responseToClientRequestMessage(workingThreadPackage*
 {
 	USHORT extractValueOfNumberOfCurrentlyConnectedClients = 0;
 	communicationResults sendRes = 0;
+	char sessionTokenString[SESSION_TOKEN_STRING_LEN];
+	BOOL isSessionOpen = FALSE;
 	//Assert
 	assert(NULL != p_params);
 
@@ -601,12 +705,13 @@ static communicationResults responseToClientRequestMessage(workingThreadPackage*
 		// number is either 1 or 2 (Only the Server main thread will see the value 0). These set of values mean that 
 		//	the current Client is either the first or second of two players, which means it is possible to continue the communication....
 		
-		//Send $$$ ^ SERVER_APPROVED ^ $$$ 
-		
+		//Send $$$ ^ SERVER_APPROVED ^ $$$  with a new session token - the Client reconnects with it if its connection drops in the middle of a game
+		isSessionOpen = openSession(p_params, sessionTokenString);
 		if ((communicationResults)TRANSFER_SUCCEEDED == (sendRes = sendMessageServerSide(
 			p_params->p_s_acceptSocket,					/* Client Socket */
 			SERVER_APPROVED_NUM,						/* Send SERVER_APPROVED */
-			NULL, NULL, NULL, NULL))) {					/* no parameters */
+			isSessionOpen ? sessionTokenString : NULL,	/* the session token (none if the session could not be opened) */
+			NULL, NULL, NULL))) {						/* no parameters : 2,3,4 */
 			//Continue...>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 			return COMMUNICATION_SUCCEEDED;
 		}
@@ -627,16 +732,46 @@ static communicationResults initiateMainMenuProcedure(workingThreadPackage* p_pa
 	message* p_receivedMessageFromClient = NULL;
 	communicationResults commRes = 0, sendRes = 0;
 	int currentlyConnectedClientsNumberDecrementationRes = 0;
+	gameHistory history;
+	char numOfGamesBuffer[12], numOfWinsBuffer[12], numOfDrawsBuffer[12];
+	char lastGamesBuffer[GAME_HISTORY_MENU_GAMES * (MAX_PLAYER_NAME_LEN + 5) + 1];
+	const char outcomeLetters[] = { 'L', 'D', 'W' }; /* by 'ratingOutcomes' */
+	BOOL hasHistory = FALSE;
+	int g = 0, lastGamesLength = 0, writtenLength = 0;
 	//Assert
 	assert(NULL != p_params);
 
+	//A game handed off by the previous Server process (hot restart) goes on first - then the Client is back at the main menu, as after any game
+	if (WORKER_PARKED_SETUP <= p_params->resumePoint) {
+		endGameAndRoomSnapshot(p_params, commRes = beginGame(p_params));
+		switch (commRes) {
+		case BACK_TO_MENU: case PLAYER_DISCONNECTED: break;
+		default: return commRes;
+		}
+	}
 
 	while (TRUE) {
-		//Send    $$$ ^ SERVER_MAIN_MENU ^ $$$
-		if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageServerSide(
+		//The player's history, read from the game history index (GameHistoryIndexTools.c) - a player with no game gets the main menu with no parameters
+		if ((WORKER_PARKED_MAIN_MENU != p_params->resumePoint) &&
+			(TRUE == (hasHistory = fetchPlayerGameHistory(p_params->p_selfPlayerName, GAME_HISTORY_MENU_GAMES, &history)))) {
+			_snprintf_s(numOfGamesBuffer, sizeof(numOfGamesBuffer), _TRUNCATE, "%ld", history.numOfGames);
+			_snprintf_s(numOfWinsBuffer, sizeof(numOfWinsBuffer), _TRUNCATE, "%ld", history.numOfWins);
+			_snprintf_s(numOfDrawsBuffer, sizeof(numOfDrawsBuffer), _TRUNCATE, "%ld", history.numOfDraws);
+			//Latest games first, e.g. "W Bob, L Alice"
+			for (g = 0, lastGamesLength = 0, lastGamesBuffer[0] = '\0'; g < history.numOfLastGames; g++, lastGamesLength += writtenLength)
+				if (0 > (writtenLength = _snprintf_s(lastGamesBuffer + lastGamesLength, sizeof(lastGamesBuffer) - lastGamesLength, _TRUNCATE, "%s%c %s",
+					(0 == g) ? "" : ", ", outcomeLetters[history.lastGames[g].outcome], history.lastGames[g].opponentName))) break; //Truncated
+		}
+
+		//Send    $$$ ^ SERVER_MAIN_MENU ^ $$$  (a Client handed off at the main menu already has it)
+		if (WORKER_PARKED_MAIN_MENU == p_params->resumePoint) p_params->resumePoint = WORKER_NOT_PARKED;
+		else if ((communicationResults)TRANSFER_SUCCEEDED != (sendRes = sendMessageServerSide(
 			p_params->p_s_acceptSocket,					/* Client Socket */
 			SERVER_MAIN_MENU_NUM,						/* Send SERVER_MAIN_MENU */
-			NULL, NULL, NULL, NULL))) {					/* no parameters */
+			(hasHistory) ? numOfGamesBuffer : NULL,		/* player's history if any - # of games, wins & draws */
+			(hasHistory) ? numOfWinsBuffer : NULL,
+			(hasHistory) ? numOfDrawsBuffer : NULL,
+			(hasHistory) ? lastGamesBuffer : NULL))) {	/* and its latest games */
 			
 			// send   SERVER_MAIN_MENU  may or may not fail -> returning the send result....
 			return sendRes;  //DON'T SET 'ERROR' EVENT!!!
@@ -686,11 +821,15 @@ static communicationResults initiateMainMenuProcedure(workingThreadPackage* p_pa
 			break;
 		}
 		//printf("My Name:   %s ,, Other Name:    %s\n", p_params->p_selfPlayerName, p_params->p_otherPlayerName); //'DELETE'
-		//Set of the global variable of "Quit if one player left abruptly in the middle of the game"
-		g_serverOpponentQuitBit = 0;
+		//Both players hold the epoch of the Game Room opened for this game, so quit flags of previous games are ignored
+		joinGameRoomCurrentEpoch(p_params);
+		journalGamePairing(p_params);
+		//Players paired again after the previous Server process ended mid-game resume it (RoomSnapshotTools.c) - each keeps its initial number
+		resumeRecoveredGame(p_params);
 
 		//Proceed to GAME!
-		switch(beginGame(p_params)){
+		endGameAndRoomSnapshot(p_params, commRes = beginGame(p_params));
+		switch(commRes){
 		case BACK_TO_MENU:			    continue; break;
 		case PLAYER_DISCONNECTED:	    continue; break; //For both  BACK_TO_MENU & PLAYER_DISCONNECTED  it is okay to resume connection with the Server. The User will choose the next step....
 		case SERVER_DISCONNECTED:	 	return SERVER_DISCONNECTED; break;
@@ -720,8 +859,18 @@ static communicationResults mainMenuClientResponses(workingThreadPackage* p_para
 
 	//Receive either _CLIENT_VERSUS_  or  _CLIENT_DISCONNECT_
 
-	//Since Server's main menu demands the decision of the Client's User, then it is allowed to wait for a long time(10min)
-	tranRes = receiveMessage(p_params->p_s_acceptSocket, &p_receivedMessageFromClient, LONG_SERVER_RESPONSE_WAITING_TIMEOUT);
+	//Since Server's main menu demands the decision of the Client's User, then it is allowed to wait for a long time(10min) - parked meanwhile if a hot restart is requested
+	while (TRUE) {
+		tranRes = receiveClientMessageOrParkForHandoff(p_params, &p_receivedMessageFromClient, WORKER_PARKED_MAIN_MENU);
+		//A Client that answered CLIENT_SETUP\CLIENT_PLAYER_MOVE before learning that its opponent quit, still sends that answer - discard it
+		if ((TRANSFER_SUCCEEDED == tranRes) &&
+			((CLIENT_SETUP_NUM == p_receivedMessageFromClient->messageType) || (CLIENT_PLAYER_MOVE_NUM == p_receivedMessageFromClient->messageType))) {
+			freeTheMessage(p_receivedMessageFromClient);
+			p_receivedMessageFromClient = NULL;
+			continue;
+		}
+		break;
+	}
 	if (TRANSFER_SUCCEEDED == tranRes) //Validate the receive operation result...
 		switch (p_receivedMessageFromClient->messageType) {
 		case CLIENT_VERSUS_NUM:
@@ -739,8 +888,7 @@ static communicationResults mainMenuClientResponses(workingThreadPackage* p_para
 			break;
 
 		default: //Received a wrong message /* no other message is expected from the Server at this point */
-			printf("Recived an unexpected message. Exiting\n");
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+			LOG_EVENT(LOG_EVENT_UNEXPECTED, "Recived an unexpected message. Exiting", p_receivedMessageFromClient->messageType, 0);
 			//Free the massage received
 			freeTheMessage(p_receivedMessageFromClient);
 			gracefulDisconnect(p_params->p_s_acceptSocket); //'CHECK TIMEOUT CASE'
@@ -749,6 +897,7 @@ static communicationResults mainMenuClientResponses(workingThreadPackage* p_para
 	else {
 		// The communication between the Server Worker thread & the Client Speaker thread failed during recv(.) function, 
 		//   and transRes contains the reason which is also the thread's exit code IN THIS CASE
+		if (TRANSFER_TIMEOUT == tranRes) recordWorkerPhaseTimeout(WORKER_PHASE_MAIN_MENU);
 		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_acceptSocket)) return COMMUNICATION_FAILED;
 		return (communicationResults)tranRes;
 	}
@@ -763,18 +912,19 @@ static communicationResults validateThereAreTwoPlayersInGameRoomAndSynchronizeTh
 {
 	int currentlyConnectedClientsNumber = 0;// , firstPlayerBit = 0;//If the firstPlayerBit becomes 1, then this thread is the "First Player" of a couple
 	transferResults sendRes = 0;
+	BOOL isBot = FALSE;
 	//Assert
 	assert(NULL != p_params);
 
-	//Fetch the number of currently connected Clients
+	//Fetch the number of currently connected Clients - the Server's bot may be summoned only while a Worker thread is free for it
 	currentlyConnectedClientsNumber = incrementDecrementNumOfCurrConnClientsAndHandleErrorEvent(p_params, 0/*fetch value*/);
+	if (-1 == currentlyConnectedClientsNumber) return COMMUNICATION_FAILED; // not communication timeout
+	isBot = (0 == strcmp(p_params->p_selfPlayerName, MATCHMAKING_BOT_NAME));
 
-		//Validate the return value of the resource value retrival operation...
-	switch (currentlyConnectedClientsNumber) {
-	case -1:
-		return COMMUNICATION_FAILED; break; // not communication timeout
-
-	case 1: // ONLY one player(User\Client) is connected to the Server...
+	//Pair with a waiting player of a close rating, or wait in the matchmaking queue to be paired
+	switch (findOpponent(fetchPlayerRating(p_params->p_selfPlayerName), isBot, (NUM_OF_WORKER_THREADS > currentlyConnectedClientsNumber) && (FALSE == isBot),
+		p_params->p_h_exitEvent, p_params->p_h_errorEvent)) {
+	case MATCHMAKING_NO_OPPONENT: // Nobody arrived in time...
 		//Send   ^ SERVER_NO_OPPONENTS ^
 		sendRes = (transferResults)sendMessageServerSide(
 			p_params->p_s_acceptSocket,					/* Client Socket */
@@ -788,13 +938,17 @@ static communicationResults validateThereAreTwoPlayersInGameRoomAndSynchronizeTh
 			return (communicationResults)sendRes; //Will send either COMMUNICATION_FAILED if sending operation failed(mem alloc.) or SERVER_DISCONNECTED if the Client abruptly disconnected
 		break;
 
-	case 2: // ONLY one player(User\Client) is connected to the Server...
+	case MATCHMAKING_MATCHED_PLAYER:
+	case MATCHMAKING_MATCHED_BOT: // The opponent is matched & heads to the Game Room as well...
 		//BEGIN SYNCHRONIZING PROCEDURE...>>>>
 		break;
 
-	default: /*ignored*/
-		printf("Default: not supposed to reach here.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+	case MATCHMAKING_ABORTED: //'EXIT'\'ERROR' events were signaled while waiting
+		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_acceptSocket)) return COMMUNICATION_FAILED;
+		return COMMUNICATION_EXIT;
+
+	default: /*MATCHMAKING_FAILED*/
+		LOG_EVENT(LOG_EVENT_FAILURE, "Matchmaking failed", 0, 0);
 		gracefulDisconnect(p_params->p_s_acceptSocket);//'CHECK' player name is free above?
 		return COMMUNICATION_FAILED; 
 	}
@@ -840,17 +994,16 @@ static BOOL setPlayerEventToSignaled(HANDLE* p_h_playerEvent, workingThreadPacka
 	assert(NULL != p_h_playerEvent);
 	assert(NULL != p_params);
 	assert((1 == playerId) || (0 == playerId));
-	printf("\nsignal back player no %d - 1 is first\n",playerId);
+	LOG_EVENT(LOG_EVENT_TRACE, "Signal back player (1 is first)", playerId, 0);
 	//Set the "Player" Event to singled state
 	if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*p_h_playerEvent)) {
-		if (1 == playerId) printf("Error: Failed to set 'First Player' event to signaled state after 'Second Player' was late to arrive, with error code no. %ld - fatal error.\nExiting..\n\n", GetLastError());
-		else  printf("Error: Failed to set 'Second Player' event to signaled state, with error code no. %ld - fatal error.\nExiting..\n\n", GetLastError());
+		if (1 == playerId) LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'First Player' event to signaled state after 'Second Player' was late to arrive - fatal error", GetLastError(), 0);
+		else  LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'Second Player' event to signaled state - fatal error", GetLastError(), 0);
 		//Signal 'Error' Event....
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: SetEvent function failed
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 		}
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
 		//Notify Client Speaker thread, that his connection, a Worker thread, disconnects due to faulty
 		gracefulDisconnect(p_params->p_s_acceptSocket);
 		return STATUS_CODE_FAILURE;
@@ -862,17 +1015,36 @@ static BOOL setPlayerEventToSignaled(HANDLE* p_h_playerEvent, workingThreadPacka
 static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient(workingThreadPackage* p_params, int dataType, int clientAbsencyMessageType)
 {
 	communicationResults stepsRes = 0;
+	HANDLE h_secondPlayerOrQuitEvents[3] = { NULL, NULL, NULL };
+	LONGLONG waitStartTicks = 0;
+	DWORD waitCode = 0, numOfAwaitedEvents = 0;
 	//Assert
 	assert(NULL != p_params);
 	//assert(NULL != p_firstPlayerBitAddress);
 
+	//The first arriver awaits the "2nd Player" Event, and during a game, also the Game Room quit Event (the room is opened only at the names exchange - dataType 1)
+	h_secondPlayerOrQuitEvents[0] = *(p_params->p_h_secondPlayerEvent);
+	h_secondPlayerOrQuitEvents[1] = *(p_params->p_gameRoom->p_h_roomQuitEvent);
+	//In the middle of an exchange, the first arriver may also be parked for a hot restart
+	h_secondPlayerOrQuitEvents[2] = *(p_params->p_h_handoffEvent);
+	numOfAwaitedEvents = (1 == dataType) ? SINGLE_OBJECT : 3;
+
 	//Sample the First Player event..
 	switch (WaitForSingleObject(*(p_params->p_h_firstPlayerEvent), SAMPLE)) {
 	case WAIT_OBJECT_0: // This thread is the First arriving player & SECOND to access the "GameSession.txt" file..
 		//THIS THREAD, meaning, This Server Worker thread associated with a connected Client, IS THE FIRST PLAYER  while there are two
 		//	players connected to the Server...    Wait for a LONG time, until the second player agrees to play as well at any stage of the communication
-		switch (WaitForSingleObject(*(p_params->p_h_secondPlayerEvent), LONG_SERVER_RESPONSE_WAITING_TIMEOUT)) {
+		waitStartTicks = readMetricsClock();
+		while (WAIT_OBJECT_0 + 2 == (waitCode = WaitForMultipleObjects(numOfAwaitedEvents, h_secondPlayerOrQuitEvents, FALSE, LONG_SERVER_RESPONSE_WAITING_TIMEOUT)))
+			//Parked until the restart is cancelled (this thread then awaits its opponent again), or the Server exits (stop awaiting the restart)
+			if (STATUS_CODE_FAILURE == parkWorkerForHandoff(p_params, (2 == dataType) ? WORKER_PARKED_SETUP_EXCHANGE : WORKER_PARKED_MOVE_EXCHANGE))
+				numOfAwaitedEvents = 2;
+		//Metrics - the opponent's arrival (or quit) ended the wait
+		if ((WAIT_OBJECT_0 == waitCode) || (WAIT_OBJECT_0 + 1 == waitCode)) recordOpponentWait(WORKER_PHASE_OF_DATA_TYPE(dataType), waitStartTicks);
+		switch (waitCode) {
 		case WAIT_OBJECT_0:
+			//The SECOND ARRIVER of the names exchange opens the Game Room, so this thread takes the other slot
+			if (1 == dataType) p_params->gameRoomSlot = GAME_ROOM_JOINER_SLOT;
 			stepsRes = stepsStyleAccessingGameSessionFile(
 				p_params,								/*thread inputs package*/
 				dataType,								/*names transfer is the first operation, initial number is the second... dictated by data type*/
@@ -883,17 +1055,25 @@ static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient
 
 						
 			if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_firstPlayerEvent))) {
-				printf("Error: Failed to set '1st Player' event to signaled state for following file accesses, with error code no. %ld.\nExiting..\n\n", GetLastError());
+				LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set '1st Player' event to signaled state for following file accesses", GetLastError(), 0);
 				stepsRes = COMMUNICATION_FAILED;
 			}
 			//SIGNAL the "1st Player" Event the SECOND time to free the AGAIN the other player....^	
+			//The opponent quit while this thread was stuck on a players Event
+			if (PLAYER_DISCONNECTED == stepsRes) return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
 			return stepsRes;  break; //Steps (Triple -'WRITE' 'READ&WRITE' 'READ') access completed Continue>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>	1st arriver	
+
+		case WAIT_OBJECT_0 + 1: //The Game Room quit Event - the opponent quit the game while this thread awaited it
+			return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
 		
 		case WAIT_TIMEOUT: // Second Player, who is assumed to be connected, took too long time to decide to play (CLIENT_VERSUS  arrived after too long or didn't arrive)
+			recordWorkerPhaseTimeout(WORKER_PHASE_OF_DATA_TYPE(dataType));
+			//During a game, the opponent took too long to respond - leave the Game Room, so the opponent is notified as well
+			if (1 != dataType) return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
 			//Send   ^ SERVER_NO_OPPONENTS ^
 			if (TRANSFER_SUCCEEDED == sendMessageServerSide(
 				p_params->p_s_acceptSocket,					/* Client Socket */
-				clientAbsencyMessageType,					/* was SERVER_NO_OPPONENTS. can also be SERVER_OPPONENT_QUIT */
+				clientAbsencyMessageType,					/* SERVER_NO_OPPONENTS */
 				NULL, NULL, NULL, NULL)) {					/* no parameters */
 				//Set the "First Player" Event for players synchronoization attempt
 				if (STATUS_CODE_FAILURE == setPlayerEventToSignaled(p_params->p_h_firstPlayerEvent, p_params, 1)) return COMMUNICATION_FAILED;
@@ -905,13 +1085,12 @@ static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient
 			}
 		
 		default: // WaitForSingleObject(.) failed..
-			printf("Error: Failed to wait on the Second Player 'door' - Event - using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait on the Second Player 'door' - Event - using WaitForSingleObject(.)", GetLastError(), 0);
 			//Signal 'Error' Event....
 			if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mutex ownership\release failed
-				printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
+				LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 				//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 			}
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
 			return COMMUNICATION_FAILED; break; // not communication timeout
 		}
 		break;
@@ -919,6 +1098,9 @@ static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient
 	case WAIT_TIMEOUT: // This thread is the Second arriving Player, who will be the FIRST TO ACCESS GameSessio.txt and write to it !!!
 		//THIS THREAD, meaning, This Server Worker thread associated with a connected Client, IS THE SECOND PLAYER  while there are two
 		//	players connected to the Server...   
+
+		//The SECOND ARRIVER of the names exchange opens the Game Room for the new game, while the FIRST ARRIVER is stuck on the "2nd Player" Event
+		if ((1 == dataType) && (STATUS_CODE_FAILURE == openGameRoomForNewGame(p_params))) return COMMUNICATION_FAILED;
 		
 		stepsRes = stepsStyleAccessingGameSessionFile(
 			p_params,								/*thread inputs package*/
@@ -943,19 +1125,20 @@ static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient
 		//Also Set "1st Player" event for FOLLOWING "GameSessions.txt" synchronous accesses (becuase this event is reset(turns non-signaled) THREE TIMES,
 		//	once by the first arriver, then by the second arriver, then by the second arriver, and the first arriver sets it ONLY TWICE)!!!!
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_firstPlayerEvent))) {
-			printf("Error: Failed to set '1st Player' event to signaled state for following file accesses, with error code no. %ld.\nExiting..\n\n", GetLastError());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set '1st Player' event to signaled state for following file accesses", GetLastError(), 0);
 			stepsRes = COMMUNICATION_FAILED;
 		}
+		//The opponent quit while this thread was stuck on a players Event
+		if (PLAYER_DISCONNECTED == stepsRes) return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
 		return stepsRes; break;  //Steps (Triple -'WRITE' 'READ&WRITE' 'READ') access completed Continue>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>	2nd arriver																	
 	
 	default:
-		printf("Error: Failed to enter(wait) on the First Player 'door' - Event - using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to enter(wait) on the First Player 'door' - Event - using WaitForSingleObject(.)", GetLastError(), 0);
 		//Signal 'Error' Event....
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mutex ownership\release failed
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 		}
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
 		return COMMUNICATION_FAILED; break; // not communication timeout
 	}
 }
@@ -963,6 +1146,9 @@ static communicationResults awaitBothPlayersByMarkingFirstClientThenSecondClient
 static communicationResults stepsStyleAccessingGameSessionFile(workingThreadPackage* p_params, int dataTypeBit, int firstPlayerBit, int writeBit, HANDLE* p_h_stuckEvent, HANDLE* p_h_releaseEvent)
 {
 	communicationResults res = COMMUNICATION_SUCCEEDED;
+	HANDLE h_stuckOrQuitEvents[2] = { NULL, NULL };
+	LONGLONG waitStartTicks = 0;
+	DWORD waitCode = 0;
 	//Assert
 	assert(NULL != p_params);
 	assert((1 == dataTypeBit) || (2 == dataTypeBit) || (3 == dataTypeBit));
@@ -994,20 +1180,19 @@ static communicationResults stepsStyleAccessingGameSessionFile(workingThreadPack
 					res = COMMUNICATION_FAILED; break;
 
 				default: /*ignored*/ 
-					printf("Default: not supposed to reach here.\n");
-					printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+					LOG_EVENT(LOG_EVENT_UNEXPECTED, "Default: not supposed to reach here", 0, 0);
 					gracefulDisconnect(p_params->p_s_acceptSocket);//'CHECK' player name is free above?
 					res = COMMUNICATION_FAILED; break;
 				}
 			else //(0==writeBit)
 				switch (dataTypeBit) {
-				case 1:if (NULL == (p_params->p_otherPlayerName = firstToReachTheFileReadWrapper(p_params)))
+				case 1:if (NULL == (p_params->p_otherPlayerName = firstToReachTheFileReadWrapper(p_params, p_params->playerNamesStorage.otherPlayerName, sizeof(p_params->playerNamesStorage.otherPlayerName))))
 					res = COMMUNICATION_FAILED; break;
 
-				case 2: if (NULL == (p_params->p_otherInitialNumber = firstToReachTheFileReadWrapper(p_params)))
+				case 2: if (NULL == (p_params->p_otherInitialNumber = firstToReachTheFileReadWrapper(p_params, p_params->playerNumbersStorage.otherInitialNumber, sizeof(p_params->playerNumbersStorage.otherInitialNumber))))
 					res = COMMUNICATION_FAILED; break;
 
-				case 3: if (NULL == (p_params->p_otherCurrentGuess = firstToReachTheFileReadWrapper(p_params)))
+				case 3: if (NULL == (p_params->p_otherCurrentGuess = firstToReachTheFileReadWrapper(p_params, p_params->playerNumbersStorage.otherCurrentGuess, sizeof(p_params->playerNumbersStorage.otherCurrentGuess))))
 					res = COMMUNICATION_FAILED; break;
 
 				default: /*ignored*/ res = COMMUNICATION_FAILED; break;
@@ -1016,53 +1201,96 @@ static communicationResults stepsStyleAccessingGameSessionFile(workingThreadPack
 		else {//(0 == firstPlayerBit)
 			//printf("\n7\n\n");
 			switch (dataTypeBit) {
-			case 1:if (NULL == (p_params->p_otherPlayerName = secondToReachTheFileReadThenWriteWrapper(p_params, p_params->p_selfPlayerName)))
+			case 1:if (NULL == (p_params->p_otherPlayerName = secondToReachTheFileReadThenWriteWrapper(p_params, p_params->p_selfPlayerName,
+				p_params->playerNamesStorage.otherPlayerName, sizeof(p_params->playerNamesStorage.otherPlayerName))))
 				res = COMMUNICATION_FAILED; break;
 
-			case 2:if (NULL == (p_params->p_otherInitialNumber = secondToReachTheFileReadThenWriteWrapper(p_params, p_params->p_selfInitialNumber)))
+			case 2:if (NULL == (p_params->p_otherInitialNumber = secondToReachTheFileReadThenWriteWrapper(p_params, p_params->p_selfInitialNumber,
+				p_params->playerNumbersStorage.otherInitialNumber, sizeof(p_params->playerNumbersStorage.otherInitialNumber))))
 				res = COMMUNICATION_FAILED; break;
 
-			case 3:if (NULL == (p_params->p_otherCurrentGuess = secondToReachTheFileReadThenWriteWrapper(p_params, p_params->p_selfCurrentGuess)))
+			case 3:if (NULL == (p_params->p_otherCurrentGuess = secondToReachTheFileReadThenWriteWrapper(p_params, p_params->p_selfCurrentGuess,
+				p_params->playerNumbersStorage.otherCurrentGuess, sizeof(p_params->playerNumbersStorage.otherCurrentGuess))))
 				res = COMMUNICATION_FAILED; break;
 
 			default: /*ignored*/
-				printf("Default: not supposed to reach here (players mmixed up).\n");
-				printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+				LOG_EVENT(LOG_EVENT_UNEXPECTED, "Default: not supposed to reach here (players mmixed up)", 0, 0);
 				gracefulDisconnect(p_params->p_s_acceptSocket);//'CHECK' player name is free above?
 				res = COMMUNICATION_FAILED; break;
 			}
 		}
 		break;
 	default:
-		printf("Default: not supposed to reach here (Events mixed up).\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		LOG_EVENT(LOG_EVENT_UNEXPECTED, "Default: not supposed to reach here (Events mixed up)", 0, 0);
 		gracefulDisconnect(p_params->p_s_acceptSocket);//'CHECK' player name is free above?
 		res = COMMUNICATION_FAILED; break;
 	}
 	//Set "Release" event 
 	if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*p_h_releaseEvent)) {  
-		printf("Error: Failed to set event to signaled state for other player, with error code no. %ld.\nExiting..\n\n", GetLastError());
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set event to signaled state for other player", GetLastError(), 0);
 		res = COMMUNICATION_FAILED;
 	}
-	//Get stucked on the "Stuck" event
-	switch (WaitForSingleObject(*p_h_stuckEvent, LONG_SERVER_RESPONSE_WAITING_TIMEOUT)) {
+	//Get stucked on the "Stuck" event. During a game, also on the Game Room quit Event, so an opponent's quit releases this thread immediately
+	h_stuckOrQuitEvents[0] = *p_h_stuckEvent;
+	h_stuckOrQuitEvents[1] = *(p_params->p_gameRoom->p_h_roomQuitEvent);
+	waitStartTicks = readMetricsClock();
+	waitCode = WaitForMultipleObjects((1 == dataTypeBit) ? SINGLE_OBJECT : 2, h_stuckOrQuitEvents, FALSE, LONG_SERVER_RESPONSE_WAITING_TIMEOUT);
+	//Metrics - the opponent's file access (or quit) ended the wait
+	if ((WAIT_OBJECT_0 == waitCode) || (WAIT_OBJECT_0 + 1 == waitCode)) recordOpponentWait(WORKER_PHASE_OF_DATA_TYPE(dataTypeBit), waitStartTicks);
+	switch (waitCode) {
 	case WAIT_OBJECT_0: break; //Proceed >>>>>>>
+	case WAIT_OBJECT_0 + 1: //The opponent quit - the caller notifies the Client
+		if (COMMUNICATION_SUCCEEDED == res) res = PLAYER_DISCONNECTED;
+		break;
 	case WAIT_TIMEOUT:
+		recordWorkerPhaseTimeout(WORKER_PHASE_OF_DATA_TYPE(dataTypeBit));
+		//fall through
 	default:
-		if(1 == firstPlayerBit) printf("Error: Failed to enter(wait) on the 1st Player Event - using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
-		else printf("Error: Failed to enter(wait) on the 2nd Player Event - using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
+		if(1 == firstPlayerBit) LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to enter(wait) on the 1st Player Event - using WaitForSingleObject(.)", GetLastError(), 0);
+		else LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to enter(wait) on the 2nd Player Event - using WaitForSingleObject(.)", GetLastError(), 0);
 		//Signal 'Error' Event....
 		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mutex ownership\release failed
-			printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
 			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
 		}
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Worker thread no. %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
 		res = COMMUNICATION_FAILED; break; // not communication timeou
 	}
 	//>>>>>>>>>>>>> Return operation result
 	return res;
 }
 
+static communicationResults notifyClientOpponentQuitAndLeaveGameRoom(workingThreadPackage* p_params)
+{
+	transferResults sendRes = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	//Send   ^ SERVER_OPPONENT_QUIT ^
+	sendRes = sendMessageServerSide(
+		p_params->p_s_acceptSocket,					/* Client Socket */
+		SERVER_OPPONENT_QUIT_NUM,					/* Send SERVER_OPPONENT_QUIT  */
+		NULL, NULL, NULL, NULL);					/* no parameters  */
+
+	//Leave the Game Room. If the opponent already left, this thread is the last one, and it restores the players Events for the next couple
+	if (STATUS_CODE_FAILURE == raiseQuitFlagInGameRoomAndWakeOpponent(p_params)) {
+		gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
+		return COMMUNICATION_FAILED;
+	}
+
+	if (TRANSFER_PREVENTED == sendRes) {
+		//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
+		gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
+		return COMMUNICATION_FAILED;
+	}
+	else if (TRANSFER_FAILED == sendRes) {
+		//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
+		return SERVER_DISCONNECTED;
+	}
+
+	//The Client returns to Server's main menu
+	return PLAYER_DISCONNECTED;
+}
+
 
 
 
@@ -1088,6 +1316,9 @@ static communicationResults beginGame(workingThreadPackage* p_params)
 	//Assert
 	assert(NULL != p_params);
 
+	//A game handed off by the previous Server process (hot restart) mid-round skips straight to the guessing rounds
+	if (WORKER_PARKED_PLAYER_MOVE <= p_params->resumePoint) return playGuessingRounds(p_params);
+
 	//Begin the Client's initial number retrival procedure...
 	initialNumberReceiveProcedureRes = receiveInitialPlayerNumber(p_params); 
 	//Possible outputs: COMMUNICATION_FAILED, SERVER_DISCONNECTED, COMMUNICATION_TIMEOUT, GRACEFUL_DISCONNECT
@@ -1097,12 +1328,17 @@ static communicationResults beginGame(workingThreadPackage* p_params)
 		//Return the result of the initial player number retrival  or failure if erasing file failed
 		return initialNumberReceiveProcedureRes;
 	}
+	checkpointRoomSnapshot(p_params, ROOM_SNAPSHOT_SETUP);
 
 
 	//Exchange between the Worker threads the initial numbers. Do so by first synchronizing between the two players, 
 	// "ERROR" Event, and then transfer the 4 digits numbers through the file...
 	switch (syncPlayersAndTransferNumbers(p_params, 2/*initial player numbers*/)) {
 	case COMMUNICATION_FAILED: fileTruncationForWhenGameEnds(p_params); return COMMUNICATION_FAILED; //Operation failed regardless of the file erasure operation outcome
+	case PLAYER_DISCONNECTED:
+		//Erase contents from Game session file
+		if (STATUS_CODE_FAILURE == fileTruncationForWhenGameEnds(p_params)) return COMMUNICATION_FAILED; //Due to fatal error at erasure
+		return PLAYER_DISCONNECTED;
 	case SERVER_DISCONNECTED:
 		//Erase contents from Game session file
 		if (STATUS_CODE_FAILURE == fileTruncationForWhenGameEnds(p_params)) return COMMUNICATION_FAILED; //Due to fatal error at erasure
@@ -1121,12 +1357,25 @@ static communicationResults beginGame(workingThreadPackage* p_params)
 			   // information at Server-side, then calculate game phases and send back results..
 	}
 
-	
+	//Both initial numbers were exchanged - the guessing rounds begin
+	setGameRoomPhase(p_params, GAME_ROOM_GUESSING);
+	journalGameSetup(p_params);
+	checkpointRoomSnapshot(p_params, ROOM_SNAPSHOT_GUESSING);
+
+	return playGuessingRounds(p_params);
+}
+
+static communicationResults playGuessingRounds(workingThreadPackage* p_params)
+{
+	LONGLONG roundStartTicks = 0;
+	//Assert
+	assert(NULL != p_params);
 
 
 	//>>>>
 	while (TRUE)
 	{
+		roundStartTicks = readMetricsClock();
 		switch (receivePlayersGuessesAndComputeResults(p_params)) {
 		case COMMUNICATION_FAILED: 
 			//Erase contents from Game session file
@@ -1150,7 +1399,12 @@ static communicationResults beginGame(workingThreadPackage* p_params)
 			//Erase contents from Game session file
 			if (STATUS_CODE_FAILURE == fileTruncationForWhenGameEnds(p_params)) return COMMUNICATION_FAILED; //Due to fatal error at erasure
 			return BACK_TO_MENU; //Take note here, if you don't return to main menu
+		case PLAYER_DISCONNECTED:
+			//Erase contents from Game session file
+			if (STATUS_CODE_FAILURE == fileTruncationForWhenGameEnds(p_params)) return COMMUNICATION_FAILED; //Due to fatal error at erasure
+			return PLAYER_DISCONNECTED; //The opponent quit - the Client returns to Server's main menu
 		default://COMMUNICATION_SUCCEEDED
+			recordRoundDuration(roundStartTicks);
 			continue;
 
 		}
@@ -1160,100 +1414,81 @@ static communicationResults beginGame(workingThreadPackage* p_params)
 
 static communicationResults receiveInitialPlayerNumber(workingThreadPackage* p_params)
 {
-	int firstPlayerBit = 0;
-	message* p_receivedMessageFromClient = NULL;
-	transferResults sendRes = 0, recvRes = 0;
+	transferResults sendRes = 0;
 	//Assert
 	assert(NULL != p_params);
 
-	//Send   ^ SERVER_INVITE ^
-	sendRes = sendMessageServerSide(																//$$$ STARTING FROM HERE  SERVER_OPPONENT_QUIT  SHOULD BE CHECKED $$$
-		p_params->p_s_acceptSocket,					/* Client Socket */
-		SERVER_INVITE_NUM,							/* Send SERVER_INVITE with the opponent's name as a single parameter */
-		p_params->p_otherPlayerName,				/* pointer to the other name string parameter */
-		NULL, NULL, NULL);							/* no parameters : 2,3,4 */
-
-	if (TRANSFER_PREVENTED == sendRes) {
-		//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
-		gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
-		return COMMUNICATION_FAILED;
-	}
-	else if (TRANSFER_FAILED == sendRes) {
-		//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
-		//But, starting from this point onward SERVER_OPPONENT_QUIT can be sent to the OTHER player, so it we set g_serverOpponentQuitBit to '1'
-		//It is okay to do so without a Synchronous object, because there may be only 2 players (Worker threads) currently in game,
-		// and because changing it leads to the immediate exit of the changer thread, which means that if one thread were to change it
-		// then there would be no collision, but if two were to change it, then collision between them wouldn't matter cause they would both
-		// seize connection, without being able to send to their Clients the SERVER_OPPONENT_QUIT message.  Evantually, the bit will be turned off when exiting to main menu 
-		g_serverOpponentQuitBit = 1;
-		return SERVER_DISCONNECTED;
+	//A game handed off by the previous Server process (hot restart) resumes where it was parked - its Client already got SERVER_INVITE &
+	// SERVER_SETUP_REQUSET, and if it was parked awaiting the opponent, this thread already holds its Client's initial number
+	if (WORKER_PARKED_SETUP_EXCHANGE == p_params->resumePoint) {
+		p_params->resumePoint = WORKER_NOT_PARKED;
+		return COMMUNICATION_SUCCEEDED;
 	}
+	if (WORKER_PARKED_SETUP == p_params->resumePoint) p_params->resumePoint = WORKER_NOT_PARKED;
+	else {
+		//Send   ^ SERVER_INVITE ^
+		sendRes = sendMessageServerSide(																//$$$ STARTING FROM HERE  SERVER_OPPONENT_QUIT  SHOULD BE CHECKED $$$
+			p_params->p_s_acceptSocket,					/* Client Socket */
+			SERVER_INVITE_NUM,							/* Send SERVER_INVITE with the opponent's name as a single parameter */
+			p_params->p_otherPlayerName,				/* pointer to the other name string parameter */
+			NULL, NULL, NULL);							/* no parameters : 2,3,4 */
+
+		if (TRANSFER_PREVENTED == sendRes) {
+			//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
+			gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
+			return COMMUNICATION_FAILED;
+		}
+		else if (TRANSFER_FAILED == sendRes) {
+			//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
+			//But, starting from this point onward SERVER_OPPONENT_QUIT can be sent to the OTHER player, so this thread raises its quit flag in the Game Room,
+			// which also wakes the OTHER Worker thread if it is blocked on a players Event or on recv(.)
+			raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
+			return SERVER_DISCONNECTED;
+		}
 
-	if(g_serverOpponentQuitBit == 1)
 		//TRANSFER_SUCCEEDED -> check if other player disconnected		 send ^ SERVER_OPPONENT_QUIT ^
-		sendRes = sendMessageServerSide(
-			p_params->p_s_acceptSocket,					/* Client Socket */
-			SERVER_OPPONENT_QUIT_NUM,					/* Send SERVER_OPPONENT_QUIT  */
-			NULL, NULL, NULL, NULL);					/* no parameters */
-	
-	else
-		//TRANSFER_SUCCEEDED ->		 send ^ SERVER_SETUP_REQUSET ^
-		sendRes = sendMessageServerSide(
-			p_params->p_s_acceptSocket,					/* Client Socket */
-			SERVER_SETUP_REQUSET_NUM,					/* Send SERVER_SETUP_REQUSET  */
-			NULL, NULL, NULL, NULL);					/* no parameters */
+		if (isOpponentQuitInGameRoom(p_params)) return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
 
-	if (TRANSFER_PREVENTED == sendRes) {
-		//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
-		gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
-		g_serverOpponentQuitBit = 1;
-		return COMMUNICATION_FAILED;
-	}
-	else if (TRANSFER_FAILED == sendRes) {
-		//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
-		g_serverOpponentQuitBit = 1;
-		return SERVER_DISCONNECTED;
+		//TRANSFER_SUCCEEDED ->		 send ^ SERVER_SETUP_REQUSET ^ with the Game Room's variant
+		sendRes = sendSetupRequest(p_params);
+
+		if (TRANSFER_PREVENTED == sendRes) {
+			//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
+			gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
+			raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
+			return COMMUNICATION_FAILED;
+		}
+		else if (TRANSFER_FAILED == sendRes) {
+			//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
+			raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
+			return SERVER_DISCONNECTED;
+		}
+		//printf("\n\n9\n\n"); //'DELETE'
 	}
-	//printf("\n\n9\n\n"); //'DELETE'
 
 
+	//A resumed game (RoomSnapshotTools.c) already holds the player's initial number - the Client doesn't send CLIENT_SETUP
+	if (NULL != p_params->p_selfInitialNumber) return COMMUNICATION_SUCCEEDED;
+
 	//TRANSFER_SUCCEEDED ->		expect to receive  CLIENT_SETUP
-	//Need to await the player's initial number, which means we to need to await a human's reponse - Long period 10min
-	recvRes = receiveMessage(p_params->p_s_acceptSocket, &p_receivedMessageFromClient, LONG_SERVER_RESPONSE_WAITING_TIMEOUT);
-	if (TRANSFER_SUCCEEDED == recvRes) //Validate the receive operation result...
-		switch (p_receivedMessageFromClient->messageType) {
-		case CLIENT_SETUP_NUM:
-			if (COPY_OPPONENT_NAME_FAILED == copyPlayerNameOrFourDigitNumberString(p_receivedMessageFromClient, &p_params->p_selfInitialNumber)) {
-				freeTheMessage(p_receivedMessageFromClient);
-				if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mem alloc failed
-					printf("Error: Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-					printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-					//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
-				}
-				//Notify Client Speaker thread, that his connection, a Worker thread, disconnects due to faulty
-				gracefulDisconnect(p_params->p_s_acceptSocket);
-				return COMMUNICATION_FAILED;
-			}
-			//Free the received message arranged in a 'message' struct
-			freeTheMessage(p_receivedMessageFromClient);
-			//Continue... >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-			return COMMUNICATION_SUCCEEDED;  break;
+	return receivePlayerNumber(p_params, CLIENT_SETUP_NUM, &p_params->p_selfInitialNumber, p_params->playerNumbersStorage.selfInitialNumber,
+		sizeof(p_params->playerNumbersStorage.selfInitialNumber), WORKER_PARKED_SETUP, WORKER_PHASE_SETUP);
+}
 
-		default: //Received a wrong message /* no other message is expected from the Server at this point */
-			g_serverOpponentQuitBit = 1;
-			printf("Recived an unexpected message. Exiting\n");
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-			freeTheMessage(p_receivedMessageFromClient);
-			gracefulDisconnect(p_params->p_s_acceptSocket); //'CHECK TIMEOUT CASE'
-			return COMMUNICATION_FAILED; break;
-		}
-	else {
-		if ((communicationResults)recvRes == SERVER_DISCONNECTED)  g_serverOpponentQuitBit = 1;
-		// The communication between the Server Worker thread & the Client Speaker thread failed during recv(.) function, 
-		//   and transRes contains the reason which is also the thread's exit code IN THIS CASE
-		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_acceptSocket)) return COMMUNICATION_FAILED;
-		return (communicationResults)recvRes; //DON'T SET 'ERROR' EVENT!!!
-	}
+static transferResults sendSetupRequest(workingThreadPackage* p_params)
+{
+	char variantLengthBuffer[GAME_VARIANT_PARAMETER_LEN], variantAlphabetBuffer[GAME_VARIANT_PARAMETER_LEN], variantRepeatsBuffer[GAME_VARIANT_PARAMETER_LEN];
+	//Assert
+	assert(NULL != p_params);
+
+	formatGameVariantParameters(&p_params->p_gameRoom->variant, variantLengthBuffer, variantAlphabetBuffer, variantRepeatsBuffer);
+	return sendMessageServerSide(
+			p_params->p_s_acceptSocket,					/* Client Socket */
+			SERVER_SETUP_REQUSET_NUM,					/* Send SERVER_SETUP_REQUSET  */
+			variantLengthBuffer,						/* the variant - number length, */
+			variantAlphabetBuffer,						/* alphabet size */
+			variantRepeatsBuffer,						/* & whether a symbol may repeat */
+			p_params->p_selfInitialNumber);				/* the player's initial number if the game is resumed (NULL otherwise) */
 }
 
 
@@ -1268,10 +1503,11 @@ static communicationResults syncPlayersAndTransferNumbers(workingThreadPackage*
 	//Assert
 	assert(NULL != p_params);
 
-	switch (awaitBothPlayersByMarkingFirstClientThenSecondClient(p_params, dataTypeBit, (int)SERVER_OPPONENT_QUIT/*Opponent may quit during game*/)) {
+	switch (awaitBothPlayersByMarkingFirstClientThenSecondClient(p_params, dataTypeBit, (int)SERVER_OPPONENT_QUIT_NUM/*Opponent may quit during game*/)) {
 	case COMMUNICATION_FAILED: return COMMUNICATION_FAILED;
 	case SERVER_DISCONNECTED: return SERVER_DISCONNECTED;
 	case GRACEFUL_DISCONNECT: return GRACEFUL_DISCONNECT;
+	case PLAYER_DISCONNECTED: return PLAYER_DISCONNECTED; //Opponent quit - SERVER_OPPONENT_QUIT was sent
 	default://COMMUNICATION_SUCCESS
 		break; // Continue to share data between Worker threads
 	}
@@ -1300,82 +1536,47 @@ static communicationResults syncPlayersAndTransferNumbers(workingThreadPackage*
 
 static communicationResults receivePlayersGuessesAndComputeResults(workingThreadPackage* p_params)
 {
-	message* p_receivedMessageFromClient = NULL;
-	transferResults sendRes = 0, recvRes = 0;
+	communicationResults guessReceiveRes = 0;
+	transferResults sendRes = 0;
+	workerParkPoints resumePoint = 0;
 	//Assert
 	assert(NULL != p_params);
 
-	if(g_serverOpponentQuitBit == 1)
-		//Send   ^ SERVER_OPPONENT_QUIT ^
-		sendRes = sendMessageServerSide(
-			p_params->p_s_acceptSocket,					/* Client Socket */
-			SERVER_OPPONENT_QUIT_NUM,				/* Send SERVER_OPPONENT_QUIT  */
-			NULL, NULL, NULL, NULL);					/* no parameters  */
-	
-	
-	else
+	//A round handed off by the previous Server process (hot restart) resumes where it was parked - past SERVER_PLAYER_MOVE_REQUEST,
+	// and if it was parked awaiting the opponent, past its Client's guess too
+	resumePoint = p_params->resumePoint;
+	p_params->resumePoint = WORKER_NOT_PARKED;
+
+	if (WORKER_PARKED_PLAYER_MOVE > resumePoint) {
+		//Send   ^ SERVER_OPPONENT_QUIT ^  if the opponent quit
+		if (isOpponentQuitInGameRoom(p_params)) return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
+
 		//Send   ^ SERVER_PLAYER_MOVE_REQUEST ^
 		sendRes = sendMessageServerSide(
-			p_params->p_s_acceptSocket,					/* Client Socket */
-			SERVER_PLAYER_MOVE_REQUEST_NUM,				/* Send SERVER_PLAYER_MOVE_REQUEST with the opponent's name as a single parameter */
-			NULL,NULL, NULL, NULL);						/* no parameters  */
+				p_params->p_s_acceptSocket,					/* Client Socket */
+				SERVER_PLAYER_MOVE_REQUEST_NUM,				/* Send SERVER_PLAYER_MOVE_REQUEST with the opponent's name as a single parameter */
+				NULL,NULL, NULL, NULL);						/* no parameters  */
 
-	if (TRANSFER_PREVENTED == sendRes) {
-		//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
-		gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
-		g_serverOpponentQuitBit = 1; //Exiting... Notify other Worker thread
-		return COMMUNICATION_FAILED;
-	}
-	else if (TRANSFER_FAILED == sendRes) {
-		//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
-		g_serverOpponentQuitBit = 1; //Exiting... Notify other Worker thread
-		return SERVER_DISCONNECTED;
+		if (TRANSFER_PREVENTED == sendRes) {
+			//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
+			gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
+			raiseQuitFlagInGameRoomAndWakeOpponent(p_params); //Exiting... Notify other Worker thread
+			return COMMUNICATION_FAILED;
+		}
+		else if (TRANSFER_FAILED == sendRes) {
+			//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
+			raiseQuitFlagInGameRoomAndWakeOpponent(p_params); //Exiting... Notify other Worker thread
+			return SERVER_DISCONNECTED;
+		}
 	}
 
 
-	//printf("My number    %s ,, Other number     %s\n", p_params->p_selfInitialNumber, p_params->p_otherInitialNumber); 'DELETE'
-
-
-
 	//TRANSFER_SUCCEEDED ->		expect to receive  *CLIENT_PLAYER_MOVE*
-	//Need to await the player's guess number, which means we to need to await a human's reponse - Long period 10min
-	recvRes = receiveMessage(p_params->p_s_acceptSocket, &p_receivedMessageFromClient, LONG_SERVER_RESPONSE_WAITING_TIMEOUT);
-	if (TRANSFER_SUCCEEDED == recvRes) //Validate the receive operation result...
-		switch (p_receivedMessageFromClient->messageType) {
-		case CLIENT_PLAYER_MOVE_NUM:
-			if (COPY_OPPONENT_NAME_FAILED == copyPlayerNameOrFourDigitNumberString(p_receivedMessageFromClient, &p_params->p_selfCurrentGuess)) {
-				freeTheMessage(p_receivedMessageFromClient);
-				if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mem alloc failed
-					printf("Error: Failed to set Exit/Error event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-					printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
-					//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
-				}
-				//Notify Client Speaker thread, that his connection, a Worker thread, disconnects due to faulty
-				gracefulDisconnect(p_params->p_s_acceptSocket);
-				return COMMUNICATION_FAILED;
-			}
-
-
-
-			//Free the received message arranged in a 'message' struct
-			freeTheMessage(p_receivedMessageFromClient);
-			//Continue... >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-			  break;
-
-		default: //Received a wrong message /* no other message is expected from the Server at this point */
-			g_serverOpponentQuitBit = 1;
-			printf("Recived an unexpected message. Exiting\n");
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-			freeTheMessage(p_receivedMessageFromClient);
-			gracefulDisconnect(p_params->p_s_acceptSocket); //'CHECK TIMEOUT CASE'
-			return COMMUNICATION_FAILED; break;
-		}
-	else {
-		if ((communicationResults)recvRes == SERVER_DISCONNECTED)  g_serverOpponentQuitBit = 1;
-		// The communication between the Server Worker thread & the Client Speaker thread failed during recv(.) function, 
-		//   and transRes contains the reason which is also the thread's exit code IN THIS CASE
-		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_acceptSocket)) return COMMUNICATION_FAILED;
-		return (communicationResults)recvRes; //DON'T SET 'ERROR' EVENT!!!
+	if (WORKER_PARKED_MOVE_EXCHANGE != resumePoint) {
+		guessReceiveRes = receivePlayerNumber(p_params, CLIENT_PLAYER_MOVE_NUM, &p_params->p_selfCurrentGuess, p_params->playerNumbersStorage.selfCurrentGuess,
+			sizeof(p_params->playerNumbersStorage.selfCurrentGuess), WORKER_PARKED_PLAYER_MOVE, WORKER_PHASE_GUESSING);
+		if (COMMUNICATION_SUCCEEDED != guessReceiveRes) return guessReceiveRes;
+		checkpointRoomSnapshot(p_params, ROOM_SNAPSHOT_GUESSING); //The pending guess
 	}
 
 	//printf("\n\n11\n\n"); 'DELETE'
@@ -1386,6 +1587,7 @@ static communicationResults receivePlayersGuessesAndComputeResults(workingThread
 	case SERVER_DISCONNECTED: return SERVER_DISCONNECTED;
 	case GRACEFUL_DISCONNECT: return GRACEFUL_DISCONNECT;
 	case COMMUNICATION_EXIT: return COMMUNICATION_EXIT;
+	case PLAYER_DISCONNECTED: return PLAYER_DISCONNECTED;
 	default://COMMUNICATION_SUCCEEDED
 		break; //continue to asking for guess numbers from the Clients, then exchange the
 			   // information at Server-side, then calculate game phases and send back results..
@@ -1397,6 +1599,7 @@ static communicationResults receivePlayersGuessesAndComputeResults(workingThread
 	case SERVER_DISCONNECTED: return SERVER_DISCONNECTED;
 	case GRACEFUL_DISCONNECT: return GRACEFUL_DISCONNECT;
 	case BACK_TO_MENU: return BACK_TO_MENU;
+	case PLAYER_DISCONNECTED: return PLAYER_DISCONNECTED;
 	default: //COMMUNICATION_SUCCEEDED
 		return COMMUNICATION_SUCCEEDED; break;
 	}
@@ -1414,21 +1617,25 @@ static communicationResults prepareResultsOfCurrentRoundAndSend(workingThreadPac
 	//"other" variables will contain the values of the results of the current thread comparisons (Current initial number, Other guesses)
 	//"self" variables will contain the values of the results of the other thread comparisons (Other initial number, self guesses)
 	SHORT selfGuessBulls = 0, otherGuessBulls = 0, selfGuessCows = 0, otherGuessCows = 0;
-	TCHAR* p_winner = NULL, * sendBullsAndCowsBuffer = NULL, sendBullsCharacter = 'a', sendCowsCharacter = 'a';
+	TCHAR* p_winner = NULL, sendBullsAndCowsBuffer[4] = { 0 }, sendBullsCharacter = 'a', sendCowsCharacter = 'a';
+	const gameVariant* p_variant = NULL;
+	gameRoundOutcomes roundOutcome = GAME_ROUND_CONTINUES;
 	//Assert
 	assert(NULL != p_params);
 
-	//Conduct a single game phase
-	playSingleGamePhase(
+	//Conduct a single game phase, with the scorer of the Game Room's variant
+	p_variant = &p_params->p_gameRoom->variant;
+	p_variant->p_scoreGuess(
 		p_params->p_otherInitialNumber,	/* Other Client(associated Worker thread) initial number */
 		p_params->p_selfCurrentGuess,		/* This Client current guess number */
 		&selfGuessBulls,					/* Bulls count of "self"(self's guess) side of the game */
 		&selfGuessCows);					/* Cows count of "self"(self's guess) side of the game */
-	playSingleGamePhase(
+	p_variant->p_scoreGuess(
 		p_params->p_selfInitialNumber,		/* Other Client(associated Worker thread) initial number */
 		p_params->p_otherCurrentGuess,		/* This Client currnt guess number */
 		&otherGuessBulls,					/* Bulls count of "other"(other's guess) side of the game */
 		&otherGuessCows);					/* Cows count of "other"(other's guess) side of the game */
+	journalGameRound(p_params, selfGuessBulls, selfGuessCows, otherGuessBulls, otherGuessCows);
 
 
 
@@ -1439,79 +1646,69 @@ static communicationResults prepareResultsOfCurrentRoundAndSend(workingThreadPac
 
 	
 
-	//Check results: 
-	if ((selfGuessBulls == 4) && (otherGuessBulls == 4))
+	//Check results: (a number is guessed when all of its symbols are bulls)
+	roundOutcome = judgeGameRound(p_variant, selfGuessBulls, otherGuessBulls);
+	if (GAME_ROUND_DRAW == roundOutcome)
 		return sendDraw(p_params); 				//Both players guessed their opponents' initial numbers correctly
 
-	else if (selfGuessBulls == 4) {
+	else if (GAME_ROUND_SELF_WINS == roundOutcome) {
 		p_winner = p_params->p_selfPlayerName; 	//"Self" wins
 		return sendWinner(p_params, p_winner);
 	}
-	else if (otherGuessBulls == 4) {
+	else if (GAME_ROUND_OTHER_WINS == roundOutcome) {
 		p_winner = p_params->p_otherPlayerName;	//"Other" wins
 		return sendWinner(p_params, p_winner);
 	}
 	else {										// None of the players guessed the other's initial number correctly
-		//Allocate memory for buffer to hold the Bulls & Cows outcomes bytes
-		if (NULL == (sendBullsAndCowsBuffer = (TCHAR*)calloc(sizeof(TCHAR), 4))) {
-			printf("Error: Failed to allocate dynamic memory (Heap) for a buffer.\n");
-			printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
-			if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mem alloc failed
-				printf("Error: Failed to set Exit/Error event to signaled state for ALL threads to be notified to finish, with error code no. %ld.\nExiting..\n\n", GetLastError());
-				printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
-				//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
-			}
-			return COMMUNICATION_FAILED;
-		}
 		//Prepare & Send a SERVER_GAME_RESULTS message with "Self" variables
 		*sendBullsAndCowsBuffer = (TCHAR)('0' + selfGuessBulls);		//Implicit type case to int, then explicit typecast to TCHAR(which is char)
 		*(sendBullsAndCowsBuffer + 2) = (TCHAR)('0' + selfGuessCows);	     //Implicit type case to int, then explicit typecast to TCHAR(which is char)
-		//Since we used calloc, these addresses are kept in Heap and are followed by null character after each of them '\0'
+		//Since the stack buffer is zero-initialized, these addresses are followed by null character after each of them '\0'
 		//so they can be related as null-terminated "strings" so we can send their addresses as type char*\TCHAR*
 
-		if(g_serverOpponentQuitBit == 1)
-			//Send   ^ SERVER_OPPONENT_QUIT ^
-			sendRes = sendMessageServerSide(
-				p_params->p_s_acceptSocket,					/* Client Socket */
-				SERVER_OPPONENT_QUIT_NUM,				/* Send SERVER_OPPONENT_QUIT  */
-				NULL, NULL, NULL, NULL);					/* no parameters  */
-
-		else
-			//Send    ^ SERVER_GAME_RESULTS ^
-			sendRes = sendMessageServerSide(
-				p_params->p_s_acceptSocket,							/* Client Socket */
-				SERVER_GAME_RESULTS_NUM,							/* Send SERVER_GAME_RESULTS  */
-				sendBullsAndCowsBuffer, sendBullsAndCowsBuffer + 2,	/* bulls & cows results as strings */
-				p_params->p_otherPlayerName,						/* opponent username */
-				p_params->p_otherCurrentGuess);						/* opponent guess number */
+		//Send   ^ SERVER_OPPONENT_QUIT ^  if the opponent quit
+		if (isOpponentQuitInGameRoom(p_params)) {
+			return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
+		}
+		//The spectators watch both guesses of the round
+		publishGameRoundToSpectators(p_params, selfGuessBulls, selfGuessCows, otherGuessBulls, otherGuessCows);
+		//Kept for a Client that reconnects before its next guess (reattachReconnectedClient(.)) - the results are sent to it again
+		p_params->lastRoundResults.resultsIndex++;
+		memcpy(p_params->lastRoundResults.bullsAndCows, sendBullsAndCowsBuffer, sizeof(p_params->lastRoundResults.bullsAndCows));
+		_snprintf_s(p_params->lastRoundResults.otherGuess, sizeof(p_params->lastRoundResults.otherGuess), _TRUNCATE, "%s", p_params->p_otherCurrentGuess);
+
+		//Send    ^ SERVER_GAME_RESULTS ^
+		sendRes = sendMessageServerSide(
+			p_params->p_s_acceptSocket,							/* Client Socket */
+			SERVER_GAME_RESULTS_NUM,							/* Send SERVER_GAME_RESULTS  */
+			sendBullsAndCowsBuffer, sendBullsAndCowsBuffer + 2,	/* bulls & cows results as strings */
+			p_params->p_otherPlayerName,						/* opponent username */
+			p_params->p_otherCurrentGuess);						/* opponent guess number */
 
 		//Validate sending result...
 		if (TRANSFER_PREVENTED == sendRes) {
 			//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
-			free(sendBullsAndCowsBuffer);
 			gracefulDisconnect(p_params->p_s_acceptSocket); //Operaion failed regardless of gracefulDisconnect operation
-			//freeThePlayer(p_params);
+			//resetThePlayer(p_params, PLAYER_RESET_CONNECTION);
 			return COMMUNICATION_FAILED;
 		}
 		else if (TRANSFER_FAILED == sendRes) {
 			//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
-			free(sendBullsAndCowsBuffer);
-			//freeThePlayer(p_params);
+			//resetThePlayer(p_params, PLAYER_RESET_CONNECTION);
+			raiseQuitFlagInGameRoomAndWakeOpponent(p_params); //Exiting... Notify other Worker thread
 			return SERVER_DISCONNECTED; // send SERVER_OPPONENT_QUIT and return BACK TO MENU
 		}
 
-		//Free bits string
-		free(sendBullsAndCowsBuffer);
 	}
 	
 
 	
 
-	//Free the memory allcations of the "Guess"es numbers of both, the Other player & self, at the end of this Round 
-	free(p_params->p_otherCurrentGuess); 
-	p_params->p_otherCurrentGuess = NULL;
-	free(p_params->p_selfCurrentGuess);
-	p_params->p_selfCurrentGuess = NULL;
+	//Discard the "Guess"es numbers of both, the Other player & self, at the end of this Round (O(1) - inline storage)
+	resetThePlayer(p_params, PLAYER_RESET_ROUND);
+	//The round ended - checkpoint the game at the round boundary
+	p_params->gameRound++;
+	checkpointRoomSnapshot(p_params, ROOM_SNAPSHOT_GUESSING);
 
 	//After analyzing the results, there appear to be no "winner" nor a "draw"
 	// Cycle another one of guesses.....
@@ -1523,24 +1720,28 @@ static communicationResults prepareResultsOfCurrentRoundAndSend(workingThreadPac
 
 static communicationResults sendDraw(workingThreadPackage* p_params)
 {
-	transferResults sendRes = 0;
+	transferResults sendRes = TRANSFER_SUCCEEDED;
 	communicationResults retVal = BACK_TO_MENU;
 	//Assert
 	assert(NULL != p_params);
 
-	if (g_serverOpponentQuitBit == 1)
-		//Send   ^ SERVER_OPPONENT_QUIT ^
-		sendRes = sendMessageServerSide(
-			p_params->p_s_acceptSocket,					/* Client Socket */
-			SERVER_OPPONENT_QUIT_NUM,				/* Send SERVER_OPPONENT_QUIT  */
-			NULL, NULL, NULL, NULL);					/* no parameters  */
-	
-	else
+	//Send   ^ SERVER_OPPONENT_QUIT ^  if the opponent quit
+	if (isOpponentQuitInGameRoom(p_params))
+		retVal = notifyClientOpponentQuitAndLeaveGameRoom(p_params);
+
+	else {
 		//Send    ^ SERVER_DRAW ^
 		sendRes = sendMessageServerSide(
 			p_params->p_s_acceptSocket,					/* Client Socket */
 			SERVER_DRAW_NUM,							/* Send SERVER_DRAW  */
 			NULL, NULL, NULL, NULL);					/* no parameters  */
+		//The game ended - rated once, by the Game Room opener
+		setGameRoomPhase(p_params, GAME_ROOM_CLOSED);
+		journalGameOutcome(p_params, RATING_OUTCOME_DRAW);
+		publishGameOutcomeToSpectators(p_params, NULL);
+		if (GAME_ROOM_OPENER_SLOT == p_params->gameRoomSlot)
+			recordRatedGame(p_params->p_selfPlayerName, p_params->p_otherPlayerName, RATING_OUTCOME_DRAW);
+	}
 
 	if (TRANSFER_PREVENTED == sendRes) {
 		//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
@@ -1549,26 +1750,11 @@ static communicationResults sendDraw(workingThreadPackage* p_params)
 	}
 	else if (TRANSFER_FAILED == sendRes) {
 		//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
-		g_serverOpponentQuitBit = 1;
+		raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
 		retVal = SERVER_DISCONNECTED;
 	}
-	//Free the memory allcations of ALL numbers of both, the Other player & self, and the opponents' name,
-	//	and pointes the pointers to NULL, at the end of this Game... 
-	//Other current guess
-	free(p_params->p_otherCurrentGuess);
-	p_params->p_otherCurrentGuess = NULL;
-	//Self current guess
-	free(p_params->p_selfCurrentGuess);
-	p_params->p_selfCurrentGuess = NULL;
-	//Other initial number
-	free(p_params->p_otherInitialNumber);
-	p_params->p_otherInitialNumber = NULL;
-	//Self initial number
-	free(p_params->p_selfInitialNumber);
-	p_params->p_selfInitialNumber = NULL;
-	//Other name
-	free(p_params->p_otherPlayerName);
-	p_params->p_otherPlayerName = NULL;
+	//Discard ALL numbers of both, the Other player & self, and the opponents' name at the end of this Game (O(1) - inline storage)
+	resetThePlayer(p_params, PLAYER_RESET_GAME);
 
 	//There is a tie!! We may return to Server's Main Menu
 	return retVal; //Default is BACK_TO_MENU
@@ -1576,19 +1762,16 @@ static communicationResults sendDraw(workingThreadPackage* p_params)
 
 static communicationResults sendWinner(workingThreadPackage* p_params, char* p_winner)
 {
-	transferResults sendRes = 0;
+	transferResults sendRes = TRANSFER_SUCCEEDED;
 	communicationResults retVal = BACK_TO_MENU;
 	//Assert
 	assert(NULL != p_params);
 
-	if (g_serverOpponentQuitBit == 1)
-		//Send   ^ SERVER_OPPONENT_QUIT ^
-		sendRes = sendMessageServerSide(
-			p_params->p_s_acceptSocket,					/* Client Socket */
-			SERVER_OPPONENT_QUIT_NUM,				/* Send SERVER_OPPONENT_QUIT  */
-			NULL, NULL, NULL, NULL);					/* no parameters  */
+	//Send   ^ SERVER_OPPONENT_QUIT ^  if the opponent quit
+	if (isOpponentQuitInGameRoom(p_params))
+		retVal = notifyClientOpponentQuitAndLeaveGameRoom(p_params);
 
-	else
+	else {
 		//Send    ^ SERVER_WIN ^
 		sendRes = sendMessageServerSide(
 			p_params->p_s_acceptSocket,					/* Client Socket */
@@ -1596,6 +1779,14 @@ static communicationResults sendWinner(workingThreadPackage* p_params, char* p_w
 			p_winner,									/* winner name  */
 			p_params->p_otherInitialNumber,				/* opponenet inital number */
 			NULL, NULL);								/* no parameters: 3,4  */
+		//The game ended - rated once, by the Game Room opener
+		setGameRoomPhase(p_params, GAME_ROOM_CLOSED);
+		journalGameOutcome(p_params, (p_winner == p_params->p_selfPlayerName) ? RATING_OUTCOME_WIN : RATING_OUTCOME_LOSS);
+		publishGameOutcomeToSpectators(p_params, p_winner);
+		if (GAME_ROOM_OPENER_SLOT == p_params->gameRoomSlot)
+			recordRatedGame(p_params->p_selfPlayerName, p_params->p_otherPlayerName,
+				(p_winner == p_params->p_selfPlayerName) ? RATING_OUTCOME_WIN : RATING_OUTCOME_LOSS);
+	}
 
 	if (TRANSFER_PREVENTED == sendRes) {
 		//Some other operation within the Server malfunctioned the Server-Client connectivity - fatal error 
@@ -1604,27 +1795,12 @@ static communicationResults sendWinner(workingThreadPackage* p_params, char* p_w
 	}
 	else if (TRANSFER_FAILED == sendRes) {
 		//No need for a "Graceful disconnect" operation because the Client disconnected abruptly
-		g_serverOpponentQuitBit = 1;
+		raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
 		retVal = SERVER_DISCONNECTED;
 	}
 
-	//Free the memory allcations of ALL numbers of both, the Other player & self, and the opponents' name,
-	//	and pointes the pointers to NULL, at the end of this Game... 
-	//Other current guess
-	free(p_params->p_otherCurrentGuess);
-	p_params->p_otherCurrentGuess = NULL;
-	//Self current guess
-	free(p_params->p_selfCurrentGuess);
-	p_params->p_selfCurrentGuess = NULL;
-	//Other initial number
-	free(p_params->p_otherInitialNumber);
-	p_params->p_otherInitialNumber = NULL;
-	//Self initial number
-	free(p_params->p_selfInitialNumber);
-	p_params->p_selfInitialNumber = NULL;
-	//Other name
-	free(p_params->p_otherPlayerName);
-	p_params->p_otherPlayerName = NULL;
+	//Discard ALL numbers of both, the Other player & self, and the opponents' name at the end of this Game (O(1) - inline storage)
+	resetThePlayer(p_params, PLAYER_RESET_GAME);
 
 	//There is a winner!! We may return to Server's Main Menu
 	return retVal; //Default is BACK_TO_MENU
@@ -1632,37 +1808,219 @@ static communicationResults sendWinner(workingThreadPackage* p_params, char* p_w
 }
 
 
-static int copyPlayerNameOrFourDigitNumberString(message* p_receivedMessageFromClient, char** p_p_playerDataInMessage)
+static int copyPlayerNameOrFourDigitNumberString(message* p_receivedMessageFromClient, char** p_p_playerDataInMessage, char* p_playerDataStorage, int playerDataStorageSize)
 {
 	int nameLength = 0;
-	//Assert
+	//Asserts
 	assert(NULL != p_receivedMessageFromClient);
+	assert(NULL != p_playerDataStorage);
+	assert(0 < playerDataStorageSize);
 
-	//Count the player's name length, either self or opponent
-	nameLength = fetchStringLength(p_receivedMessageFromClient->p_parameters->p_parameter);
-
-	//Allocate memory (Heap) for the player's name string
-	if (NULL == (*p_p_playerDataInMessage = (char*)calloc(sizeof(char), nameLength + 1))) {
-		printf("Error: Failed to allocate memory for the Opponent's name string.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\nBy Thread no.: %ld\n\n\n", __FILE__, __LINE__, __func__, GetCurrentThreadId());
+	//The message must carry the player's data as its first parameter
+	if ((NULL == p_receivedMessageFromClient->p_parameters) || (NULL == p_receivedMessageFromClient->p_parameters->p_parameter)) {
+		LOG_EVENT(LOG_EVENT_FAILURE, "The received message carries no player's name or number", 0, 0);
 		return COPY_OPPONENT_NAME_FAILED;
 	}
-	//Copy the name to the newly allocated buffer
+
+	//Count the player's name length, either self or opponent (truncated to the inline buffer, keeping room for the '\0')
+	nameLength = fetchStringLength(p_receivedMessageFromClient->p_parameters->p_parameter);
+	if (nameLength > playerDataStorageSize - 1) nameLength = playerDataStorageSize - 1;
+
+	//Copy the name to the package's inline buffer
 	concatenateStringToStringThatMayContainNullCharacters(
-		*p_p_playerDataInMessage,									/* Destination Buffer */
+		p_playerDataStorage,									/* Destination Buffer */
 		p_receivedMessageFromClient->p_parameters->p_parameter, /* Source Buffer */
 		0,														/* Start position */
 		nameLength);											/* Number of bytes to copy */
+	*(p_playerDataStorage + nameLength) = '\0';
+	*p_p_playerDataInMessage = p_playerDataStorage;
 
 	//Copy succeeded...
 	return COPY_OPPONENT_NAME_FAILED + 1;
 }
 
+static BOOL validateReceivedPlayerNumber(workingThreadPackage* p_params, const char* p_number)
+{
+	//Asserts
+	assert(NULL != p_params);
+	assert(NULL != p_number);
+
+	if (TRUE == isValidPlayerNumber(&p_params->p_gameRoom->variant, p_number)) return STATUS_CODE_SUCCESS;
+
+	recordInvalidPlayerNumber();
+	LOG_EVENT(LOG_EVENT_UNEXPECTED, "Received a number the Game Room's variant does not allow. Exiting", p_params->p_gameRoom->variant.numberLength, 0);
+	raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
+	gracefulDisconnect(p_params->p_s_acceptSocket);
+	return STATUS_CODE_FAILURE;
+}
+
+static BOOL parkWorkerForHandoff(workingThreadPackage* p_params, workerParkPoints parkPoint)
+{
+	HANDLE h_cancelExitErrorEvents[3];
+	DWORD waitCode = 0;
+	//Assert
+	assert(NULL != p_params);
+
+	h_cancelExitErrorEvents[0] = *(p_params->p_h_handoffCancelEvent);
+	h_cancelExitErrorEvents[1] = *(p_params->p_h_exitEvent);
+	h_cancelExitErrorEvents[2] = *(p_params->p_h_errorEvent);
+
+	//The main thread samples the park point - the Client's connection is handed off only once every Worker thread is parked
+	InterlockedExchange(&p_params->parkPoint, (LONG)parkPoint);
+	waitCode = WaitForMultipleObjects(3, h_cancelExitErrorEvents, FALSE, INFINITE);
+	InterlockedExchange(&p_params->parkPoint, (LONG)WORKER_NOT_PARKED);
+
+	switch (waitCode) {
+	case WAIT_OBJECT_0: return STATUS_CODE_SUCCESS; //The restart was cancelled
+	case WAIT_FAILED:
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait while parked for a hot restart", GetLastError(), 0);
+		return STATUS_CODE_FAILURE;
+	default: return STATUS_CODE_FAILURE; //'Exit' or 'Error'
+	}
+}
+
+static transferResults receiveClientMessageOrParkForHandoff(workingThreadPackage* p_params, message** p_p_receivedMessageFromClient, workerParkPoints parkPoint)
+{
+	HANDLE h_abortEvents[2];
+	int numOfAbortEvents = 0, abortingEventIndex = 0;
+	BOOL isHandoffAwaited = TRUE;
+	transferResults recvRes = 0;
+	//Asserts
+	assert(NULL != p_params);
+	assert(NULL != p_p_receivedMessageFromClient);
+
+	//The Game Room's quit Event is awaited only in a game, & the hot restart Event is always last
+	if (WORKER_PARKED_MAIN_MENU != parkPoint) h_abortEvents[numOfAbortEvents++] = *(p_params->p_gameRoom->p_h_roomQuitEvent);
+	h_abortEvents[numOfAbortEvents++] = *(p_params->p_h_handoffEvent);
+
+	while (TRUE) {
+		recvRes = receiveMessageOrAbortOnEvents(p_params->p_s_acceptSocket, p_p_receivedMessageFromClient, LONG_SERVER_RESPONSE_WAITING_TIMEOUT,
+			h_abortEvents, numOfAbortEvents, &abortingEventIndex);
+		if ((TRANSFER_ABORTED != recvRes) || (FALSE == isHandoffAwaited) || (numOfAbortEvents - 1 != abortingEventIndex)) return recvRes;
+
+		//A hot restart was requested - park until it is cancelled. If the Server exits instead, stop awaiting the restart & let
+		// the Worker thread notice the 'Exit'\'Error' Event at its next step
+		if (STATUS_CODE_FAILURE == parkWorkerForHandoff(p_params, parkPoint)) {
+			isHandoffAwaited = FALSE;
+			numOfAbortEvents--;
+		}
+	}
+}
+
+static communicationResults receivePlayerNumber(workingThreadPackage* p_params, int expectedMessageType, char** p_p_playerNumber, char* p_playerNumberStorage,
+	int playerNumberStorageSize, workerParkPoints parkPoint, workerPhases phase)
+{
+	message* p_receivedMessageFromClient = NULL;
+	transferResults recvRes = 0;
+	//Asserts
+	assert(NULL != p_params);
+	assert(NULL != p_p_playerNumber);
+	assert(NULL != p_playerNumberStorage);
+
+	//Need to await the player's number, which means we to need to await a human's reponse - Long period 10min,
+	// unless the opponent quits in the meanwhile (Game Room quit Event)
+	recvRes = receiveClientMessageOrParkForHandoff(p_params, &p_receivedMessageFromClient, parkPoint);
+	//A Client whose connection dropped may reconnect with its session token - the game is held for it & the number is awaited again
+	while (((TRANSFER_FAILED == recvRes) || (TRANSFER_DISCONNECTED == recvRes)) && (STATUS_CODE_SUCCESS == reattachReconnectedClient(p_params, parkPoint)))
+		recvRes = receiveClientMessageOrParkForHandoff(p_params, &p_receivedMessageFromClient, parkPoint);
+	if (TRANSFER_ABORTED == recvRes) return notifyClientOpponentQuitAndLeaveGameRoom(p_params);
+	if (TRANSFER_SUCCEEDED != recvRes) {
+		//This Worker thread leaves the game (abrupt disconnection, timeout or graceful disconnection) - notify the OTHER Worker thread
+		raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
+		if (TRANSFER_TIMEOUT == recvRes) recordWorkerPhaseTimeout(phase);
+		// The communication between the Server Worker thread & the Client Speaker thread failed during recv(.) function, 
+		//   and transRes contains the reason which is also the thread's exit code IN THIS CASE
+		if (COMMUNICATION_FAILED == gracefulDisconnect(p_params->p_s_acceptSocket)) return COMMUNICATION_FAILED;
+		return (communicationResults)recvRes; //DON'T SET 'ERROR' EVENT!!!
+	}
+
+	//Validate the receive operation result...
+	if (expectedMessageType != p_receivedMessageFromClient->messageType) {
+		//Received a wrong message /* no other message is expected from the Client at this point */
+		raiseQuitFlagInGameRoomAndWakeOpponent(p_params);
+		LOG_EVENT(LOG_EVENT_UNEXPECTED, "Recived an unexpected message. Exiting", p_receivedMessageFromClient->messageType, 0);
+		freeTheMessage(p_receivedMessageFromClient);
+		gracefulDisconnect(p_params->p_s_acceptSocket);
+		return COMMUNICATION_FAILED;
+	}
+
+	if (COPY_OPPONENT_NAME_FAILED == copyPlayerNameOrFourDigitNumberString(p_receivedMessageFromClient, p_p_playerNumber, p_playerNumberStorage, playerNumberStorageSize)) {
+		freeTheMessage(p_receivedMessageFromClient);
+		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*(p_params->p_h_errorEvent))) {  //reason: Mem alloc failed
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to set 'ERROR' event to signaled state for ALL threads to be notified to finish", GetLastError(), 0);
+			//Continue to exiting regardless of failure return STATUS_CODE_FAILURE;
+		}
+		//Notify Client Speaker thread, that his connection, a Worker thread, disconnects due to faulty
+		gracefulDisconnect(p_params->p_s_acceptSocket);
+		return COMMUNICATION_FAILED;
+	}
+	//Free the received message arranged in a 'message' struct
+	freeTheMessage(p_receivedMessageFromClient);
+	//The Client's word is not taken for it - a number the Game Room's variant does not allow ends the game, as an unexpected message does
+	if (STATUS_CODE_FAILURE == validateReceivedPlayerNumber(p_params, *p_p_playerNumber)) return COMMUNICATION_FAILED;
+
+	//Continue... >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+	return COMMUNICATION_SUCCEEDED;
+}
+
+static BOOL reattachReconnectedClient(workingThreadPackage* p_params, workerParkPoints parkPoint)
+{
+	HANDLE h_abortEvents[3];
+	SOCKET* p_s_reattachedSocket = NULL;
+	transferResults sendRes = 0;
+	char sessionTokenString[SESSION_TOKEN_STRING_LEN], resultsIndexString[SESSION_RESULTS_INDEX_LEN];
+	//Assert
+	assert(NULL != p_params);
+
+	//The opponent quitting or the Server exiting ends the hold
+	h_abortEvents[0] = *(p_params->p_gameRoom->p_h_roomQuitEvent);
+	h_abortEvents[1] = *(p_params->p_h_exitEvent);
+	h_abortEvents[2] = *(p_params->p_h_errorEvent);
+	if (NULL == (p_s_reattachedSocket = holdSessionForReconnect(p_params, h_abortEvents, 3))) return STATUS_CODE_FAILURE;
+
+	//The new connection replaces the dropped one, with a send queue of its own
+	detachSendQueue();
+	closeSocketProcedure(p_params->p_s_acceptSocket);
+	p_params->p_s_acceptSocket = p_s_reattachedSocket;
+	attachSendQueue(*(p_params->p_s_acceptSocket), SEND_QUEUE_DEFAULT_POLICY);
+
+	//Send   ^ SERVER_APPROVED ^  with the session token & the game's phase (& the index of the last results), followed by the pending request
+	formatSessionToken(p_params, sessionTokenString);
+	if (WORKER_PARKED_SETUP == parkPoint) {
+		if (TRANSFER_SUCCEEDED == (sendRes = sendMessageServerSide(p_params->p_s_acceptSocket, SERVER_APPROVED_NUM, sessionTokenString, SESSION_REATTACHED_SETUP, NULL, NULL)))
+			sendRes = sendSetupRequest(p_params);
+	}
+	else {
+		_snprintf_s(resultsIndexString, sizeof(resultsIndexString), _TRUNCATE, "%ld", p_params->lastRoundResults.resultsIndex);
+		sendRes = sendMessageServerSide(p_params->p_s_acceptSocket, SERVER_APPROVED_NUM, sessionTokenString, SESSION_REATTACHED_GUESSING, resultsIndexString, NULL);
+		//The results of the last round may have been lost with the dropped connection - they are sent again before the move request
+		// (the Client skips them if it already showed the results of that index)
+		if ((TRANSFER_SUCCEEDED == sendRes) && (0 < p_params->lastRoundResults.resultsIndex))
+			sendRes = sendMessageServerSide(p_params->p_s_acceptSocket, SERVER_GAME_RESULTS_NUM, p_params->lastRoundResults.bullsAndCows,
+				p_params->lastRoundResults.bullsAndCows + 2, p_params->p_otherPlayerName, p_params->lastRoundResults.otherGuess);
+		if (TRANSFER_SUCCEEDED == sendRes)
+			sendRes = sendMessageServerSide(p_params->p_s_acceptSocket, SERVER_PLAYER_MOVE_REQUEST_NUM, NULL, NULL, NULL, NULL);
+	}
+
+	//A message that could not be constructed is a fatal error. A connection that dropped again fails the next receive, & is held again
+	return (TRANSFER_PREVENTED == sendRes) ? STATUS_CODE_FAILURE : STATUS_CODE_SUCCESS;
+}
+
+static void endGameAndRoomSnapshot(workingThreadPackage* p_params, communicationResults gameResult)
+{
+	//Assert
+	assert(NULL != p_params);
+
+	if (COMMUNICATION_EXIT != gameResult) checkpointRoomSnapshot(p_params, ROOM_SNAPSHOT_EMPTY);
+	//A game the opponent quit keeps its numbers until here - a lingering initial number would pass for a resumed game's
+	resetThePlayer(p_params, PLAYER_RESET_GAME);
+}
+
 
 
 
 
-static void playSingleGamePhase(TCHAR* p_opponentInitialDigits, TCHAR* p_selfPlayerGuessDigits, SHORT* p_bullsAddress, SHORT* p_cowsAddress)
+void playSingleGamePhase(TCHAR* p_opponentInitialDigits, TCHAR* p_selfPlayerGuessDigits, SHORT* p_bullsAddress, SHORT* p_cowsAddress)
 {
 	int i = 0, j = 0, bulls = 0, cows = 0;
 	//Assert
@@ -28,4 +28,13 @@
 /// <returns>'communicationResults' code according to all of the Exit codes possible</returns>
 communicationResults WINAPI serverSideWorkerThreadRoutine(LPVOID lpParam);
 
+/// <summary>
+/// Description - This function conducts a single classic round of "Bulls and Cows" (4 different digits - the Game Room scores with its variant's scorer, GameVariantTools.c) by comparing the number(string representation)
+/// </summary>
+/// <param name="TCHAR* p_opponentInitialDigits - pointer to buffer containing an initial number of one player"></param>
+/// <param name="TCHAR*p_selfPlayerGuessDigits - pointer to buffer containing an guess number of the other player"></param>
+/// <param name="SHORT* p_bullsAddress - address of the number of bulls"></param>
+/// <param name="SHORT* p_cowsAddress - address of the number of cows"></param>
+void playSingleGamePhase(TCHAR* p_opponentInitialDigits, TCHAR* p_selfPlayerGuessDigits, SHORT* p_bullsAddress, SHORT* p_cowsAddress);
+
 #endif //__SERVER_SIDE_WORKER_THREAD_ROUTINE_H__
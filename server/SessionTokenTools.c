@@ -0,0 +1,302 @@
+/* SessionTokenTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the session tokens - a random
+		token a Client gets in SERVER_APPROVED & presents when it reconnects,
+		so a Client whose connection dropped in the middle of a game is handed
+		back to the Worker thread that holds its game, instead of losing it.
+		The tokens are kept in a fixed hash table of open addressing (linear
+		probing, backward shift deletion) - a reconnection is a single probe
+		sequence of a bucket or two, whatever the # of reconnections. A Worker
+		thread's token is replaced at its next Client's admission, so the table
+		never holds more tokens than Worker threads.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#define _CRT_RAND_S //rand_s(.) - the tokens must not be guessable
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "SessionTokenTools.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const ULONGLONG FIBONACCI_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+static const int NO_BUCKET = -1;
+
+// Global variables ------------------------------------------------------------
+//The session tokens hash table & its lock (a lookup also updates the bucket it finds - the lock is always owned exclusively)
+static sessionTableEntry g_sessionTable[SESSION_TABLE_CAPACITY];
+static int g_numOfSessions = 0;
+static volatile LONG g_numOfHeldSessions = 0;
+static SRWLOCK g_sessionTableLock = SRWLOCK_INIT;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function computes the bucket a token's probe sequence begins at (Fibonacci hashing)
+/// </summary>
+/// <param name="ULONGLONG token - the token"></param>
+/// <returns>the token's home bucket</returns>
+static int computeHomeBucket(ULONGLONG token);
+
+/// <summary>
+/// Description - This function finds the bucket of a token. Must be called with the table's lock owned
+/// </summary>
+/// <param name="ULONGLONG token - the token"></param>
+/// <returns>the token's bucket. NO_BUCKET if the token is not in the table</returns>
+static int findSessionBucket(ULONGLONG token);
+
+/// <summary>
+/// Description - This function removes the token of a bucket, shifting back the tokens of the probe sequence that follows it, so no lookup
+/// ever passes a deleted bucket (no tombstones). Must be called with the table's lock owned
+/// </summary>
+/// <param name="int bucket - the bucket to empty"></param>
+static void removeSessionBucket(int bucket);
+
+/// <summary>
+/// Description - This function draws a new random token (never 0, never a token that is in the table). Must be called with the table's lock owned
+/// </summary>
+/// <param name="ULONGLONG* p_token - output token"></param>
+/// <returns>True if succeeded. False otherwise</returns>
+static BOOL drawSessionToken(ULONGLONG* p_token);
+
+/// <summary>
+/// Description - This function inserts a token at the first empty bucket of its probe sequence. Must be called with the table's lock owned, and a bucket
+/// besides the last one empty
+/// </summary>
+/// <param name="ULONGLONG token - the token (not in the table)"></param>
+/// <param name="workingThreadPackage* p_package - the package of the Worker thread that serves the session"></param>
+static void insertSessionBucket(ULONGLONG token, workingThreadPackage* p_package);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL openSession(workingThreadPackage* p_package, char* p_tokenString)
+{
+	ULONGLONG token = 0;
+	int bucket = 0;
+	//Asserts
+	assert(NULL != p_package);
+	assert(NULL != p_tokenString);
+
+	AcquireSRWLockExclusive(&g_sessionTableLock);
+	//The package's previous Client is gone - its token is replaced
+	if (NO_BUCKET != (bucket = findSessionBucket(p_package->sessionToken))) removeSessionBucket(bucket);
+	p_package->sessionToken = 0;
+
+	//One bucket always stays empty, so every probe sequence ends
+	if ((SESSION_TABLE_CAPACITY - 1 <= g_numOfSessions) || (STATUS_CODE_FAILURE == drawSessionToken(&token))) {
+		ReleaseSRWLockExclusive(&g_sessionTableLock);
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to open a session for the admitted Client", g_numOfSessions, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	insertSessionBucket(token, p_package);
+	p_package->sessionToken = token;
+	ReleaseSRWLockExclusive(&g_sessionTableLock);
+
+	formatSessionToken(p_package, p_tokenString);
+	return STATUS_CODE_SUCCESS;
+}
+
+BOOL restoreSession(workingThreadPackage* p_package)
+{
+	//Assert
+	assert(NULL != p_package);
+
+	if (0 == p_package->sessionToken) return STATUS_CODE_SUCCESS; //The Client had no session
+
+	AcquireSRWLockExclusive(&g_sessionTableLock);
+	if ((SESSION_TABLE_CAPACITY - 1 <= g_numOfSessions) || (NO_BUCKET != findSessionBucket(p_package->sessionToken))) {
+		ReleaseSRWLockExclusive(&g_sessionTableLock);
+		p_package->sessionToken = 0;
+		LOG_EVENT(LOG_EVENT_FAILURE, "Failed to restore the session of a handed off Client", g_numOfSessions, 0);
+		return STATUS_CODE_FAILURE;
+	}
+	insertSessionBucket(p_package->sessionToken, p_package);
+	ReleaseSRWLockExclusive(&g_sessionTableLock);
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void formatSessionToken(const workingThreadPackage* p_package, char* p_tokenString)
+{
+	//Asserts
+	assert(NULL != p_package);
+	assert(NULL != p_tokenString);
+
+	_snprintf_s(p_tokenString, SESSION_TOKEN_STRING_LEN, _TRUNCATE, "%016llX", p_package->sessionToken);
+}
+
+SOCKET* holdSessionForReconnect(workingThreadPackage* p_package, HANDLE* p_h_abortEvents, int numOfAbortEvents)
+{
+	HANDLE h_waitedEvents[MAXIMUM_WAIT_OBJECTS];
+	HANDLE h_reattachEvent = NULL;
+	SOCKET* p_s_reattachedSocket = NULL;
+	int bucket = 0, e = 0;
+	//Asserts
+	assert(NULL != p_package);
+	assert(NULL != p_h_abortEvents);
+	assert((0 <= numOfAbortEvents) && (MAXIMUM_WAIT_OBJECTS > numOfAbortEvents));
+
+	//A Client without a session can't be reattached
+	if (0 == p_package->sessionToken) return NULL;
+	if (NULL == (h_reattachEvent = CreateEvent(NULL, FALSE, FALSE, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the session's reattach Event", GetLastError(), 0);
+		return NULL;
+	}
+
+	//From here on a CLIENT_REQUEST with the token is handed to this Worker thread
+	AcquireSRWLockExclusive(&g_sessionTableLock);
+	if (NO_BUCKET != (bucket = findSessionBucket(p_package->sessionToken))) {
+		g_sessionTable[bucket].state = SESSION_HELD;
+		g_sessionTable[bucket].h_reattachEvent = h_reattachEvent;
+		InterlockedIncrement(&g_numOfHeldSessions);
+	}
+	ReleaseSRWLockExclusive(&g_sessionTableLock);
+	if (NO_BUCKET == bucket) {
+		CloseHandle(h_reattachEvent);
+		return NULL;
+	}
+
+	LOG_EVENT(LOG_EVENT_CONNECTION, "Holding the game for the dropped Client", SESSION_RECONNECT_GRACE_PERIOD, 0);
+	h_waitedEvents[0] = h_reattachEvent;
+	for (e = 0; e < numOfAbortEvents; e++) h_waitedEvents[e + 1] = *(p_h_abortEvents + e);
+	if (WAIT_FAILED == WaitForMultipleObjects(numOfAbortEvents + 1, h_waitedEvents, FALSE, SESSION_RECONNECT_GRACE_PERIOD))
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to wait for the dropped Client to reconnect", GetLastError(), 0);
+
+	//Whatever ended the wait, a reconnection that was already handed over is taken (buckets may have shifted - the token is looked up again)
+	AcquireSRWLockExclusive(&g_sessionTableLock);
+	if (NO_BUCKET != (bucket = findSessionBucket(p_package->sessionToken))) {
+		p_s_reattachedSocket = g_sessionTable[bucket].p_s_reattachedSocket;
+		g_sessionTable[bucket].p_s_reattachedSocket = NULL;
+		g_sessionTable[bucket].h_reattachEvent = NULL;
+		g_sessionTable[bucket].state = SESSION_CONNECTED;
+		InterlockedDecrement(&g_numOfHeldSessions);
+	}
+	ReleaseSRWLockExclusive(&g_sessionTableLock);
+	CloseHandle(h_reattachEvent);
+
+	if (NULL != p_s_reattachedSocket) LOG_EVENT(LOG_EVENT_CONNECTION, "Dropped Client reconnected to its game", 0, 0);
+	return p_s_reattachedSocket;
+}
+
+BOOL isAnySessionHeld()
+{
+	return (0 < InterlockedCompareExchange(&g_numOfHeldSessions, 0, 0));
+}
+
+BOOL reattachSession(const char* p_tokenString, const char* p_playerName, SOCKET* p_s_socket)
+{
+	ULONGLONG token = 0;
+	char* p_tokenEnd = NULL;
+	int bucket = 0;
+	BOOL isReattached = STATUS_CODE_FAILURE;
+	//Asserts
+	assert(NULL != p_tokenString);
+	assert(NULL != p_playerName);
+	assert(NULL != p_s_socket);
+
+	//A token is exactly 16 hex digits
+	if (SESSION_TOKEN_STRING_LEN - 1 != strlen(p_tokenString)) return STATUS_CODE_FAILURE;
+	token = _strtoui64(p_tokenString, &p_tokenEnd, 16);
+	if (('\0' != *p_tokenEnd) || (0 == token)) return STATUS_CODE_FAILURE;
+
+	AcquireSRWLockExclusive(&g_sessionTableLock);
+	if ((NO_BUCKET != (bucket = findSessionBucket(token))) && (SESSION_HELD == g_sessionTable[bucket].state) &&
+		(NULL != g_sessionTable[bucket].p_package->p_selfPlayerName) && (0 == strcmp(p_playerName, g_sessionTable[bucket].p_package->p_selfPlayerName))) {
+		g_sessionTable[bucket].p_s_reattachedSocket = p_s_socket;
+		g_sessionTable[bucket].state = SESSION_REATTACHED;
+		SetEvent(g_sessionTable[bucket].h_reattachEvent);
+		isReattached = STATUS_CODE_SUCCESS;
+	}
+	ReleaseSRWLockExclusive(&g_sessionTableLock);
+
+	return isReattached;
+}
+
+
+
+
+//......................................Static functions..........................................
+
+static int computeHomeBucket(ULONGLONG token)
+{
+	return (int)((token * FIBONACCI_HASH_MULTIPLIER) >> (64 - SESSION_TABLE_BITS));
+}
+
+static int findSessionBucket(ULONGLONG token)
+{
+	int bucket = 0;
+
+	if (0 == token) return NO_BUCKET;
+	//The probe sequence ends at the token or at an empty bucket
+	for (bucket = computeHomeBucket(token); 0 != g_sessionTable[bucket].token; bucket = (bucket + 1) & (SESSION_TABLE_CAPACITY - 1))
+		if (token == g_sessionTable[bucket].token) return bucket;
+	return NO_BUCKET;
+}
+
+static void removeSessionBucket(int bucket)
+{
+	int hole = bucket, next = 0, home = 0;
+	//Assert
+	assert((0 <= bucket) && (SESSION_TABLE_CAPACITY > bucket));
+
+	//A token after the hole moves into it if its home bucket isn't between the hole & itself (it would no longer be found past the hole)
+	for (next = (bucket + 1) & (SESSION_TABLE_CAPACITY - 1); 0 != g_sessionTable[next].token; next = (next + 1) & (SESSION_TABLE_CAPACITY - 1)) {
+		home = computeHomeBucket(g_sessionTable[next].token);
+		if (((next - home) & (SESSION_TABLE_CAPACITY - 1)) >= ((next - hole) & (SESSION_TABLE_CAPACITY - 1))) {
+			g_sessionTable[hole] = g_sessionTable[next];
+			hole = next;
+		}
+	}
+	memset(&g_sessionTable[hole], 0, sizeof(sessionTableEntry));
+	g_numOfSessions--;
+}
+
+static BOOL drawSessionToken(ULONGLONG* p_token)
+{
+	unsigned int high = 0, low = 0;
+	//Assert
+	assert(NULL != p_token);
+
+	do {
+		if ((0 != rand_s(&high)) || (0 != rand_s(&low))) return STATUS_CODE_FAILURE;
+		*p_token = ((ULONGLONG)high << 32) | low;
+	} while ((0 == *p_token) || (NO_BUCKET != findSessionBucket(*p_token)));
+
+	return STATUS_CODE_SUCCESS;
+}
+
+static void insertSessionBucket(ULONGLONG token, workingThreadPackage* p_package)
+{
+	int bucket = 0;
+	//Assert
+	assert((0 != token) && (NULL != p_package));
+
+	for (bucket = computeHomeBucket(token); 0 != g_sessionTable[bucket].token; bucket = (bucket + 1) & (SESSION_TABLE_CAPACITY - 1));
+	g_sessionTable[bucket].token = token;
+	g_sessionTable[bucket].p_package = p_package;
+	g_sessionTable[bucket].state = SESSION_CONNECTED;
+	g_sessionTable[bucket].h_reattachEvent = NULL;
+	g_sessionTable[bucket].p_s_reattachedSocket = NULL;
+	g_numOfSessions++;
+}
@@ -0,0 +1,74 @@
+/* SessionTokenTools.h
+------------------------------------------------------------------
+	Module Description - header module for SessionTokenTools.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __SESSION_TOKEN_TOOLS_H__
+#define __SESSION_TOKEN_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function opens a session for the Worker thread's newly admitted Client: a new random token replaces the package's previous one
+/// in the session tokens hash table, and is formatted for SERVER_APPROVED
+/// </summary>
+/// <param name="workingThreadPackage* p_package - the package of the Worker thread that serves the Client"></param>
+/// <param name="char* p_tokenString - output buffer of SESSION_TOKEN_STRING_LEN characters"></param>
+/// <returns>True if succeeded. False otherwise (the Client is served without a session)</returns>
+BOOL openSession(workingThreadPackage* p_package, char* p_tokenString);
+
+/// <summary>
+/// Description - This function registers the session a handed off Client had in the previous Server process (hot restart) - its token, restored
+/// into the package, is inserted into this process's session tokens hash table, so the Client can still be reattached
+/// </summary>
+/// <param name="workingThreadPackage* p_package - the package of the Worker thread that resumes the Client's connection"></param>
+/// <returns>True if succeeded (or the Client had no session). False otherwise (the token is dropped - the Client is served without a session)</returns>
+BOOL restoreSession(workingThreadPackage* p_package);
+
+/// <summary>
+/// Description - This function formats the token of the Worker thread's session, as sent in SERVER_APPROVED
+/// </summary>
+/// <param name="const workingThreadPackage* p_package - the package of the Worker thread"></param>
+/// <param name="char* p_tokenString - output buffer of SESSION_TOKEN_STRING_LEN characters"></param>
+void formatSessionToken(const workingThreadPackage* p_package, char* p_tokenString);
+
+/// <summary>
+/// Description - This function holds the Worker thread's game for its dropped Client: it waits up to SESSION_RECONNECT_GRACE_PERIOD for a
+/// reconnection with the session's token to be handed over (reattachSession(.)), unless one of the abort Events is signaled first
+/// </summary>
+/// <param name="workingThreadPackage* p_package - the package of the holding Worker thread"></param>
+/// <param name="HANDLE* p_h_abortEvents - Events that end the hold (e.g. the Game Room's quit Event, 'Exit' & 'Error')"></param>
+/// <param name="int numOfAbortEvents - # of abort Events (up to MAXIMUM_WAIT_OBJECTS - 1)"></param>
+/// <returns>pointer to the reconnected Client's SOCKET struct (now owned by the caller). NULL if no Client reconnected</returns>
+SOCKET* holdSessionForReconnect(workingThreadPackage* p_package, HANDLE* p_h_abortEvents, int numOfAbortEvents);
+
+/// <summary>
+/// Description - This function tells whether any Worker thread holds a game for its dropped Client at the moment
+/// </summary>
+/// <returns>True if a session is held. False otherwise</returns>
+BOOL isAnySessionHeld();
+
+/// <summary>
+/// Description - This function hands a reconnected Client's connection over to the Worker thread that holds its game - the token must belong to a
+/// held session of a player of the same name. The lookup is a single probe sequence of the session tokens hash table
+/// </summary>
+/// <param name="const char* p_tokenString - the token the Client presented in CLIENT_REQUEST"></param>
+/// <param name="const char* p_playerName - the name the Client presented in CLIENT_REQUEST"></param>
+/// <param name="SOCKET* p_s_socket - the reconnected Client's socket (owned by the holding Worker thread if succeeded)"></param>
+/// <returns>True if handed over. False otherwise (the Client is admitted as a new one)</returns>
+BOOL reattachSession(const char* p_tokenString, const char* p_playerName, SOCKET* p_s_socket);
+
+
+#endif //__SESSION_TOKEN_TOOLS_H__
@@ -4,7 +4,7 @@
 		Server side listening socket & for accepting new clients with new sockets
 		and create Worker threads to communicate with Clients Speaker threads.
 		Also it initiates an 'Exit' thread routine to receive an STDin input of 
-		'exit' when it arrives.
+		'exit' when it arrives, and the admin endpoint serving the telemetry.
 ---------------------------------------------------------------------------------
 */
 
@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <malloc.h>
 #include <assert.h>
 
 #ifndef WIN32_LEAN_AND_MEAN
@@ -35,6 +36,12 @@
 #include "MemoryHandling.h"
 #include "ServerClientsTools.h"
 #include "ServerSideWorkerThreadRoutine.h"
+#include "GameRoomTools.h"
+#include "EventLoggingTools.h"
+#include "AdminEndpointTools.h"
+#include "SpectatorFanoutTools.h"
+#include "HotRestartTools.h"
+#include "SessionTokenTools.h"
 
 
 
@@ -88,12 +95,18 @@ HANDLE* g_p_h_connectedClientsNumMutex = NULL;
 //HANDLE* p_h_exitErrorEvent = NULL;
 HANDLE* g_p_h_exitEvent = NULL;
 HANDLE* g_p_h_errorEvent = NULL;
+//The hot restart Events - 'restart' signals the first, and a cancelled restart the second (both manual-reset & initialy non-signaled)
+HANDLE* g_p_h_handoffEvent = NULL;
+HANDLE* g_p_h_handoffCancelEvent = NULL;
 
 
 //Third, all the GameSession.txt resource synchronous objects' pointers will also be defined as global pointers for ease
 HANDLE* g_p_h_firstPlayerEvent = NULL;
 HANDLE* g_p_h_secondPlayerEvent = NULL;
 
+//Fourth, the Game Room state (phase, quit flags, epoch) shared by the two Worker threads of a game, and its quit Event
+gameRoom* g_p_gameRoom = NULL;
+
 
 
 
@@ -146,13 +159,17 @@ static BOOL createThreadsHandlesAndTheirIds(HANDLE** p_p_h_clientsThreadsHandles
 /// The number of "Currently Connected Clients"
 /// It will also call the createThreadPackageAndInsertSynchronousObjectsPointerToThem(.) to bind all pointer to a workingThreadPackage for every potential Worker thread
 /// </summary>
+/// <param name="const gameVariant* p_gameVariant - the rules of the Game Room's games"></param>
 /// <returns>pointer to the created and updated workingThreadPackage array</returns>
-static workingThreadPackage** createSynchronousObjectsAndInsertTheirPointersToThreadPackages();
+static workingThreadPackage** createSynchronousObjectsAndInsertTheirPointersToThreadPackages(const gameVariant* p_gameVariant);
 /// <summary>
-/// Description - this function will create for every Worker thread indevidually his own input package struct, and bind the Synch objects and resource pointers to it
+/// Description - this function will create for every Worker thread indevidually his own input package struct, inside the contiguous (cache line aligned)
+/// packages block, and bind the Synch objects and resource pointers to it
 /// </summary>
+/// <param name="workingThreadPackage* p_threadPackagesBlock - pointer to the zeroed block holding the packages of ALL Worker threads"></param>
+/// <param name="int packageIndex - index of the Worker thread whose package is created"></param>
 /// <returns>pointer to a created and updated workingThreadPackage of some thread</returns>
-static workingThreadPackage* createThreadPackageAndInsertSynchronousObjectsPointerToThem();
+static workingThreadPackage* createThreadPackageAndInsertSynchronousObjectsPointerToThem(workingThreadPackage* p_threadPackagesBlock, int packageIndex);
 /// <summary>
 /// Description - Mutex synch object creation, not initially own and un-named
 /// </summary>
@@ -177,6 +194,15 @@ static int findFirstUnusedThreadSlot(HANDLE* p_h_clientsThreadsHandles);
 /// <returns>operation result: KEEP GOING if successful, something else if failed</returns>
 static int findIdleWorkerThreadForTheNewConnectedClientAndInitiate(SOCKET* p_s_acceptSocket/*Stack mem.*/, HANDLE* p_h_clientsThreadsHandles, LPDWORD p_threadIds, workingThreadPackage** p_p_threadPackages);
 
+/// <summary>
+/// Description - This function checks whether a connection that found no idle Worker thread is a dropped Client reconnecting to the game its Worker
+/// thread holds (the held player's slot is its own Worker thread's). Only while a game is held, the main thread awaits the connection's CLIENT_REQUEST
+/// (SESSION_REATTACH_REQUEST_TIMEOUT at most) & hands a request with a held session's token over to the holding Worker thread
+/// </summary>
+/// <param name="SOCKET* p_s_acceptSocket - the accepted socket (owned by the holding Worker thread if succeeded)"></param>
+/// <returns>True if the connection was handed over. False otherwise (the caller drops it)</returns>
+static BOOL reattachConnectionWithoutIdleWorkerThread(SOCKET* p_s_acceptSocket);
+
 /// <summary>
 /// Description - This function validates the status of the 'Exit' 'Error' events and operates accordigly - KEEP GOING is continue listening loop
 /// </summary>
@@ -213,8 +239,8 @@ static int threadsStatusValidationAndHandlingBeforeExiting(HANDLE* p_h_clientsTh
 /// <param name="LPDWORD p_threadIds - pointer to the Worker threads ID array"></param>
 /// <param name="HANDLE* p_h_exitThread - pointer to  exit  thread handle"></param>
 /// <param name="p_p_threadPackages - pointer the Worker threads input package array"></param>
-/// <returns>True if Server operation succeeded. False if otherwise</returns>
-static BOOL cleanupAndExit(int exitFlag,
+/// <returns>True if Server operation succeeded. False if otherwise. STATUS_SERVER_HANDOFF if handed off (the parked Worker threads are left running)</returns>
+static int cleanupAndExit(int exitFlag,
 	SOCKET* p_s_mainServerSocket,
 	SOCKADDR_IN* p_service,
 	fd_set* p_serverListeningSocketSet,
@@ -226,7 +252,7 @@ static BOOL cleanupAndExit(int exitFlag,
 
 // Functions definitions -------------------------------------------------------
 
-BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
+int setCommmunicationServerSide(unsigned short serverPortNumber, const gameVariant* p_gameVariant)
 {
 	//Winsock connectivity variables & pointers
 	WSADATA wsaData;
@@ -241,7 +267,7 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 	//Working Thread package - Synchronous objects handles pointers & "accept" socket pointer
 	workingThreadPackage** p_p_threadPackages = NULL;
 	//Others
-	int selectResult = 0, exitFlag = 0;
+	int selectResult = 0, exitFlag = 0, c = 0;
 	
 	// Input integrity validation
 	//maybe skip
@@ -261,7 +287,9 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 	//		& initiate listening to incoming Clients connections. 
 	// Note: This function updates BOTH a SOCKET & a SOCKADDR_IN pointers and pointes them to an allocated & updated SOCKET & SOCKADDR_IN 
 	//		 structs respectively. The SOCKET created is the Server's listening socket.
-	if (STATUS_CODE_FAILURE == socketCreationAndLocalAddressBindingAndListening(&p_s_mainServerSocket ,&p_service, serverPortNumber)) {
+	// A Server handed off by the previous Server process (hot restart) takes over its listening socket instead - already bound & listening.
+	if ((TRUE == isHandedOffServer()) ? (STATUS_CODE_FAILURE == takeOverHandedOffListeningSocket(&p_s_mainServerSocket, &p_service)) :
+		(STATUS_CODE_FAILURE == socketCreationAndLocalAddressBindingAndListening(&p_s_mainServerSocket ,&p_service, serverPortNumber))) {
 		if (SOCKET_ERROR == WSACleanup())
 			printf("Error: Failed to close Winsocket, with error code no. %ld.\nExiting...\n\n", WSAGetLastError());
 		return STATUS_CODE_FAILURE;
@@ -305,7 +333,7 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 	//	creating the objects with WINapi. Also, this function will place the relevant pointers into the Working threads inputs struct.
 	//NOTE: some of these sync objects' pointers are defined as global, because the main Server thread & the Exit\Error thread will use 
 	//		some of these objects
-	if (NULL == (p_p_threadPackages = createSynchronousObjectsAndInsertTheirPointersToThreadPackages())) {
+	if (NULL == (p_p_threadPackages = createSynchronousObjectsAndInsertTheirPointersToThreadPackages(p_gameVariant))) {
 		
 		closeListeningSocketProcedure(p_s_mainServerSocket, p_service, p_serverListeningSocketSet, p_clientsAcceptSelectTimeout);
 		free(p_h_clientsThreadsHandles);
@@ -336,6 +364,27 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 		return STATUS_CODE_FAILURE;
 	}
 
+	//Initiate the admin endpoint - the live telemetry is served on the next port. Games are served even if it fails (e.g. the port is taken)
+	if (STATUS_CODE_SUCCESS == startAdminEndpoint(serverPortNumber + ADMIN_ENDPOINT_PORT_OFFSET, g_p_currentNumOfConnectedClients, g_p_gameRoom))
+		printf("Serving telemetry at http://%s:%hu/metrics\n", SERVER_ADDRESS_STR, (unsigned short)(serverPortNumber + ADMIN_ENDPOINT_PORT_OFFSET));
+	else
+		printf("Warning: The admin endpoint was not started, the Server runs without it\n");
+	//Initiate the spectators fan-out on the port after it. Games are served even if it fails
+	if (STATUS_CODE_SUCCESS == startSpectatorFanout(serverPortNumber + SPECTATOR_ENDPOINT_PORT_OFFSET))
+		printf("Spectators may watch on port %hu\n", (unsigned short)(serverPortNumber + SPECTATOR_ENDPOINT_PORT_OFFSET));
+	else
+		printf("Warning: The spectators fan-out was not started, the Server runs without spectators\n");
+
+
+	//The Clients handed off by the previous Server process resume with their Worker threads' state - all threads are idle yet, so the c-th
+	// connection is served by the c-th Worker thread, whose package is restored
+	if (TRUE == isHandedOffServer()) {
+		restoreHandedOffGameRoom(g_p_gameRoom);
+		for (c = 0; (c < fetchNumOfHandedOffConnections()) && (KEEP_GOING == exitFlag); c++)
+			exitFlag = (NULL == (p_s_acceptSocket = restoreHandedOffConnection(c, *(p_p_threadPackages + c)))) ? STATUS_SERVER_ERROR :
+				findIdleWorkerThreadForTheNewConnectedClientAndInitiate(p_s_acceptSocket, p_h_clientsThreadsHandles, p_threadIds, p_p_threadPackages);
+		printf("Took over the Server with %d Client(s)\n", c);
+	}
 
 	printf("Waiting for a client to connect... \n");
 	
@@ -382,7 +431,7 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 			}
 
 			// A Client (player) has been Accepted into a connection with the Server, and the communication between then was trasffered to a new socket
-			printf("Client Connected.\n");
+			LOG_EVENT(LOG_EVENT_CONNECTION, "Client Connected", 0, 0);
 			exitFlag = findIdleWorkerThreadForTheNewConnectedClientAndInitiate(p_s_acceptSocket, p_h_clientsThreadsHandles, p_threadIds, p_p_threadPackages);
 			//....Proceed to validate "Exit"\"Error" Events' status....
 			
@@ -417,6 +466,10 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 		/*....................Check whether the "Exit"\"Error" Event was signaled		     */
 		/* --------------------------------------------------------------------------------- */
 		exitFlag = validateErrorExitEventsStatus(exitFlag);
+		//'restart' - hand the Server over to a new Server process. If it fails, the Server goes on
+		if ((STATUS_SERVER_HANDOFF == exitFlag) &&
+			(STATUS_CODE_FAILURE == handOffServerToNewProcess(p_s_mainServerSocket, p_h_clientsThreadsHandles, p_p_threadPackages, serverPortNumber, p_gameVariant)))
+			exitFlag = validateErrorExitEventsStatus(KEEP_GOING);
 		
 
 
@@ -449,15 +502,28 @@ BOOL setCommmunicationServerSide(unsigned short serverPortNumber)
 //0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0o0    STDin "exit" inputted validation thread routing 
 static BOOL WINAPI exitErrorThreadRoutine(LPVOID lpParam)
 {
-	char inputFromServerUser[] = "null"; //"null" was picked arbitrary in order to initialize the variable kept in process Stack
+	char inputFromServerUser[SERVER_COMMAND_LEN] = "null"; //"null" was picked arbitrary in order to initialize the variable kept in process Stack
 	//......Parameters are not to be used - Expecting NULL parameters
 
 
 
 	//Initiate STDin Read. The operation will Block the thread until a string will be inserted by
 	//	The Server application's(process) user
-	scanf_s("%s", &inputFromServerUser, EXIT_GUESS_LEN); //2 things: 1) Might need to insert to a loop in case of User's typos 2) scanf_s retval 'CHECK'
-	//printf("\n%s\n", inputFromServerUser);
+	while (TRUE) {
+		//STDin was closed (EOF) or the input can't be read - no more commands will come
+		if (1 != scanf_s("%s", &inputFromServerUser, SERVER_COMMAND_LEN)) break;
+		//printf("\n%s\n", inputFromServerUser);
+		if (!STRINGS_ARE_EQUAL(inputFromServerUser, "restart", SERVER_COMMAND_LEN)) break;
+
+		//'restart' - the Worker threads park & the main thread hands the Server over to a new Server process (HotRestartTools.c).
+		//	If the restart is cancelled, the Server goes on & this thread awaits the next command
+		ResetEvent(*g_p_h_handoffCancelEvent);
+		if (SET_EVENT_TO_SIGNALED_STATE_FAILED == SetEvent(*g_p_h_handoffEvent)) {
+			printf("Error: Failed to set 'RESTART' event to signaled state, with error code no. %ld.\n", GetLastError());
+			continue;
+		}
+		printf("Restart requested - the Clients will be handed over to a new Server process\n");
+	}
 
 	//Validate "exit" was inserted
 	if (STRINGS_ARE_EQUAL(inputFromServerUser, "exit", EXIT_GUESS_LEN)) {
@@ -694,9 +760,10 @@ static BOOL createThreadsHandlesAndTheirIds(HANDLE** p_p_h_clientsThreadsHandles
 	return STATUS_CODE_SUCCESS;
 }
 
-static workingThreadPackage** createSynchronousObjectsAndInsertTheirPointersToThreadPackages()
+static workingThreadPackage** createSynchronousObjectsAndInsertTheirPointersToThreadPackages(const gameVariant* p_gameVariant)
 {
 	workingThreadPackage** p_p_threadPackages = NULL;
+	workingThreadPackage* p_threadPackagesBlock = NULL;
 	int i = 0;
 	//HANDLE* p_h_gameSessionFileMutex = NULL, * p_h_firstPlayerEvent = NULL, * p_h_secondPlayerEvent = NULL;
 
@@ -788,10 +855,79 @@ static workingThreadPackage** createSynchronousObjectsAndInsertTheirPointersToTh
 		closeHandleProcedure(g_p_h_exitEvent);
 		return  NULL;
 	}
+	//Allocating dynamic memory (Heap) for the hot restart Events Handles & Creating the Events and fetching their handles' pointers
+	if (NULL == (g_p_h_handoffEvent = allocateMemoryForHandleAndCreateEvent(
+		MANUAL_RESET,					/* when set to signal, ALL Worker threads should park at their next wait */
+		INITIALLY_NON_SIGNALED,			/* only when 'restart' is inserted to STDin */
+		NULL))) {						/* un-named */
+		printf("Error: Failed to allocate memory for the 'restart' notifier Event Handle & to create the Event object.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		free(p_p_threadPackages);
+		free(g_p_currentNumOfConnectedClients);
+		closeHandleProcedure(g_p_h_connectedClientsNumMutex);
+		closeHandleProcedure(g_p_h_firstPlayerEvent);
+		closeHandleProcedure(g_p_h_secondPlayerEvent);
+		closeHandleProcedure(g_p_h_exitEvent);
+		closeHandleProcedure(g_p_h_errorEvent);
+		return  NULL;
+	}
+	if (NULL == (g_p_h_handoffCancelEvent = allocateMemoryForHandleAndCreateEvent(
+		MANUAL_RESET,					/* when set to signal, ALL parked Worker threads should go on */
+		INITIALLY_NON_SIGNALED,			/* only when a restart is cancelled */
+		NULL))) {						/* un-named */
+		printf("Error: Failed to allocate memory for the 'restart' cancel Event Handle & to create the Event object.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		free(p_p_threadPackages);
+		free(g_p_currentNumOfConnectedClients);
+		closeHandleProcedure(g_p_h_connectedClientsNumMutex);
+		closeHandleProcedure(g_p_h_firstPlayerEvent);
+		closeHandleProcedure(g_p_h_secondPlayerEvent);
+		closeHandleProcedure(g_p_h_exitEvent);
+		closeHandleProcedure(g_p_h_errorEvent);
+		closeHandleProcedure(g_p_h_handoffEvent);
+		return  NULL;
+	}
+
+
+
+	//0o0o0o0o0o0  Resource 3 0o0o0o0o0o0
+	//Allocating dynamic memory (Heap) for the Game Room state (& its games variant) & Creating its quit Event
+	if (NULL == (g_p_gameRoom = allocateMemoryForGameRoomAndCreateQuitEvent(p_gameVariant))) {
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		free(p_p_threadPackages);
+		free(g_p_currentNumOfConnectedClients);
+		closeHandleProcedure(g_p_h_connectedClientsNumMutex);
+		closeHandleProcedure(g_p_h_firstPlayerEvent);
+		closeHandleProcedure(g_p_h_secondPlayerEvent);
+		closeHandleProcedure(g_p_h_exitEvent);
+		closeHandleProcedure(g_p_h_errorEvent);
+		closeHandleProcedure(g_p_h_handoffEvent);
+		closeHandleProcedure(g_p_h_handoffCancelEvent);
+		return  NULL;
+	}
+
+	//0o0o0o0o0o0  Worker threads packages 0o0o0o0o0o0
+	//Allocating ONE contiguous block for the packages of all Worker threads. Every package starts on its own cache line (CACHE_ALIGNED),
+	//	so neighbouring Worker threads never write the same cache line (no false sharing), and a game round touches only its package's hot lines
+	if (NULL == (p_threadPackagesBlock = (workingThreadPackage*)_aligned_malloc(sizeof(workingThreadPackage) * NUM_OF_WORKER_THREADS, CACHE_LINE_SIZE))) {
+		printf("Error: Failed to allocate memory for the workingthreadPackage structs block.\n");
+		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
+		free(p_p_threadPackages);
+		free(g_p_currentNumOfConnectedClients);
+		closeHandleProcedure(g_p_h_connectedClientsNumMutex);
+		closeHandleProcedure(g_p_h_firstPlayerEvent);
+		closeHandleProcedure(g_p_h_secondPlayerEvent);
+		closeHandleProcedure(g_p_h_exitEvent);
+		closeHandleProcedure(g_p_h_errorEvent);
+		closeHandleProcedure(g_p_h_handoffEvent);
+		closeHandleProcedure(g_p_h_handoffCancelEvent);
+		freeTheGameRoom(g_p_gameRoom);
+		return  NULL;
+	}
+	memset(p_threadPackagesBlock, 0, sizeof(workingThreadPackage) * NUM_OF_WORKER_THREADS);
 
 	for (i; i < NUM_OF_WORKER_THREADS; i++) {
-		if (NULL == (*(p_p_threadPackages + i) = createThreadPackageAndInsertSynchronousObjectsPointerToThem()));
-			//cLEAR MEMORY
+		*(p_p_threadPackages + i) = createThreadPackageAndInsertSynchronousObjectsPointerToThem(p_threadPackagesBlock, i);
 	}
 
 	//Worker thread inputs struct(package), the input for the thread in the Server that communicates with a Client, was created successfuly
@@ -801,16 +937,14 @@ static workingThreadPackage** createSynchronousObjectsAndInsertTheirPointersToTh
 
 }
 
-static workingThreadPackage* createThreadPackageAndInsertSynchronousObjectsPointerToThem()
+static workingThreadPackage* createThreadPackageAndInsertSynchronousObjectsPointerToThem(workingThreadPackage* p_threadPackagesBlock, int packageIndex)
 {
 	workingThreadPackage* p_threadPackage = NULL;
+	//Assert
+	assert(NULL != p_threadPackagesBlock);
 
-	//workingthreadPackage struct dynamic memory allocation
-	if (NULL == (p_threadPackage = (workingThreadPackage*)calloc(sizeof(workingThreadPackage), SINGLE_OBJECT))) {
-		printf("Error: Failed to allocate memory for a workingthreadPackage struct.\n");
-		printf("At file: %s\nAt line number: %d\nAt function: %s\n\n\n", __FILE__, __LINE__, __func__);
-		return NULL;
-	}
+	//workingthreadPackage struct is the package's cell in the (already zeroed) packages block
+	p_threadPackage = p_threadPackagesBlock + packageIndex;
 
 	//Update the Working thread package struct's fields with ALL the needed pointers 
 	p_threadPackage->p_currentNumOfConnectedClients = g_p_currentNumOfConnectedClients;
@@ -819,6 +953,10 @@ static workingThreadPackage* createThreadPackageAndInsertSynchronousObjectsPoint
 	p_threadPackage->p_h_secondPlayerEvent = g_p_h_secondPlayerEvent;
 	p_threadPackage->p_h_exitEvent = g_p_h_exitEvent;
 	p_threadPackage->p_h_errorEvent = g_p_h_errorEvent;
+	p_threadPackage->p_h_handoffEvent = g_p_h_handoffEvent;
+	p_threadPackage->p_h_handoffCancelEvent = g_p_h_handoffCancelEvent;
+	p_threadPackage->p_gameRoom = g_p_gameRoom;
+	p_threadPackage->snapshotSlot = packageIndex;
 
 
 	//Worker thread inputs struct(package), the input for the thread in the Server that communicates with a Client, was created successfuly
@@ -930,7 +1068,8 @@ static int findIdleWorkerThreadForTheNewConnectedClientAndInitiate(SOCKET* p_s_a
 	// Find the index of the first idle Worker Server thread, to attach to newly connected Client
 	idleWorkingThreadIndex = findFirstUnusedThreadSlot(p_h_clientsThreadsHandles);
 	switch (idleWorkingThreadIndex){
-	case NUM_OF_WORKER_THREADS: //no slot is available 
+	case NUM_OF_WORKER_THREADS: //no slot is available - unless it is a dropped Client reconnecting to its held game
+		if (STATUS_CODE_SUCCESS == reattachConnectionWithoutIdleWorkerThread(p_s_acceptSocket)) break;
 		printf("No slots available for client, dropping the connection.\n");
 		//Closing the socket, dropping the connection & keep running the main loop...
 		closeSocketProcedure(p_s_acceptSocket);
@@ -991,6 +1130,28 @@ static int findIdleWorkerThreadForTheNewConnectedClientAndInitiate(SOCKET* p_s_a
 	return KEEP_GOING;
 }
 
+static BOOL reattachConnectionWithoutIdleWorkerThread(SOCKET* p_s_acceptSocket)
+{
+	message* p_receivedMessageFromClient = NULL;
+	BOOL isReattached = STATUS_CODE_FAILURE;
+	//Assert
+	assert(NULL != p_s_acceptSocket);
+
+	//A dropped Client can return only to a held game - otherwise the connection is dropped without waiting for its message
+	if (FALSE == isAnySessionHeld()) return STATUS_CODE_FAILURE;
+
+	//Receive the "CLIENT_REQUEST" message (its 1st parameter is the player's name & the 2nd, if any, is the session token)
+	if (TRANSFER_SUCCEEDED != receiveMessage(p_s_acceptSocket, &p_receivedMessageFromClient, SESSION_REATTACH_REQUEST_TIMEOUT)) return STATUS_CODE_FAILURE;
+	if ((CLIENT_REQUEST_NUM == p_receivedMessageFromClient->messageType) && (NULL != p_receivedMessageFromClient->p_parameters) &&
+		(NULL != p_receivedMessageFromClient->p_parameters->p_nextParameter))
+		isReattached = reattachSession(p_receivedMessageFromClient->p_parameters->p_nextParameter->p_parameter,
+			p_receivedMessageFromClient->p_parameters->p_parameter, p_s_acceptSocket);
+	//Free the received message arranged in a 'message' struct
+	freeTheMessage(p_receivedMessageFromClient);
+
+	return isReattached;
+}
+
 static int validateErrorExitEventsStatus(int exitFlag)
 {
 	switch (WaitForSingleObject(*g_p_h_errorEvent, SAMPLE)) {
@@ -999,7 +1160,9 @@ static int validateErrorExitEventsStatus(int exitFlag)
 		if (STATUS_SERVER_ERROR != exitFlag)
 			switch (WaitForSingleObject(*g_p_h_exitEvent, SAMPLE)) {
 				//either an 'exit' from STDin or
-			case WAIT_TIMEOUT: break; //proceed... to KEEP_GOING
+			case WAIT_TIMEOUT: //proceed... to KEEP_GOING, unless 'restart' was entered
+				if (WAIT_OBJECT_0 == WaitForSingleObject(*g_p_h_handoffEvent, SAMPLE)) return STATUS_SERVER_HANDOFF;
+				break;
 			case WAIT_OBJECT_0: return STATUS_SERVER_EXIT;
 			default:
 				printf("Error: Failed to sample Server-side 'EXIT' Event's status using WaitForSingleObject(.), with error code no. %ld.", GetLastError());
@@ -1149,7 +1312,7 @@ static int threadsStatusValidationAndHandlingBeforeExiting(HANDLE* p_h_clientsTh
 
 }
 
-static BOOL cleanupAndExit(int exitFlag,
+static int cleanupAndExit(int exitFlag,
 	SOCKET* p_s_mainServerSocket,
 	SOCKADDR_IN* p_service,
 	fd_set* p_serverListeningSocketSet,
@@ -1160,6 +1323,15 @@ static BOOL cleanupAndExit(int exitFlag,
 	workingThreadPackage** p_p_threadPackages)
 {
 	printf("exit Flag %d\n\n", exitFlag);
+	//Stop serving the telemetry before its sources (connected Clients count, Game Room) are freed
+	stopAdminEndpoint();
+	//Handed off to a new Server process - the parked Worker threads still use their packages & the Clients' sockets belong to the new process too,
+	//	so only this process's listening socket & the spectators fan-out are closed (the ports are re-bound by the new process). The rest goes with the process
+	if (STATUS_SERVER_HANDOFF == exitFlag) {
+		stopSpectatorFanout();
+		closeListeningSocketProcedure(p_s_mainServerSocket, p_service, p_serverListeningSocketSet, p_clientsAcceptSelectTimeout);
+		return STATUS_SERVER_HANDOFF;
+	}
 	switch (exitFlag) {
 	case -1: // == STATUS_SERVER_ERROR
 		//After notifying all existing threads, countdown begins... 
@@ -1172,6 +1344,8 @@ static BOOL cleanupAndExit(int exitFlag,
 		exitFlag = threadsStatusValidationAndHandlingBeforeExiting(p_h_clientsThreadsHandles, p_h_exitThread, EXIT_CASE_THREADS_TIMEOUT);
 		break;
 	}	
+	//The Worker threads ended - nothing is published anymore
+	stopSpectatorFanout();
 
 	//Clean Synchronous objects & Close their Handles & Free the Worker threads inputs structs memory
 	freeTheWorkingThreadPackages(p_p_threadPackages);
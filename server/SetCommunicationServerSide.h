@@ -28,7 +28,9 @@
 /// Will terminate all threads and free memory of the program and 'exit' is inserted or a fatal error occurs
 /// </summary>
 /// <param name="unsigned short serverPortNumber - port number 0 -65536"></param>
-/// <returns>True if operation succeeded, False if otherwise</returns>
-BOOL setCommmunicationServerSide(unsigned short serverPortNumber);
+/// <param name="const gameVariant* p_gameVariant - the rules of the games the Server plays"></param>
+/// <returns>True if operation succeeded, False if otherwise. STATUS_SERVER_HANDOFF if the Server was handed over to a new Server process - its parked
+/// Worker threads still run & use the Server's state until the process leaves</returns>
+int setCommmunicationServerSide(unsigned short serverPortNumber, const gameVariant* p_gameVariant);
 
 #endif //__SERVER_CLIENTS_TOOLS_H__
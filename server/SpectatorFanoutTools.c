@@ -0,0 +1,550 @@
+/* SpectatorFanoutTools.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the spectators fan-out. Spectators
+		connect to their own port (the game port + SPECTATOR_ENDPOINT_PORT_OFFSET)
+		and only watch the Game Room - they never send. The Game Room opener's
+		Worker thread encodes every round result & outcome ONCE into an immutable,
+		reference-counted frame & pushes it onto an interlocked list. A single
+		fan-out thread queues a reference to the frame for every spectator (no
+		per-spectator encoding, nor copy) and sends it with non-blocking send(.)s
+		straight from the shared frame - the last spectator to send it frees it.
+		A spectator that falls SPECTATOR_QUEUE_CAPACITY frames behind is dropped,
+		so a slow spectator never slows the game, nor the other spectators.
+--------------------------------------------------------------------------------------
+*/
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "SpectatorFanoutTools.h"
+#include "MessagesTransferringTools.h"
+#include "MemoryHandling.h"
+#include "EventLoggingTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL MANUAL_RESET = TRUE;
+static const BOOL AUTO_RESET = FALSE;
+static const BOOL INITIALLY_NON_SIGNALED = FALSE;
+static const BOOL INETPTONS_SUCCESS = 1;
+
+static const DWORD SPECTATOR_THREAD_STOP_TIMEOUT_MS = 5000;
+static const int SPECTATOR_LISTEN_BACKLOG = 16;
+static const int NUM_OF_FANOUT_WAKE_UPS = 3;	// the stop Event, the frame published Event & the network Event
+
+
+// Global variables ------------------------------------------------------------
+//Fan-out thread & the Events that wake it up - the network Event is selected for the listening socket (FD_ACCEPT) & for every spectator socket
+static HANDLE g_h_spectatorThread = NULL;
+static HANDLE g_h_spectatorStopEvent = NULL;
+static HANDLE g_h_framePublishedEvent = NULL;
+static WSAEVENT g_h_spectatorNetworkEvent = WSA_INVALID_EVENT;
+static SOCKET g_s_spectatorListeningSocket = INVALID_SOCKET;
+
+//Frames published by the Game Room opener & not fanned out yet (LIFO)
+static SLIST_HEADER g_publishedFrames;
+//Spectator slots (touched ONLY by the fan-out thread) & the # of the taken ones (read by the publishers, so nothing is encoded while no one watches)
+static spectator* g_p_spectators = NULL;
+static volatile LONG g_numOfSpectators = 0;
+//Replies of a new spectator, encoded once
+static spectatorFrame* g_p_approvedFrame = NULL;
+static spectatorFrame* g_p_deniedFrame = NULL;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function creates the spectators listening socket, binds it to SERVER_ADDRESS_STR & the input port and starts listening
+/// </summary>
+/// <param name="unsigned short spectatorPortNumber - port number"></param>
+/// <returns>the listening socket, or INVALID_SOCKET if failed</returns>
+static SOCKET createSpectatorListeningSocket(unsigned short spectatorPortNumber);
+
+/// <summary>
+/// Description - Fan-out thread routine. Every wake up serves whatever is ready - new spectators, published frames & spectator sockets
+/// that have room again (or were closed), until the stop Event is signaled
+/// </summary>
+/// <param name="LPVOID lpParam - ignored"></param>
+/// <returns>0</returns>
+static DWORD WINAPI spectatorFanoutThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function accepts the pending spectators into free slots & queues SERVER_APPROVED for them. When all the slots are taken,
+/// the spectator is sent SERVER_DENIED & disconnected
+/// </summary>
+static void acceptPendingSpectators();
+
+/// <summary>
+/// Description - This function takes the published frames, in their publishing order, and queues a reference to each of them for every spectator
+/// </summary>
+static void fanOutPublishedFrames();
+
+/// <summary>
+/// Description - This function handles a spectator socket's network events (a closed socket drops the spectator, whatever it sent is discarded)
+/// and sends its queued frames
+/// </summary>
+/// <param name="spectator* p_spectator - pointer to a taken spectator slot"></param>
+static void serveSpectator(spectator* p_spectator);
+
+/// <summary>
+/// Description - This function sends a spectator's queued frames with non-blocking send(.)s, until its socket's send buffer is full (FD_WRITE wakes
+/// the fan-out thread once it has room again), and releases the frames that were sent whole
+/// </summary>
+/// <param name="spectator* p_spectator - pointer to a taken spectator slot"></param>
+static void flushSpectator(spectator* p_spectator);
+
+/// <summary>
+/// Description - This function queues a reference to a frame for a spectator. A spectator whose ring is full is dropped
+/// </summary>
+/// <param name="spectator* p_spectator - pointer to a taken spectator slot"></param>
+/// <param name="spectatorFrame* p_frame - the frame"></param>
+static void queueFrameForSpectator(spectator* p_spectator, spectatorFrame* p_frame);
+
+/// <summary>
+/// Description - This function disconnects a spectator, releases the frames it still holds & frees its slot
+/// </summary>
+/// <param name="spectator* p_spectator - pointer to a taken spectator slot"></param>
+/// <param name="const char* p_reason - string literal describing why the spectator is dropped"></param>
+static void dropSpectator(spectator* p_spectator, const char* p_reason);
+
+/// <summary>
+/// Description - This function encodes a message once into a new frame - its length prefix & the message, exactly as sendString(.) sends them
+/// </summary>
+/// <param name="int messageType - message type serial number"></param>
+/// <param name="char* p_paramOne, p_paramTwo, p_paramThree, p_paramFour - the message's parameters (may be NULL)"></param>
+/// <returns>pointer to the frame, holding a single reference. NULL if failed</returns>
+static spectatorFrame* encodeSpectatorFrame(int messageType, char* p_paramOne, char* p_paramTwo, char* p_paramThree, char* p_paramFour);
+
+/// <summary>
+/// Description - This function pushes an encoded frame onto the published frames list & wakes the fan-out thread. The list holds the frame's reference
+/// </summary>
+/// <param name="spectatorFrame* p_frame - the frame (ignored if NULL - the spectators miss it)"></param>
+static void publishSpectatorFrame(spectatorFrame* p_frame);
+
+/// <summary>
+/// Description - This function releases a reference to a frame, and frees the frame when its last reference is released
+/// </summary>
+/// <param name="spectatorFrame* p_frame - the frame"></param>
+static void releaseSpectatorFrame(spectatorFrame* p_frame);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL startSpectatorFanout(unsigned short spectatorPortNumber)
+{
+	int s = 0;
+	//Input integrity validation
+	if (0 == spectatorPortNumber) {
+		LOG_EVENT(LOG_EVENT_BAD_INPUTS, "", 0, 0);
+		return STATUS_CODE_FAILURE;
+	}
+
+	InitializeSListHead(&g_publishedFrames);
+
+	//The replies of a new spectator are encoded once, and are held by the module until it stops
+	if ((NULL == (g_p_approvedFrame = encodeSpectatorFrame(SERVER_APPROVED_NUM, NULL, NULL, NULL, NULL))) ||
+		(NULL == (g_p_deniedFrame = encodeSpectatorFrame(SERVER_DENIED_NUM, NULL, NULL, NULL, NULL)))) {
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+
+	if (NULL == (g_p_spectators = (spectator*)calloc(sizeof(spectator), SPECTATOR_MAX_SPECTATORS))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "the spectator slots", SPECTATOR_MAX_SPECTATORS, 0);
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+	for (s = 0; s < SPECTATOR_MAX_SPECTATORS; s++) g_p_spectators[s].s_socket = INVALID_SOCKET;
+
+	if (INVALID_SOCKET == (g_s_spectatorListeningSocket = createSpectatorListeningSocket(spectatorPortNumber))) {
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Fan-out thread & the Events that wake it up
+	if ((NULL == (g_h_spectatorStopEvent = CreateEvent(NULL, MANUAL_RESET, INITIALLY_NON_SIGNALED, NULL))) ||
+		(NULL == (g_h_framePublishedEvent = CreateEvent(NULL, AUTO_RESET, INITIALLY_NON_SIGNALED, NULL)))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the fan-out thread Events", GetLastError(), 0);
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+	if (WSA_INVALID_EVENT == (g_h_spectatorNetworkEvent = WSACreateEvent())) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to create the spectators network Event", WSAGetLastError(), 0);
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+	//The listening socket becomes non-blocking - accept(.) is called only once a connection is pending
+	if (SOCKET_ERROR == WSAEventSelect(g_s_spectatorListeningSocket, g_h_spectatorNetworkEvent, FD_ACCEPT)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to select the spectators listening socket events", WSAGetLastError(), 0);
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+	if (NULL == (g_h_spectatorThread = CreateThread(NULL, 0, spectatorFanoutThreadRoutine, NULL, 0, NULL))) {
+		LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "Failed to create the fan-out thread", GetLastError(), 0);
+		stopSpectatorFanout();
+		return STATUS_CODE_FAILURE;
+	}
+
+	return STATUS_CODE_SUCCESS;
+}
+
+void stopSpectatorFanout()
+{
+	PSLIST_ENTRY p_publishedEntry = NULL;
+	int s = 0;
+
+	//Stop the fan-out thread
+	if (NULL != g_h_spectatorThread) {
+		SetEvent(g_h_spectatorStopEvent);
+		if (WAIT_OBJECT_0 != WaitForSingleObject(g_h_spectatorThread, SPECTATOR_THREAD_STOP_TIMEOUT_MS))
+			LOG_EVENT(LOG_EVENT_TIMEOUT, "Stopping the fan-out thread", SPECTATOR_THREAD_STOP_TIMEOUT_MS, 0);
+		CloseHandle(g_h_spectatorThread);
+		g_h_spectatorThread = NULL;
+	}
+
+	//Disconnect the spectators (releasing the frames they hold), then free the frames that were published but never fanned out
+	if (NULL != g_p_spectators) {
+		for (s = 0; s < SPECTATOR_MAX_SPECTATORS; s++)
+			if (INVALID_SOCKET != g_p_spectators[s].s_socket) dropSpectator(g_p_spectators + s, "Spectator disconnected - the Server exits");
+		free(g_p_spectators);
+		g_p_spectators = NULL;
+	}
+	while (NULL != (p_publishedEntry = InterlockedPopEntrySList(&g_publishedFrames)))
+		releaseSpectatorFrame((spectatorFrame*)p_publishedEntry);
+	if (NULL != g_p_approvedFrame) {
+		releaseSpectatorFrame(g_p_approvedFrame);
+		g_p_approvedFrame = NULL;
+	}
+	if (NULL != g_p_deniedFrame) {
+		releaseSpectatorFrame(g_p_deniedFrame);
+		g_p_deniedFrame = NULL;
+	}
+
+	if (INVALID_SOCKET != g_s_spectatorListeningSocket) {
+		if (SOCKET_ERROR == closesocket(g_s_spectatorListeningSocket))
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to close the spectators listening socket", WSAGetLastError(), 0);
+		g_s_spectatorListeningSocket = INVALID_SOCKET;
+	}
+	if (WSA_INVALID_EVENT != g_h_spectatorNetworkEvent) {
+		WSACloseEvent(g_h_spectatorNetworkEvent);
+		g_h_spectatorNetworkEvent = WSA_INVALID_EVENT;
+	}
+	if (NULL != g_h_framePublishedEvent) {
+		CloseHandle(g_h_framePublishedEvent);
+		g_h_framePublishedEvent = NULL;
+	}
+	if (NULL != g_h_spectatorStopEvent) {
+		CloseHandle(g_h_spectatorStopEvent);
+		g_h_spectatorStopEvent = NULL;
+	}
+	g_numOfSpectators = 0;
+}
+
+void publishGameRoundToSpectators(workingThreadPackage* p_params, SHORT selfGuessBulls, SHORT selfGuessCows, SHORT otherGuessBulls, SHORT otherGuessCows)
+{
+	char selfResultsBuffer[4] = { 0 }, otherResultsBuffer[4] = { 0 };
+	spectatorFrame* p_selfGuessFrame = NULL;
+	//Assert
+	assert(NULL != p_params);
+
+	if ((GAME_ROOM_OPENER_SLOT != p_params->gameRoomSlot) || (0 == g_numOfSpectators)) return;
+
+	//Bulls & cows as strings, the way a Worker thread sends them to its Client ("b\0c\0")
+	selfResultsBuffer[0] = (char)('0' + selfGuessBulls);
+	selfResultsBuffer[2] = (char)('0' + selfGuessCows);
+	otherResultsBuffer[0] = (char)('0' + otherGuessBulls);
+	otherResultsBuffer[2] = (char)('0' + otherGuessCows);
+
+	//A frame per guess - its results, then who guessed what. Both are encoded before the first is published, so they are fanned out together
+	p_selfGuessFrame = encodeSpectatorFrame(SERVER_GAME_RESULTS_NUM, selfResultsBuffer, selfResultsBuffer + 2, p_params->p_selfPlayerName, p_params->p_selfCurrentGuess);
+	publishSpectatorFrame(p_selfGuessFrame);
+	publishSpectatorFrame(encodeSpectatorFrame(SERVER_GAME_RESULTS_NUM, otherResultsBuffer, otherResultsBuffer + 2, p_params->p_otherPlayerName, p_params->p_otherCurrentGuess));
+}
+
+void publishGameOutcomeToSpectators(workingThreadPackage* p_params, char* p_winner)
+{
+	//Assert
+	assert(NULL != p_params);
+
+	if ((GAME_ROOM_OPENER_SLOT != p_params->gameRoomSlot) || (0 == g_numOfSpectators)) return;
+
+	if (NULL == p_winner)
+		publishSpectatorFrame(encodeSpectatorFrame(SERVER_DRAW_NUM, NULL, NULL, NULL, NULL));
+	else //The winner & the number it guessed - its opponent's initial number
+		publishSpectatorFrame(encodeSpectatorFrame(SERVER_WIN_NUM, p_winner,
+			(p_winner == p_params->p_selfPlayerName) ? p_params->p_otherInitialNumber : p_params->p_selfInitialNumber, NULL, NULL));
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static SOCKET createSpectatorListeningSocket(unsigned short spectatorPortNumber)
+{
+	SOCKET s_listeningSocket = INVALID_SOCKET;
+	SOCKADDR_IN service;
+
+	if (INVALID_SOCKET == (s_listeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to create the spectators listening socket", WSAGetLastError(), 0);
+		return INVALID_SOCKET;
+	}
+
+	//The same address the players connect to
+	memset(&service, 0, sizeof(service));
+	service.sin_family = AF_INET;
+	service.sin_port = htons(spectatorPortNumber);
+	if (INETPTONS_SUCCESS != InetPton(AF_INET, SERVER_ADDRESS_STR, &service.sin_addr.s_addr)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to translate the spectators address", WSAGetLastError(), 0);
+		closesocket(s_listeningSocket);
+		return INVALID_SOCKET;
+	}
+
+	if (SOCKET_ERROR == bind(s_listeningSocket, (SOCKADDR*)&service, sizeof(service))) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to bind the spectators listening socket (is the spectators port taken?)", WSAGetLastError(), 0);
+		closesocket(s_listeningSocket);
+		return INVALID_SOCKET;
+	}
+	if (SOCKET_ERROR == listen(s_listeningSocket, SPECTATOR_LISTEN_BACKLOG)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed listening on the spectators socket", WSAGetLastError(), 0);
+		closesocket(s_listeningSocket);
+		return INVALID_SOCKET;
+	}
+
+	return s_listeningSocket;
+}
+
+static DWORD WINAPI spectatorFanoutThreadRoutine(LPVOID lpParam)
+{
+	HANDLE h_wakeUpObjects[3] = { g_h_spectatorStopEvent, g_h_framePublishedEvent, g_h_spectatorNetworkEvent };
+	DWORD waitCode = 0;
+	int s = 0;
+
+	while (TRUE) {
+		waitCode = WaitForMultipleObjects(NUM_OF_FANOUT_WAKE_UPS, h_wakeUpObjects, FALSE /*wait for any*/, INFINITE);
+		if (WAIT_OBJECT_0 == waitCode) break; //Stopped
+		if (WAIT_FAILED == waitCode) {
+			LOG_EVENT(LOG_EVENT_WINAPI_FAILURE, "The fan-out thread failed to wait - the spectators are no longer served", GetLastError(), 0);
+			break; //The games are served regardless
+		}
+
+		//Network events that occur from now on signal the Event again
+		WSAResetEvent(g_h_spectatorNetworkEvent);
+		acceptPendingSpectators();
+		fanOutPublishedFrames();
+		for (s = 0; s < SPECTATOR_MAX_SPECTATORS; s++)
+			if (INVALID_SOCKET != g_p_spectators[s].s_socket) serveSpectator(g_p_spectators + s);
+	}
+
+	return 0;
+}
+
+static void acceptPendingSpectators()
+{
+	SOCKET s_spectatorSocket = INVALID_SOCKET;
+	int s = 0, lastError = 0;
+
+	//The listening socket is non-blocking - accept until no connection is pending
+	while (INVALID_SOCKET != (s_spectatorSocket = accept(g_s_spectatorListeningSocket, NULL, NULL))) {
+		for (s = 0; (s < SPECTATOR_MAX_SPECTATORS) && (INVALID_SOCKET != g_p_spectators[s].s_socket); s++);
+
+		//An accepted socket inherits the listening socket's events - a spectator's socket selects its own (it stays non-blocking)
+		if ((SPECTATOR_MAX_SPECTATORS == s) ||
+			(SOCKET_ERROR == WSAEventSelect(s_spectatorSocket, g_h_spectatorNetworkEvent, FD_WRITE | FD_READ | FD_CLOSE))) {
+			//Declined with a single non-blocking send(.) - the new socket's send buffer is empty
+			LOG_EVENT(LOG_EVENT_CONNECTION, "Declining a spectator (all the spectator slots are taken, or its events can't be selected)", s, WSAGetLastError());
+			send(s_spectatorSocket, g_p_deniedFrame->p_frameBytes, g_p_deniedFrame->frameLength, 0);
+			closesocket(s_spectatorSocket);
+			continue;
+		}
+
+		memset(g_p_spectators + s, 0, sizeof(spectator));
+		g_p_spectators[s].s_socket = s_spectatorSocket;
+		InterlockedIncrement(&g_numOfSpectators);
+		LOG_EVENT(LOG_EVENT_CONNECTION, "Spectator connected", s, g_numOfSpectators);
+		//Sent as soon as the socket reports FD_WRITE
+		queueFrameForSpectator(g_p_spectators + s, g_p_approvedFrame);
+	}
+
+	if (WSAEWOULDBLOCK != (lastError = WSAGetLastError()))
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to accept a spectator", lastError, 0);
+}
+
+static void fanOutPublishedFrames()
+{
+	PSLIST_ENTRY p_publishedEntry = NULL, p_orderedEntries = NULL, p_nextEntry = NULL;
+	spectatorFrame* p_frame = NULL;
+	int s = 0;
+
+	//The published list is LIFO - reverse it, so the spectators get the frames in their publishing order
+	for (p_publishedEntry = InterlockedFlushSList(&g_publishedFrames); NULL != p_publishedEntry; p_publishedEntry = p_nextEntry) {
+		p_nextEntry = p_publishedEntry->Next;
+		p_publishedEntry->Next = p_orderedEntries;
+		p_orderedEntries = p_publishedEntry;
+	}
+
+	for (; NULL != p_orderedEntries; p_orderedEntries = p_nextEntry) {
+		p_nextEntry = p_orderedEntries->Next;
+		p_frame = (spectatorFrame*)p_orderedEntries;
+		//A reference per spectator - the frame itself is never copied
+		for (s = 0; s < SPECTATOR_MAX_SPECTATORS; s++)
+			if (INVALID_SOCKET != g_p_spectators[s].s_socket) queueFrameForSpectator(g_p_spectators + s, p_frame);
+		//Release the published list's reference (a frame no one watches is freed here)
+		releaseSpectatorFrame(p_frame);
+	}
+}
+
+static void serveSpectator(spectator* p_spectator)
+{
+	WSANETWORKEVENTS networkEvents;
+	char discardBuffer[64];
+	//Assert
+	assert(NULL != p_spectator);
+
+	if (SOCKET_ERROR == WSAEnumNetworkEvents(p_spectator->s_socket, NULL, &networkEvents)) {
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to read a spectator's socket events", WSAGetLastError(), 0);
+		dropSpectator(p_spectator, "Spectator dropped - its socket failed");
+		return;
+	}
+	if (networkEvents.lNetworkEvents & FD_CLOSE) {
+		dropSpectator(p_spectator, "Spectator disconnected");
+		return;
+	}
+	//A spectator only watches - whatever it sends is discarded
+	if (networkEvents.lNetworkEvents & FD_READ)
+		while (0 < recv(p_spectator->s_socket, discardBuffer, sizeof(discardBuffer), 0));
+
+	flushSpectator(p_spectator);
+}
+
+static void flushSpectator(spectator* p_spectator)
+{
+	spectatorFrame* p_headFrame = NULL;
+	int bytesSent = 0, lastError = 0;
+	//Assert
+	assert(NULL != p_spectator);
+
+	while (0 < p_spectator->numOfFrames) {
+		p_headFrame = p_spectator->p_frames[p_spectator->headIndex];
+		bytesSent = send(p_spectator->s_socket, p_headFrame->p_frameBytes + p_spectator->headFrameSentBytes,
+			p_headFrame->frameLength - p_spectator->headFrameSentBytes, 0 /* no flags */);
+		if (SOCKET_ERROR == bytesSent) {
+			//The socket's send buffer is full - the rest is sent once FD_WRITE reports room again
+			if (WSAEWOULDBLOCK == (lastError = WSAGetLastError())) return;
+			LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "send() to a spectator failed", lastError, 0);
+			dropSpectator(p_spectator, "Spectator dropped - send(.) failed");
+			return;
+		}
+
+		p_spectator->headFrameSentBytes += bytesSent;
+		if (p_spectator->headFrameSentBytes < p_headFrame->frameLength) continue;
+
+		//The head frame was sent whole - release the spectator's reference
+		p_spectator->headFrameSentBytes = 0;
+		p_spectator->headIndex = (p_spectator->headIndex + 1) & (SPECTATOR_QUEUE_CAPACITY - 1);
+		p_spectator->numOfFrames--;
+		releaseSpectatorFrame(p_headFrame);
+	}
+}
+
+static void queueFrameForSpectator(spectator* p_spectator, spectatorFrame* p_frame)
+{
+	//Asserts
+	assert(NULL != p_spectator);
+	assert(NULL != p_frame);
+
+	if (SPECTATOR_QUEUE_CAPACITY == p_spectator->numOfFrames) {
+		dropSpectator(p_spectator, "Spectator dropped - it fell SPECTATOR_QUEUE_CAPACITY frames behind");
+		return;
+	}
+
+	InterlockedIncrement(&p_frame->referenceCount);
+	p_spectator->p_frames[(p_spectator->headIndex + p_spectator->numOfFrames) & (SPECTATOR_QUEUE_CAPACITY - 1)] = p_frame;
+	p_spectator->numOfFrames++;
+}
+
+static void dropSpectator(spectator* p_spectator, const char* p_reason)
+{
+	//Assert
+	assert(NULL != p_spectator);
+
+	LOG_EVENT(LOG_EVENT_CONNECTION, p_reason, p_spectator->numOfFrames, (LONG)(p_spectator - g_p_spectators));
+
+	//Release the frames it still holds
+	for (; 0 < p_spectator->numOfFrames; p_spectator->numOfFrames--) {
+		releaseSpectatorFrame(p_spectator->p_frames[p_spectator->headIndex]);
+		p_spectator->headIndex = (p_spectator->headIndex + 1) & (SPECTATOR_QUEUE_CAPACITY - 1);
+	}
+
+	if (SOCKET_ERROR == closesocket(p_spectator->s_socket))
+		LOG_EVENT(LOG_EVENT_WINSOCK_FAILURE, "Failed to close a spectator's socket", WSAGetLastError(), 0);
+	p_spectator->s_socket = INVALID_SOCKET;
+	InterlockedDecrement(&g_numOfSpectators);
+}
+
+static spectatorFrame* encodeSpectatorFrame(int messageType, char* p_paramOne, char* p_paramTwo, char* p_paramThree, char* p_paramFour)
+{
+	messageString* p_messageString = NULL;
+	spectatorFrame* p_frame = NULL;
+	int messageLength = 0;
+
+	if (NULL == (p_messageString = constructMessageForSendingServer(messageType, p_paramOne, p_paramTwo, p_paramThree, p_paramFour))) {
+		LOG_EVENT(LOG_EVENT_MESSAGE_FAILURE, "Failed to construct a spectators message", messageType, 0);
+		return NULL;
+	}
+	//The message's length as sendString(.) sends it - up to & including the Line Feed
+	messageLength = findFirstOfCharacters(p_messageString->p_messageBuffer, 0, '\n', '\n', '\n', '\n') + 1;
+
+	//The frame's bytes follow the struct, in a single allocation aligned for the published list
+	if (NULL == (p_frame = (spectatorFrame*)_aligned_malloc(sizeof(spectatorFrame) + sizeof(messageLength) + messageLength, MEMORY_ALLOCATION_ALIGNMENT))) {
+		LOG_EVENT(LOG_EVENT_ALLOCATION_FAILURE, "a spectatorFrame struct", messageLength, 0);
+		freeTheString(p_messageString);
+		return NULL;
+	}
+	p_frame->referenceCount = 1;
+	p_frame->frameLength = (int)sizeof(messageLength) + messageLength;
+	p_frame->p_frameBytes = (char*)(p_frame + 1);
+	memcpy(p_frame->p_frameBytes, &messageLength, sizeof(messageLength));
+	memcpy(p_frame->p_frameBytes + sizeof(messageLength), p_messageString->p_messageBuffer, messageLength);
+
+	freeTheString(p_messageString);
+	return p_frame;
+}
+
+static void publishSpectatorFrame(spectatorFrame* p_frame)
+{
+	if (NULL == p_frame) return;
+
+	InterlockedPushEntrySList(&g_publishedFrames, &p_frame->publishedListEntry);
+	SetEvent(g_h_framePublishedEvent);
+}
+
+static void releaseSpectatorFrame(spectatorFrame* p_frame)
+{
+	//Assert
+	assert(NULL != p_frame);
+
+	if (0 == InterlockedDecrement(&p_frame->referenceCount)) _aligned_free(p_frame);
+}
@@ -0,0 +1,55 @@
+/* SpectatorFanoutTools.h
+----------------------------------------------------------------------
+	Module Description - header module for SpectatorFanoutTools.c
+----------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __SPECTATOR_FANOUT_TOOLS_H__
+#define __SPECTATOR_FANOUT_TOOLS_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+/// <summary>
+/// Description - This function creates the spectators listening socket, bound to SERVER_ADDRESS_STR & the input port, encodes the replies of a new
+/// spectator (SERVER_APPROVED\SERVER_DENIED) and starts the fan-out thread. Must be called after Winsock was initialized & before any Worker thread is created
+/// </summary>
+/// <param name="unsigned short spectatorPortNumber - port number 1 - 65535 (the game port + SPECTATOR_ENDPOINT_PORT_OFFSET)"></param>
+/// <returns>True if succeeded. False otherwise (nothing is left allocated, and every publish does nothing)</returns>
+BOOL startSpectatorFanout(unsigned short spectatorPortNumber);
+
+/// <summary>
+/// Description - This function stops the fan-out thread, disconnects the spectators, frees the frames they still hold & closes the listening socket.
+/// Must be called once, after all the Worker threads ended. Does nothing if the fan-out was not started
+/// </summary>
+void stopSpectatorFanout();
+
+/// <summary>
+/// Description - This function publishes a round to the spectators - a SERVER_GAME_RESULTS frame of each player's guess (its bulls, cows, name & guess).
+/// Called by both Worker threads of a game, only the Game Room opener publishes. Nothing is encoded while no spectator watches
+/// </summary>
+/// <param name="workingThreadPackage* p_params - the Worker thread's inputs"></param>
+/// <param name="SHORT selfGuessBulls, selfGuessCows - results of this Worker thread's player guess"></param>
+/// <param name="SHORT otherGuessBulls, otherGuessCows - results of the opponent's guess"></param>
+void publishGameRoundToSpectators(workingThreadPackage* p_params, SHORT selfGuessBulls, SHORT selfGuessCows, SHORT otherGuessBulls, SHORT otherGuessCows);
+
+/// <summary>
+/// Description - This function publishes a game's outcome to the spectators - SERVER_WIN (the winner & its opponent's initial number) or SERVER_DRAW.
+/// Called by both Worker threads of a game, only the Game Room opener publishes. Nothing is encoded while no spectator watches
+/// </summary>
+/// <param name="workingThreadPackage* p_params - the Worker thread's inputs"></param>
+/// <param name="char* p_winner - the winner's name (p_selfPlayerName or p_otherPlayerName), NULL for a draw"></param>
+void publishGameOutcomeToSpectators(workingThreadPackage* p_params, char* p_winner);
+
+
+#endif //__SPECTATOR_FANOUT_TOOLS_H__
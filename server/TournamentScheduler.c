@@ -0,0 +1,694 @@
+/* TournamentScheduler.c
+--------------------------------------------------------------------------------------
+	Module Description - This module contains the tournament scheduler, built
+		ONLY when TOURNAMENT_SCHEDULER is defined. Bots are registered as the
+		players of a single elimination bracket (seeded, the top seeds get
+		the byes) or of a Swiss tournament (players of the same score are
+		paired, rematches are avoided). All of a round's rooms are opened at
+		once: every room is queued to an I/O completion port, and a pool of
+		scheduler threads - one per processor by default - dequeues a room,
+		plays a single game round of it (both bots guess a number consistent
+		with every result they got, scored with the classic variant's kernel)
+		and queues it again, so thousands of matches share a few threads and
+		none of them owns one. A game that ends is recorded as the Worker
+		threads' sendWinner(.)\sendDraw(.) record it, the winner advances (a
+		drawn bracket match is replayed), and the last room of a round wakes
+		the scheduler, which prints the round's completion time & pairs the
+		next round.
+--------------------------------------------------------------------------------------
+*/
+
+#ifdef TOURNAMENT_SCHEDULER
+
+// Library includes -------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+
+// Projects includes -----------------------------------------------------------
+#include "TournamentScheduler.h"
+#include "GameVariantTools.h"
+
+// Constants --------------------------------------------------------------------
+static const BOOL STATUS_CODE_FAILURE = FALSE;
+static const BOOL STATUS_CODE_SUCCESS = TRUE;
+
+static const BOOL AUTO_RESET = FALSE;
+static const BOOL INITIALLY_NON_SIGNALED = FALSE;
+
+static const int NUM_OF_DIGITS = 10;
+static const int FIRST = 0;
+static const int SECOND = 1;
+static const ULONG_PTR STOP_COMPLETION_KEY = 0;			// A room is never at address 0 - this key stops a scheduler thread
+static const DWORD ROUND_TIMEOUT_MS = 600000;			// 10 Minutes - only a stuck scheduler thread reaches it
+static const DWORD SCHEDULER_EXIT_TIMEOUT_MS = 5000;
+static const double MILLISECONDS_IN_SECOND = 1000.0;
+
+//Command line options
+static const char PLAYERS_OPTION[] = "--players";
+static const char SWISS_OPTION[] = "--swiss";
+static const char THREADS_OPTION[] = "--threads";
+
+//Outcome of the first player of a room, as printed (ordered as 'ratingOutcomes')
+static const char* FIRST_PLAYER_OUTCOME_NAMES[] = { "lost to", "drew with", "beat" };
+
+
+// Global variables ------------------------------------------------------------
+//The format & the registered players (a player is updated ONLY by the single room it plays in during a round, or by the scheduler between rounds)
+static tournamentFormats g_format = TOURNAMENT_FORMAT_BRACKET;
+static tournamentPlayer* g_p_players = NULL;
+//The numbers of 4 distinct digits - a room's candidates are indexes into it
+static char (*g_p_candidateNumbers)[PLAYER_NUMBER_LEN + 1] = NULL;
+static gameVariant g_classicVariant;
+
+//Scheduler threads' completion port, the # of rooms of the current round that are still playing & the Event the last one signals
+static HANDLE g_h_schedulerPort = NULL;
+static volatile LONG g_numOfOpenRooms = 0;
+static HANDLE g_h_roundCompletedEvent = NULL;
+
+
+// Functions declerations ------------------------------------------------------
+
+/// <summary>
+/// Description - This function parses the scheduler's command line options (--players <n>, --swiss <rounds>, --threads <n>). Missing options keep their defaults
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <param name="int* p_numOfPlayers - pointer to the # of players"></param>
+/// <param name="int* p_numOfSwissRounds - pointer to the # of Swiss rounds (left 0 for a bracket)"></param>
+/// <param name="int* p_numOfThreads - pointer to the # of scheduler threads"></param>
+/// <returns>True if every option is known & its value is a positive number. False otherwise</returns>
+static BOOL fetchTournamentOptions(int argc, char* argv[], int* p_numOfPlayers, int* p_numOfSwissRounds, int* p_numOfThreads);
+
+/// <summary>
+/// Description - This function fills the table of the NUM_OF_PLAYER_NUMBERS numbers of 4 distinct digits
+/// </summary>
+static void fillCandidateNumbers();
+
+/// <summary>
+/// Description - This function registers the players - bots named TOURNAMENT_NAME_PREFIX followed by their seed
+/// </summary>
+/// <param name="int numOfPlayers - # of players"></param>
+static void registerTournamentPlayers(int numOfPlayers);
+
+/// <summary>
+/// Description - This function runs a single elimination bracket. The players are placed by seed, so the top seeds meet last and get the byes
+/// when the # of players is not a power of 2
+/// </summary>
+/// <param name="tournamentRoom* p_rooms - rooms for half the players"></param>
+/// <param name="int numOfPlayers - # of players"></param>
+/// <returns>True if every round was completed. False otherwise</returns>
+static BOOL runBracketTournament(tournamentRoom* p_rooms, int numOfPlayers);
+
+/// <summary>
+/// Description - This function runs a Swiss tournament. Every round pairs the players in standing order, each with the next player it has not met yet,
+/// and the lowest standing player that had no bye yet gets the bye of an odd round
+/// </summary>
+/// <param name="tournamentRoom* p_rooms - rooms for half the players"></param>
+/// <param name="int numOfPlayers - # of players"></param>
+/// <param name="int numOfRounds - # of rounds"></param>
+/// <returns>True if every round was completed. False otherwise</returns>
+static BOOL runSwissTournament(tournamentRoom* p_rooms, int numOfPlayers, int numOfRounds);
+
+/// <summary>
+/// Description - This function opens all of a round's rooms at once, waits for the last of them to end and prints the round's completion time
+/// </summary>
+/// <param name="tournamentRoom* p_rooms - the round's rooms, already opened with openTournamentRoom(.)"></param>
+/// <param name="int numOfRooms - # of rooms"></param>
+/// <param name="int roundNumber - the round's number, from 1"></param>
+/// <param name="int numOfByes - # of players that advance without a match"></param>
+/// <returns>True if every room ended. False otherwise</returns>
+static BOOL playTournamentRound(tournamentRoom* p_rooms, int numOfRooms, int roundNumber, int numOfByes);
+
+/// <summary>
+/// Description - This function opens a room for a match of two players - its first game is set up on the scheduler thread that dequeues it first
+/// </summary>
+/// <param name="tournamentRoom* p_room - the room"></param>
+/// <param name="int firstPlayerIndex - index of the first player"></param>
+/// <param name="int secondPlayerIndex - index of the second player"></param>
+static void openTournamentRoom(tournamentRoom* p_room, int firstPlayerIndex, int secondPlayerIndex);
+
+/// <summary>
+/// Description - Scheduler thread routine. Dequeues a room, plays a single game round of it & queues it again until its match ends - then the
+/// last room of the round signals the round completed Event. Ends when dequeuing STOP_COMPLETION_KEY
+/// </summary>
+/// <param name="LPVOID lpParam - ignored"></param>
+/// <returns>0</returns>
+static DWORD WINAPI schedulerThreadRoutine(LPVOID lpParam);
+
+/// <summary>
+/// Description - This function plays a single game round of a room (setting up a new game first if needed): each bot guesses the other's number
+/// and both are scored, as prepareResultsOfCurrentRoundAndSend(.) scores a round
+/// </summary>
+/// <param name="tournamentRoom* p_room - the room"></param>
+/// <returns>True if the room's match ended. False if it continues (another game round, or a replay of a drawn bracket match)</returns>
+static BOOL stepTournamentRoom(tournamentRoom* p_room);
+
+/// <summary>
+/// Description - This function sets up a new game in a room: random initial numbers & every number as a candidate of both bots
+/// </summary>
+/// <param name="tournamentRoom* p_room - the room"></param>
+static void setUpTournamentGame(tournamentRoom* p_room);
+
+/// <summary>
+/// Description - This function makes a bot's guess - a random candidate - scores it against the opponent's initial number, and keeps only the
+/// candidates that would have scored the same
+/// </summary>
+/// <param name="tournamentRoom* p_room - the room"></param>
+/// <param name="int side - FIRST or SECOND, the guessing bot"></param>
+/// <returns># of bulls of the guess</returns>
+static SHORT guessTournamentNumber(tournamentRoom* p_room, int side);
+
+/// <summary>
+/// Description - This function records a game that ended, as sendWinner(.)\sendDraw(.) record a game of the Game Room, and advances the winner.
+/// A drawn bracket match is replayed up to TOURNAMENT_MAX_REPLAYS times, and then the better seed advances
+/// </summary>
+/// <param name="tournamentRoom* p_room - the room"></param>
+/// <param name="ratingOutcomes firstPlayerOutcome - the game's outcome, of the first player"></param>
+/// <returns>True if the match ended. False if it is replayed</returns>
+static BOOL finishTournamentGame(tournamentRoom* p_room, ratingOutcomes firstPlayerOutcome);
+
+/// <summary>
+/// Description - This function checks whether two players met already
+/// </summary>
+/// <param name="int playerIndex - index of a player"></param>
+/// <param name="int opponentIndex - index of the other player"></param>
+/// <returns>True if they met. False otherwise</returns>
+static BOOL isRematch(int playerIndex, int opponentIndex);
+
+/// <summary>
+/// Description - qsort(.) comparison of two players' standings - higher score first, then better seed
+/// </summary>
+/// <param name="const void* p_first, p_second - pointers to the players' indexes"></param>
+/// <returns>negative if the first stands higher, positive otherwise</returns>
+static int compareStandings(const void* p_first, const void* p_second);
+
+/// <summary>
+/// Description - This function advances a xorshift generator
+/// </summary>
+/// <param name="ULONG* p_state - pointer to the generator's state (never 0)"></param>
+/// <returns>the next pseudo random number</returns>
+static ULONG nextRandomNumber(ULONG* p_state);
+
+
+// Functions definitions -------------------------------------------------------
+
+BOOL runTournamentScheduler(int argc, char* argv[])
+{
+	SYSTEM_INFO systemInfo;
+	tournamentRoom* p_rooms = NULL;
+	SHORT* p_candidatesSlab = NULL;
+	HANDLE* p_h_schedulerThreads = NULL;
+	LARGE_INTEGER startTicks, endTicks, ticksPerSecond;
+	int numOfPlayers = TOURNAMENT_DEFAULT_NUM_OF_PLAYERS, numOfSwissRounds = 0, numOfThreads = 0, numOfRooms = 0, r = 0, t = 0;
+	BOOL tournamentSucceeded = FALSE;
+
+	GetSystemInfo(&systemInfo);
+	numOfThreads = (int)systemInfo.dwNumberOfProcessors;
+	if (STATUS_CODE_FAILURE == fetchTournamentOptions(argc, argv, &numOfPlayers, &numOfSwissRounds, &numOfThreads)) {
+		printf("Usage: %s [%s <players>] [%s <rounds>] [%s <scheduler threads>]\n", argv[0], PLAYERS_OPTION, SWISS_OPTION, THREADS_OPTION);
+		return STATUS_CODE_FAILURE;
+	}
+	if ((2 > numOfPlayers) || (TOURNAMENT_MAX_PLAYERS < numOfPlayers) || (TOURNAMENT_MAX_SWISS_ROUNDS < numOfSwissRounds) || (numOfSwissRounds >= numOfPlayers)) {
+		printf("Error: A tournament has 2-%d players, and fewer Swiss rounds than players (at most %d).\n", TOURNAMENT_MAX_PLAYERS, TOURNAMENT_MAX_SWISS_ROUNDS);
+		return STATUS_CODE_FAILURE;
+	}
+	g_format = (0 == numOfSwissRounds) ? TOURNAMENT_FORMAT_BRACKET : TOURNAMENT_FORMAT_SWISS;
+	setClassicGameVariant(&g_classicVariant);
+
+	//Players, candidate numbers, and rooms for half the players - every room with the candidates of both of its bots
+	numOfRooms = numOfPlayers / 2;
+	g_p_players = (tournamentPlayer*)calloc(sizeof(tournamentPlayer), numOfPlayers);
+	g_p_candidateNumbers = (char (*)[PLAYER_NUMBER_LEN + 1])calloc(sizeof(*g_p_candidateNumbers), NUM_OF_PLAYER_NUMBERS);
+	p_rooms = (tournamentRoom*)calloc(sizeof(tournamentRoom), numOfRooms);
+	p_candidatesSlab = (SHORT*)calloc(sizeof(SHORT), (size_t)numOfRooms * 2 * NUM_OF_PLAYER_NUMBERS);
+	p_h_schedulerThreads = (HANDLE*)calloc(sizeof(HANDLE), numOfThreads);
+	if ((NULL == g_p_players) || (NULL == g_p_candidateNumbers) || (NULL == p_rooms) || (NULL == p_candidatesSlab) || (NULL == p_h_schedulerThreads)) {
+		printf("Error: Failed to allocate memory for %d players.\n", numOfPlayers);
+		free(p_h_schedulerThreads); free(p_candidatesSlab); free(p_rooms); free(g_p_candidateNumbers); free(g_p_players);
+		return STATUS_CODE_FAILURE;
+	}
+	for (r = 0; r < numOfRooms; r++) {
+		p_rooms[r].p_candidates[FIRST] = p_candidatesSlab + ((size_t)r * 2) * NUM_OF_PLAYER_NUMBERS;
+		p_rooms[r].p_candidates[SECOND] = p_rooms[r].p_candidates[FIRST] + NUM_OF_PLAYER_NUMBERS;
+		p_rooms[r].randomState = (ULONG)(GetTickCount() ^ (0x9E3779B9UL * (ULONG)(r + 1))) | 1;
+	}
+	fillCandidateNumbers();
+	registerTournamentPlayers(numOfPlayers);
+
+	//The scheduler threads, all waiting on a single completion port
+	if ((NULL == (g_h_schedulerPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, (DWORD)numOfThreads))) ||
+		(NULL == (g_h_roundCompletedEvent = CreateEvent(NULL, AUTO_RESET, INITIALLY_NON_SIGNALED, NULL)))) {
+		printf("Error: Failed to create the scheduler's completion port & Event, with error code no. %ld.\n", GetLastError());
+		numOfThreads = 0;
+	}
+	for (t = 0; t < numOfThreads; t++)
+		if (NULL == (p_h_schedulerThreads[t] = CreateThread(NULL, 0, schedulerThreadRoutine, NULL, 0, NULL))) {
+			printf("Error: Failed to create a scheduler thread, with error code no. %ld.\n", GetLastError());
+			break;
+		}
+
+	//Run the tournament
+	if ((0 < numOfThreads) && (numOfThreads == t)) {
+		if (TOURNAMENT_FORMAT_BRACKET == g_format)
+			printf("Single elimination bracket of %d players, %d scheduler threads\n", numOfPlayers, numOfThreads);
+		else
+			printf("Swiss tournament of %d players & %d rounds, %d scheduler threads\n", numOfPlayers, numOfSwissRounds, numOfThreads);
+
+		QueryPerformanceFrequency(&ticksPerSecond);
+		QueryPerformanceCounter(&startTicks);
+		tournamentSucceeded = (TOURNAMENT_FORMAT_BRACKET == g_format) ?
+			runBracketTournament(p_rooms, numOfPlayers) : runSwissTournament(p_rooms, numOfPlayers, numOfSwissRounds);
+		QueryPerformanceCounter(&endTicks);
+		if (tournamentSucceeded)
+			printf("Tournament completed in %.3f ms\n", (double)(endTicks.QuadPart - startTicks.QuadPart) * MILLISECONDS_IN_SECOND / (double)ticksPerSecond.QuadPart);
+	}
+
+	//Stop the scheduler threads - a stop key each
+	for (r = 0; r < t; r++) PostQueuedCompletionStatus(g_h_schedulerPort, 0, STOP_COMPLETION_KEY, NULL);
+	if ((0 < t) && (WAIT_TIMEOUT == WaitForMultipleObjects((DWORD)t, p_h_schedulerThreads, TRUE, SCHEDULER_EXIT_TIMEOUT_MS)))
+		printf("Warning: A scheduler thread did not stop within %lu ms.\n", SCHEDULER_EXIT_TIMEOUT_MS);
+	for (r = 0; r < t; r++) CloseHandle(p_h_schedulerThreads[r]);
+	if (NULL != g_h_roundCompletedEvent) CloseHandle(g_h_roundCompletedEvent);
+	if (NULL != g_h_schedulerPort) CloseHandle(g_h_schedulerPort);
+	g_h_roundCompletedEvent = NULL;
+	g_h_schedulerPort = NULL;
+
+	free(p_h_schedulerThreads);
+	free(p_candidatesSlab);
+	free(p_rooms);
+	free(g_p_candidateNumbers);
+	free(g_p_players);
+	g_p_candidateNumbers = NULL;
+	g_p_players = NULL;
+	return tournamentSucceeded;
+}
+
+
+
+
+
+
+
+
+
+//......................................Static functions..........................................
+
+static BOOL fetchTournamentOptions(int argc, char* argv[], int* p_numOfPlayers, int* p_numOfSwissRounds, int* p_numOfThreads)
+{
+	int a = 0;
+	long value = 0;
+
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) return STATUS_CODE_FAILURE; //Every option takes a value
+		value = strtol(argv[a + 1], NULL, 10);
+		if (0 >= value) return STATUS_CODE_FAILURE;
+
+		if (STRINGS_ARE_EQUAL(argv[a], PLAYERS_OPTION, sizeof(PLAYERS_OPTION))) *p_numOfPlayers = (int)value;
+		else if (STRINGS_ARE_EQUAL(argv[a], SWISS_OPTION, sizeof(SWISS_OPTION))) *p_numOfSwissRounds = (int)value;
+		else if (STRINGS_ARE_EQUAL(argv[a], THREADS_OPTION, sizeof(THREADS_OPTION))) *p_numOfThreads = (int)value;
+		else return STATUS_CODE_FAILURE;
+		a++;
+	}
+	return STATUS_CODE_SUCCESS;
+}
+
+static void fillCandidateNumbers()
+{
+	int numOfCandidates = 0, first = 0, second = 0, third = 0, fourth = 0;
+
+	for (first = 0; first < NUM_OF_DIGITS; first++)
+		for (second = 0; second < NUM_OF_DIGITS; second++) {
+			if (second == first) continue;
+			for (third = 0; third < NUM_OF_DIGITS; third++) {
+				if ((third == first) || (third == second)) continue;
+				for (fourth = 0; fourth < NUM_OF_DIGITS; fourth++) {
+					if ((fourth == first) || (fourth == second) || (fourth == third)) continue;
+					g_p_candidateNumbers[numOfCandidates][0] = (char)('0' + first);
+					g_p_candidateNumbers[numOfCandidates][1] = (char)('0' + second);
+					g_p_candidateNumbers[numOfCandidates][2] = (char)('0' + third);
+					g_p_candidateNumbers[numOfCandidates][3] = (char)('0' + fourth);
+					g_p_candidateNumbers[numOfCandidates][PLAYER_NUMBER_LEN] = '\0';
+					numOfCandidates++;
+				}
+			}
+		}
+	assert(NUM_OF_PLAYER_NUMBERS == numOfCandidates);
+}
+
+static void registerTournamentPlayers(int numOfPlayers)
+{
+	int p = 0;
+
+	for (p = 0; p < numOfPlayers; p++) {
+		memset(g_p_players + p, 0, sizeof(tournamentPlayer));
+		g_p_players[p].seed = p + 1;
+		sprintf_s(g_p_players[p].playerName, sizeof(g_p_players[p].playerName), "%s%04d", TOURNAMENT_NAME_PREFIX, p + 1);
+	}
+}
+
+static BOOL runBracketTournament(tournamentRoom* p_rooms, int numOfPlayers)
+{
+	int* p_bracket = NULL;
+	int bracketSize = 1, numOfEntries = 0, numOfRooms = 0, numOfByes = 0, roundNumber = 0, e = 0, pair = 0, r = 0;
+	int firstIndex = 0, secondIndex = 0;
+	tournamentPlayer* p_champion = NULL;
+	//Assert
+	assert(NULL != p_rooms);
+
+	while (bracketSize < numOfPlayers) bracketSize *= 2;
+	if (NULL == (p_bracket = (int*)calloc(sizeof(int), bracketSize))) {
+		printf("Error: Failed to allocate memory for a bracket of %d entries.\n", bracketSize);
+		return STATUS_CODE_FAILURE;
+	}
+
+	//Seeds by bracket position - every doubling pairs seed s with seed (2 * size + 1 - s), so the top seeds meet last
+	p_bracket[0] = 1;
+	for (numOfEntries = 1; numOfEntries < bracketSize; numOfEntries *= 2)
+		for (e = numOfEntries - 1; e >= 0; e--) {
+			p_bracket[2 * e + 1] = 2 * numOfEntries + 1 - p_bracket[e];
+			p_bracket[2 * e] = p_bracket[e];
+		}
+	//Seed s is player s - 1. Seeds past the # of players are byes
+	for (e = 0; e < bracketSize; e++) p_bracket[e] = (p_bracket[e] <= numOfPlayers) ? p_bracket[e] - 1 : TOURNAMENT_NO_PLAYER;
+
+	for (numOfEntries = bracketSize, roundNumber = 1; 1 < numOfEntries; numOfEntries /= 2, roundNumber++) {
+		//Open a room per pair of players - a player with no opponent advances
+		for (pair = 0, numOfRooms = 0, numOfByes = 0; pair < numOfEntries / 2; pair++) {
+			firstIndex = p_bracket[2 * pair];
+			secondIndex = p_bracket[2 * pair + 1];
+			if ((TOURNAMENT_NO_PLAYER == firstIndex) || (TOURNAMENT_NO_PLAYER == secondIndex)) {
+				if (TOURNAMENT_NO_PLAYER != firstIndex) g_p_players[firstIndex].byes++;
+				if (TOURNAMENT_NO_PLAYER != secondIndex) g_p_players[secondIndex].byes++;
+				numOfByes++;
+				continue;
+			}
+			openTournamentRoom(p_rooms + numOfRooms++, firstIndex, secondIndex);
+		}
+
+		if (STATUS_CODE_FAILURE == playTournamentRound(p_rooms, numOfRooms, roundNumber, numOfByes)) {
+			free(p_bracket);
+			return STATUS_CODE_FAILURE;
+		}
+
+		//Advance the winners - the rooms were opened in pairs order
+		for (pair = 0, r = 0; pair < numOfEntries / 2; pair++) {
+			firstIndex = p_bracket[2 * pair];
+			secondIndex = p_bracket[2 * pair + 1];
+			if (TOURNAMENT_NO_PLAYER == firstIndex) p_bracket[pair] = secondIndex;
+			else if (TOURNAMENT_NO_PLAYER == secondIndex) p_bracket[pair] = firstIndex;
+			else p_bracket[pair] = p_rooms[r++].winnerIndex;
+		}
+	}
+
+	p_champion = g_p_players + p_bracket[0];
+	printf("%s (seed %d) won the tournament - %d wins, %d draws, %d byes\n",
+		p_champion->playerName, p_champion->seed, p_champion->wins, p_champion->draws, p_champion->byes);
+	free(p_bracket);
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL runSwissTournament(tournamentRoom* p_rooms, int numOfPlayers, int numOfRounds)
+{
+	int* p_standings = NULL;
+	BOOL* p_isPaired = NULL;
+	int roundNumber = 0, numOfRooms = 0, numOfByes = 0, s = 0, o = 0, opponent = 0;
+	tournamentPlayer* p_player = NULL;
+	//Assert
+	assert(NULL != p_rooms);
+
+	p_standings = (int*)calloc(sizeof(int), numOfPlayers);
+	p_isPaired = (BOOL*)calloc(sizeof(BOOL), numOfPlayers);
+	if ((NULL == p_standings) || (NULL == p_isPaired)) {
+		printf("Error: Failed to allocate memory for the standings of %d players.\n", numOfPlayers);
+		free(p_isPaired); free(p_standings);
+		return STATUS_CODE_FAILURE;
+	}
+	for (s = 0; s < numOfPlayers; s++) p_standings[s] = s;
+
+	for (roundNumber = 1; roundNumber <= numOfRounds; roundNumber++) {
+		qsort(p_standings, numOfPlayers, sizeof(int), compareStandings);
+		memset(p_isPaired, 0, sizeof(BOOL) * numOfPlayers);
+		numOfRooms = 0;
+		numOfByes = 0;
+
+		//An odd round - the lowest standing player that had no bye yet gets it (a bye scores as a win)
+		if (numOfPlayers & 1) {
+			for (s = numOfPlayers - 1; (0 < s) && (0 < g_p_players[p_standings[s]].byes); s--);
+			p_player = g_p_players + p_standings[s];
+			p_player->byes++;
+			p_player->score += RATING_OUTCOME_WIN;
+			p_isPaired[s] = TRUE;
+			numOfByes = 1;
+		}
+
+		//Pair in standing order - each with the next player it has not met, or with the next player if it met them all
+		for (s = 0; s < numOfPlayers; s++) {
+			if (p_isPaired[s]) continue;
+			for (o = s + 1, opponent = -1; o < numOfPlayers; o++) {
+				if (p_isPaired[o]) continue;
+				if (-1 == opponent) opponent = o;
+				if (!isRematch(p_standings[s], p_standings[o])) {
+					opponent = o;
+					break;
+				}
+			}
+			if (-1 == opponent) break; //Unreachable - the # of unpaired players is even
+			p_isPaired[s] = p_isPaired[opponent] = TRUE;
+			openTournamentRoom(p_rooms + numOfRooms++, p_standings[s], p_standings[opponent]);
+		}
+
+		if (STATUS_CODE_FAILURE == playTournamentRound(p_rooms, numOfRooms, roundNumber, numOfByes)) {
+			free(p_isPaired); free(p_standings);
+			return STATUS_CODE_FAILURE;
+		}
+	}
+
+	//Final standings
+	qsort(p_standings, numOfPlayers, sizeof(int), compareStandings);
+	printf("Final standings:\n");
+	for (s = 0; (s < numOfPlayers) && (s < TOURNAMENT_STANDINGS_SHOWN); s++) {
+		p_player = g_p_players + p_standings[s];
+		printf("%3d. %-*s %5.1f points  %d-%d-%d (W-D-L), %d byes\n", s + 1, MAX_PLAYER_NAME_LEN, p_player->playerName,
+			p_player->score / 2.0, p_player->wins, p_player->draws, p_player->losses, p_player->byes);
+	}
+	free(p_isPaired);
+	free(p_standings);
+	return STATUS_CODE_SUCCESS;
+}
+
+static BOOL playTournamentRound(tournamentRoom* p_rooms, int numOfRooms, int roundNumber, int numOfByes)
+{
+	LARGE_INTEGER startTicks, endTicks, ticksPerSecond;
+	int r = 0, numOfReplays = 0;
+	//Assert
+	assert(NULL != p_rooms);
+
+	QueryPerformanceFrequency(&ticksPerSecond);
+	QueryPerformanceCounter(&startTicks);
+
+	//Open all the rooms at once. A room whose opening fails is played to its end here, so the count still reaches 0
+	g_numOfOpenRooms = numOfRooms;
+	for (r = 0; r < numOfRooms; r++)
+		if (!PostQueuedCompletionStatus(g_h_schedulerPort, 0, (ULONG_PTR)(p_rooms + r), NULL)) {
+			printf("Warning: Failed to queue a room, with error code no. %ld - it is played by the scheduler.\n", GetLastError());
+			while (!stepTournamentRoom(p_rooms + r));
+			if (0 == InterlockedDecrement(&g_numOfOpenRooms)) SetEvent(g_h_roundCompletedEvent);
+		}
+
+	if ((0 < numOfRooms) && (WAIT_OBJECT_0 != WaitForSingleObject(g_h_roundCompletedEvent, ROUND_TIMEOUT_MS))) {
+		printf("Error: Round %d did not end within %lu ms - %ld rooms are still playing.\n", roundNumber, ROUND_TIMEOUT_MS, g_numOfOpenRooms);
+		return STATUS_CODE_FAILURE;
+	}
+	QueryPerformanceCounter(&endTicks);
+
+	for (r = 0; r < numOfRooms; r++) numOfReplays += p_rooms[r].numOfReplays;
+	printf("Round %2d: %5d matches, %4d byes, %4d replays - completed in %.3f ms\n", roundNumber, numOfRooms, numOfByes, numOfReplays,
+		(double)(endTicks.QuadPart - startTicks.QuadPart) * MILLISECONDS_IN_SECOND / (double)ticksPerSecond.QuadPart);
+	//The last round of a bracket is its final
+	if (1 == numOfRooms)
+		printf("  %s %s %s\n", g_p_players[p_rooms[0].playerIndexes[FIRST]].playerName,
+			FIRST_PLAYER_OUTCOME_NAMES[p_rooms[0].firstPlayerOutcome], g_p_players[p_rooms[0].playerIndexes[SECOND]].playerName);
+	return STATUS_CODE_SUCCESS;
+}
+
+static void openTournamentRoom(tournamentRoom* p_room, int firstPlayerIndex, int secondPlayerIndex)
+{
+	//Assert
+	assert(NULL != p_room);
+
+	p_room->playerIndexes[FIRST] = firstPlayerIndex;
+	p_room->playerIndexes[SECOND] = secondPlayerIndex;
+	p_room->numOfGameRounds = 0;
+	p_room->numOfReplays = 0;
+	p_room->winnerIndex = TOURNAMENT_NO_PLAYER;
+	p_room->firstPlayerOutcome = RATING_OUTCOME_DRAW;
+}
+
+static DWORD WINAPI schedulerThreadRoutine(LPVOID lpParam)
+{
+	DWORD numOfBytes = 0;
+	ULONG_PTR completionKey = STOP_COMPLETION_KEY;
+	LPOVERLAPPED p_overlapped = NULL;
+	tournamentRoom* p_room = NULL;
+	BOOL isMatchOver = FALSE;
+
+	while (GetQueuedCompletionStatus(g_h_schedulerPort, &numOfBytes, &completionKey, &p_overlapped, INFINITE)) {
+		if (STOP_COMPLETION_KEY == completionKey) break;
+		p_room = (tournamentRoom*)completionKey;
+
+		//A single game round, then back to the end of the queue - the other rooms play in between. If it can't be queued, it is played on here
+		isMatchOver = stepTournamentRoom(p_room);
+		while ((!isMatchOver) && (!PostQueuedCompletionStatus(g_h_schedulerPort, 0, (ULONG_PTR)p_room, NULL)))
+			isMatchOver = stepTournamentRoom(p_room);
+
+		if (isMatchOver && (0 == InterlockedDecrement(&g_numOfOpenRooms))) SetEvent(g_h_roundCompletedEvent);
+	}
+
+	return 0;
+}
+
+static BOOL stepTournamentRoom(tournamentRoom* p_room)
+{
+	SHORT firstGuessBulls = 0, secondGuessBulls = 0;
+	//Assert
+	assert(NULL != p_room);
+
+	if (0 == p_room->numOfGameRounds) setUpTournamentGame(p_room);
+	p_room->numOfGameRounds++;
+
+	firstGuessBulls = guessTournamentNumber(p_room, FIRST);
+	secondGuessBulls = guessTournamentNumber(p_room, SECOND);
+
+	//Check results, as the Worker threads judge a round
+	switch (judgeGameRound(&g_classicVariant, firstGuessBulls, secondGuessBulls)) {
+	case GAME_ROUND_DRAW: return finishTournamentGame(p_room, RATING_OUTCOME_DRAW);
+	case GAME_ROUND_SELF_WINS: return finishTournamentGame(p_room, RATING_OUTCOME_WIN);
+	case GAME_ROUND_OTHER_WINS: return finishTournamentGame(p_room, RATING_OUTCOME_LOSS);
+	default: break;
+	}
+	if (TOURNAMENT_MAX_GAME_ROUNDS <= p_room->numOfGameRounds)
+		return finishTournamentGame(p_room, RATING_OUTCOME_DRAW);
+	return FALSE;
+}
+
+static void setUpTournamentGame(tournamentRoom* p_room)
+{
+	int side = 0, c = 0;
+	//Assert
+	assert(NULL != p_room);
+
+	for (side = FIRST; side <= SECOND; side++) {
+		memcpy(p_room->initialNumbers[side], g_p_candidateNumbers[nextRandomNumber(&p_room->randomState) % NUM_OF_PLAYER_NUMBERS], PLAYER_NUMBER_LEN + 1);
+		for (c = 0; c < NUM_OF_PLAYER_NUMBERS; c++) p_room->p_candidates[side][c] = (SHORT)c;
+		p_room->numOfCandidates[side] = NUM_OF_PLAYER_NUMBERS;
+	}
+}
+
+static SHORT guessTournamentNumber(tournamentRoom* p_room, int side)
+{
+	SHORT* p_candidates = NULL;
+	const char* p_guess = NULL;
+	SHORT bulls = 0, cows = 0, candidateBulls = 0, candidateCows = 0;
+	int c = 0, numOfKept = 0;
+	//Assert
+	assert(NULL != p_room);
+	assert(0 < p_room->numOfCandidates[side]);
+
+	//Guess a random candidate & score it against the opponent's initial number
+	p_candidates = p_room->p_candidates[side];
+	p_guess = g_p_candidateNumbers[p_candidates[nextRandomNumber(&p_room->randomState) % (ULONG)p_room->numOfCandidates[side]]];
+	g_classicVariant.p_scoreGuess(p_room->initialNumbers[1 - side], p_guess, &bulls, &cows);
+	if (PLAYER_NUMBER_LEN == bulls) return bulls;
+
+	//Keep the candidates that would have scored the same
+	for (c = 0; c < p_room->numOfCandidates[side]; c++) {
+		g_classicVariant.p_scoreGuess(g_p_candidateNumbers[p_candidates[c]], p_guess, &candidateBulls, &candidateCows);
+		if ((bulls == candidateBulls) && (cows == candidateCows)) p_candidates[numOfKept++] = p_candidates[c];
+	}
+	p_room->numOfCandidates[side] = numOfKept;
+	return bulls;
+}
+
+static BOOL finishTournamentGame(tournamentRoom* p_room, ratingOutcomes firstPlayerOutcome)
+{
+	tournamentPlayer* p_firstPlayer = NULL;
+	tournamentPlayer* p_secondPlayer = NULL;
+	//Assert
+	assert(NULL != p_room);
+
+	//Only this room plays its players during the round - no lock
+	p_firstPlayer = g_p_players + p_room->playerIndexes[FIRST];
+	p_secondPlayer = g_p_players + p_room->playerIndexes[SECOND];
+	p_room->firstPlayerOutcome = firstPlayerOutcome;
+	p_room->numOfGameRounds = 0;
+	switch (firstPlayerOutcome) {
+	case RATING_OUTCOME_WIN: p_firstPlayer->wins++; p_secondPlayer->losses++; break;
+	case RATING_OUTCOME_LOSS: p_firstPlayer->losses++; p_secondPlayer->wins++; break;
+	default: p_firstPlayer->draws++; p_secondPlayer->draws++; break;
+	}
+
+	//A drawn bracket match is replayed (a new game, on the room's next dequeue), and then the better seed advances
+	if ((TOURNAMENT_FORMAT_BRACKET == g_format) && (RATING_OUTCOME_DRAW == firstPlayerOutcome) && (TOURNAMENT_MAX_REPLAYS > p_room->numOfReplays)) {
+		p_room->numOfReplays++;
+		return FALSE;
+	}
+
+	//The match ended
+	p_firstPlayer->score += firstPlayerOutcome;
+	p_secondPlayer->score += RATING_OUTCOME_WIN - firstPlayerOutcome;
+	if (TOURNAMENT_MAX_SWISS_ROUNDS > p_firstPlayer->numOfOpponents)
+		p_firstPlayer->opponents[p_firstPlayer->numOfOpponents++] = p_room->playerIndexes[SECOND];
+	if (TOURNAMENT_MAX_SWISS_ROUNDS > p_secondPlayer->numOfOpponents)
+		p_secondPlayer->opponents[p_secondPlayer->numOfOpponents++] = p_room->playerIndexes[FIRST];
+
+	if (RATING_OUTCOME_WIN == firstPlayerOutcome) p_room->winnerIndex = p_room->playerIndexes[FIRST];
+	else if (RATING_OUTCOME_LOSS == firstPlayerOutcome) p_room->winnerIndex = p_room->playerIndexes[SECOND];
+	else if (TOURNAMENT_FORMAT_BRACKET == g_format)
+		p_room->winnerIndex = (p_firstPlayer->seed < p_secondPlayer->seed) ? p_room->playerIndexes[FIRST] : p_room->playerIndexes[SECOND];
+	else p_room->winnerIndex = TOURNAMENT_NO_PLAYER;
+	return TRUE;
+}
+
+static BOOL isRematch(int playerIndex, int opponentIndex)
+{
+	int o = 0;
+
+	for (o = 0; o < g_p_players[playerIndex].numOfOpponents; o++)
+		if (opponentIndex == g_p_players[playerIndex].opponents[o]) return TRUE;
+	return FALSE;
+}
+
+static int compareStandings(const void* p_first, const void* p_second)
+{
+	const tournamentPlayer* p_firstPlayer = g_p_players + *(const int*)p_first;
+	const tournamentPlayer* p_secondPlayer = g_p_players + *(const int*)p_second;
+
+	if (p_firstPlayer->score != p_secondPlayer->score) return p_secondPlayer->score - p_firstPlayer->score;
+	return p_firstPlayer->seed - p_secondPlayer->seed;
+}
+
+static ULONG nextRandomNumber(ULONG* p_state)
+{
+	ULONG state = *p_state;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	*p_state = state;
+	return state;
+}
+
+#endif //TOURNAMENT_SCHEDULER
@@ -0,0 +1,37 @@
+/* TournamentScheduler.h
+------------------------------------------------------------------
+	Module Description - header module for TournamentScheduler.c
+------------------------------------------------------------------
+*/
+
+
+#pragma once
+#ifndef __TOURNAMENT_SCHEDULER_H__
+#define __TOURNAMENT_SCHEDULER_H__
+
+
+// Library includes -------------------------------------------------------
+#include <Windows.h>
+
+
+
+// Projects includes ------------------------------------------------------
+#include "HardCodedData.h"
+
+//Functions Declarations
+
+#ifdef TOURNAMENT_SCHEDULER
+/// <summary>
+/// Description - This function registers bots as the players of a tournament - a single elimination bracket, or a Swiss tournament of a given # of
+/// rounds - opens all of a round's rooms at once on a pool of scheduler threads, advances the winners as the games end, and prints every round's
+/// completion time & the final standings. Built ONLY when TOURNAMENT_SCHEDULER is defined - the Server then runs it instead of serving Clients:
+///		server.exe [--players <n>] [--swiss <rounds>] [--threads <n>]
+/// </summary>
+/// <param name="int argc - # of command line arguments"></param>
+/// <param name="char* argv[] - command line arguments"></param>
+/// <returns>True if every round was completed. False otherwise</returns>
+BOOL runTournamentScheduler(int argc, char* argv[]);
+#endif //TOURNAMENT_SCHEDULER
+
+
+#endif //__TOURNAMENT_SCHEDULER_H__
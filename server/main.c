@@ -31,6 +31,27 @@
 #include "HardCodedData.h"
 #include "FetchAndValidateCommandlineArguments.h"
 #include "SetCommunicationServerSide.h"
+#include "SlabAllocationTools.h"
+#include "EventLoggingTools.h"
+#include "MetricsTools.h"
+#include "SendQueueTools.h"
+#include "MatchmakingTools.h"
+#include "RatingStoreTools.h"
+#include "GameJournalTools.h"
+#include "GameJournalReplay.h"
+#include "GameJournalAuditor.h"
+#include "GameHistoryIndexTools.h"
+#include "RoomSnapshotTools.h"
+#include "GameVariantTools.h"
+#include "LayoutMicrobenchmark.h"
+#include "MicrobenchmarkSuite.h"
+#include "LoopbackLatencyBenchmark.h"
+#include "TournamentScheduler.h"
+#include "SelfPlayEngine.h"
+#include "OpeningBookTools.h"
+#include "OpeningBookBuilder.h"
+#include "CandidateSetTools.h"
+#include "HotRestartTools.h"
 
 // Constants ----------------------------------------------------------------------------
 static const BOOL STATUS_CODE_FAILURE = FALSE;
@@ -42,8 +63,60 @@ static const BOOL STATUS_CODE_SUCCESS = TRUE;
 int main(int argc, char* argv[]) {	
 	int i = 0;// 0o0o0o0o0o  SERVER  0o0o0o0o0o
 	unsigned short serverPortNumber = 0;
-	//Validating the number of command line arguments
-	if ((argc != 2) || (argv[1] == NULL)) {
+	gameVariant serverGameVariant;
+	int serverStatus = 0;
+
+#ifdef LAYOUT_MICROBENCHMARK
+	//Layout microbenchmark build - measure the Worker threads packages layout instead of serving Clients
+	return (STATUS_CODE_SUCCESS == runLayoutMicrobenchmark()) ? 0 : 1;
+#endif
+#ifdef MICROBENCHMARK_SUITE
+	//Microbenchmark suite build - measure the messages & game hot paths instead of serving Clients (server.exe [--json] [--baseline <file>])
+	return (STATUS_CODE_SUCCESS == runMicrobenchmarkSuite(argc, argv)) ? 0 : 1;
+#endif
+#ifdef GAME_JOURNAL_REPLAY
+	//Game journal replay build - decode, re-score & print the journaled games instead of serving Clients (server.exe <journal file>)
+	return (STATUS_CODE_SUCCESS == runGameJournalReplay(argc, argv)) ? 0 : 1;
+#endif
+#ifdef GAME_JOURNAL_AUDIT
+	//Game journal auditor build - audit the journaled games for impossible results & automated players on all processors instead of serving Clients
+	// (server.exe <journal file> [--threads <n>])
+	return (STATUS_CODE_SUCCESS == runGameJournalAuditor(argc, argv)) ? 0 : 1;
+#endif
+#ifdef LOOPBACK_LATENCY_BENCHMARK
+	//Loopback latency benchmark build - measure the round trip of scripted Clients against an in-process Server (server.exe [--rounds <n>] [--rooms <n>])
+	return (STATUS_CODE_SUCCESS == runLoopbackLatencyBenchmark(argc, argv)) ? 0 : 1;
+#endif
+#ifdef TOURNAMENT_SCHEDULER
+	//Tournament scheduler build - run a bracket or a Swiss tournament of bots on a pool of scheduler threads instead of serving Clients
+	// (server.exe [--players <n>] [--swiss <rounds>] [--threads <n>])
+	return (STATUS_CODE_SUCCESS == runTournamentScheduler(argc, argv)) ? 0 : 1;
+#endif
+
+#ifdef SELF_PLAY_ENGINE
+	//Self-play engine build - play games of two solver strategies against each other on all processors instead of serving Clients
+	// (server.exe [--games <n>] [--threads <n>] [--first <strategy>] [--second <strategy>] [--seed <n>])
+	return (STATUS_CODE_SUCCESS == runSelfPlayEngine(argc, argv)) ? 0 : 1;
+#endif
+
+#ifdef OPENING_BOOK_BUILDER
+	//Opening book builder build - build the solver's decision tree & write it (OPENING_BOOK_PATH by default) instead of serving Clients
+	// (server.exe [--threads <n>] [--output <path>])
+	return (STATUS_CODE_SUCCESS == runOpeningBookBuilder(argc, argv)) ? 0 : 1;
+#endif
+
+	//A Server handed off by the previous Server process (hot restart) takes its sockets & state over first - the old process leaves meanwhile,
+	// releasing the game journal & the stores (server.exe <port> <variant> --handoff <state pipe> <ack pipe> <old process id>)
+	if ((argc >= 2 + HOT_RESTART_NUM_OF_ARGUMENTS) && STRINGS_ARE_EQUAL(argv[argc - HOT_RESTART_NUM_OF_ARGUMENTS], HOT_RESTART_ARGUMENT, sizeof(HOT_RESTART_ARGUMENT))) {
+		if (STATUS_CODE_FAILURE == adoptHandedOffServer(argv[argc - 3], argv[argc - 2], argv[argc - 1])) {
+			printf("Error: Failed to take over the handed off Server.\n");
+			return 1;
+		}
+		argc -= HOT_RESTART_NUM_OF_ARGUMENTS;
+	}
+
+	//Validating the number of command line arguments (server.exe <port> [<variant>])
+	if ((argc < 2) || (argc > 3) || (argv[1] == NULL)) {
 		printf("Error: Incorrect number of arguments.\n");
 		return 1;
 	}
@@ -55,6 +128,84 @@ int main(int argc, char* argv[]) {
 	/* ------------------------------------------------------------------------------------------------- */
 	if (STATUS_CODE_FAILURE == fetchAndValidateCommandLineArguments(argv[1], &serverPortNumber, NULL, NULL)) return 1;
 
+	//The game variant, "<length>x<alphabet>[r]" (e.g. 5x10, 6x16r) - the classic variant if not given
+	setClassicGameVariant(&serverGameVariant);
+	if ((3 == argc) && (STATUS_CODE_FAILURE == parseGameVariant(argv[2], &serverGameVariant))) {
+		printf("Error: Invalid game variant %s - expected <length>x<alphabet>[r], a length of 1-%d & an alphabet of %d-%d symbols.\n",
+			argv[2], MAX_PLAYER_NUMBER_LEN, MIN_GAME_ALPHABET_SIZE, MAX_GAME_ALPHABET_SIZE);
+		return 1;
+	}
+
+	//Start the event logger (diagnostics), prepare the per-thread slab caches of the messages objects, the metrics shards, the send queues, the ratings, the game journal
+	// & the matchmaking, before any thread is created
+	if (STATUS_CODE_FAILURE == initializeEventLogger()) return 1;
+	if (STATUS_CODE_FAILURE == initializeSlabAllocator()) {
+		destroyEventLogger();
+		return 1;
+	}
+	if (STATUS_CODE_FAILURE == initializeMetricsRegistry()) {
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	if (STATUS_CODE_FAILURE == initializeSendQueues()) {
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	if (STATUS_CODE_FAILURE == initializeRatingStore(RATING_STORE_PATH)) {
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	if (STATUS_CODE_FAILURE == initializeGameJournal(GAME_JOURNAL_PATH)) {
+		destroyRatingStore();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	if (STATUS_CODE_FAILURE == initializeGameHistoryIndex(GAME_HISTORY_INDEX_PATH, GAME_JOURNAL_PATH)) {
+		destroyGameJournal();
+		destroyRatingStore();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	//The games checkpointed by the previous Server process are read back - unless it handed its games over (they are still played)
+	if (STATUS_CODE_FAILURE == initializeRoomSnapshots(ROOM_SNAPSHOT_PATH, FALSE == isHandedOffServer())) {
+		destroyGameHistoryIndex();
+		destroyGameJournal();
+		destroyRatingStore();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	//The bot plays the classic variant only, and keeps its candidates in sets - fill their tables before it may be summoned
+	initializeCandidateSets();
+	if (STATUS_CODE_FAILURE == initializeMatchmaking(MATCHMAKING_DEFAULT_MODE, MATCHMAKING_DEFAULT_BOT_FALLBACK && isClassicGameVariant(&serverGameVariant), serverPortNumber)) {
+		destroyGameJournal();
+		destroyGameHistoryIndex();
+		destroyRoomSnapshots();
+		destroyRatingStore();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
+		return 1;
+	}
+	//The bot plays the opening book if one was built - otherwise it filters its candidates every round
+	if (isClassicGameVariant(&serverGameVariant) && (STATUS_CODE_FAILURE == loadOpeningBook(OPENING_BOOK_PATH)))
+		printf("Warning: No opening book (%s), the bot plays without it\n", OPENING_BOOK_PATH);
+
 	
 
 
@@ -72,8 +223,29 @@ int main(int argc, char* argv[]) {
 	//The following function will perform all needed phases of the server process from opening a socket for listening, creating	   */
 	//							Worker threads and operate incoming Clients connections										   	   */
 	/* --------------------------------------------------------------------------------------------------------------------------- */
-	if (STATUS_CODE_FAILURE == setCommmunicationServerSide(serverPortNumber)) {
+	serverStatus = setCommmunicationServerSide(serverPortNumber, &serverGameVariant);
+	//Handed off to a new Server process - the parked Worker threads still use the matchmaking, the send queues, the slab caches & the rest, so nothing
+	//	is freed: only the game journal is committed, the ratings are saved (the new process waits for this one to leave before it opens them) & the
+	//	events of the handoff still in the log rings are printed. The parked threads end with the process
+	if (STATUS_SERVER_HANDOFF == serverStatus) {
+		flushGameJournal();
+		flushRatingStore();
+		flushEventLogger();
+		printf("\n\n\n\n...............................\n\nServer was handed over to a new Server process!!!\n...............................\n\n\n\n\n\n");
+		return 0;
+	}
+	if (STATUS_CODE_FAILURE == serverStatus) {
 		printf("Error: Failed to conduct waiting room & games for client processes (players).\n");
+		unloadOpeningBook();
+		destroyMatchmaking();
+		destroyGameJournal();
+		destroyGameHistoryIndex();
+		destroyRoomSnapshots();
+		destroyRatingStore();
+		destroySendQueues();
+		destroyMetricsRegistry();
+		destroySlabAllocator();
+		destroyEventLogger();
 		return 1;
 	}
 
@@ -82,6 +254,18 @@ int main(int argc, char* argv[]) {
 
 
 
+	//All threads ended - unmap the opening book, free the matchmaking, commit & close the game journal, fold it into the game history index & unmap it, unmap the room snapshots, save & free the ratings, free the send queues, the metrics shards & the slab caches and print the remaining diagnostics
+	unloadOpeningBook();
+	destroyMatchmaking();
+	destroyGameJournal();
+	destroyGameHistoryIndex();
+	destroyRoomSnapshots();
+	destroyRatingStore();
+	destroySendQueues();
+	destroyMetricsRegistry();
+	destroySlabAllocator();
+	destroyEventLogger();
+
 	printf("\n\n\n\n...............................\n\nServer has finished properly!!!\n...............................\n\n\n\n\n\n");
 	return 0;
 }
\ No newline at end of file